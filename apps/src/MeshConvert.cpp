@@ -41,6 +41,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 // Most of the work is done by this class.  It must be included first.
 //#include "CardiacSimulation.hpp"
 
+#include <cstdlib>
 #include <string>
 #include <libgen.h>
 
@@ -49,8 +50,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "GenericMeshReader.hpp"
 #include "DistributedTetrahedralMesh.hpp"
 #include "TrianglesMeshWriter.hpp"
+#include "MappedMeshWriter.hpp"
 #include "FileFinder.hpp"
 #include "FibreConverter.hpp"
+#include "PetscTools.hpp"
 
 int main(int argc, char *argv[])
 {
@@ -60,9 +63,9 @@ int main(int argc, char *argv[])
 
     try
     {
-        if (argc<2)
+        if (argc<2 || (argc>2 && std::string(argv[2]) != "--mapped"))
         {
-            ExecutableSupport::PrintError("Usage: MeshConvert mesh_3d_file_base_name", true);
+            ExecutableSupport::PrintError("Usage: MeshConvert mesh_3d_file_base_name [--mapped [num_processes]]", true);
             exit_code = ExecutableSupport::EXIT_BAD_ARGUMENTS;
         }
         else
@@ -77,9 +80,6 @@ int main(int argc, char *argv[])
             ExecutableSupport::Print("Opening "+base+" mesh file(s).");
 
             std::shared_ptr<AbstractMeshReader<3,3> > p_mesh_reader = GenericMeshReader<3,3>(argv[1]);
-            //We have to make a mesh so that we can get the node connectivity list back
-            DistributedTetrahedralMesh<3,3> mesh;
-            mesh.ConstructFromMeshReader(*p_mesh_reader);
 
             //Find a dot
             std::string base_for_output=base;
@@ -89,11 +89,30 @@ int main(int argc, char *argv[])
                 //If dot found, then make the string smaller
                 base_for_output.resize(pos);
             }
-            base_for_output = base_for_output + "_bin";
-            TrianglesMeshWriter<3,3> mesh_writer("", base_for_output);
-            ExecutableSupport::Print("Writing  " + base_for_output + ".node etc. mesh file in " + mesh_writer.GetOutputDirectory());
-            mesh_writer.SetWriteFilesAsBinary();
-            mesh_writer.WriteFilesUsingMesh(mesh);
+
+            if (argc>2)
+            {
+                // The mapped format is written straight from the reader, optionally with a partition for the given number of processes
+                unsigned num_processes = (argc>3) ? atoi(argv[3]) : 0u;
+                base_for_output = base_for_output + "_mapped";
+                MappedMeshWriter<3,3> mesh_writer("", base_for_output);
+                ExecutableSupport::Print("Writing  " + base_for_output + ".mmesh mesh file in " + mesh_writer.GetOutputDirectory());
+                mesh_writer.SetNumPartitions(num_processes);
+                mesh_writer.WriteFilesUsingMeshReader(*p_mesh_reader);
+                PetscTools::Barrier("MeshConvert");
+            }
+            else
+            {
+                //We have to make a mesh so that we can get the node connectivity list back
+                DistributedTetrahedralMesh<3,3> mesh;
+                mesh.ConstructFromMeshReader(*p_mesh_reader);
+
+                base_for_output = base_for_output + "_bin";
+                TrianglesMeshWriter<3,3> mesh_writer("", base_for_output);
+                ExecutableSupport::Print("Writing  " + base_for_output + ".node etc. mesh file in " + mesh_writer.GetOutputDirectory());
+                mesh_writer.SetWriteFilesAsBinary();
+                mesh_writer.WriteFilesUsingMesh(mesh);
+            }
             // Convert fibres if present
             FibreConverter fibre_converter;
             FileFinder mesh_file(argv[1], RelativeTo::AbsoluteOrCwd);
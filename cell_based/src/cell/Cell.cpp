@@ -35,10 +35,13 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "Cell.hpp"
 
+#include <boost/make_shared.hpp>
+
 #include "ApoptoticCellProperty.hpp"
 #include "CellAncestor.hpp"
 #include "CellId.hpp"
 #include "CellLabel.hpp"
+#include "CellObjectPool.hpp"
 #include "DefaultCellProliferativeType.hpp"
 #include "NullSrnModel.hpp"
 #include "SmartPointers.hpp"
@@ -58,7 +61,9 @@ Cell::Cell(boost::shared_ptr<AbstractCellProperty> pMutationState,
       mUndergoingApoptosis(false),
       mIsDead(false),
       mIsLogged(false),
-      mHasSrnModel(false)
+      mHasSrnModel(false),
+      mLocationIndexSlot(UINT_MAX),
+      mpLocationIndex(nullptr)
 {
     if (SimulationTime::Instance()->IsStartTimeSetUp()==false)
     {
@@ -152,6 +157,16 @@ Cell::~Cell()
     delete mpSrnModel;
 }
 
+void* Cell::operator new(std::size_t size)
+{
+    return CellObjectPool::Allocate(size);
+}
+
+void Cell::operator delete(void* pObject, std::size_t size)
+{
+    CellObjectPool::Deallocate(pObject, size);
+}
+
 void Cell::SetCellProliferativeType(boost::shared_ptr<AbstractCellProperty> pProliferativeType)
 {
     if (!pProliferativeType->IsSubType<AbstractCellProliferativeType>())
@@ -509,7 +524,7 @@ CellPtr Cell::Divide()
     daughter_property_collection.RemoveProperty(p_cell_data);
 
     // Create a new cell data object using the copy constructor and add this to the daughter cell
-    MAKE_PTR_ARGS(CellData, p_daughter_cell_data, (*p_cell_data));
+    boost::shared_ptr<CellData> p_daughter_cell_data = boost::allocate_shared<CellData>(CellObjectPoolAllocator<CellData>(), *p_cell_data);
     daughter_property_collection.AddProperty(p_daughter_cell_data);
 
     // Get the existing copy of the cell edge data and remove it from the daughter cell
@@ -517,7 +532,7 @@ CellPtr Cell::Divide()
     daughter_property_collection.RemoveProperty(p_cell_edge_data);
 
     // Create a new cell edge data object using the copy constructor and add this to the daughter cell
-    MAKE_PTR_ARGS(CellEdgeData, p_daughter_cell_edge_data, (*p_cell_edge_data));
+    boost::shared_ptr<CellEdgeData> p_daughter_cell_edge_data = boost::allocate_shared<CellEdgeData>(CellObjectPoolAllocator<CellEdgeData>(), *p_cell_edge_data);
     daughter_property_collection.AddProperty(p_daughter_cell_edge_data);
 
     // Copy all cell Vec data (note we create a new object not just copying the pointer)
@@ -532,8 +547,12 @@ CellPtr Cell::Divide()
         daughter_property_collection.AddProperty(p_daughter_cell_vec_data);
     }
 
-    // Create daughter cell with modified cell property collection
-    CellPtr p_new_cell(new Cell(GetMutationState(), mpCellCycleModel->CreateCellCycleModel(), mpSrnModel->CreateSrnModel(), false, daughter_property_collection));
+    /*
+     * Create daughter cell with modified cell property collection. The cell and its
+     * shared_ptr control block are allocated together from CellObjectPool, reusing
+     * memory released by dead cells.
+     */
+    CellPtr p_new_cell = boost::allocate_shared<Cell>(CellObjectPoolAllocator<Cell>(), GetMutationState(), mpCellCycleModel->CreateCellCycleModel(), mpSrnModel->CreateSrnModel(), false, daughter_property_collection);
 
     // Initialise properties of daughter cell
     p_new_cell->GetCellCycleModel()->InitialiseDaughterCell();
@@ -549,3 +568,19 @@ bool Cell::HasSrnModel() const
 {
     return mHasSrnModel;
 }
+
+unsigned Cell::GetLocationIndexSlot() const
+{
+    return mLocationIndexSlot;
+}
+
+const CellLocationIndex* Cell::GetLocationIndexOfSlot() const
+{
+    return mpLocationIndex;
+}
+
+void Cell::SetLocationIndexSlot(unsigned slot, const CellLocationIndex* pLocationIndex)
+{
+    mLocationIndexSlot = slot;
+    mpLocationIndex = pLocationIndex;
+}
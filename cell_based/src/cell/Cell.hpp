@@ -57,6 +57,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 class AbstractCellCycleModel; // Circular definition (cells need to know about cycle models and vice-versa).
 class AbstractSrnModel; // Circular definition (cells need to know about subcellular reaction network models and vice-versa).
 class Cell;
+class CellLocationIndex;
 
 /** Cells shouldn't be copied - it doesn't make sense.  So all access is via this pointer type. */
 typedef boost::shared_ptr<Cell> CellPtr;
@@ -154,6 +155,19 @@ protected:
     /** Whether the cell has a sub-cellular reaction network (SRN) system of ODEs associated with it. */
     bool mHasSrnModel;
 
+    /**
+     * The slot occupied by this cell in the CellLocationIndex #mpLocationIndex
+     * (UINT_MAX if none). Not archived, since the index is rebuilt when loading.
+     */
+    unsigned mLocationIndexSlot;
+
+    /**
+     * The CellLocationIndex to which #mLocationIndexSlot refers (nullptr if none). A cell
+     * attached to the indices of more than one cell population only stores its slot in the
+     * first of them; the others look it up in a map. Not archived.
+     */
+    const CellLocationIndex* mpLocationIndex;
+
 public:
 
     /**
@@ -179,6 +193,23 @@ public:
      */
     virtual ~Cell();
 
+    /**
+     * Allocate memory for a new cell from CellObjectPool, so that memory freed by
+     * dead cells is reused.
+     *
+     * @param size  the size of the object
+     * @return a pointer to the memory
+     */
+    static void* operator new(std::size_t size);
+
+    /**
+     * Return the memory used by a cell to CellObjectPool.
+     *
+     * @param pObject  a pointer to the memory
+     * @param size  the size of the object
+     */
+    static void operator delete(void* pObject, std::size_t size);
+
     /**
      * @return the cell's proliferative type.
      */
@@ -434,6 +465,24 @@ public:
      * @return Whether the cell has a sub-cellular reaction network (SRN) system of ODEs associated with it
      */
     bool HasSrnModel() const;
+
+    /**
+     * @return mLocationIndexSlot.
+     */
+    unsigned GetLocationIndexSlot() const;
+
+    /**
+     * @return mpLocationIndex.
+     */
+    const CellLocationIndex* GetLocationIndexOfSlot() const;
+
+    /**
+     * Set mLocationIndexSlot and mpLocationIndex. This should only be called by CellLocationIndex.
+     *
+     * @param slot the slot occupied by this cell in a CellLocationIndex (UINT_MAX if none)
+     * @param pLocationIndex the CellLocationIndex (nullptr if none)
+     */
+    void SetLocationIndexSlot(unsigned slot, const CellLocationIndex* pLocationIndex);
 };
 
 
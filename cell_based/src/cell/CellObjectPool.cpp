@@ -0,0 +1,133 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "CellObjectPool.hpp"
+
+CellObjectPool::FreeList* CellObjectPool::GetFreeLists()
+{
+    static FreeList free_lists[NUM_SIZE_CLASSES] = {};
+    return free_lists;
+}
+
+std::mutex& CellObjectPool::rGetMutex()
+{
+    static std::mutex* p_mutex = new std::mutex;
+    return *p_mutex;
+}
+
+std::size_t CellObjectPool::GetSizeClass(std::size_t size)
+{
+    // Every block must be large enough to hold the free list link
+    std::size_t size_class = (size + SIZE_CLASS_GRANULARITY - 1)/SIZE_CLASS_GRANULARITY;
+    if (size_class == 0)
+    {
+        size_class = 1;
+    }
+    return (size_class < NUM_SIZE_CLASSES) ? size_class : NUM_SIZE_CLASSES;
+}
+
+void* CellObjectPool::Allocate(std::size_t size)
+{
+    std::size_t size_class = GetSizeClass(size);
+    if (size_class == NUM_SIZE_CLASSES)
+    {
+        return ::operator new(size);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(rGetMutex());
+        FreeList& r_free_list = GetFreeLists()[size_class];
+        if (r_free_list.mpHead != nullptr)
+        {
+            void* p_block = r_free_list.mpHead;
+            r_free_list.mpHead = *static_cast<void**>(p_block);
+            r_free_list.mNumBlocks--;
+            return p_block;
+        }
+    }
+
+    // Allocate the whole size class, so that the block can later be reused for any request in it
+    return ::operator new(size_class*SIZE_CLASS_GRANULARITY);
+}
+
+void CellObjectPool::Deallocate(void* pBlock, std::size_t size)
+{
+    if (pBlock == nullptr)
+    {
+        return;
+    }
+
+    std::size_t size_class = GetSizeClass(size);
+    if (size_class == NUM_SIZE_CLASSES)
+    {
+        ::operator delete(pBlock);
+        return;
+    }
+
+    // The block is linked into the free list through its own storage, so this cannot fail
+    std::lock_guard<std::mutex> lock(rGetMutex());
+    FreeList& r_free_list = GetFreeLists()[size_class];
+    *static_cast<void**>(pBlock) = r_free_list.mpHead;
+    r_free_list.mpHead = pBlock;
+    r_free_list.mNumBlocks++;
+}
+
+unsigned CellObjectPool::GetNumFreeBlocks(std::size_t size)
+{
+    std::size_t size_class = GetSizeClass(size);
+    if (size_class == NUM_SIZE_CLASSES)
+    {
+        return 0;
+    }
+
+    std::lock_guard<std::mutex> lock(rGetMutex());
+    return GetFreeLists()[size_class].mNumBlocks;
+}
+
+void CellObjectPool::Clear()
+{
+    std::lock_guard<std::mutex> lock(rGetMutex());
+    FreeList* p_free_lists = GetFreeLists();
+    for (std::size_t size_class=0; size_class<NUM_SIZE_CLASSES; size_class++)
+    {
+        while (p_free_lists[size_class].mpHead != nullptr)
+        {
+            void* p_block = p_free_lists[size_class].mpHead;
+            p_free_lists[size_class].mpHead = *static_cast<void**>(p_block);
+            ::operator delete(p_block);
+        }
+        p_free_lists[size_class].mNumBlocks = 0;
+    }
+}
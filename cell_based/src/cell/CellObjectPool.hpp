@@ -0,0 +1,202 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef CELLOBJECTPOOL_HPP_
+#define CELLOBJECTPOOL_HPP_
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+
+/**
+ * A memory pool for the small objects that are created and destroyed each time
+ * a cell divides or dies: the Cell itself, its cell-cycle and SRN models, and
+ * its CellData and CellEdgeData.
+ *
+ * Blocks are grouped into size classes. A block released by a dead cell is kept
+ * on the free list for its size class and handed out again to the next object of
+ * a similar size, so that simulations with high cell turnover do not repeatedly
+ * go through the general-purpose allocator. Requests larger than the largest
+ * size class are passed straight to the global operator new.
+ *
+ * Cell, AbstractCellCycleModel and AbstractSrnModel use the pool through their
+ * class-specific operator new and delete, so that no change is needed where
+ * these objects are created (including by Boost serialization on load).
+ * CellObjectPoolAllocator allows shared_ptr control blocks to come from the pool
+ * too, via boost::allocate_shared().
+ */
+class CellObjectPool
+{
+public:
+
+    /**
+     * Allocate a block of memory from the pool.
+     *
+     * @param size  the number of bytes required
+     * @return a pointer to the block
+     */
+    static void* Allocate(std::size_t size);
+
+    /**
+     * Return a block of memory to the pool.
+     *
+     * @param pBlock  a pointer to a block obtained from Allocate()
+     * @param size  the size that was passed to Allocate()
+     */
+    static void Deallocate(void* pBlock, std::size_t size);
+
+    /**
+     * @return the number of free blocks held by the pool for objects of the given size.
+     *
+     * @param size  the object size
+     */
+    static unsigned GetNumFreeBlocks(std::size_t size);
+
+    /**
+     * Release all free blocks back to the global allocator.
+     */
+    static void Clear();
+
+private:
+
+    /** The size classes are multiples of this number of bytes. */
+    static const std::size_t SIZE_CLASS_GRANULARITY = 16;
+
+    /** The number of size classes; larger requests are not pooled. */
+    static const std::size_t NUM_SIZE_CLASSES = 64;
+
+    /**
+     * @return the size class for a request, or NUM_SIZE_CLASSES if it is too large to pool.
+     *
+     * @param size  the number of bytes required
+     */
+    static std::size_t GetSizeClass(std::size_t size);
+
+    /**
+     * The free blocks of a size class. Each free block holds a pointer to the next in
+     * its first bytes, so that returning a block to the pool never allocates memory.
+     */
+    struct FreeList
+    {
+        /** The most recently freed block, or nullptr if there are none. */
+        void* mpHead;
+
+        /** The number of blocks in the list. */
+        unsigned mNumBlocks;
+    };
+
+    /**
+     * @return the free list of each size class. These have no destructor, so that blocks
+     * may still be returned to the pool by objects that are destroyed during static
+     * destruction.
+     */
+    static FreeList* GetFreeLists();
+
+    /**
+     * @return the mutex guarding the free blocks, since cells may be created or
+     * destroyed from several threads.
+     */
+    static std::mutex& rGetMutex();
+};
+
+/**
+ * A standard-library allocator that takes its memory from CellObjectPool. This is
+ * intended for use with boost::allocate_shared(), so that an object and its
+ * shared_ptr control block share a single pooled block.
+ */
+template<typename T>
+class CellObjectPoolAllocator
+{
+public:
+
+    /** The type of object allocated. */
+    typedef T value_type;
+
+    /**
+     * Default constructor.
+     */
+    CellObjectPoolAllocator()
+    {
+    }
+
+    /**
+     * Converting constructor, required for rebinding.
+     */
+    template<typename U>
+    CellObjectPoolAllocator(const CellObjectPoolAllocator<U>&)
+    {
+    }
+
+    /**
+     * @return storage for n objects of type T.
+     *
+     * @param n  the number of objects
+     */
+    T* allocate(std::size_t n)
+    {
+        return static_cast<T*>(CellObjectPool::Allocate(n*sizeof(T)));
+    }
+
+    /**
+     * Release storage obtained from allocate().
+     *
+     * @param pObjects  the storage
+     * @param n  the number of objects
+     */
+    void deallocate(T* pObjects, std::size_t n)
+    {
+        CellObjectPool::Deallocate(pObjects, n*sizeof(T));
+    }
+};
+
+/**
+ * @return true, since all CellObjectPoolAllocators share the same pool.
+ */
+template<typename T, typename U>
+bool operator==(const CellObjectPoolAllocator<T>&, const CellObjectPoolAllocator<U>&)
+{
+    return true;
+}
+
+/**
+ * @return false, since all CellObjectPoolAllocators share the same pool.
+ */
+template<typename T, typename U>
+bool operator!=(const CellObjectPoolAllocator<T>&, const CellObjectPoolAllocator<U>&)
+{
+    return false;
+}
+
+#endif /* CELLOBJECTPOOL_HPP_ */
@@ -34,6 +34,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "AbstractCellCycleModel.hpp"
+#include "CellObjectPool.hpp"
 
 AbstractCellCycleModel::AbstractCellCycleModel()
     : mBirthTime(SimulationTime::Instance()->GetTime()),
@@ -46,6 +47,16 @@ AbstractCellCycleModel::~AbstractCellCycleModel()
 {
 }
 
+void* AbstractCellCycleModel::operator new(std::size_t size)
+{
+    return CellObjectPool::Allocate(size);
+}
+
+void AbstractCellCycleModel::operator delete(void* pObject, std::size_t size)
+{
+    CellObjectPool::Deallocate(pObject, size);
+}
+
 AbstractCellCycleModel::AbstractCellCycleModel(const AbstractCellCycleModel& rModel)
     : mBirthTime(rModel.mBirthTime),
       mReadyToDivide(rModel.mReadyToDivide),
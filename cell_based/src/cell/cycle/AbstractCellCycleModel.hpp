@@ -144,6 +144,23 @@ public:
      */
     virtual ~AbstractCellCycleModel();
 
+    /**
+     * Allocate memory for a new cell-cycle model from CellObjectPool, so that memory freed by
+     * dead cells is reused.
+     *
+     * @param size  the size of the object
+     * @return a pointer to the memory
+     */
+    static void* operator new(std::size_t size);
+
+    /**
+     * Return the memory used by a cell-cycle model to CellObjectPool.
+     *
+     * @param pObject  a pointer to the memory
+     * @param size  the size of the object
+     */
+    static void operator delete(void* pObject, std::size_t size);
+
     /**
      * Gives the cell-cycle model a pointer to its host cell.
      *
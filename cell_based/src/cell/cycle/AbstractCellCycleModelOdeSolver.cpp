@@ -66,6 +66,11 @@ double AbstractCellCycleModelOdeSolver::GetStoppingTime()
     return mpOdeSolver->GetStoppingTime();
 }
 
+boost::shared_ptr<AbstractIvpOdeSolver> AbstractCellCycleModelOdeSolver::GetIvpOdeSolver() const
+{
+    return mpOdeSolver;
+}
+
 void AbstractCellCycleModelOdeSolver::SetSizeOfOdeSystem(unsigned sizeOfOdeSystem)
 {
     mSizeOfOdeSystem = sizeOfOdeSystem;
@@ -155,6 +155,12 @@ public:
      */
     unsigned GetSizeOfOdeSystem();
 
+    /**
+     * @return the underlying ODE solver (used by CellOdeBatchSolver to decide whether
+     * systems solved by this object can be batched).
+     */
+    boost::shared_ptr<AbstractIvpOdeSolver> GetIvpOdeSolver() const;
+
     /**
      * If using CVODE, make the solver check for stopping events using CVODE's rootfinding functionality
      * (by default we do not check).
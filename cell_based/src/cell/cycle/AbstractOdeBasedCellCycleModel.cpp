@@ -103,6 +103,11 @@ bool AbstractOdeBasedCellCycleModel::ReadyToDivide()
     return mReadyToDivide;
 }
 
+bool AbstractOdeBasedCellCycleModel::CanBatchSolveOdeToTime(double currentTime)
+{
+    return !mReadyToDivide && (mpOdeSystem != nullptr) && (currentTime > mLastTime);
+}
+
 void AbstractOdeBasedCellCycleModel::ResetForDivision()
 {
     assert(mReadyToDivide);
@@ -114,12 +119,7 @@ void AbstractOdeBasedCellCycleModel::ResetForDivision()
 
 double AbstractOdeBasedCellCycleModel::GetOdeStopTime()
 {
-    double stop_time = DOUBLE_UNSET;
-    if (mpOdeSolver->StoppingEventOccurred())
-    {
-        stop_time = mpOdeSolver->GetStoppingTime();
-    }
-    return stop_time;
+    return GetStoppingTimeOfLastSolve();
 }
 
 void AbstractOdeBasedCellCycleModel::OutputCellCycleModelParameters(out_stream& rParamsFile)
@@ -140,6 +140,15 @@ public:
      */
     virtual bool ReadyToDivide();
 
+    /**
+     * Overridden CanBatchSolveOdeToTime() method.
+     *
+     * @param currentTime  the time up to which the system would be solved
+     * @return whether the next call to ReadyToDivide() will solve the ODE system
+     * from #mLastTime to currentTime.
+     */
+    virtual bool CanBatchSolveOdeToTime(double currentTime);
+
     /**
      * For a naturally cycling model this does not need to be overridden in the
      * subclasses. But most models should override this function and then
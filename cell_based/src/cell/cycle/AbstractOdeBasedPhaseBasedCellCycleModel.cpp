@@ -156,14 +156,15 @@ void AbstractOdeBasedPhaseBasedCellCycleModel::ResetForDivision()
     mDivideTime = DBL_MAX;
 }
 
+bool AbstractOdeBasedPhaseBasedCellCycleModel::CanBatchSolveOdeToTime(double currentTime)
+{
+    return !mReadyToDivide && (mCurrentCellCyclePhase != M_PHASE) && !this->mFinishedRunningOdes
+           && (mpOdeSystem != nullptr) && (currentTime > mLastTime);
+}
+
 double AbstractOdeBasedPhaseBasedCellCycleModel::GetOdeStopTime()
 {
-    double stop_time = DOUBLE_UNSET;
-    if (mpOdeSolver->StoppingEventOccurred())
-    {
-        stop_time = mpOdeSolver->GetStoppingTime();
-    }
-    return stop_time;
+    return GetStoppingTimeOfLastSolve();
 }
 
 void AbstractOdeBasedPhaseBasedCellCycleModel::OutputCellCycleModelParameters(out_stream& rParamsFile)
@@ -128,6 +128,18 @@ public:
      */
     virtual void UpdateCellCyclePhase();
 
+    /**
+     * Overridden CanBatchSolveOdeToTime() method.
+     *
+     * Cells in M phase are not batched, since UpdateCellCyclePhase() may move them
+     * into G1 phase and reset #mLastTime before solving.
+     *
+     * @param currentTime  the time up to which the system would be solved
+     * @return whether the next call to UpdateCellCyclePhase() will solve the ODE
+     * system from #mLastTime to currentTime.
+     */
+    virtual bool CanBatchSolveOdeToTime(double currentTime);
+
     /**
      * Get the time at which the ODE stopping event occurred.
      * Only called in those subclasses for which stopping events
@@ -41,7 +41,10 @@ CellCycleModelOdeHandler::CellCycleModelOdeHandler(double lastTime,
       mpOdeSystem(nullptr),
       mpOdeSolver(pOdeSolver),
       mLastTime(lastTime),
-      mFinishedRunningOdes(false)
+      mFinishedRunningOdes(false),
+      mBatchSolvedToTime(DOUBLE_UNSET),
+      mBatchStoppingTime(DOUBLE_UNSET),
+      mLastSolveWasBatched(false)
 {
 }
 
@@ -58,7 +61,10 @@ CellCycleModelOdeHandler::CellCycleModelOdeHandler(const CellCycleModelOdeHandle
       mpOdeSystem(rHandler.mpOdeSystem),
       mpOdeSolver(rHandler.mpOdeSolver),
       mLastTime(rHandler.mLastTime),
-      mFinishedRunningOdes(rHandler.mFinishedRunningOdes)
+      mFinishedRunningOdes(rHandler.mFinishedRunningOdes),
+      mBatchSolvedToTime(DOUBLE_UNSET),
+      mBatchStoppingTime(DOUBLE_UNSET),
+      mLastSolveWasBatched(false)
 {
 }
 
@@ -101,6 +107,25 @@ double CellCycleModelOdeHandler::GetDt()
 bool CellCycleModelOdeHandler::SolveOdeToTime(double currentTime)
 {
     bool stopping_event_occurred = false;
+    mLastSolveWasBatched = false;
+
+    // Take up the result of a batched solve, if there is one
+    if (mBatchSolvedToTime != DOUBLE_UNSET)
+    {
+        double batch_solved_to_time = mBatchSolvedToTime;
+        mBatchSolvedToTime = DOUBLE_UNSET;
+
+        stopping_event_occurred = (mBatchStoppingTime != DOUBLE_UNSET);
+        mLastTime = stopping_event_occurred ? mBatchStoppingTime : batch_solved_to_time;
+        if (stopping_event_occurred || batch_solved_to_time >= currentTime)
+        {
+            mLastSolveWasBatched = true;
+            return stopping_event_occurred;
+        }
+
+        // The batched solve stopped short of this time, so solve the rest of the way as usual
+    }
+
     if (mLastTime < currentTime)
     {
         AdjustOdeParameters(currentTime);
@@ -120,10 +145,30 @@ bool CellCycleModelOdeHandler::SolveOdeToTime(double currentTime)
     return stopping_event_occurred;
 }
 
+double CellCycleModelOdeHandler::GetStoppingTimeOfLastSolve()
+{
+    if (mLastSolveWasBatched)
+    {
+        return mBatchStoppingTime;
+    }
+
+    double stop_time = DOUBLE_UNSET;
+    if (mpOdeSolver->StoppingEventOccurred())
+    {
+        stop_time = mpOdeSolver->GetStoppingTime();
+    }
+    return stop_time;
+}
+
 void CellCycleModelOdeHandler::AdjustOdeParameters(double currentTime)
 {
 }
 
+bool CellCycleModelOdeHandler::CanBatchSolveOdeToTime(double currentTime)
+{
+    return false;
+}
+
 void CellCycleModelOdeHandler::SetLastTime(double lastTime)
 {
     mLastTime = lastTime;
@@ -51,6 +51,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 class CellCycleModelOdeHandler
 {
+    /** Allow batched solves to update the ODE system and its pending result. */
+    friend class CellOdeBatchSolver;
+
 private:
 
     /** Needed for serialization. */
@@ -110,15 +113,42 @@ protected:
      */
     bool mFinishedRunningOdes;
 
+    /**
+     * The time to which the ODE system has been solved by a CellOdeBatchSolver,
+     * if that result has not yet been taken up by SolveOdeToTime(), and
+     * DOUBLE_UNSET otherwise. Not archived.
+     */
+    double mBatchSolvedToTime;
+
+    /**
+     * The time of the stopping event found by the last batched solve, or
+     * DOUBLE_UNSET if no stopping event occurred. Not archived.
+     */
+    double mBatchStoppingTime;
+
+    /** Whether the last call to SolveOdeToTime() used the result of a batched solve. Not archived. */
+    bool mLastSolveWasBatched;
+
     /**
      * Solves the ODE system to a given time.
      *
+     * If the system has already been solved by a CellOdeBatchSolver, the result of
+     * that solve is used instead. Should the batched solve have stopped short of this
+     * time (for example because the model was solved for a different time than the
+     * batch), the system is then solved on from there as usual.
+     *
      * @param currentTime the current time
      *
      * @return whether a stopping event occurred.
      */
     bool SolveOdeToTime(double currentTime);
 
+    /**
+     * @return the time at which the stopping event occurred during the last call
+     * to SolveOdeToTime(), or DOUBLE_UNSET if no stopping event occurred.
+     */
+    double GetStoppingTimeOfLastSolve();
+
     /**
      * Adjust any ODE parameters needed before solving until currentTime.
      * Defaults to do nothing.
@@ -143,6 +173,17 @@ public:
      */
     virtual ~CellCycleModelOdeHandler();
 
+    /**
+     * @return whether the next call to SolveOdeToTime() with the given time would
+     * solve the ODE system from #mLastTime, so that the solve may instead be done in
+     * a batch by CellOdeBatchSolver. Defaults to false; overridden by models whose
+     * solve does not depend on anything other than the ODE system and
+     * AdjustOdeParameters().
+     *
+     * @param currentTime  the time up to which the system would be solved
+     */
+    virtual bool CanBatchSolveOdeToTime(double currentTime);
+
     /**
      * @return #mpOdeSystem.
      */
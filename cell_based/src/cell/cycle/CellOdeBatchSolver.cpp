@@ -0,0 +1,275 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <map>
+#include <tuple>
+#include <typeindex>
+
+#include "CellOdeBatchSolver.hpp"
+#include "EulerIvpOdeSolver.hpp"
+#include "RungeKutta4IvpOdeSolver.hpp"
+#include "TimeStepper.hpp"
+
+CellOdeBatchSolver::CellOdeBatchSolver()
+    : mNumBatchedSystems(0),
+      mNumVariables(0)
+{
+}
+
+void CellOdeBatchSolver::Solve(const std::vector<CellCycleModelOdeHandler*>& rHandlers, double currentTime)
+{
+    mNumBatchedSystems = 0;
+
+    // Handlers can share a batch if they agree on the ODE system class, method, size, start time and time step
+    typedef std::tuple<std::type_index, unsigned, unsigned, double, double> BatchKey;
+    std::map<BatchKey, std::vector<CellCycleModelOdeHandler*> > batches;
+
+    for (std::vector<CellCycleModelOdeHandler*>::const_iterator iter = rHandlers.begin();
+         iter != rHandlers.end();
+         ++iter)
+    {
+        CellCycleModelOdeHandler* p_handler = *iter;
+        p_handler->mLastSolveWasBatched = false;
+
+        // A handler still holding the result of an earlier batched solve takes it up, and solves on from there, by itself
+        if (p_handler->mBatchSolvedToTime != DOUBLE_UNSET || !p_handler->CanBatchSolveOdeToTime(currentTime))
+        {
+            continue;
+        }
+
+        AbstractIvpOdeSolver* p_solver = p_handler->mpOdeSolver->GetIvpOdeSolver().get();
+        BatchMethod method;
+        if (dynamic_cast<RungeKutta4IvpOdeSolver*>(p_solver) != nullptr)
+        {
+            method = RUNGE_KUTTA_4;
+        }
+        else if (dynamic_cast<EulerIvpOdeSolver*>(p_solver) != nullptr)
+        {
+            method = EULER;
+        }
+        else
+        {
+            continue;
+        }
+
+        p_handler->AdjustOdeParameters(currentTime);
+
+        // A system whose stopping event is already true is left for SolveOdeToTime() to report
+        AbstractOdeSystem* p_system = p_handler->mpOdeSystem;
+        if (p_system->CalculateStoppingEvent(p_handler->mLastTime, p_system->rGetStateVariables()))
+        {
+            continue;
+        }
+
+        BatchKey key(std::type_index(typeid(*p_system)),
+                     method,
+                     p_system->GetNumberOfStateVariables(),
+                     p_handler->mLastTime,
+                     p_handler->GetDt());
+        batches[key].push_back(p_handler);
+    }
+
+    for (std::map<BatchKey, std::vector<CellCycleModelOdeHandler*> >::iterator iter = batches.begin();
+         iter != batches.end();
+         ++iter)
+    {
+        SolveBatch(iter->second,
+                   static_cast<BatchMethod>(std::get<1>(iter->first)),
+                   std::get<3>(iter->first),
+                   currentTime,
+                   std::get<4>(iter->first));
+        mNumBatchedSystems += iter->second.size();
+    }
+}
+
+void CellOdeBatchSolver::SolveBatch(const std::vector<CellCycleModelOdeHandler*>& rHandlers,
+                                    BatchMethod method,
+                                    double startTime,
+                                    double endTime,
+                                    double timeStep)
+{
+    mActiveHandlers = rHandlers;
+    mNumVariables = rHandlers[0]->mpOdeSystem->GetNumberOfStateVariables();
+    unsigned num_systems = mActiveHandlers.size();
+
+    mActiveSystems.resize(num_systems);
+    for (unsigned s=0; s<num_systems; s++)
+    {
+        mActiveSystems[s] = mActiveHandlers[s]->mpOdeSystem;
+    }
+
+    // Pack the state variables into struct-of-arrays form
+    std::vector<double> y(mNumVariables*num_systems);
+    for (unsigned s=0; s<num_systems; s++)
+    {
+        const std::vector<double>& r_state = mActiveHandlers[s]->mpOdeSystem->rGetStateVariables();
+        for (unsigned i=0; i<mNumVariables; i++)
+        {
+            y[i*num_systems + s] = r_state[i];
+        }
+    }
+
+    std::vector<double> next_y(y.size());
+    std::vector<double> dy(y.size());
+    std::vector<double> k1, k2, k3, yki;
+    if (method == RUNGE_KUTTA_4)
+    {
+        k1.resize(y.size());
+        k2.resize(y.size());
+        k3.resize(y.size());
+        yki.resize(y.size());
+    }
+
+    // Work vector holding the state of one system, for checking stopping events
+    std::vector<double> row(mNumVariables);
+
+    TimeStepper stepper(startTime, endTime, timeStep);
+    while (!stepper.IsTimeAtEnd() && num_systems > 0)
+    {
+        const double time = stepper.GetTime();
+        const double dt = stepper.GetNextTimeStep();
+        const unsigned size = mNumVariables*num_systems;
+
+        // These updates follow EulerIvpOdeSolver and RungeKutta4IvpOdeSolver exactly
+        EvaluateYDerivatives(time, y, dy);
+        if (method == EULER)
+        {
+            for (unsigned j=0; j<size; j++)
+            {
+                next_y[j] = y[j] + dt*dy[j];
+            }
+        }
+        else
+        {
+            for (unsigned j=0; j<size; j++)
+            {
+                k1[j] = dt*dy[j];
+                yki[j] = y[j] + 0.5*k1[j];
+            }
+            EvaluateYDerivatives(time + 0.5*dt, yki, dy);
+            for (unsigned j=0; j<size; j++)
+            {
+                k2[j] = dt*dy[j];
+                yki[j] = y[j] + 0.5*k2[j];
+            }
+            EvaluateYDerivatives(time + 0.5*dt, yki, dy);
+            for (unsigned j=0; j<size; j++)
+            {
+                k3[j] = dt*dy[j];
+                yki[j] = y[j] + k3[j];
+            }
+            EvaluateYDerivatives(time + dt, yki, dy);
+            for (unsigned j=0; j<size; j++)
+            {
+                next_y[j] = y[j] + (k1[j] + 2*k2[j] + 2*k3[j] + dt*dy[j])/6.0;
+            }
+        }
+        y.swap(next_y);
+        stepper.AdvanceOneTimeStep();
+
+        // Check for stopping events, writing back and dropping any system that has stopped
+        std::vector<unsigned> continuing_systems;
+        continuing_systems.reserve(num_systems);
+        for (unsigned s=0; s<num_systems; s++)
+        {
+            for (unsigned i=0; i<mNumVariables; i++)
+            {
+                row[i] = y[i*num_systems + s];
+            }
+
+            CellCycleModelOdeHandler* p_handler = mActiveHandlers[s];
+            if (p_handler->mpOdeSystem->CalculateStoppingEvent(stepper.GetTime(), row))
+            {
+                p_handler->mpOdeSystem->rGetStateVariables() = row;
+                p_handler->mBatchStoppingTime = stepper.GetTime();
+            }
+            else
+            {
+                continuing_systems.push_back(s);
+            }
+        }
+
+        if (continuing_systems.size() < num_systems)
+        {
+            // Repack the remaining systems so that the buffers stay contiguous
+            const unsigned num_continuing = continuing_systems.size();
+            std::vector<CellCycleModelOdeHandler*> continuing_handlers(num_continuing);
+            std::vector<AbstractOdeSystem*> continuing_ode_systems(num_continuing);
+            for (unsigned c=0; c<num_continuing; c++)
+            {
+                const unsigned s = continuing_systems[c];
+                continuing_handlers[c] = mActiveHandlers[s];
+                continuing_ode_systems[c] = mActiveSystems[s];
+                for (unsigned i=0; i<mNumVariables; i++)
+                {
+                    next_y[i*num_continuing + c] = y[i*num_systems + s];
+                }
+            }
+            y.swap(next_y);
+            mActiveHandlers.swap(continuing_handlers);
+            mActiveSystems.swap(continuing_ode_systems);
+            num_systems = num_continuing;
+        }
+    }
+
+    // Write back the systems that reached the end time
+    for (unsigned s=0; s<num_systems; s++)
+    {
+        std::vector<double>& r_state = mActiveHandlers[s]->mpOdeSystem->rGetStateVariables();
+        for (unsigned i=0; i<mNumVariables; i++)
+        {
+            r_state[i] = y[i*num_systems + s];
+        }
+        mActiveHandlers[s]->mBatchStoppingTime = DOUBLE_UNSET;
+    }
+
+    for (unsigned s=0; s<rHandlers.size(); s++)
+    {
+        rHandlers[s]->mBatchSolvedToTime = endTime;
+    }
+    mActiveHandlers.clear();
+    mActiveSystems.clear();
+}
+
+void CellOdeBatchSolver::EvaluateYDerivatives(double time, const std::vector<double>& rY, std::vector<double>& rDy)
+{
+    // All the systems in a batch are of the same class
+    mActiveSystems[0]->EvaluateYDerivativesBatch(time, mActiveSystems, rY, rDy);
+}
+
+unsigned CellOdeBatchSolver::GetNumBatchedSystems() const
+{
+    return mNumBatchedSystems;
+}
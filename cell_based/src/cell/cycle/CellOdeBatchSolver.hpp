@@ -0,0 +1,140 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef CELLODEBATCHSOLVER_HPP_
+#define CELLODEBATCHSOLVER_HPP_
+
+#include <vector>
+
+#include "CellCycleModelOdeHandler.hpp"
+
+/**
+ * A solver that advances the ODE systems of many cell-cycle or SRN models together.
+ *
+ * Handlers whose ODE systems are of the same class, have the same number of state
+ * variables, and are to be solved from the same start time with the same fixed-step
+ * method (forward Euler or fourth-order Runge-Kutta) and time step are grouped into
+ * a batch. The state variables of a batch are packed into a struct-of-arrays buffer,
+ * so that the stage updates of each step are simple loops over contiguous memory,
+ * and the right-hand sides of the systems in a batch are evaluated together by
+ * AbstractOdeSystem::EvaluateYDerivativesBatch(). Unless the ODE system class provides
+ * a vectorised version, this evaluates each system in turn in a threaded loop (see
+ * ThreadingTools). The arithmetic of each step is identical to that of
+ * EulerIvpOdeSolver and RungeKutta4IvpOdeSolver, so results match solving each
+ * system separately.
+ *
+ * Handlers that cannot be batched (for example because they use an adaptive solver
+ * such as CVODE) are left untouched, and are solved as usual the next time the model
+ * calls SolveOdeToTime(). Handlers that are batched keep the result of the solve, and
+ * hand it back to the model when it next calls SolveOdeToTime() for the same time.
+ */
+class CellOdeBatchSolver
+{
+private:
+
+    /** The fixed-step methods that may be used for a batch. */
+    enum BatchMethod
+    {
+        EULER,
+        RUNGE_KUTTA_4
+    };
+
+    /** The number of ODE systems solved in batches by the last call to Solve(). */
+    unsigned mNumBatchedSystems;
+
+    /** The number of state variables of each ODE system in the current batch. */
+    unsigned mNumVariables;
+
+    /** The handlers in the current batch that have not yet had a stopping event. */
+    std::vector<CellCycleModelOdeHandler*> mActiveHandlers;
+
+    /** The ODE systems of #mActiveHandlers. */
+    std::vector<AbstractOdeSystem*> mActiveSystems;
+
+    /**
+     * Evaluate the derivatives of every active system in the current batch.
+     *
+     * Both vectors are stored as struct-of-arrays, so that variable i of system s
+     * is held at entry i*num_systems + s.
+     *
+     * @param time  the time at which to evaluate the derivatives
+     * @param rY  the state variables of the batch
+     * @param rDy  filled in with the derivatives of the batch
+     */
+    void EvaluateYDerivatives(double time, const std::vector<double>& rY, std::vector<double>& rDy);
+
+    /**
+     * Solve the ODE systems of a batch of handlers from startTime to endTime.
+     *
+     * @param rHandlers  the handlers in the batch
+     * @param method  the fixed-step method to use
+     * @param startTime  the time from which to solve
+     * @param endTime  the time to which to solve
+     * @param timeStep  the time step to use
+     */
+    void SolveBatch(const std::vector<CellCycleModelOdeHandler*>& rHandlers,
+                    BatchMethod method,
+                    double startTime,
+                    double endTime,
+                    double timeStep);
+
+public:
+
+    /**
+     * Constructor.
+     */
+    CellOdeBatchSolver();
+
+    /**
+     * Solve the ODE systems of as many of the given handlers as possible to the
+     * given time, in batches.
+     *
+     * A handler is only included if CanBatchSolveOdeToTime() returns true for it,
+     * in which case it should call SolveOdeToTime() with the same time before it is
+     * next solved. A handler that has not done so is left out, and solves on from
+     * the batched result by itself when it next calls SolveOdeToTime().
+     *
+     * @param rHandlers  the ODE handlers (cell-cycle or SRN models) to solve
+     * @param currentTime  the time to which to solve
+     */
+    void Solve(const std::vector<CellCycleModelOdeHandler*>& rHandlers, double currentTime);
+
+    /**
+     * @return the number of ODE systems solved in batches by the last call to Solve().
+     */
+    unsigned GetNumBatchedSystems() const;
+};
+
+#endif /*CELLODEBATCHSOLVER_HPP_*/
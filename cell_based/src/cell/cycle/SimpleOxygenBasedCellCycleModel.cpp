@@ -67,7 +67,7 @@ void SimpleOxygenBasedCellCycleModel::UpdateCellCyclePhase()
         UpdateHypoxicDuration();
 
         // Get cell's oxygen concentration
-        double oxygen_concentration = mpCell->GetCellData()->GetItem("oxygen");
+        double oxygen_concentration = mpCell->GetCellData()->GetItem(CellDataKeyRegistry::OXYGEN_KEY);
 
         AbstractSimplePhaseBasedCellCycleModel::UpdateCellCyclePhase();
 
@@ -119,7 +119,7 @@ void SimpleOxygenBasedCellCycleModel::UpdateHypoxicDuration()
     assert(!mpCell->HasApoptosisBegun());
 
     // Get cell's oxygen concentration
-    double oxygen_concentration = mpCell->GetCellData()->GetItem("oxygen");
+    double oxygen_concentration = mpCell->GetCellData()->GetItem(CellDataKeyRegistry::OXYGEN_KEY);
 
     if (oxygen_concentration < mHypoxicConcentration)
     {
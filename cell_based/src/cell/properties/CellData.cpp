@@ -33,64 +33,90 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 */
 
+#include <algorithm>
+
 #include "CellData.hpp"
 
+CellData::CellData()
+    : AbstractCellProperty(),
+      mNumItems(0)
+{
+}
+
 CellData::~CellData()
 {
 }
 
 void CellData::SetItem(const std::string& rVariableName, double data)
 {
-    mCellData[rVariableName] = data;
+    SetItem(CellDataKeyRegistry::Instance()->GetKey(rVariableName), data);
+}
+
+void CellData::SetItem(unsigned key, double data)
+{
+    if (key >= mValues.size())
+    {
+        mValues.resize(key + 1, 0.0);
+        mIsStored.resize(key + 1, false);
+    }
+    if (!mIsStored[key])
+    {
+        mIsStored[key] = true;
+        mNumItems++;
+    }
+    mValues[key] = data;
 }
 
 double CellData::GetItem(const std::string& rVariableName) const
 {
-    /*
-     * Note that mCellData[rVariableName] is not const. If rVariableName is not
-     * a key, then mCellData[rVariableName] will create a new item in the map
-     * and increase the size by one.  Using a const_iterator ensures that the
-     * map remains const.
-     */
-    std::map<std::string, double>::const_iterator it = mCellData.find(rVariableName);
-    if (it == mCellData.end())
+    unsigned key = CellDataKeyRegistry::Instance()->FindKey(rVariableName);
+    if (!HasItem(key))
     {
         EXCEPTION("The item " << rVariableName << " is not stored");
     }
-    return(it->second);
+    return mValues[key];
+}
+
+double CellData::GetItem(unsigned key) const
+{
+    if (!HasItem(key))
+    {
+        EXCEPTION("The item " << CellDataKeyRegistry::Instance()->rGetName(key) << " is not stored");
+    }
+    return mValues[key];
 }
 
 unsigned CellData::GetNumItems() const
 {
-    return mCellData.size();
+    return mNumItems;
 }
 
 std::vector<std::string> CellData::GetKeys() const
 {
     std::vector<std::string> keys;
-    for (std::map<std::string, double>::const_iterator it = mCellData.begin(); it != mCellData.end(); ++it)
+    keys.reserve(mNumItems);
+    for (unsigned key=0; key<mValues.size(); key++)
     {
-        keys.push_back(it->first);
+        if (mIsStored[key])
+        {
+            keys.push_back(CellDataKeyRegistry::Instance()->rGetName(key));
+        }
     }
 
-    // From STL documentation we assume that the iterator is returning sorted keys sort(keys.begin(), keys.end());
+    // Keys are interned in order of first use, so sort to give a predictable ordering
+    std::sort(keys.begin(), keys.end());
     return keys;
 }
 
 bool CellData::HasItem(const std::string& rVariableName) const
 {
-    /*
-     * Note that mCellData[rVariableName] is not const. If rVariableName is not
-     * a key, then mCellData[rVariableName] will create a new item in the map
-     * and increase the size by one.  Using a const_iterator ensures that the
-     * map remains const.
-     */
-    std::map<std::string, double>::const_iterator it = mCellData.find(rVariableName);
-    if (it == mCellData.end())
-    {
-        return false;
-    }
-    return true;
+    return HasItem(CellDataKeyRegistry::Instance()->FindKey(rVariableName));
+}
+
+bool CellData::HasItem(unsigned key) const
+{
+    // Note that UNSIGNED_UNSET, returned by CellDataKeyRegistry::FindKey() for unknown names, is never a valid index
+    return (key < mValues.size() && mIsStored[key]);
 }
 
 #include "SerializationExportWrapperForCpp.hpp"
@@ -42,9 +42,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 
 #include "AbstractCellProperty.hpp"
+#include "CellDataKeyRegistry.hpp"
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/map.hpp>
+#include <boost/serialization/split_member.hpp>
 #include "Exception.hpp"
 
 /**
@@ -54,6 +56,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * for example corresponding to the intracellular oxygen concentration. Other classes may interrogate
  * or modify the values stored in this class.
  *
+ * Item names are interned by CellDataKeyRegistry and the values are stored in a dense vector
+ * indexed by the resulting keys. Classes that access the same item for many cells may obtain
+ * its key once, using CellDataKeyRegistry::Instance()->GetKey(), and then use the key-based
+ * overloads of SetItem(), GetItem() and HasItem().
+ *
  * Within the Cell constructor, an empty CellData object is created and passed to the Cell
  * (unless there is already a CellData object present in mCellPropertyCollection).
  */
@@ -62,27 +69,78 @@ class CellData : public AbstractCellProperty
 private:
 
     /**
-     * The cell data.
+     * The cell data, indexed by the keys assigned by CellDataKeyRegistry.
+     */
+    std::vector<double> mValues;
+
+    /**
+     * Whether each entry of mValues has been set.
+     */
+    std::vector<bool> mIsStored;
+
+    /**
+     * The number of data items stored.
      */
-    std::map<std::string, double> mCellData;
+    unsigned mNumItems;
 
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
-     * Archive the member variables.
+     * Save the member variables.
+     *
+     * The data are archived by name rather than by key, since keys depend on
+     * the order in which names were interned.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void save(Archive & archive, const unsigned int version) const
+    {
+        archive & boost::serialization::base_object<AbstractCellProperty>(*this);
+
+        std::map<std::string, double> cell_data;
+        for (unsigned key=0; key<mValues.size(); key++)
+        {
+            if (mIsStored[key])
+            {
+                cell_data[CellDataKeyRegistry::Instance()->rGetName(key)] = mValues[key];
+            }
+        }
+        archive & cell_data;
+    }
+
+    /**
+     * Load the member variables.
      *
      * @param archive the archive
      * @param version the current version of this class
      */
     template<class Archive>
-    void serialize(Archive & archive, const unsigned int version)
+    void load(Archive & archive, const unsigned int version)
     {
         archive & boost::serialization::base_object<AbstractCellProperty>(*this);
-        archive & mCellData;
+
+        std::map<std::string, double> cell_data;
+        archive & cell_data;
+
+        mValues.clear();
+        mIsStored.clear();
+        mNumItems = 0;
+        for (std::map<std::string, double>::const_iterator it = cell_data.begin(); it != cell_data.end(); ++it)
+        {
+            SetItem(it->first, it->second);
+        }
     }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
 
 public:
 
+    /**
+     * Default constructor.
+     */
+    CellData();
+
     /**
      * We need the empty virtual destructor in this class to ensure Boost
      * serialization works correctly with static libraries.
@@ -97,6 +155,14 @@ public:
      */
     void SetItem(const std::string& rVariableName, double data);
 
+    /**
+     * This assigns the cell data.
+     *
+     * @param key the key of the data to be set, as returned by CellDataKeyRegistry::GetKey().
+     * @param data the value to set it to.
+     */
+    void SetItem(unsigned key, double data);
+
     /**
      * @return data.
      *
@@ -105,6 +171,14 @@ public:
      */
     double GetItem(const std::string& rVariableName) const;
 
+    /**
+     * @return data.
+     *
+     * @param key the key of the data required, as returned by CellDataKeyRegistry::GetKey().
+     * throws if no data has been stored with this key
+     */
+    double GetItem(unsigned key) const;
+
     /**
      * @return number of data items
      */
@@ -113,7 +187,7 @@ public:
     /**
      * @return all keys.
      *
-     * According to STL these are sorted in lexicographical/alphabetic order (so that the ordering here is predictable).
+     * These are sorted in lexicographical/alphabetic order (so that the ordering here is predictable).
      */
     std::vector<std::string> GetKeys() const;
 
@@ -125,6 +199,15 @@ public:
      * @return if rVariableName has been stored
      */
     bool HasItem(const std::string& rVariableName) const;
+
+    /**
+     * Check if data with given key is stored.
+     *
+     * @param key the key of the data required, as returned by CellDataKeyRegistry::GetKey().
+     *
+     * @return if data has been stored with this key
+     */
+    bool HasItem(unsigned key) const;
 };
 
 #include "SerializationExportWrapper.hpp"
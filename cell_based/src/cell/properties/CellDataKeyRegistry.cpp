@@ -0,0 +1,118 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <cassert>
+
+#include "CellDataKeyRegistry.hpp"
+#include "Exception.hpp"
+
+const unsigned CellDataKeyRegistry::OXYGEN_KEY;
+
+std::atomic<CellDataKeyRegistry*> CellDataKeyRegistry::mpInstance(nullptr);
+
+std::mutex CellDataKeyRegistry::mInstanceMutex;
+
+CellDataKeyRegistry* CellDataKeyRegistry::Instance()
+{
+    CellDataKeyRegistry* p_instance = mpInstance.load();
+    if (p_instance == nullptr)
+    {
+        std::lock_guard<std::mutex> lock(mInstanceMutex);
+        p_instance = mpInstance.load();
+        if (p_instance == nullptr)
+        {
+            p_instance = new CellDataKeyRegistry;
+            mpInstance.store(p_instance);
+        }
+    }
+    return p_instance;
+}
+
+void CellDataKeyRegistry::Destroy()
+{
+    std::lock_guard<std::mutex> lock(mInstanceMutex);
+    CellDataKeyRegistry* p_instance = mpInstance.exchange(nullptr);
+    if (p_instance)
+    {
+        delete p_instance;
+    }
+}
+
+CellDataKeyRegistry::CellDataKeyRegistry()
+{
+    // Pre-register the items read by the cell-cycle models, so that their keys can be constants
+    unsigned oxygen_key = GetKey("oxygen");
+    assert(oxygen_key == OXYGEN_KEY);
+    UNUSED_OPT(oxygen_key);
+}
+
+unsigned CellDataKeyRegistry::GetKey(const std::string& rName)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::unordered_map<std::string, unsigned>::const_iterator it = mKeys.find(rName);
+    if (it != mKeys.end())
+    {
+        return it->second;
+    }
+
+    unsigned key = mNames.size();
+    mKeys[rName] = key;
+    mNames.push_back(rName);
+    return key;
+}
+
+unsigned CellDataKeyRegistry::FindKey(const std::string& rName) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    std::unordered_map<std::string, unsigned>::const_iterator it = mKeys.find(rName);
+    if (it == mKeys.end())
+    {
+        return UNSIGNED_UNSET;
+    }
+    return it->second;
+}
+
+const std::string& CellDataKeyRegistry::rGetName(unsigned key) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    assert(key < mNames.size());
+    return mNames[key];
+}
+
+unsigned CellDataKeyRegistry::GetNumKeys() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mNames.size();
+}
@@ -0,0 +1,151 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef CELLDATAKEYREGISTRY_HPP_
+#define CELLDATAKEYREGISTRY_HPP_
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * A singleton registry that interns the names of CellData items.
+ *
+ * Each distinct item name is assigned a small integer key the first time it
+ * is seen. CellData stores its values in a dense vector indexed by these keys,
+ * so classes that access the same item for many cells each time step (such as
+ * PDE modifiers and oxygen-based cell-cycle models) can look the key up once
+ * and then use the key-based CellData methods, avoiding string construction
+ * and comparison on every access.
+ *
+ * Keys are never removed or reused, so a key remains valid until the registry
+ * is destroyed by Destroy(). Item names used by the cell-cycle models, such as
+ * "oxygen", are registered when the registry is created and so always have the
+ * same key. The registry is not archived: CellData archives its items by name,
+ * and names are re-interned on load.
+ *
+ * All methods are safe to call from several threads at once.
+ */
+class CellDataKeyRegistry
+{
+public:
+
+    /**
+     * @return the single instance of the registry.
+     */
+    static CellDataKeyRegistry* Instance();
+
+    /**
+     * Destroy the current instance of the registry. Keys obtained from it,
+     * other than those of pre-registered names such as OXYGEN_KEY, must not
+     * be used afterwards, and nor must any CellData created while it existed.
+     * This is intended for use in test tearDown() methods.
+     */
+    static void Destroy();
+
+    /** The key of the "oxygen" item, which is registered when the registry is created. */
+    static const unsigned OXYGEN_KEY = 0;
+
+    /**
+     * Get the key for a given item name, interning the name if it has not
+     * been seen before.
+     *
+     * @param rName the name of the CellData item
+     * @return the key associated with rName
+     */
+    unsigned GetKey(const std::string& rName);
+
+    /**
+     * Get the key for a given item name without interning it.
+     *
+     * @param rName the name of the CellData item
+     * @return the key associated with rName, or UNSIGNED_UNSET if rName has
+     *     not been interned
+     */
+    unsigned FindKey(const std::string& rName) const;
+
+    /**
+     * @param key a key previously returned by GetKey()
+     * @return the item name associated with key
+     */
+    const std::string& rGetName(unsigned key) const;
+
+    /**
+     * @return the number of item names interned so far.
+     */
+    unsigned GetNumKeys() const;
+
+private:
+
+    /**
+     * Default constructor.
+     */
+    CellDataKeyRegistry();
+
+    /**
+     * Copy constructor.
+     */
+    CellDataKeyRegistry(const CellDataKeyRegistry&);
+
+    /**
+     * Overloaded assignment operator.
+     * @return reference by convention
+     */
+    CellDataKeyRegistry& operator= (const CellDataKeyRegistry&);
+
+    /**
+     * A pointer to the singleton instance of this class.
+     */
+    static std::atomic<CellDataKeyRegistry*> mpInstance;
+
+    /** Guards the creation and destruction of the singleton instance. */
+    static std::mutex mInstanceMutex;
+
+    /** Guards mKeys and mNames. */
+    mutable std::mutex mMutex;
+
+    /** Map from item name to key. */
+    std::unordered_map<std::string, unsigned> mKeys;
+
+    /**
+     * Item names, indexed by key. A deque is used so that the references returned
+     * by rGetName() are not invalidated when new names are interned.
+     */
+    std::deque<std::string> mNames;
+};
+
+#endif /* CELLDATAKEYREGISTRY_HPP_ */
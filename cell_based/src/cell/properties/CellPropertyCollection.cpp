@@ -36,7 +36,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "CellPropertyCollection.hpp"
 
 CellPropertyCollection::CellPropertyCollection()
-    : mpCellPropertyRegistry(nullptr)
+    : mpCellPropertyRegistry(nullptr),
+      mTypeMask(0),
+      mHasUnmaskedProperties(false)
 {
 }
 
@@ -65,6 +67,16 @@ void CellPropertyCollection::AddProperty(const boost::shared_ptr<AbstractCellPro
         EXCEPTION("That property object is already in the collection.");
     }
     mProperties.insert(rProp);
+
+    unsigned type_index = CellPropertyRegistry::GetTypeIndex(rProp);
+    if (type_index < CellPropertyRegistry::NUM_MASKED_TYPES)
+    {
+        mTypeMask |= (uint64_t(1) << type_index);
+    }
+    else
+    {
+        mHasUnmaskedProperties = true;
+    }
 }
 
 bool CellPropertyCollection::HasProperty(const boost::shared_ptr<AbstractCellProperty>& rProp) const
@@ -82,6 +94,7 @@ void CellPropertyCollection::RemoveProperty(const boost::shared_ptr<AbstractCell
     else
     {
         mProperties.erase(it);
+        UpdateTypeMask();
     }
 }
 
@@ -111,3 +124,21 @@ boost::shared_ptr<AbstractCellProperty> CellPropertyCollection::GetProperty() co
         EXCEPTION("Can only call GetProperty on a collection of size 1.");
     }
 }
+
+void CellPropertyCollection::UpdateTypeMask()
+{
+    mTypeMask = 0;
+    mHasUnmaskedProperties = false;
+    for (ConstIteratorType it = mProperties.begin(); it != mProperties.end(); ++it)
+    {
+        unsigned type_index = CellPropertyRegistry::GetTypeIndex(*it);
+        if (type_index < CellPropertyRegistry::NUM_MASKED_TYPES)
+        {
+            mTypeMask |= (uint64_t(1) << type_index);
+        }
+        else
+        {
+            mHasUnmaskedProperties = true;
+        }
+    }
+}
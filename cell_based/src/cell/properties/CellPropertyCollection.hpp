@@ -36,12 +36,15 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef CELLPROPERTYCOLLECTION_HPP_
 #define CELLPROPERTYCOLLECTION_HPP_
 
+#include <cstdint>
 #include <set>
+#include <typeinfo>
 #include <boost/shared_ptr.hpp>
 
 #include "ChasteSerialization.hpp"
 #include <boost/serialization/shared_ptr.hpp>
 #include <boost/serialization/set.hpp>
+#include <boost/serialization/split_member.hpp>
 
 #include "AbstractCellProperty.hpp"
 #include "CellPropertyRegistry.hpp"
@@ -51,6 +54,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * Cell property collection class.
  *
  * Contains methods for accessing and interrogating a set of cell properties.
+ *
+ * Alongside the set of properties, the collection keeps a bit mask of the types of
+ * property it contains, using the type indices assigned by CellPropertyRegistry, so
+ * that HasProperty() and HasPropertyType() are usually a single bitwise AND.
  */
 class CellPropertyCollection
 {
@@ -70,21 +77,53 @@ private:
     /** Cell property registry. */
     CellPropertyRegistry* mpCellPropertyRegistry;
 
+    /**
+     * Bit mask of the types of property in this collection. Bit i is set if the
+     * collection contains a property whose class has type index i.
+     */
+    uint64_t mTypeMask;
+
+    /**
+     * Whether the collection contains a property whose type index is too large to
+     * be represented in mTypeMask, in which case HasPropertyType() must scan.
+     */
+    bool mHasUnmaskedProperties;
+
+    /**
+     * Recompute mTypeMask and mHasUnmaskedProperties from mProperties.
+     */
+    void UpdateTypeMask();
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
-     * Save/load our member variables.
+     * Save our member variables.
      *
      * @param archive the archive
      * @param version the current version of this class
      */
     template<class Archive>
-    void serialize(Archive & archive, const unsigned int version)
+    void save(Archive & archive, const unsigned int version) const
     {
         archive & mProperties;
         // archive & mpCellPropertyRegistry; Not required as archived by the CellPopulation.
     }
 
+    /**
+     * Load our member variables. The type mask is not archived, since type
+     * indices depend on the order in which property classes are first seen.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void load(Archive & archive, const unsigned int version)
+    {
+        archive & mProperties;
+        UpdateTypeMask();
+    }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
+
 public:
     /**
      * Create an empty collection of cell properties.
@@ -126,6 +165,12 @@ public:
     template<typename CLASS>
     bool HasProperty() const
     {
+        static const unsigned type_index = CellPropertyRegistry::GetTypeIndex(typeid(CLASS));
+        if (type_index < CellPropertyRegistry::NUM_MASKED_TYPES)
+        {
+            return (mTypeMask & (uint64_t(1) << type_index)) != 0;
+        }
+
         for (ConstIteratorType it = mProperties.begin(); it != mProperties.end(); ++it)
         {
             if ((*it)->IsType<CLASS>())
@@ -145,6 +190,30 @@ public:
     template<typename BASECLASS>
     bool HasPropertyType() const
     {
+        uint64_t unchecked_types = mTypeMask & ~CellPropertyRegistry::GetCheckedTypeMask<BASECLASS>();
+        if (unchecked_types != 0)
+        {
+            // Some of our property types have not yet been checked against BASECLASS
+            for (ConstIteratorType it = mProperties.begin(); it != mProperties.end(); ++it)
+            {
+                unsigned type_index = CellPropertyRegistry::GetTypeIndex(*it);
+                if (type_index < CellPropertyRegistry::NUM_MASKED_TYPES
+                    && (unchecked_types & (uint64_t(1) << type_index)) != 0)
+                {
+                    CellPropertyRegistry::RecordSubType<BASECLASS>(type_index, (*it)->IsSubType<BASECLASS>());
+                }
+            }
+        }
+
+        if ((mTypeMask & CellPropertyRegistry::GetSubTypeMask<BASECLASS>()) != 0)
+        {
+            return true;
+        }
+        if (!mHasUnmaskedProperties)
+        {
+            return false;
+        }
+
         for (ConstIteratorType it = mProperties.begin(); it != mProperties.end(); ++it)
         {
             if ((*it)->IsSubType<BASECLASS>())
@@ -166,6 +235,7 @@ public:
             if ((*it)->IsType<CLASS>())
             {
                 mProperties.erase(it);
+                UpdateTypeMask();
                 return;
             }
         }
@@ -214,6 +284,10 @@ public:
     CellPropertyCollection GetProperties() const
     {
         CellPropertyCollection result;
+        if (!HasProperty<CLASS>())
+        {
+            return result;
+        }
         for (ConstIteratorType it = mProperties.begin(); it != mProperties.end(); ++it)
         {
             if ((*it)->IsType<CLASS>())
@@ -232,6 +306,10 @@ public:
     CellPropertyCollection GetPropertiesType() const
     {
         CellPropertyCollection result;
+        if (!HasPropertyType<BASECLASS>())
+        {
+            return result;
+        }
         for (ConstIteratorType it = mProperties.begin(); it != mProperties.end(); ++it)
         {
             if ((*it)->IsSubType<BASECLASS>())
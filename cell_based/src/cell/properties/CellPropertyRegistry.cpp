@@ -34,12 +34,17 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include <algorithm>
+#include <cassert>
 
 #include "CellPropertyRegistry.hpp"
 #include "Exception.hpp"
 
 CellPropertyRegistry* CellPropertyRegistry::mpInstance = nullptr;
 
+std::unordered_map<std::type_index, unsigned> CellPropertyRegistry::mTypeIndices;
+
+std::mutex CellPropertyRegistry::mTypeMutex;
+
 CellPropertyRegistry* CellPropertyRegistry::Instance()
 {
     if (mpInstance == nullptr)
@@ -97,3 +102,23 @@ bool CellPropertyRegistry::HasOrderingBeenSpecified()
 {
     return mOrderingHasBeenSpecified;
 }
+
+unsigned CellPropertyRegistry::GetTypeIndex(const std::type_info& rType)
+{
+    std::lock_guard<std::mutex> lock(mTypeMutex);
+    std::unordered_map<std::type_index, unsigned>::const_iterator it = mTypeIndices.find(std::type_index(rType));
+    if (it != mTypeIndices.end())
+    {
+        return it->second;
+    }
+
+    unsigned index = mTypeIndices.size();
+    mTypeIndices[std::type_index(rType)] = index;
+    return index;
+}
+
+unsigned CellPropertyRegistry::GetTypeIndex(const boost::shared_ptr<AbstractCellProperty>& rProp)
+{
+    assert(rProp);
+    return GetTypeIndex(typeid(*rProp));
+}
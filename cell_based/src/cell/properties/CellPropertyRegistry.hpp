@@ -36,7 +36,13 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef CELLPROPERTYREGISTRY_HPP_
 #define CELLPROPERTYREGISTRY_HPP_
 
+#include <atomic>
 #include <boost/shared_ptr.hpp>
+#include <cstdint>
+#include <mutex>
+#include <typeindex>
+#include <typeinfo>
+#include <unordered_map>
 #include <vector>
 
 #include "AbstractCellProperty.hpp"
@@ -47,10 +53,21 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 /**
  * A singleton registry of available cell properties.
+ *
+ * The registry also assigns each cell property type a small integer type index the
+ * first time it is seen. These indices are shared by all registries, and are used by
+ * CellPropertyCollection to keep a bit mask of the property types it contains, so
+ * that queries such as Cell::HasCellProperty() do not need to scan the collection.
  */
 class CellPropertyRegistry
 {
 public:
+    /**
+     * The number of cell property types that can be represented in a type mask.
+     * Types with larger indices are still supported, but are queried by scanning.
+     */
+    static const unsigned NUM_MASKED_TYPES = 64;
+
     /**
      * The main interface to this class.
      * @return a particular cell property object.
@@ -102,6 +119,52 @@ public:
      */
     bool HasOrderingBeenSpecified();
 
+    /**
+     * Get the type index of a cell property class, assigning one if the class
+     * has not been seen before.
+     *
+     * @param rType  the type of the cell property class
+     * @return the type index
+     */
+    static unsigned GetTypeIndex(const std::type_info& rType);
+
+    /**
+     * Get the type index of the run-time class of a cell property object,
+     * assigning one if the class has not been seen before.
+     *
+     * @param rProp  the cell property
+     * @return the type index
+     */
+    static unsigned GetTypeIndex(const boost::shared_ptr<AbstractCellProperty>& rProp);
+
+    /**
+     * Record whether the cell property type with a given index is BASECLASS or
+     * a subclass of BASECLASS. Only types with index less than NUM_MASKED_TYPES
+     * are recorded. Since a type can only be checked given an object of that
+     * type, this is called by CellPropertyCollection::HasPropertyType() for its
+     * own properties, rather than the registry keeping objects of each type.
+     *
+     * @param typeIndex  the type index of a cell property class
+     * @param isSubType  whether that class is BASECLASS or inherits from it
+     */
+    template<typename BASECLASS>
+    static void RecordSubType(unsigned typeIndex, bool isSubType);
+
+    /**
+     * @return a bit mask with bit i set if the cell property type with index i
+     * has been checked against BASECLASS by RecordSubType().
+     */
+    template<typename BASECLASS>
+    static uint64_t GetCheckedTypeMask();
+
+    /**
+     * @return a bit mask with bit i set if the cell property type with index i
+     * has been found to be BASECLASS or a subclass of BASECLASS. Only types
+     * included in GetCheckedTypeMask() can be set.
+     */
+    template<typename BASECLASS>
+    static uint64_t GetSubTypeMask();
+
 private:
 
     /**
@@ -133,6 +196,30 @@ private:
     /** Whether an ordering has been set up */
     bool mOrderingHasBeenSpecified;
 
+    /** The type index assigned to each cell property class. */
+    static std::unordered_map<std::type_index, unsigned> mTypeIndices;
+
+    /** Guards mTypeIndices, which may be queried from several threads. */
+    static std::mutex mTypeMutex;
+
+    /**
+     * The type masks recorded for a base class by RecordSubType().
+     */
+    struct SubTypeMasks
+    {
+        /** Bit i is set if the type with index i has been checked. */
+        std::atomic<uint64_t> mChecked;
+
+        /** Bit i is set if the type with index i is the base class or a subclass of it. */
+        std::atomic<uint64_t> mSubTypes;
+    };
+
+    /**
+     * @return the type masks recorded for BASECLASS.
+     */
+    template<typename BASECLASS>
+    static SubTypeMasks& rGetSubTypeMasks();
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -170,4 +257,40 @@ boost::shared_ptr<AbstractCellProperty> CellPropertyRegistry::Get()
     return p_property;
 }
 
+template<typename BASECLASS>
+CellPropertyRegistry::SubTypeMasks& CellPropertyRegistry::rGetSubTypeMasks()
+{
+    // Zero-initialised, as it has static storage duration
+    static SubTypeMasks masks;
+    return masks;
+}
+
+template<typename BASECLASS>
+void CellPropertyRegistry::RecordSubType(unsigned typeIndex, bool isSubType)
+{
+    if (typeIndex < NUM_MASKED_TYPES)
+    {
+        SubTypeMasks& r_masks = rGetSubTypeMasks<BASECLASS>();
+
+        // Set the subtype bit first, so that a type is never seen as checked without it
+        if (isSubType)
+        {
+            r_masks.mSubTypes.fetch_or(uint64_t(1) << typeIndex);
+        }
+        r_masks.mChecked.fetch_or(uint64_t(1) << typeIndex);
+    }
+}
+
+template<typename BASECLASS>
+uint64_t CellPropertyRegistry::GetCheckedTypeMask()
+{
+    return rGetSubTypeMasks<BASECLASS>().mChecked.load();
+}
+
+template<typename BASECLASS>
+uint64_t CellPropertyRegistry::GetSubTypeMask()
+{
+    return rGetSubTypeMasks<BASECLASS>().mSubTypes.load();
+}
+
 #endif /* CELLPROPERTYREGISTRY_HPP_ */
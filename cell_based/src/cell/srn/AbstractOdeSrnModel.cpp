@@ -68,6 +68,11 @@ AbstractOdeSrnModel::~AbstractOdeSrnModel()
 {
 }
 
+bool AbstractOdeSrnModel::CanBatchSolveOdeToTime(double currentTime)
+{
+    return !this->mFinishedRunningOdes && (mpOdeSystem != nullptr) && (currentTime > mLastTime);
+}
+
 void AbstractOdeSrnModel::SimulateToCurrentTime()
 {
     assert(mpOdeSystem != nullptr);
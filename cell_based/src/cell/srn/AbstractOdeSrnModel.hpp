@@ -133,6 +133,15 @@ public:
      */
     virtual void SimulateToCurrentTime();
 
+    /**
+     * Overridden CanBatchSolveOdeToTime() method.
+     *
+     * @param currentTime  the time up to which the system would be solved
+     * @return whether the next call to SimulateToCurrentTime() will solve the ODE
+     * system from #mLastTime to currentTime.
+     */
+    virtual bool CanBatchSolveOdeToTime(double currentTime);
+
      /**
      * For a naturally cycling model this does not need to be overridden in the
      * subclasses. But most models should override this function and then
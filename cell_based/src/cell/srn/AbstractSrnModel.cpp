@@ -34,6 +34,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "AbstractSrnModel.hpp"
+#include "CellObjectPool.hpp"
 
 AbstractSrnModel::AbstractSrnModel()
     : mSimulatedToTime(SimulationTime::Instance()->GetTime()),
@@ -46,6 +47,16 @@ AbstractSrnModel::~AbstractSrnModel()
 {
 }
 
+void* AbstractSrnModel::operator new(std::size_t size)
+{
+    return CellObjectPool::Allocate(size);
+}
+
+void AbstractSrnModel::operator delete(void* pObject, std::size_t size)
+{
+    CellObjectPool::Deallocate(pObject, size);
+}
+
 void AbstractSrnModel::Initialise()
 {
 }
@@ -84,15 +84,6 @@ AbstractSrnModel* DeltaNotchEdgeSrnModel::CreateSrnModel()
     return new DeltaNotchEdgeSrnModel(*this);
 }
 
-void DeltaNotchEdgeSrnModel::SimulateToCurrentTime()
-{
-    // Update information before running simulation
-    UpdateDeltaNotch();
-
-    // Run the ODE simulation as needed
-    AbstractOdeSrnModel::SimulateToCurrentTime();
-}
-
 void DeltaNotchEdgeSrnModel::Initialise()
 {
     AbstractOdeSrnModel::Initialise(new DeltaNotchEdgeOdeSystem);
@@ -111,6 +102,11 @@ void DeltaNotchEdgeSrnModel::InitialiseDaughterCell()
     mpOdeSystem->SetParameter("interior notch", 0.0);
 }
 
+void DeltaNotchEdgeSrnModel::AdjustOdeParameters(double currentTime)
+{
+    UpdateDeltaNotch();
+}
+
 void DeltaNotchEdgeSrnModel::UpdateDeltaNotch()
 {
     assert(mpOdeSystem != nullptr);
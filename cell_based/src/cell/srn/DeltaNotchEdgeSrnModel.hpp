@@ -91,6 +91,14 @@ protected:
      */
     DeltaNotchEdgeSrnModel(const DeltaNotchEdgeSrnModel& rModel);
 
+    /**
+     * Overridden AdjustOdeParameters() method, which calls UpdateDeltaNotch() before
+     * each solve, whether or not the system is solved in a batch by CellOdeBatchSolver.
+     *
+     * @param currentTime  the time up to which the system will be solved.
+     */
+    void AdjustOdeParameters(double currentTime);
+
 public:
 
     /**
@@ -119,13 +127,6 @@ public:
      */
     virtual void InitialiseDaughterCell();
 
-    /**
-     * Overridden SimulateToTime() method for custom behaviour.
-     * Updates parameters (such as neighbour or interior Delta/Notch) and
-     * runs the simulation to current time
-     */
-    virtual void SimulateToCurrentTime();
-
     /**
      * Update the levels of Delta and Notch of neighbouring edge sensed by this edge
      * That is, fetch neighbour values from CellEdgeData object, storing the sensed information,
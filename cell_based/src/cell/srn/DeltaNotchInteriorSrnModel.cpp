@@ -93,18 +93,14 @@ void DeltaNotchInteriorSrnModel::ResetForDivision()
     ScaleSrnVariables(0.5);
 }
 
-void DeltaNotchInteriorSrnModel::SimulateToCurrentTime()
+void DeltaNotchInteriorSrnModel::Initialise()
 {
-    // Custom behaviour
-    UpdateDeltaNotch();
-
-    // Run the ODE simulation as needed
-    AbstractOdeSrnModel::SimulateToCurrentTime();
+    AbstractOdeSrnModel::Initialise(new DeltaNotchInteriorOdeSystem);
 }
 
-void DeltaNotchInteriorSrnModel::Initialise()
+void DeltaNotchInteriorSrnModel::AdjustOdeParameters(double currentTime)
 {
-    AbstractOdeSrnModel::Initialise(new DeltaNotchInteriorOdeSystem);
+    UpdateDeltaNotch();
 }
 
 void DeltaNotchInteriorSrnModel::UpdateDeltaNotch()
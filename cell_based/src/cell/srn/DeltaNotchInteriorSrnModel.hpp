@@ -88,6 +88,14 @@ protected:
      */
     DeltaNotchInteriorSrnModel(const DeltaNotchInteriorSrnModel& rModel);
 
+    /**
+     * Overridden AdjustOdeParameters() method, which calls UpdateDeltaNotch() before
+     * each solve, whether or not the system is solved in a batch by CellOdeBatchSolver.
+     *
+     * @param currentTime  the time up to which the system will be solved.
+     */
+    void AdjustOdeParameters(double currentTime);
+
 public:
 
     /**
@@ -117,12 +125,6 @@ public:
      */
     virtual void Initialise();
 
-    /**
-     * Overridden SimulateToTime() method for custom behaviour.
-     *
-     */
-    virtual void SimulateToCurrentTime();
-
     /**
      * Updates model parameters, such as total edge concnetration of Delta/Notch, via processing data
      * from CellData()() object
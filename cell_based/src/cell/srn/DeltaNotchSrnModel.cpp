@@ -80,18 +80,14 @@ AbstractSrnModel* DeltaNotchSrnModel::CreateSrnModel()
     return new DeltaNotchSrnModel(*this);
 }
 
-void DeltaNotchSrnModel::SimulateToCurrentTime()
+void DeltaNotchSrnModel::Initialise()
 {
-    // Custom behaviour
-    UpdateDeltaNotch();
-
-    // Run the ODE simulation as needed
-    AbstractOdeSrnModel::SimulateToCurrentTime();
+    AbstractOdeSrnModel::Initialise(new DeltaNotchOdeSystem);
 }
 
-void DeltaNotchSrnModel::Initialise()
+void DeltaNotchSrnModel::AdjustOdeParameters(double currentTime)
 {
-    AbstractOdeSrnModel::Initialise(new DeltaNotchOdeSystem);
+    UpdateDeltaNotch();
 }
 
 void DeltaNotchSrnModel::UpdateDeltaNotch()
@@ -84,6 +84,14 @@ protected:
      */
     DeltaNotchSrnModel(const DeltaNotchSrnModel& rModel);
 
+    /**
+     * Overridden AdjustOdeParameters() method, which calls UpdateDeltaNotch() before
+     * each solve, whether or not the system is solved in a batch by CellOdeBatchSolver.
+     *
+     * @param currentTime  the time up to which the system will be solved.
+     */
+    void AdjustOdeParameters(double currentTime);
+
 public:
 
     /**
@@ -109,13 +117,6 @@ public:
      */
     void Initialise(); // override
 
-    /**
-     * Overridden SimulateToTime() method for custom behaviour.
-     *
-     * \todo #2752 say what it does in this class
-     */
-    void SimulateToCurrentTime();
-
     /**
      * Update the current levels of Delta and Notch in the cell.
      *
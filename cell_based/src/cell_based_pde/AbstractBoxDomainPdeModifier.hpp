@@ -96,6 +96,14 @@ protected:
      */
     bool mSetBcsOnBoxBoundary;
 
+    /**
+     * Whether to keep the PDE solver (and hence its assembled matrix, KSP solver and
+     * preconditioner) between time steps rather than creating a new solver each time.
+     * This is only valid if the diffusion term of the PDE does not change over time.
+     * Defaults to false. Not archived.
+     */
+    bool mUsePersistentSolver;
+
 public:
 
     /**
@@ -138,6 +146,18 @@ public:
      */
     bool AreBcsSetOnBoxBoundary();
 
+    /**
+     * Set mUsePersistentSolver.
+     *
+     * @param usePersistentSolver whether to reuse the PDE solver between time steps
+     */
+    void SetUsePersistentSolver(bool usePersistentSolver);
+
+    /**
+     * @return mUsePersistentSolver.
+     */
+    bool GetUsePersistentSolver() const;
+
     /**
      * Overridden SetupSolve() method.
      *
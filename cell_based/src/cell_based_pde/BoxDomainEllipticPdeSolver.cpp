@@ -0,0 +1,151 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "BoxDomainEllipticPdeSolver.hpp"
+
+template<unsigned DIM>
+c_matrix<double, 1*(DIM+1), 1*(DIM+1)> BoxDomainEllipticPdeSolver<DIM>::ComputeMatrixTerm(
+        c_vector<double, DIM+1>& rPhi,
+        c_matrix<double, DIM, DIM+1>& rGradPhi,
+        ChastePoint<DIM>& rX,
+        c_vector<double,1>& rU,
+        c_matrix<double,1,DIM>& rGradU,
+        Element<DIM,DIM>* pElement)
+{
+    c_matrix<double, DIM+1, DIM+1> matrix_term = zero_matrix<double>(DIM+1, DIM+1);
+
+    if (mAssembleDiffusionTerm)
+    {
+        c_matrix<double, DIM, DIM> pde_diffusion_term = this->mpEllipticPde->ComputeDiffusionTerm(rX);
+        matrix_term += prod(trans(rGradPhi), c_matrix<double, DIM, DIM+1>(prod(pde_diffusion_term, rGradPhi)));
+    }
+
+    if (mAssembleSourceTerm)
+    {
+        // This if statement just saves computing phi*phi^T if it is to be multiplied by zero
+        double linear_in_u_coeff = this->mpEllipticPde->ComputeLinearInUCoeffInSourceTerm(rX, pElement);
+        if (linear_in_u_coeff != 0)
+        {
+            matrix_term -= linear_in_u_coeff*outer_prod(rPhi, rPhi);
+        }
+    }
+
+    return matrix_term;
+}
+
+template<unsigned DIM>
+void BoxDomainEllipticPdeSolver<DIM>::SetupLinearSystem(Vec currentSolution, bool computeMatrix)
+{
+    LinearSystem* p_linear_system = this->mpLinearSystem;
+    assert(p_linear_system->rGetLhsMatrix() != nullptr);
+    assert(p_linear_system->rGetRhsVector() != nullptr);
+
+    if (mDiffusionMatrix == nullptr)
+    {
+        // Assemble and cache the diffusion term, which depends only on the mesh
+        mAssembleDiffusionTerm = true;
+        mAssembleSourceTerm = false;
+        this->SetMatrixToAssemble(p_linear_system->rGetLhsMatrix());
+        this->AssembleMatrix();
+        p_linear_system->FinaliseLhsMatrix();
+
+        MatDuplicate(p_linear_system->rGetLhsMatrix(), MAT_COPY_VALUES, &mDiffusionMatrix);
+    }
+    else
+    {
+        // Dirichlet rows are zeroed keeping the non-zero pattern, so the patterns still agree
+        MatCopy(mDiffusionMatrix, p_linear_system->rGetLhsMatrix(), SAME_NONZERO_PATTERN);
+    }
+
+    // Add the source term to the copied diffusion matrix and assemble the right-hand side
+    mAssembleDiffusionTerm = false;
+    mAssembleSourceTerm = true;
+    this->SetMatrixToAssemble(p_linear_system->rGetLhsMatrix(), false);
+    this->SetVectorToAssemble(p_linear_system->rGetRhsVector(), true);
+    this->Assemble();
+    mAssembleDiffusionTerm = true;
+
+    // The remainder follows AbstractAssemblerSolverHybrid::SetupGivenLinearSystem()
+    this->mNaturalNeumannSurfaceTermAssembler.SetVectorToAssemble(p_linear_system->rGetRhsVector(), false);
+    this->mNaturalNeumannSurfaceTermAssembler.Assemble();
+
+    p_linear_system->FinaliseRhsVector();
+    p_linear_system->SwitchWriteModeLhsMatrix();
+
+    this->mpBoundaryConditions->ApplyDirichletToLinearProblem(*p_linear_system, true);
+
+    p_linear_system->FinaliseRhsVector();
+    p_linear_system->FinaliseLhsMatrix();
+}
+
+template<unsigned DIM>
+BoxDomainEllipticPdeSolver<DIM>::BoxDomainEllipticPdeSolver(AbstractTetrahedralMesh<DIM,DIM>* pMesh,
+                                                            AbstractLinearEllipticPde<DIM,DIM>* pPde,
+                                                            BoundaryConditionsContainer<DIM,DIM,1>* pBoundaryConditions)
+    : SimpleLinearEllipticSolver<DIM,DIM>(pMesh, pPde, pBoundaryConditions),
+      mDiffusionMatrix(nullptr),
+      mAssembleDiffusionTerm(true),
+      mAssembleSourceTerm(true)
+{
+}
+
+template<unsigned DIM>
+BoxDomainEllipticPdeSolver<DIM>::~BoxDomainEllipticPdeSolver()
+{
+    if (mDiffusionMatrix)
+    {
+        PetscTools::Destroy(mDiffusionMatrix);
+    }
+}
+
+template<unsigned DIM>
+void BoxDomainEllipticPdeSolver<DIM>::InitialiseForSolve(Vec initialSolution)
+{
+    SimpleLinearEllipticSolver<DIM,DIM>::InitialiseForSolve(initialSolution);
+    this->mpLinearSystem->SetMatrixIsConstant(true);
+}
+
+template<unsigned DIM>
+void BoxDomainEllipticPdeSolver<DIM>::ResetBoundaryConditionsContainer(BoundaryConditionsContainer<DIM,DIM,1>* pBoundaryConditions)
+{
+    assert(pBoundaryConditions);
+    this->mpBoundaryConditions = pBoundaryConditions;
+    this->mNaturalNeumannSurfaceTermAssembler.ResetBoundaryConditionsContainer(pBoundaryConditions);
+}
+
+// Explicit instantiation
+template class BoxDomainEllipticPdeSolver<1>;
+template class BoxDomainEllipticPdeSolver<2>;
+template class BoxDomainEllipticPdeSolver<3>;
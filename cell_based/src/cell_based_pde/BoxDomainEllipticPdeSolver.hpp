@@ -0,0 +1,140 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef BOXDOMAINELLIPTICPDESOLVER_HPP_
+#define BOXDOMAINELLIPTICPDESOLVER_HPP_
+
+#include "SimpleLinearEllipticSolver.hpp"
+
+/**
+ * A linear elliptic PDE solver for use by EllipticBoxDomainPdeModifier when
+ * it is told to keep its solver between time steps.
+ *
+ * The diffusion part of the stiffness matrix depends only on the (fixed) box
+ * domain mesh, so it is assembled once, on the first call to Solve(), and cached.
+ * Subsequent solves copy the cached matrix into the linear system and only
+ * assemble the cell-dependent linear-in-u source term and the right-hand side.
+ * The KSP solver and its preconditioner are created on the first solve and reused
+ * thereafter.
+ *
+ * This assumes that the diffusion term of the PDE does not change between solves.
+ */
+template<unsigned DIM>
+class BoxDomainEllipticPdeSolver : public SimpleLinearEllipticSolver<DIM,DIM>
+{
+private:
+
+    /** The assembled diffusion part of the stiffness matrix (before boundary conditions are applied). */
+    Mat mDiffusionMatrix;
+
+    /** Whether ComputeMatrixTerm() should include the diffusion term. */
+    bool mAssembleDiffusionTerm;
+
+    /** Whether ComputeMatrixTerm() should include the linear-in-u source term. */
+    bool mAssembleSourceTerm;
+
+protected:
+
+    /**
+     * Overridden ComputeMatrixTerm() method.
+     *
+     * @return the diffusion and/or linear-in-u source contributions to the element stiffness
+     * matrix, depending on which part of the matrix is currently being assembled
+     *
+     * @param rPhi The basis functions, rPhi(i) = phi_i, i=1..numBases
+     * @param rGradPhi Basis gradients, rGradPhi(i,j) = d(phi_j)/d(X_i)
+     * @param rX The point in space
+     * @param rU The unknown as a vector, u(i) = u_i
+     * @param rGradU The gradient of the unknown as a matrix, rGradU(i,j) = d(u_i)/d(X_j)
+     * @param pElement Pointer to the element
+     */
+    c_matrix<double, 1*(DIM+1), 1*(DIM+1)> ComputeMatrixTerm(
+        c_vector<double, DIM+1>& rPhi,
+        c_matrix<double, DIM, DIM+1>& rGradPhi,
+        ChastePoint<DIM>& rX,
+        c_vector<double,1>& rU,
+        c_matrix<double,1,DIM>& rGradU,
+        Element<DIM,DIM>* pElement);
+
+    /**
+     * Overridden SetupLinearSystem() method.
+     *
+     * On the first call the diffusion matrix is assembled and cached; on every call
+     * the cached matrix is copied into the linear system, the source term and
+     * right-hand side vector are assembled, and the boundary conditions are applied.
+     *
+     * @param currentSolution The current solution (unused here)
+     * @param computeMatrix Whether to compute the LHS matrix (unused here, since the
+     *     source term part of the matrix is always recomputed)
+     */
+    void SetupLinearSystem(Vec currentSolution, bool computeMatrix);
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param pMesh pointer to the mesh
+     * @param pPde pointer to the PDE
+     * @param pBoundaryConditions pointer to the boundary conditions
+     */
+    BoxDomainEllipticPdeSolver(AbstractTetrahedralMesh<DIM,DIM>* pMesh,
+                               AbstractLinearEllipticPde<DIM,DIM>* pPde,
+                               BoundaryConditionsContainer<DIM,DIM,1>* pBoundaryConditions);
+
+    /**
+     * Destructor.
+     */
+    virtual ~BoxDomainEllipticPdeSolver();
+
+    /**
+     * Overridden InitialiseForSolve() method.
+     *
+     * Calls the method on the parent class, then marks the linear system as constant
+     * so that the preconditioner is reused between solves.
+     *
+     * @param initialSolution initialSolution (used in base class version of this method)
+     */
+    void InitialiseForSolve(Vec initialSolution = nullptr);
+
+    /**
+     * Replace the boundary conditions container used by the next solve.
+     *
+     * @param pBoundaryConditions pointer to the new boundary conditions
+     */
+    void ResetBoundaryConditionsContainer(BoundaryConditionsContainer<DIM,DIM,1>* pBoundaryConditions);
+};
+
+#endif /*BOXDOMAINELLIPTICPDESOLVER_HPP_*/
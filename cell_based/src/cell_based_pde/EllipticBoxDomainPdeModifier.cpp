@@ -69,15 +69,42 @@ void EllipticBoxDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopula
     // Pass in already updated CellPdeElementMap to speed up finding cells.
     this->SetUpSourceTermsForAveragedSourcePde(this->mpFeMesh, &this->mCellPdeElementMap);
 
-    // Use SimpleLinearEllipticSolver as Averaged Source PDE
-    ///\todo allow other PDE classes to be used with this modifier
-    SimpleLinearEllipticSolver<DIM,DIM> solver(this->mpFeMesh,
-                                               boost::static_pointer_cast<AbstractLinearEllipticPde<DIM,DIM> >(this->GetPde()).get(),
-                                               p_bcc.get());
-
-    ///\todo Use solution at previous time step as an initial guess for Solve()
     Vec old_solution_copy = this->mSolution;
-    this->mSolution = solver.Solve();
+    if (this->mUsePersistentSolver)
+    {
+        // The solver only holds a raw pointer to the boundary conditions, so keep them alive
+        mpPersistentBcc = p_bcc;
+
+        if (!mpPersistentSolver)
+        {
+            mpPersistentSolver.reset(new BoxDomainEllipticPdeSolver<DIM>(this->mpFeMesh,
+                                                                         boost::static_pointer_cast<AbstractLinearEllipticPde<DIM,DIM> >(this->GetPde()).get(),
+                                                                         p_bcc.get()));
+
+            // A (zero) initial guess must be supplied to the first solve for later guesses to be used
+            Vec initial_guess = PetscTools::CreateAndSetVec(this->mpFeMesh->GetNumNodes(), 0.0);
+            this->mSolution = mpPersistentSolver->Solve(initial_guess);
+            PetscTools::Destroy(initial_guess);
+        }
+        else
+        {
+            // Use the solution at the previous time step as an initial guess
+            mpPersistentSolver->ResetBoundaryConditionsContainer(p_bcc.get());
+            this->mSolution = mpPersistentSolver->Solve(old_solution_copy);
+        }
+    }
+    else
+    {
+        // Use SimpleLinearEllipticSolver as Averaged Source PDE
+        ///\todo allow other PDE classes to be used with this modifier
+        SimpleLinearEllipticSolver<DIM,DIM> solver(this->mpFeMesh,
+                                                   boost::static_pointer_cast<AbstractLinearEllipticPde<DIM,DIM> >(this->GetPde()).get(),
+                                                   p_bcc.get());
+
+        ///\todo Use solution at previous time step as an initial guess for Solve()
+        this->mSolution = solver.Solve();
+    }
+
     if (old_solution_copy != nullptr)
     {
         PetscTools::Destroy(old_solution_copy);
@@ -41,6 +41,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractBoxDomainPdeModifier.hpp"
 #include "BoundaryConditionsContainer.hpp"
+#include "BoxDomainEllipticPdeSolver.hpp"
 #include "PetscTools.hpp"
 #include "FileFinder.hpp"
 
@@ -61,6 +62,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *
  * Examples of PDEs in the source folder that can be solved using this class are
  * AveragedSourceEllipticPde, VolumeDependentAveragedSourceEllipticPde and UniformSourceEllipticPde.
+ *
+ * If SetUsePersistentSolver(true) is called, a single BoxDomainEllipticPdeSolver is kept
+ * for the whole simulation, so that the diffusion matrix is only assembled once and the
+ * solution at the previous time step is used as an initial guess.
  */
 template<unsigned DIM>
 class EllipticBoxDomainPdeModifier : public AbstractBoxDomainPdeModifier<DIM>
@@ -84,6 +89,15 @@ private:
         archive & boost::serialization::base_object<AbstractBoxDomainPdeModifier<DIM> >(*this);
     }
 
+    /**
+     * The solver kept between time steps if mUsePersistentSolver is true.
+     * Not archived; it is recreated on the first time step after loading.
+     */
+    boost::shared_ptr<BoxDomainEllipticPdeSolver<DIM> > mpPersistentSolver;
+
+    /** The boundary conditions container currently used by mpPersistentSolver. */
+    std::shared_ptr<BoundaryConditionsContainer<DIM,DIM,1> > mpPersistentBcc;
+
 public:
 
     /**
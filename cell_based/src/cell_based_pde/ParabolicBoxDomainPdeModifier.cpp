@@ -48,7 +48,8 @@ ParabolicBoxDomainPdeModifier<DIM>::ParabolicBoxDomainPdeModifier(boost::shared_
                                         isNeumannBoundaryCondition,
                                         pMeshCuboid,
                                         stepSize,
-                                        solution)
+                                        solution),
+      mPersistentSolverTimeStep(DOUBLE_UNSET)
 {
 }
 
@@ -60,8 +61,12 @@ ParabolicBoxDomainPdeModifier<DIM>::~ParabolicBoxDomainPdeModifier()
 template<unsigned DIM>
 void ParabolicBoxDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopulation<DIM,DIM>& rCellPopulation)
 {
-    // Set up boundary conditions
-    std::shared_ptr<BoundaryConditionsContainer<DIM,DIM,1> > p_bcc = ConstructBoundaryConditionsContainer(rCellPopulation);
+    std::shared_ptr<BoundaryConditionsContainer<DIM,DIM,1> > p_bcc;
+    if (!this->mUsePersistentSolver)
+    {
+        // Set up boundary conditions
+        p_bcc = ConstructBoundaryConditionsContainer(rCellPopulation);
+    }
 
     this->UpdateCellPdeElementMap(rCellPopulation);
 
@@ -69,25 +74,48 @@ void ParabolicBoxDomainPdeModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopul
     // Pass in already updated CellPdeElementMap to speed up finding cells.
     this->SetUpSourceTermsForAveragedSourcePde(this->mpFeMesh, &this->mCellPdeElementMap);
 
-    // Use SimpleLinearParabolicSolver as averaged Source PDE
-    SimpleLinearParabolicSolver<DIM,DIM> solver(this->mpFeMesh,
-                                                boost::static_pointer_cast<AbstractLinearParabolicPde<DIM,DIM> >(this->GetPde()).get(),
-                                                p_bcc.get());
-
     ///\todo Investigate more than one PDE time step per spatial step
     SimulationTime* p_simulation_time = SimulationTime::Instance();
     double current_time = p_simulation_time->GetTime();
     double dt = p_simulation_time->GetTimeStep();
-    solver.SetTimes(current_time,current_time + dt);
-    solver.SetTimeStep(dt);
+
+    // Use SimpleLinearParabolicSolver as averaged Source PDE
+    boost::shared_ptr<SimpleLinearParabolicSolver<DIM,DIM> > p_solver;
+    if (this->mUsePersistentSolver)
+    {
+        if (!mpPersistentSolver)
+        {
+            // The boundary conditions are imposed on the fixed box domain, so only need constructing once
+            mpPersistentBcc = ConstructBoundaryConditionsContainer(rCellPopulation);
+            mpPersistentSolver.reset(new SimpleLinearParabolicSolver<DIM,DIM>(this->mpFeMesh,
+                                                                              boost::static_pointer_cast<AbstractLinearParabolicPde<DIM,DIM> >(this->GetPde()).get(),
+                                                                              mpPersistentBcc.get()));
+        }
+        else if (dt != mPersistentSolverTimeStep)
+        {
+            // The system matrix depends on the time step
+            mpPersistentSolver->SetMatrixIsNotAssembled();
+        }
+        mPersistentSolverTimeStep = dt;
+        p_solver = mpPersistentSolver;
+    }
+    else
+    {
+        p_solver.reset(new SimpleLinearParabolicSolver<DIM,DIM>(this->mpFeMesh,
+                                                                boost::static_pointer_cast<AbstractLinearParabolicPde<DIM,DIM> >(this->GetPde()).get(),
+                                                                p_bcc.get()));
+    }
+
+    p_solver->SetTimes(current_time,current_time + dt);
+    p_solver->SetTimeStep(dt);
 
     // Use previous solution as the initial condition
     Vec previous_solution = this->mSolution;
-    solver.SetInitialCondition(previous_solution);
+    p_solver->SetInitialCondition(previous_solution);
 
     // Note that the linear solver creates a vector, so we have to keep a handle on the old one
     // in order to destroy it
-    this->mSolution = solver.Solve();
+    this->mSolution = p_solver->Solve();
     PetscTools::Destroy(previous_solution);
     this->UpdateCellData(rCellPopulation);
 }
@@ -41,6 +41,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "AbstractBoxDomainPdeModifier.hpp"
 #include "BoundaryConditionsContainer.hpp"
+#include "SimpleLinearParabolicSolver.hpp"
 
 /**
  * A modifier class in which a linear parabolic PDE coupled to a cell-based simulation
@@ -59,6 +60,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *
  * Examples of PDEs in the source folder that can be solved using this class are
  * AveragedSourceParabolicPde and UniformSourceParabolicPde.
+ *
+ * If SetUsePersistentSolver(true) is called, a single SimpleLinearParabolicSolver and
+ * boundary conditions container are kept for the whole simulation. Since the source term
+ * only enters the right-hand side, the system matrix, KSP solver and preconditioner are
+ * then only set up once (or again if the time step changes).
  */
 template<unsigned DIM>
 class ParabolicBoxDomainPdeModifier : public AbstractBoxDomainPdeModifier<DIM>
@@ -82,6 +88,18 @@ private:
         archive & boost::serialization::base_object<AbstractBoxDomainPdeModifier<DIM> >(*this);
     }
 
+    /**
+     * The solver kept between time steps if mUsePersistentSolver is true.
+     * Not archived; it is recreated on the first time step after loading.
+     */
+    boost::shared_ptr<SimpleLinearParabolicSolver<DIM,DIM> > mpPersistentSolver;
+
+    /** The boundary conditions container used by mpPersistentSolver. */
+    std::shared_ptr<BoundaryConditionsContainer<DIM,DIM,1> > mpPersistentBcc;
+
+    /** The time step with which the matrix of mpPersistentSolver was last assembled. */
+    double mPersistentSolverTimeStep;
+
 public:
 
     /**
@@ -43,6 +43,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "SimulationTime.hpp"
 #include "RandomNumberGenerator.hpp"
 #include "CellPropertyRegistry.hpp"
+#include "CellDataKeyRegistry.hpp"
 #include "CellId.hpp"
 
 /**
@@ -78,6 +79,7 @@ protected:
         SimulationTime::Destroy();
         RandomNumberGenerator::Destroy();
         CellPropertyRegistry::Instance()->Clear(); // Destroys properties which are still held by a shared pointer
+        CellDataKeyRegistry::Destroy();
     }
 };
 
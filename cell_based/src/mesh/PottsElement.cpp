@@ -34,11 +34,14 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 #include "PottsElement.hpp"
 #include "RandomNumberGenerator.hpp"
+#include "PottsMesh.hpp"
 
 
 template<unsigned DIM>
 PottsElement<DIM>::PottsElement(unsigned index, const std::vector<Node<DIM>*>& rNodes)
-    : MutableElement<DIM,DIM>(index, rNodes)
+    : MutableElement<DIM,DIM>(index, rNodes),
+      mpMesh(nullptr),
+      mSurfaceArea(0)
 {
     this->RegisterWithNodes();
 }
@@ -56,6 +59,59 @@ void PottsElement<DIM>::AddNode(Node<DIM>* pNode,  const unsigned& rIndex)
 
     // Add pNode to mNodes
     this->mNodes.push_back(pNode);
+
+    if (mpMesh != nullptr)
+    {
+        int surface_area_change = GetSurfaceAreaChangeOnAddingNode(pNode->GetIndex());
+        assert((int)mSurfaceArea + surface_area_change >= 0);
+        mSurfaceArea += surface_area_change;
+    }
+}
+
+template<unsigned DIM>
+void PottsElement<DIM>::DeleteNode(const unsigned& rIndex)
+{
+    if (mpMesh != nullptr)
+    {
+        // The node's neighbours in this element are unchanged by its removal, so the change is the reverse of adding it
+        int surface_area_change = GetSurfaceAreaChangeOnAddingNode(this->GetNodeGlobalIndex(rIndex));
+        assert((int)mSurfaceArea - surface_area_change >= 0);
+        mSurfaceArea -= surface_area_change;
+    }
+
+    MutableElement<DIM,DIM>::DeleteNode(rIndex);
+}
+
+template<unsigned DIM>
+void PottsElement<DIM>::SetMesh(PottsMesh<DIM>* pMesh)
+{
+    mpMesh = pMesh;
+
+    // Each node contributes one unit of surface for each of its 2*DIM sides not shared with a Von Neumann neighbour in this element
+    mSurfaceArea = 0;
+    for (unsigned local_index=0; local_index<this->GetNumNodes(); local_index++)
+    {
+        unsigned num_neighbours_in_element = mpMesh->GetNumVonNeumannNeighboursInElement(this->GetNodeGlobalIndex(local_index), this->mIndex);
+        mSurfaceArea += 2*DIM - std::min(num_neighbours_in_element, 2*DIM);
+    }
+}
+
+template<unsigned DIM>
+unsigned PottsElement<DIM>::GetSurfaceArea() const
+{
+    assert(mpMesh != nullptr);
+    return mSurfaceArea;
+}
+
+template<unsigned DIM>
+int PottsElement<DIM>::GetSurfaceAreaChangeOnAddingNode(unsigned nodeIndex) const
+{
+    /*
+     * The node gains one unit of surface for each side not shared with a neighbour in this element,
+     * and each such neighbour loses one, since the Von Neumann neighbourhood is symmetric.
+     */
+    unsigned num_neighbours_in_element = std::min(mpMesh->GetNumVonNeumannNeighboursInElement(nodeIndex, this->mIndex), 2*DIM);
+    return 2*(int)DIM - 2*(int)num_neighbours_in_element;
 }
 
 template<unsigned DIM>
@@ -36,6 +36,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef POTTSELEMENT_HPP_
 #define POTTSELEMENT_HPP_
 
+// Forward declaration prevents circular include chain
+template<unsigned DIM>
+class PottsMesh;
+
 #include "MutableElement.hpp"
 
 #include "ChasteSerialization.hpp"
@@ -56,6 +60,26 @@ class PottsElement : public MutableElement<DIM, DIM>
 {
 private:
 
+    /**
+     * The mesh whose lattice neighbourhoods this element uses to keep mSurfaceArea
+     * up to date. Set by SetMesh(); nullptr if the element is not part of a mesh.
+     */
+    PottsMesh<DIM>* mpMesh;
+
+    /**
+     * The surface area (or perimeter in 2D) of the element, updated whenever a
+     * node is added or deleted. Only meaningful if mpMesh is set.
+     */
+    unsigned mSurfaceArea;
+
+    /**
+     * @return the change in mSurfaceArea when the given node joins this element.
+     * This is minus the change when it leaves.
+     *
+     * @param nodeIndex the global index of the node
+     */
+    int GetSurfaceAreaChangeOnAddingNode(unsigned nodeIndex) const;
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -98,6 +122,27 @@ public:
      */
     void AddNode(Node<DIM>* pNode,  const unsigned& rIndex = UINT_MAX);
 
+    /**
+     * Delete a node from the element, updating mSurfaceArea.
+     *
+     * @param rIndex the local index of the node to remove
+     */
+    void DeleteNode(const unsigned& rIndex);
+
+    /**
+     * Set the mesh containing this element and recompute mSurfaceArea from scratch,
+     * after which it is updated in O(neighbourhood) time as nodes are added and deleted.
+     * Called by PottsMesh whenever an element is added or the connectivity changes.
+     *
+     * @param pMesh the mesh containing the element
+     */
+    void SetMesh(PottsMesh<DIM>* pMesh);
+
+    /**
+     * @return mSurfaceArea. Requires SetMesh() to have been called.
+     */
+    unsigned GetSurfaceArea() const;
+
     /**
      * Method to calculate the aspect ratio of the element. Currently only works on 2D
      *
@@ -79,6 +79,7 @@ PottsMesh<DIM>::PottsMesh(std::vector<Node<DIM>*> nodes,
             p_element->GetNode(node_index)->AddElement(element_index);
         }
     }
+    SetUpElementSurfaceAreas();
 
     this->mMeshChangesDuringSimulation = true;
 }
@@ -116,6 +117,15 @@ unsigned PottsMesh<DIM>::SolveBoundaryElementMapping(unsigned index) const
     return index;
 }
 
+template<unsigned DIM>
+void PottsMesh<DIM>::SetUpElementSurfaceAreas()
+{
+    for (unsigned elem_index=0; elem_index<mElements.size(); elem_index++)
+    {
+        mElements[elem_index]->SetMesh(this);
+    }
+}
+
 template<unsigned DIM>
 void PottsMesh<DIM>::Clear()
 {
@@ -200,33 +210,7 @@ double PottsMesh<DIM>::GetSurfaceAreaOfElement(unsigned index)
     ///\todo not implemented in 3d yet
     assert(DIM==2 || DIM==3); // LCOV_EXCL_LINE
 
-    // Helper variables
-    PottsElement<DIM>* p_element = GetElement(index);
-    unsigned num_nodes = p_element->GetNumNodes();
-
-    double surface_area = 0.0;
-    for (unsigned node_index=0; node_index<num_nodes; node_index++)
-    {
-        std::set<unsigned> neighbouring_node_indices = GetVonNeumannNeighbouringNodeIndices(p_element->GetNode(node_index)->GetIndex());
-        unsigned local_edges = 2*DIM;
-        for (std::set<unsigned>::iterator iter = neighbouring_node_indices.begin();
-             iter != neighbouring_node_indices.end();
-             iter++)
-        {
-            std::set<unsigned> neighbouring_node_element_indices = this->mNodes[*iter]->rGetContainingElementIndices();
-
-            if (!(neighbouring_node_element_indices.empty()) && (local_edges!=0))
-            {
-                unsigned neighbouring_node_element_index = *(neighbouring_node_element_indices.begin());
-                if (neighbouring_node_element_index == index)
-                {
-                    local_edges--;
-                }
-            }
-        }
-        surface_area += local_edges;
-    }
-    return surface_area;
+    return GetElement(index)->GetSurfaceArea();
 }
 
 template<unsigned DIM>
@@ -241,6 +225,24 @@ std::set<unsigned> PottsMesh<DIM>::GetVonNeumannNeighbouringNodeIndices(unsigned
     return mVonNeumannNeighbouringNodeIndices[nodeIndex];
 }
 
+template<unsigned DIM>
+unsigned PottsMesh<DIM>::GetNumVonNeumannNeighboursInElement(unsigned nodeIndex, unsigned elementIndex) const
+{
+    const std::set<unsigned>& r_neighbouring_node_indices = mVonNeumannNeighbouringNodeIndices[nodeIndex];
+
+    unsigned num_neighbours_in_element = 0;
+    for (std::set<unsigned>::const_iterator iter = r_neighbouring_node_indices.begin();
+         iter != r_neighbouring_node_indices.end();
+         ++iter)
+    {
+        if (this->mNodes[*iter]->rGetContainingElementIndices().count(elementIndex) > 0)
+        {
+            num_neighbours_in_element++;
+        }
+    }
+    return num_neighbours_in_element;
+}
+
 template<unsigned DIM>
 void PottsMesh<DIM>::DeleteElement(unsigned index)
 {
@@ -380,6 +382,9 @@ void PottsMesh<DIM>::DeleteNode(unsigned index)
             mElements[elem_index]->ResetIndex(elem_index);
         }
     }
+
+    // The connectivity has changed, so recompute the element surface areas
+    SetUpElementSurfaceAreas();
 }
 
 template<unsigned DIM>
@@ -523,6 +528,7 @@ unsigned PottsMesh<DIM>::AddElement(PottsElement<DIM>* pNewElement)
         this->mElements[new_element_index] = pNewElement;
     }
     pNewElement->RegisterWithNodes();
+    pNewElement->SetMesh(this);
     return pNewElement->GetIndex();
 }
 
@@ -635,6 +641,8 @@ void PottsMesh<DIM>::ConstructFromMeshReader(AbstractMeshReader<DIM, DIM>& rMesh
     {
         mMooreNeighbouringNodeIndices.resize(num_nodes);
     }
+
+    SetUpElementSurfaceAreas();
 }
 
 // Explicit instantiation
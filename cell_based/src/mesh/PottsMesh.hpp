@@ -107,6 +107,13 @@ protected:
      */
     unsigned SolveBoundaryElementMapping(unsigned index) const;
 
+    /**
+     * Set this mesh on every element, so that each recomputes its surface area.
+     * Must be called whenever the elements or the connectivity are set up or changed
+     * other than through PottsElement::AddNode() and PottsElement::DeleteNode().
+     */
+    void SetUpElementSurfaceAreas();
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
 
@@ -260,6 +267,10 @@ public:
     /**
      * Compute the surface area (or perimeter in 2D) of a PottsElement.
      *
+     * This is the number of sides of the element's lattice sites that are not shared
+     * with another site of the element. It is kept up to date by the element itself
+     * (see PottsElement::SetMesh()), so this method takes constant time.
+     *
      * This needs to be overridden in daughter classes for non-Euclidean metrics.
      *
      * @param index  the global index of a specified PottsElement
@@ -284,6 +295,16 @@ public:
      */
     std::set<unsigned> GetVonNeumannNeighbouringNodeIndices(unsigned nodeIndex);
 
+    /**
+     * Count the Von Neumann neighbours of a node that are contained in a given element.
+     * Used by PottsElement to update its surface area as nodes are added and deleted.
+     *
+     * @param nodeIndex global index of the node
+     * @param elementIndex global index of the element
+     * @return the number of neighbouring nodes contained in the element
+     */
+    unsigned GetNumVonNeumannNeighboursInElement(unsigned nodeIndex, unsigned elementIndex) const;
+
     /**
      * Mark a node as deleted. Note that in a Potts mesh this requires the elements and connectivity to be updated accordingly.
      *
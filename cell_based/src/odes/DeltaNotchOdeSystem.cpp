@@ -77,6 +77,34 @@ void DeltaNotchOdeSystem::EvaluateYDerivatives(double time, const std::vector<do
     rDY[1] = 1.0/(1.0 + 100.0*notch*notch) - delta;                   // d[Delta]/dt
 }
 
+void DeltaNotchOdeSystem::EvaluateYDerivativesBatch(double time,
+                                                    const std::vector<AbstractOdeSystem*>& rSystems,
+                                                    const std::vector<double>& rY,
+                                                    std::vector<double>& rDY)
+{
+    const unsigned num_systems = rSystems.size();
+
+    // Gather the parameter of each cell first, so that the loop below only reads contiguous arrays
+    std::vector<double> mean_deltas(num_systems);
+    for (unsigned s=0; s<num_systems; s++)
+    {
+        assert(dynamic_cast<DeltaNotchOdeSystem*>(rSystems[s]) != nullptr);
+        mean_deltas[s] = static_cast<DeltaNotchOdeSystem*>(rSystems[s])->mParameters[0];
+    }
+
+    const double* p_notch = &rY[0];
+    const double* p_delta = &rY[num_systems];
+    const double* p_mean_delta = &mean_deltas[0];
+    double* p_dnotch = &rDY[0];
+    double* p_ddelta = &rDY[num_systems];
+    for (unsigned s=0; s<num_systems; s++)
+    {
+        // As in EvaluateYDerivatives()
+        p_dnotch[s] = p_mean_delta[s]*p_mean_delta[s]/(0.01 + p_mean_delta[s]*p_mean_delta[s]) - p_notch[s];
+        p_ddelta[s] = 1.0/(1.0 + 100.0*p_notch[s]*p_notch[s]) - p_delta[s];
+    }
+}
+
 template<>
 void CellwiseOdeSystemInformation<DeltaNotchOdeSystem>::Initialise()
 {
@@ -94,6 +94,19 @@ public:
      * @param rDY filled in with the resulting derivatives (using  Collier et al. system of equations).
      */
     void EvaluateYDerivatives(double time, const std::vector<double>& rY, std::vector<double>& rDY);
+
+    /**
+     * Compute the RHS of the Collier et al. system of ODEs for several cells at once, as a
+     * loop over the cells that the compiler can vectorise. Subclasses that change the
+     * equations must override this method as well as EvaluateYDerivatives().
+     *
+     * @param time used to evaluate the RHS.
+     * @param rSystems the ODE systems of the cells, which must all be DeltaNotchOdeSystems.
+     * @param rY the solution vectors of the cells, in struct-of-arrays layout.
+     * @param rDY filled in with the resulting derivatives, in struct-of-arrays layout.
+     */
+    void EvaluateYDerivativesBatch(double time, const std::vector<AbstractOdeSystem*>& rSystems,
+                                   const std::vector<double>& rY, std::vector<double>& rDY);
 };
 
 // Declare identifier for the serializer
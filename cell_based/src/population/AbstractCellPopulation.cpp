@@ -36,6 +36,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/bind.hpp>
 
 #include <algorithm>
+#include <exception>
 #include <functional>
 
 #include "AbstractCellPopulation.hpp"
@@ -43,6 +44,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "SmartPointers.hpp"
 #include "CellAncestor.hpp"
 #include "ApoptoticCellProperty.hpp"
+#include "BackgroundIoThread.hpp"
+#include "CellPopulationHdf5Writer.hpp"
+#include "PetscTools.hpp"
 
 // Cell writers
 #include "BoundaryNodeWriter.hpp"
@@ -74,7 +78,9 @@ AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation( Abstract
       mCells(rCells.begin(), rCells.end()),
       mCentroid(zero_vector<double>(SPACE_DIM)),
       mpCellPropertyRegistry(CellPropertyRegistry::Instance()->TakeOwnership()),
-      mOutputResultsForChasteVisualizer(true)
+      mOutputResultsForChasteVisualizer(true),
+      mUseBufferedWriterOutput(false),
+      mOutputResultsAsHdf5(false)
 {
     /*
      * To avoid double-counting problems, clear the passed-in cells vector.
@@ -92,9 +98,8 @@ AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation( Abstract
         }
     }
 
-    // Set up the map between location indices and cells
-    mLocationCellMap.clear();
-    mCellLocationMap.clear();
+    // Set up the index between location indices and cells
+    mCellLocationIndex.Clear();
 
     std::list<CellPtr>::iterator it = mCells.begin();
     for (unsigned i=0; it != mCells.end(); ++it, ++i)
@@ -110,7 +115,9 @@ AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation( Abstract
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AbstractCellPopulation(AbstractMesh<ELEMENT_DIM, SPACE_DIM>& rMesh)
-    : mrMesh(rMesh)
+    : mrMesh(rMesh),
+      mUseBufferedWriterOutput(false),
+      mOutputResultsAsHdf5(false)
 {
 }
 
@@ -178,7 +185,7 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetCellAncestorsToLocationI
 {
     for (typename AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator cell_iter=this->Begin(); cell_iter!=this->End(); ++cell_iter)
     {
-        MAKE_PTR_ARGS(CellAncestor, p_cell_ancestor, (mCellLocationMap[(*cell_iter).get()]));
+        MAKE_PTR_ARGS(CellAncestor, p_cell_ancestor, (mCellLocationIndex.GetLocationIndex(*cell_iter)));
         cell_iter->SetAncestor(p_cell_ancestor);
     }
 }
@@ -325,39 +332,32 @@ std::vector<unsigned> AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellCyc
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 CellPtr AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellUsingLocationIndex(unsigned index)
 {
-    // Get the set of pointers to cells corresponding to this location index
-    std::set<CellPtr> cells = mLocationCellMap[index];
+    return rGetCellUsingLocationIndex(index);
+}
 
-    // If there is only one cell attached return the cell. Note currently only one cell per index.
-    if (cells.size() == 1)
-    {
-        return *(cells.begin());
-    }
-    if (cells.empty())
-    {
-        EXCEPTION("Location index input argument does not correspond to a Cell");
-    }
-    else
-    {
-        EXCEPTION("Multiple cells are attached to a single location index.");
-    }
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+const CellPtr& AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::rGetCellUsingLocationIndex(unsigned index)
+{
+    /*
+     * This method never modifies mCellLocationIndex, and is therefore safe to call
+     * concurrently (e.g. from threaded force calculations). An exception is thrown
+     * unless exactly one cell is attached to this location index.
+     */
+    return mCellLocationIndex.rGetCell(index);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 std::set<CellPtr> AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetCellsUsingLocationIndex(unsigned index)
 {
     // Return the set of pointers to cells corresponding to this location index, note the set may be empty.
-    return mLocationCellMap[index];
+    return mCellLocationIndex.GetCells(index);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::IsCellAttachedToLocationIndex(unsigned index)
 {
-    // Get the set of pointers to cells corresponding to this location index
-    std::set<CellPtr> cells = mLocationCellMap[index];
-
     // Return whether there is a cell attached to the location index
-    return !(cells.empty());
+    return mCellLocationIndex.GetNumCells(index) != 0;
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -368,38 +368,20 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::WriteDataToVisualizerSetupF
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetCellUsingLocationIndex(unsigned index, CellPtr pCell)
 {
-    // Clear the maps
-    mLocationCellMap[index].clear();
-    mCellLocationMap.erase(pCell.get());
-
-    // Replace with new cell
-    mLocationCellMap[index].insert(pCell);
-
-    // Do other half of the map
-    mCellLocationMap[pCell.get()] = index;
+    // Detach any cells from this location index and the cell from any other, then attach the cell here
+    mCellLocationIndex.SetCell(index, pCell);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AddCellUsingLocationIndex(unsigned index, CellPtr pCell)
 {
-    mLocationCellMap[index].insert(pCell);
-    mCellLocationMap[pCell.get()] = index;
+    mCellLocationIndex.AddCell(index, pCell);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::RemoveCellUsingLocationIndex(unsigned index, CellPtr pCell)
 {
-    std::set<CellPtr>::iterator cell_iter = mLocationCellMap[index].find(pCell);
-
-    if (cell_iter == mLocationCellMap[index].end())
-    {
-        EXCEPTION("Tried to remove a cell which is not attached to the given location index");
-    }
-    else
-    {
-        mLocationCellMap[index].erase(cell_iter);
-        mCellLocationMap.erase(pCell.get());
-    }
+    mCellLocationIndex.RemoveCell(index, pCell);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -413,12 +395,9 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::MoveCellInLocationMap(CellP
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
-unsigned AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetLocationIndexUsingCell(CellPtr pCell)
+unsigned AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetLocationIndexUsingCell(const CellPtr& pCell)
 {
-    // Check the cell is in the map
-    assert(this->mCellLocationMap.find(pCell.get()) != this->mCellLocationMap.end());
-
-    return mCellLocationMap[pCell.get()];
+    return mCellLocationIndex.GetLocationIndex(pCell);
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -498,10 +477,42 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::CloseRoundRobinWritersFiles
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::CloseWritersFiles()
 {
+    // If buffered output fails to reach the files, we still release the thread and close every file before rethrowing
+    std::exception_ptr p_flush_exception = nullptr;
+    if (mpWriterIoThread)
+    {
+        // Wait for buffered output to reach the files before closing them
+        try
+        {
+            mpWriterIoThread->Flush();
+        }
+        catch (...)
+        {
+            p_flush_exception = std::current_exception();
+        }
+        mpWriterIoThread.reset();
+
+        // Count and event writers' files were also kept open
+        typedef AbstractCellPopulationCountWriter<ELEMENT_DIM, SPACE_DIM> count_writer_t;
+        BOOST_FOREACH(boost::shared_ptr<count_writer_t> p_count_writer, mCellPopulationCountWriters)
+        {
+            p_count_writer->CloseFile();
+        }
+
+        typedef AbstractCellPopulationEventWriter<ELEMENT_DIM, SPACE_DIM> event_writer_t;
+        BOOST_FOREACH(boost::shared_ptr<event_writer_t> p_event_writer, mCellPopulationEventWriters)
+        {
+            p_event_writer->CloseFile();
+        }
+    }
+
     typedef AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> cell_writer_t;
     BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
     {
-        p_cell_writer->CloseFile();
+        if (!IsCellWriterOutputInHdf5(*p_cell_writer))
+        {
+            p_cell_writer->CloseFile();
+        }
     }
 
     typedef AbstractCellPopulationWriter<ELEMENT_DIM, SPACE_DIM> pop_writer_t;
@@ -510,21 +521,39 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::CloseWritersFiles()
         p_pop_writer->CloseFile();
     }
 
+    if (mpHdf5Writer)
+    {
+        // This also writes the XDMF file
+        mpHdf5Writer->Close();
+        mpHdf5Writer.reset();
+    }
 #ifdef CHASTE_VTK
-    *mpVtkMetaFile << "    </Collection>\n";
-    *mpVtkMetaFile << "</VTKFile>\n";
-    mpVtkMetaFile->close();
+    else
+    {
+        *mpVtkMetaFile << "    </Collection>\n";
+        *mpVtkMetaFile << "</VTKFile>\n";
+        mpVtkMetaFile->close();
+    }
 #endif //CHASTE_VTK
+
+    if (p_flush_exception)
+    {
+        std::rethrow_exception(p_flush_exception);
+    }
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::OpenWritersFiles(OutputFileHandler& rOutputFileHandler)
 {
 #ifdef CHASTE_VTK
-    mpVtkMetaFile = rOutputFileHandler.OpenOutputFile("results.pvd");
-    *mpVtkMetaFile << "<?xml version=\"1.0\"?>\n";
-    *mpVtkMetaFile << "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"LittleEndian\" compressor=\"vtkZLibDataCompressor\">\n";
-    *mpVtkMetaFile << "    <Collection>\n";
+    // VTK output is replaced by the HDF5 file, if there is one
+    if (!mOutputResultsAsHdf5)
+    {
+        mpVtkMetaFile = rOutputFileHandler.OpenOutputFile("results.pvd");
+        *mpVtkMetaFile << "<?xml version=\"1.0\"?>\n";
+        *mpVtkMetaFile << "<VTKFile type=\"Collection\" version=\"0.1\" byte_order=\"LittleEndian\" compressor=\"vtkZLibDataCompressor\">\n";
+        *mpVtkMetaFile << "    <Collection>\n";
+    }
 #endif //CHASTE_VTK
 
     if (mOutputResultsForChasteVisualizer)
@@ -547,35 +576,160 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::OpenWritersFiles(OutputFile
         }
     }
 
+    if (mOutputResultsAsHdf5)
+    {
+        mpHdf5Writer.reset(new CellPopulationHdf5Writer<ELEMENT_DIM, SPACE_DIM>(rOutputFileHandler));
+    }
+
+    if (mUseBufferedWriterOutput)
+    {
+        mpWriterIoThread.reset(new BackgroundIoThread);
+    }
+    std::vector<AbstractCellBasedWriter<ELEMENT_DIM, SPACE_DIM>*> writers;
+
     // Open output files for any cell writers
     typedef AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> cell_writer_t;
     BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
     {
-        p_cell_writer->OpenOutputFile(rOutputFileHandler);
+        if (!IsCellWriterOutputInHdf5(*p_cell_writer))
+        {
+            OpenWriterFile(*p_cell_writer, rOutputFileHandler);
+            writers.push_back(p_cell_writer.get());
+        }
     }
 
     // Open output files and write headers for any population writers
     typedef AbstractCellPopulationWriter<ELEMENT_DIM, SPACE_DIM> pop_writer_t;
     BOOST_FOREACH(boost::shared_ptr<pop_writer_t> p_pop_writer, mCellPopulationWriters)
     {
-        p_pop_writer->OpenOutputFile(rOutputFileHandler);
+        OpenWriterFile(*p_pop_writer, rOutputFileHandler);
         p_pop_writer->WriteHeader(this);
+        writers.push_back(p_pop_writer.get());
     }
 
     // Open output files and write headers for any population count writers
     typedef AbstractCellPopulationCountWriter<ELEMENT_DIM, SPACE_DIM> count_writer_t;
     BOOST_FOREACH(boost::shared_ptr<count_writer_t> p_count_writer, mCellPopulationCountWriters)
     {
-        p_count_writer->OpenOutputFile(rOutputFileHandler);
+        OpenWriterFile(*p_count_writer, rOutputFileHandler);
         p_count_writer->WriteHeader(this);
+        writers.push_back(p_count_writer.get());
     }
 
     // Open output files and write headers for any population event writers
     typedef AbstractCellPopulationEventWriter<ELEMENT_DIM, SPACE_DIM> event_writer_t;
     BOOST_FOREACH(boost::shared_ptr<event_writer_t> p_event_writer, mCellPopulationEventWriters)
     {
-        p_event_writer->OpenOutputFile(rOutputFileHandler);
+        OpenWriterFile(*p_event_writer, rOutputFileHandler);
         p_event_writer->WriteHeader(this);
+        writers.push_back(p_event_writer.get());
+    }
+
+    if (mpWriterIoThread)
+    {
+        // Every process wrote the same headers, so only the master's copy is needed
+        WriteBufferedWriterOutput(writers, false);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::OpenWriterFile(AbstractCellBasedWriter<ELEMENT_DIM, SPACE_DIM>& rWriter,
+                                                                    OutputFileHandler& rOutputFileHandler)
+{
+    if (!mpWriterIoThread)
+    {
+        rWriter.OpenOutputFile(rOutputFileHandler);
+    }
+    else
+    {
+        // Only the master process writes to file; the others just format their share of the output.
+        // The file is emptied and then held open for appending, so that writers which share a file
+        // (such as two writers of the same type) add their output in the order it is written.
+        if (PetscTools::AmMaster())
+        {
+            rWriter.OpenOutputFile(rOutputFileHandler);
+            rWriter.OpenOutputFileForAppend(rOutputFileHandler);
+        }
+        rWriter.BeginBufferedOutput();
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::WriteBufferedWriterOutput(const std::vector<AbstractCellBasedWriter<ELEMENT_DIM, SPACE_DIM>*>& rWriters,
+                                                                               bool gatherFromAllProcesses)
+{
+    assert(mpWriterIoThread);
+    const unsigned num_writers = rWriters.size();
+
+    std::vector<std::string> texts(num_writers);
+    for (unsigned i=0; i<num_writers; i++)
+    {
+        texts[i] = rWriters[i]->TakeBufferedOutput();
+    }
+
+    if (gatherFromAllProcesses && !PetscTools::IsSequential() && num_writers > 0)
+    {
+        // Gather the lengths of every writer's text on every process...
+        const unsigned num_procs = PetscTools::GetNumProcs();
+        std::vector<int> local_lengths(num_writers);
+        std::string local_text;
+        for (unsigned i=0; i<num_writers; i++)
+        {
+            local_lengths[i] = texts[i].size();
+            local_text += texts[i];
+        }
+        std::vector<int> lengths(PetscTools::AmMaster() ? num_procs*num_writers : 1);
+        MPI_Gather(&local_lengths[0], num_writers, MPI_INT, &lengths[0], num_writers, MPI_INT, 0, PETSC_COMM_WORLD);
+
+        // ...then all the text at once, in rank order
+        std::vector<int> proc_lengths(num_procs, 0);
+        std::vector<int> proc_offsets(num_procs, 0);
+        std::string all_text;
+        if (PetscTools::AmMaster())
+        {
+            for (unsigned proc=0; proc<num_procs; proc++)
+            {
+                for (unsigned i=0; i<num_writers; i++)
+                {
+                    proc_lengths[proc] += lengths[proc*num_writers + i];
+                }
+                if (proc > 0)
+                {
+                    proc_offsets[proc] = proc_offsets[proc-1] + proc_lengths[proc-1];
+                }
+            }
+            all_text.resize(proc_offsets[num_procs-1] + proc_lengths[num_procs-1]);
+        }
+        MPI_Gatherv(local_text.empty() ? nullptr : &local_text[0], local_text.size(), MPI_CHAR,
+                    all_text.empty() ? nullptr : &all_text[0], &proc_lengths[0], &proc_offsets[0], MPI_CHAR,
+                    0, PETSC_COMM_WORLD);
+
+        if (PetscTools::AmMaster())
+        {
+            // Reassemble each writer's text, process by process
+            for (unsigned i=0; i<num_writers; i++)
+            {
+                texts[i].clear();
+            }
+            unsigned offset = 0;
+            for (unsigned proc=0; proc<num_procs; proc++)
+            {
+                for (unsigned i=0; i<num_writers; i++)
+                {
+                    unsigned length = lengths[proc*num_writers + i];
+                    texts[i].append(all_text, offset, length);
+                    offset += length;
+                }
+            }
+        }
+    }
+
+    if (PetscTools::AmMaster())
+    {
+        for (unsigned i=0; i<num_writers; i++)
+        {
+            rWriters[i]->WriteBufferedOutput(*mpWriterIoThread, std::move(texts[i]));
+        }
     }
 }
 
@@ -601,7 +755,42 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::WriteResultsToFiles(const s
     typedef AbstractCellPopulationWriter<ELEMENT_DIM, SPACE_DIM> pop_writer_t;
     OutputFileHandler output_file_handler(rDirectory, false);
 
-    if (!(mCellWriters.empty() && mCellPopulationWriters.empty() && mCellPopulationCountWriters.empty()))
+    /*
+     * Cell writers whose data goes to the HDF5 file do not also write text output, so they
+     * are set aside while the text output is written and restored however we leave this method.
+     */
+    struct CellWritersRestorer
+    {
+        std::vector<boost::shared_ptr<cell_writer_t> >& mrCellWriters;
+        std::vector<boost::shared_ptr<cell_writer_t> > mAllCellWriters;
+        bool mIsSetAside;
+        ~CellWritersRestorer()
+        {
+            if (mIsSetAside)
+            {
+                mrCellWriters.swap(mAllCellWriters);
+            }
+        }
+    } cell_writers_restorer = {mCellWriters, std::vector<boost::shared_ptr<cell_writer_t> >(), false};
+    if (mpHdf5Writer)
+    {
+        BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+        {
+            if (!IsCellWriterOutputInHdf5(*p_cell_writer))
+            {
+                cell_writers_restorer.mAllCellWriters.push_back(p_cell_writer);
+            }
+        }
+        mCellWriters.swap(cell_writers_restorer.mAllCellWriters);
+        cell_writers_restorer.mIsSetAside = true;
+    }
+
+    if (mpWriterIoThread)
+    {
+        // The files were opened by OpenWritersFiles() and are kept open
+        WriteBufferedResultsToFiles();
+    }
+    else if (!(mCellWriters.empty() && mCellPopulationWriters.empty() && mCellPopulationCountWriters.empty()))
     {
         // An ordering must be specified for cell mutation states and cell proliferative types
         SetDefaultCellMutationStateAndProliferativeTypeOrdering();
@@ -706,13 +895,120 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::WriteResultsToFiles(const s
         }
     }
 
-    // VTK can only be written in 2 or 3 dimensions
-    if (SPACE_DIM > 1)
+    if (mpHdf5Writer)
+    {
+        mCellWriters.swap(cell_writers_restorer.mAllCellWriters);
+        cell_writers_restorer.mIsSetAside = false;
+        mpHdf5Writer->WriteTimeStep(SimulationTime::Instance()->GetTime(), *this, mCellWriters);
+    }
+    else if (SPACE_DIM > 1)
     {
+       // VTK can only be written in 2 or 3 dimensions
        WriteVtkResultsToFile(rDirectory);
     }
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::IsCellWriterOutputInHdf5(AbstractCellWriter<ELEMENT_DIM, SPACE_DIM>& rCellWriter) const
+{
+    return mpHdf5Writer && (rCellWriter.GetOutputScalarData() || rCellWriter.GetOutputVectorData());
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::WriteBufferedResultsToFiles()
+{
+    typedef AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> cell_writer_t;
+    typedef AbstractCellPopulationWriter<ELEMENT_DIM, SPACE_DIM> pop_writer_t;
+    typedef AbstractCellPopulationCountWriter<ELEMENT_DIM, SPACE_DIM> count_writer_t;
+    typedef AbstractCellPopulationEventWriter<ELEMENT_DIM, SPACE_DIM> event_writer_t;
+
+    // As in WriteResultsToFiles(), event writers alone do not trigger any output
+    if (mCellWriters.empty() && mCellPopulationWriters.empty() && mCellPopulationCountWriters.empty())
+    {
+        return;
+    }
+
+    // An ordering must be specified for cell mutation states and cell proliferative types
+    SetDefaultCellMutationStateAndProliferativeTypeOrdering();
+
+    /*
+     * Each process formats its share of the cell and population writer output exactly as
+     * it would in the round robin: the master process writes time stamps and the top-most
+     * process adds newlines.
+     */
+    std::vector<AbstractCellBasedWriter<ELEMENT_DIM, SPACE_DIM>*> round_robin_writers;
+    BOOST_FOREACH(boost::shared_ptr<cell_writer_t> p_cell_writer, mCellWriters)
+    {
+        round_robin_writers.push_back(p_cell_writer.get());
+    }
+    BOOST_FOREACH(boost::shared_ptr<pop_writer_t> p_pop_writer, mCellPopulationWriters)
+    {
+        round_robin_writers.push_back(p_pop_writer.get());
+    }
+
+    if (PetscTools::AmMaster())
+    {
+        for (unsigned i=0; i<round_robin_writers.size(); i++)
+        {
+            round_robin_writers[i]->WriteTimeStamp();
+        }
+    }
+
+    for (typename std::vector<boost::shared_ptr<pop_writer_t> >::iterator pop_writer_iter = mCellPopulationWriters.begin();
+         pop_writer_iter != mCellPopulationWriters.end();
+         ++pop_writer_iter)
+    {
+        AcceptPopulationWriter(*pop_writer_iter);
+    }
+
+    AcceptCellWritersAcrossPopulation();
+
+    if (PetscTools::AmTopMost())
+    {
+        for (unsigned i=0; i<round_robin_writers.size(); i++)
+        {
+            round_robin_writers[i]->WriteNewline();
+        }
+    }
+
+    WriteBufferedWriterOutput(round_robin_writers, true);
+
+    // Population count and event writers only write from the master process
+    std::vector<AbstractCellBasedWriter<ELEMENT_DIM, SPACE_DIM>*> master_writers;
+
+    if (PetscTools::AmMaster())
+    {
+        BOOST_FOREACH(boost::shared_ptr<count_writer_t> p_count_writer, mCellPopulationCountWriters)
+        {
+            p_count_writer->WriteTimeStamp();
+        }
+    }
+    for (typename std::vector<boost::shared_ptr<count_writer_t> >::iterator count_writer_iter = mCellPopulationCountWriters.begin();
+         count_writer_iter != mCellPopulationCountWriters.end();
+         ++count_writer_iter)
+    {
+        AcceptPopulationCountWriter(*count_writer_iter);
+        master_writers.push_back(count_writer_iter->get());
+    }
+    if (PetscTools::AmMaster())
+    {
+        BOOST_FOREACH(boost::shared_ptr<count_writer_t> p_count_writer, mCellPopulationCountWriters)
+        {
+            p_count_writer->WriteNewline();
+        }
+    }
+
+    for (typename std::vector<boost::shared_ptr<event_writer_t> >::iterator event_writer_iter = mCellPopulationEventWriters.begin();
+         event_writer_iter != mCellPopulationEventWriters.end();
+         ++event_writer_iter)
+    {
+        AcceptPopulationEventWriter(*event_writer_iter);
+        master_writers.push_back(event_writer_iter->get());
+    }
+
+    WriteBufferedWriterOutput(master_writers, false);
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::AcceptCellWritersAcrossPopulation()
 {
@@ -824,6 +1120,30 @@ void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetOutputResultsForChasteVi
     mOutputResultsForChasteVisualizer = outputResultsForChasteVisualizer;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetUseBufferedWriterOutput(bool useBufferedWriterOutput)
+{
+    mUseBufferedWriterOutput = useBufferedWriterOutput;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetUseBufferedWriterOutput() const
+{
+    return mUseBufferedWriterOutput;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::SetOutputResultsAsHdf5(bool outputResultsAsHdf5)
+{
+    mOutputResultsAsHdf5 = outputResultsAsHdf5;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetOutputResultsAsHdf5() const
+{
+    return mOutputResultsAsHdf5;
+}
+
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 std::vector<std::string> AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::GetDivisionsInformation()
 {
@@ -37,6 +37,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define ABSTRACTCELLPOPULATION_HPP_
 
 #include "Cell.hpp"
+#include "CellLocationIndex.hpp"
 #include "OutputFileHandler.hpp"
 
 #include <list>
@@ -52,6 +53,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/serialization/map.hpp>
 #include <boost/serialization/set.hpp>
 #include <boost/serialization/shared_ptr.hpp>
+#include <boost/serialization/split_member.hpp>
 
 #include <boost/foreach.hpp>
 
@@ -66,6 +68,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 // Forward declaration prevents circular include chain
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM> class AbstractCellBasedSimulation;
+class BackgroundIoThread;
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM> class CellPopulationHdf5Writer;
 /**
  * An abstract facade class encapsulating a cell population.
  *
@@ -80,23 +84,76 @@ private:
     friend class boost::serialization::access;
 
     /**
-     * Serialize the object and its member variables.
+     * Save the object and its member variables.
      *
      * @param archive the archive
      * @param version the current version of this class
      */
     template<class Archive>
-    void serialize(Archive & archive, const unsigned int version)
+    void save(Archive & archive, const unsigned int version) const
     {
         archive & mCells;
-        archive & mLocationCellMap;
-        archive & mCellLocationMap;
+
+        // The location index is archived as the pair of maps it replaced
+        std::map<unsigned, std::set<CellPtr> > location_cell_map = mCellLocationIndex.GetLocationCellMap();
+        std::map<Cell*, unsigned> cell_location_map;
+        for (std::map<unsigned, std::set<CellPtr> >::const_iterator map_iter = location_cell_map.begin();
+             map_iter != location_cell_map.end();
+             ++map_iter)
+        {
+            for (std::set<CellPtr>::const_iterator cell_iter = map_iter->second.begin();
+                 cell_iter != map_iter->second.end();
+                 ++cell_iter)
+            {
+                cell_location_map[cell_iter->get()] = map_iter->first;
+            }
+        }
+        archive & location_cell_map;
+        archive & cell_location_map;
+
+        archive & mpCellPropertyRegistry;
+        archive & mOutputResultsForChasteVisualizer;
+        archive & mCellWriters;
+        archive & mCellPopulationWriters;
+        archive & mCellPopulationCountWriters;
+    }
+
+    /**
+     * Load the object and its member variables.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void load(Archive & archive, const unsigned int version)
+    {
+        archive & mCells;
+
+        std::map<unsigned, std::set<CellPtr> > location_cell_map;
+        std::map<Cell*, unsigned> cell_location_map;
+        archive & location_cell_map;
+        archive & cell_location_map;
+
+        mCellLocationIndex.Clear();
+        for (std::map<unsigned, std::set<CellPtr> >::iterator map_iter = location_cell_map.begin();
+             map_iter != location_cell_map.end();
+             ++map_iter)
+        {
+            for (std::set<CellPtr>::iterator cell_iter = map_iter->second.begin();
+                 cell_iter != map_iter->second.end();
+                 ++cell_iter)
+            {
+                mCellLocationIndex.AddCell(map_iter->first, *cell_iter);
+            }
+        }
+
         archive & mpCellPropertyRegistry;
         archive & mOutputResultsForChasteVisualizer;
         archive & mCellWriters;
         archive & mCellPopulationWriters;
         archive & mCellPopulationCountWriters;
     }
+    BOOST_SERIALIZATION_SPLIT_MEMBER()
 
     /**
      * Open all files in mCellPopulationWriters and mCellWriters in append mode for writing.
@@ -117,13 +174,48 @@ private:
      */
     void CloseRoundRobinWritersFiles();
 
-protected:
+    /**
+     * Open the output file of a writer, or if buffering output, open it on the master process
+     * only and start buffering the writer's output.
+     *
+     * @param rWriter the writer
+     * @param rOutputFileHandler handler for the directory in which to open the file
+     */
+    void OpenWriterFile(AbstractCellBasedWriter<ELEMENT_DIM, SPACE_DIM>& rWriter, OutputFileHandler& rOutputFileHandler);
+
+    /**
+     * Queue the text buffered by some writers to be appended to their files by mpWriterIoThread.
+     *
+     * In parallel the text from every process is gathered onto the master process in rank order,
+     * giving the same files as writing in a round robin, or else only the master's text is written.
+     * All the writers' text is gathered at once, so this must be called collectively.
+     *
+     * @param rWriters the writers
+     * @param gatherFromAllProcesses whether to write the text from every process, rather than just the master
+     */
+    void WriteBufferedWriterOutput(const std::vector<AbstractCellBasedWriter<ELEMENT_DIM, SPACE_DIM>*>& rWriters,
+                                   bool gatherFromAllProcesses);
+
+    /**
+     * @return whether the data of a cell writer is written to the HDF5 file (see SetOutputResultsAsHdf5()),
+     * in which case the writer does not also write text output. This is the case for every cell writer
+     * with scalar or vector data while mpHdf5Writer is set.
+     *
+     * @param rCellWriter the cell writer
+     */
+    bool IsCellWriterOutputInHdf5(AbstractCellWriter<ELEMENT_DIM, SPACE_DIM>& rCellWriter) const;
+
+    /**
+     * Write results to output files while writer output is buffered (see SetUseBufferedWriterOutput()).
+     *
+     * Called by WriteResultsToFiles().
+     */
+    void WriteBufferedResultsToFiles();
 
-    /** Map location (node or VertexElement) indices back to cells. */
-    std::map<unsigned, std::set<CellPtr> > mLocationCellMap;
+protected:
 
-    /** Map cells to location (node or VertexElement) indices. */
-    std::map<Cell*, unsigned> mCellLocationMap;
+    /** Two-way index between cells and location (node, VertexElement or lattice site) indices. */
+    CellLocationIndex mCellLocationIndex;
 
     /** Reference to the mesh. */
     AbstractMesh<ELEMENT_DIM, SPACE_DIM>& mrMesh;
@@ -143,6 +235,30 @@ protected:
     /** Whether to write results to file for visualization using the Chaste java visualizer (defaults to true). */
     bool mOutputResultsForChasteVisualizer;
 
+    /**
+     * Whether OpenWritersFiles() should set up buffered writer output (defaults to false).
+     * Not archived, as it does not affect the results.
+     */
+    bool mUseBufferedWriterOutput;
+
+    /**
+     * The thread that appends buffered writer output to file. Only non-null between
+     * OpenWritersFiles() and CloseWritersFiles() when mUseBufferedWriterOutput is set.
+     */
+    boost::shared_ptr<BackgroundIoThread> mpWriterIoThread;
+
+    /**
+     * Whether OpenWritersFiles() should set up output of results to a binary HDF5 file
+     * (defaults to false). Not archived.
+     */
+    bool mOutputResultsAsHdf5;
+
+    /**
+     * The writer for HDF5 output. Only non-null between OpenWritersFiles() and
+     * CloseWritersFiles() when mOutputResultsAsHdf5 is set.
+     */
+    boost::shared_ptr<CellPopulationHdf5Writer<ELEMENT_DIM, SPACE_DIM> > mpHdf5Writer;
+
     /** A list of cell writers. */
     std::vector<boost::shared_ptr<AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> > > mCellWriters;
 
@@ -462,14 +578,26 @@ public:
     /**
      * Get the cell corresponding to a given location index.
      *
-     * This method assumes that there is at most one cell attached to a location index and an assertion fails if not.
-     * \todo should be an exception?
+     * This method assumes that there is exactly one cell attached to a location index and throws an exception if not.
+     *
+     * @param index the location index
+     *
+     * @return the cell.
+     */
+    CellPtr GetCellUsingLocationIndex(unsigned index);
+
+    /**
+     * Get the cell corresponding to a given location index, without copying the pointer.
+     * This is the version to use in loops over many cells, such as force calculations,
+     * since copying a CellPtr updates its shared reference count.
+     *
+     * This method assumes that there is exactly one cell attached to a location index and throws an exception if not.
      *
      * @param index the location index
      *
      * @return the cell.
      */
-    virtual CellPtr GetCellUsingLocationIndex(unsigned index);
+    virtual const CellPtr& rGetCellUsingLocationIndex(unsigned index);
 
     /**
      * Get the set of cells corresponding to a given location index.
@@ -520,7 +648,7 @@ public:
     virtual void RemoveCellUsingLocationIndex(unsigned index, CellPtr pCell);
 
     /**
-     * Change the location index of a cell in mLocationCellMap and mCellLocationMap
+     * Change the location index of a cell in mCellLocationIndex
      *
      * @param pCell the cell to move
      * @param old_index the old location index
@@ -537,7 +665,7 @@ public:
      *
      * @return the location index.
      */
-    unsigned GetLocationIndexUsingCell(CellPtr pCell);
+    unsigned GetLocationIndexUsingCell(const CellPtr& pCell);
 
     /**
      * @return registry of cell properties used in this cell population.
@@ -937,6 +1065,47 @@ public:
      */
     void SetOutputResultsForChasteVisualizer(bool outputResultsForChasteVisualizer);
 
+    /**
+     * Set whether to buffer writer output (defaults to false).
+     *
+     * If set, OpenWritersFiles() opens the writers' files once and leaves them open until
+     * CloseWritersFiles(). At each call to WriteResultsToFiles() the writers format their output
+     * into memory, and the text is appended to the files by a background thread. In parallel,
+     * each process's text is gathered onto the master process rather than each process taking
+     * turns to write. The files produced are identical to those written without buffering.
+     *
+     * Must be called before OpenWritersFiles() to take effect.
+     *
+     * @param useBufferedWriterOutput whether to buffer writer output
+     */
+    void SetUseBufferedWriterOutput(bool useBufferedWriterOutput);
+
+    /**
+     * @return mUseBufferedWriterOutput
+     */
+    bool GetUseBufferedWriterOutput() const;
+
+    /**
+     * Set whether to also write results to a binary HDF5 file, results.h5, with an XDMF
+     * file, results.xdmf, for viewing in ParaView (defaults to false).
+     *
+     * At each call to WriteResultsToFiles() the location, id, proliferative type and CellData
+     * items of every cell are appended to the file, along with the VTK data of each cell
+     * writer in mCellWriters. See CellPopulationHdf5Writer for the layout of the file.
+     * Since the HDF5 file replaces them, cell writers with VTK data do not write their text
+     * files and no VTK files are written. Population, count and event writers are unaffected.
+     *
+     * Must be called before OpenWritersFiles() to take effect.
+     *
+     * @param outputResultsAsHdf5 whether to write results to an HDF5 file
+     */
+    void SetOutputResultsAsHdf5(bool outputResultsAsHdf5);
+
+    /**
+     * @return mOutputResultsAsHdf5
+     */
+    bool GetOutputResultsAsHdf5() const;
+
     /**
      * @return The width (maximum distance to centroid) of the cell population
      *     in each dimension
@@ -0,0 +1,270 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "CellLocationIndex.hpp"
+
+#include <climits>
+#include "Exception.hpp"
+
+CellLocationIndex::CellLocationIndex()
+    : mNumAttachedCells(0)
+{
+}
+
+CellLocationIndex::~CellLocationIndex()
+{
+    Clear();
+}
+
+unsigned CellLocationIndex::GetSlot(const Cell* pCell) const
+{
+    // The slot stored on the cell is only valid if this index agrees that the cell occupies it
+    if (pCell->GetLocationIndexOfSlot() == this)
+    {
+        unsigned slot = pCell->GetLocationIndexSlot();
+        if (slot < mSlotCells.size() && mSlotCells[slot].get() == pCell)
+        {
+            return slot;
+        }
+    }
+
+    std::map<const Cell*, unsigned>::const_iterator it = mForeignCellSlots.find(pCell);
+    return (it == mForeignCellSlots.end()) ? UINT_MAX : it->second;
+}
+
+void CellLocationIndex::DetachSlot(unsigned slot)
+{
+    unsigned location_index = mSlotLocations[slot];
+
+    // Unlink the slot from the list of slots attached to its location index
+    if (mFirstSlots[location_index] == slot)
+    {
+        mFirstSlots[location_index] = mNextSlots[slot];
+    }
+    else
+    {
+        unsigned previous_slot = mFirstSlots[location_index];
+        while (mNextSlots[previous_slot] != slot)
+        {
+            previous_slot = mNextSlots[previous_slot];
+        }
+        mNextSlots[previous_slot] = mNextSlots[slot];
+    }
+    mNumCellsAtLocation[location_index]--;
+    mNumAttachedCells--;
+
+    if (mSlotCells[slot]->GetLocationIndexOfSlot() == this)
+    {
+        mSlotCells[slot]->SetLocationIndexSlot(UINT_MAX, nullptr);
+    }
+    else
+    {
+        mForeignCellSlots.erase(mSlotCells[slot].get());
+    }
+    mSlotCells[slot].reset();
+    mNextSlots[slot] = UINT_MAX;
+    mFreeSlots.push_back(slot);
+}
+
+void CellLocationIndex::Clear()
+{
+    for (unsigned slot=0; slot<mSlotCells.size(); slot++)
+    {
+        if (mSlotCells[slot] && mSlotCells[slot]->GetLocationIndexOfSlot() == this)
+        {
+            mSlotCells[slot]->SetLocationIndexSlot(UINT_MAX, nullptr);
+        }
+    }
+    mSlotCells.clear();
+    mForeignCellSlots.clear();
+    mSlotLocations.clear();
+    mNextSlots.clear();
+    mFreeSlots.clear();
+    mFirstSlots.clear();
+    mNumCellsAtLocation.clear();
+    mNumAttachedCells = 0;
+}
+
+void CellLocationIndex::AddCell(unsigned locationIndex, const CellPtr& pCell)
+{
+    RemoveCell(pCell);
+
+    if (locationIndex >= mFirstSlots.size())
+    {
+        mFirstSlots.resize(locationIndex + 1, UINT_MAX);
+        mNumCellsAtLocation.resize(locationIndex + 1, 0);
+    }
+
+    unsigned slot;
+    if (mFreeSlots.empty())
+    {
+        slot = mSlotCells.size();
+        mSlotCells.push_back(pCell);
+        mSlotLocations.push_back(locationIndex);
+        mNextSlots.push_back(UINT_MAX);
+    }
+    else
+    {
+        slot = mFreeSlots.back();
+        mFreeSlots.pop_back();
+        mSlotCells[slot] = pCell;
+        mSlotLocations[slot] = locationIndex;
+    }
+
+    // Append the slot to the list for this location index, so cells are kept in the order they were added
+    mNextSlots[slot] = UINT_MAX;
+    if (mFirstSlots[locationIndex] == UINT_MAX)
+    {
+        mFirstSlots[locationIndex] = slot;
+    }
+    else
+    {
+        unsigned last_slot = mFirstSlots[locationIndex];
+        while (mNextSlots[last_slot] != UINT_MAX)
+        {
+            last_slot = mNextSlots[last_slot];
+        }
+        mNextSlots[last_slot] = slot;
+    }
+    mNumCellsAtLocation[locationIndex]++;
+    mNumAttachedCells++;
+
+    // The cell stores its slot unless it is already doing so for another index
+    const CellLocationIndex* p_other_index = pCell->GetLocationIndexOfSlot();
+    if (p_other_index == nullptr || p_other_index == this)
+    {
+        pCell->SetLocationIndexSlot(slot, this);
+    }
+    else
+    {
+        mForeignCellSlots[pCell.get()] = slot;
+    }
+}
+
+void CellLocationIndex::SetCell(unsigned locationIndex, const CellPtr& pCell)
+{
+    if (locationIndex < mFirstSlots.size())
+    {
+        while (mFirstSlots[locationIndex] != UINT_MAX)
+        {
+            DetachSlot(mFirstSlots[locationIndex]);
+        }
+    }
+    AddCell(locationIndex, pCell);
+}
+
+void CellLocationIndex::RemoveCell(unsigned locationIndex, const CellPtr& pCell)
+{
+    unsigned slot = GetSlot(pCell.get());
+    if (slot == UINT_MAX || mSlotLocations[slot] != locationIndex)
+    {
+        EXCEPTION("Tried to remove a cell which is not attached to the given location index");
+    }
+    DetachSlot(slot);
+}
+
+void CellLocationIndex::RemoveCell(const CellPtr& pCell)
+{
+    unsigned slot = GetSlot(pCell.get());
+    if (slot != UINT_MAX)
+    {
+        DetachSlot(slot);
+    }
+}
+
+const CellPtr& CellLocationIndex::rGetCell(unsigned locationIndex) const
+{
+    unsigned num_cells = GetNumCells(locationIndex);
+    if (num_cells == 0)
+    {
+        EXCEPTION("Location index input argument does not correspond to a Cell");
+    }
+    if (num_cells > 1)
+    {
+        EXCEPTION("Multiple cells are attached to a single location index.");
+    }
+    return mSlotCells[mFirstSlots[locationIndex]];
+}
+
+std::set<CellPtr> CellLocationIndex::GetCells(unsigned locationIndex) const
+{
+    std::set<CellPtr> cells;
+    if (locationIndex < mFirstSlots.size())
+    {
+        for (unsigned slot = mFirstSlots[locationIndex]; slot != UINT_MAX; slot = mNextSlots[slot])
+        {
+            cells.insert(mSlotCells[slot]);
+        }
+    }
+    return cells;
+}
+
+unsigned CellLocationIndex::GetNumCells(unsigned locationIndex) const
+{
+    return (locationIndex < mNumCellsAtLocation.size()) ? mNumCellsAtLocation[locationIndex] : 0;
+}
+
+unsigned CellLocationIndex::GetNumAttachedCells() const
+{
+    return mNumAttachedCells;
+}
+
+bool CellLocationIndex::IsCellAttached(const CellPtr& pCell) const
+{
+    return GetSlot(pCell.get()) != UINT_MAX;
+}
+
+unsigned CellLocationIndex::GetLocationIndex(const CellPtr& pCell) const
+{
+    unsigned slot = GetSlot(pCell.get());
+    if (slot == UINT_MAX)
+    {
+        EXCEPTION("Tried to get the location index of a cell which is not attached to one");
+    }
+    return mSlotLocations[slot];
+}
+
+std::map<unsigned, std::set<CellPtr> > CellLocationIndex::GetLocationCellMap() const
+{
+    std::map<unsigned, std::set<CellPtr> > location_cell_map;
+    for (unsigned slot=0; slot<mSlotCells.size(); slot++)
+    {
+        if (mSlotCells[slot])
+        {
+            location_cell_map[mSlotLocations[slot]].insert(mSlotCells[slot]);
+        }
+    }
+    return location_cell_map;
+}
@@ -0,0 +1,207 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef CELLLOCATIONINDEX_HPP_
+#define CELLLOCATIONINDEX_HPP_
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "Cell.hpp"
+
+/**
+ * A two-way index between cells and the location indices (nodes, elements or lattice
+ * sites) to which they are attached, used by AbstractCellPopulation.
+ *
+ * Each attached cell occupies a slot, whose number is stored on the cell itself
+ * (see Cell::GetLocationIndexSlot()), so that finding the location of a cell is a
+ * vector lookup. For each location index we store the number of attached cells and
+ * the first of a linked list of slots, so that finding the cell at a location is also
+ * a vector lookup. More than one cell may be attached to a location index, as
+ * required by CaBasedCellPopulation.
+ *
+ * A cell only stores one slot, so if it is attached to the indices of more than one
+ * cell population, it stores its slot in the first of them and the others keep its slot
+ * in a map.
+ *
+ * Freed slots are reused, so the storage is proportional to the number of attached
+ * cells and the largest location index used.
+ */
+class CellLocationIndex
+{
+private:
+
+    /** For each slot, the cell occupying it (empty if the slot is free). */
+    std::vector<CellPtr> mSlotCells;
+
+    /** For each slot, the location index of the cell occupying it. */
+    std::vector<unsigned> mSlotLocations;
+
+    /** For each slot, the next slot attached to the same location index (UINT_MAX if none). */
+    std::vector<unsigned> mNextSlots;
+
+    /** Slots that are not currently occupied. */
+    std::vector<unsigned> mFreeSlots;
+
+    /** For each location index, the first slot attached to it (UINT_MAX if none). */
+    std::vector<unsigned> mFirstSlots;
+
+    /** For each location index, the number of cells attached to it. */
+    std::vector<unsigned> mNumCellsAtLocation;
+
+    /** The slots of attached cells which store their slot for another index. */
+    std::map<const Cell*, unsigned> mForeignCellSlots;
+
+    /** The total number of cells attached to location indices. */
+    unsigned mNumAttachedCells;
+
+    /**
+     * @return the slot occupied by a cell, or UINT_MAX if the cell is not in this index.
+     *
+     * @param pCell the cell
+     */
+    unsigned GetSlot(const Cell* pCell) const;
+
+    /**
+     * Detach the cell in a given slot from its location index and free the slot.
+     *
+     * @param slot the slot
+     */
+    void DetachSlot(unsigned slot);
+
+public:
+
+    /**
+     * Default constructor.
+     */
+    CellLocationIndex();
+
+    /**
+     * Destructor. Detaches all cells.
+     */
+    ~CellLocationIndex();
+
+    /**
+     * Detach all cells.
+     */
+    void Clear();
+
+    /**
+     * Attach a cell to a location index. If the cell is already attached to a
+     * location index, it is first detached from it.
+     *
+     * @param locationIndex the location index
+     * @param pCell the cell
+     */
+    void AddCell(unsigned locationIndex, const CellPtr& pCell);
+
+    /**
+     * Detach all cells from a location index, then attach a given cell to it.
+     *
+     * @param locationIndex the location index
+     * @param pCell the cell
+     */
+    void SetCell(unsigned locationIndex, const CellPtr& pCell);
+
+    /**
+     * Detach a cell from a location index.
+     *
+     * Throws an exception if the cell is not attached to this location index.
+     *
+     * @param locationIndex the location index
+     * @param pCell the cell
+     */
+    void RemoveCell(unsigned locationIndex, const CellPtr& pCell);
+
+    /**
+     * Detach a cell from whichever location index it is attached to, if any.
+     *
+     * @param pCell the cell
+     */
+    void RemoveCell(const CellPtr& pCell);
+
+    /**
+     * @return the cell attached to a location index.
+     *
+     * Throws an exception if there is not exactly one cell attached to it.
+     *
+     * @param locationIndex the location index
+     */
+    const CellPtr& rGetCell(unsigned locationIndex) const;
+
+    /**
+     * @return the set of cells attached to a location index (which may be empty).
+     *
+     * @param locationIndex the location index
+     */
+    std::set<CellPtr> GetCells(unsigned locationIndex) const;
+
+    /**
+     * @return the number of cells attached to a location index.
+     *
+     * @param locationIndex the location index
+     */
+    unsigned GetNumCells(unsigned locationIndex) const;
+
+    /**
+     * @return the total number of cells attached to location indices.
+     */
+    unsigned GetNumAttachedCells() const;
+
+    /**
+     * @return whether a cell is attached to a location index.
+     *
+     * @param pCell the cell
+     */
+    bool IsCellAttached(const CellPtr& pCell) const;
+
+    /**
+     * @return the location index to which a cell is attached.
+     *
+     * Throws an exception if the cell is not attached to a location index.
+     *
+     * @param pCell the cell
+     */
+    unsigned GetLocationIndex(const CellPtr& pCell) const;
+
+    /**
+     * @return the contents of the index as a map from location indices to sets of cells,
+     * the form in which AbstractCellPopulation archives it.
+     */
+    std::map<unsigned, std::set<CellPtr> > GetLocationCellMap() const;
+};
+
+#endif /*CELLLOCATIONINDEX_HPP_*/
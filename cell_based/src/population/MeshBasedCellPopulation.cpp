@@ -61,7 +61,10 @@ MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::MeshBasedCellPopulation(MutableM
       mAreaBasedDampingConstantParameter(0.1),
       mWriteVtkAsPoints(false),
       mBoundVoronoiTessellation(false),
-      mHasVariableRestLength(false)
+      mHasVariableRestLength(false),
+      mUseLazyVoronoiTessellation(false),
+      mUseIncrementalVoronoiTessellation(false),
+      mIsVoronoiTessellationOutOfDate(false)
 {
     mpMutableMesh = static_cast<MutableMesh<ELEMENT_DIM,SPACE_DIM>* >(&(this->mrMesh));
 
@@ -83,7 +86,10 @@ MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::MeshBasedCellPopulation(MutableM
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::MeshBasedCellPopulation(MutableMesh<ELEMENT_DIM,SPACE_DIM>& rMesh)
-    : AbstractCentreBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>(rMesh)
+    : AbstractCentreBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>(rMesh),
+      mUseLazyVoronoiTessellation(false),
+      mUseIncrementalVoronoiTessellation(false),
+      mIsVoronoiTessellationOutOfDate(false)
 {
     mpMutableMesh = static_cast<MutableMesh<ELEMENT_DIM,SPACE_DIM>* >(&(this->mrMesh));
     mpVoronoiTessellation = nullptr;
@@ -342,15 +348,20 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::Update(bool hasHadBirthsOrD
         UpdateGhostNodesAfterReMesh(node_map);
 
         // Update the mappings between cells and location indices
-        std::map<Cell*, unsigned> old_cell_location_map = this->mCellLocationMap;
+        std::vector<unsigned> old_node_indices;
+        old_node_indices.reserve(this->mCells.size());
+        for (std::list<CellPtr>::iterator it = this->mCells.begin(); it != this->mCells.end(); ++it)
+        {
+            old_node_indices.push_back(this->GetLocationIndexUsingCell(*it));
+        }
 
-        // Remove any dead pointers from the maps (needed to avoid archiving errors)
-        this->mLocationCellMap.clear();
-        this->mCellLocationMap.clear();
+        // Remove any dead pointers from the index (needed to avoid archiving errors)
+        this->mCellLocationIndex.Clear();
 
-        for (std::list<CellPtr>::iterator it = this->mCells.begin(); it != this->mCells.end(); ++it)
+        std::vector<unsigned>::iterator old_index_iter = old_node_indices.begin();
+        for (std::list<CellPtr>::iterator it = this->mCells.begin(); it != this->mCells.end(); ++it, ++old_index_iter)
         {
-            unsigned old_node_index = old_cell_location_map[(*it).get()];
+            unsigned old_node_index = *old_index_iter;
 
             // This shouldn't ever happen, as the cell vector only contains living cells
             assert(!node_map.IsDeleted(old_node_index));
@@ -372,11 +383,11 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::Update(bool hasHadBirthsOrD
     }
     else
     {
-        if (old_node_radius_map[this->mCellLocationMap[(*(this->mCells.begin())).get()]] > 0.0)
+        if (old_node_radius_map[this->GetLocationIndexUsingCell(*(this->mCells.begin()))] > 0.0)
         {
             for (std::list<CellPtr>::iterator it = this->mCells.begin(); it != this->mCells.end(); ++it)
             {
-                unsigned node_index = this->mCellLocationMap[(*it).get()];
+                unsigned node_index = this->GetLocationIndexUsingCell(*it);
                 this->GetNode(node_index)->SetRadius(old_node_radius_map[node_index]);
             }
         }
@@ -384,7 +395,7 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::Update(bool hasHadBirthsOrD
         {
             for (std::list<CellPtr>::iterator it = this->mCells.begin(); it != this->mCells.end(); ++it)
             {
-                unsigned node_index = this->mCellLocationMap[(*it).get()];
+                unsigned node_index = this->GetLocationIndexUsingCell(*it);
                 this->GetNode(node_index)->AddAppliedForceContribution(old_node_applied_force_map[node_index]);
             }
         }
@@ -448,12 +459,36 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::TessellateIfNeeded()
             this-> template HasWriter<CellPopulationAreaWriter>() ||
             this-> template HasWriter<CellVolumesWriter>())
         {
-            CreateVoronoiTessellation();
+            if (mUseLazyVoronoiTessellation)
+            {
+                // Defer creation until the tessellation is used
+                mIsVoronoiTessellationOutOfDate = true;
+            }
+            else
+            {
+                CreateVoronoiTessellation();
+            }
+        }
+        else if (mUseLazyVoronoiTessellation && mpVoronoiTessellation != nullptr)
+        {
+            // An existing tessellation, for example one created by GetVolumeOfCell(), no longer matches the mesh
+            mIsVoronoiTessellationOutOfDate = true;
         }
         CellBasedEventHandler::EndEvent(CellBasedEventHandler::TESSELLATION);
     }
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::CreateVoronoiTessellationIfOutOfDate()
+{
+    if (mIsVoronoiTessellationOutOfDate)
+    {
+        CellBasedEventHandler::BeginEvent(CellBasedEventHandler::TESSELLATION);
+        CreateVoronoiTessellation();
+        CellBasedEventHandler::EndEvent(CellBasedEventHandler::TESSELLATION);
+    }
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::DivideLongSprings([[maybe_unused]] double springDivisionThreshold) // [[maybe_unused]] due to unused-but-set-parameter warning in GCC 7,8,9
 {
@@ -691,6 +726,8 @@ void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::WriteVtkResultsToFile(const
         *(this->mpVtkMetaFile) << num_timesteps;
         *(this->mpVtkMetaFile) << ".vtu\"/>\n";
     }
+
+    CreateVoronoiTessellationIfOutOfDate();
     if (mpVoronoiTessellation != nullptr)
     {
         // Create mesh writer for VTK output
@@ -765,7 +802,8 @@ double MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetVolumeOfCell(CellPtr p
 
     if (ELEMENT_DIM == SPACE_DIM)
     {
-        // Ensure that the Voronoi tessellation exists
+        // Ensure that the Voronoi tessellation exists and is up to date
+        CreateVoronoiTessellationIfOutOfDate();
         if (mpVoronoiTessellation == nullptr)
         {
             CreateVoronoiTessellation();
@@ -846,6 +884,30 @@ bool MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetBoundVoronoiTessellation
     return mBoundVoronoiTessellation;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::SetUseLazyVoronoiTessellation(bool useLazyVoronoiTessellation)
+{
+    mUseLazyVoronoiTessellation = useLazyVoronoiTessellation;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetUseLazyVoronoiTessellation() const
+{
+    return mUseLazyVoronoiTessellation;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::SetUseIncrementalVoronoiTessellation(bool useIncrementalVoronoiTessellation)
+{
+    mUseIncrementalVoronoiTessellation = useIncrementalVoronoiTessellation;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetUseIncrementalVoronoiTessellation() const
+{
+    return mUseIncrementalVoronoiTessellation;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::WriteDataToVisualizerSetupFile(out_stream& pVizSetupFile)
 {
@@ -954,6 +1016,16 @@ typename MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::SpringIterator MeshBase
 template<>
 void MeshBasedCellPopulation<2>::CreateVoronoiTessellation()
 {
+    mIsVoronoiTessellationOutOfDate = false;
+
+    // Only the unbounded tessellation of a non-periodic mesh can be updated in place; the others are always constructed afresh below
+    if (mUseIncrementalVoronoiTessellation && !mBoundVoronoiTessellation && mpVoronoiTessellation != nullptr
+        && dynamic_cast<Cylindrical2dMesh*>(&mrMesh) == nullptr && dynamic_cast<Toroidal2dMesh*>(&mrMesh) == nullptr
+        && mpVoronoiTessellation->UpdateVoronoiTessellation())
+    {
+        return;
+    }
+
     delete mpVoronoiTessellation;
 
     // Check if the mesh associated with this cell population is periodic
@@ -994,6 +1066,14 @@ void MeshBasedCellPopulation<2,3>::CreateVoronoiTessellation()
 template<>
 void MeshBasedCellPopulation<3>::CreateVoronoiTessellation()
 {
+    mIsVoronoiTessellationOutOfDate = false;
+
+    if (mUseIncrementalVoronoiTessellation && mpVoronoiTessellation != nullptr
+        && mpVoronoiTessellation->UpdateVoronoiTessellation())
+    {
+        return;
+    }
+
     delete mpVoronoiTessellation;
     mpVoronoiTessellation = new VertexMesh<3, 3>(static_cast<MutableMesh<3, 3> &>((this->mrMesh)));
 }
@@ -1041,6 +1121,7 @@ void MeshBasedCellPopulation<1, 3>::CreateVoronoiTessellation()
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 VertexMesh<ELEMENT_DIM,SPACE_DIM>* MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetVoronoiTessellation()
 {
+    CreateVoronoiTessellationIfOutOfDate();
     assert(mpVoronoiTessellation!=nullptr);
     return mpVoronoiTessellation;
 }
@@ -1048,6 +1129,7 @@ VertexMesh<ELEMENT_DIM,SPACE_DIM>* MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 double MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetVolumeOfVoronoiElement(unsigned index)
 {
+    CreateVoronoiTessellationIfOutOfDate();
     unsigned element_index = mpVoronoiTessellation->GetVoronoiElementIndexCorrespondingToDelaunayNodeIndex(index);
     double volume = mpVoronoiTessellation->GetVolumeOfElement(element_index);
     return volume;
@@ -1056,6 +1138,7 @@ double MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetVolumeOfVoronoiElement
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 double MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetSurfaceAreaOfVoronoiElement(unsigned index)
 {
+    CreateVoronoiTessellationIfOutOfDate();
     unsigned element_index = mpVoronoiTessellation->GetVoronoiElementIndexCorrespondingToDelaunayNodeIndex(index);
     double surface_area = mpVoronoiTessellation->GetSurfaceAreaOfElement(element_index);
     return surface_area;
@@ -1064,6 +1147,7 @@ double MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetSurfaceAreaOfVoronoiEl
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 double MeshBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>::GetVoronoiEdgeLength(unsigned index1, unsigned index2)
 {
+    CreateVoronoiTessellationIfOutOfDate();
     unsigned element_index1 = mpVoronoiTessellation->GetVoronoiElementIndexCorrespondingToDelaunayNodeIndex(index1);
     unsigned element_index2 = mpVoronoiTessellation->GetVoronoiElementIndexCorrespondingToDelaunayNodeIndex(index2);
     try
@@ -140,6 +140,21 @@ protected:
     /** Whether springs have variable rest lengths. */
     bool mHasVariableRestLength;
 
+    /**
+     * Whether to create the Voronoi tessellation only when it is first requested after
+     * each call to Update(), rather than in every call to Update(). Not archived.
+     */
+    bool mUseLazyVoronoiTessellation;
+
+    /**
+     * Whether to update an existing Voronoi tessellation in place where possible, rather
+     * than constructing it afresh (see VertexMesh::UpdateVoronoiTessellation()). Not archived.
+     */
+    bool mUseIncrementalVoronoiTessellation;
+
+    /** Whether mpVoronoiTessellation must be recreated before it is next used. */
+    bool mIsVoronoiTessellationOutOfDate;
+
     /** Node pairs for force calculations. */
     std::vector< std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > > mNodePairs;
 
@@ -337,6 +352,16 @@ public:
      */
     void TessellateIfNeeded();
 
+    /**
+     * Create the Voronoi tessellation if TessellateIfNeeded() deferred its creation
+     * because mUseLazyVoronoiTessellation is set. Called by every method that uses
+     * mpVoronoiTessellation.
+     *
+     * Since this may modify the tessellation, code that uses it from within a parallel
+     * region should call GetVoronoiTessellation() before entering the region.
+     */
+    void CreateVoronoiTessellationIfOutOfDate();
+
     /**
      *  Divides springs longer than the given threshold
      *
@@ -377,6 +402,9 @@ public:
 
     /**
      * Create a Voronoi tessellation of the mesh.
+     *
+     * If mUseIncrementalVoronoiTessellation is set, an existing tessellation is updated
+     * in place when possible.
      */
     void CreateVoronoiTessellation();
 
@@ -572,6 +600,30 @@ public:
      */
     bool GetBoundVoronoiTessellation();
 
+    /**
+     * Set mUseLazyVoronoiTessellation.
+     *
+     * @param useLazyVoronoiTessellation whether to create the Voronoi tessellation only when it is used
+     */
+    void SetUseLazyVoronoiTessellation(bool useLazyVoronoiTessellation);
+
+    /**
+     * @return mUseLazyVoronoiTessellation.
+     */
+    bool GetUseLazyVoronoiTessellation() const;
+
+    /**
+     * Set mUseIncrementalVoronoiTessellation.
+     *
+     * @param useIncrementalVoronoiTessellation whether to update the Voronoi tessellation in place where possible
+     */
+    void SetUseIncrementalVoronoiTessellation(bool useIncrementalVoronoiTessellation);
+
+    /**
+     * @return mUseIncrementalVoronoiTessellation.
+     */
+    bool GetUseIncrementalVoronoiTessellation() const;
+
     /**
      * Overridden GetNeighbouringNodeIndices() method.
      *
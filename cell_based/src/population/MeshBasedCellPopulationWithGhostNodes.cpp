@@ -426,6 +426,8 @@ void MeshBasedCellPopulationWithGhostNodes<DIM>::WriteVtkResultsToFile(const std
         *(this->mpVtkMetaFile) << num_timesteps;
         *(this->mpVtkMetaFile) << ".vtu\"/>\n";
     }
+
+    this->CreateVoronoiTessellationIfOutOfDate();
     if (this->mpVoronoiTessellation != nullptr)
     {
         // Create mesh writer for VTK output
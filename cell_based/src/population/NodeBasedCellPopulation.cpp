@@ -47,7 +47,11 @@ NodeBasedCellPopulation<DIM>::NodeBasedCellPopulation(NodesOnlyMesh<DIM>& rMesh,
       mDeleteMesh(deleteMesh),
       mUseVariableRadii(false),
       mLoadBalanceMesh(false),
-      mLoadBalanceFrequency(100)
+      mLoadBalanceFrequency(100),
+      mUseVerletList(false),
+      mVerletSkin(0.25),
+      mFilterNodePairsByDistance(false),
+      mNodePairGeometryIsCurrent(false)
 {
     mpNodesOnlyMesh = static_cast<NodesOnlyMesh<DIM>* >(&(this->mrMesh));
 
@@ -63,7 +67,11 @@ NodeBasedCellPopulation<DIM>::NodeBasedCellPopulation(NodesOnlyMesh<DIM>& rMesh)
       mDeleteMesh(true),
       mUseVariableRadii(false), // will be set by serialize() method
       mLoadBalanceMesh(false),
-      mLoadBalanceFrequency(100)
+      mLoadBalanceFrequency(100),
+      mUseVerletList(false),
+      mVerletSkin(0.25),
+      mFilterNodePairsByDistance(false),
+      mNodePairGeometryIsCurrent(false)
 {
     mpNodesOnlyMesh = static_cast<NodesOnlyMesh<DIM>* >(&(this->mrMesh));
 }
@@ -113,6 +121,11 @@ template<unsigned DIM>
 void NodeBasedCellPopulation<DIM>::Clear()
 {
     mNodePairs.clear();
+    mVerletReferenceLocations.clear();
+    mFilteredNodePairs.clear();
+    mFilteredNodePairSeparations.clear();
+    mFilteredNodePairDistances.clear();
+    mNodePairGeometryIsCurrent = false;
 }
 
 template<unsigned DIM>
@@ -143,6 +156,7 @@ template<unsigned DIM>
 void NodeBasedCellPopulation<DIM>::SetNode(unsigned nodeIndex, ChastePoint<DIM>& rNewLocation)
 {
     mpNodesOnlyMesh->SetNode(nodeIndex, rNewLocation, false);
+    mNodePairGeometryIsCurrent = false;
 }
 
 template<unsigned DIM>
@@ -150,27 +164,38 @@ void NodeBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
 {
     UpdateCellProcessLocation();
 
-    mpNodesOnlyMesh->UpdateBoxCollection();
-
-    if (mLoadBalanceMesh)
+    // If the Verlet list is still valid, we can skip the neighbour search
+    if (!mUseVerletList || IsVerletListRebuildRequired(hasHadBirthsOrDeaths))
     {
-        if ((SimulationTime::Instance()->GetTimeStepsElapsed() % mLoadBalanceFrequency) == 0)
+        mpNodesOnlyMesh->UpdateBoxCollection();
+
+        if (mLoadBalanceMesh)
         {
-            mpNodesOnlyMesh->LoadBalanceMesh();
+            if ((SimulationTime::Instance()->GetTimeStepsElapsed() % mLoadBalanceFrequency) == 0)
+            {
+                mpNodesOnlyMesh->LoadBalanceMesh();
 
-            UpdateCellProcessLocation();
+                UpdateCellProcessLocation();
 
-            mpNodesOnlyMesh->UpdateBoxCollection();
+                mpNodesOnlyMesh->UpdateBoxCollection();
+            }
         }
-    }
 
-    RefreshHaloCells();
+        RefreshHaloCells();
 
-    mpNodesOnlyMesh->CalculateInteriorNodePairs(mNodePairs);
+        mpNodesOnlyMesh->CalculateInteriorNodePairs(mNodePairs);
 
-    AddReceivedHaloCells();
+        AddReceivedHaloCells();
 
-    mpNodesOnlyMesh->CalculateBoundaryNodePairs(mNodePairs);
+        mpNodesOnlyMesh->CalculateBoundaryNodePairs(mNodePairs);
+
+        if (mUseVerletList)
+        {
+            BuildVerletList();
+        }
+    }
+
+    InvalidateNodePairGeometry();
 
     /*
      * Update cell radii based on CellData
@@ -191,6 +216,63 @@ void NodeBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
     PetscTools::Barrier("Update");
 }
 
+template<unsigned DIM>
+bool NodeBasedCellPopulation<DIM>::IsVerletListRebuildRequired(bool hasHadBirthsOrDeaths)
+{
+    if (hasHadBirthsOrDeaths || PetscTools::IsParallel()
+        || mVerletReferenceLocations.size() != mpNodesOnlyMesh->GetNumNodes())
+    {
+        return true;
+    }
+
+    // Compare squared displacements with the square of half the skin, to avoid taking square roots
+    double max_displacement_squared = 0.25*mVerletSkin*mVerletSkin;
+    unsigned node_count = 0;
+    for (typename AbstractMesh<DIM,DIM>::NodeIterator node_iter = mpNodesOnlyMesh->GetNodeIteratorBegin();
+         node_iter != mpNodesOnlyMesh->GetNodeIteratorEnd();
+         ++node_iter)
+    {
+        // Use GetVectorFromAtoB() to allow for periodicity
+        c_vector<double, DIM> displacement = mpNodesOnlyMesh->GetVectorFromAtoB(mVerletReferenceLocations[node_count], node_iter->rGetLocation());
+        if (inner_prod(displacement, displacement) > max_displacement_squared)
+        {
+            return true;
+        }
+        node_count++;
+    }
+
+    return false;
+}
+
+template<unsigned DIM>
+void NodeBasedCellPopulation<DIM>::BuildVerletList()
+{
+    double verlet_radius = mpNodesOnlyMesh->GetMaximumInteractionDistance() + mVerletSkin;
+
+    // Keep only the pairs within the Verlet radius, preserving their order
+    unsigned num_kept = 0;
+    for (unsigned i=0; i<mNodePairs.size(); i++)
+    {
+        c_vector<double, DIM> node_a_to_b = mpNodesOnlyMesh->GetVectorFromAtoB(mNodePairs[i].first->rGetLocation(), mNodePairs[i].second->rGetLocation());
+        if (norm_2(node_a_to_b) < verlet_radius)
+        {
+            mNodePairs[num_kept] = mNodePairs[i];
+            num_kept++;
+        }
+    }
+    mNodePairs.resize(num_kept);
+
+    // Store the node locations, against which displacements are measured
+    mVerletReferenceLocations.clear();
+    mVerletReferenceLocations.reserve(mpNodesOnlyMesh->GetNumNodes());
+    for (typename AbstractMesh<DIM,DIM>::NodeIterator node_iter = mpNodesOnlyMesh->GetNodeIteratorBegin();
+         node_iter != mpNodesOnlyMesh->GetNodeIteratorEnd();
+         ++node_iter)
+    {
+        mVerletReferenceLocations.push_back(node_iter->rGetLocation());
+    }
+}
+
 template<unsigned DIM>
 void NodeBasedCellPopulation<DIM>::UpdateMapsAfterRemesh(NodeMap& map)
 {
@@ -199,18 +281,24 @@ void NodeBasedCellPopulation<DIM>::UpdateMapsAfterRemesh(NodeMap& map)
         UpdateParticlesAfterReMesh(map);
 
         // Update the mappings between cells and location indices
-        ///\todo we want to make mCellLocationMap private - we need to find a better way of doing this
-        std::map<Cell*, unsigned> old_map = this->mCellLocationMap;
+        std::vector<unsigned> old_node_indices;
+        old_node_indices.reserve(this->mCells.size());
+        for (std::list<CellPtr>::iterator it = this->mCells.begin();
+             it != this->mCells.end();
+             ++it)
+        {
+            old_node_indices.push_back(this->GetLocationIndexUsingCell(*it));
+        }
 
-        // Remove any dead pointers from the maps (needed to avoid archiving errors)
-        this->mLocationCellMap.clear();
-        this->mCellLocationMap.clear();
+        // Remove any dead pointers from the index (needed to avoid archiving errors)
+        this->mCellLocationIndex.Clear();
 
+        std::vector<unsigned>::iterator old_index_iter = old_node_indices.begin();
         for (std::list<CellPtr>::iterator it = this->mCells.begin();
              it != this->mCells.end();
-             ++it)
+             ++it, ++old_index_iter)
         {
-            unsigned old_node_index = old_map[(*it).get()];
+            unsigned old_node_index = *old_index_iter;
 
             // This shouldn't ever happen, as the cell vector only contains living cells
             assert(!map.IsDeleted(old_node_index));
@@ -251,6 +339,12 @@ unsigned NodeBasedCellPopulation<DIM>::RemoveDeadCells()
         }
     }
 
+    // Deaths invalidate the Verlet list
+    if (num_removed > 0)
+    {
+        mVerletReferenceLocations.clear();
+    }
+
     return num_removed;
 }
 
@@ -267,7 +361,7 @@ unsigned NodeBasedCellPopulation<DIM>::GetNumNodes()
 }
 
 template<unsigned DIM>
-CellPtr NodeBasedCellPopulation<DIM>::GetCellUsingLocationIndex(unsigned index)
+const CellPtr& NodeBasedCellPopulation<DIM>::rGetCellUsingLocationIndex(unsigned index)
 {
     std::map<unsigned, CellPtr>::iterator iter = mLocationHaloCellMap.find(index);
     if (iter != mLocationHaloCellMap.end())
@@ -276,7 +370,7 @@ CellPtr NodeBasedCellPopulation<DIM>::GetCellUsingLocationIndex(unsigned index)
     }
     else
     {
-        return AbstractCellPopulation<DIM, DIM>::GetCellUsingLocationIndex(index);
+        return AbstractCellPopulation<DIM, DIM>::rGetCellUsingLocationIndex(index);
     }
 }
 
@@ -296,6 +390,10 @@ void NodeBasedCellPopulation<DIM>::OutputCellPopulationParameters(out_stream& rP
 {
     *rParamsFile << "\t\t<MechanicsCutOffLength>" << mpNodesOnlyMesh->GetMaximumInteractionDistance() << "</MechanicsCutOffLength>\n";
     *rParamsFile << "\t\t<UseVariableRadii>" << mUseVariableRadii << "</UseVariableRadii>\n";
+    *rParamsFile << "\t\t<UseVerletList>" << mUseVerletList << "</UseVerletList>\n";
+    *rParamsFile << "\t\t<VerletSkin>" << mVerletSkin << "</VerletSkin>\n";
+    *rParamsFile << "\t\t<NeighbourListSkin>" << mpNodesOnlyMesh->GetNeighbourListSkin() << "</NeighbourListSkin>\n";
+    *rParamsFile << "\t\t<UseFlatCellList>" << mpNodesOnlyMesh->GetUseFlatCellList() << "</UseFlatCellList>\n";
 
     // Call method on direct parent class
     AbstractCentreBasedCellPopulation<DIM>::OutputCellPopulationParameters(rParamsFile);
@@ -355,6 +453,122 @@ void NodeBasedCellPopulation<DIM>::SetLoadBalanceFrequency(unsigned loadBalanceF
     mLoadBalanceFrequency = loadBalanceFrequency;
 }
 
+template<unsigned DIM>
+void NodeBasedCellPopulation<DIM>::SetUseVerletList(bool useVerletList)
+{
+    mUseVerletList = useVerletList;
+    mVerletReferenceLocations.clear();
+
+    // The boxes must be wide enough to find all pairs within the cut-off length plus the skin
+    mpNodesOnlyMesh->SetNeighbourListSkin(mUseVerletList ? mVerletSkin : 0.0);
+}
+
+template<unsigned DIM>
+bool NodeBasedCellPopulation<DIM>::GetUseVerletList()
+{
+    return mUseVerletList;
+}
+
+template<unsigned DIM>
+void NodeBasedCellPopulation<DIM>::SetVerletSkin(double verletSkin)
+{
+    if (!(verletSkin > 0.0))
+    {
+        EXCEPTION("The Verlet skin distance must be positive");
+    }
+    mVerletSkin = verletSkin;
+    mVerletReferenceLocations.clear();
+
+    if (mUseVerletList)
+    {
+        mpNodesOnlyMesh->SetNeighbourListSkin(mVerletSkin);
+    }
+}
+
+template<unsigned DIM>
+double NodeBasedCellPopulation<DIM>::GetVerletSkin()
+{
+    return mVerletSkin;
+}
+
+template<unsigned DIM>
+void NodeBasedCellPopulation<DIM>::SetFilterNodePairsByDistance(bool filterNodePairsByDistance)
+{
+    mFilterNodePairsByDistance = filterNodePairsByDistance;
+    InvalidateNodePairGeometry();
+}
+
+template<unsigned DIM>
+bool NodeBasedCellPopulation<DIM>::GetFilterNodePairsByDistance()
+{
+    return mFilterNodePairsByDistance;
+}
+
+template<unsigned DIM>
+void NodeBasedCellPopulation<DIM>::UpdateNodePairGeometry()
+{
+    if (mNodePairGeometryIsCurrent)
+    {
+        return;
+    }
+    mNodePairGeometryIsCurrent = true;
+
+    mFilteredNodePairs.clear();
+    mFilteredNodePairSeparations.clear();
+    mFilteredNodePairDistances.clear();
+
+    if (!mFilterNodePairsByDistance)
+    {
+        return;
+    }
+
+    double cut_off_length = mpNodesOnlyMesh->GetMaximumInteractionDistance();
+
+    for (unsigned i=0; i<mNodePairs.size(); i++)
+    {
+        // Use GetVectorFromAtoB() to allow for periodicity
+        c_vector<double, DIM> node_a_to_b = mpNodesOnlyMesh->GetVectorFromAtoB(mNodePairs[i].first->rGetLocation(), mNodePairs[i].second->rGetLocation());
+        double distance_between_nodes = norm_2(node_a_to_b);
+
+        // Keep pairs that overlap beyond the cut-off length, as RepulsionForce acts between them
+        double sum_of_radii = mNodePairs[i].first->GetRadius() + mNodePairs[i].second->GetRadius();
+
+        if (distance_between_nodes < std::max(cut_off_length, sum_of_radii))
+        {
+            mFilteredNodePairs.push_back(mNodePairs[i]);
+            mFilteredNodePairSeparations.push_back(node_a_to_b);
+            mFilteredNodePairDistances.push_back(distance_between_nodes);
+        }
+    }
+}
+
+template<unsigned DIM>
+void NodeBasedCellPopulation<DIM>::InvalidateNodePairGeometry()
+{
+    mNodePairGeometryIsCurrent = false;
+}
+
+template<unsigned DIM>
+std::vector< std::pair<Node<DIM>*, Node<DIM>* > >& NodeBasedCellPopulation<DIM>::rGetFilteredNodePairs()
+{
+    UpdateNodePairGeometry();
+    return mFilteredNodePairs;
+}
+
+template<unsigned DIM>
+const std::vector<c_vector<double, DIM> >& NodeBasedCellPopulation<DIM>::rGetFilteredNodePairSeparations()
+{
+    UpdateNodePairGeometry();
+    return mFilteredNodePairSeparations;
+}
+
+template<unsigned DIM>
+const std::vector<double>& NodeBasedCellPopulation<DIM>::rGetFilteredNodePairDistances()
+{
+    UpdateNodePairGeometry();
+    return mFilteredNodePairDistances;
+}
+
 template<unsigned DIM>
 double NodeBasedCellPopulation<DIM>::GetWidth(const unsigned& rDimension)
 {
@@ -722,6 +936,9 @@ CellPtr NodeBasedCellPopulation<DIM>::AddCell(CellPtr pNewCell, CellPtr pParentC
 
     p_new_node->SetRadius(p_parent_node->GetRadius());
 
+    // Births invalidate the Verlet list
+    mVerletReferenceLocations.clear();
+
     // Return pointer to new cell
     return p_created_cell;
 }
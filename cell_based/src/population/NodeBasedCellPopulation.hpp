@@ -40,6 +40,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/serialization/base_object.hpp>
 
 
+#include "ChasteSerializationVersion.hpp"
 #include "ObjectCommunicator.hpp"
 #include "AbstractCentreBasedCellPopulation.hpp"
 #include "NodesOnlyMesh.hpp"
@@ -113,6 +114,47 @@ private:
     /** The frequency at which the mesh is rebalanced */
     unsigned mLoadBalanceFrequency;
 
+    /** Whether to keep node pairs in a Verlet list between time steps. Defaults to false. */
+    bool mUseVerletList;
+
+    /**
+     * The skin distance of the Verlet list: node pairs are stored if they are closer than
+     * the mechanics cut-off length plus the skin. Defaults to 0.25.
+     */
+    double mVerletSkin;
+
+    /**
+     * The node locations when the Verlet list was last built, in the order of the node
+     * iterator. Empty if the list needs to be rebuilt.
+     */
+    std::vector<c_vector<double, DIM> > mVerletReferenceLocations;
+
+    /**
+     * Whether to keep, alongside mNodePairs, the node pairs that lie closer than the mechanics
+     * cut-off length together with their separations. Defaults to false.
+     */
+    bool mFilterNodePairsByDistance;
+
+    /**
+     * The node pairs in mNodePairs that lie closer than the mechanics cut-off length or the sum of
+     * their node radii. Together with mFilteredNodePairSeparations and mFilteredNodePairDistances
+     * this forms a struct-of-arrays pair buffer, filled by UpdateNodePairGeometry() if
+     * mFilterNodePairsByDistance is true.
+     */
+    std::vector< std::pair<Node<DIM>*, Node<DIM>* > > mFilteredNodePairs;
+
+    /** The vector from the first to the second node of each pair in mFilteredNodePairs. */
+    std::vector<c_vector<double, DIM> > mFilteredNodePairSeparations;
+
+    /** The distance between the nodes of each pair in mFilteredNodePairs. */
+    std::vector<double> mFilteredNodePairDistances;
+
+    /**
+     * Whether mFilteredNodePairs and their separations match the current node pairs and locations.
+     * Cleared by InvalidateNodePairGeometry().
+     */
+    bool mNodePairGeometryIsCurrent;
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -129,10 +171,31 @@ private:
     {
         archive & boost::serialization::base_object<AbstractCentreBasedCellPopulation<DIM> >(*this);
         archive & mUseVariableRadii;
+        if (version > 0)
+        {
+            archive & mUseVerletList;
+            archive & mVerletSkin;
+        }
 
         this->Validate();
     }
 
+    /**
+     * Whether the Verlet list must be rebuilt, i.e. if there have been births or deaths since it was built,
+     * or if any node has moved by more than half the skin distance since then. Always true in parallel,
+     * since the halo nodes are refreshed on every call to Update().
+     *
+     * @param hasHadBirthsOrDeaths whether there have been any births or deaths since the last call to Update()
+     * @return whether the Verlet list must be rebuilt.
+     */
+    bool IsVerletListRebuildRequired(bool hasHadBirthsOrDeaths);
+
+    /**
+     * Remove the node pairs that are further apart than the cut-off length plus the skin from
+     * mNodePairs, and store the current node locations for IsVerletListRebuildRequired().
+     */
+    void BuildVerletList();
+
     /**
      * Overridden AddNode() method.
      *
@@ -309,12 +372,12 @@ public:
 
     /**
      * Overridden method from AbstractCellPopulation so that we can access halo cells
-     * through this method.
+     * through this method (and GetCellUsingLocationIndex()).
      *
      * @param index the global index of the node assocaited with a cell
      * @return the (set of) cells to which the node is attached.
      */
-    virtual CellPtr GetCellUsingLocationIndex(unsigned index);
+    virtual const CellPtr& rGetCellUsingLocationIndex(unsigned index);
 
     /**
      * Overridden GetNode() method.
@@ -427,6 +490,82 @@ public:
      */
     void SetLoadBalanceFrequency(unsigned loadBalanceFrequency);
 
+    /**
+     * Set whether to keep the node pairs in a Verlet list. The node pairs are then found within the
+     * mechanics cut-off length plus a skin distance, and are only recalculated when there have been
+     * births or deaths, or when some node has moved by more than half the skin since they were last
+     * calculated. Forces that only act between nodes closer than the cut-off length are unchanged.
+     *
+     * The width of the boxes in the NodesOnlyMesh is increased by the skin while the Verlet list is
+     * in use. In parallel the node pairs are still recalculated on every call to Update().
+     *
+     * @param useVerletList whether to use a Verlet list (defaults to true)
+     */
+    void SetUseVerletList(bool useVerletList=true);
+
+    /**
+     * @return mUseVerletList
+     */
+    bool GetUseVerletList();
+
+    /**
+     * Set the skin distance of the Verlet list.
+     *
+     * @param verletSkin the new skin distance (must be positive)
+     */
+    void SetVerletSkin(double verletSkin);
+
+    /**
+     * @return mVerletSkin
+     */
+    double GetVerletSkin();
+
+    /**
+     * Set whether to filter the node pairs by distance. If true, UpdateNodePairGeometry() stores the
+     * node pairs that lie closer than the mechanics cut-off length or the sum of their node radii,
+     * along with the vector between and distance between their nodes, and subclasses of
+     * AbstractTwoBodyInteractionForce use these in place of rGetNodePairs(). Note that other pairs
+     * then exert no force, as if SetCutOffLength() had been called on each force; pairs of large
+     * cells are kept so that forces such as RepulsionForce, which act out to the sum of the radii,
+     * are unchanged.
+     *
+     * @param filterNodePairsByDistance whether to filter the node pairs (defaults to true)
+     */
+    void SetFilterNodePairsByDistance(bool filterNodePairsByDistance=true);
+
+    /**
+     * @return mFilterNodePairsByDistance
+     */
+    bool GetFilterNodePairsByDistance();
+
+    /**
+     * Recalculate the filtered node pairs and their separations from the current node locations,
+     * if they are out of date. Does nothing unless mFilterNodePairsByDistance is true.
+     */
+    void UpdateNodePairGeometry();
+
+    /**
+     * Mark the filtered node pairs and their separations as out of date, so that they are
+     * recalculated when next used. Called by Update() and SetNode(); code that moves nodes
+     * directly, for example through Node::rGetModifiableLocation(), must call this method.
+     */
+    void InvalidateNodePairGeometry();
+
+    /**
+     * @return mFilteredNodePairs, recalculated first if out of date
+     */
+    std::vector< std::pair<Node<DIM>*, Node<DIM>* > >& rGetFilteredNodePairs();
+
+    /**
+     * @return mFilteredNodePairSeparations, recalculated first if out of date
+     */
+    const std::vector<c_vector<double, DIM> >& rGetFilteredNodePairSeparations();
+
+    /**
+     * @return mFilteredNodePairDistances, recalculated first if out of date
+     */
+    const std::vector<double>& rGetFilteredNodePairDistances();
+
     /**
      * Overridden GetWidth() method.
      *
@@ -540,6 +679,19 @@ namespace boost
 {
 namespace serialization
 {
+/**
+ * Specify a version number for archive backwards compatibility.
+ *
+ * This is how to do BOOST_CLASS_VERSION(NodeBasedCellPopulation, 1)
+ * with a templated class.
+ */
+template <unsigned DIM>
+struct version<NodeBasedCellPopulation<DIM> >
+{
+    ///Macro to set the version number of templated archive in known versions of Boost
+    CHASTE_VERSION_CONTENT(1);
+};
+
 /**
  * Serialize information required to construct a NodeBasedCellPopulation.
  */
@@ -33,12 +33,16 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 */
 
+#include <algorithm>
+#include <climits>
+#include <exception>
 #include "PottsBasedCellPopulation.hpp"
 #include "RandomNumberGenerator.hpp"
 #include "AbstractPottsUpdateRule.hpp"
 #include "NodesOnlyMesh.hpp"
 #include "CellPopulationElementWriter.hpp"
 #include "CellIdWriter.hpp"
+#include "ThreadingTools.hpp"
 
 // Needed to convert mesh in order to write nodes to VTK (visualize as glyphs)
 #include "VtkMeshWriter.hpp"
@@ -81,7 +85,8 @@ PottsBasedCellPopulation<DIM>::PottsBasedCellPopulation(PottsMesh<DIM>& rMesh,
       mpElementTessellation(nullptr),
       mpMutableMesh(nullptr),
       mTemperature(0.1),
-      mNumSweepsPerTimestep(1)
+      mNumSweepsPerTimestep(1),
+      mUseCheckerboardSweep(false)
 {
     mpPottsMesh = static_cast<PottsMesh<DIM>* >(&(this->mrMesh));
     // Check each element has only one cell associated with it
@@ -97,7 +102,8 @@ PottsBasedCellPopulation<DIM>::PottsBasedCellPopulation(PottsMesh<DIM>& rMesh)
       mpElementTessellation(nullptr),
       mpMutableMesh(nullptr),
       mTemperature(0.1),
-      mNumSweepsPerTimestep(1)
+      mNumSweepsPerTimestep(1),
+      mUseCheckerboardSweep(false)
 {
     mpPottsMesh = static_cast<PottsMesh<DIM>* >(&(this->mrMesh));
 }
@@ -226,6 +232,7 @@ unsigned PottsBasedCellPopulation<DIM>::RemoveDeadCells()
             mpPottsMesh->DeleteElement(location_index);
 
             // Erase cell and update counter
+            this->RemoveCellUsingLocationIndex(location_index, *cell_iter);
             cell_iter = this->mCells.erase(cell_iter);
             num_removed++;
         }
@@ -262,6 +269,12 @@ void PottsBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
         p_gen->Shuffle(this->mUpdateRuleCollection);
     }
 
+    if (mUseCheckerboardSweep)
+    {
+        UpdateCellLocationsWithCheckerboardSweep();
+        return;
+    }
+
     for (unsigned i=0; i<num_nodes*mNumSweepsPerTimestep; i++)
     {
         unsigned node_index;
@@ -298,24 +311,10 @@ void PottsBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
 
             neighbour_location_index = *neighbour_iter;
 
-            std::set<unsigned> containing_elements = p_node->rGetContainingElementIndices();
-            std::set<unsigned> neighbour_containing_elements = GetNode(neighbour_location_index)->rGetContainingElementIndices();
             // Only calculate Hamiltonian and update elements if the nodes are from different elements, or one is from the medium
-            if ((!containing_elements.empty() && neighbour_containing_elements.empty())
-                || (containing_elements.empty() && !neighbour_containing_elements.empty())
-                || (!containing_elements.empty() && !neighbour_containing_elements.empty() && *containing_elements.begin() != *neighbour_containing_elements.begin()))
+            if (IsSpinCopyCandidate(node_index, neighbour_location_index))
             {
-                double delta_H = 0.0; // This is H_1-H_0.
-
-                // Now add contributions to the Hamiltonian from each AbstractPottsUpdateRule
-                for (typename std::vector<boost::shared_ptr<AbstractUpdateRule<DIM> > >::iterator iter = this->mUpdateRuleCollection.begin();
-                     iter != this->mUpdateRuleCollection.end();
-                     ++iter)
-                {
-                    // This static cast is fine, since we assert the update rule must be a Potts update rule in AddUpdateRule()
-                    double dH = (boost::static_pointer_cast<AbstractPottsUpdateRule<DIM> >(*iter))->EvaluateHamiltonianContribution(neighbour_location_index, p_node->GetIndex(), *this);
-                    delta_H += dH;
-                }
+                double delta_H = EvaluateDeltaHamiltonian(node_index, neighbour_location_index); // This is H_1-H_0.
 
                 // Generate a uniform random number to do the random motion
                 double random_number = p_gen->ranf();
@@ -323,27 +322,226 @@ void PottsBasedCellPopulation<DIM>::UpdateCellLocations(double dt)
                 double p = exp(-delta_H/mTemperature);
                 if (delta_H <= 0 || random_number < p)
                 {
-                    // Do swap
+                    CopySpin(node_index, neighbour_location_index);
+                }
+            }
+        }
+    }
+}
+
+template<unsigned DIM>
+bool PottsBasedCellPopulation<DIM>::IsSpinCopyCandidate(unsigned nodeIndex, unsigned neighbourIndex)
+{
+    const std::set<unsigned>& r_containing_elements = this->mrMesh.GetNode(nodeIndex)->rGetContainingElementIndices();
+    const std::set<unsigned>& r_neighbour_containing_elements = this->mrMesh.GetNode(neighbourIndex)->rGetContainingElementIndices();
+
+    return (!r_containing_elements.empty() && r_neighbour_containing_elements.empty())
+           || (r_containing_elements.empty() && !r_neighbour_containing_elements.empty())
+           || (!r_containing_elements.empty() && !r_neighbour_containing_elements.empty() && *r_containing_elements.begin() != *r_neighbour_containing_elements.begin());
+}
+
+template<unsigned DIM>
+double PottsBasedCellPopulation<DIM>::EvaluateDeltaHamiltonian(unsigned nodeIndex, unsigned neighbourIndex)
+{
+    double delta_H = 0.0;
+
+    // Add contributions to the Hamiltonian from each AbstractPottsUpdateRule
+    for (typename std::vector<boost::shared_ptr<AbstractUpdateRule<DIM> > >::iterator iter = this->mUpdateRuleCollection.begin();
+         iter != this->mUpdateRuleCollection.end();
+         ++iter)
+    {
+        // This static cast is fine, since we assert the update rule must be a Potts update rule in AddUpdateRule()
+        double dH = (boost::static_pointer_cast<AbstractPottsUpdateRule<DIM> >(*iter))->EvaluateHamiltonianContribution(neighbourIndex, nodeIndex, *this);
+        delta_H += dH;
+    }
+    return delta_H;
+}
+
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::CopySpin(unsigned nodeIndex, unsigned neighbourIndex)
+{
+    // Take copies, as the containing element sets are modified below
+    std::set<unsigned> containing_elements = this->mrMesh.GetNode(nodeIndex)->rGetContainingElementIndices();
+    std::set<unsigned> neighbour_containing_elements = this->mrMesh.GetNode(neighbourIndex)->rGetContainingElementIndices();
+
+    // Remove the current node from any elements containing it (there should be at most one such element)
+    for (std::set<unsigned>::iterator iter = containing_elements.begin();
+         iter != containing_elements.end();
+         ++iter)
+    {
+        GetElement(*iter)->DeleteNode(GetElement(*iter)->GetNodeLocalIndex(nodeIndex));
+
+        ///\todo If this causes the element to have no nodes then flag the element and cell to be deleted
+    }
+
+    // Next add the current node to any elements containing the neighbouring node (there should be at most one such element)
+    for (std::set<unsigned>::iterator iter = neighbour_containing_elements.begin();
+         iter != neighbour_containing_elements.end();
+         ++iter)
+    {
+        GetElement(*iter)->AddNode(this->mrMesh.GetNode(nodeIndex));
+    }
+}
+
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::SetUpCheckerboardSweep()
+{
+    unsigned num_nodes = this->mrMesh.GetNumNodes();
+
+    // Flatten the Moore neighbourhoods; std::set iteration order means each list is sorted
+    mFlatMooreNeighbourOffsets.assign(1, 0);
+    mFlatMooreNeighbourIndices.clear();
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        std::set<unsigned> neighbours = mpPottsMesh->GetMooreNeighbouringNodeIndices(node_index);
+        mFlatMooreNeighbourIndices.insert(mFlatMooreNeighbourIndices.end(), neighbours.begin(), neighbours.end());
+        mFlatMooreNeighbourOffsets.push_back(mFlatMooreNeighbourIndices.size());
+    }
 
-                    // Remove the current node from any elements containing it (there should be at most one such element)
-                    for (std::set<unsigned>::iterator iter = containing_elements.begin();
-                         iter != containing_elements.end();
-                         ++iter)
+    // Greedily colour the Moore neighbourhood graph, giving each node the lowest colour unused by its neighbours
+    std::vector<unsigned> node_colours(num_nodes, UINT_MAX);
+    unsigned num_colours = 0;
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        std::vector<bool> colour_is_used(num_colours + 1, false);
+        for (unsigned k=mFlatMooreNeighbourOffsets[node_index]; k<mFlatMooreNeighbourOffsets[node_index+1]; k++)
+        {
+            unsigned neighbour_colour = node_colours[mFlatMooreNeighbourIndices[k]];
+            if (neighbour_colour != UINT_MAX)
+            {
+                colour_is_used[neighbour_colour] = true;
+            }
+        }
+
+        unsigned colour = 0;
+        while (colour_is_used[colour])
+        {
+            colour++;
+        }
+        node_colours[node_index] = colour;
+        num_colours = std::max(num_colours, colour + 1);
+    }
+
+    // Bucket the nodes by colour, preserving index order within each sublattice
+    mSublatticeOffsets.assign(num_colours + 1, 0);
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        mSublatticeOffsets[node_colours[node_index] + 1]++;
+    }
+    for (unsigned colour=0; colour<num_colours; colour++)
+    {
+        mSublatticeOffsets[colour + 1] += mSublatticeOffsets[colour];
+    }
+    mSublatticeNodeIndices.resize(num_nodes);
+    std::vector<unsigned> next_entry(mSublatticeOffsets.begin(), mSublatticeOffsets.end() - 1);
+    for (unsigned node_index=0; node_index<num_nodes; node_index++)
+    {
+        mSublatticeNodeIndices[next_entry[node_colours[node_index]]++] = node_index;
+    }
+}
+
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::UpdateCellLocationsWithCheckerboardSweep()
+{
+    RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+    unsigned num_nodes = this->mrMesh.GetNumNodes();
+
+    if (mFlatMooreNeighbourOffsets.size() != num_nodes + 1)
+    {
+        SetUpCheckerboardSweep();
+    }
+
+    unsigned num_sublattices = mSublatticeOffsets.size() - 1;
+    std::vector<unsigned> sublattice_order(num_sublattices);
+
+    // The neighbour whose spin each site of the current sublattice copies, or UINT_MAX if the move is rejected
+    std::vector<unsigned> accepted_neighbours(num_nodes);
+
+    for (unsigned sweep=0; sweep<mNumSweepsPerTimestep; sweep++)
+    {
+        if (this->mUpdateNodesInRandomOrder)
+        {
+            p_gen->Shuffle(num_sublattices, sublattice_order);
+        }
+        else
+        {
+            for (unsigned colour=0; colour<num_sublattices; colour++)
+            {
+                sublattice_order[colour] = colour;
+            }
+        }
+
+        for (unsigned i=0; i<num_sublattices; i++)
+        {
+            const unsigned colour = sublattice_order[i];
+            const unsigned first_entry = mSublatticeOffsets[colour];
+            const int num_sites = mSublatticeOffsets[colour + 1] - first_entry;
+
+            // Draw the seed for this phase from the global generator, so it is reproducible from the usual seed
+            const uint64_t seed = (uint64_t(p_gen->randMod(UINT_MAX)) << 32) | uint64_t(p_gen->randMod(UINT_MAX));
+
+            // Exceptions cannot leave a parallel region, so we keep the one thrown for the lowest site and rethrow it below
+            std::exception_ptr p_exception = nullptr;
+            int exception_site = INT_MAX;
+
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static) num_threads(ThreadingTools::GetNumThreads())
+#endif
+            for (int site=0; site<num_sites; site++)
+            {
+                try
+                {
+                    const unsigned node_index = mSublatticeNodeIndices[first_entry + site];
+                    accepted_neighbours[site] = UINT_MAX;
+
+                    // Each node in the mesh must be in at most one element
+                    assert(this->mrMesh.GetNode(node_index)->GetNumContainingElements() <= 1);
+
+                    const unsigned num_neighbours = mFlatMooreNeighbourOffsets[node_index + 1] - mFlatMooreNeighbourOffsets[node_index];
+                    if (num_neighbours > 0)
                     {
-                        GetElement(*iter)->DeleteNode(GetElement(*iter)->GetNodeLocalIndex(node_index));
+                        RandomNumberStream site_stream(seed, node_index);
+                        unsigned chosen_neighbour = site_stream.randMod(num_neighbours);
+                        unsigned neighbour_location_index = mFlatMooreNeighbourIndices[mFlatMooreNeighbourOffsets[node_index] + chosen_neighbour];
 
-                        ///\todo If this causes the element to have no nodes then flag the element and cell to be deleted
+                        if (IsSpinCopyCandidate(node_index, neighbour_location_index))
+                        {
+                            double delta_H = EvaluateDeltaHamiltonian(node_index, neighbour_location_index);
+                            if (delta_H <= 0 || site_stream.ranf() < exp(-delta_H/mTemperature))
+                            {
+                                accepted_neighbours[site] = neighbour_location_index;
+                            }
+                        }
                     }
-
-                    // Next add the current node to any elements containing the neighbouring node (there should be at most one such element)
-                    for (std::set<unsigned>::iterator iter = neighbour_containing_elements.begin();
-                         iter != neighbour_containing_elements.end();
-                         ++iter)
+                }
+                catch (...)
+                {
+#ifdef CHASTE_OPENMP
+#pragma omp critical(PottsBasedCellPopulationException)
+#endif
                     {
-                        GetElement(*iter)->AddNode(this->mrMesh.GetNode(node_index));
+                        if (site < exception_site)
+                        {
+                            exception_site = site;
+                            p_exception = std::current_exception();
+                        }
                     }
                 }
             }
+
+            if (p_exception)
+            {
+                std::rethrow_exception(p_exception);
+            }
+
+            // No two sites of a sublattice are neighbours, so the accepted moves are independent; apply them in order
+            for (int site=0; site<num_sites; site++)
+            {
+                if (accepted_neighbours[site] != UINT_MAX)
+                {
+                    CopySpin(mSublatticeNodeIndices[first_entry + site], accepted_neighbours[site]);
+                }
+            }
         }
     }
 }
@@ -488,6 +686,7 @@ void PottsBasedCellPopulation<DIM>::OutputCellPopulationParameters(out_stream& r
 {
     *rParamsFile << "\t\t<Temperature>" << mTemperature << "</Temperature>\n";
     *rParamsFile << "\t\t<NumSweepsPerTimestep>" << mNumSweepsPerTimestep << "</NumSweepsPerTimestep>\n";
+    *rParamsFile << "\t\t<UseCheckerboardSweep>" << mUseCheckerboardSweep << "</UseCheckerboardSweep>\n";
 
     // Call method on direct parent class
     AbstractOnLatticeCellPopulation<DIM>::OutputCellPopulationParameters(rParamsFile);
@@ -517,6 +716,18 @@ unsigned PottsBasedCellPopulation<DIM>::GetNumSweepsPerTimestep()
     return mNumSweepsPerTimestep;
 }
 
+template<unsigned DIM>
+void PottsBasedCellPopulation<DIM>::SetUseCheckerboardSweep(bool useCheckerboardSweep)
+{
+    mUseCheckerboardSweep = useCheckerboardSweep;
+}
+
+template<unsigned DIM>
+bool PottsBasedCellPopulation<DIM>::GetUseCheckerboardSweep()
+{
+    return mUseCheckerboardSweep;
+}
+
 template<unsigned DIM>
 void PottsBasedCellPopulation<DIM>::WriteVtkResultsToFile(const std::string& rDirectory)
 {
@@ -43,6 +43,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "MutableMesh.hpp"
 
 #include "ChasteSerialization.hpp"
+#include "ChasteSerializationVersion.hpp"
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/vector.hpp>
 
@@ -91,6 +92,32 @@ private:
      */
     unsigned mNumSweepsPerTimestep;
 
+    /**
+     * Whether to update the lattice using a checkerboard (sublattice) sweep, in which
+     * sites that are not Moore neighbours of each other are evaluated concurrently.
+     * Initialised to false in the constructor. Not archived.
+     */
+    bool mUseCheckerboardSweep;
+
+    /**
+     * Offsets into mFlatMooreNeighbourIndices: the Moore neighbours of node i are stored
+     * in entries mFlatMooreNeighbourOffsets[i] to mFlatMooreNeighbourOffsets[i+1]-1, in
+     * increasing order. Set up by SetUpCheckerboardSweep().
+     */
+    std::vector<unsigned> mFlatMooreNeighbourOffsets;
+
+    /** The Moore neighbours of every node, stored contiguously (see mFlatMooreNeighbourOffsets). */
+    std::vector<unsigned> mFlatMooreNeighbourIndices;
+
+    /**
+     * Offsets into mSublatticeNodeIndices: the nodes of sublattice (colour) c are stored in
+     * entries mSublatticeOffsets[c] to mSublatticeOffsets[c+1]-1. Set up by SetUpCheckerboardSweep().
+     */
+    std::vector<unsigned> mSublatticeOffsets;
+
+    /** The nodes of every sublattice, stored contiguously in increasing order (see mSublatticeOffsets). */
+    std::vector<unsigned> mSublatticeNodeIndices;
+
     friend class boost::serialization::access;
     /**
      * Serialize the object and its member variables.
@@ -117,6 +144,10 @@ private:
 
         archive & mTemperature;
         archive & mNumSweepsPerTimestep;
+        if (version > 0)
+        {
+            archive & mUseCheckerboardSweep;
+        }
     }
 
     /**
@@ -136,6 +167,58 @@ private:
      */
     virtual void WriteVtkResultsToFile(const std::string& rDirectory);
 
+    /**
+     * Whether a node and one of its neighbours lie in different elements, or exactly
+     * one of them lies in the medium, so that copying the neighbour's spin is a valid move.
+     *
+     * @param nodeIndex the index of the target node
+     * @param neighbourIndex the index of the neighbouring node
+     * @return whether the move should be evaluated
+     */
+    bool IsSpinCopyCandidate(unsigned nodeIndex, unsigned neighbourIndex);
+
+    /**
+     * @return the change in the Hamiltonian, summed over all update rules, if the
+     * target node is added to the element(s) containing the neighbouring node.
+     *
+     * @param nodeIndex the index of the target node
+     * @param neighbourIndex the index of the neighbouring node
+     */
+    double EvaluateDeltaHamiltonian(unsigned nodeIndex, unsigned neighbourIndex);
+
+    /**
+     * Move the target node out of any element containing it and into any element
+     * containing the neighbouring node.
+     *
+     * @param nodeIndex the index of the target node
+     * @param neighbourIndex the index of the neighbouring node
+     */
+    void CopySpin(unsigned nodeIndex, unsigned neighbourIndex);
+
+    /**
+     * Set up mFlatMooreNeighbourOffsets, mFlatMooreNeighbourIndices and the sublattices
+     * used by UpdateCellLocationsWithCheckerboardSweep().
+     *
+     * The sublattices are found by greedily colouring the Moore neighbourhood graph in
+     * node index order, so no two nodes of the same sublattice are Moore neighbours. On a
+     * regular lattice this gives 2^DIM sublattices.
+     */
+    void SetUpCheckerboardSweep();
+
+    /**
+     * Perform the Monte Carlo sweeps of UpdateCellLocations() one sublattice at a time.
+     *
+     * Since the change in the Hamiltonian at a site depends only on the site and its
+     * neighbours, all sites of a sublattice are evaluated concurrently against the
+     * configuration at the start of the phase, and accepted moves are then applied
+     * in node index order. Each site draws its random numbers from a RandomNumberStream
+     * keyed on a per-phase seed and the node index, so results do not depend on the
+     * number of threads.
+     * Global element properties (volume, surface area) are read at the start of each
+     * phase, so this is not identical to the serial random-site sweep.
+     */
+    void UpdateCellLocationsWithCheckerboardSweep();
+
 public:
 
     /**
@@ -394,6 +477,19 @@ public:
      */
     unsigned GetNumSweepsPerTimestep();
 
+    /**
+     * Set mUseCheckerboardSweep.
+     *
+     * @param useCheckerboardSweep whether to update the lattice one sublattice at a time,
+     *     evaluating the sites of each sublattice concurrently (see ThreadingTools)
+     */
+    void SetUseCheckerboardSweep(bool useCheckerboardSweep);
+
+    /**
+     * @return mUseCheckerboardSweep
+     */
+    bool GetUseCheckerboardSweep();
+
     /**
      * Create a Element tessellation of the mesh for use in visualising the mesh.
      */
@@ -449,6 +545,19 @@ namespace boost
 {
 namespace serialization
 {
+/**
+ * Specify a version number for archive backwards compatibility.
+ *
+ * This is how to do BOOST_CLASS_VERSION(PottsBasedCellPopulation, 1)
+ * with a templated class.
+ */
+template <unsigned DIM>
+struct version<PottsBasedCellPopulation<DIM> >
+{
+    ///Macro to set the version number of templated archive in known versions of Boost
+    CHASTE_VERSION_CONTENT(1);
+};
+
 /**
  * Serialize information required to construct a PottsBasedCellPopulation.
  */
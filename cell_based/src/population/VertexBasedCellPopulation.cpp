@@ -171,7 +171,7 @@ unsigned VertexBasedCellPopulation<DIM>::GetNumNodes()
 template<unsigned DIM>
 c_vector<double, DIM> VertexBasedCellPopulation<DIM>::GetLocationOfCellCentre(CellPtr pCell)
 {
-    return mpMutableVertexMesh->GetCentroidOfElement(this->mCellLocationMap[pCell.get()]);
+    return mpMutableVertexMesh->GetCentroidOfElement(this->GetLocationIndexUsingCell(pCell));
 }
 
 template<unsigned DIM>
@@ -258,7 +258,6 @@ CellPtr VertexBasedCellPopulation<DIM>::AddCell(CellPtr pNewCell, CellPtr pParen
     // Update location cell map
     CellPtr p_created_cell = this->mCells.back();
     this->SetCellUsingLocationIndex(new_element_index,p_created_cell);
-    this->mCellLocationMap[p_created_cell.get()] = new_element_index;
 
     return p_created_cell;
 }
@@ -288,6 +287,7 @@ unsigned VertexBasedCellPopulation<DIM>::RemoveDeadCells()
             }
 
             // Delete the cell
+            this->mCellLocationIndex.RemoveCell(*it);
             it = this->mCells.erase(it);
         }
         else
@@ -340,18 +340,24 @@ void VertexBasedCellPopulation<DIM>::Update(bool hasHadBirthsOrDeaths)
     if (!element_map.IsIdentityMap())
     {
         // Fix up the mappings between CellPtrs and VertexElements
-        ///\todo We want to make these maps private, so we need a better way of doing the code below.
-        std::map<Cell*, unsigned> old_map = this->mCellLocationMap;
+        std::vector<unsigned> old_elem_indices;
+        old_elem_indices.reserve(this->mCells.size());
+        for (std::list<CellPtr>::iterator cell_iter = this->mCells.begin();
+             cell_iter != this->mCells.end();
+             ++cell_iter)
+        {
+            old_elem_indices.push_back(this->GetLocationIndexUsingCell(*cell_iter));
+        }
 
-        this->mCellLocationMap.clear();
-        this->mLocationCellMap.clear();
+        this->mCellLocationIndex.Clear();
 
+        std::vector<unsigned>::iterator old_index_iter = old_elem_indices.begin();
         for (std::list<CellPtr>::iterator cell_iter = this->mCells.begin();
              cell_iter != this->mCells.end();
-             ++cell_iter)
+             ++cell_iter, ++old_index_iter)
         {
             // The cell vector should only ever contain living cells
-            unsigned old_elem_index = old_map[(*cell_iter).get()];
+            unsigned old_elem_index = *old_index_iter;
             assert(!element_map.IsDeleted(old_elem_index));
 
             unsigned new_elem_index = element_map.GetNewIndex(old_elem_index);
@@ -33,7 +33,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 */
 
+#include <climits>
+#include <exception>
+
 #include "AbstractTwoBodyInteractionForce.hpp"
+#include "ThreadingTools.hpp"
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::AbstractTwoBodyInteractionForce()
@@ -95,31 +99,140 @@ void AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::AddForceContributio
         }
     }
     else    // This is a NodeBasedCellPopulation
+    {
+        AddForceContributionsFromCentreBasedNodePairs(rCellPopulation);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+c_vector<double, SPACE_DIM> AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::CalculateForceBetweenNodesWithSeparation(unsigned nodeAGlobalIndex,
+                                                                                                                            unsigned nodeBGlobalIndex,
+                                                                                                                            AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation,
+                                                                                                                            const c_vector<double, SPACE_DIM>& rVectorFromAtoB,
+                                                                                                                            double distanceBetweenNodes)
+{
+    return CalculateForceBetweenNodes(nodeAGlobalIndex, nodeBGlobalIndex, rCellPopulation);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::AddForceContributionsFromCentreBasedNodePairs(AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation)
+{
+    NodeBasedCellPopulation<SPACE_DIM>* p_node_based_cell_population = dynamic_cast<NodeBasedCellPopulation<SPACE_DIM>*>(&rCellPopulation);
+
+    if ((p_node_based_cell_population != nullptr) && p_node_based_cell_population->GetFilterNodePairsByDistance())
+    {
+        // Use the node pairs within the cut-off length, whose separations have already been calculated
+        AddForceContributionsFromNodePairs(p_node_based_cell_population->rGetFilteredNodePairs(),
+                                           rCellPopulation,
+                                           &(p_node_based_cell_population->rGetFilteredNodePairSeparations()),
+                                           &(p_node_based_cell_population->rGetFilteredNodePairDistances()));
+    }
+    else
     {
         AbstractCentreBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>* p_static_cast_cell_population = static_cast<AbstractCentreBasedCellPopulation<ELEMENT_DIM,SPACE_DIM>*>(&rCellPopulation);
 
-        std::vector< std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > >& r_node_pairs = p_static_cast_cell_population->rGetNodePairs();
+        AddForceContributionsFromNodePairs(p_static_cast_cell_population->rGetNodePairs(), rCellPopulation);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::IsNodePairInteracting(Node<SPACE_DIM>* pNodeA,
+                                                                                   Node<SPACE_DIM>* pNodeB,
+                                                                                   AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation)
+{
+    return true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::IsNodePairInteractingAtDistance(Node<SPACE_DIM>* pNodeA,
+                                                                                             Node<SPACE_DIM>* pNodeB,
+                                                                                             double distanceBetweenNodes,
+                                                                                             AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation)
+{
+    return IsNodePairInteracting(pNodeA, pNodeB, rCellPopulation);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractTwoBodyInteractionForce<ELEMENT_DIM,SPACE_DIM>::AddForceContributionsFromNodePairs(std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >& rNodePairs,
+                                                                                                AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation,
+                                                                                                const std::vector<c_vector<double, SPACE_DIM> >* pSeparations,
+                                                                                                const std::vector<double>* pDistances)
+{
+    const unsigned num_pairs = rNodePairs.size();
+    const bool use_separations = (pSeparations != nullptr);
+    assert(!use_separations || (pDistances != nullptr && pSeparations->size() == num_pairs && pDistances->size() == num_pairs));
+
+    // Calculate the force for each pair; pair_is_interacting is not a vector<bool>, as its entries are written concurrently
+    std::vector<c_vector<double, SPACE_DIM> > pair_forces(num_pairs);
+    std::vector<unsigned char> pair_is_interacting(num_pairs, 0);
+
+    // Exceptions cannot leave a parallel region, so we keep the one thrown for the lowest pair index and rethrow it below
+    std::exception_ptr p_exception = nullptr;
+    unsigned exception_pair_index = UINT_MAX;
 
-        for (typename std::vector< std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > >::iterator iter = r_node_pairs.begin();
-            iter != r_node_pairs.end();
-            iter++)
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(static) num_threads(ThreadingTools::GetNumThreads())
+#endif
+    for (unsigned pair_index=0; pair_index<num_pairs; pair_index++)
+    {
+        try
         {
-            std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>* > pair = *iter;
+            Node<SPACE_DIM>* p_node_a = rNodePairs[pair_index].first;
+            Node<SPACE_DIM>* p_node_b = rNodePairs[pair_index].second;
 
-            unsigned node_a_index = pair.first->GetIndex();
-            unsigned node_b_index = pair.second->GetIndex();
+            if (use_separations)
+            {
+                if (IsNodePairInteractingAtDistance(p_node_a, p_node_b, (*pDistances)[pair_index], rCellPopulation))
+                {
+                    // Calculate the force between nodes, reusing their separation
+                    pair_forces[pair_index] = CalculateForceBetweenNodesWithSeparation(p_node_a->GetIndex(), p_node_b->GetIndex(), rCellPopulation,
+                                                                                       (*pSeparations)[pair_index], (*pDistances)[pair_index]);
+                    pair_is_interacting[pair_index] = 1;
+                }
+            }
+            else if (IsNodePairInteracting(p_node_a, p_node_b, rCellPopulation))
+            {
+                // Calculate the force between nodes
+                pair_forces[pair_index] = CalculateForceBetweenNodes(p_node_a->GetIndex(), p_node_b->GetIndex(), rCellPopulation);
+                pair_is_interacting[pair_index] = 1;
+            }
 
-            // Calculate the force between nodes
-            c_vector<double, SPACE_DIM> force = CalculateForceBetweenNodes(node_a_index, node_b_index, rCellPopulation);
-            for (unsigned j=0; j<SPACE_DIM; j++)
+            if (pair_is_interacting[pair_index])
+            {
+                for (unsigned j=0; j<SPACE_DIM; j++)
+                {
+                    assert(!std::isnan(pair_forces[pair_index][j]));
+                }
+            }
+        }
+        catch (...)
+        {
+#ifdef CHASTE_OPENMP
+#pragma omp critical(AbstractTwoBodyInteractionForceException)
+#endif
             {
-                assert(!std::isnan(force[j]));
+                if (pair_index < exception_pair_index)
+                {
+                    exception_pair_index = pair_index;
+                    p_exception = std::current_exception();
+                }
             }
+        }
+    }
 
-            // Add the force contribution to each node
-            c_vector<double, SPACE_DIM> negative_force = -1.0*force;
-            pair.first->AddAppliedForceContribution(force);
-            pair.second->AddAppliedForceContribution(negative_force);
+    if (p_exception)
+    {
+        std::rethrow_exception(p_exception);
+    }
+
+    // Add the force contribution to each node, in the same order as a serial calculation
+    for (unsigned pair_index=0; pair_index<num_pairs; pair_index++)
+    {
+        if (pair_is_interacting[pair_index])
+        {
+            c_vector<double, SPACE_DIM> negative_force = -1.0*pair_forces[pair_index];
+            rNodePairs[pair_index].first->AddAppliedForceContribution(pair_forces[pair_index]);
+            rNodePairs[pair_index].second->AddAppliedForceContribution(negative_force);
         }
     }
 }
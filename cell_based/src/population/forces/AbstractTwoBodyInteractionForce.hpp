@@ -71,6 +71,75 @@ protected:
     /** Mechanics cut off length. */
     double mMechanicsCutOffLength;
 
+    /**
+     * Whether the force between a given pair of nodes should be calculated.
+     *
+     * Called by AddForceContributionsFromNodePairs() for each node pair, possibly
+     * concurrently from several threads, so overridden methods must not modify any
+     * shared state. By default all pairs interact.
+     *
+     * @param pNodeA one node of the pair
+     * @param pNodeB the other node of the pair
+     * @param rCellPopulation the cell population
+     *
+     * @return whether the nodes interact
+     */
+    virtual bool IsNodePairInteracting(Node<SPACE_DIM>* pNodeA,
+                                       Node<SPACE_DIM>* pNodeB,
+                                       AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation);
+
+    /**
+     * Whether the force between a given pair of nodes, whose separation is already known,
+     * should be calculated. Used in place of IsNodePairInteracting() when the cell population
+     * filters its node pairs by distance (see NodeBasedCellPopulation::SetFilterNodePairsByDistance()).
+     *
+     * By default this calls IsNodePairInteracting(). As for that method, overridden methods
+     * must not modify any shared state.
+     *
+     * @param pNodeA one node of the pair
+     * @param pNodeB the other node of the pair
+     * @param distanceBetweenNodes the distance between the nodes
+     * @param rCellPopulation the cell population
+     *
+     * @return whether the nodes interact
+     */
+    virtual bool IsNodePairInteractingAtDistance(Node<SPACE_DIM>* pNodeA,
+                                                 Node<SPACE_DIM>* pNodeB,
+                                                 double distanceBetweenNodes,
+                                                 AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation);
+
+    /**
+     * Calculate the force between each interacting pair of nodes in rNodePairs and
+     * add the force contributions to the nodes.
+     *
+     * The forces are calculated on ThreadingTools::GetNumThreads() threads and stored
+     * per pair, then added to the nodes serially in pair order. The applied forces are
+     * therefore bit-identical to those of a serial calculation, whatever the number of
+     * threads. This requires CalculateForceBetweenNodes() to be safe to call concurrently
+     * for different node pairs.
+     *
+     * If pSeparations and pDistances are given, they hold the vector between and distance between
+     * the nodes of each pair, and CalculateForceBetweenNodesWithSeparation() is called in place of
+     * CalculateForceBetweenNodes().
+     *
+     * @param rNodePairs the node pairs
+     * @param rCellPopulation the cell population
+     * @param pSeparations the vector from the first to the second node of each pair (defaults to nullptr)
+     * @param pDistances the distance between the nodes of each pair (defaults to nullptr)
+     */
+    void AddForceContributionsFromNodePairs(std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >& rNodePairs,
+                                            AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation,
+                                            const std::vector<c_vector<double, SPACE_DIM> >* pSeparations=nullptr,
+                                            const std::vector<double>* pDistances=nullptr);
+
+    /**
+     * Add the force contributions for a node-based cell population, using the node pairs
+     * filtered by distance if the population provides them and rGetNodePairs() otherwise.
+     *
+     * @param rCellPopulation the cell population, which must be a subclass of AbstractCentreBasedCellPopulation
+     */
+    void AddForceContributionsFromCentreBasedNodePairs(AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation);
+
 public:
 
     /**
@@ -116,6 +185,28 @@ public:
      */
     virtual c_vector<double, SPACE_DIM> CalculateForceBetweenNodes(unsigned nodeAGlobalIndex, unsigned nodeBGlobalIndex, AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>& rCellPopulation)=0;
 
+    /**
+     * Calculates the force between two nodes, given the vector from node A to node B and
+     * its length. Called in place of CalculateForceBetweenNodes() when the cell population
+     * filters its node pairs by distance, so that the separation is not recomputed.
+     *
+     * By default this ignores the separation and calls CalculateForceBetweenNodes(). Subclasses
+     * that override this method should also override CalculateForceBetweenNodes(), and vice versa.
+     *
+     * @param nodeAGlobalIndex index of one neighbouring node
+     * @param nodeBGlobalIndex index of the other neighbouring node
+     * @param rCellPopulation the cell population
+     * @param rVectorFromAtoB the vector from node A to node B
+     * @param distanceBetweenNodes the length of rVectorFromAtoB
+     *
+     * @return The force exerted on Node A by Node B.
+     */
+    virtual c_vector<double, SPACE_DIM> CalculateForceBetweenNodesWithSeparation(unsigned nodeAGlobalIndex,
+                                                                                 unsigned nodeBGlobalIndex,
+                                                                                 AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>& rCellPopulation,
+                                                                                 const c_vector<double, SPACE_DIM>& rVectorFromAtoB,
+                                                                                 double distanceBetweenNodes);
+
     /**
      * Overridden AddForceContribution() method.
      *
@@ -72,11 +72,32 @@ c_vector<double, DIM> BuskeElasticForce<DIM>::CalculateForceBetweenNodes(unsigne
     const c_vector<double, DIM>& r_node_a_location = p_node_a->rGetLocation();
     const c_vector<double, DIM>& r_node_b_location = p_node_b->rGetLocation();
 
-    // Get the unit vector parallel to the line joining the two nodes (assuming no periodicities etc.)
-    c_vector<double, DIM> unit_vector = r_node_b_location - r_node_a_location;
+    // Get the vector joining the two nodes (assuming no periodicities etc.)
+    c_vector<double, DIM> vector_from_a_to_b = r_node_b_location - r_node_a_location;
 
     // Calculate the distance between the two nodes
-    double distance_between_nodes = norm_2(unit_vector);
+    double distance_between_nodes = norm_2(vector_from_a_to_b);
+
+    return CalculateForceBetweenNodesWithSeparation(nodeAGlobalIndex, nodeBGlobalIndex, rCellPopulation, vector_from_a_to_b, distance_between_nodes);
+}
+
+template<unsigned DIM>
+c_vector<double, DIM> BuskeElasticForce<DIM>::CalculateForceBetweenNodesWithSeparation(unsigned nodeAGlobalIndex,
+                                                                                       unsigned nodeBGlobalIndex,
+                                                                                       AbstractCellPopulation<DIM>& rCellPopulation,
+                                                                                       const c_vector<double, DIM>& rVectorFromAtoB,
+                                                                                       double distanceBetweenNodes)
+{
+    // This force class is defined for NodeBasedCellPopulations only
+    assert(dynamic_cast<NodeBasedCellPopulation<DIM>*>(&rCellPopulation) != nullptr);
+
+    // We should only ever calculate the force between two distinct nodes
+    assert(nodeAGlobalIndex != nodeBGlobalIndex);
+
+    Node<DIM>* p_node_a = rCellPopulation.GetNode(nodeAGlobalIndex);
+    Node<DIM>* p_node_b = rCellPopulation.GetNode(nodeBGlobalIndex);
+
+    double distance_between_nodes = distanceBetweenNodes;
 
     // Account for any cutoff in the force law
     if (this->mUseCutOffLength)
@@ -91,8 +112,8 @@ c_vector<double, DIM> BuskeElasticForce<DIM>::CalculateForceBetweenNodes(unsigne
     assert(distance_between_nodes > 0);
     assert(!std::isnan(distance_between_nodes));
 
-    // Normalize the unit vector
-    unit_vector /= distance_between_nodes;
+    // Get the unit vector parallel to the line joining the two nodes
+    c_vector<double, DIM> unit_vector = rVectorFromAtoB/distance_between_nodes;
 
     // Get the cell radii
     double radius_of_cell_one = p_node_a->GetRadius();
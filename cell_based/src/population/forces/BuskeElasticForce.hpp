@@ -112,6 +112,24 @@ public:
      */
     c_vector<double, DIM> CalculateForceBetweenNodes(unsigned nodeAGlobalIndex, unsigned nodeBGlobalIndex, AbstractCellPopulation<DIM>& rCellPopulation);
 
+    /**
+     * @return the force between two nodes, given the vector between them.
+     *
+     * Called by CalculateForceBetweenNodes(), and directly by AbstractTwoBodyInteractionForce
+     * when the cell population filters its node pairs by distance.
+     *
+     * @param nodeAGlobalIndex index of one neighbouring node
+     * @param nodeBGlobalIndex index of the other neighbouring node
+     * @param rCellPopulation the cell population
+     * @param rVectorFromAtoB the vector from node A to node B
+     * @param distanceBetweenNodes the length of rVectorFromAtoB
+     */
+    c_vector<double, DIM> CalculateForceBetweenNodesWithSeparation(unsigned nodeAGlobalIndex,
+                                                                   unsigned nodeBGlobalIndex,
+                                                                   AbstractCellPopulation<DIM>& rCellPopulation,
+                                                                   const c_vector<double, DIM>& rVectorFromAtoB,
+                                                                   double distanceBetweenNodes);
+
     /**
      * @return calculated magnitude of the force between two nodes that are a given distance apart and
      * are associated with given cell radii.
@@ -59,10 +59,10 @@ double DifferentialAdhesionGeneralisedLinearSpringForce<ELEMENT_DIM, SPACE_DIM>:
     else
     {
         // Determine which (if any) of the cells corresponding to these nodes are labelled
-        CellPtr p_cell_A = rCellPopulation.GetCellUsingLocationIndex(nodeAGlobalIndex);
+        const CellPtr& p_cell_A = rCellPopulation.rGetCellUsingLocationIndex(nodeAGlobalIndex);
         bool cell_A_is_labelled = p_cell_A->template HasCellProperty<CellLabel>();
 
-        CellPtr p_cell_B = rCellPopulation.GetCellUsingLocationIndex(nodeBGlobalIndex);
+        const CellPtr& p_cell_B = rCellPopulation.rGetCellUsingLocationIndex(nodeBGlobalIndex);
         bool cell_B_is_labelled = p_cell_B->template HasCellProperty<CellLabel>();
 
         // For heterotypic interactions, scale the spring constant by mHeterotypicSpringConstantMultiplier
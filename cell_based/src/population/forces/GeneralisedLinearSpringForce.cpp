@@ -70,13 +70,47 @@ c_vector<double, SPACE_DIM> GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>:
     // We should only ever calculate the force between two distinct nodes
     assert(nodeAGlobalIndex != nodeBGlobalIndex);
 
+    // Get the node locations
+    const c_vector<double, SPACE_DIM>& r_node_a_location = rCellPopulation.GetNode(nodeAGlobalIndex)->rGetLocation();
+    const c_vector<double, SPACE_DIM>& r_node_b_location = rCellPopulation.GetNode(nodeBGlobalIndex)->rGetLocation();
+
+    /*
+     * We use the mesh method GetVectorFromAtoB() to compute the direction of the
+     * unit vector along the line joining the two nodes, rather than simply subtract
+     * their positions, because this method can be overloaded (e.g. to enforce a
+     * periodic boundary in Cylindrical2dMesh).
+     */
+    c_vector<double, SPACE_DIM> vector_from_a_to_b = rCellPopulation.rGetMesh().GetVectorFromAtoB(r_node_a_location, r_node_b_location);
+
+    // Calculate the distance between the two nodes
+    double distance_between_nodes = norm_2(vector_from_a_to_b);
+
+    return CalculateSpringForce(nodeAGlobalIndex, nodeBGlobalIndex, rCellPopulation, vector_from_a_to_b, distance_between_nodes);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+c_vector<double, SPACE_DIM> GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>::CalculateForceBetweenNodesWithSeparation(unsigned nodeAGlobalIndex,
+                                                                                                                         unsigned nodeBGlobalIndex,
+                                                                                                                         AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation,
+                                                                                                                         const c_vector<double, SPACE_DIM>& rVectorFromAtoB,
+                                                                                                                         double distanceBetweenNodes)
+{
+    return CalculateSpringForce(nodeAGlobalIndex, nodeBGlobalIndex, rCellPopulation, rVectorFromAtoB, distanceBetweenNodes);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+c_vector<double, SPACE_DIM> GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>::CalculateSpringForce(unsigned nodeAGlobalIndex,
+                                                                                                     unsigned nodeBGlobalIndex,
+                                                                                                     AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation,
+                                                                                                     const c_vector<double, SPACE_DIM>& rVectorFromAtoB,
+                                                                                                     double distanceBetweenNodes)
+{
+    // We should only ever calculate the force between two distinct nodes
+    assert(nodeAGlobalIndex != nodeBGlobalIndex);
+
     Node<SPACE_DIM>* p_node_a = rCellPopulation.GetNode(nodeAGlobalIndex);
     Node<SPACE_DIM>* p_node_b = rCellPopulation.GetNode(nodeBGlobalIndex);
 
-    // Get the node locations
-    const c_vector<double, SPACE_DIM>& r_node_a_location = p_node_a->rGetLocation();
-    const c_vector<double, SPACE_DIM>& r_node_b_location = p_node_b->rGetLocation();
-
     // Get the node radii for a NodeBasedCellPopulation
     double node_a_radius = 0.0;
     double node_b_radius = 0.0;
@@ -87,22 +121,13 @@ c_vector<double, SPACE_DIM> GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>:
         node_b_radius = p_node_b->GetRadius();
     }
 
-    // Get the unit vector parallel to the line joining the two nodes
-    c_vector<double, SPACE_DIM> unit_difference;
-    /*
-     * We use the mesh method GetVectorFromAtoB() to compute the direction of the
-     * unit vector along the line joining the two nodes, rather than simply subtract
-     * their positions, because this method can be overloaded (e.g. to enforce a
-     * periodic boundary in Cylindrical2dMesh).
-     */
-    unit_difference = rCellPopulation.rGetMesh().GetVectorFromAtoB(r_node_a_location, r_node_b_location);
-
-    // Calculate the distance between the two nodes
-    double distance_between_nodes = norm_2(unit_difference);
+    // Get the distance between the two nodes
+    double distance_between_nodes = distanceBetweenNodes;
     assert(distance_between_nodes > 0);
     assert(!std::isnan(distance_between_nodes));
 
-    unit_difference /= distance_between_nodes;
+    // Get the unit vector parallel to the line joining the two nodes
+    c_vector<double, SPACE_DIM> unit_difference = rVectorFromAtoB/distance_between_nodes;
 
     /*
      * If mUseCutOffLength has been set, then there is zero force between
@@ -134,8 +159,8 @@ c_vector<double, SPACE_DIM> GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>:
 
     double rest_length = rest_length_final;
 
-    CellPtr p_cell_A = rCellPopulation.GetCellUsingLocationIndex(nodeAGlobalIndex);
-    CellPtr p_cell_B = rCellPopulation.GetCellUsingLocationIndex(nodeBGlobalIndex);
+    const CellPtr& p_cell_A = rCellPopulation.rGetCellUsingLocationIndex(nodeAGlobalIndex);
+    const CellPtr& p_cell_B = rCellPopulation.rGetCellUsingLocationIndex(nodeBGlobalIndex);
 
     double ageA = p_cell_A->GetAge();
     double ageB = p_cell_B->GetAge();
@@ -153,16 +178,22 @@ c_vector<double, SPACE_DIM> GeneralisedLinearSpringForce<ELEMENT_DIM,SPACE_DIM>:
 
         std::pair<CellPtr,CellPtr> cell_pair = p_static_cast_cell_population->CreateCellPair(p_cell_A, p_cell_B);
 
+        /*
+         * Only marked springs are ever unmarked, so that populations without marked
+         * springs (e.g. NodeBasedCellPopulation) are only read here; this keeps this
+         * method safe to call concurrently for node-based populations.
+         */
         if (p_static_cast_cell_population->IsMarkedSpring(cell_pair))
         {
             // Spring rest length increases from a small value to the normal rest length over 1 hour
             double lambda = mMeinekeDivisionRestingSpringLength;
             rest_length = lambda + (rest_length_final - lambda) * ageA/mMeinekeSpringGrowthDuration;
-        }
-        if (ageA + SimulationTime::Instance()->GetTimeStep() >= mMeinekeSpringGrowthDuration)
-        {
-            // This spring is about to go out of scope
-            p_static_cast_cell_population->UnmarkSpring(cell_pair);
+
+            if (ageA + SimulationTime::Instance()->GetTimeStep() >= mMeinekeSpringGrowthDuration)
+            {
+                // This spring is about to go out of scope
+                p_static_cast_cell_population->UnmarkSpring(cell_pair);
+            }
         }
     }
 
@@ -113,6 +113,23 @@ protected:
      */
     double mMeinekeSpringGrowthDuration;
 
+    /**
+     * Calculate the spring force between two nodes, given the vector between them.
+     * Used by CalculateForceBetweenNodes() and CalculateForceBetweenNodesWithSeparation().
+     *
+     * @param nodeAGlobalIndex index of one neighbouring node
+     * @param nodeBGlobalIndex index of the other neighbouring node
+     * @param rCellPopulation the cell population
+     * @param rVectorFromAtoB the vector from node A to node B
+     * @param distanceBetweenNodes the length of rVectorFromAtoB
+     * @return The force exerted on Node A by Node B.
+     */
+    c_vector<double, SPACE_DIM> CalculateSpringForce(unsigned nodeAGlobalIndex,
+                                                     unsigned nodeBGlobalIndex,
+                                                     AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation,
+                                                     const c_vector<double, SPACE_DIM>& rVectorFromAtoB,
+                                                     double distanceBetweenNodes);
+
 public:
 
     /**
@@ -158,6 +175,26 @@ public:
     c_vector<double, SPACE_DIM> CalculateForceBetweenNodes(unsigned nodeAGlobalIndex,
                                                      unsigned nodeBGlobalIndex,
                                                      AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation);
+
+    /**
+     * Overridden CalculateForceBetweenNodesWithSeparation() method.
+     *
+     * Calculates the force between two nodes, given the vector between them. Subclasses
+     * that override CalculateForceBetweenNodes() must also override this method.
+     *
+     * @param nodeAGlobalIndex index of one neighbouring node
+     * @param nodeBGlobalIndex index of the other neighbouring node
+     * @param rCellPopulation the cell population
+     * @param rVectorFromAtoB the vector from node A to node B
+     * @param distanceBetweenNodes the length of rVectorFromAtoB
+     * @return The force exerted on Node A by Node B.
+     */
+    c_vector<double, SPACE_DIM> CalculateForceBetweenNodesWithSeparation(unsigned nodeAGlobalIndex,
+                                                                         unsigned nodeBGlobalIndex,
+                                                                         AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation,
+                                                                         const c_vector<double, SPACE_DIM>& rVectorFromAtoB,
+                                                                         double distanceBetweenNodes);
+
     /**
      * @return mMeinekeSpringStiffness
      */
@@ -50,47 +50,28 @@ void RepulsionForce<DIM>::AddForceContribution(AbstractCellPopulation<DIM>& rCel
         EXCEPTION("RepulsionForce is to be used with a NodeBasedCellPopulation only");
     }
 
-    std::vector< std::pair<Node<DIM>*, Node<DIM>* > >& r_node_pairs = (static_cast<NodeBasedCellPopulation<DIM>*>(&rCellPopulation))->rGetNodePairs();
+    this->AddForceContributionsFromCentreBasedNodePairs(rCellPopulation);
+}
 
-    for (typename std::vector< std::pair<Node<DIM>*, Node<DIM>* > >::iterator iter = r_node_pairs.begin();
-        iter != r_node_pairs.end();
-        iter++)
-    {
-        std::pair<Node<DIM>*, Node<DIM>* > pair = *iter;
-
-        Node<DIM>* p_node_a = pair.first;
-        Node<DIM>* p_node_b = pair.second;
-
-        // Get the node locations
-        const c_vector<double, DIM>& r_node_a_location = p_node_a->rGetLocation();
-        const c_vector<double, DIM>& r_node_b_location = p_node_b->rGetLocation();
-
-        // Get the node radii
-        double node_a_radius = p_node_a->GetRadius();
-        double node_b_radius = p_node_b->GetRadius();
-
-        // Get the unit vector parallel to the line joining the two nodes
-        c_vector<double, DIM> unit_difference;
-
-        unit_difference = (static_cast<NodeBasedCellPopulation<DIM>*>(&rCellPopulation))->rGetMesh().GetVectorFromAtoB(r_node_a_location, r_node_b_location);
-
-        // Calculate the value of the rest length
-        double rest_length = node_a_radius+node_b_radius;
-
-        if (norm_2(unit_difference) < rest_length)
-        {
-            // Calculate the force between nodes
-            c_vector<double, DIM> force = this->CalculateForceBetweenNodes(p_node_a->GetIndex(), p_node_b->GetIndex(), rCellPopulation);
-            c_vector<double, DIM> negative_force = -1.0 * force;
-            for (unsigned j=0; j<DIM; j++)
-            {
-                assert(!std::isnan(force[j]));
-            }
-            // Add the force contribution to each node
-            p_node_a->AddAppliedForceContribution(force);
-            p_node_b->AddAppliedForceContribution(negative_force);
-        }
-    }
+template<unsigned DIM>
+bool RepulsionForce<DIM>::IsNodePairInteracting(Node<DIM>* pNodeA, Node<DIM>* pNodeB, AbstractCellPopulation<DIM>& rCellPopulation)
+{
+    // Get the unit vector parallel to the line joining the two nodes
+    c_vector<double, DIM> unit_difference = rCellPopulation.rGetMesh().GetVectorFromAtoB(pNodeA->rGetLocation(), pNodeB->rGetLocation());
+
+    // Calculate the value of the rest length
+    double rest_length = pNodeA->GetRadius() + pNodeB->GetRadius();
+
+    return norm_2(unit_difference) < rest_length;
+}
+
+template<unsigned DIM>
+bool RepulsionForce<DIM>::IsNodePairInteractingAtDistance(Node<DIM>* pNodeA, Node<DIM>* pNodeB, double distanceBetweenNodes, AbstractCellPopulation<DIM>& rCellPopulation)
+{
+    // Calculate the value of the rest length
+    double rest_length = pNodeA->GetRadius() + pNodeB->GetRadius();
+
+    return distanceBetweenNodes < rest_length;
 }
 
 template<unsigned DIM>
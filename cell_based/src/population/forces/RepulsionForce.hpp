@@ -66,6 +66,35 @@ private :
         archive & boost::serialization::base_object<GeneralisedLinearSpringForce<DIM> >(*this);
     }
 
+protected :
+
+    /**
+     * Overridden IsNodePairInteracting() method.
+     *
+     * Nodes only repel each other if they are closer than the sum of their radii.
+     *
+     * @param pNodeA one node of the pair
+     * @param pNodeB the other node of the pair
+     * @param rCellPopulation the cell population
+     *
+     * @return whether the nodes overlap
+     */
+    bool IsNodePairInteracting(Node<DIM>* pNodeA, Node<DIM>* pNodeB, AbstractCellPopulation<DIM>& rCellPopulation);
+
+    /**
+     * Overridden IsNodePairInteractingAtDistance() method.
+     *
+     * Nodes only repel each other if they are closer than the sum of their radii.
+     *
+     * @param pNodeA one node of the pair
+     * @param pNodeB the other node of the pair
+     * @param distanceBetweenNodes the distance between the nodes
+     * @param rCellPopulation the cell population
+     *
+     * @return whether the nodes overlap
+     */
+    bool IsNodePairInteractingAtDistance(Node<DIM>* pNodeA, Node<DIM>* pNodeB, double distanceBetweenNodes, AbstractCellPopulation<DIM>& rCellPopulation);
+
 public :
 
     /**
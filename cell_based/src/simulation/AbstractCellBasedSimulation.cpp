@@ -44,6 +44,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractPdeModifier.hpp"
 #include "CellDivisionLocationsWriter.hpp"
 #include "CellRemovalLocationsWriter.hpp"
+#include "CellOdeBatchSolver.hpp"
+#include "ApoptoticCellProperty.hpp"
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::AbstractCellBasedSimulation(AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation,
@@ -63,7 +65,8 @@ AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::AbstractCellBasedSimulation(
       mOutputDivisionLocations(false),
       mOutputCellVelocities(false),
       mSamplingTimestepMultiple(1),
-      mUpdatingTimestepMultiple(1)
+      mUpdatingTimestepMultiple(1),
+      mUseBatchedOdeSolver(false)
 {
     // Set a random seed of 0 if it wasn't specified earlier
     RandomNumberGenerator::Instance();
@@ -99,6 +102,42 @@ unsigned AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::DoCellBirth()
 
     unsigned num_births_this_step = 0;
 
+    if (mUseBatchedOdeSolver)
+    {
+        /*
+         * Solve the ODEs of the cells that ReadyToDivide() will be called on below
+         * in batches. Each cell's SRN is solved before its cell-cycle model, as in
+         * Cell::ReadyToDivide(), which then takes up the results.
+         */
+        std::vector<CellCycleModelOdeHandler*> srn_handlers;
+        std::vector<CellCycleModelOdeHandler*> cell_cycle_handlers;
+        for (typename AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>::Iterator cell_iter = mrCellPopulation.Begin();
+             cell_iter != mrCellPopulation.End();
+             ++cell_iter)
+        {
+            if (cell_iter->GetAge() > 0.0
+                && !cell_iter->HasApoptosisBegun()
+                && !cell_iter->template HasCellProperty<ApoptoticCellProperty>())
+            {
+                CellCycleModelOdeHandler* p_srn_handler = dynamic_cast<CellCycleModelOdeHandler*>(cell_iter->GetSrnModel());
+                if (p_srn_handler != nullptr)
+                {
+                    srn_handlers.push_back(p_srn_handler);
+                }
+                CellCycleModelOdeHandler* p_cell_cycle_handler = dynamic_cast<CellCycleModelOdeHandler*>(cell_iter->GetCellCycleModel());
+                if (p_cell_cycle_handler != nullptr)
+                {
+                    cell_cycle_handlers.push_back(p_cell_cycle_handler);
+                }
+            }
+        }
+
+        double current_time = SimulationTime::Instance()->GetTime();
+        CellOdeBatchSolver batch_solver;
+        batch_solver.Solve(srn_handlers, current_time);
+        batch_solver.Solve(cell_cycle_handlers, current_time);
+    }
+
     // Iterate over all cells, seeing if each one can be divided
     for (typename AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>::Iterator cell_iter = mrCellPopulation.Begin();
          cell_iter != mrCellPopulation.End();
@@ -256,6 +295,18 @@ bool AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::GetUpdateCellPopulation
     return mUpdateCellPopulation;
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::SetUseBatchedOdeSolver(bool useBatchedOdeSolver)
+{
+    mUseBatchedOdeSolver = useBatchedOdeSolver;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::GetUseBatchedOdeSolver() const
+{
+    return mUseBatchedOdeSolver;
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellBasedSimulation<ELEMENT_DIM,SPACE_DIM>::SetNoBirth(bool noBirth)
 {
@@ -184,6 +184,13 @@ protected:
      */
     unsigned mUpdatingTimestepMultiple;
 
+    /**
+     * Whether to solve the ODEs of cell-cycle and SRN models in batches, using a
+     * CellOdeBatchSolver, before checking which cells are ready to divide
+     * (defaults to false). Not archived.
+     */
+    bool mUseBatchedOdeSolver;
+
     /**
      * Writes out special information about the mesh to the visualizer.
      */
@@ -376,6 +383,22 @@ public:
      */
     bool GetUpdateCellPopulationRule();
 
+    /**
+     * Set whether to solve the ODEs of cell-cycle and SRN models in batches.
+     *
+     * Models whose ODE systems are of the same class and are solved with the same
+     * fixed-step solver (forward Euler or fourth-order Runge-Kutta) and time step are
+     * solved together, with results identical to solving them one cell at a time.
+     *
+     * @param useBatchedOdeSolver  whether to use a CellOdeBatchSolver
+     */
+    void SetUseBatchedOdeSolver(bool useBatchedOdeSolver);
+
+    /**
+     * @return #mUseBatchedOdeSolver
+     */
+    bool GetUseBatchedOdeSolver() const;
+
     /**
      * Add a cell killer to be used in this simulation.
      *
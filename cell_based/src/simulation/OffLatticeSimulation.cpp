@@ -39,7 +39,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "CellBasedEventHandler.hpp"
 #include "ForwardEulerNumericalMethod.hpp"
+#include "NodeBasedCellPopulation.hpp"
 #include "StepSizeException.hpp"
+#include "VertexMesh.hpp"
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 OffLatticeSimulation<ELEMENT_DIM,SPACE_DIM>::OffLatticeSimulation(AbstractCellPopulation<ELEMENT_DIM,SPACE_DIM>& rCellPopulation,
@@ -163,6 +165,18 @@ void OffLatticeSimulation<ELEMENT_DIM,SPACE_DIM>::RevertToOldLocations(std::map<
     {
         (node_iter)->rGetModifiableLocation() = oldNodeLoctions[&(*node_iter)];
     }
+
+    // Nodes have been moved directly, so discard any cached element geometry or node pair separations
+    VertexMesh<ELEMENT_DIM, SPACE_DIM>* p_vertex_mesh = dynamic_cast<VertexMesh<ELEMENT_DIM, SPACE_DIM>*>(&(this->mrCellPopulation.rGetMesh()));
+    if (p_vertex_mesh)
+    {
+        p_vertex_mesh->InvalidateElementGeometry();
+    }
+    NodeBasedCellPopulation<SPACE_DIM>* p_node_based_cell_population = dynamic_cast<NodeBasedCellPopulation<SPACE_DIM>*>(&(this->mrCellPopulation));
+    if (p_node_based_cell_population)
+    {
+        p_node_based_cell_population->InvalidateNodePairGeometry();
+    }
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -176,6 +190,13 @@ void OffLatticeSimulation<ELEMENT_DIM,SPACE_DIM>::ApplyBoundaries(std::map<Node<
         (*bcs_iter)->ImposeBoundaryCondition(oldNodeLoctions);
     }
 
+    // Boundary conditions move nodes directly, so discard any cached element geometry
+    VertexMesh<ELEMENT_DIM, SPACE_DIM>* p_vertex_mesh = dynamic_cast<VertexMesh<ELEMENT_DIM, SPACE_DIM>*>(&(this->mrCellPopulation.rGetMesh()));
+    if (p_vertex_mesh)
+    {
+        p_vertex_mesh->InvalidateElementGeometry();
+    }
+
     // Verify that each boundary condition is now satisfied
     for (typename std::vector<boost::shared_ptr<AbstractCellPopulationBoundaryCondition<ELEMENT_DIM,SPACE_DIM> > >::iterator bcs_iter = mBoundaryConditions.begin();
          bcs_iter != mBoundaryConditions.end();
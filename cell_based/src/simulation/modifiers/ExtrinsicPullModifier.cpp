@@ -34,6 +34,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "ExtrinsicPullModifier.hpp"
+#include "VertexMesh.hpp"
 
 template<unsigned DIM>
 ExtrinsicPullModifier<DIM>::ExtrinsicPullModifier()
@@ -86,6 +87,13 @@ void ExtrinsicPullModifier<DIM>::UpdateAtEndOfTimeStep(AbstractCellPopulation<DI
             }
         }
     }
+
+    // Nodes have been moved directly, so discard any cached element geometry
+    VertexMesh<DIM, DIM>* p_vertex_mesh = dynamic_cast<VertexMesh<DIM, DIM>*>(&(rCellPopulation.rGetMesh()));
+    if (p_vertex_mesh)
+    {
+        p_vertex_mesh->InvalidateElementGeometry();
+    }
 }
 
 template<unsigned DIM>
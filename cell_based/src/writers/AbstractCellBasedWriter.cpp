@@ -33,11 +33,17 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 */
 #include "AbstractCellBasedWriter.hpp"
+
+#include <cassert>
+
 #include "SimulationTime.hpp"
+#include "BackgroundIoThread.hpp"
+#include "Exception.hpp"
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 AbstractCellBasedWriter<ELEMENT_DIM, SPACE_DIM>::AbstractCellBasedWriter(const std::string& rFileName)
-    : mFileName(rFileName)
+    : mIsOutputBuffered(false),
+      mFileName(rFileName)
 {
 }
 
@@ -49,6 +55,17 @@ AbstractCellBasedWriter<ELEMENT_DIM, SPACE_DIM>::~AbstractCellBasedWriter()
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellBasedWriter<ELEMENT_DIM, SPACE_DIM>::CloseFile()
 {
+    if (mIsOutputBuffered)
+    {
+        mIsOutputBuffered = false;
+        mBuffer.str("");
+        mpOutStream = mpFileStream;
+        mpFileStream.reset();
+        if (!mpOutStream)
+        {
+            return;
+        }
+    }
     mpOutStream->close();
 }
 
@@ -64,6 +81,65 @@ void AbstractCellBasedWriter<ELEMENT_DIM, SPACE_DIM>::OpenOutputFileForAppend(Ou
     mpOutStream = rOutputFileHandler.OpenOutputFile(mFileName, std::ios::app);
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellBasedWriter<ELEMENT_DIM, SPACE_DIM>::BeginBufferedOutput()
+{
+    assert(!mIsOutputBuffered);
+    mpFileStream = mpOutStream;
+
+    /*
+     * mpOutStream is an ofstream, so that subclasses need not change, but one which is never
+     * opened: its output is redirected to mBuffer instead.
+     */
+    mpOutStream.reset(new std::ofstream);
+    if (mpFileStream)
+    {
+        mpOutStream->copyfmt(*mpFileStream);
+    }
+    static_cast<std::ostream&>(*mpOutStream).rdbuf(&mBuffer);
+    mIsOutputBuffered = true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool AbstractCellBasedWriter<ELEMENT_DIM, SPACE_DIM>::IsOutputBuffered() const
+{
+    return mIsOutputBuffered;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::string AbstractCellBasedWriter<ELEMENT_DIM, SPACE_DIM>::TakeBufferedOutput()
+{
+    assert(mIsOutputBuffered);
+    std::string text = mBuffer.str();
+    mBuffer.str("");
+    return text;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractCellBasedWriter<ELEMENT_DIM, SPACE_DIM>::WriteBufferedOutput(BackgroundIoThread& rIoThread, std::string text)
+{
+    assert(mIsOutputBuffered);
+    if (!mpFileStream)
+    {
+        EXCEPTION("No file is open for buffered output from " + mFileName);
+    }
+    if (!text.empty())
+    {
+        // The file is only touched by the background thread until that thread is flushed
+        out_stream p_file = mpFileStream;
+        std::string file_name = mFileName;
+        rIoThread.Enqueue([p_file, file_name, text = std::move(text)]()
+        {
+            p_file->write(text.data(), text.size());
+            p_file->flush();
+            if (!p_file->good())
+            {
+                EXCEPTION("Error writing buffered output to " + file_name);
+            }
+        });
+    }
+}
+
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void AbstractCellBasedWriter<ELEMENT_DIM, SPACE_DIM>::WriteTimeStamp()
 {
@@ -41,8 +41,16 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "Identifiable.hpp"
 #include "OutputFileHandler.hpp"
 
+#include <sstream>
+
+class BackgroundIoThread;
+
 /**
  * Abstract class for a writer that takes data from an AbstractCellPopulation and writes it to file.
+ *
+ * Output may optionally be buffered (see BeginBufferedOutput()). Subclasses still write via
+ * mpOutStream, but the text is then formatted into memory and later appended to the file,
+ * which is kept open, by a BackgroundIoThread.
  */
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 class AbstractCellBasedWriter : public Identifiable
@@ -63,6 +71,18 @@ private:
         archive & mFileName;
     }
 
+    /**
+     * While output is buffered, the file to which buffered text is eventually written.
+     * This is null on processes that format output but leave the writing to the master.
+     */
+    out_stream mpFileStream;
+
+    /** While output is buffered, the in-memory buffer that mpOutStream writes into. */
+    std::stringbuf mBuffer;
+
+    /** Whether output is currently buffered. */
+    bool mIsOutputBuffered;
+
 protected:
 
     /** The name of the output file. */
@@ -87,6 +107,10 @@ public:
 
     /**
      * Close mpOutStream.
+     *
+     * If output is buffered, this closes the underlying file (if any) instead, discarding any text
+     * not yet passed to WriteBufferedOutput(), and ends buffering. Any background writes to the
+     * file must have completed first.
      */
     void CloseFile();
 
@@ -105,6 +129,31 @@ public:
      */
     void OpenOutputFileForAppend(OutputFileHandler& rOutputFileHandler);
 
+    /**
+     * Start buffering output. The currently open file, if any, is kept open, and mpOutStream is
+     * replaced by a stream with the same formatting that writes into memory.
+     */
+    void BeginBufferedOutput();
+
+    /**
+     * @return whether output is currently buffered.
+     */
+    bool IsOutputBuffered() const;
+
+    /**
+     * @return the text written to mpOutStream since output was buffered or this method was last
+     * called, which is then cleared from the buffer.
+     */
+    std::string TakeBufferedOutput();
+
+    /**
+     * Queue text to be appended to the file on a background thread.
+     *
+     * @param rIoThread the thread on which to write
+     * @param text the text, e.g. from TakeBufferedOutput() (possibly combined across processes)
+     */
+    void WriteBufferedOutput(BackgroundIoThread& rIoThread, std::string text);
+
     /**
      * Write the current time stamp to mpOutStream.
      */
@@ -0,0 +1,496 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "CellPopulationHdf5Writer.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <limits>
+#include <sstream>
+
+#include "AbstractCellPopulation.hpp"
+#include "AbstractCellWriter.hpp"
+#include "CellDataKeyRegistry.hpp"
+#include "Exception.hpp"
+#include "PetscTools.hpp"
+#include "Version.hpp"
+#include "Warnings.hpp"
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+CellPopulationHdf5Writer<ELEMENT_DIM, SPACE_DIM>::CellPopulationHdf5Writer(OutputFileHandler& rOutputFileHandler,
+                                                                           const std::string& rBaseName)
+    : mDirectory(rOutputFileHandler.GetOutputDirectoryFullPath()),
+      mBaseName(rBaseName),
+      mFileId(-1),
+      mCellDimensionSize(0),
+      mChunkSize(1024),
+      mCompressionLevel(4)
+{
+    if (!PetscTools::IsSequential())
+    {
+        EXCEPTION("HDF5 output of cell populations is not yet supported in parallel");
+    }
+
+    mFileId = H5Fcreate((mDirectory + mBaseName + ".h5").c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    if (mFileId < 0)
+    {
+        EXCEPTION("Could not create HDF5 file " + mBaseName + ".h5 in " + mDirectory);
+    }
+
+    H5Gclose(H5Gcreate2(mFileId, "CellData", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+    H5Gclose(H5Gcreate2(mFileId, "CellWriters", H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT));
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+CellPopulationHdf5Writer<ELEMENT_DIM, SPACE_DIM>::~CellPopulationHdf5Writer()
+{
+    if (mFileId >= 0)
+    {
+        try
+        {
+            Close();
+        }
+        catch (const Exception& e)
+        {
+            WARNING("CellPopulationHdf5Writer was destroyed without being closed, and closing it failed: " << e.GetShortMessage());
+        }
+        catch (...)
+        {
+            WARNING("CellPopulationHdf5Writer was destroyed without being closed, and closing it failed.");
+        }
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void CellPopulationHdf5Writer<ELEMENT_DIM, SPACE_DIM>::SetChunkSize(unsigned chunkSize)
+{
+    assert(mTimes.empty());
+    if (chunkSize == 0)
+    {
+        EXCEPTION("The chunk size must be at least one");
+    }
+    mChunkSize = chunkSize;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void CellPopulationHdf5Writer<ELEMENT_DIM, SPACE_DIM>::SetCompressionLevel(unsigned compressionLevel)
+{
+    assert(mTimes.empty());
+    if (compressionLevel > 9)
+    {
+        EXCEPTION("The compression level must be between 0 and 9");
+    }
+    mCompressionLevel = compressionLevel;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+typename CellPopulationHdf5Writer<ELEMENT_DIM, SPACE_DIM>::Dataset CellPopulationHdf5Writer<ELEMENT_DIM, SPACE_DIM>::CreateDataset(
+    const std::string& rPath, unsigned width, bool isUnsigned)
+{
+    Dataset dataset;
+    dataset.Width = width;
+    dataset.IsUnsigned = isUnsigned;
+
+    // Time is the first dimension, then cells, then (for vector data) components
+    const int rank = (width == 0) ? 1 : ((width == 1) ? 2 : 3);
+    hsize_t dims[3] = {mTimes.size(), mCellDimensionSize, width};
+    hsize_t max_dims[3] = {H5S_UNLIMITED, H5S_UNLIMITED, width};
+    hsize_t chunk_dims[3] = {1, mChunkSize, width};
+    if (width == 0)
+    {
+        chunk_dims[0] = mChunkSize;
+    }
+
+    hid_t property_list = H5Pcreate(H5P_DATASET_CREATE);
+    H5Pset_chunk(property_list, rank, chunk_dims);
+    if (mCompressionLevel > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE) > 0)
+    {
+        H5Pset_shuffle(property_list);
+        H5Pset_deflate(property_list, mCompressionLevel);
+    }
+
+    // Entries for cells that do not exist (or lack a CellData item) hold a fill value
+    hid_t type = isUnsigned ? H5T_NATIVE_UINT : H5T_NATIVE_DOUBLE;
+    const unsigned unsigned_fill = UINT_MAX;
+    const double double_fill = std::numeric_limits<double>::quiet_NaN();
+    H5Pset_fill_value(property_list, type, isUnsigned ? static_cast<const void*>(&unsigned_fill) : static_cast<const void*>(&double_fill));
+
+    hid_t dataspace = H5Screate_simple(rank, dims, max_dims);
+    dataset.Id = H5Dcreate2(mFileId, rPath.c_str(), type, dataspace, H5P_DEFAULT, property_list, H5P_DEFAULT);
+    H5Sclose(dataspace);
+    H5Pclose(property_list);
+
+    if (dataset.Id < 0)
+    {
+        EXCEPTION("Could not create dataset " + rPath + " in HDF5 file " + mBaseName + ".h5");
+    }
+    return dataset;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void CellPopulationHdf5Writer<ELEMENT_DIM, SPACE_DIM>::WriteToDataset(const Dataset& rDataset, const void* pData, unsigned numCells)
+{
+    hsize_t new_dims[3] = {mTimes.size(), mCellDimensionSize, rDataset.Width};
+    H5Dset_extent(rDataset.Id, new_dims);
+
+    if (numCells > 0)
+    {
+        const int rank = (rDataset.Width == 1) ? 2 : 3;
+        hsize_t start[3] = {mTimes.size() - 1, 0, 0};
+        hsize_t count[3] = {1, numCells, rDataset.Width};
+
+        hid_t file_dataspace = H5Dget_space(rDataset.Id);
+        H5Sselect_hyperslab(file_dataspace, H5S_SELECT_SET, start, nullptr, count, nullptr);
+        hid_t memory_dataspace = H5Screate_simple(rank, count, nullptr);
+
+        herr_t err = H5Dwrite(rDataset.Id, rDataset.IsUnsigned ? H5T_NATIVE_UINT : H5T_NATIVE_DOUBLE,
+                              memory_dataspace, file_dataspace, H5P_DEFAULT, pData);
+
+        H5Sclose(memory_dataspace);
+        H5Sclose(file_dataspace);
+
+        if (err < 0)
+        {
+            EXCEPTION("Could not write to HDF5 file " + mBaseName + ".h5");
+        }
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::string CellPopulationHdf5Writer<ELEMENT_DIM, SPACE_DIM>::MakeDatasetName(const std::string& rName)
+{
+    // Dataset names may not contain slashes, and XDMF paths are easier to read without spaces
+    std::string name = rName;
+    for (unsigned i=0; i<name.size(); i++)
+    {
+        if (name[i] == '/' || name[i] == ' ')
+        {
+            name[i] = '_';
+        }
+    }
+    return name;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void CellPopulationHdf5Writer<ELEMENT_DIM, SPACE_DIM>::WriteTimeStep(double time,
+                                                                     AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>& rCellPopulation,
+                                                                     const std::vector<boost::shared_ptr<AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> > >& rCellWriters)
+{
+    typedef AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> cell_writer_t;
+    assert(mFileId >= 0);
+
+    if (mTimes.empty())
+    {
+        mTimeDataset = CreateDataset("Time", 0, false);
+        mNumCellsDataset = CreateDataset("NumCells", 0, true);
+        mCellDatasets["Position"] = CreateDataset("Position", SPACE_DIM, false);
+        mCellDatasets["CellId"] = CreateDataset("CellId", 1, true);
+        mCellDatasets["CellProliferativeType"] = CreateDataset("CellProliferativeType", 1, true);
+    }
+
+    // Gather the data for every cell in a single pass over the population
+    const unsigned num_keys = CellDataKeyRegistry::Instance()->GetNumKeys();
+    const unsigned num_writers = rCellWriters.size();
+    std::vector<double> positions;
+    std::vector<unsigned> ids;
+    std::vector<unsigned> types;
+    std::vector<std::vector<double> > cell_data(num_keys);
+    std::vector<bool> is_key_used(num_keys, false);
+    std::vector<std::vector<double> > scalar_writer_data(num_writers);
+    std::vector<std::vector<double> > vector_writer_data(num_writers);
+
+    for (typename AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>::Iterator cell_iter = rCellPopulation.Begin();
+         cell_iter != rCellPopulation.End();
+         ++cell_iter)
+    {
+        c_vector<double, SPACE_DIM> location = rCellPopulation.GetLocationOfCellCentre(*cell_iter);
+        for (unsigned i=0; i<SPACE_DIM; i++)
+        {
+            positions.push_back(location[i]);
+        }
+        ids.push_back(cell_iter->GetCellId());
+        types.push_back(cell_iter->GetCellProliferativeType()->GetColour());
+
+        boost::shared_ptr<CellData> p_cell_data = cell_iter->GetCellData();
+        for (unsigned key=0; key<num_keys; key++)
+        {
+            if (p_cell_data->HasItem(key))
+            {
+                cell_data[key].push_back(p_cell_data->GetItem(key));
+                is_key_used[key] = true;
+            }
+            else
+            {
+                cell_data[key].push_back(std::numeric_limits<double>::quiet_NaN());
+            }
+        }
+
+        for (unsigned w=0; w<num_writers; w++)
+        {
+            if (rCellWriters[w]->GetOutputScalarData())
+            {
+                scalar_writer_data[w].push_back(rCellWriters[w]->GetCellDataForVtkOutput(*cell_iter, &rCellPopulation));
+            }
+            if (rCellWriters[w]->GetOutputVectorData())
+            {
+                c_vector<double, SPACE_DIM> data = rCellWriters[w]->GetVectorCellDataForVtkOutput(*cell_iter, &rCellPopulation);
+                for (unsigned i=0; i<SPACE_DIM; i++)
+                {
+                    vector_writer_data[w].push_back(data[i]);
+                }
+            }
+        }
+    }
+    const unsigned num_cells = ids.size();
+
+    // Add any datasets for CellData items or cell writers not seen before
+    for (unsigned key=0; key<num_keys; key++)
+    {
+        std::string path = "CellData/" + MakeDatasetName(CellDataKeyRegistry::Instance()->rGetName(key));
+        if (is_key_used[key] && mCellDatasets.find(path) == mCellDatasets.end())
+        {
+            mCellDatasets[path] = CreateDataset(path, 1, false);
+        }
+    }
+    for (unsigned w=0; w<num_writers; w++)
+    {
+        if (rCellWriters[w]->GetOutputScalarData())
+        {
+            std::string path = "CellWriters/" + MakeDatasetName(rCellWriters[w]->GetVtkCellDataName());
+            if (mCellDatasets.find(path) == mCellDatasets.end())
+            {
+                mCellDatasets[path] = CreateDataset(path, 1, false);
+            }
+        }
+        if (rCellWriters[w]->GetOutputVectorData())
+        {
+            std::string path = "CellWriters/" + MakeDatasetName(rCellWriters[w]->GetVtkVectorCellDataName());
+            if (mCellDatasets.find(path) == mCellDatasets.end())
+            {
+                mCellDatasets[path] = CreateDataset(path, SPACE_DIM, false);
+            }
+        }
+    }
+
+    // Extend the time dimension, and if need be the cell dimension
+    mTimes.push_back(time);
+    mNumCells.push_back(num_cells);
+    mCellDimensionSize = std::max(mCellDimensionSize, num_cells);
+
+    hsize_t time_dims[1] = {mTimes.size()};
+    hsize_t start[1] = {mTimes.size() - 1};
+    hsize_t count[1] = {1};
+    const Dataset* time_datasets[2] = {&mTimeDataset, &mNumCellsDataset};
+    const void* time_data[2] = {&time, &num_cells};
+    for (unsigned i=0; i<2; i++)
+    {
+        H5Dset_extent(time_datasets[i]->Id, time_dims);
+        hid_t file_dataspace = H5Dget_space(time_datasets[i]->Id);
+        H5Sselect_hyperslab(file_dataspace, H5S_SELECT_SET, start, nullptr, count, nullptr);
+        hid_t memory_dataspace = H5Screate_simple(1, count, nullptr);
+        herr_t err = H5Dwrite(time_datasets[i]->Id, time_datasets[i]->IsUnsigned ? H5T_NATIVE_UINT : H5T_NATIVE_DOUBLE,
+                              memory_dataspace, file_dataspace, H5P_DEFAULT, time_data[i]);
+        H5Sclose(memory_dataspace);
+        H5Sclose(file_dataspace);
+
+        if (err < 0)
+        {
+            EXCEPTION("Could not write to HDF5 file " + mBaseName + ".h5");
+        }
+    }
+
+    // Every per-cell dataset is extended, including those not written at this time
+    std::map<std::string, const void*> data_for_path;
+    data_for_path["Position"] = positions.empty() ? nullptr : &positions[0];
+    data_for_path["CellId"] = ids.empty() ? nullptr : &ids[0];
+    data_for_path["CellProliferativeType"] = types.empty() ? nullptr : &types[0];
+    for (unsigned key=0; key<num_keys; key++)
+    {
+        if (is_key_used[key])
+        {
+            data_for_path["CellData/" + MakeDatasetName(CellDataKeyRegistry::Instance()->rGetName(key))] = &cell_data[key][0];
+        }
+    }
+    for (unsigned w=0; w<num_writers; w++)
+    {
+        if (!scalar_writer_data[w].empty())
+        {
+            data_for_path["CellWriters/" + MakeDatasetName(rCellWriters[w]->GetVtkCellDataName())] = &scalar_writer_data[w][0];
+        }
+        if (!vector_writer_data[w].empty())
+        {
+            data_for_path["CellWriters/" + MakeDatasetName(rCellWriters[w]->GetVtkVectorCellDataName())] = &vector_writer_data[w][0];
+        }
+    }
+
+    for (typename std::map<std::string, Dataset>::iterator it = mCellDatasets.begin();
+         it != mCellDatasets.end();
+         ++it)
+    {
+        std::map<std::string, const void*>::iterator data_it = data_for_path.find(it->first);
+        if (data_it != data_for_path.end())
+        {
+            WriteToDataset(it->second, data_it->second, num_cells);
+        }
+        else
+        {
+            WriteToDataset(it->second, nullptr, 0);
+        }
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned CellPopulationHdf5Writer<ELEMENT_DIM, SPACE_DIM>::GetNumTimeSteps() const
+{
+    return mTimes.size();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void CellPopulationHdf5Writer<ELEMENT_DIM, SPACE_DIM>::Close()
+{
+    if (mFileId < 0)
+    {
+        return;
+    }
+
+    if (!mTimes.empty())
+    {
+        H5Dclose(mTimeDataset.Id);
+        H5Dclose(mNumCellsDataset.Id);
+    }
+    for (typename std::map<std::string, Dataset>::iterator it = mCellDatasets.begin();
+         it != mCellDatasets.end();
+         ++it)
+    {
+        H5Dclose(it->second.Id);
+    }
+    mCellDatasets.clear();
+    H5Fclose(mFileId);
+    mFileId = -1;
+
+    // XDMF geometry can only describe 2 or 3 dimensions
+    if (SPACE_DIM > 1)
+    {
+        WriteXdmfFile();
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void CellPopulationHdf5Writer<ELEMENT_DIM, SPACE_DIM>::WriteXdmfFile()
+{
+    OutputFileHandler output_file_handler(FileFinder(mDirectory, RelativeTo::Absolute), false);
+    out_stream p_file = output_file_handler.OpenOutputFile(mBaseName + ".xdmf");
+
+    *p_file << "<?xml version=\"1.0\" ?>\n";
+    *p_file << "<!DOCTYPE Xdmf SYSTEM \"Xdmf.dtd\" []>\n";
+    *p_file << "<Xdmf Version=\"2.0\">\n";
+    *p_file << "  <Domain>\n";
+    *p_file << "    <Grid Name=\"CellPopulation\" GridType=\"Collection\" CollectionType=\"Temporal\">\n";
+
+    // Each dataset is described by a hyperslab of its values at one time
+    const unsigned num_times = mTimes.size();
+    std::string h5_file = mBaseName + ".h5";
+
+    for (unsigned t=0; t<num_times; t++)
+    {
+        unsigned num_cells = mNumCells[t];
+        *p_file << "      <Grid Name=\"Cells\" GridType=\"Uniform\">\n";
+        *p_file << "        <Time Value=\"" << mTimes[t] << "\"/>\n";
+        *p_file << "        <Topology TopologyType=\"Polyvertex\" NumberOfElements=\"" << num_cells << "\" NodesPerElement=\"1\"/>\n";
+
+        for (typename std::map<std::string, Dataset>::iterator it = mCellDatasets.begin();
+             it != mCellDatasets.end();
+             ++it)
+        {
+            const Dataset& r_dataset = it->second;
+            std::string indent = "          ";
+            if (it->first == "Position")
+            {
+                *p_file << "        <Geometry GeometryType=\"" << (SPACE_DIM == 2 ? "XY" : "XYZ") << "\">\n";
+            }
+            else
+            {
+                std::string attribute_type = "Scalar";
+                if (r_dataset.Width > 1)
+                {
+                    attribute_type = (SPACE_DIM == 3) ? "Vector" : "Matrix";
+                }
+                *p_file << "        <Attribute Name=\"" << it->first << "\" AttributeType=\"" << attribute_type << "\" Center=\"Node\">\n";
+            }
+
+            std::stringstream slab_dims, start, stride, count, h5_dims;
+            slab_dims << num_cells;
+            start << t << " 0";
+            stride << "1 1";
+            count << "1 " << num_cells;
+            h5_dims << num_times << " " << mCellDimensionSize;
+            unsigned rank = 2;
+            if (r_dataset.Width > 1)
+            {
+                slab_dims << " " << r_dataset.Width;
+                start << " 0";
+                stride << " 1";
+                count << " " << r_dataset.Width;
+                h5_dims << " " << r_dataset.Width;
+                rank = 3;
+            }
+
+            *p_file << indent << "<DataItem ItemType=\"HyperSlab\" Dimensions=\"" << slab_dims.str() << "\">\n";
+            *p_file << indent << "  <DataItem Dimensions=\"3 " << rank << "\" Format=\"XML\">"
+                    << start.str() << " " << stride.str() << " " << count.str() << "</DataItem>\n";
+            *p_file << indent << "  <DataItem Dimensions=\"" << h5_dims.str() << "\" "
+                    << (r_dataset.IsUnsigned ? "NumberType=\"UInt\" Precision=\"4\"" : "NumberType=\"Float\" Precision=\"8\"")
+                    << " Format=\"HDF\">" << h5_file << ":/" << it->first << "</DataItem>\n";
+            *p_file << indent << "</DataItem>\n";
+            *p_file << (it->first == "Position" ? "        </Geometry>\n" : "        </Attribute>\n");
+        }
+        *p_file << "      </Grid>\n";
+    }
+
+    *p_file << "    </Grid>\n";
+    *p_file << "  </Domain>\n";
+    *p_file << "</Xdmf>\n";
+    *p_file << "<!-- " + ChasteBuildInfo::GetProvenanceString() + "-->\n";
+    p_file->close();
+}
+
+// Explicit instantiation
+template class CellPopulationHdf5Writer<1,1>;
+template class CellPopulationHdf5Writer<1,2>;
+template class CellPopulationHdf5Writer<2,2>;
+template class CellPopulationHdf5Writer<1,3>;
+template class CellPopulationHdf5Writer<2,3>;
+template class CellPopulationHdf5Writer<3,3>;
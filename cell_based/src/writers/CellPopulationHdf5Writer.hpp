@@ -0,0 +1,206 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef CELLPOPULATIONHDF5WRITER_HPP_
+#define CELLPOPULATIONHDF5WRITER_HPP_
+
+#include <hdf5.h>
+#include <map>
+#include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+#include "OutputFileHandler.hpp"
+
+// Forward declarations prevent circular include chain
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM> class AbstractCellPopulation;
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM> class AbstractCellWriter;
+
+/**
+ * A class for writing the state of a cell population at each output time to a single binary HDF5
+ * file, as an alternative to the per-writer text files and per-time-step VTK files.
+ *
+ * The file contains the following datasets, each of which is chunked, compressed (if the
+ * HDF5 library supports it) and extendible in both the time and the cell dimension:
+ *  - "Time" and "NumCells", of size (number of times);
+ *  - "Position", of size (number of times) x (maximum number of cells) x SPACE_DIM, holding the
+ *    location of each cell centre;
+ *  - "CellId" and "CellProliferativeType" (the colour of the cell's proliferative type);
+ *  - "CellData/<name>", one for each CellData item that any cell has had;
+ *  - "CellWriters/<name>", one for each AbstractCellWriter that outputs scalar or vector data
+ *    for VTK, named by the writer's VTK cell data name.
+ * At a time with n cells, only the first n entries along the cell dimension are meaningful;
+ * the rest hold the fill value (NaN, or UINT_MAX for integers). Cells are listed in the order of
+ * the population's iterator, so the same row need not hold the same cell at different times.
+ *
+ * On Close(), an XDMF file that describes the datasets as a time series of point clouds is
+ * written alongside the HDF5 file, so that the results can be opened in ParaView. This is only
+ * done for SPACE_DIM > 1, as for VTK output.
+ *
+ * HDF5 output is not yet supported in parallel.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class CellPopulationHdf5Writer
+{
+private:
+
+    /** A dataset in the file. */
+    struct Dataset
+    {
+        /** The HDF5 identifier of the dataset. */
+        hid_t Id;
+
+        /** The number of values per cell (1, or SPACE_DIM for vector data). */
+        unsigned Width;
+
+        /** Whether the dataset stores unsigned integers rather than doubles. */
+        bool IsUnsigned;
+    };
+
+    /** The full path of the output directory. */
+    std::string mDirectory;
+
+    /** The base name of the output files (without extension). */
+    std::string mBaseName;
+
+    /** The HDF5 file identifier. */
+    hid_t mFileId;
+
+    /** The "Time" and "NumCells" datasets. */
+    Dataset mTimeDataset, mNumCellsDataset;
+
+    /** The per-cell datasets, indexed by their paths in the file. */
+    std::map<std::string, Dataset> mCellDatasets;
+
+    /** The output times written so far. */
+    std::vector<double> mTimes;
+
+    /** The number of cells written at each output time so far. */
+    std::vector<unsigned> mNumCells;
+
+    /** The current size of the cell dimension, i.e. the largest number of cells written so far. */
+    unsigned mCellDimensionSize;
+
+    /** The chunk size along the cell dimension. */
+    unsigned mChunkSize;
+
+    /** The deflate compression level (0 for none). */
+    unsigned mCompressionLevel;
+
+    /**
+     * Create a dataset, sized to match those already in the file.
+     *
+     * @param rPath the path of the dataset in the file
+     * @param width the number of values per cell (or 0 for a dataset with only a time dimension)
+     * @param isUnsigned whether to store unsigned integers rather than doubles
+     * @return the new dataset
+     */
+    Dataset CreateDataset(const std::string& rPath, unsigned width, bool isUnsigned);
+
+    /**
+     * Write the values at the current output time to a per-cell dataset, which must
+     * already have been extended to include the current time.
+     *
+     * @param rDataset the dataset
+     * @param pData the values, cell by cell (unsigned or double as appropriate)
+     * @param numCells the number of cells
+     */
+    void WriteToDataset(const Dataset& rDataset, const void* pData, unsigned numCells);
+
+    /**
+     * @return a name that can be used as the final component of a dataset path.
+     *
+     * @param rName a data item or writer name
+     */
+    static std::string MakeDatasetName(const std::string& rName);
+
+    /**
+     * Write the XDMF file describing the HDF5 file.
+     */
+    void WriteXdmfFile();
+
+public:
+
+    /**
+     * Constructor. Creates the HDF5 file in the given output directory.
+     *
+     * @param rOutputFileHandler handler for the directory in which to create the file
+     * @param rBaseName the base name of the HDF5 and XDMF files (defaults to "results")
+     */
+    CellPopulationHdf5Writer(OutputFileHandler& rOutputFileHandler, const std::string& rBaseName="results");
+
+    /**
+     * Destructor. Closes the file if Close() has not been called, giving a warning
+     * rather than throwing if this fails.
+     */
+    ~CellPopulationHdf5Writer();
+
+    /**
+     * Set the chunk size along the cell dimension. Must be called before the first WriteTimeStep().
+     *
+     * @param chunkSize the number of cells per chunk (defaults to 1024)
+     */
+    void SetChunkSize(unsigned chunkSize);
+
+    /**
+     * Set the deflate compression level. Must be called before the first WriteTimeStep().
+     *
+     * @param compressionLevel from 0 (no compression) to 9 (defaults to 4)
+     */
+    void SetCompressionLevel(unsigned compressionLevel);
+
+    /**
+     * Append the current state of a cell population to the file.
+     *
+     * @param time the current time
+     * @param rCellPopulation the cell population
+     * @param rCellWriters the cell writers whose VTK data should also be written
+     */
+    void WriteTimeStep(double time,
+                       AbstractCellPopulation<ELEMENT_DIM, SPACE_DIM>& rCellPopulation,
+                       const std::vector<boost::shared_ptr<AbstractCellWriter<ELEMENT_DIM, SPACE_DIM> > >& rCellWriters);
+
+    /**
+     * @return the number of output times written so far.
+     */
+    unsigned GetNumTimeSteps() const;
+
+    /**
+     * Close the HDF5 file and write the XDMF file.
+     */
+    void Close();
+};
+
+#endif /*CELLPOPULATIONHDF5WRITER_HPP_*/
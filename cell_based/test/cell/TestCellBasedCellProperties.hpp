@@ -42,10 +42,14 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "CellId.hpp"
 #include "CellData.hpp"
+#include "CellDataKeyRegistry.hpp"
 #include "CellEdgeData.hpp"
 
 #include "CellPropertyRegistry.hpp"
 
+#include <sstream>
+#include <thread>
+
 #include <boost/shared_ptr.hpp>
 #include <boost/serialization/shared_ptr.hpp>
 
@@ -143,6 +147,90 @@ public:
         TS_ASSERT_EQUALS(p_cell_data->GetNumItems(), 3u);
     }
 
+    void TestCellDataKeyMethods()
+    {
+        CellDataKeyRegistry* p_registry = CellDataKeyRegistry::Instance();
+        TS_ASSERT_EQUALS(p_registry->FindKey("key thing unused"), UNSIGNED_UNSET);
+
+        unsigned key_b = p_registry->GetKey("key thing b");
+        unsigned key_a = p_registry->GetKey("key thing a");
+        TS_ASSERT_DIFFERS(key_a, key_b);
+        TS_ASSERT_EQUALS(p_registry->GetKey("key thing b"), key_b);
+        TS_ASSERT_EQUALS(p_registry->FindKey("key thing a"), key_a);
+        TS_ASSERT_EQUALS(p_registry->rGetName(key_a), "key thing a");
+        TS_ASSERT_LESS_THAN(key_a, p_registry->GetNumKeys());
+
+        MAKE_PTR(CellData, p_cell_data);
+        TS_ASSERT_EQUALS(p_cell_data->HasItem(key_a), false);
+        TS_ASSERT_THROWS_THIS(p_cell_data->GetItem(key_a), "The item key thing a is not stored");
+
+        // Items set by key are visible by name, and vice versa
+        p_cell_data->SetItem(key_b, 2.0);
+        p_cell_data->SetItem("key thing a", 1.0);
+        TS_ASSERT_EQUALS(p_cell_data->HasItem("key thing b"), true);
+        TS_ASSERT_DELTA(p_cell_data->GetItem("key thing b"), 2.0, 1e-8);
+        TS_ASSERT_DELTA(p_cell_data->GetItem(key_a), 1.0, 1e-8);
+        TS_ASSERT_EQUALS(p_cell_data->GetNumItems(), 2u);
+
+        // Overwriting an item does not change the number of items
+        p_cell_data->SetItem(key_a, 3.0);
+        TS_ASSERT_DELTA(p_cell_data->GetItem("key thing a"), 3.0, 1e-8);
+        TS_ASSERT_EQUALS(p_cell_data->GetNumItems(), 2u);
+
+        // Keys are returned in alphabetical order, not the order in which they were interned
+        std::vector<std::string> keys = p_cell_data->GetKeys();
+        TS_ASSERT_EQUALS(keys.size(), 2u);
+        TS_ASSERT_EQUALS(keys[0], "key thing a");
+        TS_ASSERT_EQUALS(keys[1], "key thing b");
+
+        // Copies are independent of the original
+        CellData cell_data_copy(*p_cell_data);
+        cell_data_copy.SetItem(key_a, 4.0);
+        TS_ASSERT_DELTA(cell_data_copy.GetItem(key_a), 4.0, 1e-8);
+        TS_ASSERT_DELTA(cell_data_copy.GetItem(key_b), 2.0, 1e-8);
+        TS_ASSERT_DELTA(p_cell_data->GetItem(key_a), 3.0, 1e-8);
+    }
+
+    void TestCellDataKeyRegistryDestroy()
+    {
+        // Items read by the cell-cycle models are registered when the registry is created
+        TS_ASSERT_EQUALS(CellDataKeyRegistry::Instance()->FindKey("oxygen"), CellDataKeyRegistry::OXYGEN_KEY);
+        unsigned num_initial_keys = CellDataKeyRegistry::Instance()->GetNumKeys();
+        CellDataKeyRegistry::Instance()->GetKey("key thing c");
+        TS_ASSERT_EQUALS(CellDataKeyRegistry::Instance()->GetNumKeys(), num_initial_keys + 1);
+
+        // Destroying the registry forgets every other item name
+        CellDataKeyRegistry::Destroy();
+        TS_ASSERT_EQUALS(CellDataKeyRegistry::Instance()->FindKey("key thing c"), UNSIGNED_UNSET);
+        TS_ASSERT_EQUALS(CellDataKeyRegistry::Instance()->GetNumKeys(), num_initial_keys);
+        TS_ASSERT_EQUALS(CellDataKeyRegistry::Instance()->rGetName(CellDataKeyRegistry::OXYGEN_KEY), "oxygen");
+
+        // Names may be interned from several threads at once
+        std::vector<unsigned> keys(100);
+        std::vector<std::thread> threads;
+        for (unsigned t=0; t<4; t++)
+        {
+            threads.push_back(std::thread([&keys, t]()
+            {
+                for (unsigned i=t; i<100; i+=4)
+                {
+                    std::stringstream name;
+                    name << "threaded key " << i%10;
+                    keys[i] = CellDataKeyRegistry::Instance()->GetKey(name.str());
+                }
+            }));
+        }
+        for (unsigned t=0; t<4; t++)
+        {
+            threads[t].join();
+        }
+        TS_ASSERT_EQUALS(CellDataKeyRegistry::Instance()->GetNumKeys(), num_initial_keys + 10);
+        for (unsigned i=0; i<100; i++)
+        {
+            TS_ASSERT_EQUALS(keys[i], keys[i%10]);
+        }
+    }
+
     void TestArchiveCellData()
     {
         OutputFileHandler handler("archive", false);
@@ -0,0 +1,177 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTCELLOBJECTPOOL_HPP_
+#define TESTCELLOBJECTPOOL_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <vector>
+
+#include <boost/make_shared.hpp>
+
+#include "CellObjectPool.hpp"
+#include "Cell.hpp"
+#include "CellData.hpp"
+#include "FixedG1GenerationalCellCycleModel.hpp"
+#include "WildTypeCellMutationState.hpp"
+#include "StemCellProliferativeType.hpp"
+#include "TransitCellProliferativeType.hpp"
+#include "SmartPointers.hpp"
+#include "AbstractCellBasedTestSuite.hpp"
+#include "FakePetscSetup.hpp"
+
+class TestCellObjectPool : public AbstractCellBasedTestSuite
+{
+public:
+
+    void TestAllocateAndDeallocate()
+    {
+        CellObjectPool::Clear();
+        TS_ASSERT_EQUALS(CellObjectPool::GetNumFreeBlocks(40), 0u);
+
+        // A released block is kept by the pool...
+        void* p_block = CellObjectPool::Allocate(40);
+        CellObjectPool::Deallocate(p_block, 40);
+        TS_ASSERT_EQUALS(CellObjectPool::GetNumFreeBlocks(40), 1u);
+
+        // ...and reused for the next request of a similar size
+        TS_ASSERT_EQUALS(CellObjectPool::GetNumFreeBlocks(48), 1u);
+        void* p_other_block = CellObjectPool::Allocate(48);
+        TS_ASSERT_EQUALS(p_other_block, p_block);
+        TS_ASSERT_EQUALS(CellObjectPool::GetNumFreeBlocks(40), 0u);
+        CellObjectPool::Deallocate(p_other_block, 48);
+
+        // Requests of a different size class do not use the block
+        TS_ASSERT_EQUALS(CellObjectPool::GetNumFreeBlocks(64), 0u);
+
+        // Large requests are not pooled
+        void* p_large_block = CellObjectPool::Allocate(100000);
+        CellObjectPool::Deallocate(p_large_block, 100000);
+        TS_ASSERT_EQUALS(CellObjectPool::GetNumFreeBlocks(100000), 0u);
+
+        // Deallocating a null pointer does nothing
+        CellObjectPool::Deallocate(nullptr, 40);
+        TS_ASSERT_EQUALS(CellObjectPool::GetNumFreeBlocks(40), 1u);
+
+        // Several released blocks are linked together, and handed out most recent first
+        std::vector<void*> blocks;
+        for (unsigned i=0; i<3; i++)
+        {
+            blocks.push_back(CellObjectPool::Allocate(40));
+        }
+        for (unsigned i=0; i<3; i++)
+        {
+            CellObjectPool::Deallocate(blocks[i], 40);
+        }
+        TS_ASSERT_EQUALS(CellObjectPool::GetNumFreeBlocks(40), 3u);
+        for (unsigned i=0; i<3; i++)
+        {
+            TS_ASSERT_EQUALS(CellObjectPool::Allocate(40), blocks[2-i]);
+        }
+        TS_ASSERT_EQUALS(CellObjectPool::GetNumFreeBlocks(40), 0u);
+        for (unsigned i=0; i<3; i++)
+        {
+            CellObjectPool::Deallocate(blocks[i], 40);
+        }
+
+        // Blocks for empty objects are still large enough to be linked into the free list
+        void* p_empty_block = CellObjectPool::Allocate(0);
+        CellObjectPool::Deallocate(p_empty_block, 0);
+        TS_ASSERT_EQUALS(CellObjectPool::GetNumFreeBlocks(0), 1u);
+
+        CellObjectPool::Clear();
+        TS_ASSERT_EQUALS(CellObjectPool::GetNumFreeBlocks(40), 0u);
+        TS_ASSERT_EQUALS(CellObjectPool::GetNumFreeBlocks(0), 0u);
+    }
+
+    void TestAllocateShared()
+    {
+        CellObjectPool::Clear();
+        {
+            boost::shared_ptr<CellData> p_cell_data = boost::allocate_shared<CellData>(CellObjectPoolAllocator<CellData>());
+            p_cell_data->SetItem("thing", 1.0);
+            TS_ASSERT_DELTA(p_cell_data->GetItem("thing"), 1.0, 1e-12);
+        }
+
+        // The object and its control block were allocated as a single pooled block
+        unsigned num_free_blocks = 0;
+        for (unsigned size=16; size<=1024; size+=16)
+        {
+            num_free_blocks += CellObjectPool::GetNumFreeBlocks(size);
+        }
+        TS_ASSERT_EQUALS(num_free_blocks, 1u);
+
+        TS_ASSERT(CellObjectPoolAllocator<CellData>() == CellObjectPoolAllocator<Cell>());
+        TS_ASSERT(!(CellObjectPoolAllocator<CellData>() != CellObjectPoolAllocator<Cell>()));
+    }
+
+    void TestDivisionReusesMemoryOfDeadCells()
+    {
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(24.0, 1);
+
+        MAKE_PTR(WildTypeCellMutationState, p_healthy_state);
+        MAKE_PTR(StemCellProliferativeType, p_stem_type);
+
+        FixedG1GenerationalCellCycleModel* p_model = new FixedG1GenerationalCellCycleModel();
+        CellPtr p_cell(new Cell(p_healthy_state, p_model));
+        p_cell->SetCellProliferativeType(p_stem_type);
+        p_cell->SetBirthTime(-1.0);
+        p_cell->InitialiseCellCycleModel();
+
+        SimulationTime::Instance()->IncrementTimeOneStep();
+        TS_ASSERT_EQUALS(p_cell->ReadyToDivide(), true);
+
+        CellPtr p_daughter_cell = p_cell->Divide();
+        TS_ASSERT_EQUALS(p_daughter_cell->GetCellProliferativeType()->IsType<TransitCellProliferativeType>(), true);
+        TS_ASSERT_EQUALS(p_daughter_cell->GetCellData()->GetNumItems(), 0u);
+        TS_ASSERT(p_daughter_cell->GetCellData() != p_cell->GetCellData());
+
+        // When the daughter cell is destroyed, the memory used by its cell-cycle model is returned to the pool
+        const std::size_t model_size = sizeof(FixedG1GenerationalCellCycleModel);
+        unsigned num_free_blocks = CellObjectPool::GetNumFreeBlocks(model_size);
+        p_daughter_cell.reset();
+        TS_ASSERT_LESS_THAN(num_free_blocks, CellObjectPool::GetNumFreeBlocks(model_size));
+
+        // A new cell-cycle model then takes its memory from the pool
+        num_free_blocks = CellObjectPool::GetNumFreeBlocks(model_size);
+        FixedG1GenerationalCellCycleModel* p_new_model = new FixedG1GenerationalCellCycleModel();
+        TS_ASSERT_EQUALS(CellObjectPool::GetNumFreeBlocks(model_size), num_free_blocks - 1);
+        delete p_new_model;
+        TS_ASSERT_EQUALS(CellObjectPool::GetNumFreeBlocks(model_size), num_free_blocks);
+    }
+};
+
+#endif /*TESTCELLOBJECTPOOL_HPP_*/
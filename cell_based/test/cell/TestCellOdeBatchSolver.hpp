@@ -0,0 +1,306 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTCELLODEBATCHSOLVER_HPP_
+#define TESTCELLODEBATCHSOLVER_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "CellOdeBatchSolver.hpp"
+#include "Alarcon2004OxygenBasedCellCycleModel.hpp"
+#include "TysonNovakCellCycleModel.hpp"
+#include "DeltaNotchSrnModel.hpp"
+#include "DeltaNotchOdeSystem.hpp"
+#include "UniformG1GenerationalCellCycleModel.hpp"
+#include "CellCycleModelOdeSolver.hpp"
+#include "BackwardEulerIvpOdeSolver.hpp"
+#include "EulerIvpOdeSolver.hpp"
+#include "WildTypeCellMutationState.hpp"
+#include "StemCellProliferativeType.hpp"
+#include "DifferentiatedCellProliferativeType.hpp"
+#include "SmartPointers.hpp"
+#include "AbstractCellBasedTestSuite.hpp"
+#include "FakePetscSetup.hpp"
+
+class TestCellOdeBatchSolver : public AbstractCellBasedTestSuite
+{
+public:
+
+    void TestBatchedCellCycleModelsMatchSerialSolve()
+    {
+        SimulationTime* p_simulation_time = SimulationTime::Instance();
+        p_simulation_time->SetEndTimeAndNumberOfTimeSteps(20.0, 200);
+
+        MAKE_PTR(WildTypeCellMutationState, p_state);
+        MAKE_PTR(StemCellProliferativeType, p_stem_type);
+
+        // Create two identical sets of cells with different oxygen concentrations, so that their ODEs stop at different times
+        std::vector<CellPtr> serial_cells;
+        std::vector<CellPtr> batched_cells;
+        unsigned num_cells = 6;
+        for (unsigned i=0; i<num_cells; i++)
+        {
+            for (unsigned set=0; set<2; set++)
+            {
+                Alarcon2004OxygenBasedCellCycleModel* p_model = new Alarcon2004OxygenBasedCellCycleModel();
+                p_model->SetDimension(2);
+                CellPtr p_cell(new Cell(p_state, p_model));
+                p_cell->SetCellProliferativeType(p_stem_type);
+                p_cell->GetCellData()->SetItem("oxygen", 0.2 + 0.15*i);
+                p_cell->InitialiseCellCycleModel();
+                (set == 0 ? serial_cells : batched_cells).push_back(p_cell);
+            }
+        }
+
+        // This model uses an ODE solver that cannot be batched, so is solved as usual
+        boost::shared_ptr<CellCycleModelOdeSolver<TysonNovakCellCycleModel, BackwardEulerIvpOdeSolver> >
+            p_solver(CellCycleModelOdeSolver<TysonNovakCellCycleModel, BackwardEulerIvpOdeSolver>::Instance());
+        p_solver->SetSizeOfOdeSystem(6);
+        p_solver->Initialise();
+        TysonNovakCellCycleModel* p_tyson_novak_model = new TysonNovakCellCycleModel(p_solver);
+        CellPtr p_tyson_novak_cell(new Cell(p_state, p_tyson_novak_model));
+        p_tyson_novak_cell->SetCellProliferativeType(p_stem_type);
+        p_tyson_novak_cell->InitialiseCellCycleModel();
+
+        std::vector<CellCycleModelOdeHandler*> handlers;
+        for (unsigned i=0; i<num_cells; i++)
+        {
+            handlers.push_back(dynamic_cast<CellCycleModelOdeHandler*>(batched_cells[i]->GetCellCycleModel()));
+        }
+        handlers.push_back(p_tyson_novak_model);
+
+        CellOdeBatchSolver batch_solver;
+        TS_ASSERT_EQUALS(batch_solver.GetNumBatchedSystems(), 0u);
+
+        unsigned total_num_batched = 0;
+        unsigned num_ready_to_divide = 0;
+        while (!p_simulation_time->IsFinished())
+        {
+            p_simulation_time->IncrementTimeOneStep();
+
+            batch_solver.Solve(handlers, p_simulation_time->GetTime());
+            TS_ASSERT_LESS_THAN_EQUALS(batch_solver.GetNumBatchedSystems(), num_cells);
+            total_num_batched += batch_solver.GetNumBatchedSystems();
+
+            p_tyson_novak_cell->ReadyToDivide();
+            for (unsigned i=0; i<num_cells; i++)
+            {
+                bool serial_ready = serial_cells[i]->ReadyToDivide();
+                bool batched_ready = batched_cells[i]->ReadyToDivide();
+                TS_ASSERT_EQUALS(serial_ready, batched_ready);
+                if (serial_ready)
+                {
+                    num_ready_to_divide++;
+                }
+
+                Alarcon2004OxygenBasedCellCycleModel* p_serial_model = static_cast<Alarcon2004OxygenBasedCellCycleModel*>(serial_cells[i]->GetCellCycleModel());
+                Alarcon2004OxygenBasedCellCycleModel* p_batched_model = static_cast<Alarcon2004OxygenBasedCellCycleModel*>(batched_cells[i]->GetCellCycleModel());
+                TS_ASSERT_EQUALS(p_serial_model->GetCurrentCellCyclePhase(), p_batched_model->GetCurrentCellCyclePhase());
+                TS_ASSERT_DELTA(p_serial_model->GetG1Duration(), p_batched_model->GetG1Duration(), 1e-12);
+
+                std::vector<double> serial_state = p_serial_model->GetProteinConcentrations();
+                std::vector<double> batched_state = p_batched_model->GetProteinConcentrations();
+                for (unsigned j=0; j<serial_state.size(); j++)
+                {
+                    TS_ASSERT_DELTA(serial_state[j], batched_state[j], 1e-12);
+                }
+            }
+        }
+
+        // Some of the ODEs will have been batched, and some will have reached their stopping event
+        TS_ASSERT_LESS_THAN(0u, total_num_batched);
+        TS_ASSERT_LESS_THAN(0u, num_ready_to_divide);
+    }
+
+    void TestBatchedSrnModelsMatchSerialSolve()
+    {
+        SimulationTime* p_simulation_time = SimulationTime::Instance();
+        p_simulation_time->SetEndTimeAndNumberOfTimeSteps(5.0, 50);
+
+        MAKE_PTR(WildTypeCellMutationState, p_state);
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+
+        // Use a forward Euler solver, so that both fixed-step methods are covered
+        boost::shared_ptr<CellCycleModelOdeSolver<DeltaNotchSrnModel, EulerIvpOdeSolver> >
+            p_solver(CellCycleModelOdeSolver<DeltaNotchSrnModel, EulerIvpOdeSolver>::Instance());
+        p_solver->Initialise();
+
+        std::vector<CellPtr> serial_cells;
+        std::vector<CellPtr> batched_cells;
+        std::vector<CellCycleModelOdeHandler*> handlers;
+        unsigned num_cells = 5;
+        for (unsigned i=0; i<num_cells; i++)
+        {
+            for (unsigned set=0; set<2; set++)
+            {
+                DeltaNotchSrnModel* p_srn_model = new DeltaNotchSrnModel(p_solver);
+                p_srn_model->SetDt(0.01);
+                std::vector<double> initial_conditions(2, 0.1*(i+1));
+                p_srn_model->SetInitialConditions(initial_conditions);
+
+                CellPtr p_cell(new Cell(p_state, new UniformG1GenerationalCellCycleModel(), p_srn_model));
+                p_cell->SetCellProliferativeType(p_diff_type);
+                p_cell->GetCellData()->SetItem("mean delta", 0.25*i);
+                p_cell->InitialiseCellCycleModel();
+                p_cell->InitialiseSrnModel();
+
+                if (set == 0)
+                {
+                    serial_cells.push_back(p_cell);
+                }
+                else
+                {
+                    batched_cells.push_back(p_cell);
+                    handlers.push_back(p_srn_model);
+                }
+            }
+        }
+
+        CellOdeBatchSolver batch_solver;
+        while (!p_simulation_time->IsFinished())
+        {
+            p_simulation_time->IncrementTimeOneStep();
+
+            batch_solver.Solve(handlers, p_simulation_time->GetTime());
+            TS_ASSERT_EQUALS(batch_solver.GetNumBatchedSystems(), num_cells);
+
+            for (unsigned i=0; i<num_cells; i++)
+            {
+                serial_cells[i]->ReadyToDivide();
+                batched_cells[i]->ReadyToDivide();
+
+                DeltaNotchSrnModel* p_serial_model = static_cast<DeltaNotchSrnModel*>(serial_cells[i]->GetSrnModel());
+                DeltaNotchSrnModel* p_batched_model = static_cast<DeltaNotchSrnModel*>(batched_cells[i]->GetSrnModel());
+                TS_ASSERT_DELTA(p_serial_model->GetNotch(), p_batched_model->GetNotch(), 1e-12);
+                TS_ASSERT_DELTA(p_serial_model->GetDelta(), p_batched_model->GetDelta(), 1e-12);
+                TS_ASSERT_DELTA(p_batched_model->GetMeanNeighbouringDelta(), 0.25*i, 1e-12);
+            }
+        }
+
+        // The SRN models have not been solved past the end time
+        batch_solver.Solve(handlers, p_simulation_time->GetTime());
+        TS_ASSERT_EQUALS(batch_solver.GetNumBatchedSystems(), 0u);
+    }
+
+    void TestBatchedResultNotTakenUpInTime()
+    {
+        SimulationTime* p_simulation_time = SimulationTime::Instance();
+        p_simulation_time->SetEndTimeAndNumberOfTimeSteps(1.0, 10);
+
+        MAKE_PTR(WildTypeCellMutationState, p_state);
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+
+        boost::shared_ptr<CellCycleModelOdeSolver<DeltaNotchSrnModel, EulerIvpOdeSolver> >
+            p_solver(CellCycleModelOdeSolver<DeltaNotchSrnModel, EulerIvpOdeSolver>::Instance());
+        p_solver->Initialise();
+
+        std::vector<CellPtr> cells;
+        std::vector<DeltaNotchSrnModel*> srn_models;
+        for (unsigned set=0; set<2; set++)
+        {
+            DeltaNotchSrnModel* p_srn_model = new DeltaNotchSrnModel(p_solver);
+            p_srn_model->SetDt(0.01);
+            std::vector<double> initial_conditions(2, 0.3);
+            p_srn_model->SetInitialConditions(initial_conditions);
+
+            CellPtr p_cell(new Cell(p_state, new UniformG1GenerationalCellCycleModel(), p_srn_model));
+            p_cell->SetCellProliferativeType(p_diff_type);
+            p_cell->GetCellData()->SetItem("mean delta", 0.5);
+            p_cell->InitialiseCellCycleModel();
+            p_cell->InitialiseSrnModel();
+            cells.push_back(p_cell);
+            srn_models.push_back(p_srn_model);
+        }
+        std::vector<CellCycleModelOdeHandler*> handlers(1, srn_models[1]);
+
+        // The second model is solved in a batch, but not asked for the result at that time...
+        CellOdeBatchSolver batch_solver;
+        p_simulation_time->IncrementTimeOneStep();
+        batch_solver.Solve(handlers, p_simulation_time->GetTime());
+        TS_ASSERT_EQUALS(batch_solver.GetNumBatchedSystems(), 1u);
+
+        // ...so it is left out of the next batch, and solves on from the batched result by itself
+        p_simulation_time->IncrementTimeOneStep();
+        batch_solver.Solve(handlers, p_simulation_time->GetTime());
+        TS_ASSERT_EQUALS(batch_solver.GetNumBatchedSystems(), 0u);
+
+        cells[0]->ReadyToDivide();
+        cells[1]->ReadyToDivide();
+        TS_ASSERT_DELTA(srn_models[1]->GetNotch(), srn_models[0]->GetNotch(), 1e-12);
+        TS_ASSERT_DELTA(srn_models[1]->GetDelta(), srn_models[0]->GetDelta(), 1e-12);
+
+        // It can be batched again afterwards
+        p_simulation_time->IncrementTimeOneStep();
+        batch_solver.Solve(handlers, p_simulation_time->GetTime());
+        TS_ASSERT_EQUALS(batch_solver.GetNumBatchedSystems(), 1u);
+    }
+
+    void TestEvaluateYDerivativesBatch()
+    {
+        // Systems with different states and parameters, in struct-of-arrays layout
+        unsigned num_systems = 4;
+        std::vector<DeltaNotchOdeSystem> systems(num_systems);
+        std::vector<AbstractOdeSystem*> system_ptrs;
+        std::vector<double> y(2*num_systems);
+        for (unsigned s=0; s<num_systems; s++)
+        {
+            systems[s].SetParameter("Mean Delta", 0.1*s);
+            system_ptrs.push_back(&systems[s]);
+            y[s] = 0.2*(s+1);
+            y[num_systems + s] = 1.0 - 0.1*s;
+        }
+
+        // Both the vectorised version and the default give the same derivatives as each system
+        std::vector<double> dy(2*num_systems);
+        std::vector<double> default_dy(2*num_systems);
+        systems[0].EvaluateYDerivativesBatch(0.0, system_ptrs, y, dy);
+        systems[0].AbstractOdeSystem::EvaluateYDerivativesBatch(0.0, system_ptrs, y, default_dy);
+        for (unsigned s=0; s<num_systems; s++)
+        {
+            std::vector<double> row_y(2);
+            row_y[0] = y[s];
+            row_y[1] = y[num_systems + s];
+            std::vector<double> row_dy(2);
+            systems[s].EvaluateYDerivatives(0.0, row_y, row_dy);
+            for (unsigned i=0; i<2; i++)
+            {
+                TS_ASSERT_DELTA(dy[i*num_systems + s], row_dy[i], 1e-12);
+                TS_ASSERT_EQUALS(default_dy[i*num_systems + s], row_dy[i]);
+            }
+        }
+    }
+};
+
+#endif /*TESTCELLODEBATCHSOLVER_HPP_*/
@@ -39,6 +39,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "CheckpointArchiveTypes.hpp"
 
 #include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
 
 #include "CellPropertyCollection.hpp"
 #include "AbstractCellProperty.hpp"
@@ -48,6 +49,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ApcOneHitCellMutationState.hpp"
 #include "ApcTwoHitCellMutationState.hpp"
 #include "BetaCateninOneHitCellMutationState.hpp"
+#include "AbstractCellProliferativeType.hpp"
+#include "StemCellProliferativeType.hpp"
+#include "CellLabel.hpp"
 
 #include "OutputFileHandler.hpp"
 
@@ -137,6 +141,58 @@ public:
                               "Can only call GetProperty on a collection of size 1.");
     }
 
+    void TestPropertyCollectionTypeMask()
+    {
+        // Each property class is given a single type index, shared by all objects of that class
+        unsigned wild_type_index = CellPropertyRegistry::GetTypeIndex(typeid(WildTypeCellMutationState));
+        NEW_PROP(WildTypeCellMutationState, p_wt_mutation);
+        TS_ASSERT_EQUALS(CellPropertyRegistry::GetTypeIndex(p_wt_mutation), wild_type_index);
+        NEW_PROP(CellLabel, p_label);
+        TS_ASSERT_DIFFERS(CellPropertyRegistry::GetTypeIndex(p_label), wild_type_index);
+
+        // Querying a collection records which of its property classes derive from the base class
+        CellPropertyCollection mutation_collection;
+        mutation_collection.AddProperty(p_wt_mutation);
+        mutation_collection.AddProperty(p_label);
+        TS_ASSERT_EQUALS(mutation_collection.HasPropertyType<AbstractCellMutationState>(), true);
+        uint64_t checked_mask = CellPropertyRegistry::GetCheckedTypeMask<AbstractCellMutationState>();
+        TS_ASSERT((checked_mask & (uint64_t(1) << wild_type_index)) != 0);
+        TS_ASSERT((checked_mask & (uint64_t(1) << CellPropertyRegistry::GetTypeIndex(p_label))) != 0);
+        uint64_t mutation_mask = CellPropertyRegistry::GetSubTypeMask<AbstractCellMutationState>();
+        TS_ASSERT((mutation_mask & (uint64_t(1) << wild_type_index)) != 0);
+        TS_ASSERT((mutation_mask & (uint64_t(1) << CellPropertyRegistry::GetTypeIndex(p_label))) == 0);
+
+        // The registry does not keep property objects alive
+        boost::weak_ptr<AbstractCellProperty> p_weak_label = p_label;
+        mutation_collection.RemoveProperty(p_label);
+        p_label.reset();
+        TS_ASSERT(p_weak_label.expired());
+        NEW_PROP(CellLabel, p_new_label);
+        p_label = p_new_label;
+
+        // A class seen for the first time is checked when queried
+        CellPropertyCollection collection;
+        TS_ASSERT_EQUALS(collection.HasPropertyType<AbstractCellProliferativeType>(), false);
+        NEW_PROP(StemCellProliferativeType, p_stem_type);
+        collection.AddProperty(p_stem_type);
+        TS_ASSERT_EQUALS(collection.HasPropertyType<AbstractCellProliferativeType>(), true);
+        TS_ASSERT_EQUALS(collection.HasProperty<StemCellProliferativeType>(), true);
+        TS_ASSERT_EQUALS(collection.HasPropertyType<AbstractCellMutationState>(), false);
+
+        // Queries on a copy are answered from its own copy of the mask
+        collection.AddProperty(p_label);
+        CellPropertyCollection copied_collection = collection;
+        copied_collection.RemoveProperty<CellLabel>();
+        TS_ASSERT_EQUALS(copied_collection.HasProperty<CellLabel>(), false);
+        TS_ASSERT_EQUALS(copied_collection.HasProperty<StemCellProliferativeType>(), true);
+        TS_ASSERT_EQUALS(collection.HasProperty<CellLabel>(), true);
+
+        // Sub-collections only contain properties of the requested type
+        TS_ASSERT_EQUALS(collection.GetPropertiesType<AbstractCellMutationState>().GetSize(), 0u);
+        TS_ASSERT_EQUALS(collection.GetPropertiesType<AbstractCellProliferativeType>().GetSize(), 1u);
+        TS_ASSERT_EQUALS(collection.GetProperties<CellLabel>().HasProperty<CellLabel>(), true);
+    }
+
     void TestArchiveCellPropertyCollection()
     {
         OutputFileHandler handler("archive", false);
@@ -97,6 +97,9 @@ public:
         // Coverage of some set and methods
         p_pde_modifier->SetBcsOnBoxBoundary(false);
         TS_ASSERT_EQUALS(p_pde_modifier->AreBcsSetOnBoxBoundary(), false);
+        TS_ASSERT_EQUALS(p_pde_modifier->GetUsePersistentSolver(), false);
+        p_pde_modifier->SetUsePersistentSolver(true);
+        TS_ASSERT_EQUALS(p_pde_modifier->GetUsePersistentSolver(), true);
 
         // Check that the finite element mesh is correct
         TS_ASSERT_EQUALS(p_pde_modifier->mpFeMesh->GetNumNodes(), 121u);
@@ -237,6 +240,80 @@ public:
         TS_ASSERT_DELTA( p_cell_0->GetCellData()->GetItem("variable_grad_y"), -0.0179, 1e-4);
     }
 
+    void TestMeshBasedSquareMonolayerWithPersistentSolver()
+    {
+        HoneycombMeshGenerator generator(10,10,0);
+        boost::shared_ptr<MutableMesh<2,2> > p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_differentiated_type);
+        CellsGenerator<UniformCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, p_mesh->GetNumNodes(), p_differentiated_type);
+
+        // Make cells with x<5.0 apoptotic (so no source term)
+        boost::shared_ptr<AbstractCellProperty> p_apoptotic_property =
+                cells[0]->rGetCellPropertyCollection().GetCellPropertyRegistry()->Get<ApoptoticCellProperty>();
+        for (unsigned i=0; i<cells.size(); i++)
+        {
+            c_vector<double,2> cell_location;
+            cell_location = p_mesh->GetNode(i)->rGetLocation();
+            if (cell_location(0) < 5.0)
+            {
+                cells[i]->AddCellProperty(p_apoptotic_property);
+            }
+        }
+
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        // Set up simulation time for file output
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 3);
+
+        // Create PDE and boundary condition objects
+        MAKE_PTR_ARGS(AveragedSourceEllipticPde<2>, p_pde, (cell_population, -0.1));
+        MAKE_PTR_ARGS(ConstBoundaryCondition<2>, p_bc, (1.0));
+
+        // Create a ChasteCuboid on which to base the finite element mesh used to solve the PDE
+        ChastePoint<2> lower(-5.0, -5.0);
+        ChastePoint<2> upper(15.0, 15.0);
+        MAKE_PTR_ARGS(ChasteCuboid<2>, p_cuboid, (lower, upper));
+
+        // Create one PDE modifier that keeps its solver and one that does not
+        MAKE_PTR_ARGS(EllipticBoxDomainPdeModifier<2>, p_persistent_modifier, (p_pde, p_bc, false, p_cuboid));
+        p_persistent_modifier->SetDependentVariableName("persistent");
+        p_persistent_modifier->SetUsePersistentSolver(true);
+        p_persistent_modifier->SetupSolve(cell_population, "TestAveragedBoxEllipticPdeWithPersistentSolver");
+
+        MAKE_PTR_ARGS(EllipticBoxDomainPdeModifier<2>, p_modifier, (p_pde, p_bc, false, p_cuboid));
+        p_modifier->SetDependentVariableName("variable");
+        p_modifier->SetupSolve(cell_population, "TestAveragedBoxEllipticPdeWithPersistentSolver");
+
+        // The first solve should match TestMeshBasedSquareMonolayer
+        CellPtr p_cell_0 = cell_population.GetCellUsingLocationIndex(0);
+        TS_ASSERT_DELTA(p_cell_0->GetCellData()->GetItem("persistent"), 0.8605, 1e-4);
+
+        // Move the cells so that the source term changes between solves, and check the two modifiers agree
+        for (unsigned step=0; step<3; step++)
+        {
+            for (unsigned i=0; i<p_mesh->GetNumNodes(); i++)
+            {
+                p_mesh->GetNode(i)->rGetModifiableLocation()[0] += 1.0;
+            }
+
+            SimulationTime::Instance()->IncrementTimeOneStep();
+            p_persistent_modifier->UpdateAtEndOfTimeStep(cell_population);
+            p_modifier->UpdateAtEndOfTimeStep(cell_population);
+
+            for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+                 cell_iter != cell_population.End();
+                 ++cell_iter)
+            {
+                TS_ASSERT_DELTA(cell_iter->GetCellData()->GetItem("persistent"),
+                                cell_iter->GetCellData()->GetItem("variable"), 1e-4);
+            }
+        }
+        TS_ASSERT(p_persistent_modifier->mpPersistentSolver);
+    }
+
     void TestNodeBasedSquareMonolayer()
     {
         HoneycombMeshGenerator generator(10,10,0);
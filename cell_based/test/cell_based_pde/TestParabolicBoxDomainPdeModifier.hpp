@@ -109,6 +109,9 @@ public:
         TS_ASSERT_EQUALS(p_pde_modifier->GetOutputGradient(),false); // Defaults to false
         p_pde_modifier->SetOutputGradient(true);
         TS_ASSERT_EQUALS(p_pde_modifier->GetOutputGradient(),true);
+        TS_ASSERT_EQUALS(p_pde_modifier->GetUsePersistentSolver(), false);
+        p_pde_modifier->SetUsePersistentSolver(true);
+        TS_ASSERT_EQUALS(p_pde_modifier->GetUsePersistentSolver(), true);
     }
 
     void TestArchiveParabolicBoxDomainPdeModifier()
@@ -249,6 +252,68 @@ public:
             "Boundary conditions cannot yet be set on the cell population boundary for a ParabolicBoxDomainPdeModifier");
     }
 
+    // Only difference from above test is the use of a persistent solver here
+    void TestMeshBasedSquareMonolayerWithPersistentSolver()
+    {
+        HoneycombMeshGenerator generator(10,10,0);
+        boost::shared_ptr<MutableMesh<2,2> > p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_differentiated_type);
+        CellsGenerator<UniformCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, p_mesh->GetNumNodes(), p_differentiated_type);
+
+        // Make cells with x<5.0 apoptotic (so no source term)
+        boost::shared_ptr<AbstractCellProperty> p_apoptotic_property =
+                       cells[0]->rGetCellPropertyCollection().GetCellPropertyRegistry()->Get<ApoptoticCellProperty>();
+        for (unsigned i=0; i<cells.size(); i++)
+        {
+            c_vector<double,2> cell_location;
+            cell_location = p_mesh->GetNode(i)->rGetLocation();
+            if (cell_location(0) < 5.0)
+            {
+                cells[i]->AddCellProperty(p_apoptotic_property);
+            }
+            // Set initial condition for PDE
+            cells[i]->GetCellData()->SetItem("variable",1.0);
+        }
+
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+        // Set up simulation time for file output
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 10);
+
+        // Create PDE and boundary condition objects
+        MAKE_PTR_ARGS(AveragedSourceParabolicPde<2>, p_pde, (cell_population, 0.1, 1.0, -1.0));
+        MAKE_PTR_ARGS(ConstBoundaryCondition<2>, p_bc, (1.0));
+
+        // Create a ChasteCuboid on which to base the finite element mesh used to solve the PDE
+        ChastePoint<2> lower(-5.0, -5.0);
+        ChastePoint<2> upper(15.0, 15.0);
+        MAKE_PTR_ARGS(ChasteCuboid<2>, p_cuboid, (lower, upper));
+
+        // Create a PDE modifier and set the name of the dependent variable in the PDE
+        MAKE_PTR_ARGS(ParabolicBoxDomainPdeModifier<2>, p_pde_modifier, (p_pde, p_bc, false, p_cuboid));
+        p_pde_modifier->SetDependentVariableName("variable");
+        p_pde_modifier->SetUsePersistentSolver(true);
+        p_pde_modifier->SetOutputGradient(true);
+        p_pde_modifier->SetupSolve(cell_population,"TestAveragedParabolicPdeWithPersistentSolver");
+
+        // Run for 10 time steps
+        for (unsigned i=0; i<10; i++)
+        {
+            SimulationTime::Instance()->IncrementTimeOneStep();
+            p_pde_modifier->UpdateAtEndOfTimeStep(cell_population);
+        }
+        TS_ASSERT(p_pde_modifier->mpPersistentSolver);
+
+        // The solution should match TestMeshBasedSquareMonolayer
+        CellPtr p_cell_0 = cell_population.GetCellUsingLocationIndex(0);
+        TS_ASSERT_DELTA( p_cell_0->GetCellData()->GetItem("variable"), 0.8513, 1e-4);
+        TS_ASSERT_DELTA( p_cell_0->GetCellData()->GetItem("variable_grad_x"), -0.0505, 1e-4);
+        TS_ASSERT_DELTA( p_cell_0->GetCellData()->GetItem("variable_grad_y"), -0.0175, 1e-4);
+    }
+
     // Only difference from above test is the use of Neuman BCs here
     void TestMeshBasedSquareMonolayerWithNeumanBcs()
     {
@@ -47,11 +47,84 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PottsMesh.hpp"
 #include "PottsMeshGenerator.hpp"
 #include "ArchiveOpener.hpp"
+#include "RandomNumberGenerator.hpp"
 
 #include "PetscSetupAndFinalize.hpp"
 
 class TestPottsMesh : public CxxTest::TestSuite
 {
+private:
+
+    /**
+     * Calculate the surface area of a Potts element from scratch, by looping over its
+     * nodes and counting the sides not shared with a Von Neumann neighbour in the element.
+     */
+    template<unsigned DIM>
+    unsigned CalculateSurfaceAreaOfElement(PottsMesh<DIM>& rMesh, unsigned elemIndex)
+    {
+        PottsElement<DIM>* p_element = rMesh.GetElement(elemIndex);
+        unsigned surface_area = 0;
+        for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+        {
+            std::set<unsigned> neighbours = rMesh.GetVonNeumannNeighbouringNodeIndices(p_element->GetNodeGlobalIndex(local_index));
+            unsigned local_edges = 2*DIM;
+            for (std::set<unsigned>::iterator iter = neighbours.begin(); iter != neighbours.end(); ++iter)
+            {
+                if (rMesh.GetNode(*iter)->rGetContainingElementIndices().count(elemIndex) > 0)
+                {
+                    local_edges--;
+                }
+            }
+            surface_area += local_edges;
+        }
+        return surface_area;
+    }
+
+    /**
+     * Randomly copy the element of one node to a neighbouring node many times, as in
+     * a Potts simulation, checking that the element surface areas stay up to date.
+     */
+    template<unsigned DIM>
+    void CheckSurfaceAreasAfterRandomSpinCopies(PottsMesh<DIM>& rMesh, unsigned numCopies)
+    {
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+        for (unsigned i=0; i<numCopies; i++)
+        {
+            unsigned node_index = p_gen->randMod(rMesh.GetNumNodes());
+            std::set<unsigned> neighbours = rMesh.GetMooreNeighbouringNodeIndices(node_index);
+            std::set<unsigned>::iterator neighbour_iter = neighbours.begin();
+            std::advance(neighbour_iter, p_gen->randMod(neighbours.size()));
+
+            std::set<unsigned> containing_elements = rMesh.GetNode(node_index)->rGetContainingElementIndices();
+            std::set<unsigned> neighbour_containing_elements = rMesh.GetNode(*neighbour_iter)->rGetContainingElementIndices();
+            if (containing_elements == neighbour_containing_elements)
+            {
+                continue;
+            }
+
+            // Don't empty any element
+            if (!containing_elements.empty() && rMesh.GetElement(*containing_elements.begin())->GetNumNodes() == 1)
+            {
+                continue;
+            }
+
+            if (!containing_elements.empty())
+            {
+                PottsElement<DIM>* p_element = rMesh.GetElement(*containing_elements.begin());
+                p_element->DeleteNode(p_element->GetNodeLocalIndex(node_index));
+            }
+            if (!neighbour_containing_elements.empty())
+            {
+                rMesh.GetElement(*neighbour_containing_elements.begin())->AddNode(rMesh.GetNode(node_index));
+            }
+
+            for (unsigned elem_index=0; elem_index<rMesh.GetNumElements(); elem_index++)
+            {
+                TS_ASSERT_DELTA(rMesh.GetSurfaceAreaOfElement(elem_index), CalculateSurfaceAreaOfElement(rMesh, elem_index), 1e-12);
+            }
+        }
+    }
+
 public:
     void TestBasic2dPottsMesh()
     {
@@ -1780,6 +1853,47 @@ public:
         TS_ASSERT_EQUALS(p_mesh->GetNumNodes(), 2u);
     }
 
+    void TestElementSurfaceAreasAreKeptUpToDate()
+    {
+        RandomNumberGenerator::Instance()->Reseed(0);
+
+        // 2D mesh with a gap of medium around the elements
+        {
+            PottsMeshGenerator<2> generator(12, 2, 4, 12, 2, 4);
+            boost::shared_ptr<PottsMesh<2> > p_mesh = generator.GetMesh();
+
+            for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+            {
+                TS_ASSERT_DELTA(p_mesh->GetSurfaceAreaOfElement(elem_index), 16.0, 1e-12);
+            }
+            CheckSurfaceAreasAfterRandomSpinCopies(*p_mesh, 500);
+
+            // Dividing an element and deleting a node should also leave the surface areas correct
+            unsigned new_elem_index = p_mesh->DivideElement(p_mesh->GetElement(0));
+            TS_ASSERT_DELTA(p_mesh->GetSurfaceAreaOfElement(0), CalculateSurfaceAreaOfElement(*p_mesh, 0), 1e-12);
+            TS_ASSERT_DELTA(p_mesh->GetSurfaceAreaOfElement(new_elem_index), CalculateSurfaceAreaOfElement(*p_mesh, new_elem_index), 1e-12);
+
+            p_mesh->DeleteNode(p_mesh->GetElement(1)->GetNodeGlobalIndex(0));
+            for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+            {
+                TS_ASSERT_DELTA(p_mesh->GetSurfaceAreaOfElement(elem_index), CalculateSurfaceAreaOfElement(*p_mesh, elem_index), 1e-12);
+            }
+            CheckSurfaceAreasAfterRandomSpinCopies(*p_mesh, 100);
+        }
+
+        // 3D mesh that is periodic in x
+        {
+            PottsMeshGenerator<3> generator(6, 2, 3, 5, 1, 3, 5, 1, 3, false, true);
+            boost::shared_ptr<PottsMesh<3> > p_mesh = generator.GetMesh();
+
+            for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+            {
+                TS_ASSERT_DELTA(p_mesh->GetSurfaceAreaOfElement(elem_index), CalculateSurfaceAreaOfElement(*p_mesh, elem_index), 1e-12);
+            }
+            CheckSurfaceAreasAfterRandomSpinCopies(*p_mesh, 500);
+        }
+    }
+
     void TestArchive2dPottsMesh()
     {
         EXIT_IF_PARALLEL;
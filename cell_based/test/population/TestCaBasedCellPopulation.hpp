@@ -235,6 +235,9 @@ public:
         TS_ASSERT_THROWS_THIS(cell_population.GetCellUsingLocationIndex(2),
             "Location index input argument does not correspond to a Cell");
         TS_ASSERT_THROWS_NOTHING(cell_population.GetCellUsingLocationIndex(3));
+        TS_ASSERT_EQUALS(cell_population.rGetCellUsingLocationIndex(3), cell_population.GetCellUsingLocationIndex(3));
+        TS_ASSERT_THROWS_THIS(cell_population.rGetCellUsingLocationIndex(2),
+            "Location index input argument does not correspond to a Cell");
 
         // Now remove first cell from lattice 0 and move it to lattice 3
         cells.resize(cell_population.rGetCells().size()); // Since the vector gets cleared by the population constructor
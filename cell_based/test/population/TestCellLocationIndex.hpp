@@ -0,0 +1,218 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTCELLLOCATIONINDEX_HPP_
+#define TESTCELLLOCATIONINDEX_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "AbstractCellBasedTestSuite.hpp"
+#include "CellLocationIndex.hpp"
+#include "CellsGenerator.hpp"
+#include "DifferentiatedCellProliferativeType.hpp"
+#include "FixedG1GenerationalCellCycleModel.hpp"
+#include "SmartPointers.hpp"
+
+// This test is always run sequentially (never in parallel)
+#include "FakePetscSetup.hpp"
+
+class TestCellLocationIndex : public AbstractCellBasedTestSuite
+{
+public:
+
+    void TestAddAndRemoveCells()
+    {
+        std::vector<CellPtr> cells;
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, 4, p_diff_type);
+
+        CellLocationIndex index;
+        TS_ASSERT_EQUALS(index.GetNumAttachedCells(), 0u);
+        TS_ASSERT_EQUALS(index.GetNumCells(7), 0u);
+        TS_ASSERT(index.GetCells(7).empty());
+        TS_ASSERT_EQUALS(cells[0]->GetLocationIndexSlot(), UINT_MAX);
+
+        // Attach cells to location indices out of order
+        index.AddCell(5, cells[0]);
+        index.AddCell(2, cells[1]);
+        index.AddCell(9, cells[2]);
+        TS_ASSERT_EQUALS(index.GetNumAttachedCells(), 3u);
+        TS_ASSERT_EQUALS(index.GetLocationIndex(cells[0]), 5u);
+        TS_ASSERT_EQUALS(index.GetLocationIndex(cells[1]), 2u);
+        TS_ASSERT_EQUALS(index.GetLocationIndex(cells[2]), 9u);
+        TS_ASSERT(index.rGetCell(5) == cells[0]);
+        TS_ASSERT(index.rGetCell(2) == cells[1]);
+        TS_ASSERT(index.rGetCell(9) == cells[2]);
+        TS_ASSERT(index.IsCellAttached(cells[2]));
+        TS_ASSERT(!index.IsCellAttached(cells[3]));
+
+        TS_ASSERT_THROWS_THIS(index.rGetCell(3), "Location index input argument does not correspond to a Cell");
+        TS_ASSERT_THROWS_THIS(index.rGetCell(100), "Location index input argument does not correspond to a Cell");
+
+        // Adding an attached cell moves it
+        index.AddCell(3, cells[0]);
+        TS_ASSERT_EQUALS(index.GetNumAttachedCells(), 3u);
+        TS_ASSERT_EQUALS(index.GetLocationIndex(cells[0]), 3u);
+        TS_ASSERT_EQUALS(index.GetNumCells(5), 0u);
+
+        // Removing a cell frees its slot for reuse
+        unsigned slot = cells[1]->GetLocationIndexSlot();
+        TS_ASSERT_THROWS_THIS(index.RemoveCell(3, cells[1]),
+                              "Tried to remove a cell which is not attached to the given location index");
+        index.RemoveCell(2, cells[1]);
+        TS_ASSERT(!index.IsCellAttached(cells[1]));
+        TS_ASSERT_EQUALS(cells[1]->GetLocationIndexSlot(), UINT_MAX);
+        TS_ASSERT_EQUALS(index.GetNumCells(2), 0u);
+        TS_ASSERT_EQUALS(index.GetNumAttachedCells(), 2u);
+
+        index.AddCell(4, cells[3]);
+        TS_ASSERT_EQUALS(cells[3]->GetLocationIndexSlot(), slot);
+        TS_ASSERT_EQUALS(index.GetLocationIndex(cells[3]), 4u);
+
+        // SetCell() replaces any cells at a location index
+        index.SetCell(9, cells[1]);
+        TS_ASSERT(!index.IsCellAttached(cells[2]));
+        TS_ASSERT(index.rGetCell(9) == cells[1]);
+
+        std::map<unsigned, std::set<CellPtr> > location_cell_map = index.GetLocationCellMap();
+        TS_ASSERT_EQUALS(location_cell_map.size(), 3u);
+        TS_ASSERT_EQUALS(location_cell_map[3].count(cells[0]), 1u);
+        TS_ASSERT_EQUALS(location_cell_map[4].count(cells[3]), 1u);
+        TS_ASSERT_EQUALS(location_cell_map[9].count(cells[1]), 1u);
+
+        // Removing a cell that is not attached does nothing
+        index.RemoveCell(cells[2]);
+        TS_ASSERT_EQUALS(index.GetNumAttachedCells(), 3u);
+
+        index.Clear();
+        TS_ASSERT_EQUALS(index.GetNumAttachedCells(), 0u);
+        TS_ASSERT(!index.IsCellAttached(cells[0]));
+        TS_ASSERT_EQUALS(cells[0]->GetLocationIndexSlot(), UINT_MAX);
+    }
+
+    void TestMultipleCellsAtALocation()
+    {
+        std::vector<CellPtr> cells;
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, 4, p_diff_type);
+
+        CellLocationIndex index;
+        for (unsigned i=0; i<3; i++)
+        {
+            index.AddCell(1, cells[i]);
+        }
+        index.AddCell(0, cells[3]);
+
+        TS_ASSERT_EQUALS(index.GetNumCells(1), 3u);
+        TS_ASSERT_THROWS_THIS(index.rGetCell(1), "Multiple cells are attached to a single location index.");
+
+        std::set<CellPtr> cells_at_location = index.GetCells(1);
+        TS_ASSERT_EQUALS(cells_at_location.size(), 3u);
+        for (unsigned i=0; i<3; i++)
+        {
+            TS_ASSERT_EQUALS(cells_at_location.count(cells[i]), 1u);
+            TS_ASSERT_EQUALS(index.GetLocationIndex(cells[i]), 1u);
+        }
+
+        // Remove cells from the middle, head and tail of the list at this location index
+        index.RemoveCell(1, cells[1]);
+        TS_ASSERT_EQUALS(index.GetNumCells(1), 2u);
+        index.RemoveCell(1, cells[0]);
+        TS_ASSERT(index.rGetCell(1) == cells[2]);
+        index.AddCell(1, cells[1]);
+        index.RemoveCell(1, cells[1]);
+        TS_ASSERT(index.rGetCell(1) == cells[2]);
+        TS_ASSERT(index.rGetCell(0) == cells[3]);
+
+        // A cell may only be attached to one location index at a time
+        index.AddCell(0, cells[2]);
+        TS_ASSERT_EQUALS(index.GetNumCells(1), 0u);
+        TS_ASSERT_EQUALS(index.GetNumCells(0), 2u);
+        TS_ASSERT_EQUALS(index.GetNumAttachedCells(), 2u);
+    }
+
+    void TestCellsInMoreThanOneIndex()
+    {
+        std::vector<CellPtr> cells;
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, 3, p_diff_type);
+
+        // The cells store their slots for the first index they are attached to
+        CellLocationIndex index;
+        index.AddCell(4, cells[0]);
+        index.AddCell(7, cells[1]);
+        TS_ASSERT(cells[0]->GetLocationIndexOfSlot() == &index);
+
+        {
+            CellLocationIndex other_index;
+            other_index.AddCell(2, cells[2]);
+            other_index.AddCell(8, cells[1]);
+            other_index.AddCell(5, cells[0]);
+            TS_ASSERT(cells[0]->GetLocationIndexOfSlot() == &index);
+            TS_ASSERT(cells[2]->GetLocationIndexOfSlot() == &other_index);
+
+            TS_ASSERT_EQUALS(index.GetLocationIndex(cells[0]), 4u);
+            TS_ASSERT_EQUALS(index.GetLocationIndex(cells[1]), 7u);
+            TS_ASSERT_EQUALS(other_index.GetLocationIndex(cells[0]), 5u);
+            TS_ASSERT_EQUALS(other_index.GetLocationIndex(cells[1]), 8u);
+            TS_ASSERT_EQUALS(other_index.GetLocationIndex(cells[2]), 2u);
+            TS_ASSERT(!index.IsCellAttached(cells[2]));
+            TS_ASSERT_THROWS_THIS(index.GetLocationIndex(cells[2]),
+                                  "Tried to get the location index of a cell which is not attached to one");
+
+            // Moving or removing a cell in one index does not affect the other
+            other_index.AddCell(6, cells[0]);
+            other_index.RemoveCell(8, cells[1]);
+            TS_ASSERT_EQUALS(index.GetLocationIndex(cells[0]), 4u);
+            TS_ASSERT_EQUALS(index.GetLocationIndex(cells[1]), 7u);
+            TS_ASSERT_EQUALS(other_index.GetLocationIndex(cells[0]), 6u);
+            TS_ASSERT(!other_index.IsCellAttached(cells[1]));
+
+            index.RemoveCell(4, cells[0]);
+            TS_ASSERT(cells[0]->GetLocationIndexOfSlot() == nullptr);
+            TS_ASSERT_EQUALS(other_index.GetLocationIndex(cells[0]), 6u);
+        }
+
+        // Destroying an index detaches its cells
+        TS_ASSERT(cells[2]->GetLocationIndexOfSlot() == nullptr);
+        TS_ASSERT_EQUALS(cells[2]->GetLocationIndexSlot(), UINT_MAX);
+        TS_ASSERT_EQUALS(index.GetLocationIndex(cells[1]), 7u);
+    }
+};
+
+#endif /*TESTCELLLOCATIONINDEX_HPP_*/
@@ -0,0 +1,192 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTCELLLOCATIONINDEXPROFILE_HPP_
+#define TESTCELLLOCATIONINDEXPROFILE_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <map>
+#include <set>
+
+#include "AbstractCellBasedTestSuite.hpp"
+#include "CellLocationIndex.hpp"
+#include "CellsGenerator.hpp"
+#include "DifferentiatedCellProliferativeType.hpp"
+#include "FixedG1GenerationalCellCycleModel.hpp"
+#include "RandomNumberGenerator.hpp"
+#include "SmartPointers.hpp"
+#include "Timer.hpp"
+
+// This test is always run sequentially (never in parallel)
+#include "FakePetscSetup.hpp"
+
+/**
+ * The pair of maps that AbstractCellPopulation used to link cells and location
+ * indices before CellLocationIndex, kept here as a baseline for comparison.
+ */
+class MapBasedCellLocationIndex
+{
+public:
+
+    /** Map location indices back to cells. */
+    std::map<unsigned, std::set<CellPtr> > mLocationCellMap;
+
+    /** Map cells to location indices. */
+    std::map<Cell*, unsigned> mCellLocationMap;
+
+    /**
+     * Attach a cell to a location index.
+     *
+     * @param index the location index
+     * @param pCell the cell
+     */
+    void AddCell(unsigned index, CellPtr pCell)
+    {
+        mLocationCellMap[index].insert(pCell);
+        mCellLocationMap[pCell.get()] = index;
+    }
+
+    /**
+     * @return the cell attached to a location index.
+     *
+     * @param index the location index
+     */
+    CellPtr GetCell(unsigned index)
+    {
+        std::map<unsigned, std::set<CellPtr> >::const_iterator iter = mLocationCellMap.find(index);
+        return *(iter->second.begin());
+    }
+
+    /**
+     * @return whether a cell is attached to a location index.
+     *
+     * @param index the location index
+     */
+    bool IsCellAttached(unsigned index)
+    {
+        std::set<CellPtr> cells = mLocationCellMap[index];
+        return !(cells.empty());
+    }
+
+    /**
+     * @return the location index of a cell.
+     *
+     * @param pCell the cell
+     */
+    unsigned GetLocationIndex(CellPtr pCell)
+    {
+        return mCellLocationMap[pCell.get()];
+    }
+};
+
+/**
+ * This class measures the throughput of the lookups between cells and location indices
+ * made by forces, writers, killers and PDE modifiers, for the old map-based scheme and
+ * for CellLocationIndex.
+ *
+ * This test is used for profiling.
+ */
+class TestCellLocationIndexProfile : public AbstractCellBasedTestSuite
+{
+public:
+
+    void TestLookupThroughput()
+    {
+        const unsigned num_cells = 10000;
+        const unsigned num_sweeps = 100;
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, num_cells, p_diff_type);
+
+        // Attach the cells to a random permutation of location indices
+        std::vector<unsigned> location_indices(num_cells);
+        for (unsigned i=0; i<num_cells; i++)
+        {
+            location_indices[i] = i;
+        }
+        RandomNumberGenerator::Instance()->Shuffle(num_cells, location_indices);
+
+        MapBasedCellLocationIndex map_index;
+        CellLocationIndex dense_index;
+        for (unsigned i=0; i<num_cells; i++)
+        {
+            map_index.AddCell(location_indices[i], cells[i]);
+            dense_index.AddCell(location_indices[i], cells[i]);
+        }
+
+        // Time cell -> location, location -> cell and occupancy lookups for each scheme
+        unsigned map_checksum = 0;
+        double start_time = Timer::GetWallTime();
+        for (unsigned sweep=0; sweep<num_sweeps; sweep++)
+        {
+            for (unsigned i=0; i<num_cells; i++)
+            {
+                unsigned location_index = map_index.GetLocationIndex(cells[i]);
+                if (map_index.IsCellAttached(location_index))
+                {
+                    map_checksum += map_index.GetCell(location_index)->GetCellId() + location_index;
+                }
+            }
+        }
+        double map_time = Timer::GetWallTime() - start_time;
+
+        unsigned dense_checksum = 0;
+        start_time = Timer::GetWallTime();
+        for (unsigned sweep=0; sweep<num_sweeps; sweep++)
+        {
+            for (unsigned i=0; i<num_cells; i++)
+            {
+                unsigned location_index = dense_index.GetLocationIndex(cells[i]);
+                if (dense_index.GetNumCells(location_index) != 0)
+                {
+                    dense_checksum += dense_index.rGetCell(location_index)->GetCellId() + location_index;
+                }
+            }
+        }
+        double dense_time = Timer::GetWallTime() - start_time;
+
+        // Both schemes should find the same cells
+        TS_ASSERT_EQUALS(dense_checksum, map_checksum);
+
+        double num_lookups = 3.0*num_cells*num_sweeps;
+        std::cout << "Map-based location index:\t" << num_lookups/map_time << " lookups/s\n";
+        std::cout << "CellLocationIndex:\t\t" << num_lookups/dense_time << " lookups/s\n";
+    }
+};
+
+#endif /*TESTCELLLOCATIONINDEXPROFILE_HPP_*/
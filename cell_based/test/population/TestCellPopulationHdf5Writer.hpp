@@ -0,0 +1,212 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTCELLPOPULATIONHDF5WRITER_HPP_
+#define TESTCELLPOPULATIONHDF5WRITER_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <climits>
+#include <cmath>
+#include <hdf5.h>
+
+#include "AbstractCellBasedTestSuite.hpp"
+#include "CellAgesWriter.hpp"
+#include "CellPopulationHdf5Writer.hpp"
+#include "CellProliferativeTypesCountWriter.hpp"
+#include "CellsGenerator.hpp"
+#include "FileFinder.hpp"
+#include "FixedG1GenerationalCellCycleModel.hpp"
+#include "HoneycombMeshGenerator.hpp"
+#include "MeshBasedCellPopulation.hpp"
+#include "OutputFileHandler.hpp"
+#include "SmartPointers.hpp"
+#include "PetscSetupAndFinalize.hpp"
+
+class TestCellPopulationHdf5Writer : public AbstractCellBasedTestSuite
+{
+private:
+
+    /**
+     * Read the whole of a dataset from an open HDF5 file.
+     *
+     * @param fileId  the HDF5 file
+     * @param rPath  the path of the dataset within the file
+     * @param type  the memory type to read into
+     * @param rDims  filled in with the dimensions of the dataset
+     * @return the dataset contents in row-major order
+     */
+    template<typename T>
+    std::vector<T> ReadDataset(hid_t fileId, const std::string& rPath, hid_t type, std::vector<hsize_t>& rDims)
+    {
+        hid_t dataset = H5Dopen2(fileId, rPath.c_str(), H5P_DEFAULT);
+        TS_ASSERT(dataset >= 0);
+        hid_t dataspace = H5Dget_space(dataset);
+        int rank = H5Sget_simple_extent_ndims(dataspace);
+        rDims.resize(rank);
+        H5Sget_simple_extent_dims(dataspace, &rDims[0], nullptr);
+
+        hsize_t size = 1;
+        for (int i=0; i<rank; i++)
+        {
+            size *= rDims[i];
+        }
+        std::vector<T> data(size);
+        H5Dread(dataset, type, H5S_ALL, H5S_ALL, H5P_DEFAULT, &data[0]);
+        H5Sclose(dataspace);
+        H5Dclose(dataset);
+        return data;
+    }
+
+public:
+
+    void TestWriteMeshBasedCellPopulation()
+    {
+        EXIT_IF_PARALLEL; // HDF5 output of cell populations is sequential only
+
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 2);
+
+        HoneycombMeshGenerator generator(3, 3);
+        boost::shared_ptr<MutableMesh<2,2> > p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, p_mesh->GetNumNodes());
+
+        MeshBasedCellPopulation<2> cell_population(*p_mesh, cells);
+        cell_population.AddCellWriter<CellAgesWriter>();
+        cell_population.AddCellPopulationCountWriter<CellProliferativeTypesCountWriter>();
+
+        TS_ASSERT_EQUALS(cell_population.GetOutputResultsAsHdf5(), false);
+        cell_population.SetOutputResultsAsHdf5(true);
+        TS_ASSERT_EQUALS(cell_population.GetOutputResultsAsHdf5(), true);
+
+        std::string output_directory = "TestCellPopulationHdf5Writer";
+        OutputFileHandler output_file_handler(output_directory);
+        cell_population.OpenWritersFiles(output_file_handler);
+        cell_population.WriteResultsToFiles(output_directory);
+
+        // Remove a cell and give another a CellData item before the second write
+        SimulationTime::Instance()->IncrementTimeOneStep();
+        cell_population.GetCellUsingLocationIndex(4)->Kill();
+        cell_population.RemoveDeadCells();
+        cell_population.Update();
+        cell_population.Begin()->GetCellData()->SetItem("growth factor", 2.5);
+
+        cell_population.WriteResultsToFiles(output_directory);
+        cell_population.CloseWritersFiles();
+
+        // Read the data back in
+        FileFinder h5_file = output_file_handler.FindFile("results.h5");
+        TS_ASSERT(h5_file.IsFile());
+        TS_ASSERT(output_file_handler.FindFile("results.xdmf").IsFile());
+
+        // The HDF5 file replaces the text output of cell writers and the VTK output, but not other writers' output
+        TS_ASSERT(!output_file_handler.FindFile("cellages.dat").Exists());
+        TS_ASSERT(!output_file_handler.FindFile("results.pvd").Exists());
+        TS_ASSERT(!output_file_handler.FindFile("results_0.vtu").Exists());
+        TS_ASSERT(output_file_handler.FindFile("celltypes.dat").IsFile());
+
+        hid_t file_id = H5Fopen(h5_file.GetAbsolutePath().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        TS_ASSERT(file_id >= 0);
+
+        std::vector<hsize_t> dims;
+        std::vector<double> times = ReadDataset<double>(file_id, "Time", H5T_NATIVE_DOUBLE, dims);
+        TS_ASSERT_EQUALS(dims.size(), 1u);
+        TS_ASSERT_EQUALS(times.size(), 2u);
+        TS_ASSERT_DELTA(times[0], 0.0, 1e-12);
+        TS_ASSERT_DELTA(times[1], 0.5, 1e-12);
+
+        std::vector<unsigned> num_cells = ReadDataset<unsigned>(file_id, "NumCells", H5T_NATIVE_UINT, dims);
+        TS_ASSERT_EQUALS(num_cells.size(), 2u);
+        TS_ASSERT_EQUALS(num_cells[0], 9u);
+        TS_ASSERT_EQUALS(num_cells[1], 8u);
+
+        // Positions are stored as [time, cell, component]
+        std::vector<double> positions = ReadDataset<double>(file_id, "Position", H5T_NATIVE_DOUBLE, dims);
+        TS_ASSERT_EQUALS(dims.size(), 3u);
+        TS_ASSERT_EQUALS(dims[0], 2u);
+        TS_ASSERT_EQUALS(dims[1], 9u);
+        TS_ASSERT_EQUALS(dims[2], 2u);
+        unsigned index = 0;
+        for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+             cell_iter != cell_population.End();
+             ++cell_iter)
+        {
+            c_vector<double, 2> location = cell_population.GetLocationOfCellCentre(*cell_iter);
+            TS_ASSERT_DELTA(positions[(9 + index)*2], location[0], 1e-12);
+            TS_ASSERT_DELTA(positions[(9 + index)*2 + 1], location[1], 1e-12);
+            index++;
+        }
+
+        // The slot of the removed cell is left at the fill value
+        std::vector<unsigned> ids = ReadDataset<unsigned>(file_id, "CellId", H5T_NATIVE_UINT, dims);
+        TS_ASSERT_EQUALS(ids.size(), 18u);
+        TS_ASSERT_EQUALS(ids[9], cell_population.Begin()->GetCellId());
+        TS_ASSERT_EQUALS(ids[17], UINT_MAX);
+
+        // The CellData item only appears at the second time step
+        std::vector<double> growth = ReadDataset<double>(file_id, "CellData/growth_factor", H5T_NATIVE_DOUBLE, dims);
+        TS_ASSERT_EQUALS(growth.size(), 18u);
+        TS_ASSERT(std::isnan(growth[0]));
+        TS_ASSERT_DELTA(growth[9], 2.5, 1e-12);
+        TS_ASSERT(std::isnan(growth[10]));
+
+        // Cell writers contribute their VTK data
+        std::vector<double> ages = ReadDataset<double>(file_id, "CellWriters/Ages", H5T_NATIVE_DOUBLE, dims);
+        TS_ASSERT_EQUALS(ages.size(), 18u);
+        TS_ASSERT_DELTA(ages[9], cell_population.Begin()->GetAge(), 1e-12);
+
+        H5Fclose(file_id);
+    }
+
+    void TestExceptions()
+    {
+        EXIT_IF_PARALLEL;
+
+        OutputFileHandler output_file_handler("TestCellPopulationHdf5WriterExceptions", false);
+        CellPopulationHdf5Writer<2,2> writer(output_file_handler);
+        TS_ASSERT_EQUALS(writer.GetNumTimeSteps(), 0u);
+
+        TS_ASSERT_THROWS_THIS(writer.SetChunkSize(0), "The chunk size must be at least one");
+        TS_ASSERT_THROWS_THIS(writer.SetCompressionLevel(10), "The compression level must be between 0 and 9");
+
+        writer.SetChunkSize(16);
+        writer.SetCompressionLevel(0);
+        writer.Close();
+    }
+};
+
+#endif /*TESTCELLPOPULATIONHDF5WRITER_HPP_*/
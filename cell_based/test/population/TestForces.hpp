@@ -50,6 +50,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "HoneycombVertexMeshGenerator.hpp"
 #include "ChemotacticForce.hpp"
 #include "RepulsionForce.hpp"
+#include "BuskeAdhesiveForce.hpp"
+#include "BuskeElasticForce.hpp"
 #include "NagaiHondaForce.hpp"
 #include "NagaiHondaDifferentialAdhesionForce.hpp"
 #include "WelikyOsterForce.hpp"
@@ -67,9 +69,35 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "FileComparison.hpp"
 #include "SimpleTargetAreaModifier.hpp"
 #include "OffLatticeSimulation.hpp"
+#include "ThreadingTools.hpp"
 
 #include "PetscSetupAndFinalize.hpp"
 
+/**
+ * A spring force whose force between any two nodes is the unit vector in the x direction,
+ * used to check that overriding CalculateForceBetweenNodes() and
+ * CalculateForceBetweenNodesWithSeparation() takes effect.
+ */
+class ConstantSpringForce : public GeneralisedLinearSpringForce<3>
+{
+public:
+    c_vector<double, 3> CalculateForceBetweenNodes(unsigned nodeAGlobalIndex,
+                                                   unsigned nodeBGlobalIndex,
+                                                   AbstractCellPopulation<3>& rCellPopulation)
+    {
+        return unit_vector<double>(3, 0);
+    }
+
+    c_vector<double, 3> CalculateForceBetweenNodesWithSeparation(unsigned nodeAGlobalIndex,
+                                                                 unsigned nodeBGlobalIndex,
+                                                                 AbstractCellPopulation<3>& rCellPopulation,
+                                                                 const c_vector<double, 3>& rVectorFromAtoB,
+                                                                 double distanceBetweenNodes)
+    {
+        return CalculateForceBetweenNodes(nodeAGlobalIndex, nodeBGlobalIndex, rCellPopulation);
+    }
+};
+
 class TestForces : public AbstractCellBasedTestSuite
 {
 public:
@@ -1020,6 +1048,345 @@ public:
         }
     }
 
+    void TestTwoBodyForcesIndependentOfNumberOfThreads()
+    {
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0,1);
+
+        // Create a NodeBasedCellPopulation on a perturbed cubic lattice, so that most nodes interact
+        std::vector<Node<3>*> nodes;
+        unsigned index = 0;
+        for (unsigned i=0; i<8; i++)
+        {
+            for (unsigned j=0; j<8; j++)
+            {
+                for (unsigned k=0; k<8; k++)
+                {
+                    double x = 0.8*i + 0.1*sin(1.0*index);
+                    double y = 0.8*j + 0.1*cos(2.0*index);
+                    double z = 0.8*k + 0.1*sin(3.0*index);
+                    nodes.push_back(new Node<3>(index, false, x, y, z));
+                    index++;
+                }
+            }
+        }
+
+        NodesOnlyMesh<3> mesh;
+        mesh.ConstructNodesWithoutMesh(nodes, 1.5);
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 3> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+
+        NodeBasedCellPopulation<3> cell_population(mesh, cells);
+        cell_population.Update(); //Needs to be called separately as not in a simulation
+
+        // Label every third cell, so that the differential adhesion force has heterotypic pairs
+        boost::shared_ptr<AbstractCellProperty> p_label(cell_population.GetCellPropertyRegistry()->Get<CellLabel>());
+        unsigned cell_count = 0;
+        for (AbstractCellPopulation<3>::Iterator cell_iter = cell_population.Begin();
+             cell_iter != cell_population.End();
+             ++cell_iter)
+        {
+            if (cell_count%3 == 0)
+            {
+                cell_iter->AddCellProperty(p_label);
+            }
+            cell_count++;
+        }
+
+        std::vector<boost::shared_ptr<AbstractTwoBodyInteractionForce<3> > > forces;
+        MAKE_PTR(GeneralisedLinearSpringForce<3>, p_spring_force);
+        p_spring_force->SetCutOffLength(1.5);
+        forces.push_back(p_spring_force);
+        MAKE_PTR(DifferentialAdhesionGeneralisedLinearSpringForce<3>, p_adhesion_force);
+        p_adhesion_force->SetHeterotypicSpringConstantMultiplier(0.1);
+        p_adhesion_force->SetCutOffLength(1.5);
+        forces.push_back(p_adhesion_force);
+        MAKE_PTR(RepulsionForce<3>, p_repulsion_force);
+        forces.push_back(p_repulsion_force);
+
+        for (unsigned force_index=0; force_index<forces.size(); force_index++)
+        {
+            // Calculate the forces on one thread
+            ThreadingTools::SetNumThreads(1);
+            for (AbstractMesh<3,3>::NodeIterator node_iter = mesh.GetNodeIteratorBegin();
+                 node_iter != mesh.GetNodeIteratorEnd();
+                 ++node_iter)
+            {
+                node_iter->ClearAppliedForce();
+            }
+            forces[force_index]->AddForceContribution(cell_population);
+
+            std::vector<c_vector<double, 3> > serial_forces;
+            for (AbstractMesh<3,3>::NodeIterator node_iter = mesh.GetNodeIteratorBegin();
+                 node_iter != mesh.GetNodeIteratorEnd();
+                 ++node_iter)
+            {
+                serial_forces.push_back(node_iter->rGetAppliedForce());
+            }
+
+            // Calculate the forces on as many threads as are available (just one if built without OpenMP)
+            ThreadingTools::SetNumThreads(ThreadingTools::GetMaxNumThreads());
+            for (AbstractMesh<3,3>::NodeIterator node_iter = mesh.GetNodeIteratorBegin();
+                 node_iter != mesh.GetNodeIteratorEnd();
+                 ++node_iter)
+            {
+                node_iter->ClearAppliedForce();
+            }
+            forces[force_index]->AddForceContribution(cell_population);
+
+            // The results should be bit-identical
+            unsigned node_count = 0;
+            for (AbstractMesh<3,3>::NodeIterator node_iter = mesh.GetNodeIteratorBegin();
+                 node_iter != mesh.GetNodeIteratorEnd();
+                 ++node_iter)
+            {
+                for (unsigned j=0; j<3; j++)
+                {
+                    TS_ASSERT_EQUALS(node_iter->rGetAppliedForce()[j], serial_forces[node_count][j]);
+                }
+                node_count++;
+            }
+        }
+
+        ThreadingTools::Reset();
+
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
+
+    void TestTwoBodyForcesWithNodePairsFilteredByDistance()
+    {
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0,1);
+
+        // Create a NodeBasedCellPopulation on a perturbed cubic lattice
+        std::vector<Node<3>*> nodes;
+        unsigned index = 0;
+        for (unsigned i=0; i<6; i++)
+        {
+            for (unsigned j=0; j<6; j++)
+            {
+                for (unsigned k=0; k<6; k++)
+                {
+                    double x = 0.8*i + 0.1*sin(1.0*index);
+                    double y = 0.8*j + 0.1*cos(2.0*index);
+                    double z = 0.8*k + 0.1*sin(3.0*index);
+                    nodes.push_back(new Node<3>(index, false, x, y, z));
+                    index++;
+                }
+            }
+        }
+
+        NodesOnlyMesh<3> mesh;
+        mesh.ConstructNodesWithoutMesh(nodes, 1.5);
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 3> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+
+        NodeBasedCellPopulation<3> cell_population(mesh, cells);
+        TS_ASSERT_EQUALS(cell_population.GetFilterNodePairsByDistance(), false);
+        cell_population.Update(); //Needs to be called separately as not in a simulation
+        TS_ASSERT_EQUALS(cell_population.rGetFilteredNodePairs().size(), 0u);
+
+        // Filtering the node pairs keeps those closer than the cut-off length, along with their separations
+        cell_population.SetFilterNodePairsByDistance();
+        TS_ASSERT_EQUALS(cell_population.GetFilterNodePairsByDistance(), true);
+
+        std::vector<std::pair<Node<3>*, Node<3>*> >& r_node_pairs = cell_population.rGetNodePairs();
+        std::vector<std::pair<Node<3>*, Node<3>*> >& r_filtered_node_pairs = cell_population.rGetFilteredNodePairs();
+        const std::vector<c_vector<double, 3> >& r_separations = cell_population.rGetFilteredNodePairSeparations();
+        const std::vector<double>& r_distances = cell_population.rGetFilteredNodePairDistances();
+
+        unsigned num_pairs_within_cut_off = 0;
+        for (unsigned i=0; i<r_node_pairs.size(); i++)
+        {
+            if (norm_2(r_node_pairs[i].second->rGetLocation() - r_node_pairs[i].first->rGetLocation()) < 1.5)
+            {
+                num_pairs_within_cut_off++;
+            }
+        }
+        TS_ASSERT_EQUALS(r_filtered_node_pairs.size(), num_pairs_within_cut_off);
+        TS_ASSERT_LESS_THAN(r_filtered_node_pairs.size(), r_node_pairs.size());
+        TS_ASSERT_EQUALS(r_separations.size(), r_filtered_node_pairs.size());
+        TS_ASSERT_EQUALS(r_distances.size(), r_filtered_node_pairs.size());
+
+        for (unsigned i=0; i<r_filtered_node_pairs.size(); i++)
+        {
+            c_vector<double, 3> separation = r_filtered_node_pairs[i].second->rGetLocation() - r_filtered_node_pairs[i].first->rGetLocation();
+            for (unsigned j=0; j<3; j++)
+            {
+                TS_ASSERT_DELTA(r_separations[i][j], separation[j], 1e-12);
+            }
+            TS_ASSERT_DELTA(r_distances[i], norm_2(separation), 1e-12);
+            TS_ASSERT_LESS_THAN(r_distances[i], 1.5);
+        }
+
+        // The forces should not depend on whether the node pairs are filtered
+        std::vector<boost::shared_ptr<AbstractTwoBodyInteractionForce<3> > > forces;
+        MAKE_PTR(GeneralisedLinearSpringForce<3>, p_spring_force);
+        p_spring_force->SetCutOffLength(1.5);
+        forces.push_back(p_spring_force);
+        MAKE_PTR(RepulsionForce<3>, p_repulsion_force);
+        forces.push_back(p_repulsion_force);
+        MAKE_PTR(BuskeAdhesiveForce<3>, p_buske_adhesive_force);
+        forces.push_back(p_buske_adhesive_force);
+        MAKE_PTR(BuskeElasticForce<3>, p_buske_elastic_force);
+        forces.push_back(p_buske_elastic_force);
+
+        for (unsigned force_index=0; force_index<forces.size(); force_index++)
+        {
+            // Calculate the forces from all node pairs
+            cell_population.SetFilterNodePairsByDistance(false);
+            for (AbstractMesh<3,3>::NodeIterator node_iter = mesh.GetNodeIteratorBegin();
+                 node_iter != mesh.GetNodeIteratorEnd();
+                 ++node_iter)
+            {
+                node_iter->ClearAppliedForce();
+            }
+            forces[force_index]->AddForceContribution(cell_population);
+
+            std::vector<c_vector<double, 3> > unfiltered_forces;
+            for (AbstractMesh<3,3>::NodeIterator node_iter = mesh.GetNodeIteratorBegin();
+                 node_iter != mesh.GetNodeIteratorEnd();
+                 ++node_iter)
+            {
+                unfiltered_forces.push_back(node_iter->rGetAppliedForce());
+            }
+
+            // Calculate the forces from the filtered node pairs
+            cell_population.SetFilterNodePairsByDistance(true);
+            for (AbstractMesh<3,3>::NodeIterator node_iter = mesh.GetNodeIteratorBegin();
+                 node_iter != mesh.GetNodeIteratorEnd();
+                 ++node_iter)
+            {
+                node_iter->ClearAppliedForce();
+            }
+            forces[force_index]->AddForceContribution(cell_population);
+
+            unsigned node_count = 0;
+            for (AbstractMesh<3,3>::NodeIterator node_iter = mesh.GetNodeIteratorBegin();
+                 node_iter != mesh.GetNodeIteratorEnd();
+                 ++node_iter)
+            {
+                for (unsigned j=0; j<3; j++)
+                {
+                    TS_ASSERT_DELTA(node_iter->rGetAppliedForce()[j], unfiltered_forces[node_count][j], 1e-12);
+                }
+                node_count++;
+            }
+        }
+
+        // A subclass that overrides the force calculation is used when the node pairs are filtered
+        MAKE_PTR(ConstantSpringForce, p_constant_force);
+        for (AbstractMesh<3,3>::NodeIterator node_iter = mesh.GetNodeIteratorBegin();
+             node_iter != mesh.GetNodeIteratorEnd();
+             ++node_iter)
+        {
+            node_iter->ClearAppliedForce();
+        }
+        p_constant_force->AddForceContribution(cell_population);
+
+        std::vector<int> net_num_filtered_pairs_at_node(mesh.GetNumNodes(), 0);
+        for (unsigned i=0; i<r_filtered_node_pairs.size(); i++)
+        {
+            net_num_filtered_pairs_at_node[r_filtered_node_pairs[i].first->GetIndex()]++;
+            net_num_filtered_pairs_at_node[r_filtered_node_pairs[i].second->GetIndex()]--;
+        }
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            TS_ASSERT_DELTA(mesh.GetNode(i)->rGetAppliedForce()[0], (double)net_num_filtered_pairs_at_node[i], 1e-12);
+        }
+
+        // Pairs of large cells further apart than the cut-off length are kept, so that RepulsionForce is unchanged
+        for (unsigned i=0; i<10; i++)
+        {
+            mesh.GetNode(i)->SetRadius(1.0);
+        }
+        cell_population.InvalidateNodePairGeometry();
+        cell_population.UpdateNodePairGeometry();
+
+        unsigned num_large_pairs_beyond_cut_off = 0;
+        for (unsigned i=0; i<r_filtered_node_pairs.size(); i++)
+        {
+            if (r_distances[i] >= 1.5)
+            {
+                TS_ASSERT_LESS_THAN(r_distances[i], r_filtered_node_pairs[i].first->GetRadius() + r_filtered_node_pairs[i].second->GetRadius());
+                num_large_pairs_beyond_cut_off++;
+            }
+        }
+        TS_ASSERT_LESS_THAN(0u, num_large_pairs_beyond_cut_off);
+
+        std::vector<c_vector<double, 3> > unfiltered_repulsion_forces;
+        for (unsigned filter=0; filter<2; filter++)
+        {
+            cell_population.SetFilterNodePairsByDistance(filter == 1);
+            for (AbstractMesh<3,3>::NodeIterator node_iter = mesh.GetNodeIteratorBegin();
+                 node_iter != mesh.GetNodeIteratorEnd();
+                 ++node_iter)
+            {
+                node_iter->ClearAppliedForce();
+            }
+            p_repulsion_force->AddForceContribution(cell_population);
+
+            unsigned node_count = 0;
+            for (AbstractMesh<3,3>::NodeIterator node_iter = mesh.GetNodeIteratorBegin();
+                 node_iter != mesh.GetNodeIteratorEnd();
+                 ++node_iter)
+            {
+                if (filter == 0)
+                {
+                    unfiltered_repulsion_forces.push_back(node_iter->rGetAppliedForce());
+                }
+                else
+                {
+                    for (unsigned j=0; j<3; j++)
+                    {
+                        TS_ASSERT_DELTA(node_iter->rGetAppliedForce()[j], unfiltered_repulsion_forces[node_count][j], 1e-12);
+                    }
+                }
+                node_count++;
+            }
+        }
+        for (unsigned i=0; i<10; i++)
+        {
+            mesh.GetNode(i)->SetRadius(0.5);
+        }
+        cell_population.InvalidateNodePairGeometry();
+
+        // The separations are recalculated after a node is moved by SetNode()...
+        c_vector<double, 3> new_location = mesh.GetNode(0)->rGetLocation();
+        new_location[0] += 0.05;
+        ChastePoint<3> new_point(new_location);
+        cell_population.SetNode(0, new_point);
+        for (unsigned i=0; i<cell_population.rGetFilteredNodePairs().size(); i++)
+        {
+            c_vector<double, 3> separation = r_filtered_node_pairs[i].second->rGetLocation() - r_filtered_node_pairs[i].first->rGetLocation();
+            TS_ASSERT_DELTA(cell_population.rGetFilteredNodePairDistances()[i], norm_2(separation), 1e-12);
+        }
+
+        // ...but only after InvalidateNodePairGeometry() if the node is moved directly
+        std::vector<double> old_distances = cell_population.rGetFilteredNodePairDistances();
+        mesh.GetNode(0)->rGetModifiableLocation()[0] += 0.05;
+        for (unsigned i=0; i<old_distances.size(); i++)
+        {
+            TS_ASSERT_DELTA(cell_population.rGetFilteredNodePairDistances()[i], old_distances[i], 1e-12);
+        }
+        cell_population.InvalidateNodePairGeometry();
+        for (unsigned i=0; i<cell_population.rGetFilteredNodePairs().size(); i++)
+        {
+            c_vector<double, 3> separation = r_filtered_node_pairs[i].second->rGetLocation() - r_filtered_node_pairs[i].first->rGetLocation();
+            TS_ASSERT_DELTA(cell_population.rGetFilteredNodePairDistances()[i], norm_2(separation), 1e-12);
+        }
+
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
+
     void TestNagaiHondaForceMethods()
     {
         // Construct a 2D vertex mesh consisting of a single element
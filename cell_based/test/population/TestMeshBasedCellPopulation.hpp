@@ -141,6 +141,112 @@ private:
         TS_ASSERT_EQUALS(counter, cell_population.GetNumAllCells());
     }
 
+    /**
+     * Create the cells used by the tests of writing results to file: one per node of the mesh
+     * square_4_elements, in various cell cycle phases and with various proliferative types,
+     * mutation states and properties.
+     *
+     * @param rMesh  the mesh to construct
+     * @param rCells  to be filled in with the cells
+     */
+    void CreateMeshAndCellsForWriteResultsToFile(MutableMesh<2,2>& rMesh, std::vector<CellPtr>& rCells)
+    {
+        // Set up SimulationTime (needed if VTK is used)
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 1);
+
+        // Resetting the maximum cell ID to zero (to account for previous tests)
+        CellId::ResetMaxCellId();
+
+        // Create a simple mesh-based cell population, comprising various cell types in various cell cycle phases
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/square_4_elements");
+        rMesh.ConstructFromMeshReader(mesh_reader);
+
+        boost::shared_ptr<AbstractCellProperty> p_stem(CellPropertyRegistry::Instance()->Get<StemCellProliferativeType>());
+        boost::shared_ptr<AbstractCellProperty> p_transit(CellPropertyRegistry::Instance()->Get<TransitCellProliferativeType>());
+        boost::shared_ptr<AbstractCellProperty> p_diff(CellPropertyRegistry::Instance()->Get<DifferentiatedCellProliferativeType>());
+        boost::shared_ptr<AbstractCellProperty> p_wildtype(CellPropertyRegistry::Instance()->Get<WildTypeCellMutationState>());
+
+        for (unsigned elem_index=0; elem_index<rMesh.GetNumNodes(); elem_index++)
+        {
+            FixedG1GenerationalCellCycleModel* p_model = new FixedG1GenerationalCellCycleModel();
+
+            CellPtr p_cell(new Cell(p_wildtype, p_model));
+            if (elem_index%3 == 0)
+            {
+                p_cell->SetCellProliferativeType(p_stem);
+            }
+            else if (elem_index%3 == 1)
+            {
+                p_cell->SetCellProliferativeType(p_transit);
+            }
+            else
+            {
+                p_cell->SetCellProliferativeType(p_diff);
+            }
+
+            double birth_time = 0.0 - elem_index;
+            p_cell->SetBirthTime(birth_time);
+
+            rCells.push_back(p_cell);
+        }
+
+        boost::shared_ptr<AbstractCellProperty> p_apc1(CellPropertyRegistry::Instance()->Get<ApcOneHitCellMutationState>());
+        boost::shared_ptr<AbstractCellProperty> p_apc2(CellPropertyRegistry::Instance()->Get<ApcTwoHitCellMutationState>());
+        boost::shared_ptr<AbstractCellProperty> p_bcat1(CellPropertyRegistry::Instance()->Get<BetaCateninOneHitCellMutationState>());
+        boost::shared_ptr<AbstractCellProperty> p_apoptotic_state(CellPropertyRegistry::Instance()->Get<ApoptoticCellProperty>());
+        boost::shared_ptr<AbstractCellProperty> p_label(CellPropertyRegistry::Instance()->Get<CellLabel>());
+
+        rCells[0]->AddCellProperty(p_apoptotic_state);
+        rCells[1]->SetMutationState(p_apc1);
+        rCells[2]->SetMutationState(p_apc2);
+        rCells[3]->SetMutationState(p_bcat1);
+        rCells[4]->AddCellProperty(p_label);
+    }
+
+    /**
+     * Add the count and cell writers used by the tests of writing results to file.
+     *
+     * @param rCellPopulation  the cell population
+     */
+    void AddWritersForWriteResultsToFile(MeshBasedCellPopulation<2>& rCellPopulation)
+    {
+        rCellPopulation.AddCellPopulationCountWriter<CellMutationStatesCountWriter>();
+        rCellPopulation.AddCellPopulationCountWriter<CellProliferativeTypesCountWriter>();
+        rCellPopulation.AddCellPopulationCountWriter<CellProliferativePhasesCountWriter>();
+
+        rCellPopulation.AddCellWriter<CellAgesWriter>();
+        rCellPopulation.AddCellWriter<CellAncestorWriter>();
+        rCellPopulation.AddCellWriter<CellIdWriter>();
+        rCellPopulation.AddCellWriter<CellLabelWriter>();
+        rCellPopulation.AddCellWriter<CellLocationIndexWriter>();
+        rCellPopulation.AddCellWriter<CellMutationStatesWriter>();
+        rCellPopulation.AddCellWriter<CellProliferativePhasesWriter>();
+        rCellPopulation.AddCellWriter<CellProliferativeTypesWriter>();
+        rCellPopulation.AddCellWriter<CellVolumesWriter>();
+    }
+
+    /**
+     * Write results to file at the initial time and after one time step, as in a simulation.
+     *
+     * @param rCellPopulation  the cell population
+     * @param rOutputFileHandler  handler for the output directory
+     */
+    void WriteResultsForOneTimeStep(MeshBasedCellPopulation<2>& rCellPopulation, OutputFileHandler& rOutputFileHandler)
+    {
+        // This method is usually called by Update()
+        rCellPopulation.CreateVoronoiTessellation();
+
+        std::string output_directory = rOutputFileHandler.GetRelativePath();
+        rCellPopulation.OpenWritersFiles(rOutputFileHandler);
+        rCellPopulation.WriteResultsToFiles(output_directory);
+
+        SimulationTime::Instance()->IncrementTimeOneStep();
+        rCellPopulation.Update();
+
+        rCellPopulation.WriteResultsToFiles(output_directory);
+        rCellPopulation.CloseWritersFiles();
+    }
+
 public:
 
     // Test construction, accessors and Iterator
@@ -430,6 +536,83 @@ public:
         TS_ASSERT_EQUALS(cell_population.GetLocationIndexUsingCell(cell_population.rGetCells().back()), old_num_nodes);
     }
 
+    void TestLazyAndIncrementalVoronoiTessellation()
+    {
+        SimulationTime* p_simulation_time = SimulationTime::Instance();
+        p_simulation_time->SetEndTimeAndNumberOfTimeSteps(10.0, 2);
+
+        // Create a mesh whose element indices are kept across remeshes where possible
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/square_128_elements");
+        MutableMesh<2,2> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+        mesh.SetUseIncrementalReMesh(true);
+
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+
+        MeshBasedCellPopulation<2> cell_population(mesh, cells);
+        cell_population.AddPopulationWriter<VoronoiDataWriter>();
+
+        TS_ASSERT_EQUALS(cell_population.GetUseLazyVoronoiTessellation(), false);
+        TS_ASSERT_EQUALS(cell_population.GetUseIncrementalVoronoiTessellation(), false);
+        cell_population.SetUseLazyVoronoiTessellation(true);
+        cell_population.SetUseIncrementalVoronoiTessellation(true);
+        TS_ASSERT_EQUALS(cell_population.GetUseLazyVoronoiTessellation(), true);
+        TS_ASSERT_EQUALS(cell_population.GetUseIncrementalVoronoiTessellation(), true);
+
+        cell_population.Update();
+        cell_population.GetVoronoiTessellation();
+
+        c_vector<double,2> new_cell_location;
+        new_cell_location[0] = 0.31;
+        new_cell_location[1] = 0.27;
+        typedef FixedCentreBasedDivisionRule<2,2> FixedRule;
+        MAKE_PTR_ARGS(FixedRule, p_div_rule, (new_cell_location));
+        cell_population.SetCentreBasedDivisionRule(p_div_rule);
+
+        for (unsigned step=0; step<2; step++)
+        {
+            p_simulation_time->IncrementTimeOneStep();
+
+            // Move the interior nodes, and on the first step divide a cell
+            for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+            {
+                if (!mesh.GetNode(i)->IsBoundaryNode())
+                {
+                    c_vector<double,2>& r_location = mesh.GetNode(i)->rGetModifiableLocation();
+                    r_location[0] += 0.01*sin(1.7*i + step);
+                    r_location[1] += 0.01*cos(2.3*i + step);
+                }
+            }
+            if (step == 0)
+            {
+                MAKE_PTR(WildTypeCellMutationState, p_state);
+                MAKE_PTR(StemCellProliferativeType, p_stem_type);
+                CellPtr p_cell(new Cell(p_state, new FixedG1GenerationalCellCycleModel()));
+                p_cell->SetCellProliferativeType(p_stem_type);
+                p_cell->SetBirthTime(p_simulation_time->GetTime());
+                cell_population.AddCell(p_cell, cell_population.rGetCells().front());
+            }
+            cell_population.Update();
+
+            // The tessellation should match one constructed afresh from the remeshed mesh
+            VertexMesh<2,2>* p_tessellation = cell_population.GetVoronoiTessellation();
+            VertexMesh<2,2> fresh_tessellation(mesh);
+            TS_ASSERT_EQUALS(p_tessellation->GetNumElements(), fresh_tessellation.GetNumElements());
+            TS_ASSERT_EQUALS(p_tessellation->GetNumNodes(), fresh_tessellation.GetNumNodes());
+            for (unsigned elem_index=0; elem_index<fresh_tessellation.GetNumElements(); elem_index++)
+            {
+                unsigned node_index = fresh_tessellation.GetDelaunayNodeIndexCorrespondingToVoronoiElementIndex(elem_index);
+                TS_ASSERT_DELTA(cell_population.GetVolumeOfVoronoiElement(node_index),
+                                fresh_tessellation.GetVolumeOfElement(elem_index), 1e-12);
+                TS_ASSERT_DELTA(cell_population.GetSurfaceAreaOfVoronoiElement(node_index),
+                                fresh_tessellation.GetSurfaceAreaOfElement(elem_index), 1e-12);
+            }
+        }
+        TS_ASSERT_EQUALS(mesh.GetNumNodes(), 82u);
+    }
+
     /*
      * This test is for 2D meshes in 3D (i.e. surfaces)
      */
@@ -788,58 +971,9 @@ public:
     {
         EXIT_IF_PARALLEL;
 
-        // Set up SimulationTime (needed if VTK is used)
-        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 1);
-
-        // Resetting the maximum cell ID to zero (to account for previous tests)
-        CellId::ResetMaxCellId();
-
-        // Create a simple mesh-based cell population, comprising various cell types in various cell cycle phases
-        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/square_4_elements");
         MutableMesh<2,2> mesh;
-        mesh.ConstructFromMeshReader(mesh_reader);
-
-        boost::shared_ptr<AbstractCellProperty> p_stem(CellPropertyRegistry::Instance()->Get<StemCellProliferativeType>());
-        boost::shared_ptr<AbstractCellProperty> p_transit(CellPropertyRegistry::Instance()->Get<TransitCellProliferativeType>());
-        boost::shared_ptr<AbstractCellProperty> p_diff(CellPropertyRegistry::Instance()->Get<DifferentiatedCellProliferativeType>());
-        boost::shared_ptr<AbstractCellProperty> p_wildtype(CellPropertyRegistry::Instance()->Get<WildTypeCellMutationState>());
-
         std::vector<CellPtr> cells;
-        for (unsigned elem_index=0; elem_index<mesh.GetNumNodes(); elem_index++)
-        {
-            FixedG1GenerationalCellCycleModel* p_model = new FixedG1GenerationalCellCycleModel();
-
-            CellPtr p_cell(new Cell(p_wildtype, p_model));
-            if (elem_index%3 == 0)
-            {
-                p_cell->SetCellProliferativeType(p_stem);
-            }
-            else if (elem_index%3 == 1)
-            {
-                p_cell->SetCellProliferativeType(p_transit);
-            }
-            else
-            {
-                p_cell->SetCellProliferativeType(p_diff);
-            }
-
-            double birth_time = 0.0 - elem_index;
-            p_cell->SetBirthTime(birth_time);
-
-            cells.push_back(p_cell);
-        }
-
-        boost::shared_ptr<AbstractCellProperty> p_apc1(CellPropertyRegistry::Instance()->Get<ApcOneHitCellMutationState>());
-        boost::shared_ptr<AbstractCellProperty> p_apc2(CellPropertyRegistry::Instance()->Get<ApcTwoHitCellMutationState>());
-        boost::shared_ptr<AbstractCellProperty> p_bcat1(CellPropertyRegistry::Instance()->Get<BetaCateninOneHitCellMutationState>());
-        boost::shared_ptr<AbstractCellProperty> p_apoptotic_state(CellPropertyRegistry::Instance()->Get<ApoptoticCellProperty>());
-        boost::shared_ptr<AbstractCellProperty> p_label(CellPropertyRegistry::Instance()->Get<CellLabel>());
-
-        cells[0]->AddCellProperty(p_apoptotic_state);
-        cells[1]->SetMutationState(p_apc1);
-        cells[2]->SetMutationState(p_apc2);
-        cells[3]->SetMutationState(p_bcat1);
-        cells[4]->AddCellProperty(p_label);
+        CreateMeshAndCellsForWriteResultsToFile(mesh, cells);
 
         MeshBasedCellPopulation<2> cell_population(mesh, cells);
         cell_population.InitialiseCells();
@@ -873,34 +1007,10 @@ public:
 
         // Test set methods
         cell_population.SetOutputResultsForChasteVisualizer(true);
-        cell_population.AddCellPopulationCountWriter<CellMutationStatesCountWriter>();
-        cell_population.AddCellPopulationCountWriter<CellProliferativeTypesCountWriter>();
-        cell_population.AddCellPopulationCountWriter<CellProliferativePhasesCountWriter>();
-
-        cell_population.AddCellWriter<CellAgesWriter>();
-        cell_population.AddCellWriter<CellAncestorWriter>();
-        cell_population.AddCellWriter<CellIdWriter>();
-        cell_population.AddCellWriter<CellLabelWriter>();
-        cell_population.AddCellWriter<CellLocationIndexWriter>();
-        cell_population.AddCellWriter<CellMutationStatesWriter>();
-        cell_population.AddCellWriter<CellProliferativePhasesWriter>();
-        cell_population.AddCellWriter<CellProliferativeTypesWriter>();
-        cell_population.AddCellWriter<CellVolumesWriter>();
-
-        // This method is usually called by Update()
-        cell_population.CreateVoronoiTessellation();
-
-        std::string output_directory = "TestMeshBasedCellPopulationWriteResultsToFile";
-        OutputFileHandler output_file_handler(output_directory, false);
+        AddWritersForWriteResultsToFile(cell_population);
 
-        cell_population.OpenWritersFiles(output_file_handler);
-        cell_population.WriteResultsToFiles(output_directory);
-
-        SimulationTime::Instance()->IncrementTimeOneStep();
-        cell_population.Update();
-
-        cell_population.WriteResultsToFiles(output_directory);
-        cell_population.CloseWritersFiles();
+        OutputFileHandler output_file_handler("TestMeshBasedCellPopulationWriteResultsToFile", false);
+        WriteResultsForOneTimeStep(cell_population, output_file_handler);
 
         // Test the GetCellMutationStateCount function
         std::vector<unsigned> cell_mutation_states = cell_population.GetCellMutationStateCount();
@@ -1123,6 +1233,64 @@ public:
  #endif //CHASTE_VTK
     }
 
+    void TestWriteResultsToFileWithBufferedOutput()
+    {
+        EXIT_IF_PARALLEL;
+
+        // Set up the same cell population and writers as in TestMeshBasedCellPopulationWriteResultsToFile
+        MutableMesh<2,2> mesh;
+        std::vector<CellPtr> cells;
+        CreateMeshAndCellsForWriteResultsToFile(mesh, cells);
+
+        MeshBasedCellPopulation<2> cell_population(mesh, cells);
+        cell_population.InitialiseCells();
+        cell_population.SetCellAncestorsToLocationIndices();
+
+        // CellIdWriter is added twice, as in TestMeshBasedCellPopulationWriteResultsToFile, so loggedcell.dat has two rows per time
+        cell_population.AddPopulationWriter<VoronoiDataWriter>();
+        cell_population.AddCellWriter<CellIdWriter>();
+        AddWritersForWriteResultsToFile(cell_population);
+        cell_population.AddCellPopulationEventWriter<CellDivisionLocationsWriter>();
+
+        // Test set/get methods
+        TS_ASSERT_EQUALS(cell_population.GetUseBufferedWriterOutput(), false);
+        cell_population.SetUseBufferedWriterOutput(true);
+        TS_ASSERT_EQUALS(cell_population.GetUseBufferedWriterOutput(), true);
+
+        std::string output_directory = "TestWriteResultsToFileWithBufferedOutput";
+        OutputFileHandler output_file_handler(output_directory, false);
+        WriteResultsForOneTimeStep(cell_population, output_file_handler);
+
+        // The files should be identical to those written without buffering
+        std::vector<std::string> files_to_compare;
+        files_to_compare.push_back("results.viznodes");
+        files_to_compare.push_back("results.vizelements");
+        files_to_compare.push_back("voronoi.dat");
+        files_to_compare.push_back("cellages.dat");
+        files_to_compare.push_back("results.vizancestors");
+        files_to_compare.push_back("loggedcell.dat");
+        files_to_compare.push_back("results.vizlabels");
+        files_to_compare.push_back("results.vizlocationindices");
+        files_to_compare.push_back("results.vizmutationstates");
+        files_to_compare.push_back("results.vizcellphases");
+        files_to_compare.push_back("results.vizcelltypes");
+        files_to_compare.push_back("cellareas.dat");
+        files_to_compare.push_back("cellmutationstates.dat");
+        files_to_compare.push_back("cellcyclephases.dat");
+        files_to_compare.push_back("celltypes.dat");
+        files_to_compare.push_back("divisions.dat");
+
+        std::string results_dir = output_file_handler.GetOutputDirectoryFullPath();
+        for (unsigned i=0; i<files_to_compare.size(); i++)
+        {
+            FileComparison comparer(results_dir + files_to_compare[i],"cell_based/test/data/TestMeshBasedCellPopulationWriteResultsToFile/" + files_to_compare[i]);
+            TS_ASSERT(comparer.CompareFiles());
+        }
+
+        // Writing after the files have been closed reverts to opening them for each write
+        TS_ASSERT_THROWS_NOTHING(cell_population.WriteResultsToFiles(output_directory));
+    }
+
     void TestCellPopulationWritersIn3d()
     {
         // Cannot write cell populations in parallel
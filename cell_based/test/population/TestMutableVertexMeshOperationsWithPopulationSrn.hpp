@@ -428,17 +428,23 @@ public:
         cell_population.RemoveDeadCells();
         vertex_mesh.RemoveDeletedNodesAndElements(element_map);
 
-        std::map<Cell*, unsigned> old_map = cell_population.mCellLocationMap;
+        std::vector<unsigned> old_elem_indices;
+        for (std::list<CellPtr>::iterator cell_iter = cell_population.mCells.begin();
+                cell_iter != cell_population.mCells.end();
+                ++cell_iter)
+        {
+            old_elem_indices.push_back(cell_population.GetLocationIndexUsingCell(*cell_iter));
+        }
 
-        cell_population.mCellLocationMap.clear();
-        cell_population.mLocationCellMap.clear();
+        cell_population.mCellLocationIndex.Clear();
 
+        std::vector<unsigned>::iterator old_index_iter = old_elem_indices.begin();
         for (std::list<CellPtr>::iterator cell_iter = cell_population.mCells.begin();
                 cell_iter != cell_population.mCells.end();
-                ++cell_iter)
+                ++cell_iter, ++old_index_iter)
         {
             // The cell vector should only ever contain living cells
-            unsigned old_elem_index = old_map[(*cell_iter).get()];
+            unsigned old_elem_index = *old_index_iter;
             assert(!element_map.IsDeleted(old_elem_index));
 
             unsigned new_elem_index = element_map.GetNewIndex(old_elem_index);
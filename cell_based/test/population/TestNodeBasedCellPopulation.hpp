@@ -554,6 +554,79 @@ public:
         }
     }
 
+    void TestVerletList()
+    {
+        EXIT_IF_PARALLEL; // The Verlet list is rebuilt on every call to Update() in parallel
+
+        // Create a mesh with three nodes in a line and one further away
+        std::vector<Node<2>*> nodes;
+        nodes.push_back(new Node<2>(0, false, 0.0, 0.0));
+        nodes.push_back(new Node<2>(1, false, 0.28, 0.0));
+        nodes.push_back(new Node<2>(2, false, 0.6, 0.0));
+        nodes.push_back(new Node<2>(3, false, 0.6, 0.6));
+
+        NodesOnlyMesh<2> mesh;
+        mesh.ConstructNodesWithoutMesh(nodes, 0.2);
+
+        // Create cells
+        std::vector<CellPtr> cells;
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasic(cells, mesh.GetNumNodes());
+
+        // Create a cell population
+        NodeBasedCellPopulation<2> node_based_cell_population(mesh, cells);
+
+        // Test the default values and setting the member variables
+        TS_ASSERT_EQUALS(node_based_cell_population.GetUseVerletList(), false);
+        TS_ASSERT_DELTA(node_based_cell_population.GetVerletSkin(), 0.25, 1e-12);
+        TS_ASSERT_THROWS_THIS(node_based_cell_population.SetVerletSkin(0.0), "The Verlet skin distance must be positive");
+
+        node_based_cell_population.SetVerletSkin(0.1);
+        node_based_cell_population.SetUseVerletList();
+        TS_ASSERT_EQUALS(node_based_cell_population.GetUseVerletList(), true);
+        TS_ASSERT_DELTA(node_based_cell_population.GetVerletSkin(), 0.1, 1e-12);
+        TS_ASSERT_DELTA(mesh.GetNeighbourListSkin(), 0.1, 1e-12);
+        TS_ASSERT_DELTA(node_based_cell_population.GetMechanicsCutOffLength(), 0.2, 1e-12);
+
+        // The Verlet list contains the pairs within the cut-off length plus the skin
+        node_based_cell_population.Update();
+        std::vector<std::pair<Node<2>*, Node<2>*> >& r_node_pairs = node_based_cell_population.rGetNodePairs();
+        TS_ASSERT_EQUALS(r_node_pairs.size(), 1u);
+        TS_ASSERT_EQUALS(std::min(r_node_pairs[0].first->GetIndex(), r_node_pairs[0].second->GetIndex()), 0u);
+        TS_ASSERT_EQUALS(std::max(r_node_pairs[0].first->GetIndex(), r_node_pairs[0].second->GetIndex()), 1u);
+
+        // Moving a node by less than half the skin does not cause the list to be rebuilt...
+        mesh.GetNode(1)->rGetModifiableLocation()[0] = 0.32;
+        node_based_cell_population.Update(false);
+        TS_ASSERT_EQUALS(r_node_pairs.size(), 1u);
+        TS_ASSERT_EQUALS(std::max(r_node_pairs[0].first->GetIndex(), r_node_pairs[0].second->GetIndex()), 1u);
+
+        // ...but moving it by more than half the skin does
+        mesh.GetNode(1)->rGetModifiableLocation()[0] = 0.34;
+        node_based_cell_population.Update(false);
+        TS_ASSERT_EQUALS(r_node_pairs.size(), 1u);
+        TS_ASSERT_EQUALS(std::min(r_node_pairs[0].first->GetIndex(), r_node_pairs[0].second->GetIndex()), 1u);
+        TS_ASSERT_EQUALS(std::max(r_node_pairs[0].first->GetIndex(), r_node_pairs[0].second->GetIndex()), 2u);
+
+        // Births or deaths always cause the list to be rebuilt
+        mesh.GetNode(2)->rGetModifiableLocation()[0] = 0.645;
+        node_based_cell_population.Update(false);
+        TS_ASSERT_EQUALS(r_node_pairs.size(), 1u);
+        node_based_cell_population.Update(true);
+        TS_ASSERT_EQUALS(r_node_pairs.size(), 0u);
+
+        // Switching off the Verlet list restores the box width
+        node_based_cell_population.SetUseVerletList(false);
+        TS_ASSERT_EQUALS(node_based_cell_population.GetUseVerletList(), false);
+        TS_ASSERT_DELTA(mesh.GetNeighbourListSkin(), 0.0, 1e-12);
+
+        // Tidy up
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
+
     void TestAddAndRemoveAndAddWithOutRemovingDeletedNodesSmallCutOff()
     {
         SimulationTime* p_simulation_time = SimulationTime::Instance();
@@ -1510,6 +1583,9 @@ public:
             }
 
             p_cell_population->SetUseVariableRadii(true);
+            p_cell_population->SetUseVerletList(true);
+            p_cell_population->SetVerletSkin(0.3);
+            mesh.SetUseFlatCellList(true);
 
             // Create an output archive
             ArchiveOpener<boost::archive::text_oarchive, std::ofstream> arch_opener(archive_dir, archive_file);
@@ -1575,6 +1651,11 @@ public:
             // Check the member variables have been restored
             TS_ASSERT_DELTA(p_cell_population->GetMechanicsCutOffLength(), 1.5, 1e-9);
             TS_ASSERT(p_cell_population->GetUseVariableRadii());
+            TS_ASSERT(p_cell_population->GetUseVerletList());
+            TS_ASSERT_DELTA(p_cell_population->GetVerletSkin(), 0.3, 1e-9);
+            NodesOnlyMesh<2>& r_mesh = static_cast<NodesOnlyMesh<2>&>(p_cell_population->rGetMesh());
+            TS_ASSERT_DELTA(r_mesh.GetNeighbourListSkin(), 0.3, 1e-9);
+            TS_ASSERT(r_mesh.GetUseFlatCellList());
 
             // Tidy up
             delete p_cell_population;
@@ -286,6 +286,7 @@ public:
 
         TS_ASSERT_THROWS_NOTHING(mpNodeBasedCellPopulation->GetCellUsingLocationIndex(10));
         TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->GetCellUsingLocationIndex(10), p_cell);
+        TS_ASSERT_EQUALS(mpNodeBasedCellPopulation->rGetCellUsingLocationIndex(10), p_cell);
     }
 
     void TestNodeBasedCellPopulationOutputInParallel()
@@ -393,6 +394,102 @@ public:
             delete nodes[i];
         }
     }
+
+    void TestBufferedOutputMatchesRoundRobinOutputInParallel()
+    {
+        SimulationTime::Instance()->SetEndTimeAndNumberOfTimeSteps(1.0, 1);
+
+        std::vector<Node<2>* > nodes;
+        for (unsigned i=0; i<5; i++)
+        {
+            nodes.push_back(new Node<2>(i, false, 0.0, 0.75*i));
+        }
+
+        // Write the same cell population with round-robin and with buffered output
+        NodesOnlyMesh<2> round_robin_mesh;
+        round_robin_mesh.ConstructNodesWithoutMesh(nodes, 1.5);
+        NodesOnlyMesh<2> buffered_mesh;
+        buffered_mesh.ConstructNodesWithoutMesh(nodes, 1.5);
+
+        // Each population takes ownership of the cell properties created for its cells, so create them in turn
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        std::vector<CellPtr> round_robin_cells;
+        CellId::ResetMaxCellId();
+        cells_generator.GenerateBasic(round_robin_cells, round_robin_mesh.GetNumNodes());
+        for (unsigned i=0; i<round_robin_cells.size(); i++)
+        {
+            round_robin_cells[i]->SetBirthTime(-1.0*i);
+        }
+        NodeBasedCellPopulation<2> round_robin_population(round_robin_mesh, round_robin_cells);
+
+        std::vector<CellPtr> buffered_cells;
+        CellId::ResetMaxCellId();
+        cells_generator.GenerateBasic(buffered_cells, buffered_mesh.GetNumNodes());
+        for (unsigned i=0; i<buffered_cells.size(); i++)
+        {
+            buffered_cells[i]->SetBirthTime(-1.0*i);
+        }
+        NodeBasedCellPopulation<2> buffered_population(buffered_mesh, buffered_cells);
+        buffered_population.SetUseBufferedWriterOutput(true);
+
+        std::vector<NodeBasedCellPopulation<2>*> populations;
+        populations.push_back(&round_robin_population);
+        populations.push_back(&buffered_population);
+        std::vector<std::string> output_directories;
+        output_directories.push_back("TestNodeBasedCellPopulationRoundRobinOutput");
+        output_directories.push_back("TestNodeBasedCellPopulationBufferedOutput");
+
+        for (unsigned p=0; p<populations.size(); p++)
+        {
+            populations[p]->Update();
+            populations[p]->AddCellWriter<CellIdWriter>();
+            populations[p]->AddCellWriter<CellAgesWriter>();
+            populations[p]->AddCellWriter<CellProliferativePhasesWriter>();
+            populations[p]->AddCellWriter<CellVolumesWriter>();
+            populations[p]->AddCellWriter<CellAncestorWriter>();
+            populations[p]->AddCellPopulationCountWriter<CellMutationStatesCountWriter>();
+            populations[p]->AddCellPopulationCountWriter<CellProliferativeTypesCountWriter>();
+
+            OutputFileHandler output_file_handler(output_directories[p]);
+            populations[p]->OpenWritersFiles(output_file_handler);
+            populations[p]->WriteResultsToFiles(output_directories[p]);
+        }
+
+        SimulationTime::Instance()->IncrementTimeOneStep();
+        for (unsigned p=0; p<populations.size(); p++)
+        {
+            populations[p]->Update();
+            populations[p]->WriteResultsToFiles(output_directories[p]);
+            populations[p]->CloseWritersFiles();
+        }
+
+        // Every process's data is gathered into the files in rank order, just as the round robin writes it
+        std::vector<std::string> files_to_compare;
+        files_to_compare.push_back("results.viznodes");
+        files_to_compare.push_back("results.vizcelltypes");
+        files_to_compare.push_back("loggedcell.dat");
+        files_to_compare.push_back("cellages.dat");
+        files_to_compare.push_back("results.vizcellphases");
+        files_to_compare.push_back("cellareas.dat");
+        files_to_compare.push_back("results.vizancestors");
+        files_to_compare.push_back("cellmutationstates.dat");
+        files_to_compare.push_back("celltypes.dat");
+
+        FileFinder round_robin_dir(output_directories[0], RelativeTo::ChasteTestOutput);
+        FileFinder buffered_dir(output_directories[1], RelativeTo::ChasteTestOutput);
+        for (unsigned i=0; i<files_to_compare.size(); i++)
+        {
+            FileComparison comparer(FileFinder(files_to_compare[i], buffered_dir), FileFinder(files_to_compare[i], round_robin_dir));
+            comparer.SetIgnoreCommentLines(false);
+            TS_ASSERT(comparer.CompareFiles());
+        }
+
+        // Avoid memory leak
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
 };
 
 #endif /*TESTNODEBASEDCELLPOPULATIONPARALLELMETHODS_HPP_*/
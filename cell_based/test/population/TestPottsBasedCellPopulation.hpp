@@ -44,6 +44,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "CellsGenerator.hpp"
 #include "PottsBasedCellPopulation.hpp"
 #include "VolumeConstraintPottsUpdateRule.hpp"
+#include "AdhesionPottsUpdateRule.hpp"
+#include "SurfaceAreaConstraintPottsUpdateRule.hpp"
+#include "ThreadingTools.hpp"
 #include "PottsMeshGenerator.hpp"
 #include "FixedG1GenerationalCellCycleModel.hpp"
 #include "AbstractCellBasedTestSuite.hpp"
@@ -422,6 +425,138 @@ public:
     }
 
     ///\todo implement this test (#1666)
+    void TestCheckerboardSublattices()
+    {
+        // In 2D a regular lattice should be split into four sublattices
+        {
+            PottsMeshGenerator<2> generator(10, 2, 3, 8, 2, 3);
+            boost::shared_ptr<PottsMesh<2> > p_mesh = generator.GetMesh();
+
+            std::vector<CellPtr> cells;
+            CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasic(cells, p_mesh->GetNumElements());
+            PottsBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+            cell_population.SetUpCheckerboardSweep();
+            TS_ASSERT_EQUALS(cell_population.mSublatticeOffsets.size(), 5u);
+            TS_ASSERT_EQUALS(cell_population.mSublatticeNodeIndices.size(), p_mesh->GetNumNodes());
+
+            // The flattened neighbourhoods should match those stored by the mesh
+            for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+            {
+                std::set<unsigned> neighbours = p_mesh->GetMooreNeighbouringNodeIndices(node_index);
+                std::vector<unsigned> flat_neighbours(cell_population.mFlatMooreNeighbourIndices.begin() + cell_population.mFlatMooreNeighbourOffsets[node_index],
+                                                      cell_population.mFlatMooreNeighbourIndices.begin() + cell_population.mFlatMooreNeighbourOffsets[node_index+1]);
+                TS_ASSERT(std::equal(neighbours.begin(), neighbours.end(), flat_neighbours.begin()));
+                TS_ASSERT_EQUALS(neighbours.size(), flat_neighbours.size());
+            }
+
+            // No two nodes of the same sublattice should be Moore neighbours
+            for (unsigned colour=0; colour<4; colour++)
+            {
+                std::set<unsigned> sublattice(cell_population.mSublatticeNodeIndices.begin() + cell_population.mSublatticeOffsets[colour],
+                                              cell_population.mSublatticeNodeIndices.begin() + cell_population.mSublatticeOffsets[colour+1]);
+                for (std::set<unsigned>::iterator iter = sublattice.begin(); iter != sublattice.end(); ++iter)
+                {
+                    std::set<unsigned> neighbours = p_mesh->GetMooreNeighbouringNodeIndices(*iter);
+                    for (std::set<unsigned>::iterator neighbour_iter = neighbours.begin(); neighbour_iter != neighbours.end(); ++neighbour_iter)
+                    {
+                        TS_ASSERT_EQUALS(sublattice.count(*neighbour_iter), 0u);
+                    }
+                }
+            }
+        }
+
+        // In 3D there should be eight sublattices
+        {
+            PottsMeshGenerator<3> generator(6, 2, 2, 6, 2, 2, 6, 2, 2);
+            boost::shared_ptr<PottsMesh<3> > p_mesh = generator.GetMesh();
+
+            std::vector<CellPtr> cells;
+            CellsGenerator<FixedG1GenerationalCellCycleModel, 3> cells_generator;
+            cells_generator.GenerateBasic(cells, p_mesh->GetNumElements());
+            PottsBasedCellPopulation<3> cell_population(*p_mesh, cells);
+
+            cell_population.SetUpCheckerboardSweep();
+            TS_ASSERT_EQUALS(cell_population.mSublatticeOffsets.size(), 9u);
+            TS_ASSERT_EQUALS(cell_population.mSublatticeNodeIndices.size(), p_mesh->GetNumNodes());
+        }
+    }
+
+    void TestUpdateCellLocationsWithCheckerboardSweep()
+    {
+        std::vector<std::vector<unsigned> > node_elements_for_each_run;
+
+        unsigned max_num_threads = ThreadingTools::GetMaxNumThreads();
+        for (unsigned run=0; run<2; run++)
+        {
+            RandomNumberGenerator::Instance()->Reseed(0);
+
+            PottsMeshGenerator<2> generator(20, 3, 4, 20, 3, 4);
+            boost::shared_ptr<PottsMesh<2> > p_mesh = generator.GetMesh();
+
+            std::vector<CellPtr> cells;
+            CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasic(cells, p_mesh->GetNumElements());
+            PottsBasedCellPopulation<2> cell_population(*p_mesh, cells);
+
+            TS_ASSERT_EQUALS(cell_population.GetUseCheckerboardSweep(), false);
+            cell_population.SetUseCheckerboardSweep(true);
+            TS_ASSERT_EQUALS(cell_population.GetUseCheckerboardSweep(), true);
+            cell_population.SetTemperature(10.0);
+            cell_population.SetNumSweepsPerTimestep(2);
+
+            MAKE_PTR(VolumeConstraintPottsUpdateRule<2>, p_volume_constraint_update_rule);
+            cell_population.AddUpdateRule(p_volume_constraint_update_rule);
+            MAKE_PTR(SurfaceAreaConstraintPottsUpdateRule<2>, p_surface_area_update_rule);
+            cell_population.AddUpdateRule(p_surface_area_update_rule);
+            MAKE_PTR(AdhesionPottsUpdateRule<2>, p_adhesion_update_rule);
+            cell_population.AddUpdateRule(p_adhesion_update_rule);
+
+            std::vector<unsigned> initial_num_element_nodes;
+            for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+            {
+                initial_num_element_nodes.push_back(p_mesh->GetElement(elem_index)->GetNumNodes());
+            }
+
+            // The first run uses one thread and the second as many as are available
+            ThreadingTools::SetNumThreads(run == 0 ? 1 : max_num_threads);
+            for (unsigned step=0; step<5; step++)
+            {
+                cell_population.UpdateCellLocations(1.0);
+            }
+
+            // Each node should be in at most one element, and each element should still have nodes
+            std::vector<unsigned> node_elements(p_mesh->GetNumNodes(), UINT_MAX);
+            bool lattice_has_changed = false;
+            for (unsigned elem_index=0; elem_index<p_mesh->GetNumElements(); elem_index++)
+            {
+                PottsElement<2>* p_element = p_mesh->GetElement(elem_index);
+                TS_ASSERT_LESS_THAN(0u, p_element->GetNumNodes());
+                lattice_has_changed = lattice_has_changed || (p_element->GetNumNodes() != initial_num_element_nodes[elem_index]);
+                for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+                {
+                    unsigned node_index = p_element->GetNodeGlobalIndex(local_index);
+                    TS_ASSERT_EQUALS(node_elements[node_index], UINT_MAX);
+                    node_elements[node_index] = elem_index;
+                }
+            }
+            for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+            {
+                TS_ASSERT_LESS_THAN_EQUALS(p_mesh->GetNode(node_index)->GetNumContainingElements(), 1u);
+            }
+
+            // At this temperature the lattice should have evolved from its initial configuration
+            TS_ASSERT(lattice_has_changed);
+
+            node_elements_for_each_run.push_back(node_elements);
+        }
+        ThreadingTools::Reset();
+
+        // The results should not depend on the number of threads
+        TS_ASSERT(node_elements_for_each_run[0] == node_elements_for_each_run[1]);
+    }
+
 //    void TestVoronoiMethods()
 //    {
 //        // Create a simple 2D PottsMesh
@@ -679,6 +814,7 @@ public:
             static_cast<PottsBasedCellPopulation<2>*>(p_cell_population)->SetNumSweepsPerTimestep(3);
             static_cast<PottsBasedCellPopulation<2>*>(p_cell_population)->SetUpdateNodesInRandomOrder(false);
             static_cast<PottsBasedCellPopulation<2>*>(p_cell_population)->SetIterateRandomlyOverUpdateRuleCollection(true);
+            static_cast<PottsBasedCellPopulation<2>*>(p_cell_population)->SetUseCheckerboardSweep(true);
 
             // Archive the cell population
             (*p_arch) << static_cast<const SimulationTime&>(*p_simulation_time);
@@ -714,6 +850,7 @@ public:
             TS_ASSERT_EQUALS(p_static_population->GetNumSweepsPerTimestep(), 3u);
             TS_ASSERT_EQUALS(p_static_population->GetUpdateNodesInRandomOrder(), false);
             TS_ASSERT_EQUALS(p_static_population->GetIterateRandomlyOverUpdateRuleCollection(), true);
+            TS_ASSERT_EQUALS(p_static_population->GetUseCheckerboardSweep(), true);
 
             // Test that the update rule has been archived correctly
             std::vector<boost::shared_ptr<AbstractUpdateRule<2> > > update_rule_collection = p_static_population->GetUpdateRuleCollection();
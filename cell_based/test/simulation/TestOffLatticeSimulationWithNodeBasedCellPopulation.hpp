@@ -236,6 +236,71 @@ public:
         }
     }
 
+    void TestVerletListGivesSameResultAsRebuildingEveryStep()
+    {
+        EXIT_IF_PARALLEL; // Cant access cells with index loop on multiple processors.
+
+        // Create a simple mesh
+        std::vector<Node<2>*> nodes = GenerateMesh(6, 6);
+
+        // Run the same simulation, including cell divisions, without and with a Verlet list
+        std::vector<std::vector<c_vector<double, 2> > > final_locations(2);
+        for (unsigned use_verlet_list=0; use_verlet_list<2; use_verlet_list++)
+        {
+            // Reset the singletons
+            SimulationTime::Instance()->Destroy();
+            SimulationTime::Instance()->SetStartTime(0.0);
+            RandomNumberGenerator::Instance()->Reseed(0);
+
+            NodesOnlyMesh<2> mesh;
+            mesh.ConstructNodesWithoutMesh(nodes, 1.5);
+
+            std::vector<CellPtr> cells;
+            CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasicRandom(cells, mesh.GetNumNodes());
+
+            NodeBasedCellPopulation<2> cell_population(mesh, cells);
+            if (use_verlet_list == 1)
+            {
+                cell_population.SetVerletSkin(0.3);
+                cell_population.SetUseVerletList();
+                TS_ASSERT_DELTA(mesh.GetNeighbourListSkin(), 0.3, 1e-12);
+            }
+
+            OffLatticeSimulation<2> simulator(cell_population);
+            simulator.SetOutputDirectory("TestOffLatticeSimulationWithNodeBasedCellPopulationVerletList");
+            simulator.SetEndTime(10.0);
+
+            MAKE_PTR(GeneralisedLinearSpringForce<2>, p_linear_force);
+            p_linear_force->SetCutOffLength(1.5);
+            simulator.AddForce(p_linear_force);
+
+            simulator.Solve();
+
+            for (unsigned i=0; i<cell_population.GetNumNodes(); i++)
+            {
+                final_locations[use_verlet_list].push_back(cell_population.GetNode(i)->rGetLocation());
+            }
+        }
+
+        // The forces, and hence the node locations, should not depend on the Verlet list
+        TS_ASSERT_LESS_THAN(nodes.size(), final_locations[0].size());
+        TS_ASSERT_EQUALS(final_locations[1].size(), final_locations[0].size());
+        for (unsigned i=0; i<final_locations[0].size(); i++)
+        {
+            for (unsigned d=0; d<2; d++)
+            {
+                TS_ASSERT_DELTA(final_locations[1][i][d], final_locations[0][i][d], 1e-8);
+            }
+        }
+
+        // Tidy up
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
+
     /**
      * Create a simulation of a NodeBasedCellPopulation with a Cylindrical2dNodesOnlyMesh
      * to test periodicity.
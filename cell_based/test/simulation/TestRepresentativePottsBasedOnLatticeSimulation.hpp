@@ -47,6 +47,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "VolumeConstraintPottsUpdateRule.hpp"
 #include "AdhesionPottsUpdateRule.hpp"
 #include "DifferentialAdhesionPottsUpdateRule.hpp"
+#include "SurfaceAreaConstraintPottsUpdateRule.hpp"
 #include "AbstractCellBasedTestSuite.hpp"
 #include "PottsMeshGenerator.hpp"
 #include "WildTypeCellMutationState.hpp"
@@ -61,8 +62,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PetscSetupAndFinalize.hpp"
 
 /**
- * This class consists of a single test - a 2D Potts-based cell population
- * simulation of 100 cells with differential adhesion and no birth or death.
+ * This class consists of 2D Potts-based cell population simulations of 100 cells
+ * with differential adhesion and no birth or death, with and without a surface
+ * area constraint.
  *
  * This test is used for profiling, to establish the run time
  * variation as the code is developed.
@@ -125,6 +127,63 @@ public:
         // Run simulation
         simulator.Solve();
     }
+
+    /*
+     * As above, with a surface area constraint, whose Hamiltonian contribution
+     * depends on the surface areas of the elements either side of each trial copy.
+     */
+    void TestPottsMonolayerCellSortingWithSurfaceAreaConstraint()
+    {
+        EXIT_IF_PARALLEL;
+
+        PottsMeshGenerator<2> generator(60, 10, 4, 60, 10, 4);
+        boost::shared_ptr<PottsMesh<2> > p_mesh = generator.GetMesh();
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(DifferentiatedCellProliferativeType, p_diff_type);
+        CellsGenerator<FixedG1GenerationalCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, p_mesh->GetNumElements(), p_diff_type);
+
+        MAKE_PTR(CellLabel, p_label);
+
+        PottsBasedCellPopulation<2> cell_population(*p_mesh, cells);
+        cell_population.AddCellPopulationCountWriter<CellMutationStatesCountWriter>();
+
+        for (AbstractCellPopulation<2>::Iterator cell_iter = cell_population.Begin();
+             cell_iter != cell_population.End();
+             ++cell_iter)
+        {
+            if (RandomNumberGenerator::Instance()->ranf() < 0.5)
+            {
+                (*cell_iter)->AddCellProperty(p_label);
+            }
+        }
+
+        OnLatticeSimulation<2> simulator(cell_population);
+        simulator.SetOutputDirectory("TestRepresentativePottsBasedSimulationWithSurfaceAreaForProfiling");
+        simulator.SetDt(0.1);
+        simulator.SetEndTime(10);
+
+        MAKE_PTR(VolumeConstraintPottsUpdateRule<2>, p_volume_constraint_update_rule);
+        p_volume_constraint_update_rule->SetMatureCellTargetVolume(16);
+        p_volume_constraint_update_rule->SetDeformationEnergyParameter(0.2);
+        simulator.AddUpdateRule(p_volume_constraint_update_rule);
+
+        MAKE_PTR(SurfaceAreaConstraintPottsUpdateRule<2>, p_surface_area_update_rule);
+        p_surface_area_update_rule->SetMatureCellTargetSurfaceArea(16);
+        p_surface_area_update_rule->SetDeformationEnergyParameter(0.1);
+        simulator.AddUpdateRule(p_surface_area_update_rule);
+
+        MAKE_PTR(DifferentialAdhesionPottsUpdateRule<2>, p_differential_adhesion_update_rule);
+        p_differential_adhesion_update_rule->SetLabelledCellLabelledCellAdhesionEnergyParameter(0.16);
+        p_differential_adhesion_update_rule->SetLabelledCellCellAdhesionEnergyParameter(0.11);
+        p_differential_adhesion_update_rule->SetCellCellAdhesionEnergyParameter(0.02);
+        p_differential_adhesion_update_rule->SetLabelledCellBoundaryAdhesionEnergyParameter(0.16);
+        p_differential_adhesion_update_rule->SetCellBoundaryAdhesionEnergyParameter(0.16);
+        simulator.AddUpdateRule(p_differential_adhesion_update_rule);
+
+        simulator.Solve();
+    }
 };
 
 #endif /*TESTREPRESENTATIVEPOTTSBASEDONLATTICESIMULATION_HPP_*/
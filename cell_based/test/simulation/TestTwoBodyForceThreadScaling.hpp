@@ -0,0 +1,140 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTTWOBODYFORCETHREADSCALING_HPP_
+#define TESTTWOBODYFORCETHREADSCALING_HPP_
+
+#include <cxxtest/TestSuite.h>
+#include <algorithm>
+
+// Must be included before other cell_based headers
+#include "CellBasedSimulationArchiver.hpp"
+
+#include "AbstractCellBasedWithTimingsTestSuite.hpp"
+#include "GeneralisedLinearSpringForce.hpp"
+#include "CellsGenerator.hpp"
+#include "NodeBasedCellPopulation.hpp"
+#include "UniformCellCycleModel.hpp"
+#include "TransitCellProliferativeType.hpp"
+#include "ThreadingTools.hpp"
+#include "Timer.hpp"
+#include "SmartPointers.hpp"
+#include "FakePetscSetup.hpp"
+
+/**
+ * This class consists of a single test, which times the calculation of
+ * GeneralisedLinearSpringForce on a large 3D node-based cell population
+ * using 1, 2, 4, ..., 64 threads (limited by the number of threads that
+ * OpenMP makes available on this machine).
+ *
+ * This test is used for profiling the threaded force calculation. Unless
+ * Chaste is configured with Chaste_USE_OPENMP=ON, only one thread is timed.
+ */
+class TestTwoBodyForceThreadScaling : public AbstractCellBasedWithTimingsTestSuite
+{
+public:
+
+    void TestGeneralisedLinearSpringForceThreadScaling()
+    {
+        // Create a 3D population of 30^3 cells on a cubic lattice
+        unsigned cells_across = 30;
+        std::vector<Node<3>*> nodes;
+        unsigned index = 0;
+        for (unsigned i=0; i<cells_across; i++)
+        {
+            for (unsigned j=0; j<cells_across; j++)
+            {
+                for (unsigned k=0; k<cells_across; k++)
+                {
+                    nodes.push_back(new Node<3>(index, false, 0.9*i, 0.9*j, 0.9*k));
+                    index++;
+                }
+            }
+        }
+
+        NodesOnlyMesh<3> mesh;
+        mesh.ConstructNodesWithoutMesh(nodes, 1.5);
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(TransitCellProliferativeType, p_transit_type);
+        CellsGenerator<UniformCellCycleModel, 3> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, mesh.GetNumNodes(), p_transit_type);
+
+        NodeBasedCellPopulation<3> cell_population(mesh, cells);
+        cell_population.Update();
+
+        GeneralisedLinearSpringForce<3> force;
+        force.SetCutOffLength(1.5);
+
+        std::cout << "Number of node pairs: " << cell_population.rGetNodePairs().size() << "\n";
+
+        unsigned num_repeats = 20;
+        unsigned max_num_threads = std::min(64u, ThreadingTools::GetMaxNumThreads());
+        double serial_time = 0.0;
+        for (unsigned num_threads=1; num_threads<=max_num_threads; num_threads*=2)
+        {
+            ThreadingTools::SetNumThreads(num_threads);
+
+            double start_time = Timer::GetWallTime();
+            for (unsigned repeat=0; repeat<num_repeats; repeat++)
+            {
+                for (AbstractMesh<3,3>::NodeIterator node_iter = mesh.GetNodeIteratorBegin();
+                     node_iter != mesh.GetNodeIteratorEnd();
+                     ++node_iter)
+                {
+                    node_iter->ClearAppliedForce();
+                }
+                force.AddForceContribution(cell_population);
+            }
+            double elapsed_time = (Timer::GetWallTime() - start_time)/num_repeats;
+
+            if (num_threads == 1)
+            {
+                serial_time = elapsed_time;
+            }
+            std::cout << "Threads: " << num_threads << "\ttime per force calculation: " << elapsed_time
+                      << "s\tspeedup: " << serial_time/elapsed_time << "\n";
+        }
+
+        ThreadingTools::Reset();
+
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
+};
+
+#endif /*TESTTWOBODYFORCETHREADSCALING_HPP_*/
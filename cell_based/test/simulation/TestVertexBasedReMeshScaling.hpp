@@ -0,0 +1,147 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTVERTEXBASEDREMESHSCALING_HPP_
+#define TESTVERTEXBASEDREMESHSCALING_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+// Must be included before other cell_based headers
+#include "CellBasedSimulationArchiver.hpp"
+
+#include "AbstractCellBasedWithTimingsTestSuite.hpp"
+#include "OffLatticeSimulation.hpp"
+#include "VertexBasedCellPopulation.hpp"
+#include "NagaiHondaForce.hpp"
+#include "SimpleTargetAreaModifier.hpp"
+#include "CellsGenerator.hpp"
+#include "HoneycombVertexMeshGenerator.hpp"
+#include "UniformCellCycleModel.hpp"
+#include "TransitCellProliferativeType.hpp"
+#include "RandomNumberGenerator.hpp"
+#include "Timer.hpp"
+#include "SmartPointers.hpp"
+#include "FakePetscSetup.hpp"
+
+/**
+ * This class times the remeshing of vertex-based tissues of increasing size,
+ * from 100 to 20000 cells. The first test times a single call to ReMesh() on
+ * a honeycomb mesh whose interior nodes have been randomly moved, so that many
+ * T1 swaps are required; the second times each step of a proliferating
+ * vertex-based simulation.
+ *
+ * This test is used for profiling the worklists used by MutableVertexMesh::ReMesh().
+ */
+class TestVertexBasedReMeshScaling : public AbstractCellBasedWithTimingsTestSuite
+{
+public:
+
+    void TestReMeshScaling()
+    {
+        unsigned cells_across[5] = {10, 20, 40, 80, 142};
+
+        for (unsigned i=0; i<5; i++)
+        {
+            HoneycombVertexMeshGenerator generator(cells_across[i], cells_across[i]);
+            boost::shared_ptr<MutableVertexMesh<2,2> > p_mesh = generator.GetMesh();
+            p_mesh->SetCellRearrangementThreshold(0.3);
+
+            // Move the interior nodes so that many edges become shorter than the threshold
+            RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+            p_gen->Reseed(0);
+            for (unsigned node_index=0; node_index<p_mesh->GetNumNodes(); node_index++)
+            {
+                Node<2>* p_node = p_mesh->GetNode(node_index);
+                if (!p_node->IsBoundaryNode())
+                {
+                    p_node->rGetModifiableLocation()[0] += 0.15*(2.0*p_gen->ranf() - 1.0);
+                    p_node->rGetModifiableLocation()[1] += 0.15*(2.0*p_gen->ranf() - 1.0);
+                }
+            }
+
+            double start_time = Timer::GetWallTime();
+            p_mesh->ReMesh();
+            double elapsed_time = Timer::GetWallTime() - start_time;
+
+            std::cout << "Cells: " << p_mesh->GetNumElements()
+                      << "\tT1 swaps: " << p_mesh->GetLocationsOfT1Swaps().size()
+                      << "\tReMesh time: " << elapsed_time << "s\n";
+        }
+    }
+
+    void TestSimulationTimestepScaling()
+    {
+        unsigned cells_across[5] = {10, 20, 40, 80, 142};
+        unsigned num_timesteps = 10;
+
+        for (unsigned i=0; i<5; i++)
+        {
+            SimulationTime::Destroy();
+            SimulationTime::Instance()->SetStartTime(0.0);
+            RandomNumberGenerator::Instance()->Reseed(0);
+
+            HoneycombVertexMeshGenerator generator(cells_across[i], cells_across[i]);
+            boost::shared_ptr<MutableVertexMesh<2,2> > p_mesh = generator.GetMesh();
+
+            std::vector<CellPtr> cells;
+            MAKE_PTR(TransitCellProliferativeType, p_transit_type);
+            CellsGenerator<UniformCellCycleModel, 2> cells_generator;
+            cells_generator.GenerateBasicRandom(cells, p_mesh->GetNumElements(), p_transit_type);
+
+            VertexBasedCellPopulation<2> cell_population(*p_mesh, cells);
+            cell_population.SetOutputResultsForChasteVisualizer(false);
+
+            OffLatticeSimulation<2> simulator(cell_population);
+            simulator.SetOutputDirectory("TestVertexBasedReMeshScaling");
+            simulator.SetDt(0.002);
+            simulator.SetSamplingTimestepMultiple(num_timesteps);
+            simulator.SetEndTime(num_timesteps*0.002);
+
+            MAKE_PTR(NagaiHondaForce<2>, p_force);
+            simulator.AddForce(p_force);
+            MAKE_PTR(SimpleTargetAreaModifier<2>, p_growth_modifier);
+            simulator.AddSimulationModifier(p_growth_modifier);
+
+            double start_time = Timer::GetWallTime();
+            simulator.Solve();
+            double elapsed_time = (Timer::GetWallTime() - start_time)/num_timesteps;
+
+            std::cout << "Cells: " << cell_population.GetNumRealCells()
+                      << "\ttime per timestep: " << elapsed_time << "s\n";
+        }
+    }
+};
+
+#endif /*TESTVERTEXBASEDREMESHSCALING_HPP_*/
@@ -0,0 +1,257 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTVERTEXELEMENTGEOMETRYCACHEPROFILE_HPP_
+#define TESTVERTEXELEMENTGEOMETRYCACHEPROFILE_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+// Must be included before other cell_based headers
+#include "CellBasedSimulationArchiver.hpp"
+
+#include "AbstractCellBasedWithTimingsTestSuite.hpp"
+#include "OffLatticeSimulation.hpp"
+#include "VertexBasedCellPopulation.hpp"
+#include "NagaiHondaForce.hpp"
+#include "SimpleTargetAreaModifier.hpp"
+#include "VolumeTrackingModifier.hpp"
+#include "CellVolumesWriter.hpp"
+#include "CellsGenerator.hpp"
+#include "HoneycombVertexMeshGenerator.hpp"
+#include "UniformCellCycleModel.hpp"
+#include "TransitCellProliferativeType.hpp"
+#include "RandomNumberGenerator.hpp"
+#include "Timer.hpp"
+#include "SmartPointers.hpp"
+#include "FakePetscSetup.hpp"
+
+/**
+ * A MutableVertexMesh that counts how many times the area, perimeter and centroid
+ * of its elements are requested, and how many times they are actually evaluated.
+ */
+class CountingMutableVertexMesh : public MutableVertexMesh<2,2>
+{
+public:
+
+    /** The number of calls to GetVolumeOfElement(), GetSurfaceAreaOfElement() and GetCentroidOfElement(). */
+    unsigned mNumRequests;
+
+    /** The number of these calls that evaluated the geometry of an element. */
+    unsigned mNumEvaluations;
+
+    /**
+     * Constructor.
+     *
+     * @param nodes vector of pointers to nodes
+     * @param vertexElements vector of pointers to VertexElements
+     */
+    CountingMutableVertexMesh(std::vector<Node<2>*> nodes, std::vector<VertexElement<2,2>*> vertexElements)
+        : MutableVertexMesh<2,2>(nodes, vertexElements),
+          mNumRequests(0),
+          mNumEvaluations(0)
+    {
+    }
+
+    /**
+     * Count a request for the geometry of an element.
+     *
+     * @param index the global index of the element
+     */
+    void CountRequest(unsigned index)
+    {
+        mNumRequests++;
+        if (!mUseElementGeometryCache || index >= mElementGeometryIsCurrent.size() || !mElementGeometryIsCurrent[index])
+        {
+            mNumEvaluations++;
+        }
+    }
+
+    /**
+     * Overridden GetVolumeOfElement() method.
+     *
+     * @param index the global index of the element
+     * @return the area of the element
+     */
+    double GetVolumeOfElement(unsigned index) override
+    {
+        CountRequest(index);
+        return MutableVertexMesh<2,2>::GetVolumeOfElement(index);
+    }
+
+    /**
+     * Overridden GetSurfaceAreaOfElement() method.
+     *
+     * @param index the global index of the element
+     * @return the perimeter of the element
+     */
+    double GetSurfaceAreaOfElement(unsigned index) override
+    {
+        CountRequest(index);
+        return MutableVertexMesh<2,2>::GetSurfaceAreaOfElement(index);
+    }
+
+    /**
+     * Overridden GetCentroidOfElement() method.
+     *
+     * @param index the global index of the element
+     * @return the centroid of the element
+     */
+    c_vector<double, 2> GetCentroidOfElement(unsigned index) override
+    {
+        CountRequest(index);
+        return MutableVertexMesh<2,2>::GetCentroidOfElement(index);
+    }
+};
+
+/**
+ * This class profiles the element geometry cache of VertexMesh in a typical vertex-based
+ * simulation, with a NagaiHondaForce, target area and volume tracking modifiers and a cell
+ * volumes writer. It reports how many element geometry evaluations the cache removes.
+ *
+ * This test is used for profiling.
+ */
+class TestVertexElementGeometryCacheProfile : public AbstractCellBasedWithTimingsTestSuite
+{
+private:
+
+    /**
+     * Run a proliferating vertex-based simulation on a copy of a honeycomb mesh.
+     *
+     * @param useCache whether to cache element geometry
+     * @param rNumRequests set to the number of requests for element geometry
+     * @param rNumEvaluations set to the number of element geometry evaluations
+     * @param rNodeLocations set to the final node locations
+     */
+    void RunSimulation(bool useCache, unsigned& rNumRequests, unsigned& rNumEvaluations,
+                       std::vector<c_vector<double, 2> >& rNodeLocations)
+    {
+        SimulationTime::Destroy();
+        SimulationTime::Instance()->SetStartTime(0.0);
+        RandomNumberGenerator::Instance()->Reseed(0);
+
+        HoneycombVertexMeshGenerator generator(20, 20);
+        boost::shared_ptr<MutableVertexMesh<2,2> > p_generated_mesh = generator.GetMesh();
+
+        std::vector<Node<2>*> nodes;
+        for (unsigned node_index=0; node_index<p_generated_mesh->GetNumNodes(); node_index++)
+        {
+            Node<2>* p_node = p_generated_mesh->GetNode(node_index);
+            nodes.push_back(new Node<2>(node_index, p_node->rGetLocation(), p_node->IsBoundaryNode()));
+        }
+        std::vector<VertexElement<2,2>*> elements;
+        for (unsigned elem_index=0; elem_index<p_generated_mesh->GetNumElements(); elem_index++)
+        {
+            VertexElement<2,2>* p_element = p_generated_mesh->GetElement(elem_index);
+            std::vector<Node<2>*> element_nodes;
+            for (unsigned local_index=0; local_index<p_element->GetNumNodes(); local_index++)
+            {
+                element_nodes.push_back(nodes[p_element->GetNodeGlobalIndex(local_index)]);
+            }
+            elements.push_back(new VertexElement<2,2>(elem_index, element_nodes));
+        }
+        CountingMutableVertexMesh mesh(nodes, elements);
+        mesh.SetUseElementGeometryCache(useCache);
+
+        std::vector<CellPtr> cells;
+        MAKE_PTR(TransitCellProliferativeType, p_transit_type);
+        CellsGenerator<UniformCellCycleModel, 2> cells_generator;
+        cells_generator.GenerateBasicRandom(cells, mesh.GetNumElements(), p_transit_type);
+
+        VertexBasedCellPopulation<2> cell_population(mesh, cells);
+        cell_population.AddCellWriter<CellVolumesWriter>();
+
+        OffLatticeSimulation<2> simulator(cell_population);
+        simulator.SetOutputDirectory("TestVertexElementGeometryCacheProfile");
+        simulator.SetSamplingTimestepMultiple(10);
+        simulator.SetEndTime(0.5);
+
+        MAKE_PTR(NagaiHondaForce<2>, p_force);
+        simulator.AddForce(p_force);
+        MAKE_PTR(SimpleTargetAreaModifier<2>, p_growth_modifier);
+        simulator.AddSimulationModifier(p_growth_modifier);
+        MAKE_PTR(VolumeTrackingModifier<2>, p_volume_modifier);
+        simulator.AddSimulationModifier(p_volume_modifier);
+
+        double start_time = Timer::GetWallTime();
+        simulator.Solve();
+        double elapsed_time = Timer::GetWallTime() - start_time;
+
+        rNumRequests = mesh.mNumRequests;
+        rNumEvaluations = mesh.mNumEvaluations;
+        rNodeLocations.clear();
+        for (unsigned node_index=0; node_index<mesh.GetNumNodes(); node_index++)
+        {
+            rNodeLocations.push_back(mesh.GetNode(node_index)->rGetLocation());
+        }
+
+        std::cout << (useCache ? "With" : "Without") << " element geometry cache:"
+                  << "\tcells: " << cell_population.GetNumRealCells()
+                  << "\trequests: " << rNumRequests
+                  << "\tevaluations: " << rNumEvaluations
+                  << "\ttime: " << elapsed_time << "s\n";
+    }
+
+public:
+
+    void TestElementGeometryCacheRemovesRedundantEvaluations()
+    {
+        unsigned num_requests_without_cache;
+        unsigned num_evaluations_without_cache;
+        std::vector<c_vector<double, 2> > node_locations_without_cache;
+        RunSimulation(false, num_requests_without_cache, num_evaluations_without_cache, node_locations_without_cache);
+
+        unsigned num_requests_with_cache;
+        unsigned num_evaluations_with_cache;
+        std::vector<c_vector<double, 2> > node_locations_with_cache;
+        RunSimulation(true, num_requests_with_cache, num_evaluations_with_cache, node_locations_with_cache);
+
+        // Without the cache, every request is an evaluation
+        TS_ASSERT_EQUALS(num_evaluations_without_cache, num_requests_without_cache);
+        TS_ASSERT_LESS_THAN(num_evaluations_with_cache, num_evaluations_without_cache);
+
+        std::cout << "Redundant element geometry evaluations removed: "
+                  << num_evaluations_without_cache - num_evaluations_with_cache << "\n";
+
+        // The cache should not change the results of the simulation
+        TS_ASSERT_EQUALS(node_locations_with_cache.size(), node_locations_without_cache.size());
+        for (unsigned i=0; i<std::min(node_locations_with_cache.size(), node_locations_without_cache.size()); i++)
+        {
+            TS_ASSERT_DELTA(node_locations_with_cache[i][0], node_locations_without_cache[i][0], 1e-10);
+            TS_ASSERT_DELTA(node_locations_with_cache[i][1], node_locations_without_cache[i][1], 1e-10);
+        }
+    }
+};
+
+#endif /*TESTVERTEXELEMENTGEOMETRYCACHEPROFILE_HPP_*/
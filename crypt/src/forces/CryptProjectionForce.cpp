@@ -153,8 +153,8 @@ c_vector<double,2> CryptProjectionForce::CalculateForceBetweenNodes(unsigned nod
 
     double rest_length = 1.0;
 
-    CellPtr p_cell_A = rCellPopulation.GetCellUsingLocationIndex(nodeAGlobalIndex);
-    CellPtr p_cell_B = rCellPopulation.GetCellUsingLocationIndex(nodeBGlobalIndex);
+    const CellPtr& p_cell_A = rCellPopulation.rGetCellUsingLocationIndex(nodeAGlobalIndex);
+    const CellPtr& p_cell_B = rCellPopulation.rGetCellUsingLocationIndex(nodeBGlobalIndex);
 
     double ageA = p_cell_A->GetAge();
     double ageB = p_cell_B->GetAge();
@@ -250,6 +250,15 @@ c_vector<double,2> CryptProjectionForce::CalculateForceBetweenNodes(unsigned nod
     return projected_force_between_nodes_2d;
 }
 
+c_vector<double,2> CryptProjectionForce::CalculateForceBetweenNodesWithSeparation(unsigned nodeAGlobalIndex,
+                                                                                  unsigned nodeBGlobalIndex,
+                                                                                  AbstractCellPopulation<2>& rCellPopulation,
+                                                                                  const c_vector<double,2>& rVectorFromAtoB,
+                                                                                  double distanceBetweenNodes)
+{
+    return CalculateForceBetweenNodes(nodeAGlobalIndex, nodeBGlobalIndex, rCellPopulation);
+}
+
 void CryptProjectionForce::AddForceContribution(AbstractCellPopulation<2>& rCellPopulation)
 {
     // First work out the 3D location of each cell
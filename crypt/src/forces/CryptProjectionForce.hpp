@@ -115,6 +115,27 @@ private:
      */
     c_vector<double,2> CalculateForceBetweenNodes(unsigned nodeAGlobalIndex, unsigned nodeBGlobalIndex, AbstractCellPopulation<2>& rCellPopulation);
 
+    /**
+     * Overridden CalculateForceBetweenNodesWithSeparation() method.
+     *
+     * The force depends on the separation of the nodes' projections onto the crypt
+     * surface rather than their separation in the plane, so the given separation is
+     * ignored and CalculateForceBetweenNodes() is called instead.
+     *
+     * @param nodeAGlobalIndex the index of the first node
+     * @param nodeBGlobalIndex the index of the second node
+     * @param rCellPopulation the cell population
+     * @param rVectorFromAtoB the vector from node A to node B (not used)
+     * @param distanceBetweenNodes the length of rVectorFromAtoB (not used)
+     *
+     * @return The force exerted on Node A by Node B.
+     */
+    c_vector<double,2> CalculateForceBetweenNodesWithSeparation(unsigned nodeAGlobalIndex,
+                                                                unsigned nodeBGlobalIndex,
+                                                                AbstractCellPopulation<2>& rCellPopulation,
+                                                                const c_vector<double,2>& rVectorFromAtoB,
+                                                                double distanceBetweenNodes);
+
 public:
 
     /**
@@ -101,8 +101,8 @@ double LinearSpringWithVariableSpringConstantsForce<DIM>::VariableSpringConstant
                                                                                                             rCellPopulation,
                                                                                                             isCloserThanRestLength);
 
-    CellPtr p_cell_A = rCellPopulation.GetCellUsingLocationIndex(nodeAGlobalIndex);
-    CellPtr p_cell_B = rCellPopulation.GetCellUsingLocationIndex(nodeBGlobalIndex);
+    const CellPtr& p_cell_A = rCellPopulation.rGetCellUsingLocationIndex(nodeAGlobalIndex);
+    const CellPtr& p_cell_B = rCellPopulation.rGetCellUsingLocationIndex(nodeBGlobalIndex);
 
     /*
      * The next code block computes the edge-dependent spring constant as given by equation
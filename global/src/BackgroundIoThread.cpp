@@ -0,0 +1,131 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "BackgroundIoThread.hpp"
+
+BackgroundIoThread::BackgroundIoThread()
+    : mBusy(false),
+      mStop(false)
+{
+    mThread = std::thread(&BackgroundIoThread::Run, this);
+}
+
+BackgroundIoThread::~BackgroundIoThread()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mTaskQueued.notify_one();
+    mThread.join();
+}
+
+void BackgroundIoThread::Enqueue(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        RethrowTaskException();
+        mTasks.push_back(std::move(task));
+    }
+    mTaskQueued.notify_one();
+}
+
+void BackgroundIoThread::Flush()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    mQueueEmptied.wait(lock, [this]{ return mTasks.empty() && !mBusy; });
+    RethrowTaskException();
+}
+
+unsigned BackgroundIoThread::GetNumPendingTasks()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mTasks.size() + (mBusy ? 1u : 0u);
+}
+
+void BackgroundIoThread::RethrowTaskException()
+{
+    if (mpException)
+    {
+        std::exception_ptr p_exception = mpException;
+        mpException = nullptr;
+        std::rethrow_exception(p_exception);
+    }
+}
+
+void BackgroundIoThread::Run()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true)
+    {
+        mTaskQueued.wait(lock, [this]{ return mStop || !mTasks.empty(); });
+        if (mTasks.empty())
+        {
+            // Asked to stop, and nothing left to do
+            break;
+        }
+
+        std::function<void()> task = std::move(mTasks.front());
+        mTasks.pop_front();
+        mBusy = true;
+        lock.unlock();
+
+        std::exception_ptr p_exception;
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            p_exception = std::current_exception();
+        }
+
+        lock.lock();
+        mBusy = false;
+        if (p_exception)
+        {
+            // Later tasks probably depend on this one (e.g. appends to the same file), so drop them
+            if (!mpException)
+            {
+                mpException = p_exception;
+            }
+            mTasks.clear();
+        }
+        if (mTasks.empty())
+        {
+            mQueueEmptied.notify_all();
+        }
+    }
+}
@@ -0,0 +1,132 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef BACKGROUNDIOTHREAD_HPP_
+#define BACKGROUNDIOTHREAD_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * A single worker thread that runs output tasks, typically writes of text or data
+ * that has already been formatted in memory, in the order in which they are queued.
+ * This lets the calling thread carry on computing rather than wait on the file system.
+ *
+ * A task must only use data (including open files) that the calling thread leaves
+ * alone until Flush() has returned. If a task throws, any tasks still queued are
+ * discarded and the exception is rethrown on the calling thread by the next call to
+ * Enqueue() or Flush().
+ */
+class BackgroundIoThread
+{
+private:
+
+    /** The worker thread. */
+    std::thread mThread;
+
+    /** Protects all the members below. */
+    std::mutex mMutex;
+
+    /** Signalled when a task is queued or the worker is asked to stop. */
+    std::condition_variable mTaskQueued;
+
+    /** Signalled when the worker has run out of tasks. */
+    std::condition_variable mQueueEmptied;
+
+    /** Tasks waiting to be run, oldest first. */
+    std::deque<std::function<void()> > mTasks;
+
+    /** Whether the worker is currently running a task. */
+    bool mBusy;
+
+    /** Whether the worker should exit once the queue is empty. */
+    bool mStop;
+
+    /** The first exception thrown by a task and not yet rethrown. */
+    std::exception_ptr mpException;
+
+    /**
+     * The body of the worker thread.
+     */
+    void Run();
+
+    /**
+     * Rethrow (and forget) the exception thrown by a task, if there was one.
+     * Must be called with mMutex held.
+     */
+    void RethrowTaskException();
+
+public:
+
+    /**
+     * Constructor. Starts the worker thread.
+     */
+    BackgroundIoThread();
+
+    /**
+     * Destructor. Runs any queued tasks, then stops the worker thread. Exceptions
+     * thrown by tasks at this point are ignored, so call Flush() first to see them.
+     */
+    ~BackgroundIoThread();
+
+    /** Copying is not allowed. */
+    BackgroundIoThread(const BackgroundIoThread&) = delete;
+
+    /** Copying is not allowed. @return this */
+    BackgroundIoThread& operator=(const BackgroundIoThread&) = delete;
+
+    /**
+     * Queue a task to be run on the worker thread after those already queued.
+     *
+     * @param task the task
+     */
+    void Enqueue(std::function<void()> task);
+
+    /**
+     * Wait until every queued task has been run.
+     */
+    void Flush();
+
+    /**
+     * @return the number of tasks queued or running.
+     */
+    unsigned GetNumPendingTasks();
+};
+
+#endif /*BACKGROUNDIOTHREAD_HPP_*/
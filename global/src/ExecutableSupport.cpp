@@ -111,8 +111,8 @@ void ExecutableSupport::InitializePetsc(int* pArgc, char*** pArgv)
     // Store the arguments in case other code needs them
     CommandLineArguments::Instance()->p_argc = pArgc;
     CommandLineArguments::Instance()->p_argv = pArgv;
-    // Initialise PETSc
-    PETSCEXCEPT(PetscInitialize(pArgc, pArgv, PETSC_NULL, PETSC_NULL));
+    // Initialise PETSc (and MPI with MPI_THREAD_MULTIPLE support if "-mpi_thread_multiple" is given)
+    PetscSetupUtils::InitialisePetsc();
     // Set default output folder
     if (!mOutputDirectory.IsPathSet())
     {
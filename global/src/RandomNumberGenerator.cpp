@@ -48,10 +48,11 @@ RandomNumberGenerator::RandomNumberGenerator()
         : mMersenneTwisterGenerator(0u),
           mGenerateUnitReal(mMersenneTwisterGenerator, boost::uniform_real<>()),
 #if BOOST_VERSION < 106400 // #2585 and #2893
-          mGenerateStandardNormal(mMersenneTwisterGenerator, boost::random::normal_distribution_v165<>(0.0, 1.0))
+          mGenerateStandardNormal(mMersenneTwisterGenerator, boost::random::normal_distribution_v165<>(0.0, 1.0)),
 #else
-          mGenerateStandardNormal(mMersenneTwisterGenerator, boost::normal_distribution<>(0.0, 1.0))
+          mGenerateStandardNormal(mMersenneTwisterGenerator, boost::normal_distribution<>(0.0, 1.0)),
 #endif
+          mStreamSeed(0u)
 {
     assert(mpInstance == nullptr); // Ensure correct serialization
 }
@@ -159,6 +160,8 @@ void RandomNumberGenerator::Reseed(unsigned seed)
 
     // Probably don't need to do this, but it probably is good practice!
     mGenerateUnitReal.distribution().reset();
+
+    mStreamSeed = seed;
 }
 
 void RandomNumberGenerator::Shuffle(unsigned num, std::vector<unsigned>& rValues)
@@ -178,3 +181,18 @@ void RandomNumberGenerator::Shuffle(unsigned num, std::vector<unsigned>& rValues
         rValues[k] = temp;
     }
 }
+
+RandomNumberStream RandomNumberGenerator::GetStream(unsigned streamId, unsigned timestep, unsigned purpose) const
+{
+    return RandomNumberStream(mStreamSeed, streamId, timestep, purpose);
+}
+
+uint64_t RandomNumberGenerator::GetStreamSeed() const
+{
+    return mStreamSeed;
+}
+
+void RandomNumberGenerator::SetStreamSeed(uint64_t streamSeed)
+{
+    mStreamSeed = streamSeed;
+}
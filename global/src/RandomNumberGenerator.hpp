@@ -38,6 +38,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <boost/shared_ptr.hpp>
 #include <boost/version.hpp>
+#include <cstdint>
 #include <sstream>
 
 #if BOOST_VERSION < 106400
@@ -49,7 +50,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <boost/serialization/split_member.hpp>
 #include "ChasteSerialization.hpp"
+#include "ChasteSerializationVersion.hpp"
 #include "SerializableSingleton.hpp"
+#include "RandomNumberStream.hpp"
 
 /**
  * A special singleton class allowing one to generate different types of
@@ -77,6 +80,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * if the user is on an older version of boost some of the Chaste copies of newer boost distributions
  * in global/src/random are used instead to give consistent random numbers across boost versions.
  *
+ * All the methods above draw from a single sequential stream, so the numbers a caller gets depend
+ * on how many have been drawn before. Code that must give the same results whatever order (or on
+ * however many threads) it runs in should instead use GetStream() to obtain a counter-based
+ * RandomNumberStream keyed on, for example, a cell id, the timestep and the purpose of the numbers.
+ * The seed of these streams is set by Reseed() and archived with the generator.
  */
 class RandomNumberGenerator : public SerializableSingleton<RandomNumberGenerator>
 {
@@ -95,6 +103,10 @@ private:
 #else
     boost::variate_generator<boost::mt19937&, boost::normal_distribution<> > mGenerateStandardNormal;
 #endif
+
+    /** The seed of the counter-based streams returned by GetStream(). */
+    uint64_t mStreamSeed;
+
     /** Pointer to the single instance. */
     static RandomNumberGenerator* mpInstance;
 
@@ -125,6 +137,8 @@ private:
         normal_internals << r_normal_dist;
         std::string normal_internals_string = normal_internals.str();
         archive& normal_internals_string;
+
+        archive& mStreamSeed;
     }
 
     /**
@@ -148,6 +162,13 @@ private:
         archive& normal_internals_string;
         std::stringstream normal_internals(normal_internals_string);
         normal_internals >> mGenerateStandardNormal.distribution();
+
+        // Archives written before counter-based streams were added use the default stream seed
+        mStreamSeed = 0u;
+        if (version > 0)
+        {
+            archive& mStreamSeed;
+        }
     }
     BOOST_SERIALIZATION_SPLIT_MEMBER()
 
@@ -239,6 +260,31 @@ public:
      */
     void Shuffle(unsigned num, std::vector<unsigned>& rValues);
 
+    /**
+     * Get a counter-based random number stream. The numbers drawn from the stream depend
+     * only on its keys and the stream seed, not on any other use of the generator, so
+     * streams may be used in any order and from any thread.
+     *
+     * @param streamId  the id of the stream (e.g. a cell id or node index)
+     * @param timestep  the timestep at which the stream is used
+     * @param purpose  what the stream is used for, to distinguish several streams per object and timestep
+     * @return the stream
+     */
+    RandomNumberStream GetStream(unsigned streamId, unsigned timestep = 0u, unsigned purpose = 0u) const;
+
+    /**
+     * @return the seed of the counter-based streams returned by GetStream().
+     */
+    uint64_t GetStreamSeed() const;
+
+    /**
+     * Set the seed of the counter-based streams returned by GetStream(), without
+     * affecting the sequential stream. Reseed() also sets this seed.
+     *
+     * @param streamSeed  the new stream seed
+     */
+    void SetStreamSeed(uint64_t streamSeed);
+
     /**
      * @return a pointer to the random number generator object.
      * The object is created the first time this method is called.
@@ -261,4 +307,6 @@ public:
     void Reseed(unsigned seed);
 };
 
+BOOST_CLASS_VERSION(RandomNumberGenerator, 1u)
+
 #endif /*RANDOMNUMBERGENERATORS_HPP_*/
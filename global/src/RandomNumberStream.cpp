@@ -0,0 +1,203 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <cassert>
+#include <cmath>
+
+#include "RandomNumberStream.hpp"
+
+RandomNumberStream::RandomNumberStream(uint64_t seed, unsigned streamId, unsigned timestep, unsigned purpose)
+    : mNumUsedInBlock(4u),
+      mHasSpareNormal(false),
+      mSpareNormal(0.0)
+{
+    mKey[0] = uint32_t(seed);
+    mKey[1] = uint32_t(seed >> 32);
+
+    mCounter[0] = 0u;
+    mCounter[1] = purpose;
+    mCounter[2] = streamId;
+    mCounter[3] = timestep;
+}
+
+void RandomNumberStream::Philox4x32(const uint32_t counter[4], const uint32_t key[2], uint32_t result[4])
+{
+    const uint32_t multiplier_0 = 0xD2511F53u;
+    const uint32_t multiplier_1 = 0xCD9E8D57u;
+    const uint32_t weyl_0 = 0x9E3779B9u;
+    const uint32_t weyl_1 = 0xBB67AE85u;
+
+    uint32_t x[4] = {counter[0], counter[1], counter[2], counter[3]};
+    uint32_t k[2] = {key[0], key[1]};
+
+    for (unsigned round=0; round<10; round++)
+    {
+        if (round > 0)
+        {
+            k[0] += weyl_0;
+            k[1] += weyl_1;
+        }
+
+        const uint64_t product_0 = uint64_t(multiplier_0)*x[0];
+        const uint64_t product_1 = uint64_t(multiplier_1)*x[2];
+
+        const uint32_t y0 = uint32_t(product_1 >> 32) ^ x[1] ^ k[0];
+        const uint32_t y1 = uint32_t(product_1);
+        const uint32_t y2 = uint32_t(product_0 >> 32) ^ x[3] ^ k[1];
+        const uint32_t y3 = uint32_t(product_0);
+
+        x[0] = y0;
+        x[1] = y1;
+        x[2] = y2;
+        x[3] = y3;
+    }
+
+    for (unsigned i=0; i<4; i++)
+    {
+        result[i] = x[i];
+    }
+}
+
+uint32_t RandomNumberStream::NextUnsigned()
+{
+    if (mNumUsedInBlock == 4u)
+    {
+        Philox4x32(mCounter, mKey, mBlock);
+        mCounter[0]++;
+        mNumUsedInBlock = 0u;
+    }
+    return mBlock[mNumUsedInBlock++];
+}
+
+double RandomNumberStream::ranf()
+{
+    // As in the Mersenne Twister's genrand_res53(), combine 27 and 26 bits
+    const uint32_t a = NextUnsigned() >> 5;
+    const uint32_t b = NextUnsigned() >> 6;
+    return (a*67108864.0 + b)*(1.0/9007199254740992.0);
+}
+
+unsigned RandomNumberStream::randMod(unsigned base)
+{
+    assert(base > 0u);
+
+    // Reject the lowest (2^32 mod base) values, so that every result is equally likely
+    const uint32_t threshold = (0u - uint32_t(base)) % uint32_t(base);
+    uint32_t value;
+    do
+    {
+        value = NextUnsigned();
+    }
+    while (value < threshold);
+
+    return value % base;
+}
+
+double RandomNumberStream::StandardNormalRandomDeviate()
+{
+    if (mHasSpareNormal)
+    {
+        mHasSpareNormal = false;
+        return mSpareNormal;
+    }
+
+    // Box-Muller transform; 1 - ranf() lies in (0,1], so the logarithm is finite
+    const double radius = sqrt(-2.0*log(1.0 - ranf()));
+    const double angle = 2.0*M_PI*ranf();
+
+    mSpareNormal = radius*sin(angle);
+    mHasSpareNormal = true;
+    return radius*cos(angle);
+}
+
+double RandomNumberStream::NormalRandomDeviate(double mean, double stdDev)
+{
+    return stdDev*StandardNormalRandomDeviate() + mean;
+}
+
+double RandomNumberStream::ExponentialRandomDeviate(double scale)
+{
+    return -log(1.0 - ranf())/scale;
+}
+
+double RandomNumberStream::GammaRandomDeviate(double shape, double scale)
+{
+    assert(shape > 0.0);
+
+    if (shape < 1.0)
+    {
+        // Use the relation Gamma(a) = Gamma(a+1)*U^(1/a)
+        const double u = 1.0 - ranf();
+        return GammaRandomDeviate(shape + 1.0, scale)*pow(u, 1.0/shape);
+    }
+
+    // Marsaglia and Tsang's method
+    const double d = shape - 1.0/3.0;
+    const double c = 1.0/sqrt(9.0*d);
+    while (true)
+    {
+        const double x = StandardNormalRandomDeviate();
+        double v = 1.0 + c*x;
+        if (v <= 0.0)
+        {
+            continue;
+        }
+        v = v*v*v;
+
+        const double u = 1.0 - ranf();
+        if (u < 1.0 - 0.0331*x*x*x*x || log(u) < 0.5*x*x + d*(1.0 - v + log(v)))
+        {
+            return scale*d*v;
+        }
+    }
+}
+
+void RandomNumberStream::Shuffle(unsigned num, std::vector<unsigned>& rValues)
+{
+    rValues.resize(num);
+    for (unsigned i=0; i<num; i++)
+    {
+        rValues[i] = i;
+    }
+
+    for (unsigned end=num; end>1; end--)
+    {
+        // Pick a random integer from {0,..,end-1}
+        unsigned k = randMod(end);
+        unsigned temp = rValues[end - 1];
+        rValues[end - 1] = rValues[k];
+        rValues[k] = temp;
+    }
+}
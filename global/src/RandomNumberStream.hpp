@@ -0,0 +1,159 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef RANDOMNUMBERSTREAM_HPP_
+#define RANDOMNUMBERSTREAM_HPP_
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * A counter-based random number stream, for use where random numbers must not
+ * depend on the order in which they are drawn (for example in threaded loops).
+ *
+ * Each stream is identified by a 64-bit seed and three keys, conventionally a
+ * stream id (such as a cell id or node index), a timestep and a purpose (which of
+ * the object's random decisions the numbers are for). The i-th number drawn from a
+ * stream is a fixed function of these values and i, computed with the Philox4x32-10
+ * bijection of Salmon et al. (2011), so streams with different keys are independent
+ * and a stream can be recreated at any time without storing any state.
+ *
+ * Streams are normally obtained from RandomNumberGenerator::GetStream(), which
+ * supplies a seed that is set by RandomNumberGenerator::Reseed() and checkpointed
+ * with the generator.
+ */
+class RandomNumberStream
+{
+private:
+
+    /** The Philox key, formed from the seed. */
+    uint32_t mKey[2];
+
+    /** The Philox counter: the block index followed by the purpose, stream id and timestep. */
+    uint32_t mCounter[4];
+
+    /** The most recently generated block of random bits. */
+    uint32_t mBlock[4];
+
+    /** The number of entries of mBlock that have been used. */
+    unsigned mNumUsedInBlock;
+
+    /** Whether mSpareNormal holds an unused standard normal deviate. */
+    bool mHasSpareNormal;
+
+    /** The second deviate produced by the last Box-Muller transform. */
+    double mSpareNormal;
+
+    /**
+     * Apply the Philox4x32-10 bijection.
+     *
+     * @param counter  the counter to encrypt
+     * @param key  the key
+     * @param result  filled in with the random bits
+     */
+    static void Philox4x32(const uint32_t counter[4], const uint32_t key[2], uint32_t result[4]);
+
+    /**
+     * @return the next 32 random bits of the stream.
+     */
+    uint32_t NextUnsigned();
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param seed  the seed shared by a family of streams
+     * @param streamId  the id of the stream within the family (e.g. a cell id)
+     * @param timestep  the timestep at which the stream is used
+     * @param purpose  what the stream is used for
+     */
+    RandomNumberStream(uint64_t seed, unsigned streamId, unsigned timestep = 0u, unsigned purpose = 0u);
+
+    /**
+     * @return a uniform random number in [0,1), with 53 random bits.
+     */
+    double ranf();
+
+    /**
+     * @return a random integer in [0, base), without modulo bias.
+     *
+     * @param base  the number of possible values (must be positive)
+     */
+    unsigned randMod(unsigned base);
+
+    /**
+     * @return a random number from the normal distribution with mean 0 and
+     * standard deviation 1.
+     */
+    double StandardNormalRandomDeviate();
+
+    /**
+     * @return a random number from a normal distribution with given mean and
+     * standard deviation.
+     *
+     * @param mean  the mean of the distribution
+     * @param stdDev  the standard deviation of the distribution
+     */
+    double NormalRandomDeviate(double mean, double stdDev);
+
+    /**
+     * @return a random number from an exponential distribution with the given rate,
+     * as for RandomNumberGenerator::ExponentialRandomDeviate().
+     *
+     * @param scale  the rate parameter of the distribution
+     */
+    double ExponentialRandomDeviate(double scale);
+
+    /**
+     * @return a random number from a gamma distribution with the given shape and
+     * scale parameters.
+     *
+     * @param shape  the shape parameter of the distribution
+     * @param scale  the scale parameter of the distribution
+     */
+    double GammaRandomDeviate(double shape, double scale);
+
+    /**
+     * Produce a permutation of the integers 0,1,..,num-1 using the Fisher-Yates
+     * algorithm, as for RandomNumberGenerator::Shuffle().
+     *
+     * @param num  the number of integers to shuffle
+     * @param rValues  the output permutation (any initial values ignored)
+     */
+    void Shuffle(unsigned num, std::vector<unsigned>& rValues);
+};
+
+#endif /*RANDOMNUMBERSTREAM_HPP_*/
@@ -73,19 +73,32 @@ void FpeSignalToAbort(int sig_num, siginfo_t* info, void* context)
 }
 #endif
 
-void PetscSetupUtils::InitialisePetsc()
+bool PetscSetupUtils::mMpiInitialisedHere = false;
+
+void PetscSetupUtils::InitialisePetsc(bool requestMpiThreadMultiple)
 {
     // The CommandLineArguments instance is filled in by the cxxtest test suite runner.
     CommandLineArguments* p_args = CommandLineArguments::Instance();
+
+    int mpi_is_initialised;
+    MPI_Initialized(&mpi_is_initialised);
+    if (!mpi_is_initialised && (requestMpiThreadMultiple || p_args->OptionExists("-mpi_thread_multiple")))
+    {
+        // PETSc uses MPI as we leave it, so collective HDF5 writes may then be made on another thread
+        int thread_support;
+        MPI_Init_thread(p_args->p_argc, p_args->p_argv, MPI_THREAD_MULTIPLE, &thread_support);
+        mMpiInitialisedHere = true;
+    }
+
     PETSCEXCEPT(PetscInitialize(p_args->p_argc, p_args->p_argv, PETSC_NULL, PETSC_NULL));
     // Work around what seems to be an Intel compiler bug/quirk that makes the cache stale,
     // by using an explicit reset to ensure all code is aware we're running in parallel.
     PetscTools::ResetCache();
 }
 
-void PetscSetupUtils::CommonSetup()
+void PetscSetupUtils::CommonSetup(bool requestMpiThreadMultiple)
 {
-    InitialisePetsc();
+    InitialisePetsc(requestMpiThreadMultiple);
 
     if ((PETSC_VERSION_MAJOR < 3) || (PETSC_VERSION_MAJOR == 3 && PETSC_VERSION_MINOR < 5)) // PETSc 3.4 or earlier
     {
@@ -125,6 +138,15 @@ void PetscSetupUtils::CommonFinalize()
     Citations::Print();
 
     PETSCEXCEPT(PetscFinalize());
+
+    // PETSc only finalises MPI if it initialised it
+    int mpi_is_finalised;
+    MPI_Finalized(&mpi_is_finalised);
+    if (mMpiInitialisedHere && !mpi_is_finalised)
+    {
+        MPI_Finalize();
+        mMpiInitialisedHere = false;
+    }
 }
 
 void PetscSetupUtils::ResetStatusCache()
@@ -45,13 +45,23 @@ class PetscSetupUtils
 public:
     /**
      * The global setup for Chaste tests.
+     *
+     * @param requestMpiThreadMultiple  whether to initialise MPI with MPI_THREAD_MULTIPLE support
+     *     (see InitialisePetsc(); defaults to false)
      */
-    static void CommonSetup();
+    static void CommonSetup(bool requestMpiThreadMultiple=false);
 
     /**
      * Just initialise PETSc without performing the rest of the common setup.
+     *
+     * If requestMpiThreadMultiple is true, or the "-mpi_thread_multiple" command line option is
+     * given, MPI is first initialised with MPI_THREAD_MULTIPLE support (unless it has been
+     * initialised already), so that Hdf5DataWriter can make collective writes from its background
+     * I/O thread. This is not done by default as it may slow down other MPI calls.
+     *
+     * @param requestMpiThreadMultiple  whether to initialise MPI with MPI_THREAD_MULTIPLE support (defaults to false)
      */
-    static void InitialisePetsc();
+    static void InitialisePetsc(bool requestMpiThreadMultiple=false);
 
     /**
      * Call PetscTools::ResetCache().
@@ -60,11 +70,14 @@ public:
     static void ResetStatusCache();
 
     /**
-     * The global finalize (prints citations).
+     * The global finalize (prints citations). Also finalises MPI if it was initialised by InitialisePetsc().
      */
     static void CommonFinalize();
 
 private:
+
+    /** Whether MPI was initialised by InitialisePetsc() rather than by PETSc. */
+    static bool mMpiInitialisedHere;
 };
 
 #endif // PETSCSETUPUTILS_HPP_
@@ -0,0 +1,91 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef THREADINGTOOLS_HPP_
+#define THREADINGTOOLS_HPP_
+
+/**
+ * A helper class of static methods controlling shared-memory (OpenMP) threading.
+ *
+ * Threading is only available if Chaste was configured with Chaste_USE_OPENMP=ON,
+ * in which case CHASTE_OPENMP is defined. Otherwise all threaded loops run on a
+ * single thread and requests for more threads are ignored with a warning.
+ *
+ * The number of threads defaults to one, so that code run by existing users is
+ * unchanged unless they explicitly ask for more threads.
+ */
+class ThreadingTools
+{
+private:
+
+    /** The number of threads to be used by threaded loops. */
+    static unsigned mNumThreads;
+
+public:
+
+    /**
+     * @return whether Chaste was built with OpenMP support.
+     */
+    static bool IsThreadingAvailable();
+
+    /**
+     * Set the number of threads to be used by threaded loops.
+     *
+     * If Chaste was built without OpenMP support, a warning is issued and
+     * the number of threads remains one.
+     *
+     * @param numThreads the number of threads (must be at least one)
+     */
+    static void SetNumThreads(unsigned numThreads);
+
+    /**
+     * @return the number of threads to be used by threaded loops.
+     */
+    static unsigned GetNumThreads();
+
+    /**
+     * @return the maximum number of threads that OpenMP would use by default on
+     * this machine (e.g. as set by OMP_NUM_THREADS), or one if Chaste was built
+     * without OpenMP support.
+     */
+    static unsigned GetMaxNumThreads();
+
+    /**
+     * Reset the number of threads to one.
+     */
+    static void Reset();
+};
+
+#endif /*THREADINGTOOLS_HPP_*/
@@ -0,0 +1,127 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _TESTBACKGROUNDIOTHREAD_HPP_
+#define _TESTBACKGROUNDIOTHREAD_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include <future>
+#include <string>
+#include <vector>
+
+#include "BackgroundIoThread.hpp"
+#include "Exception.hpp"
+#include "FileComparison.hpp"
+#include "OutputFileHandler.hpp"
+//This test is always run sequentially (never in parallel)
+#include "FakePetscSetup.hpp"
+
+class TestBackgroundIoThread : public CxxTest::TestSuite
+{
+public:
+
+    void TestTasksRunInOrder()
+    {
+        std::vector<unsigned> order;
+        {
+            BackgroundIoThread io_thread;
+            for (unsigned i=0; i<100; i++)
+            {
+                io_thread.Enqueue([&order, i](){ order.push_back(i); });
+            }
+            io_thread.Flush();
+            TS_ASSERT_EQUALS(io_thread.GetNumPendingTasks(), 0u);
+            TS_ASSERT_EQUALS(order.size(), 100u);
+
+            // Tasks still queued on destruction are run
+            io_thread.Enqueue([&order](){ order.push_back(100); });
+        }
+        TS_ASSERT_EQUALS(order.size(), 101u);
+        for (unsigned i=0; i<order.size(); i++)
+        {
+            TS_ASSERT_EQUALS(order[i], i);
+        }
+    }
+
+    void TestWritingToFile()
+    {
+        OutputFileHandler handler("TestBackgroundIoThread");
+        out_stream p_file = handler.OpenOutputFile("background.txt");
+
+        BackgroundIoThread io_thread;
+        for (unsigned i=0; i<3; i++)
+        {
+            std::string line = "line " + std::to_string(i) + "\n";
+            io_thread.Enqueue([p_file, line](){ *p_file << line; });
+        }
+        io_thread.Flush();
+        p_file->close();
+
+        out_stream p_expected = handler.OpenOutputFile("expected.txt");
+        *p_expected << "line 0\nline 1\nline 2\n";
+        p_expected->close();
+
+        std::string dir = handler.GetOutputDirectoryFullPath();
+        FileComparison comparer(dir + "background.txt", dir + "expected.txt");
+        TS_ASSERT(comparer.CompareFiles());
+    }
+
+    void TestExceptions()
+    {
+        BackgroundIoThread io_thread;
+        unsigned num_run = 0;
+
+        // Hold the worker in the first task until all three tasks are queued
+        std::promise<void> all_queued;
+        std::shared_future<void> all_queued_future = all_queued.get_future().share();
+        io_thread.Enqueue([&num_run, all_queued_future](){ all_queued_future.wait(); num_run++; });
+        io_thread.Enqueue([](){ EXCEPTION("Disk full"); });
+        io_thread.Enqueue([&num_run](){ num_run++; });
+        TS_ASSERT_EQUALS(io_thread.GetNumPendingTasks(), 3u);
+        all_queued.set_value();
+
+        // The failing task's exception is rethrown, and the task queued after it is dropped
+        TS_ASSERT_THROWS_THIS(io_thread.Flush(), "Disk full");
+        TS_ASSERT_EQUALS(num_run, 1u);
+
+        // The thread can still be used afterwards
+        io_thread.Enqueue([&num_run](){ num_run++; });
+        io_thread.Flush();
+        TS_ASSERT_EQUALS(num_run, 2u);
+    }
+};
+
+#endif /*_TESTBACKGROUNDIOTHREAD_HPP_*/
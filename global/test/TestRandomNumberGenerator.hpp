@@ -37,6 +37,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define TESTRANDOMNUMBERGENERATOR_HPP_
 #include <cxxtest/TestSuite.h>
 
+#include <algorithm>
 #include <random>
 
 #include "CheckpointArchiveTypes.hpp"
@@ -243,6 +244,9 @@ public:
                 TS_ASSERT_EQUALS(p_gen, RandomNumberGenerator::Instance());
             }
 
+            // The seed of the counter-based streams is restored too
+            TS_ASSERT_EQUALS(p_gen->GetStreamSeed(), 7u);
+
             // Random Number generator restored; now check it generates the same numbers as the one we saved
             for (unsigned i = 0; i < generated_numbers.size(); i++)
             {
@@ -487,6 +491,96 @@ public:
         TS_ASSERT_DELTA(p_gen->ExponentialRandomDeviate(3.0), 0.2967, 1e-4);
         TS_ASSERT_DELTA(p_gen->ExponentialRandomDeviate(4.0), 0.2715, 1e-4);
     }
+
+    void TestCounterBasedStreams()
+    {
+        RandomNumberGenerator::Destroy();
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+        TS_ASSERT_EQUALS(p_gen->GetStreamSeed(), 0u);
+
+        // The first block of the stream with all keys zero is the Philox4x32-10 known-answer vector
+        {
+            RandomNumberStream stream = p_gen->GetStream(0u);
+            TS_ASSERT_DELTA(stream.ranf(), 0.39904647231489565, 1e-15);
+            TS_ASSERT_DELTA(stream.ranf(), 0.7357127860596914, 1e-15);
+        }
+
+        // Streams do not depend on the sequential generator, or on the order in which they are used
+        p_gen->Reseed(3);
+        std::vector<double> first_numbers;
+        for (unsigned stream_id = 0; stream_id < 10; stream_id++)
+        {
+            first_numbers.push_back(p_gen->GetStream(stream_id, 5u, 1u).ranf());
+            p_gen->ranf();
+        }
+        for (unsigned i = 0; i < 10; i++)
+        {
+            unsigned stream_id = 9 - i;
+            TS_ASSERT_EQUALS(p_gen->GetStream(stream_id, 5u, 1u).ranf(), first_numbers[stream_id]);
+        }
+
+        // Each key gives a different stream
+        double number = p_gen->GetStream(1u, 5u, 1u).ranf();
+        TS_ASSERT_DIFFERS(p_gen->GetStream(2u, 5u, 1u).ranf(), number);
+        TS_ASSERT_DIFFERS(p_gen->GetStream(1u, 6u, 1u).ranf(), number);
+        TS_ASSERT_DIFFERS(p_gen->GetStream(1u, 5u, 2u).ranf(), number);
+        p_gen->SetStreamSeed(4u);
+        TS_ASSERT_DIFFERS(p_gen->GetStream(1u, 5u, 1u).ranf(), number);
+
+        // Reseeding sets the stream seed
+        p_gen->Reseed(3);
+        TS_ASSERT_EQUALS(p_gen->GetStreamSeed(), 3u);
+        TS_ASSERT_EQUALS(p_gen->GetStream(1u, 5u, 1u).ranf(), number);
+
+        // Check the distributions have the right moments
+        RandomNumberStream stream = p_gen->GetStream(7u);
+        unsigned num_samples = 100000;
+        double sum_uniform = 0.0;
+        double sum_normal = 0.0;
+        double sum_normal_squared = 0.0;
+        double sum_exponential = 0.0;
+        double sum_gamma = 0.0;
+        double sum_small_shape_gamma = 0.0;
+        std::vector<unsigned> counts(6, 0u);
+        for (unsigned i = 0; i < num_samples; i++)
+        {
+            double uniform = stream.ranf();
+            TS_ASSERT(uniform >= 0.0 && uniform < 1.0);
+            sum_uniform += uniform;
+
+            double normal = stream.NormalRandomDeviate(1.0, 2.0);
+            sum_normal += normal;
+            sum_normal_squared += normal*normal;
+
+            sum_exponential += stream.ExponentialRandomDeviate(4.0);
+            sum_gamma += stream.GammaRandomDeviate(3.5, 2.0);
+            sum_small_shape_gamma += stream.GammaRandomDeviate(0.5, 2.0);
+
+            counts[stream.randMod(6)]++;
+        }
+        TS_ASSERT_DELTA(sum_uniform/num_samples, 0.5, 1e-2);
+        TS_ASSERT_DELTA(sum_normal/num_samples, 1.0, 2e-2);
+        TS_ASSERT_DELTA(sum_normal_squared/num_samples - 1.0, 4.0, 5e-2);
+        TS_ASSERT_DELTA(sum_exponential/num_samples, 0.25, 1e-2);
+        TS_ASSERT_DELTA(sum_gamma/num_samples, 7.0, 5e-2);
+        TS_ASSERT_DELTA(sum_small_shape_gamma/num_samples, 1.0, 2e-2);
+        for (unsigned i = 0; i < 6; i++)
+        {
+            TS_ASSERT_DELTA(counts[i]/double(num_samples), 1.0/6.0, 1e-2);
+        }
+
+        // Shuffling gives a permutation
+        std::vector<unsigned> shuffled;
+        stream.Shuffle(10, shuffled);
+        std::vector<unsigned> sorted(shuffled);
+        std::sort(sorted.begin(), sorted.end());
+        for (unsigned i = 0; i < 10; i++)
+        {
+            TS_ASSERT_EQUALS(sorted[i], i);
+        }
+
+        RandomNumberGenerator::Destroy();
+    }
 };
 
 #endif /*TESTRANDOMNUMBERGENERATOR_HPP_*/
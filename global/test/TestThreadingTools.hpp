@@ -0,0 +1,77 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _TESTTHREADINGTOOLS_HPP_
+#define _TESTTHREADINGTOOLS_HPP_
+
+#include <cxxtest/TestSuite.h>
+#include "ThreadingTools.hpp"
+#include "Warnings.hpp"
+#include "Exception.hpp"
+//This test is always run sequentially (never in parallel)
+#include "FakePetscSetup.hpp"
+
+class TestThreadingTools : public CxxTest::TestSuite
+{
+public:
+
+    void TestNumThreads()
+    {
+        // By default we run on one thread
+        TS_ASSERT_EQUALS(ThreadingTools::GetNumThreads(), 1u);
+        TS_ASSERT_LESS_THAN_EQUALS(1u, ThreadingTools::GetMaxNumThreads());
+
+        TS_ASSERT_THROWS_THIS(ThreadingTools::SetNumThreads(0), "The number of threads must be at least one");
+
+        ThreadingTools::SetNumThreads(4);
+        if (ThreadingTools::IsThreadingAvailable())
+        {
+            TS_ASSERT_EQUALS(ThreadingTools::GetNumThreads(), 4u);
+            TS_ASSERT_EQUALS(Warnings::Instance()->GetNumWarnings(), 0u);
+        }
+        else
+        {
+            TS_ASSERT_EQUALS(ThreadingTools::GetNumThreads(), 1u);
+            TS_ASSERT_EQUALS(ThreadingTools::GetMaxNumThreads(), 1u);
+            TS_ASSERT_EQUALS(Warnings::Instance()->GetNumWarnings(), 1u);
+            Warnings::QuietDestroy();
+        }
+
+        ThreadingTools::Reset();
+        TS_ASSERT_EQUALS(ThreadingTools::GetNumThreads(), 1u);
+    }
+};
+
+#endif /*_TESTTHREADINGTOOLS_HPP_*/
@@ -67,6 +67,11 @@ void AbstractCardiacCell::SetTimestep(double dt)
     mDt = dt;
 }
 
+double AbstractCardiacCell::GetTimestep() const
+{
+    return mDt;
+}
+
 void AbstractCardiacCell::SolveAndUpdateState(double tStart, double tEnd)
 {
     mpOdeSolver->SolveAndUpdateStateVariable(this, tStart, tEnd, mDt);
@@ -104,6 +109,11 @@ void AbstractCardiacCell::ComputeExceptVoltage(double tStart, double tEnd)
 #endif // NDEBUG
 }
 
+AbstractCardiacCellBatch* AbstractCardiacCell::CreateCellBatch()
+{
+    return NULL;
+}
+
 void AbstractCardiacCell::SetVoltage(double voltage)
 {
     SetAnyVariable(mVoltageIndex, voltage);
@@ -54,6 +54,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <vector>
 
+class AbstractCardiacCellBatch;
+
 typedef enum _CellModelState
 {
     STATE_UNSET = 0,
@@ -172,6 +174,11 @@ public:
      */
     void SetTimestep(double dt);
 
+    /**
+     * @return the timestep used for simulating this cell.
+     */
+    double GetTimestep() const;
+
     /**
      * Simulate this cell's behaviour between the time interval [tStart, tEnd],
      * with timestemp #mDt, updating the internal state variable values.
@@ -201,6 +208,18 @@ public:
      */
     virtual void ComputeExceptVoltage(double tStart, double tEnd);
 
+    /**
+     * Create an empty batch to which this cell, and other cells of the same model, can be
+     * added in order to be solved together (see AbstractCardiacCellBatch).
+     *
+     * The default implementation returns NULL, meaning this model has no batched version.
+     * Models which provide one should only return a batch when they are not subclassed,
+     * since a subclass may change the equations.
+     *
+     * @return a new batch, which the caller takes ownership of, or NULL
+     */
+    virtual AbstractCardiacCellBatch* CreateCellBatch();
+
     /** Set the transmembrane potential
      * @param voltage  new value
      */
@@ -0,0 +1,244 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "AbstractCardiacCellBatch.hpp"
+
+#include <cassert>
+#include <climits>
+#include <cmath>
+#include <typeinfo>
+
+#include "EulerIvpOdeSolver.hpp"
+#include "TimeStepper.hpp"
+
+AbstractCardiacCellBatch::AbstractCardiacCellBatch(unsigned numStateVariables, unsigned voltageIndex)
+    : mDt(0.0),
+      mUseRushLarsen(false),
+      mNumStateVariables(numStateVariables),
+      mVoltageIndex(voltageIndex),
+      mSetVoltageDerivativeToZero(false)
+{
+}
+
+AbstractCardiacCellBatch::~AbstractCardiacCellBatch()
+{
+}
+
+bool AbstractCardiacCellBatch::CanAddCell(AbstractCardiacCell* pCell) const
+{
+    if (!dynamic_cast<EulerIvpOdeSolver*>(pCell->GetSolver().get())
+        || pCell->GetNumberOfStateVariables() != mNumStateVariables)
+    {
+        return false;
+    }
+    if (mCells.empty())
+    {
+        return true;
+    }
+
+    AbstractCardiacCell* p_first_cell = mCells[0];
+    if (typeid(*pCell) != typeid(*p_first_cell)
+        || pCell->GetTimestep() != mDt
+        || pCell->GetNumberOfParameters() != p_first_cell->GetNumberOfParameters())
+    {
+        return false;
+    }
+    for (unsigned i=0; i<p_first_cell->GetNumberOfParameters(); i++)
+    {
+        if (pCell->GetParameter(i) != p_first_cell->GetParameter(i))
+        {
+            return false;
+        }
+    }
+    return HasSameSettings(pCell, p_first_cell);
+}
+
+bool AbstractCardiacCellBatch::HasSameSettings(AbstractCardiacCell* pCell, AbstractCardiacCell* pFirstCell) const
+{
+    return true;
+}
+
+double AbstractCardiacCellBatch::GetStimulus(AbstractCardiacCell* pCell, double time)
+{
+    return pCell->GetIntracellularAreaStimulus(time);
+}
+
+AbstractCardiacCell* AbstractCardiacCellBatch::GetCell(unsigned index) const
+{
+    assert(index < mCells.size());
+    return mCells[index];
+}
+
+void AbstractCardiacCellBatch::AddCell(AbstractCardiacCell* pCell)
+{
+    assert(CanAddCell(pCell));
+    if (mCells.empty())
+    {
+        mDt = pCell->GetTimestep();
+    }
+    mCells.push_back(pCell);
+}
+
+unsigned AbstractCardiacCellBatch::GetNumCells() const
+{
+    return mCells.size();
+}
+
+void AbstractCardiacCellBatch::SetUseRushLarsen(bool useRushLarsen)
+{
+    mUseRushLarsen = useRushLarsen;
+}
+
+bool AbstractCardiacCellBatch::GetUseRushLarsen() const
+{
+    return mUseRushLarsen;
+}
+
+void AbstractCardiacCellBatch::ComputeExceptVoltage(double tStart, double tEnd)
+{
+    Solve(tStart, tEnd, false);
+}
+
+void AbstractCardiacCellBatch::SolveAndUpdateState(double tStart, double tEnd)
+{
+    Solve(tStart, tEnd, true);
+}
+
+void AbstractCardiacCellBatch::Solve(double tStart, double tEnd, bool updateVoltage)
+{
+    const unsigned num_cells = mCells.size();
+    const unsigned num_entries = mNumStateVariables*num_cells;
+    const unsigned num_gating_entries = mGatingVariableIndices.size()*num_cells;
+    if (num_cells == 0)
+    {
+        return;
+    }
+
+    // Find which gating variable, if any, each state variable is
+    std::vector<unsigned> gating_index(mNumStateVariables, UINT_MAX);
+    for (unsigned j=0; j<mGatingVariableIndices.size(); j++)
+    {
+        assert(mGatingVariableIndices[j] < mNumStateVariables);
+        gating_index[mGatingVariableIndices[j]] = j;
+    }
+
+    // Gather the state of the cells into struct-of-arrays layout
+    mStateVariables.resize(num_entries);
+    mDerivatives.resize(num_entries);
+    mGatingSteadyStates.resize(num_gating_entries);
+    mGatingTimeConstants.resize(num_gating_entries);
+    mStimuli.resize(num_cells);
+    for (unsigned c=0; c<num_cells; c++)
+    {
+        const std::vector<double>& r_state = mCells[c]->rGetStateVariables();
+        for (unsigned i=0; i<mNumStateVariables; i++)
+        {
+            mStateVariables[i*num_cells + c] = r_state[i];
+        }
+    }
+
+    // Forward Euler, or Rush-Larsen for gating variables, stepping exactly as AbstractOneStepIvpOdeSolver does
+    mSetVoltageDerivativeToZero = !updateVoltage;
+    double* p_y = mStateVariables.data();
+    double* p_dy = mDerivatives.data();
+    double* p_inf = mGatingSteadyStates.data();
+    double* p_tau = mGatingTimeConstants.data();
+    TimeStepper stepper(tStart, tEnd, mDt);
+    while (!stepper.IsTimeAtEnd())
+    {
+        const double time = stepper.GetTime();
+        const double dt = stepper.GetNextTimeStep();
+        for (unsigned c=0; c<num_cells; c++)
+        {
+            mStimuli[c] = GetStimulus(mCells[c], time);
+        }
+
+        EvaluateEquations(time, p_y, mStimuli.data(), p_dy, p_inf, p_tau);
+
+        for (unsigned i=0; i<mNumStateVariables; i++)
+        {
+            double* p_y_i = p_y + i*num_cells;
+            if (gating_index[i] == UINT_MAX)
+            {
+                const double* p_dy_i = p_dy + i*num_cells;
+                for (unsigned c=0; c<num_cells; c++)
+                {
+                    p_y_i[c] = p_y_i[c] + dt*p_dy_i[c];
+                }
+            }
+            else
+            {
+                const double* p_inf_i = p_inf + gating_index[i]*num_cells;
+                const double* p_tau_i = p_tau + gating_index[i]*num_cells;
+                if (mUseRushLarsen)
+                {
+                    for (unsigned c=0; c<num_cells; c++)
+                    {
+                        p_y_i[c] = p_inf_i[c] + (p_y_i[c] - p_inf_i[c])*exp(-dt/p_tau_i[c]);
+                    }
+                }
+                else
+                {
+                    // The derivative is formed as the single-cell models do, so results match
+                    for (unsigned c=0; c<num_cells; c++)
+                    {
+                        p_y_i[c] = p_y_i[c] + dt*((p_inf_i[c] - p_y_i[c])/p_tau_i[c]);
+                    }
+                }
+            }
+        }
+        stepper.AdvanceOneTimeStep();
+    }
+    mSetVoltageDerivativeToZero = false;
+
+    // Scatter the new state back to the cells
+    for (unsigned c=0; c<num_cells; c++)
+    {
+        AbstractCardiacCell* p_cell = mCells[c];
+        const double saved_voltage = p_cell->GetVoltage();
+        std::vector<double>& r_state = p_cell->rGetStateVariables();
+        for (unsigned i=0; i<mNumStateVariables; i++)
+        {
+            r_state[i] = mStateVariables[i*num_cells + c];
+        }
+        if (!updateVoltage)
+        {
+            p_cell->SetVoltage(saved_voltage);
+        }
+#ifndef NDEBUG
+        p_cell->VerifyStateVariables();
+#endif // NDEBUG
+    }
+}
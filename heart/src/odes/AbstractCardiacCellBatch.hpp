@@ -0,0 +1,240 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef ABSTRACTCARDIACCELLBATCH_HPP_
+#define ABSTRACTCARDIACCELLBATCH_HPP_
+
+#include <vector>
+
+#include "AbstractCardiacCell.hpp"
+
+/**
+ * Base class for batched cardiac cell models, which integrate the ODEs of many cells
+ * of the same model together.
+ *
+ * A batch holds the state variables of its cells in struct-of-arrays layout, so that
+ * variable i of cell c is stored at entry i*GetNumCells() + c, and concrete classes
+ * evaluate the right-hand side of the model for every cell in a single call to
+ * EvaluateYDerivatives(). Written as simple loops over cells, with no calls to virtual
+ * methods, these kernels can be vectorised by the compiler.
+ *
+ * The cells themselves remain the owners of their state. Each call to
+ * ComputeExceptVoltage() or SolveAndUpdateState() copies the state of the cells into
+ * the batch, integrates it with the forward Euler method, and copies it back, so that
+ * the cells may be used as normal between solves. The step arithmetic is that of
+ * EulerIvpOdeSolver, so results match solving each cell separately with that solver.
+ *
+ * Models may declare some of their state variables to be gating variables, of the form
+ * dy/dt = (y_inf - y)/tau, by filling in #mGatingVariableIndices. Their kernels then give
+ * y_inf and tau for these variables instead of the derivative. With SetUseRushLarsen(), the
+ * gating variables are updated exactly over each step, as by the Rush-Larsen method, and
+ * the other state variables with forward Euler. Since the gating equations are linear in
+ * the gating variable, this is also the first order generalised Rush-Larsen (GRL1) update
+ * for them. This changes the results compared with solving each cell with EulerIvpOdeSolver,
+ * but allows larger time steps.
+ *
+ * Cells can be added to a batch if they are of the same class as the first cell added,
+ * are solved by an EulerIvpOdeSolver with the same time step, and have the same parameter
+ * values (see CanAddCell()). Batches are created by AbstractCardiacCell::CreateCellBatch().
+ */
+class AbstractCardiacCellBatch
+{
+private:
+
+    /** The cells in this batch. */
+    std::vector<AbstractCardiacCell*> mCells;
+
+    /** The time step used to solve the cells in this batch. */
+    double mDt;
+
+    /** The state variables of the cells, in struct-of-arrays layout. */
+    std::vector<double> mStateVariables;
+
+    /** The derivatives of the state variables of the cells, in struct-of-arrays layout. */
+    std::vector<double> mDerivatives;
+
+    /** The steady states of the gating variables of the cells, in struct-of-arrays layout. */
+    std::vector<double> mGatingSteadyStates;
+
+    /** The time constants of the gating variables of the cells, in struct-of-arrays layout. */
+    std::vector<double> mGatingTimeConstants;
+
+    /** The stimulus of each cell at the current time (see GetStimulus()). */
+    std::vector<double> mStimuli;
+
+    /** Whether to update the gating variables with the Rush-Larsen method. */
+    bool mUseRushLarsen;
+
+    /**
+     * Integrate the ODEs of every cell from tStart to tEnd, using the forward Euler method,
+     * or the Rush-Larsen method for gating variables if #mUseRushLarsen is set.
+     *
+     * @param tStart  beginning of the time interval to simulate
+     * @param tEnd  end of the time interval to simulate
+     * @param updateVoltage  whether to integrate the transmembrane potential too
+     */
+    void Solve(double tStart, double tEnd, bool updateVoltage);
+
+protected:
+
+    /** The number of state variables of the model. */
+    unsigned mNumStateVariables;
+
+    /** The index of the transmembrane potential within the state variables of the model. */
+    unsigned mVoltageIndex;
+
+    /**
+     * Whether to set the derivative of the transmembrane potential to zero, as
+     * AbstractCardiacCellInterface::SetVoltageDerivativeToZero() does for a single cell.
+     */
+    bool mSetVoltageDerivativeToZero;
+
+    /**
+     * The indices, within the state variables of the model, of its gating variables.
+     * Filled in by the constructors of concrete classes. Empty by default.
+     */
+    std::vector<unsigned> mGatingVariableIndices;
+
+    /**
+     * Evaluate the right-hand side of the model for every cell in the batch.
+     *
+     * All arrays are in struct-of-arrays layout, with GetNumCells() entries per variable.
+     * For the state variables that are not gating variables, implementations fill in pDY,
+     * using the same arithmetic as the EvaluateYDerivatives() method of the corresponding
+     * single-cell model, and must honour #mSetVoltageDerivativeToZero. For the j-th gating
+     * variable in #mGatingVariableIndices, they instead fill in entry j of pGatingSteadyStates
+     * and pGatingTimeConstants, and the corresponding entries of pDY are ignored.
+     *
+     * @param time  the current time, in milliseconds
+     * @param pY  the current values of the state variables
+     * @param pStimuli  the stimulus of each cell at this time (see GetStimulus())
+     * @param pDY  to be filled in with the derivatives
+     * @param pGatingSteadyStates  to be filled in with the steady states of the gating variables
+     * @param pGatingTimeConstants  to be filled in with the time constants of the gating variables
+     */
+    virtual void EvaluateEquations(double time, const double* pY, const double* pStimuli, double* pDY,
+                                   double* pGatingSteadyStates, double* pGatingTimeConstants)=0;
+
+    /**
+     * @return the stimulus of a cell at the given time, as used by the model's equations.
+     * The default implementation returns the intracellular area stimulus.
+     *
+     * @param pCell  a cell in this batch
+     * @param time  the current time, in milliseconds
+     */
+    virtual double GetStimulus(AbstractCardiacCell* pCell, double time);
+
+    /**
+     * @return whether a cell has the same values of any model-specific settings, which
+     * are not parameters, as the first cell in the batch. Used by CanAddCell(), and only
+     * called for cells of the same class as the first cell. The default implementation
+     * returns true.
+     *
+     * @param pCell  the cell
+     * @param pFirstCell  the first cell in the batch
+     */
+    virtual bool HasSameSettings(AbstractCardiacCell* pCell, AbstractCardiacCell* pFirstCell) const;
+
+    /**
+     * @return a cell in this batch.
+     *
+     * @param index  the index of the cell in the batch
+     */
+    AbstractCardiacCell* GetCell(unsigned index) const;
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param numStateVariables  the number of state variables of the model
+     * @param voltageIndex  the index of the transmembrane potential within the state variables
+     */
+    AbstractCardiacCellBatch(unsigned numStateVariables, unsigned voltageIndex);
+
+    /** Virtual destructor. */
+    virtual ~AbstractCardiacCellBatch();
+
+    /**
+     * @return whether a cell can be added to this batch: it must be of the same class as
+     *     the cells already in the batch, be solved by an EulerIvpOdeSolver with the same time
+     *     step, and have the same parameter values and settings (see HasSameSettings()).
+     *
+     * @param pCell  the cell
+     */
+    bool CanAddCell(AbstractCardiacCell* pCell) const;
+
+    /**
+     * Add a cell to this batch. The batch does not take ownership of the cell.
+     *
+     * @param pCell  the cell, for which CanAddCell() must be true
+     */
+    void AddCell(AbstractCardiacCell* pCell);
+
+    /** @return the number of cells in this batch. */
+    unsigned GetNumCells() const;
+
+    /**
+     * Set whether to update the gating variables of the model with the Rush-Larsen method,
+     * rather than forward Euler. Has no effect for models without gating variables.
+     * Defaults to false.
+     *
+     * @param useRushLarsen  whether to use the Rush-Larsen method
+     */
+    void SetUseRushLarsen(bool useRushLarsen);
+
+    /** @return whether the gating variables are updated with the Rush-Larsen method. */
+    bool GetUseRushLarsen() const;
+
+    /**
+     * Simulate every cell in the batch between tStart and tEnd without updating the
+     * transmembrane potential, as AbstractCardiacCell::ComputeExceptVoltage() does.
+     *
+     * @param tStart  beginning of the time interval to simulate
+     * @param tEnd  end of the time interval to simulate
+     */
+    void ComputeExceptVoltage(double tStart, double tEnd);
+
+    /**
+     * Simulate every cell in the batch between tStart and tEnd, including the transmembrane
+     * potential, as AbstractCardiacCell::SolveAndUpdateState() does.
+     *
+     * @param tStart  beginning of the time interval to simulate
+     * @param tEnd  end of the time interval to simulate
+     */
+    void SolveAndUpdateState(double tStart, double tEnd);
+};
+
+#endif /*ABSTRACTCARDIACCELLBATCH_HPP_*/
@@ -33,8 +33,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 */
 #include "FitzHughNagumo1961OdeSystem.hpp"
+#include "FitzHughNagumo1961OdeSystemBatch.hpp"
 #include "OdeSystemInformation.hpp"
 #include <cmath>
+#include <typeinfo>
 
 //
 // Model-scope constant parameters
@@ -89,6 +91,15 @@ double FitzHughNagumo1961OdeSystem::GetIIonic(const std::vector<double>* pStateV
     return fake_ionic_current;
 }
 
+AbstractCardiacCellBatch* FitzHughNagumo1961OdeSystem::CreateCellBatch()
+{
+    if (typeid(*this) != typeid(FitzHughNagumo1961OdeSystem))
+    {
+        return NULL;
+    }
+    return new FitzHughNagumo1961OdeSystemBatch;
+}
+
 template<>
 void OdeSystemInformation<FitzHughNagumo1961OdeSystem>::Initialise(void)
 {
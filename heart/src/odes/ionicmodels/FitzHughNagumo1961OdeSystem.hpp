@@ -44,6 +44,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 class FitzHughNagumo1961OdeSystem : public AbstractCardiacCell
 {
+    /** The batched version of this model shares its constants. */
+    friend class FitzHughNagumo1961OdeSystemBatch;
+
 private:
     static const double mAlpha; /**< Constant parameter alpha */
     static const double mGamma; /**< Constant parameter gamma */
@@ -82,6 +85,14 @@ public:
      * @return the total ionic current
      */
     double GetIIonic(const std::vector<double>* pStateVariables=NULL);
+
+    /**
+     * Overridden method to create a FitzHughNagumo1961OdeSystemBatch, if this cell is
+     * not an instance of a subclass.
+     *
+     * @return a new batch, or NULL
+     */
+    AbstractCardiacCellBatch* CreateCellBatch();
 };
 
 #endif //_FITZHUGHNAGUMO1961ODESYSTEM_HPP_
@@ -0,0 +1,79 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "FitzHughNagumo1961OdeSystemBatch.hpp"
+#include "FitzHughNagumo1961OdeSystem.hpp"
+
+FitzHughNagumo1961OdeSystemBatch::FitzHughNagumo1961OdeSystemBatch()
+    : AbstractCardiacCellBatch(2, 0)
+{
+}
+
+void FitzHughNagumo1961OdeSystemBatch::EvaluateEquations(double time, const double* pY, const double* pStimuli, double* pDY,
+                                                         double* pGatingSteadyStates, double* pGatingTimeConstants)
+{
+    const unsigned num_cells = GetNumCells();
+    const double alpha = FitzHughNagumo1961OdeSystem::mAlpha;
+    const double gamma = FitzHughNagumo1961OdeSystem::mGamma;
+    const double epsilon = FitzHughNagumo1961OdeSystem::mEpsilon;
+
+    const double* p_membrane_V = pY; // v
+    const double* p_recovery_variable = pY + num_cells; // w
+    double* p_membrane_V_prime = pDY;
+    double* p_recovery_variable_prime = pDY + num_cells;
+
+    // dV/dt
+    if (mSetVoltageDerivativeToZero)
+    {
+        for (unsigned c=0; c<num_cells; c++)
+        {
+            p_membrane_V_prime[c] = 0;
+        }
+    }
+    else
+    {
+        for (unsigned c=0; c<num_cells; c++)
+        {
+            const double membrane_V = p_membrane_V[c];
+            p_membrane_V_prime[c] = membrane_V*(membrane_V-alpha)*(1-membrane_V)-p_recovery_variable[c]+pStimuli[c];
+        }
+    }
+
+    // dw/dt
+    for (unsigned c=0; c<num_cells; c++)
+    {
+        p_recovery_variable_prime[c] = epsilon*(p_membrane_V[c]-gamma*p_recovery_variable[c]);
+    }
+}
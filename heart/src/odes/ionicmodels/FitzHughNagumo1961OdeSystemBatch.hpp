@@ -0,0 +1,69 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _FITZHUGHNAGUMO1961ODESYSTEMBATCH_HPP_
+#define _FITZHUGHNAGUMO1961ODESYSTEMBATCH_HPP_
+
+#include "AbstractCardiacCellBatch.hpp"
+
+/**
+ * Batched version of FitzHughNagumo1961OdeSystem, which evaluates the right-hand side
+ * of the model for many cells at once.
+ */
+class FitzHughNagumo1961OdeSystemBatch : public AbstractCardiacCellBatch
+{
+protected:
+    /**
+     * Compute the RHS of the FitzHugh-Nagumo system of ODEs for every cell in the batch.
+     * The model has no gating variables.
+     *
+     * @param time  the current time, in milliseconds
+     * @param pY  current values of the state variables
+     * @param pStimuli  the intracellular area stimulus of each cell
+     * @param pDY  to be filled in with derivatives
+     * @param pGatingSteadyStates  not used
+     * @param pGatingTimeConstants  not used
+     */
+    void EvaluateEquations(double time, const double* pY, const double* pStimuli, double* pDY,
+                           double* pGatingSteadyStates, double* pGatingTimeConstants);
+
+public:
+    /**
+     * Constructor.
+     */
+    FitzHughNagumo1961OdeSystemBatch();
+};
+
+#endif //_FITZHUGHNAGUMO1961ODESYSTEMBATCH_HPP_
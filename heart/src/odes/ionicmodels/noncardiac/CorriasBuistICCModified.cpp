@@ -34,9 +34,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 */
 
 #include "CorriasBuistICCModified.hpp"
+#include "CorriasBuistICCModifiedBatch.hpp"
 #include <cmath>
 #include <cassert>
 #include <memory>
+#include <typeinfo>
 #include "Exception.hpp"
 #include "OdeSystemInformation.hpp"
 #include "HeartConfig.hpp"
@@ -420,6 +422,15 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
         rDY[17] = (f_inf_kv11-rY[17])/tau_f_kv11;
     }
 
+    AbstractCardiacCellBatch* CorriasBuistICCModified::CreateCellBatch()
+    {
+        if (typeid(*this) != typeid(CorriasBuistICCModified))
+        {
+            return NULL;
+        }
+        return new CorriasBuistICCModifiedBatch;
+    }
+
 template<>
 void OdeSystemInformation<CorriasBuistICCModified>::Initialise(void)
 {
@@ -58,6 +58,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 class CorriasBuistICCModified : public AbstractCardiacCell
 {
+    /** The batched version of this model shares its constants. */
+    friend class CorriasBuistICCModifiedBatch;
+
     friend class boost::serialization::access;
     /**
      * Boost Serialization method for archiving/checkpointing.
@@ -276,6 +279,14 @@ public:
      * @return the Carbon Monoxide scale factor
      */
     double GetCarbonMonoxideScaleFactor();
+
+    /**
+     * Overridden method to create a CorriasBuistICCModifiedBatch, if this cell is
+     * not an instance of a subclass.
+     *
+     * @return a new batch, or NULL
+     */
+    AbstractCardiacCellBatch* CreateCellBatch();
 };
 
 
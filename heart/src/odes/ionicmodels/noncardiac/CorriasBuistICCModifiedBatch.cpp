@@ -0,0 +1,260 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+#include "CorriasBuistICCModifiedBatch.hpp"
+#include "CorriasBuistICCModified.hpp"
+
+#include <cmath>
+
+CorriasBuistICCModifiedBatch::CorriasBuistICCModifiedBatch()
+    : AbstractCardiacCellBatch(18, 0)
+{
+    // d_CaCl, d_ERG, d_Ltype, d_NSCC, d_Na, d_VDDR, d_kv11, f_Ltype, f_Na, f_VDDR, f_ca_Ltype, f_kv11
+    for (unsigned i=6; i<=17; i++)
+    {
+        mGatingVariableIndices.push_back(i);
+    }
+}
+
+double CorriasBuistICCModifiedBatch::GetStimulus(AbstractCardiacCell* pCell, double time)
+{
+    return pCell->GetStimulus(time);
+}
+
+bool CorriasBuistICCModifiedBatch::HasSameSettings(AbstractCardiacCell* pCell, AbstractCardiacCell* pFirstCell) const
+{
+    CorriasBuistICCModified* p_cell = static_cast<CorriasBuistICCModified*>(pCell);
+    CorriasBuistICCModified* p_first_cell = static_cast<CorriasBuistICCModified*>(pFirstCell);
+    return p_cell->mFractionOfVDDRInPU == p_first_cell->mFractionOfVDDRInPU
+           && p_cell->mIP3Concentration == p_first_cell->mIP3Concentration
+           && p_cell->mScaleFactorSerca == p_first_cell->mScaleFactorSerca
+           && p_cell->mScaleFactorCarbonMonoxide == p_first_cell->mScaleFactorCarbonMonoxide
+           && p_cell->Asurf == p_first_cell->Asurf;
+}
+
+void CorriasBuistICCModifiedBatch::EvaluateEquations(double time, const double* pY, const double* pStimuli, double* pDY,
+                                                     double* pGatingSteadyStates, double* pGatingTimeConstants)
+{
+    const unsigned n = GetNumCells();
+
+    // All cells in the batch have the same constants (see HasSameSettings())
+    const CorriasBuistICCModified& r_model = *static_cast<CorriasBuistICCModified*>(GetCell(0));
+    const double fraction_VDDR_in_PU = r_model.mFractionOfVDDRInPU;
+    const double co_scale_factor = r_model.mScaleFactorCarbonMonoxide;
+    const double serca_scale_factor = r_model.mScaleFactorSerca;
+    const double Ca_o = r_model.Ca_o;
+    const double F = r_model.F;
+    const double FoRT = r_model.FoRT;
+    const double RToF = r_model.RToF;
+    const double Asurf = r_model.Asurf;
+    const double Na_i = r_model.Na_i;
+    const double fc = r_model.fc;
+    const double fe = r_model.fe;
+    const double fm = r_model.fm;
+    const double G_max_BK = r_model.G_max_BK;
+    const double G_max_CaCl = r_model.G_max_CaCl;
+    const double G_max_ERG = r_model.G_max_ERG;
+    const double G_max_Ltype = r_model.G_max_Ltype;
+    const double G_max_NSCC = r_model.G_max_NSCC;
+    const double G_max_Na = r_model.G_max_Na;
+    const double G_max_VDDR = r_model.G_max_VDDR;
+    const double G_max_bk = r_model.G_max_bk;
+    const double G_max_kv11 = r_model.G_max_kv11;
+    const double J_max_PMCA = r_model.J_max_PMCA;
+    const double J_max_PMCA_PU = r_model.J_max_PMCA_PU;
+    const double J_ERleak = r_model.J_ERleak;
+    const double J_max_leak = r_model.J_max_leak;
+    const double Jmax_IP3 = r_model.Jmax_IP3;
+    const double Jmax_NaCa = r_model.Jmax_NaCa;
+    const double Jmax_serca = r_model.Jmax_serca;
+    const double Jmax_uni = r_model.Jmax_uni;
+    const double L = r_model.L;
+    const double na = r_model.na;
+    const double K_Ca = r_model.K_Ca;
+    const double K_Na = r_model.K_Na;
+    const double K_act = r_model.K_act;
+    const double K_trans = r_model.K_trans;
+    const double k_serca = r_model.k_serca;
+    const double conc = r_model.conc;
+    const double d_ACT = r_model.d_ACT;
+    const double d_INH = r_model.d_INH;
+    const double tau_d_CaCl = r_model.tau_d_CaCl;
+    const double tau_d_NSCC = r_model.tau_d_NSCC;
+    const double tauh = r_model.tauh;
+    const double deltaPsi_star = r_model.deltaPsi_star;
+    const double deltaPsi = r_model.deltaPsi;
+    const double V_cyto = r_model.V_cyto;
+    const double V_ER = r_model.V_ER;
+    const double V_MITO = r_model.V_MITO;
+    const double V_PU = r_model.V_PU;
+    const double T_correction_BK = r_model.T_correction_BK;
+    const double E_Na = r_model.E_Na;
+    const double E_K = r_model.E_K;
+    const double E_Cl = r_model.E_Cl;
+    const double E_NSCC = r_model.E_NSCC;
+    const double tau_d_ERG = r_model.tau_d_ERG;
+    const double tau_d_Ltype = r_model.tau_d_Ltype;
+    const double tau_d_Na = r_model.tau_d_Na;
+    const double tau_d_VDDR = r_model.tau_d_VDDR;
+    const double tau_d_kv11 = r_model.tau_d_kv11;
+    const double tau_f_Ltype = r_model.tau_f_Ltype;
+    const double tau_f_Na = r_model.tau_f_Na;
+    const double tau_f_VDDR = r_model.tau_f_VDDR;
+    const double tau_f_ca_Ltype = r_model.tau_f_ca_Ltype;
+    const double tau_f_kv11 = r_model.tau_f_kv11;
+    const double e2FoRTdPsiMdPsiS = r_model.e2FoRTdPsiMdPsiS;
+    const double ebFoRTdPsiMdPsiS = r_model.ebFoRTdPsiMdPsiS;
+
+    // Terms which are the same for every cell
+    const double ip3_term = r_model.mIP3Concentration/(r_model.mIP3Concentration+r_model.d_IP3);
+    const double J_NaCa_numerator = Jmax_NaCa*ebFoRTdPsiMdPsiS;
+    const double J_NaCa_Na_term = (1.0+K_Na*K_Na/(Na_i*Na_i));
+    const bool set_voltage_derivative_to_zero = mSetVoltageDerivativeToZero;
+
+    const double* p_Vm = pY;
+    const double* p_Ca_i = pY + n;
+    const double* p_Ca_ER = pY + 2*n;
+    const double* p_Ca_PU = pY + 3*n;
+    const double* p_Ca_m = pY + 4*n;
+    const double* p_h = pY + 5*n;
+    const double* p_d_CaCl = pY + 6*n;
+    const double* p_d_ERG = pY + 7*n;
+    const double* p_d_Ltype = pY + 8*n;
+    const double* p_d_NSCC = pY + 9*n;
+    const double* p_d_Na = pY + 10*n;
+    const double* p_d_VDDR = pY + 11*n;
+    const double* p_d_kv11 = pY + 12*n;
+    const double* p_f_Ltype = pY + 13*n;
+    const double* p_f_Na = pY + 14*n;
+    const double* p_f_VDDR = pY + 15*n;
+    const double* p_f_ca_Ltype = pY + 16*n;
+    const double* p_f_kv11 = pY + 17*n;
+
+    double* p_inf = pGatingSteadyStates;
+    double* p_tau = pGatingTimeConstants;
+
+    for (unsigned c=0; c<n; c++)
+    {
+        const double Vm = p_Vm[c];
+        const double Ca_i = p_Ca_i[c];
+        const double Ca_ER = p_Ca_ER[c];
+        const double Ca_PU = p_Ca_PU[c];
+        const double Ca_m = p_Ca_m[c];
+        const double h = p_h[c];
+
+        /* ----------------- */
+        /* Membrane currents */
+        /* ----------------- */
+
+        double E_Ca = 0.5*RToF*log(Ca_o/Ca_i);
+        double I_Na = G_max_Na*p_f_Na[c]*p_d_Na[c]*(Vm-E_Na);
+        double I_Ltype = G_max_Ltype*p_f_Ltype[c]*p_d_Ltype[c]*p_f_ca_Ltype[c]*(Vm-E_Ca);
+        double I_VDDR = G_max_VDDR*p_f_VDDR[c]*p_d_VDDR[c]*(Vm-E_Ca);
+        double I_kv11 = co_scale_factor*G_max_kv11*p_f_kv11[c]*p_d_kv11[c]*(Vm-E_K);
+        double I_ERG = co_scale_factor*G_max_ERG*p_d_ERG[c]*(Vm-E_K);
+        double d_BK = 1.0/(1.0+((exp(Vm/-17.0))/((Ca_i/0.001)*(Ca_i/0.001))));
+        double I_BK = (G_max_BK+T_correction_BK)*d_BK*(Vm-E_K);
+        double I_bk = co_scale_factor*G_max_bk*(Vm-E_K);
+        double I_CaCl = G_max_CaCl*p_d_CaCl[c]*(Vm-E_Cl);
+        double I_NSCC = G_max_NSCC*p_d_NSCC[c]*(Vm-E_NSCC);
+        double J_PMCA = J_max_PMCA*1.0/(1.0+(0.000298/Ca_i));
+
+        /* ----------------- */
+        /* ER fluxes         */
+        /* ----------------- */
+
+        double tmp2 = Ca_PU/(Ca_PU+d_ACT);
+        double J_ERout = (Jmax_IP3*ip3_term*ip3_term*ip3_term*tmp2*tmp2*tmp2*h*h*h+J_ERleak)*(Ca_ER-Ca_PU);
+        double J_SERCA = serca_scale_factor*Jmax_serca*Ca_PU*Ca_PU/(k_serca*k_serca+Ca_PU*Ca_PU);
+
+        /* ----------------- */
+        /* Mito fluxes       */
+        /* ----------------- */
+
+        double tmp1 = 1.0+Ca_PU/K_trans;
+        double MWC = conc*(Ca_PU/K_trans)*tmp1*tmp1*tmp1/(tmp1*tmp1*tmp1*tmp1+L/pow(1.0+Ca_PU/K_act, na));
+        double J_uni = Jmax_uni*(MWC-Ca_m*e2FoRTdPsiMdPsiS)*2.0*FoRT*(deltaPsi-deltaPsi_star)/(1.0-e2FoRTdPsiMdPsiS);
+        double J_NaCa = J_NaCa_numerator/(J_NaCa_Na_term*(1.0+K_Ca/Ca_m));
+
+        /* ----------------- */
+        /* Cyto fluxes       */
+        /* ----------------- */
+
+        double J_leak = J_max_leak*(Ca_PU-Ca_i); /* P.U.->Cai */
+
+        /* ----------------- */
+        /* Entrainment       */
+        /* ----------------- */
+
+        double E_Ca_PU = 0.5*RToF*log(Ca_o/Ca_PU);
+        double I_VDDR_PU = G_max_VDDR*p_d_VDDR[c]*p_f_VDDR[c]*(Vm-E_Ca_PU);
+        double J_PMCA_PU = J_max_PMCA_PU*1.0/(1.0+exp(-(Ca_PU-0.0001)/0.000015));
+
+        pDY[c] = set_voltage_derivative_to_zero ? 0.0 : (-1.0 / 0.01) * (pStimuli[c] + I_Na+I_Ltype+I_VDDR+I_kv11+I_ERG+I_BK+I_CaCl+I_NSCC+I_bk+(J_PMCA*2.0*F*V_cyto/Asurf));
+        pDY[n+c] = fc*((-I_Ltype-I_VDDR)*Asurf/(2.0*F*V_cyto)+J_leak-J_PMCA);
+        pDY[2*n+c] = fe*(J_SERCA-J_ERout);
+        double dCa_PU = fc*((J_NaCa-J_uni)*V_MITO/V_PU+(J_ERout-J_SERCA)*V_ER/V_PU-J_leak*V_cyto/V_PU);
+        dCa_PU -= fc*(((fraction_VDDR_in_PU*I_VDDR_PU*Asurf)/(2.0*F*V_PU))+J_PMCA_PU);
+        pDY[3*n+c] = dCa_PU;
+        pDY[4*n+c] = fm*(J_uni-J_NaCa);
+        pDY[5*n+c] = 1.0*(d_INH-h*(Ca_PU+d_INH))/tauh;
+
+        /* gating variables, in the order of the state variables */
+        double tmp3 = 0.00014/Ca_i;
+        p_inf[c] = 1.0/(1.0+(tmp3*tmp3*tmp3)); // d_CaCl
+        p_tau[c] = tau_d_CaCl;
+        p_inf[n+c] = 0.2+0.8/(1.0+exp((Vm+20.0)/-1.8)); // d_ERG
+        p_tau[n+c] = tau_d_ERG;
+        p_inf[2*n+c] = 1.0/(1.0+exp((Vm+17.0)/-4.3)); // d_Ltype
+        p_tau[2*n+c] = tau_d_Ltype;
+        p_inf[3*n+c] = 1.0/(1.0+pow(0.0000745/Ca_PU, -85.0)); // d_NSCC
+        p_tau[3*n+c] = tau_d_NSCC;
+        p_inf[4*n+c] = 1.0/(1.0+exp((Vm+47.0)/-4.8)); // d_Na
+        p_tau[4*n+c] = tau_d_Na;
+        p_inf[5*n+c] = 1.0/(1.0+exp((Vm+26.0)/-6.0)); // d_VDDR
+        p_tau[5*n+c] = tau_d_VDDR;
+        p_inf[6*n+c] = 1.0/(1.0+exp((Vm+25.0)/-7.7)); // d_kv11
+        p_tau[6*n+c] = tau_d_kv11;
+        p_inf[7*n+c] = 1.0/(1.0+exp((Vm+43.0)/8.9)); // f_Ltype
+        p_tau[7*n+c] = tau_f_Ltype;
+        p_inf[8*n+c] = 1.0/(1.0+exp((Vm+78.0)/7.0)); // f_Na
+        p_tau[8*n+c] = tau_f_Na;
+        p_inf[9*n+c] = 1.0/(1.0+exp((Vm+66.0)/6.0)); // f_VDDR
+        p_tau[9*n+c] = tau_f_VDDR;
+        p_inf[10*n+c] = 1.0-1.0/(1.0+exp((Ca_i-0.0001-0.000214)/-0.0000131)); // f_ca_Ltype
+        p_tau[10*n+c] = tau_f_ca_Ltype;
+        p_inf[11*n+c] = 0.5+0.5/(1.0+exp((Vm+44.8)/4.4)); // f_kv11
+        p_tau[11*n+c] = tau_f_kv11;
+    }
+}
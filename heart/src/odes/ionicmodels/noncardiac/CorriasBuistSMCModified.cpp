@@ -37,9 +37,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cmath>
 #include <cassert>
 #include <memory>
+#include <typeinfo>
 #include "Exception.hpp"
 #include "OdeSystemInformation.hpp"
 #include "CorriasBuistSMCModified.hpp"
+#include "CorriasBuistSMCModifiedBatch.hpp"
 #include "HeartConfig.hpp"
 
 
@@ -326,6 +328,15 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
         rDY[13] = (-(ICaL+ILVA)*Asurf/(2.0*F*VolCell)-JCaExt); /* intracellular calcium *1000 M-> mM; /1000 F units*/
     }
 
+    AbstractCardiacCellBatch* CorriasBuistSMCModified::CreateCellBatch()
+    {
+        if (typeid(*this) != typeid(CorriasBuistSMCModified))
+        {
+            return NULL;
+        }
+        return new CorriasBuistSMCModifiedBatch;
+    }
+
 template<>
 void OdeSystemInformation<CorriasBuistSMCModified>::Initialise(void)
 {
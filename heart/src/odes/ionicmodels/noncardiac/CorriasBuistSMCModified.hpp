@@ -57,6 +57,9 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 class CorriasBuistSMCModified : public AbstractCardiacCell
 {
+    /** The batched version of this model shares its constants. */
+    friend class CorriasBuistSMCModifiedBatch;
+
     friend class boost::serialization::access;
     /**
      * Boost Serialization method for archiving/checkpointing.
@@ -207,6 +210,14 @@ public:
      * @return the Carbon Monoxide scale factor
      */
     double GetCarbonMonoxideScaleFactor();
+
+    /**
+     * Overridden method to create a CorriasBuistSMCModifiedBatch, if this cell is
+     * not an instance of a subclass.
+     *
+     * @return a new batch, or NULL
+     */
+    AbstractCardiacCellBatch* CreateCellBatch();
 };
 
 // Needs to be included last
@@ -0,0 +1,208 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+#include "CorriasBuistSMCModifiedBatch.hpp"
+#include "CorriasBuistSMCModified.hpp"
+
+#include <cmath>
+
+CorriasBuistSMCModifiedBatch::CorriasBuistSMCModifiedBatch()
+    : AbstractCardiacCellBatch(14, 0)
+{
+    // d_CaL, f_CaL, fCa_CaL, d_LVA, f_LVA, d_Na, f_Na, m_nsCC, xr1, xr2, xa1, xa2
+    for (unsigned i=1; i<=12; i++)
+    {
+        mGatingVariableIndices.push_back(i);
+    }
+}
+
+double CorriasBuistSMCModifiedBatch::GetStimulus(AbstractCardiacCell* pCell, double time)
+{
+    CorriasBuistSMCModified* p_cell = static_cast<CorriasBuistSMCModified*>(pCell);
+    return p_cell->mFakeIccStimulusPresent ? 0.0 : p_cell->GetStimulus(time);
+}
+
+bool CorriasBuistSMCModifiedBatch::HasSameSettings(AbstractCardiacCell* pCell, AbstractCardiacCell* pFirstCell) const
+{
+    CorriasBuistSMCModified* p_cell = static_cast<CorriasBuistSMCModified*>(pCell);
+    CorriasBuistSMCModified* p_first_cell = static_cast<CorriasBuistSMCModified*>(pFirstCell);
+    return p_cell->mScaleFactorCarbonMonoxide == p_first_cell->mScaleFactorCarbonMonoxide
+           && p_cell->mFakeIccStimulusPresent == p_first_cell->mFakeIccStimulusPresent
+           && p_cell->Asurf == p_first_cell->Asurf;
+}
+
+void CorriasBuistSMCModifiedBatch::EvaluateEquations(double time, const double* pY, const double* pStimuli, double* pDY,
+                                                     double* pGatingSteadyStates, double* pGatingTimeConstants)
+{
+    const unsigned num_cells = GetNumCells();
+
+    // All cells in the batch have the same constants (see HasSameSettings())
+    const CorriasBuistSMCModified& r_model = *static_cast<CorriasBuistSMCModified*>(GetCell(0));
+    const double co_scale_factor = r_model.mScaleFactorCarbonMonoxide;
+    const double Asurf = r_model.Asurf;
+    const double VolCell = r_model.VolCell;
+    const double hCa = r_model.hCa;
+    const double sCa = r_model.sCa;
+    const double ACh = r_model.ACh;
+    const double CaiRest = r_model.CaiRest;
+    const double gLVA_max = r_model.gLVA_max;
+    const double gCaL_max = r_model.gCaL_max;
+    const double gKb_max = r_model.gKb_max;
+    const double gKA_max = r_model.gKA_max;
+    const double gKr_max = r_model.gKr_max;
+    const double gNa_max = r_model.gNa_max;
+    const double gnsCC_max = r_model.gnsCC_max;
+    const double JCaExt_max = r_model.JCaExt_max;
+    const double T_correct_Ca = r_model.T_correct_Ca;
+    const double T_correct_K = r_model.T_correct_K;
+    const double T_correct_Na = r_model.T_correct_Na;
+    const double T_correct_gBK = r_model.T_correct_gBK;
+    const double EK = r_model.EK;
+    const double ENa = r_model.ENa;
+    const double EnsCC = r_model.EnsCC;
+    const double Ca_o = r_model.Ca_o;
+    const double F = r_model.F;
+    const double RToF = r_model.RToF;
+
+    // The fake ICC stimulus depends only on time, so is the same for every cell
+    double fake_icc_stimulus = 0.0;
+    if (r_model.mFakeIccStimulusPresent)
+    {
+        const double gcouple = r_model.gcouple;
+        double t_ICCplateau = 7582.0; // time_units
+        double V_decay = 37.25; // voltage_units
+        double t_ICCpeak = 98.0; // time_units
+
+        double period = 20000.0; // time_units
+        double stim_start = ((time > (period * 1.0)) && (time <= (period * 2.0))) ? (period * 1.0) : ((time > (period * 2.0)) && (time <= (period * 3.0))) ? (period * 2.0) : ((time > (period * 3.0)) && (time <= (period * 4.0))) ? (period * 3.0) : ((time > (period * 4.0)) && (time <= (period * 5.0))) ? (period * 4.0) : 0.0; // time_units
+        double local_time = time - (stim_start + t_ICCpeak); // time_units
+        double t_ICC_stimulus = 10000.0; // time_units
+        double delta_VICC = 59.0; // voltage_units
+
+        fake_icc_stimulus = (local_time < t_ICCpeak) ? (gcouple * delta_VICC) : ((local_time >= t_ICCpeak) && (local_time <= t_ICCplateau)) ? (gcouple * delta_VICC * (1.0 / (1.0 + exp((local_time - 8000.0) / 1000.0)))) : ((local_time > t_ICCplateau) && (local_time < t_ICC_stimulus)) ? (gcouple * V_decay * (1.0 / (1.0 + exp((local_time - 8000.0) / 150.0)))) : 0.0; // current_units
+    }
+    const bool fake_icc_stimulus_present = r_model.mFakeIccStimulusPresent;
+    const bool set_voltage_derivative_to_zero = mSetVoltageDerivativeToZero;
+
+    const double* p_Vm = pY;
+    const double* p_d_CaL = pY + num_cells;
+    const double* p_f_CaL = pY + 2*num_cells;
+    const double* p_fCa_CaL = pY + 3*num_cells;
+    const double* p_d_LVA = pY + 4*num_cells;
+    const double* p_f_LVA = pY + 5*num_cells;
+    const double* p_d_Na = pY + 6*num_cells;
+    const double* p_f_Na = pY + 7*num_cells;
+    const double* p_m_nsCC = pY + 8*num_cells;
+    const double* p_xr1 = pY + 9*num_cells;
+    const double* p_xr2 = pY + 10*num_cells;
+    const double* p_xa1 = pY + 11*num_cells;
+    const double* p_xa2 = pY + 12*num_cells;
+    const double* p_Cai = pY + 13*num_cells;
+
+    double* p_inf = pGatingSteadyStates;
+    double* p_tau = pGatingTimeConstants;
+    const unsigned n = num_cells;
+
+    for (unsigned c=0; c<num_cells; c++)
+    {
+        const double Vm = p_Vm[c];
+        const double Cai = p_Cai[c];
+
+        double ECa = 0.5*RToF*log(Ca_o/Cai);
+
+        /* inward sodium current */
+        double INa = gNa_max*p_d_Na[c]*p_f_Na[c]*(Vm-ENa);
+
+        /* L-type calcium current */
+        double ICaL = gCaL_max*p_d_CaL[c]*p_f_CaL[c]*p_fCa_CaL[c]*(Vm-ECa);
+
+        /* low voltage activated (T-type) calcium current */
+        double ILVA = gLVA_max*p_d_LVA[c]*p_f_LVA[c]*(Vm-ECa);
+
+        /* large conductance calcium activated potassium current */
+        double Po_BK = 1.0/(1.0+exp(-(Vm/17.0)-2.0*log(Cai/0.001)));
+        double IBK = T_correct_gBK*Po_BK*(Vm-EK);
+
+        /* delayed rectifier potassium current */
+        double IKr = co_scale_factor*gKr_max*p_xr1[c]*p_xr2[c]*(Vm-EK);
+
+        /* A-type potassium current */
+        double IKA = co_scale_factor*gKA_max*p_xa1[c]*p_xa2[c]*(Vm-EK);
+
+        /* background (leakage) potassium current */
+        double IKb = co_scale_factor*gKb_max*(Vm-EK);
+
+        /* non-specific cation current */
+        double hCa_nsCC = 1.0/(1.0+pow((Cai/0.0002),-4.0));
+        double rACh_nsCC = 1.0/(1.0+(0.01/ACh));
+        double InsCC = gnsCC_max*p_m_nsCC[c]*rACh_nsCC*hCa_nsCC*(Vm-EnsCC);
+
+        /* phenomenological calcium extrusion current */
+        double JCaExt = JCaExt_max*pow(Cai,1.34);
+
+        /* membrane potential */
+        double i_stim = fake_icc_stimulus_present ? fake_icc_stimulus : pStimuli[c];
+        double Iion = INa+ICaL+ILVA+IKr+IKA+IBK+IKb+InsCC+(JCaExt*2.0*F*VolCell/Asurf);
+        pDY[c] = set_voltage_derivative_to_zero ? 0.0 : (-1.0 / 0.01) * (-i_stim + Iion);
+
+        /* gating variables, in the order of the state variables */
+        p_inf[c] = 1.0/(1.0+exp(-(Vm+17.0)/4.3)); // d_CaL
+        p_tau[c] = 0.47*T_correct_Ca;
+        p_inf[n+c] = 1.0/(1.0+exp((Vm+43.0)/8.9)); // f_CaL
+        p_tau[n+c] = 86.0*T_correct_Ca;
+        p_inf[2*n+c] = 1.0-(1.0/(1.0+exp(-((Cai-CaiRest)-hCa)/sCa))); // fCa_CaL
+        p_tau[2*n+c] = 2.0*T_correct_Ca;
+        p_inf[3*n+c] = 1.0/(1.0+exp(-(Vm+27.5)/10.9)); // d_LVA
+        p_tau[3*n+c] = 3.0*T_correct_Ca;
+        p_inf[4*n+c] = 1.0/(1.0+exp((Vm+15.8)/7.0)); // f_LVA
+        p_tau[4*n+c] = 7.58*exp(Vm*0.00817)*T_correct_Ca;
+        p_inf[5*n+c] = 1.0/(1.0+exp(-(Vm+47.0)/4.8)); // d_Na
+        p_tau[5*n+c] = (0.44-0.017*Vm)*T_correct_Na;
+        p_inf[6*n+c] = 1.0/(1.0+exp((Vm+78.0)/3.0)); // f_Na
+        p_tau[6*n+c] = (5.5-0.25*Vm)*T_correct_Na;
+        p_inf[7*n+c] = 1.0/(1.0+exp(-(Vm+25.0)/20.0)); // m_nsCC
+        p_tau[7*n+c] = 150.0/(1.0+exp(-(Vm+66.0)/26.0));
+        p_inf[8*n+c] = 1.0/(1.0+exp(-(Vm+27.0)/5.0)); // xr1
+        p_tau[8*n+c] = 80.0*T_correct_K;
+        p_inf[9*n+c] = 0.2+0.8/(1.0+exp((Vm+58.0)/10.0)); // xr2
+        p_tau[9*n+c] = (-707.0+1481.0*exp((Vm+36.0)/95.0))*T_correct_K;
+        p_inf[10*n+c] = 1.0/(1.0+exp(-(Vm+26.5)/7.9)); // xa1
+        p_tau[10*n+c] = (31.8+175.0*exp(-0.5*pow(((Vm+44.4)/22.3),2.0)))*T_correct_K;
+        p_inf[11*n+c] = 0.1+0.9/(1.0+exp((Vm+65.0)/6.2)); // xa2
+        p_tau[11*n+c] = 90.0*T_correct_K;
+
+        /* intracellular calcium */
+        pDY[13*n+c] = (-(ICaL+ILVA)*Asurf/(2.0*F*VolCell)-JCaExt);
+    }
+}
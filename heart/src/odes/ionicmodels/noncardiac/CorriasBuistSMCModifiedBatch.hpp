@@ -0,0 +1,90 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+#ifndef CORRIASBUISTSMCMODIFIEDBATCH_HPP_
+#define CORRIASBUISTSMCMODIFIEDBATCH_HPP_
+
+#include "AbstractCardiacCellBatch.hpp"
+
+/**
+ * Batched version of CorriasBuistSMCModified, which evaluates the right-hand side
+ * of the model for many cells at once.
+ *
+ * State variables 1 to 12 are gating variables, so may be updated with the
+ * Rush-Larsen method (see AbstractCardiacCellBatch::SetUseRushLarsen()).
+ */
+class CorriasBuistSMCModifiedBatch : public AbstractCardiacCellBatch
+{
+protected:
+    /**
+     * Compute the RHS of the Corrias-Buist SMC model for every cell in the batch.
+     *
+     * @param time  the current time, in milliseconds
+     * @param pY  current values of the state variables
+     * @param pStimuli  the intracellular stimulus of each cell
+     * @param pDY  to be filled in with derivatives
+     * @param pGatingSteadyStates  to be filled in with the steady states of the gating variables
+     * @param pGatingTimeConstants  to be filled in with the time constants of the gating variables
+     */
+    void EvaluateEquations(double time, const double* pY, const double* pStimuli, double* pDY,
+                           double* pGatingSteadyStates, double* pGatingTimeConstants);
+
+    /**
+     * Overridden method to use the intracellular stimulus, as CorriasBuistSMCModified does,
+     * or none if the fake ICC stimulus is present.
+     *
+     * @return the stimulus of the cell
+     * @param pCell  a cell in this batch
+     * @param time  the current time, in milliseconds
+     */
+    double GetStimulus(AbstractCardiacCell* pCell, double time);
+
+    /**
+     * Overridden method to check that the cells have the same carbon monoxide scale factor,
+     * fake ICC stimulus setting and surface area.
+     *
+     * @return whether the cells have the same settings
+     * @param pCell  the cell
+     * @param pFirstCell  the first cell in the batch
+     */
+    bool HasSameSettings(AbstractCardiacCell* pCell, AbstractCardiacCell* pFirstCell) const;
+
+public:
+    /**
+     * Constructor.
+     */
+    CorriasBuistSMCModifiedBatch();
+};
+
+#endif // CORRIASBUISTSMCMODIFIEDBATCH_HPP_
@@ -40,6 +40,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "OutputFileHandler.hpp"
 #include "DistanceMapCalculator.hpp"
 #include "PseudoEcgCalculator.hpp"
+#include "StreamingPostProcessor.hpp"
 #include "Version.hpp"
 #include "HeartEventHandler.hpp"
 #include "Hdf5DataWriter.hpp"
@@ -76,51 +77,91 @@ void PostProcessingWriter<ELEMENT_DIM, SPACE_DIM>::WritePostProcessingFiles()
 
     // Please note that only the master processor should write to file.
     // Each of the private methods called here takes care of checking.
+    std::vector<std::pair<double,double> > apd_maps;
     if (HeartConfig::Instance()->IsApdMapsRequested())
     {
-        std::vector<std::pair<double,double> > apd_maps;
         HeartConfig::Instance()->GetApdMaps(apd_maps);
-        for (unsigned i=0; i<apd_maps.size(); i++)
-        {
-            WriteApdMapFile(apd_maps[i].first, apd_maps[i].second);
-        }
     }
-
+    std::vector<double> upstroke_time_maps;
     if (HeartConfig::Instance()->IsUpstrokeTimeMapsRequested())
     {
-        std::vector<double> upstroke_time_maps;
         HeartConfig::Instance()->GetUpstrokeTimeMaps(upstroke_time_maps);
-        for (unsigned i=0; i<upstroke_time_maps.size(); i++)
-        {
-            WriteUpstrokeTimeMap(upstroke_time_maps[i]);
-        }
     }
-
+    std::vector<double> upstroke_velocity_maps;
     if (HeartConfig::Instance()->IsMaxUpstrokeVelocityMapRequested())
     {
-        std::vector<double> upstroke_velocity_maps;
         HeartConfig::Instance()->GetMaxUpstrokeVelocityMaps(upstroke_velocity_maps);
-        for (unsigned i=0; i<upstroke_velocity_maps.size(); i++)
-        {
-            WriteMaxUpstrokeVelocityMap(upstroke_velocity_maps[i]);
-        }
     }
-
+    std::vector<unsigned> conduction_velocity_maps;
     if (HeartConfig::Instance()->IsConductionVelocityMapsRequested())
     {
-        std::vector<unsigned> conduction_velocity_maps;
         HeartConfig::Instance()->GetConductionVelocityMaps(conduction_velocity_maps);
+    }
+
+    if (!apd_maps.empty() || !upstroke_time_maps.empty() || !upstroke_velocity_maps.empty() || !conduction_velocity_maps.empty())
+    {
+        // Calculate all the maps in a single pass through the voltage data
+        StreamingPostProcessor processor(mLo, mHi);
+        for (unsigned i=0; i<apd_maps.size(); i++)
+        {
+            processor.AddApdMap(apd_maps[i].first, apd_maps[i].second);
+        }
+        for (unsigned i=0; i<upstroke_time_maps.size(); i++)
+        {
+            processor.AddUpstrokeTimeMap(upstroke_time_maps[i]);
+        }
+        for (unsigned i=0; i<upstroke_velocity_maps.size(); i++)
+        {
+            processor.AddMaxUpstrokeVelocityMap(upstroke_velocity_maps[i]);
+        }
+        if (!conduction_velocity_maps.empty())
+        {
+            processor.AddConductionVelocityMaps();
+        }
+        processor.ProcessHdf5Data(*mpDataReader, mVoltageName);
+        processor.Finish();
+
+        for (unsigned i=0; i<apd_maps.size(); i++)
+        {
+            // HDF5 shouldn't have minus signs in the data names..
+            std::stringstream hdf5_dataset_name;
+            hdf5_dataset_name << "Apd_" << apd_maps[i].first;
+            WriteOutputDataToHdf5(processor.GetApdMap(apd_maps[i].first, apd_maps[i].second),
+                                  hdf5_dataset_name.str() + ConvertToHdf5FriendlyString(apd_maps[i].second) + "_Map",
+                                  "msec");
+        }
 
-        //get the mesh here
-        DistanceMapCalculator<ELEMENT_DIM, SPACE_DIM> dist_map_calculator(mrMesh);
+        for (unsigned i=0; i<upstroke_time_maps.size(); i++)
+        {
+            WriteOutputDataToHdf5(processor.GetUpstrokeTimeMap(upstroke_time_maps[i]),
+                                  "UpstrokeTimeMap" + ConvertToHdf5FriendlyString(upstroke_time_maps[i]),
+                                  "msec");
+        }
+
+        for (unsigned i=0; i<upstroke_velocity_maps.size(); i++)
+        {
+            WriteOutputDataToHdf5(processor.GetMaxUpstrokeVelocityMap(upstroke_velocity_maps[i]),
+                                  "MaxUpstrokeVelocityMap" + ConvertToHdf5FriendlyString(upstroke_velocity_maps[i]),
+                                  "mV_per_msec");
+        }
 
-        for (unsigned i=0; i<conduction_velocity_maps.size(); i++)
+        if (!conduction_velocity_maps.empty())
         {
-            std::vector<double> distance_map;
-            std::vector<unsigned> origin_surface;
-            origin_surface.push_back(conduction_velocity_maps[i]);
-            dist_map_calculator.ComputeDistanceMap(origin_surface, distance_map);
-            WriteConductionVelocityMap(conduction_velocity_maps[i], distance_map);
+            //get the mesh here
+            DistanceMapCalculator<ELEMENT_DIM, SPACE_DIM> dist_map_calculator(mrMesh);
+
+            for (unsigned i=0; i<conduction_velocity_maps.size(); i++)
+            {
+                std::vector<double> distance_map;
+                std::vector<unsigned> origin_surface;
+                origin_surface.push_back(conduction_velocity_maps[i]);
+                dist_map_calculator.ComputeDistanceMap(origin_surface, distance_map);
+
+                std::stringstream filename_stream;
+                filename_stream << "ConductionVelocityFromNode" << conduction_velocity_maps[i];
+                WriteOutputDataToHdf5(processor.GetConductionVelocityMap(conduction_velocity_maps[i], distance_map),
+                                      filename_stream.str(), "cm_per_msec");
+            }
         }
     }
 
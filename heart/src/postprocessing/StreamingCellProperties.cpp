@@ -0,0 +1,522 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cmath>
+
+#include "StreamingCellProperties.hpp"
+#include "Exception.hpp"
+#include "Warnings.hpp"
+
+StreamingCellProperties::StreamingCellProperties(double threshold, const std::vector<double>& rApdPercentages)
+    : mThreshold(threshold),
+      mNumSamples(0u),
+      mFinished(false),
+      mPrevTime(0.0),
+      mPrevVoltage(0.0),
+      mPrevVoltageDerivative(0.0),
+      mIsAboveThreshold(false),
+      mSwitchingPhase(false),
+      mFoundAFlatBit(false),
+      mMaxUpstrokeVelocity(-DBL_MAX),
+      mTimeOfMaxUpstrokeVelocity(0.0),
+      mCurrentRestingValue(DBL_MAX),
+      mCurrentRestingIndex(0u),
+      mCurrentMinimumVelocity(DBL_MAX),
+      mCurrentPeak(-DBL_MAX),
+      mCounterOfPlateauDepolarisations(0u),
+      mNumOnsets(0u),
+      mFirstActionPotential(0u),
+      mFirstBufferedSample(0u)
+{
+    for (unsigned i=0; i<rApdPercentages.size(); i++)
+    {
+        ApdCalculation calculation;
+        calculation.Percentage = rApdPercentages[i];
+        calculation.NextActionPotential = 0u;
+        calculation.AwaitingStart = false;
+        calculation.StartSearchIndex = 0u;
+        calculation.AwaitingEnd = false;
+        calculation.EndSearchIndex = 0u;
+        calculation.Target = DOUBLE_UNSET;
+        calculation.PreviousTarget = DOUBLE_UNSET;
+        calculation.StartTime = DOUBLE_UNSET;
+        calculation.EndTime = DOUBLE_UNSET;
+        calculation.StartingIndex = UNSIGNED_UNSET;
+        mApdCalculations.push_back(calculation);
+    }
+}
+
+double StreamingCellProperties::GetBufferedTime(unsigned index) const
+{
+    assert(index >= mFirstBufferedSample && index < mNumSamples);
+    return mBufferedTimes[index - mFirstBufferedSample];
+}
+
+double StreamingCellProperties::GetBufferedVoltage(unsigned index) const
+{
+    assert(index >= mFirstBufferedSample && index < mNumSamples);
+    return mBufferedVoltages[index - mFirstBufferedSample];
+}
+
+void StreamingCellProperties::AddSample(double time, double voltage)
+{
+    assert(!mFinished);
+    const bool calculate_apds = !mApdCalculations.empty();
+    const unsigned index = mNumSamples;
+    mNumSamples++;
+
+    if (calculate_apds)
+    {
+        mBufferedTimes.push_back(time);
+        mBufferedVoltages.push_back(voltage);
+        if (!mRestingSamples.empty() && mRestingSamples.back().Index + 1u == index)
+        {
+            mRestingSamples.back().NextTime = time;
+            mRestingSamples.back().NextVoltage = voltage;
+        }
+    }
+
+    if (index > 0u)
+    {
+        // This follows CellProperties::CalculateProperties() exactly
+        const double v = voltage;
+        const double t = time;
+        const double prev_v = mPrevVoltage;
+        const double prev_t = mPrevTime;
+        const double voltage_derivative = (t == prev_t) ? 0.0 : (v - prev_v) / (t - prev_t);
+        const double resting_potential_gradient_threshold = 1e-2;
+
+        if (voltage_derivative >= mMaxUpstrokeVelocity)
+        {
+            mMaxUpstrokeVelocity = voltage_derivative;
+            mTimeOfMaxUpstrokeVelocity = t;
+        }
+
+        if (!mIsAboveThreshold)
+        {
+            if (fabs(voltage_derivative) <= mCurrentMinimumVelocity && fabs(voltage_derivative) <= resting_potential_gradient_threshold)
+            {
+                mCurrentMinimumVelocity = fabs(voltage_derivative);
+                mCurrentRestingValue = prev_v;
+                mCurrentRestingIndex = index - 1u;
+                mFoundAFlatBit = true;
+            }
+            else if (prev_v < mCurrentRestingValue && !mFoundAFlatBit)
+            {
+                mCurrentRestingValue = prev_v;
+                mCurrentRestingIndex = index - 1u;
+            }
+
+            // If we cross the threshold, this counts as an AP
+            if (v > mThreshold && prev_v <= mThreshold)
+            {
+                mNumOnsets++;
+                if (calculate_apds)
+                {
+                    const double onset = prev_t + (t - prev_t) / (v - prev_v) * (mThreshold - prev_v);
+
+                    // The APD search starts just before the first sample at or after the onset
+                    unsigned first_later_index = index;
+                    if (t < onset)
+                    {
+                        first_later_index = index + 1u;
+                    }
+                    while (first_later_index > mFirstBufferedSample && GetBufferedTime(first_later_index - 1u) >= onset)
+                    {
+                        first_later_index--;
+                    }
+                    assert(first_later_index > 0u);
+
+                    ActionPotential action_potential;
+                    action_potential.RestingValue = mCurrentRestingValue;
+                    action_potential.PeakValue = -DBL_MAX;
+                    action_potential.PeakIsFinal = false;
+                    action_potential.StartingTimeIndex = first_later_index - 1u;
+                    action_potential.RestingSamples.swap(mRestingSamples);
+                    mActionPotentials.push_back(action_potential);
+                    mRestingSamples.clear();
+                }
+
+                mCurrentMinimumVelocity = DBL_MAX;
+                mCurrentRestingValue = DBL_MAX;
+                mSwitchingPhase = true;
+                mFoundAFlatBit = false;
+                mIsAboveThreshold = true;
+            }
+        }
+
+        if (mIsAboveThreshold)
+        {
+            if (v > mCurrentPeak)
+            {
+                mCurrentPeak = v;
+            }
+
+            if (mPrevVoltageDerivative <= 0 && voltage_derivative > 0 && !mSwitchingPhase)
+            {
+                mCounterOfPlateauDepolarisations++;
+            }
+            mSwitchingPhase = false;
+
+            // If we cross the threshold again, the AP is over
+            if (v < mThreshold && prev_v >= mThreshold)
+            {
+                if (calculate_apds)
+                {
+                    mActionPotentials.back().PeakValue = mCurrentPeak;
+                    mActionPotentials.back().PeakIsFinal = true;
+                }
+                mCurrentPeak = mThreshold;
+
+                mMaxUpstrokeVelocities.push_back(mMaxUpstrokeVelocity);
+                mMaxUpstrokeVelocity = -DBL_MAX;
+                mTimesAtMaxUpstrokeVelocity.push_back(mTimeOfMaxUpstrokeVelocity);
+                mTimeOfMaxUpstrokeVelocity = 0.0;
+                mCountersOfPlateauDepolarisations.push_back(mCounterOfPlateauDepolarisations);
+                mCounterOfPlateauDepolarisations = 0u;
+
+                mIsAboveThreshold = false;
+            }
+        }
+
+        mPrevVoltageDerivative = voltage_derivative;
+    }
+    mPrevVoltage = voltage;
+    mPrevTime = time;
+
+    if (calculate_apds)
+    {
+        /*
+         * Only a sample below threshold that is lower than every later sample before the
+         * next onset can be where an APD that starts below threshold is found to start.
+         */
+        if (voltage < mThreshold)
+        {
+            while (!mRestingSamples.empty() && mRestingSamples.back().Voltage >= voltage)
+            {
+                mRestingSamples.pop_back();
+            }
+            RestingSample sample;
+            sample.Index = index;
+            sample.Time = time;
+            sample.Voltage = voltage;
+            sample.NextTime = DOUBLE_UNSET;
+            sample.NextVoltage = DOUBLE_UNSET;
+            mRestingSamples.push_back(sample);
+        }
+
+        for (unsigned i=0; i<mApdCalculations.size(); i++)
+        {
+            AdvanceApdCalculation(mApdCalculations[i]);
+        }
+        DiscardUnneededData();
+    }
+}
+
+void StreamingCellProperties::AdvanceApdCalculation(ApdCalculation& rCalculation)
+{
+    // This follows CellProperties::CalculateActionPotentialDurations(), one AP at a time
+    while (rCalculation.NextActionPotential < mFirstActionPotential + mActionPotentials.size())
+    {
+        const unsigned ap_index = rCalculation.NextActionPotential;
+        const ActionPotential& r_action_potential = mActionPotentials[ap_index - mFirstActionPotential];
+        const unsigned starting_time_index = r_action_potential.StartingTimeIndex;
+
+        if (!rCalculation.AwaitingStart && !rCalculation.AwaitingEnd)
+        {
+            // We need the peak to know the target voltage
+            if (!r_action_potential.PeakIsFinal)
+            {
+                break;
+            }
+
+            rCalculation.PreviousTarget = rCalculation.Target;
+            rCalculation.Target = r_action_potential.RestingValue + 0.01 * (100 - rCalculation.Percentage) * (r_action_potential.PeakValue - r_action_potential.RestingValue);
+            const double target = rCalculation.Target;
+
+            if (target >= mThreshold)
+            {
+                // Look forwards for the crossing point (normally no later than the peak)
+                rCalculation.AwaitingStart = true;
+                rCalculation.StartSearchIndex = starting_time_index + 1u;
+            }
+            else
+            {
+                // Look backwards, through the only samples that can be the crossing point
+                const std::vector<RestingSample>& r_samples = r_action_potential.RestingSamples;
+                for (unsigned i=r_samples.size(); i-- > 0u; )
+                {
+                    if (r_samples[i].Index <= starting_time_index && r_samples[i].Voltage < target)
+                    {
+                        rCalculation.StartTime = r_samples[i].NextTime + ((target - r_samples[i].NextVoltage) / (r_samples[i].Voltage - r_samples[i].NextVoltage)) * (r_samples[i].Time - r_samples[i].NextTime);
+                        rCalculation.StartingIndex = r_samples[i].Index + 1u;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (rCalculation.AwaitingStart)
+        {
+            const double target = rCalculation.Target;
+            while (rCalculation.StartSearchIndex < mNumSamples)
+            {
+                const unsigned t = rCalculation.StartSearchIndex;
+                if (GetBufferedVoltage(t) > target)
+                {
+                    const double prev_t = GetBufferedTime(t - 1u);
+                    const double prev_v = GetBufferedVoltage(t - 1u);
+                    rCalculation.StartTime = prev_t + ((target - prev_v) / (GetBufferedVoltage(t) - prev_v)) * (GetBufferedTime(t) - prev_t);
+                    rCalculation.StartingIndex = t;
+                    rCalculation.AwaitingStart = false;
+                    break;
+                }
+                rCalculation.StartSearchIndex++;
+            }
+            if (rCalculation.AwaitingStart)
+            {
+                if (!mFinished)
+                {
+                    break;
+                }
+                rCalculation.AwaitingStart = false;
+            }
+        }
+
+        if (!rCalculation.AwaitingEnd)
+        {
+            // Skip an AP that starts before the last one finished
+            if (rCalculation.EndTime != DOUBLE_UNSET && rCalculation.StartTime != DOUBLE_UNSET && rCalculation.StartTime < rCalculation.EndTime)
+            {
+                rCalculation.NextActionPotential++;
+                continue;
+            }
+
+            if (ap_index > 0u)
+            {
+                if (fabs(rCalculation.Target - rCalculation.PreviousTarget) > 2) // If we see more than a 2mV shift in AP threshold
+                {
+                    WARNING("The voltage threshold for measuring APD" << rCalculation.Percentage << " changed from "
+                                                                      << rCalculation.PreviousTarget << " to " << rCalculation.Target << " in this AP trace, which may suggest CellProperties isn't telling you anything very sensible!");
+                }
+            }
+
+            if (rCalculation.StartingIndex == UNSIGNED_UNSET)
+            {
+                rCalculation.NextActionPotential++;
+                continue;
+            }
+
+            // Samples between the start of the APD and the onset are all above the target
+            rCalculation.AwaitingEnd = true;
+            rCalculation.EndSearchIndex = std::max(rCalculation.StartingIndex, starting_time_index + 1u);
+        }
+
+        // Now just look forwards for the repolarisation time
+        const double target = rCalculation.Target;
+        while (rCalculation.EndSearchIndex < mNumSamples)
+        {
+            const unsigned t = rCalculation.EndSearchIndex;
+            if (GetBufferedVoltage(t) < target)
+            {
+                const double prev_v = GetBufferedVoltage(t - 1u);
+                rCalculation.EndTime = GetBufferedTime(t - 1u) + ((target - prev_v) / (GetBufferedVoltage(t) - prev_v)) * (GetBufferedTime(t) - GetBufferedTime(t - 1u));
+                rCalculation.Durations.push_back(rCalculation.EndTime - rCalculation.StartTime);
+                rCalculation.AwaitingEnd = false;
+                break;
+            }
+            rCalculation.EndSearchIndex++;
+        }
+        if (rCalculation.AwaitingEnd)
+        {
+            if (!mFinished)
+            {
+                break;
+            }
+            rCalculation.AwaitingEnd = false;
+        }
+        rCalculation.NextActionPotential++;
+    }
+}
+
+void StreamingCellProperties::DiscardUnneededData()
+{
+    // Keep the last few samples, to find where the next AP starts
+    unsigned first_needed_sample = (mNumSamples > 3u) ? mNumSamples - 3u : 0u;
+    unsigned first_needed_action_potential = mFirstActionPotential + mActionPotentials.size();
+    if (mIsAboveThreshold)
+    {
+        first_needed_sample = std::min(first_needed_sample, mActionPotentials.back().StartingTimeIndex);
+    }
+    for (unsigned i=0; i<mApdCalculations.size(); i++)
+    {
+        const ApdCalculation& r_calculation = mApdCalculations[i];
+        const unsigned next_ap = r_calculation.NextActionPotential;
+        first_needed_action_potential = std::min(first_needed_action_potential, next_ap);
+        if (next_ap < mFirstActionPotential + mActionPotentials.size())
+        {
+            if (r_calculation.AwaitingStart)
+            {
+                first_needed_sample = std::min(first_needed_sample, r_calculation.StartSearchIndex - 1u);
+            }
+            else if (r_calculation.AwaitingEnd)
+            {
+                first_needed_sample = std::min(first_needed_sample, r_calculation.EndSearchIndex - 1u);
+            }
+            else
+            {
+                first_needed_sample = std::min(first_needed_sample, mActionPotentials[next_ap - mFirstActionPotential].StartingTimeIndex);
+            }
+            // Later APs start no earlier than the one after this
+            if (next_ap + 1u < mFirstActionPotential + mActionPotentials.size())
+            {
+                first_needed_sample = std::min(first_needed_sample, mActionPotentials[next_ap + 1u - mFirstActionPotential].StartingTimeIndex);
+            }
+        }
+    }
+
+    // Discard in batches, so that the cost of moving what is kept is spread out
+    const unsigned num_unneeded_samples = first_needed_sample - mFirstBufferedSample;
+    if (2u*num_unneeded_samples >= mBufferedTimes.size() && num_unneeded_samples > 0u)
+    {
+        mBufferedTimes.erase(mBufferedTimes.begin(), mBufferedTimes.begin() + num_unneeded_samples);
+        mBufferedVoltages.erase(mBufferedVoltages.begin(), mBufferedVoltages.begin() + num_unneeded_samples);
+        mFirstBufferedSample = first_needed_sample;
+    }
+
+    if (first_needed_action_potential > mFirstActionPotential)
+    {
+        mActionPotentials.erase(mActionPotentials.begin(), mActionPotentials.begin() + (first_needed_action_potential - mFirstActionPotential));
+        mFirstActionPotential = first_needed_action_potential;
+    }
+
+    // The APD of the next AP cannot start before the sample giving the resting potential
+    if (!mIsAboveThreshold && !mRestingSamples.empty() && mRestingSamples[0].Index < mCurrentRestingIndex)
+    {
+        unsigned num_unneeded_resting_samples = 0u;
+        while (num_unneeded_resting_samples < mRestingSamples.size()
+               && mRestingSamples[num_unneeded_resting_samples].Index < mCurrentRestingIndex)
+        {
+            num_unneeded_resting_samples++;
+        }
+        if (2u*num_unneeded_resting_samples >= mRestingSamples.size())
+        {
+            mRestingSamples.erase(mRestingSamples.begin(), mRestingSamples.begin() + num_unneeded_resting_samples);
+        }
+    }
+}
+
+void StreamingCellProperties::Finish()
+{
+    if (mNumSamples < 1u)
+    {
+        EXCEPTION("Insufficient time steps to calculate physiological properties.");
+    }
+    assert(!mFinished);
+    mFinished = true;
+
+    // If the trace ends halfway through an AP, register the upstroke so far
+    if (mIsAboveThreshold)
+    {
+        mMaxUpstrokeVelocities.push_back(mMaxUpstrokeVelocity);
+        mTimesAtMaxUpstrokeVelocity.push_back(mTimeOfMaxUpstrokeVelocity);
+        if (!mApdCalculations.empty())
+        {
+            mActionPotentials.back().PeakValue = mCurrentPeak;
+            mActionPotentials.back().PeakIsFinal = true;
+        }
+    }
+
+    for (unsigned i=0; i<mApdCalculations.size(); i++)
+    {
+        AdvanceApdCalculation(mApdCalculations[i]);
+    }
+
+    // Release everything but the results
+    std::vector<ActionPotential>().swap(mActionPotentials);
+    std::vector<RestingSample>().swap(mRestingSamples);
+    std::vector<double>().swap(mBufferedTimes);
+    std::vector<double>().swap(mBufferedVoltages);
+}
+
+std::vector<double> StreamingCellProperties::GetMaxUpstrokeVelocities() const
+{
+    assert(mFinished);
+    if (mMaxUpstrokeVelocities.empty())
+    {
+        EXCEPTION("AP did not occur, never descended past threshold voltage.");
+    }
+    return mMaxUpstrokeVelocities;
+}
+
+std::vector<double> StreamingCellProperties::GetTimesAtMaxUpstrokeVelocity() const
+{
+    assert(mFinished);
+    if (mTimesAtMaxUpstrokeVelocity.empty())
+    {
+        EXCEPTION("AP did not occur, never descended past threshold voltage.");
+    }
+    return mTimesAtMaxUpstrokeVelocity;
+}
+
+std::vector<unsigned> StreamingCellProperties::GetNumberOfAboveThresholdDepolarisationsForAllAps() const
+{
+    assert(mFinished);
+    return mCountersOfPlateauDepolarisations;
+}
+
+std::vector<double> StreamingCellProperties::GetAllActionPotentialDurations(double percentage) const
+{
+    assert(mFinished);
+    for (unsigned i=0; i<mApdCalculations.size(); i++)
+    {
+        if (mApdCalculations[i].Percentage == percentage)
+        {
+            if (mNumOnsets == 0u)
+            {
+                EXCEPTION("AP did not occur, never exceeded threshold voltage.");
+            }
+            if (mApdCalculations[i].Durations.empty())
+            {
+                EXCEPTION("No full action potential was recorded");
+            }
+            return mApdCalculations[i].Durations;
+        }
+    }
+    EXCEPTION("APD" << percentage << " was not requested when these properties were constructed.");
+}
@@ -0,0 +1,281 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _STREAMINGCELLPROPERTIES_HPP_
+#define _STREAMINGCELLPROPERTIES_HPP_
+
+#include <vector>
+
+/**
+ * Calculates the same physiological properties as CellProperties, for a single cell, from
+ * a voltage trace that is supplied one sample at a time rather than as a complete vector.
+ *
+ * This lets many traces be processed together in a single pass through time-major
+ * simulation output (see StreamingPostProcessor), keeping only a small amount of state
+ * per trace:
+ *   Maximum upstroke velocity, and the time it occurs, for each AP
+ *   Number of above-threshold depolarisations for each AP
+ *   Action potential durations, for percentages given to the constructor
+ *
+ * The results are identical to those from CellProperties with the same threshold. To
+ * achieve this for APDs, whose target voltages are only known once each AP has peaked,
+ * the samples of the AP currently being measured are retained, together with those
+ * samples before its onset that could mark the start of the APD.
+ */
+class StreamingCellProperties
+{
+private:
+    /** A sample of the trace, and the sample after it, kept to look back for the start of an APD. */
+    struct RestingSample
+    {
+        /** The index of the sample in the trace. */
+        unsigned Index;
+        /** The time of the sample. */
+        double Time;
+        /** The voltage of the sample. */
+        double Voltage;
+        /** The time of the following sample. */
+        double NextTime;
+        /** The voltage of the following sample. */
+        double NextVoltage;
+    };
+
+    /** What is known about an action potential whose durations have not yet been calculated. */
+    struct ActionPotential
+    {
+        /** The resting potential before this AP. */
+        double RestingValue;
+        /** The peak potential of this AP. */
+        double PeakValue;
+        /** Whether #PeakValue is final, because the AP has ended or the trace has. */
+        bool PeakIsFinal;
+        /** The index of the last sample before the onset of this AP. */
+        unsigned StartingTimeIndex;
+        /**
+         * The samples before the onset at which an APD could start, in order: those
+         * below threshold and below every later sample up to the onset.
+         */
+        std::vector<RestingSample> RestingSamples;
+    };
+
+    /** The progress of the calculation of APDs at one percentage. */
+    struct ApdCalculation
+    {
+        /** The repolarisation percentage, e.g. 90 for APD90. */
+        double Percentage;
+        /** The index of the next AP to process, in the whole trace. */
+        unsigned NextActionPotential;
+        /** Whether we are looking forwards for the start of the APD of AP #NextActionPotential. */
+        bool AwaitingStart;
+        /** The index of the next sample to check for the start of the APD. */
+        unsigned StartSearchIndex;
+        /** Whether we are looking for the end of the APD of AP #NextActionPotential. */
+        bool AwaitingEnd;
+        /** The index of the next sample to check for the end of the APD. */
+        unsigned EndSearchIndex;
+        /** The target voltage for the last AP processed. */
+        double Target;
+        /** The target voltage for the AP before that. */
+        double PreviousTarget;
+        /** The time the last APD started. */
+        double StartTime;
+        /** The time the last APD ended. */
+        double EndTime;
+        /** The index of the first sample after the start of the last APD. */
+        unsigned StartingIndex;
+        /** The APDs calculated so far. */
+        std::vector<double> Durations;
+    };
+
+    /** Threshold for determining what counts as an action potential. */
+    double mThreshold;
+
+    /** The number of samples added so far. */
+    unsigned mNumSamples;
+
+    /** Whether Finish() has been called. */
+    bool mFinished;
+
+    /** The time of the previous sample. */
+    double mPrevTime;
+
+    /** The voltage of the previous sample. */
+    double mPrevVoltage;
+
+    /** The rate of change of voltage over the previous interval. */
+    double mPrevVoltageDerivative;
+
+    /** Whether the trace is currently above threshold, i.e. in an AP. */
+    bool mIsAboveThreshold;
+
+    /** Whether we have just crossed the threshold upwards. */
+    bool mSwitchingPhase;
+
+    /** Whether a flat bit of trace has been found since the last AP. */
+    bool mFoundAFlatBit;
+
+    /** The largest upstroke velocity so far in the current AP. */
+    double mMaxUpstrokeVelocity;
+
+    /** The time of #mMaxUpstrokeVelocity. */
+    double mTimeOfMaxUpstrokeVelocity;
+
+    /** The resting potential so far since the last AP. */
+    double mCurrentRestingValue;
+
+    /** The index of the sample giving #mCurrentRestingValue. */
+    unsigned mCurrentRestingIndex;
+
+    /** The smallest rate of change of voltage so far since the last AP. */
+    double mCurrentMinimumVelocity;
+
+    /** The peak potential so far in the current AP. */
+    double mCurrentPeak;
+
+    /** The number of depolarisations so far in the current AP. */
+    unsigned mCounterOfPlateauDepolarisations;
+
+    /** The number of APs whose onset has been seen. */
+    unsigned mNumOnsets;
+
+    /** The maximum upstroke velocity for each AP. */
+    std::vector<double> mMaxUpstrokeVelocities;
+
+    /** The time of the maximum upstroke velocity for each AP. */
+    std::vector<double> mTimesAtMaxUpstrokeVelocity;
+
+    /** The number of above-threshold depolarisations for each complete AP. */
+    std::vector<unsigned> mCountersOfPlateauDepolarisations;
+
+    /** The APD calculations to make, one per percentage. */
+    std::vector<ApdCalculation> mApdCalculations;
+
+    /** APs still needed by some APD calculation, starting with AP number #mFirstActionPotential. */
+    std::vector<ActionPotential> mActionPotentials;
+
+    /** The index in the whole trace of the first entry of #mActionPotentials. */
+    unsigned mFirstActionPotential;
+
+    /** Candidate samples for the start of the APD of the next AP (see ActionPotential::RestingSamples). */
+    std::vector<RestingSample> mRestingSamples;
+
+    /** Recent times, starting with sample number #mFirstBufferedSample. */
+    std::vector<double> mBufferedTimes;
+
+    /** Recent voltages, starting with sample number #mFirstBufferedSample. */
+    std::vector<double> mBufferedVoltages;
+
+    /** The index in the trace of the first entry of #mBufferedTimes. */
+    unsigned mFirstBufferedSample;
+
+    /**
+     * @return the time of a buffered sample
+     * @param index  the index of the sample in the trace
+     */
+    double GetBufferedTime(unsigned index) const;
+
+    /**
+     * @return the voltage of a buffered sample
+     * @param index  the index of the sample in the trace
+     */
+    double GetBufferedVoltage(unsigned index) const;
+
+    /**
+     * Calculate as many APDs as the samples so far allow, following
+     * CellProperties::CalculateActionPotentialDurations().
+     *
+     * @param rCalculation  the calculation to advance
+     */
+    void AdvanceApdCalculation(ApdCalculation& rCalculation);
+
+    /**
+     * Discard buffered samples, candidate resting samples and APs that will not be needed again.
+     */
+    void DiscardUnneededData();
+
+public:
+    /**
+     * Constructor.
+     *
+     * @param threshold  the threshold for determining if an AP started, as for CellProperties
+     * @param rApdPercentages  the repolarisation percentages for which to calculate APDs, if any
+     */
+    StreamingCellProperties(double threshold = -30.0,
+                            const std::vector<double>& rApdPercentages = std::vector<double>());
+
+    /**
+     * Process the next sample of the trace.
+     *
+     * @param time  the time of the sample, which must be later than that of the last sample
+     * @param voltage  the voltage of the sample
+     */
+    void AddSample(double time, double voltage);
+
+    /**
+     * Say that the trace is complete, so that the results may be retrieved.
+     */
+    void Finish();
+
+    /**
+     * As CellProperties::GetMaxUpstrokeVelocities().
+     *
+     * @return a vector containing the maximum upstroke velocity for all APs
+     */
+    std::vector<double> GetMaxUpstrokeVelocities() const;
+
+    /**
+     * As CellProperties::GetTimesAtMaxUpstrokeVelocity().
+     *
+     * @return a vector containing the times of maximum upstroke velocity for all APs
+     */
+    std::vector<double> GetTimesAtMaxUpstrokeVelocity() const;
+
+    /**
+     * As CellProperties::GetNumberOfAboveThresholdDepolarisationsForAllAps().
+     *
+     * @return a vector containing the number of above-threshold depolarisations for each AP
+     */
+    std::vector<unsigned> GetNumberOfAboveThresholdDepolarisationsForAllAps() const;
+
+    /**
+     * As CellProperties::GetAllActionPotentialDurations().
+     *
+     * @param percentage  the repolarisation percentage, which must have been given to the constructor
+     * @return a vector containing all the APDs
+     */
+    std::vector<double> GetAllActionPotentialDurations(double percentage) const;
+};
+
+#endif //_STREAMINGCELLPROPERTIES_HPP_
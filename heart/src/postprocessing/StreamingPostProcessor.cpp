@@ -0,0 +1,320 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "StreamingPostProcessor.hpp"
+#include "Exception.hpp"
+#include "PetscTools.hpp"
+
+StreamingPostProcessor::StreamingPostProcessor(unsigned lo, unsigned hi)
+    : mLo(lo),
+      mHi(hi),
+      mNumTimeSteps(0u),
+      mFinished(false)
+{
+    assert(lo <= hi);
+}
+
+unsigned StreamingPostProcessor::AddThreshold(double threshold)
+{
+    if (mNumTimeSteps > 0u)
+    {
+        EXCEPTION("Maps must be requested before any time steps are processed.");
+    }
+    for (unsigned i=0; i<mThresholds.size(); i++)
+    {
+        if (mThresholds[i] == threshold)
+        {
+            return i;
+        }
+    }
+    mThresholds.push_back(threshold);
+    mApdPercentages.push_back(std::vector<double>());
+    return mThresholds.size() - 1u;
+}
+
+unsigned StreamingPostProcessor::GetThresholdIndex(double threshold) const
+{
+    for (unsigned i=0; i<mThresholds.size(); i++)
+    {
+        if (mThresholds[i] == threshold)
+        {
+            return i;
+        }
+    }
+    EXCEPTION("No map was requested with a threshold of " << threshold << ".");
+}
+
+void StreamingPostProcessor::AddApdMap(double repolarisationPercentage, double threshold)
+{
+    std::vector<double>& r_percentages = mApdPercentages[AddThreshold(threshold)];
+    if (std::find(r_percentages.begin(), r_percentages.end(), repolarisationPercentage) == r_percentages.end())
+    {
+        r_percentages.push_back(repolarisationPercentage);
+    }
+}
+
+void StreamingPostProcessor::AddUpstrokeTimeMap(double threshold)
+{
+    AddThreshold(threshold);
+}
+
+void StreamingPostProcessor::AddMaxUpstrokeVelocityMap(double threshold)
+{
+    AddThreshold(threshold);
+}
+
+void StreamingPostProcessor::AddConductionVelocityMaps()
+{
+    // PropagationPropertiesCalculator uses the CellProperties default threshold
+    AddThreshold(-30.0);
+}
+
+void StreamingPostProcessor::ProcessTimeStep(double time, const double* pVoltages, unsigned stride)
+{
+    assert(!mFinished);
+    if (mNumTimeSteps == 0u)
+    {
+        // Now we know everything that is to be calculated at each node
+        for (unsigned i=0; i<mThresholds.size(); i++)
+        {
+            mCellProperties.push_back(std::vector<StreamingCellProperties>(mHi - mLo, StreamingCellProperties(mThresholds[i], mApdPercentages[i])));
+        }
+    }
+    mNumTimeSteps++;
+
+    for (unsigned local_index=0; local_index<mHi-mLo; local_index++)
+    {
+        const double voltage = pVoltages[local_index*stride];
+        for (unsigned i=0; i<mCellProperties.size(); i++)
+        {
+            mCellProperties[i][local_index].AddSample(time, voltage);
+        }
+    }
+}
+
+void StreamingPostProcessor::ProcessHdf5Data(Hdf5DataReader& rReader, const std::string& rVoltageName)
+{
+    std::vector<double> times = rReader.GetUnlimitedDimensionValues();
+    const unsigned num_nodes = mHi - mLo;
+    if (mThresholds.empty() || num_nodes == 0u)
+    {
+        // Nothing to calculate, but still count the time steps
+        mNumTimeSteps += times.size();
+        return;
+    }
+
+    // Read around a million values at a time, so memory use doesn't depend on the length of the simulation
+    const unsigned num_values_per_block = 1u << 20;
+    const unsigned num_time_steps_per_block = std::max(1u, num_values_per_block/num_nodes);
+
+    for (unsigned first_time_step=0; first_time_step<times.size(); first_time_step+=num_time_steps_per_block)
+    {
+        unsigned num_time_steps = std::min(num_time_steps_per_block, (unsigned)(times.size()) - first_time_step);
+        std::vector<double> voltages = rReader.GetVariableOverMultipleNodesOverTimeRange(rVoltageName, mLo, mHi,
+                                                                                          first_time_step, num_time_steps);
+        for (unsigned i=0; i<num_time_steps; i++)
+        {
+            ProcessTimeStep(times[first_time_step + i], &voltages[i*num_nodes]);
+        }
+    }
+}
+
+void StreamingPostProcessor::Finish()
+{
+    assert(!mFinished);
+    mFinished = true;
+
+    // With no time steps, every map is left with its default entries
+    if (mNumTimeSteps > 0u)
+    {
+        for (unsigned i=0; i<mCellProperties.size(); i++)
+        {
+            for (unsigned local_index=0; local_index<mCellProperties[i].size(); local_index++)
+            {
+                mCellProperties[i][local_index].Finish();
+            }
+        }
+    }
+}
+
+std::vector<std::vector<double> > StreamingPostProcessor::GetApdMap(double repolarisationPercentage, double threshold) const
+{
+    assert(mFinished);
+    unsigned threshold_index = GetThresholdIndex(threshold);
+    const std::vector<double>& r_percentages = mApdPercentages[threshold_index];
+    if (std::find(r_percentages.begin(), r_percentages.end(), repolarisationPercentage) == r_percentages.end())
+    {
+        EXCEPTION("No APD" << repolarisationPercentage << " map was requested with a threshold of " << threshold << ".");
+    }
+
+    if (mNumTimeSteps == 0u)
+    {
+        return std::vector<std::vector<double> >(mHi - mLo, std::vector<double>(1u, 0.0));
+    }
+    std::vector<std::vector<double> > output_data(mHi - mLo);
+    for (unsigned local_index=0; local_index<mHi-mLo; local_index++)
+    {
+        try
+        {
+            output_data[local_index] = mCellProperties[threshold_index][local_index].GetAllActionPotentialDurations(repolarisationPercentage);
+        }
+        catch (Exception&)
+        {
+            output_data[local_index].push_back(0);
+        }
+    }
+    return output_data;
+}
+
+std::vector<std::vector<double> > StreamingPostProcessor::GetUpstrokeTimeMap(double threshold) const
+{
+    assert(mFinished);
+    unsigned threshold_index = GetThresholdIndex(threshold);
+
+    if (mNumTimeSteps == 0u)
+    {
+        return std::vector<std::vector<double> >(mHi - mLo, std::vector<double>(1u, 0.0));
+    }
+    std::vector<std::vector<double> > output_data(mHi - mLo);
+    for (unsigned local_index=0; local_index<mHi-mLo; local_index++)
+    {
+        try
+        {
+            output_data[local_index] = mCellProperties[threshold_index][local_index].GetTimesAtMaxUpstrokeVelocity();
+        }
+        catch (Exception&)
+        {
+            output_data[local_index].push_back(0);
+        }
+    }
+    return output_data;
+}
+
+std::vector<std::vector<double> > StreamingPostProcessor::GetMaxUpstrokeVelocityMap(double threshold) const
+{
+    assert(mFinished);
+    unsigned threshold_index = GetThresholdIndex(threshold);
+
+    if (mNumTimeSteps == 0u)
+    {
+        return std::vector<std::vector<double> >(mHi - mLo, std::vector<double>(1u, 0.0));
+    }
+    std::vector<std::vector<double> > output_data(mHi - mLo);
+    for (unsigned local_index=0; local_index<mHi-mLo; local_index++)
+    {
+        try
+        {
+            output_data[local_index] = mCellProperties[threshold_index][local_index].GetMaxUpstrokeVelocities();
+        }
+        catch (Exception&)
+        {
+            output_data[local_index].push_back(0);
+        }
+    }
+    return output_data;
+}
+
+std::vector<std::vector<double> > StreamingPostProcessor::GetConductionVelocityMap(unsigned originNode,
+                                                                                   const std::vector<double>& rDistancesFromOriginNode) const
+{
+    assert(mFinished);
+    unsigned threshold_index = GetThresholdIndex(-30.0);
+
+    // Share the upstroke times at the origin node with every process
+    std::vector<double> local_origin_times;
+    if (originNode >= mLo && originNode < mHi && mNumTimeSteps > 0u)
+    {
+        try
+        {
+            local_origin_times = mCellProperties[threshold_index][originNode - mLo].GetTimesAtMaxUpstrokeVelocity();
+        }
+        catch (Exception&)
+        {
+            // No upstrokes at the origin, so no conduction velocities anywhere
+        }
+    }
+    unsigned local_num_origin_times = local_origin_times.size();
+    unsigned num_origin_times = 0u;
+    MPI_Allreduce(&local_num_origin_times, &num_origin_times, 1, MPI_UNSIGNED, MPI_MAX, PETSC_COMM_WORLD);
+    std::vector<double> origin_times(num_origin_times);
+    if (num_origin_times > 0u)
+    {
+        local_origin_times.resize(num_origin_times, 0.0);
+        MPI_Allreduce(&local_origin_times[0], &origin_times[0], num_origin_times, MPI_DOUBLE, MPI_SUM, PETSC_COMM_WORLD);
+    }
+
+    std::vector<std::vector<double> > output_data(mHi - mLo);
+    for (unsigned dest_node=mLo; dest_node<mHi; dest_node++)
+    {
+        std::vector<double>& r_conduction_velocities = output_data[dest_node - mLo];
+        std::vector<double> dest_times;
+        if (num_origin_times > 0u)
+        {
+            try
+            {
+                dest_times = mCellProperties[threshold_index][dest_node - mLo].GetTimesAtMaxUpstrokeVelocity();
+            }
+            catch (Exception&)
+            {
+                // No upstrokes at this node
+            }
+        }
+        if (dest_times.empty())
+        {
+            r_conduction_velocities.push_back(0);
+            continue;
+        }
+
+        // We calculate only where the AP reached both nodes
+        unsigned number_of_aps = std::min(num_origin_times, (unsigned)(dest_times.size()));
+        for (unsigned i=0; i<number_of_aps; i++)
+        {
+            ///\todo remove magic number? (#1884)
+            if (originNode == dest_node || fabs(dest_times[i] - origin_times[i]) < 1e-8)
+            {
+                r_conduction_velocities.push_back(0.0);
+            }
+            else
+            {
+                r_conduction_velocities.push_back(rDistancesFromOriginNode[dest_node] / (dest_times[i] - origin_times[i]));
+            }
+        }
+    }
+    return output_data;
+}
@@ -0,0 +1,191 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _STREAMINGPOSTPROCESSOR_HPP_
+#define _STREAMINGPOSTPROCESSOR_HPP_
+
+#include <string>
+#include <vector>
+
+#include "Hdf5DataReader.hpp"
+#include "StreamingCellProperties.hpp"
+
+/**
+ * Calculate the maps produced by PostProcessingWriter (APDs, upstroke times, maximum
+ * upstroke velocities and conduction velocities) for a contiguous range of nodes in a
+ * single pass through time.
+ *
+ * All requested maps are declared first. Voltages are then passed in one time step at a
+ * time, either by the caller (e.g. an output modifier during a simulation) or by reading
+ * an HDF5 file in blocks of time steps, and each node keeps a StreamingCellProperties per
+ * distinct threshold. Results are identical to those from PropagationPropertiesCalculator.
+ *
+ * The maps are per node in the range, in order, with the same convention as
+ * PostProcessingWriter that a node with no results gets a single 0.
+ */
+class StreamingPostProcessor
+{
+private:
+    /** Index of the first node in the range. */
+    unsigned mLo;
+
+    /** One past the index of the last node in the range. */
+    unsigned mHi;
+
+    /** The number of time steps processed. */
+    unsigned mNumTimeSteps;
+
+    /** Whether Finish() has been called. */
+    bool mFinished;
+
+    /** The thresholds for which properties are calculated. */
+    std::vector<double> mThresholds;
+
+    /** The APD percentages to calculate, for each threshold in #mThresholds. */
+    std::vector<std::vector<double> > mApdPercentages;
+
+    /** The properties of each node in the range, for each threshold in #mThresholds. */
+    std::vector<std::vector<StreamingCellProperties> > mCellProperties;
+
+    /**
+     * @return the index in #mThresholds of a threshold, adding it if it is new
+     * @param threshold  the threshold
+     */
+    unsigned AddThreshold(double threshold);
+
+    /**
+     * @return the index in #mThresholds of a threshold that was requested
+     * @param threshold  the threshold
+     */
+    unsigned GetThresholdIndex(double threshold) const;
+
+public:
+    /**
+     * Constructor.
+     *
+     * @param lo  index of the first node in the range, normally DistributedVectorFactory::GetLow()
+     * @param hi  one past the index of the last node, normally DistributedVectorFactory::GetHigh()
+     */
+    StreamingPostProcessor(unsigned lo, unsigned hi);
+
+    /**
+     * Request an APD map.
+     *
+     * @param repolarisationPercentage  eg. 90.0 for APD90
+     * @param threshold  Vm used to signify the upstroke (mV)
+     */
+    void AddApdMap(double repolarisationPercentage, double threshold);
+
+    /**
+     * Request an upstroke time map.
+     *
+     * @param threshold  Vm used to signify the upstroke (mV)
+     */
+    void AddUpstrokeTimeMap(double threshold);
+
+    /**
+     * Request a maximum upstroke velocity map.
+     *
+     * @param threshold  Vm used to signify the upstroke (mV)
+     */
+    void AddMaxUpstrokeVelocityMap(double threshold);
+
+    /**
+     * Request conduction velocity maps. These use the default threshold of CellProperties.
+     */
+    void AddConductionVelocityMaps();
+
+    /**
+     * Process the voltages at the next time step.
+     *
+     * @param time  the time, which must be later than that of the last time step
+     * @param pVoltages  the voltages, the one for node mLo + i being pVoltages[i*stride]
+     * @param stride  the spacing of voltages in pVoltages (e.g. the problem dimension
+     *     for a striped solution vector)
+     */
+    void ProcessTimeStep(double time, const double* pVoltages, unsigned stride=1u);
+
+    /**
+     * Process all the time steps in an HDF5 file, reading the voltages for this range of
+     * nodes in blocks of consecutive time steps.
+     *
+     * @param rReader  a reader for the file
+     * @param rVoltageName  the name of the variable representing the membrane potential
+     */
+    void ProcessHdf5Data(Hdf5DataReader& rReader, const std::string& rVoltageName);
+
+    /**
+     * Say that all time steps have been processed, so that the maps may be retrieved.
+     */
+    void Finish();
+
+    /**
+     * @return the APDs for each node in the range
+     *
+     * @param repolarisationPercentage  eg. 90.0 for APD90
+     * @param threshold  Vm used to signify the upstroke (mV)
+     */
+    std::vector<std::vector<double> > GetApdMap(double repolarisationPercentage, double threshold) const;
+
+    /**
+     * @return the times of each upstroke for each node in the range
+     *
+     * @param threshold  Vm used to signify the upstroke (mV)
+     */
+    std::vector<std::vector<double> > GetUpstrokeTimeMap(double threshold) const;
+
+    /**
+     * @return the velocities of each maximum upstroke for each node in the range
+     *
+     * @param threshold  Vm used to signify the upstroke (mV)
+     */
+    std::vector<std::vector<double> > GetMaxUpstrokeVelocityMap(double threshold) const;
+
+    /**
+     * @return the conduction velocities from a node to each node in the range, as
+     * PropagationPropertiesCalculator::CalculateAllConductionVelocities().
+     *
+     * This is collective, as the origin node need not be in the range on this process. The
+     * ranges on different processes must not overlap.
+     *
+     * @param originNode  the node to compute the conduction velocity from
+     * @param rDistancesFromOriginNode  distance map from originNode to all the nodes in the
+     *     mesh. Typically calculated with DistanceMapCalculator
+     */
+    std::vector<std::vector<double> > GetConductionVelocityMap(unsigned originNode,
+                                                               const std::vector<double>& rDistancesFromOriginNode) const;
+};
+
+#endif //_STREAMINGPOSTPROCESSOR_HPP_
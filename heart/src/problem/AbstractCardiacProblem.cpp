@@ -522,9 +522,15 @@ void AbstractCardiacProblem<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM>::Solve()
                 PetscTools::Destroy(initial_condition);
             }
 
-            // Re-throw
+            // Re-throw (reporting this error rather than any from closing the output files)
             HeartEventHandler::Reset();
-            CloseFilesAndPostProcess();
+            try
+            {
+                CloseFilesAndPostProcess();
+            }
+            catch (const Exception&)
+            {
+            }
 
             throw e;
         }
@@ -593,7 +599,19 @@ void AbstractCardiacProblem<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM>::CloseFilesAndP
         return;
     }
     HeartEventHandler::BeginEvent(HeartEventHandler::WRITE_OUTPUT);
-    // If write caching is on, the next line might actually take a significant amount of time.
+    // If write caching or asynchronous writing is on, the next line might actually take a significant amount of time.
+    // The writer is closed explicitly so that any error finishing the writes is reported.
+    try
+    {
+        mpWriter->Close();
+    }
+    catch (Exception&)
+    {
+        delete mpWriter;
+        mpWriter = NULL;
+        HeartEventHandler::EndEvent(HeartEventHandler::WRITE_OUTPUT);
+        throw;
+    }
     delete mpWriter;
     mpWriter = NULL;
     HeartEventHandler::EndEvent(HeartEventHandler::WRITE_OUTPUT);
@@ -867,6 +885,14 @@ bool AbstractCardiacProblem<ELEMENT_DIM, SPACE_DIM, PROBLEM_DIM>::InitialiseWrit
         mpWriter->SetAlignment(mHdf5DataWriterChunkSizeAndAlignment);
     }
 
+    // Likewise compression and asynchronous writes are only available when creating a new dataset
+    if (!extend_file)
+    {
+        mpWriter->SetDeflateLevel(HeartConfig::Instance()->GetHdf5DataWriterDeflateLevel());
+        mpWriter->SetUseShuffleFilter(HeartConfig::Instance()->GetUseHdf5DataWriterShuffleFilter());
+        mpWriter->SetUseAsynchronousWrites(HeartConfig::Instance()->GetUseHdf5DataWriterAsynchronousWrites());
+    }
+
     // Define columns, or get the variable IDs from the writer
     DefineWriterColumns(extend_file);
 
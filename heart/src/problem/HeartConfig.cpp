@@ -218,7 +218,10 @@ HeartConfig::HeartConfig()
         : mUseMassLumping(false),
           mUseMassLumpingForPrecond(false),
           mUseFixedNumberIterations(false),
-          mEvaluateNumItsEveryNSolves(UINT_MAX)
+          mEvaluateNumItsEveryNSolves(UINT_MAX),
+          mHdf5DataWriterDeflateLevel(0u),
+          mUseHdf5DataWriterShuffleFilter(false),
+          mUseHdf5DataWriterAsynchronousWrites(false)
 {
     assert(mpInstance.get() == NULL);
     mUseFixedSchemaLocation = true;
@@ -2897,6 +2900,40 @@ unsigned HeartConfig::GetEvaluateNumItsEveryNSolves()
     return mEvaluateNumItsEveryNSolves;
 }
 
+void HeartConfig::SetHdf5DataWriterDeflateLevel(unsigned deflateLevel)
+{
+    if (deflateLevel > 9u)
+    {
+        EXCEPTION("Deflate level must be between 0 and 9.");
+    }
+    mHdf5DataWriterDeflateLevel = deflateLevel;
+}
+
+unsigned HeartConfig::GetHdf5DataWriterDeflateLevel()
+{
+    return mHdf5DataWriterDeflateLevel;
+}
+
+void HeartConfig::SetUseHdf5DataWriterShuffleFilter(bool useShuffleFilter)
+{
+    mUseHdf5DataWriterShuffleFilter = useShuffleFilter;
+}
+
+bool HeartConfig::GetUseHdf5DataWriterShuffleFilter()
+{
+    return mUseHdf5DataWriterShuffleFilter;
+}
+
+void HeartConfig::SetUseHdf5DataWriterAsynchronousWrites(bool useAsynchronousWrites)
+{
+    mUseHdf5DataWriterAsynchronousWrites = useAsynchronousWrites;
+}
+
+bool HeartConfig::GetUseHdf5DataWriterAsynchronousWrites()
+{
+    return mUseHdf5DataWriterAsynchronousWrites;
+}
+
 //
 // Purkinje methods
 //
@@ -125,6 +125,12 @@ private:
             archive & mUseFixedNumberIterations;
             archive & mEvaluateNumItsEveryNSolves;
         }
+        if (version > 2)
+        {
+            archive & mHdf5DataWriterDeflateLevel;
+            archive & mUseHdf5DataWriterShuffleFilter;
+            archive & mUseHdf5DataWriterAsynchronousWrites;
+        }
 
         PetscTools::Barrier("HeartConfig::save");
     }
@@ -159,6 +165,12 @@ private:
             archive & mUseFixedNumberIterations;
             archive & mEvaluateNumItsEveryNSolves;
         }
+        if (version > 2)
+        {
+            archive & mHdf5DataWriterDeflateLevel;
+            archive & mUseHdf5DataWriterShuffleFilter;
+            archive & mUseHdf5DataWriterAsynchronousWrites;
+        }
     }
     BOOST_SERIALIZATION_SPLIT_MEMBER()
 
@@ -759,6 +771,21 @@ public:
      */
     unsigned GetEvaluateNumItsEveryNSolves();
 
+    /**
+     * @return the deflate compression level of the HDF5 output (see SetHdf5DataWriterDeflateLevel).
+     */
+    unsigned GetHdf5DataWriterDeflateLevel();
+
+    /**
+     * @return whether the shuffle filter is applied to the HDF5 output (see SetUseHdf5DataWriterShuffleFilter).
+     */
+    bool GetUseHdf5DataWriterShuffleFilter();
+
+    /**
+     * @return whether the HDF5 output is written asynchronously (see SetUseHdf5DataWriterAsynchronousWrites).
+     */
+    bool GetUseHdf5DataWriterAsynchronousWrites();
+
 
     ///////////////////////////////////////////////////////////////
     //
@@ -1189,6 +1216,30 @@ public:
      */
     void SetUseFixedNumberIterationsLinearSolver(bool useFixedNumberIterations = true, unsigned evaluateNumItsEveryNSolves=UINT_MAX);
 
+    /**
+     * Compress the HDF5 output of a cardiac problem with the deflate filter. Passed to
+     * Hdf5DataWriter::SetDeflateLevel() when a new results file is created.
+     *
+     * @param deflateLevel Compression level, from 0 (none, the default) to 9 (most)
+     */
+    void SetHdf5DataWriterDeflateLevel(unsigned deflateLevel);
+
+    /**
+     * Apply the shuffle filter to the HDF5 output of a cardiac problem. Passed to
+     * Hdf5DataWriter::SetUseShuffleFilter() when a new results file is created.
+     *
+     * @param useShuffleFilter Whether to apply the filter (defaults to true)
+     */
+    void SetUseHdf5DataWriterShuffleFilter(bool useShuffleFilter = true);
+
+    /**
+     * Write the HDF5 output of a cardiac problem on a background I/O thread. Passed to
+     * Hdf5DataWriter::SetUseAsynchronousWrites() when a new results file is created.
+     *
+     * @param useAsynchronousWrites Whether to write asynchronously (defaults to true)
+     */
+    void SetUseHdf5DataWriterAsynchronousWrites(bool useAsynchronousWrites = true);
+
     /**
      * @return whether HeartConfig has a drug concentration and any IC50s set up
      */
@@ -1364,6 +1415,15 @@ private:
      */
     unsigned mEvaluateNumItsEveryNSolves;
 
+    /** Deflate compression level of the HDF5 output, 0 for no compression. */
+    unsigned mHdf5DataWriterDeflateLevel;
+
+    /** Whether to apply the shuffle filter to the HDF5 output. */
+    bool mUseHdf5DataWriterShuffleFilter;
+
+    /** Whether to write the HDF5 output on a background I/O thread. */
+    bool mUseHdf5DataWriterAsynchronousWrites;
+
     /**
      * CheckSimulationIsDefined is a convenience method for checking if the "<"Simulation">" element
      * has been defined and therefore is safe to use the Simulation().get() pointer to access
@@ -1388,7 +1448,7 @@ private:
 };
 
 
-BOOST_CLASS_VERSION(HeartConfig, 2)
+BOOST_CLASS_VERSION(HeartConfig, 3)
 #include "SerializationExportWrapper.hpp"
 // Declare identifier for the serializer
 CHASTE_CLASS_EXPORT(HeartConfig)
@@ -0,0 +1,139 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "PostProcessingOutputModifier.hpp"
+#include "OutputFileHandler.hpp"
+#include "HeartConfig.hpp"
+#include "PetscTools.hpp"
+
+void PostProcessingOutputModifier::AddApdMap(double repolarisationPercentage, double threshold)
+{
+    mApdMaps.push_back(std::pair<double,double>(repolarisationPercentage, threshold));
+}
+
+void PostProcessingOutputModifier::AddUpstrokeTimeMap(double threshold)
+{
+    mUpstrokeTimeMaps.push_back(threshold);
+}
+
+void PostProcessingOutputModifier::AddMaxUpstrokeVelocityMap(double threshold)
+{
+    mMaxUpstrokeVelocityMaps.push_back(threshold);
+}
+
+void PostProcessingOutputModifier::InitialiseAtStart(DistributedVectorFactory* pVectorFactory, const std::vector<unsigned>& rNodePermutation)
+{
+    mpProcessor.reset(new StreamingPostProcessor(pVectorFactory->GetLow(), pVectorFactory->GetHigh()));
+    for (unsigned i=0; i<mApdMaps.size(); i++)
+    {
+        mpProcessor->AddApdMap(mApdMaps[i].first, mApdMaps[i].second);
+    }
+    for (unsigned i=0; i<mUpstrokeTimeMaps.size(); i++)
+    {
+        mpProcessor->AddUpstrokeTimeMap(mUpstrokeTimeMaps[i]);
+    }
+    for (unsigned i=0; i<mMaxUpstrokeVelocityMaps.size(); i++)
+    {
+        mpProcessor->AddMaxUpstrokeVelocityMap(mMaxUpstrokeVelocityMaps[i]);
+    }
+}
+
+void PostProcessingOutputModifier::FinaliseAtEnd()
+{
+    mpProcessor->Finish();
+
+    for (unsigned i=0; i<mApdMaps.size(); i++)
+    {
+        std::stringstream map_name;
+        map_name << "Apd_" << mApdMaps[i].first << "_" << mApdMaps[i].second << "_Map";
+        WriteMap(mpProcessor->GetApdMap(mApdMaps[i].first, mApdMaps[i].second), map_name.str());
+    }
+    for (unsigned i=0; i<mUpstrokeTimeMaps.size(); i++)
+    {
+        std::stringstream map_name;
+        map_name << "UpstrokeTimeMap_" << mUpstrokeTimeMaps[i];
+        WriteMap(mpProcessor->GetUpstrokeTimeMap(mUpstrokeTimeMaps[i]), map_name.str());
+    }
+    for (unsigned i=0; i<mMaxUpstrokeVelocityMaps.size(); i++)
+    {
+        std::stringstream map_name;
+        map_name << "MaxUpstrokeVelocityMap_" << mMaxUpstrokeVelocityMaps[i];
+        WriteMap(mpProcessor->GetMaxUpstrokeVelocityMap(mMaxUpstrokeVelocityMaps[i]), map_name.str());
+    }
+
+    mpProcessor.reset();
+}
+
+void PostProcessingOutputModifier::WriteMap(const std::vector<std::vector<double> >& rMap, const std::string& rMapName)
+{
+    OutputFileHandler output_handler(HeartConfig::Instance()->GetOutputDirectory(), false);
+    const std::string file_name = mFilename + "_" + rMapName + ".dat";
+
+    PetscTools::BeginRoundRobin();
+    {
+        out_stream file_stream = out_stream(NULL);
+        // Open the file as new or append
+        if (PetscTools::AmMaster())
+        {
+            file_stream = output_handler.OpenOutputFile(file_name);
+        }
+        else
+        {
+            file_stream = output_handler.OpenOutputFile(file_name, std::ios::app);
+        }
+        for (unsigned i=0; i<rMap.size(); i++)
+        {
+            for (unsigned j=0; j<rMap[i].size(); j++)
+            {
+                (*file_stream) << rMap[i][j] << "\t";
+            }
+            (*file_stream) << "\n";
+        }
+        file_stream->close();
+    }
+    PetscTools::EndRoundRobin();
+}
+
+void PostProcessingOutputModifier::ProcessSolutionAtTimeStep(double time, Vec solution, unsigned problemDim)
+{
+    double* p_solution;
+    VecGetArray(solution, &p_solution);
+    // The voltage is the first variable at each node
+    mpProcessor->ProcessTimeStep(time, p_solution, problemDim);
+    VecRestoreArray(solution, &p_solution);
+}
+
+#include "SerializationExportWrapperForCpp.hpp"
+CHASTE_CLASS_EXPORT(PostProcessingOutputModifier)
@@ -0,0 +1,175 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef POSTPROCESSINGOUTPUTMODIFIER_HPP_
+#define POSTPROCESSINGOUTPUTMODIFIER_HPP_
+
+#include "AbstractOutputModifier.hpp"
+#include "StreamingPostProcessor.hpp"
+#include <boost/shared_ptr.hpp>
+#include <boost/serialization/base_object.hpp>
+#include <boost/serialization/utility.hpp>
+#include <boost/serialization/vector.hpp>
+
+/**
+ * Specialised class for on-the-fly calculation of the maps that PostProcessingWriter
+ * produces from the HDF5 output after a simulation: APD maps, upstroke time maps and
+ * maximum upstroke velocity maps. All the requested maps are calculated together,
+ * with the voltage at every PDE time step, so no output needs to be read back.
+ *
+ * One file is written per map, named after the modifier's file name, e.g. for "maps"
+ * and an APD90 map with a threshold of -30 mV: maps_Apd_90_-30_Map.dat
+ *
+ * Each line of a file holds the values at one node, in node order:
+ *
+ * <first APD for node 0> <second APD for node 0> ...
+ * <first APD for node 1> <second APD for node 1> ...
+ * ...
+ *
+ * with a single 0 for nodes where there are no values, as for PostProcessingWriter.
+ * Since the voltage is sampled every PDE time step, rather than every printing time
+ * step, results may differ slightly from those of PostProcessingWriter.
+ *
+ *  WARNING:  If you checkpoint this class then the partial results will not be stored, only
+ *  the list of requested maps.  Calculations restart when a simulation is resumed.
+ */
+class PostProcessingOutputModifier : public AbstractOutputModifier
+{
+private:
+    /** The requested APD maps, as (percentage, threshold) pairs. */
+    std::vector<std::pair<double,double> > mApdMaps;
+
+    /** The thresholds of the requested upstroke time maps. */
+    std::vector<double> mUpstrokeTimeMaps;
+
+    /** The thresholds of the requested maximum upstroke velocity maps. */
+    std::vector<double> mMaxUpstrokeVelocityMaps;
+
+    /** Does the calculations for the nodes on this process (set up in #InitialiseAtStart) */
+    boost::shared_ptr<StreamingPostProcessor> mpProcessor;
+
+    friend class TestOutputModifiers;
+
+    /** Needed for serialization. */
+    friend class boost::serialization::access;
+
+    /**
+     * Archive the output modifier, never used directly - boost uses this.
+     *
+     * @param archive the archive
+     * @param version the current version of this class
+     */
+    template<class Archive>
+    void serialize(Archive & archive, const unsigned int version)
+    {
+        // This calls serialize on the base class.
+        archive & boost::serialization::base_object<AbstractOutputModifier>(*this);
+        archive & mApdMaps;
+        archive & mUpstrokeTimeMaps;
+        archive & mMaxUpstrokeVelocityMaps;
+        // The processor is re-initialised in a process-specific manner
+    }
+
+    /** Private constructor that does nothing, for archiving */
+    PostProcessingOutputModifier()
+    {}
+
+    /**
+     * Write one map to file, in a round-robin fashion.
+     *
+     * @param rMap  the values at each node on this process
+     * @param rMapName  the name of the map, appended to the modifier's file name
+     */
+    void WriteMap(const std::vector<std::vector<double> >& rMap, const std::string& rMapName);
+
+public:
+    /**
+     * Constructor
+     *
+     * @param rFilename  The base name of the files which are eventually produced by this modifier
+     */
+    PostProcessingOutputModifier(const std::string& rFilename)
+        : AbstractOutputModifier(rFilename)
+    {
+    }
+
+    /**
+     * Request an APD map.
+     *
+     * @param repolarisationPercentage  eg. 90.0 for APD90
+     * @param threshold  Vm used to signify the upstroke (mV)
+     */
+    void AddApdMap(double repolarisationPercentage, double threshold);
+
+    /**
+     * Request an upstroke time map.
+     *
+     * @param threshold  Vm used to signify the upstroke (mV)
+     */
+    void AddUpstrokeTimeMap(double threshold);
+
+    /**
+     * Request a maximum upstroke velocity map.
+     *
+     * @param threshold  Vm used to signify the upstroke (mV)
+     */
+    void AddMaxUpstrokeVelocityMap(double threshold);
+
+    /**
+     * Initialise the modifier (set up the calculations for local nodes) when the solve loop is starting
+     *
+     * @param pVectorFactory  The vector factory which is associated with the calling problem's mesh
+     * @param rNodePermutation The permutation associated with the calling problem's mesh (when running with parallel partitioning)
+     */
+    virtual void InitialiseAtStart(DistributedVectorFactory* pVectorFactory, const std::vector<unsigned>& rNodePermutation);
+
+    /**
+     * Finalise the modifier (write all maps to their files)
+     */
+    virtual void FinaliseAtEnd();
+
+    /**
+     * Process a solution time-step (pass the voltages to the calculations)
+     * @param time  The current simulation time
+     * @param solution  A working copy of the solution at the current time-step.  This is the PETSc vector which is distributed across the processes.
+     * @param problemDim  The calling problem dimension. Used here to avoid probing the size of the solution vector
+     */
+    virtual void ProcessSolutionAtTimeStep(double time, Vec solution, unsigned problemDim);
+};
+
+#include "SerializationExportWrapper.hpp"
+CHASTE_CLASS_EXPORT(PostProcessingOutputModifier)
+
+#endif /* POSTPROCESSINGOUTPUTMODIFIER_HPP_ */
@@ -48,6 +48,10 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PetscVecTools.hpp"
 #include "AbstractCvodeCell.hpp"
 #include "Warnings.hpp"
+#include "ThreadingTools.hpp"
+#include "EulerIvpOdeSolver.hpp"
+#include "RungeKutta2IvpOdeSolver.hpp"
+#include "RungeKutta4IvpOdeSolver.hpp"
 
 template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
 AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::AbstractCardiacTissue(
@@ -59,7 +63,11 @@ AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::AbstractCardiacTissue(
       mHasPurkinje(false),
       mDoCacheReplication(true),
       mMeshUnarchived(false),
-      mExchangeHalos(exchangeHalos)
+      mExchangeHalos(exchangeHalos),
+      mUseBatchedCellModels(false),
+      mUseRushLarsenInCellBatches(false),
+      mCellSolveTaskNumThreads(0),
+      mCellBatchNumThreads(0)
 {
     //This constructor is called from the Initialise() method of the CardiacProblem class
     assert(pCellFactory != NULL);
@@ -184,7 +192,11 @@ AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::AbstractCardiacTissue(AbstractTetr
       mHasPurkinje(false),
       mDoCacheReplication(true),
       mMeshUnarchived(true),
-      mExchangeHalos(false)
+      mExchangeHalos(false),
+      mUseBatchedCellModels(false),
+      mUseRushLarsenInCellBatches(false),
+      mCellSolveTaskNumThreads(0),
+      mCellBatchNumThreads(0)
 {
     mIionicCacheReplicated.Resize(mpDistributedVectorFactory->GetProblemSize());
     mIntracellularStimulusCacheReplicated.Resize(mpDistributedVectorFactory->GetProblemSize());
@@ -361,6 +373,40 @@ bool AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::GetDoCacheReplication()
     return mDoCacheReplication;
 }
 
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SetUseBatchedCellModels(bool useBatchedCellModels)
+{
+    mUseBatchedCellModels = useBatchedCellModels;
+
+    // The cells to solve individually will change
+    mCellBatches.clear();
+    mIsCellBatched.clear();
+    mCellSolveTaskCells.clear();
+    mCellSolveTaskOffsets.clear();
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+bool AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::GetUseBatchedCellModels()
+{
+    return mUseBatchedCellModels;
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SetUseRushLarsenInCellBatches(bool useRushLarsen)
+{
+    mUseRushLarsenInCellBatches = useRushLarsen;
+    for (unsigned b=0; b<mCellBatches.size(); b++)
+    {
+        mCellBatches[b]->SetUseRushLarsen(useRushLarsen);
+    }
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+bool AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::GetUseRushLarsenInCellBatches()
+{
+    return mUseRushLarsenInCellBatches;
+}
+
 template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
 const c_matrix<double, SPACE_DIM, SPACE_DIM>& AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::rGetIntracellularConductivityTensor(unsigned elementIndex)
 {
@@ -483,87 +529,73 @@ void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SolveCellSystems(Vec existing
     DistributedVector::Stripe voltage(dist_solution, 0);
     try
     {
-        double voltage_before_update;
-        for (DistributedVector::Iterator index = dist_solution.Begin();
-             index != dist_solution.End();
-             ++index)
+        if (mUseBatchedCellModels)
         {
-            voltage_before_update = voltage[index];
-            mCellsDistributed[index.Local]->SetVoltage( voltage_before_update );
+            if (mIsCellBatched.empty() || mCellBatchNumThreads != ThreadingTools::GetNumThreads())
+            {
+                SetUpCellBatches();
+            }
+            SolveCellBatches(dist_solution, voltage, time, nextTime, updateVoltage);
+        }
 
-            // Added a try-catch here to provide more output to screen when an error occurs.
-            /// \todo This may want to go to std::cerr ??
-            try
+        if (ThreadingTools::GetNumThreads() > 1)
+        {
+            if (mCellSolveTaskOffsets.empty() || mCellSolveTaskNumThreads != ThreadingTools::GetNumThreads())
             {
-                if (!updateVoltage)
+                SetUpCellSolveTasks();
+            }
+
+            // Exceptions cannot leave a parallel region, so we keep the one thrown for the lowest task index and rethrow it below
+            std::exception_ptr p_exception = nullptr;
+            unsigned exception_task_index = UINT_MAX;
+            const unsigned num_tasks = mCellSolveTaskOffsets.size() - 1;
+            const unsigned lo = dist_solution.GetLow();
+
+            // The cost of solving a cell varies (e.g. with CVODE), so tasks are handed out dynamically
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(ThreadingTools::GetNumThreads())
+#endif
+            for (unsigned task_index=0; task_index<num_tasks; task_index++)
+            {
+                try
                 {
-                    // solve ODE system at this node.
-                    // Note: Voltage is not being updated. The voltage is updated in the PDE solve.
-#ifndef CHASTE_CVODE
-                    mCellsDistributed[index.Local]->ComputeExceptVoltage(time, nextTime);
-#else
-                    // If CVODE is enabled, and this is a CVODE cell
-                    // there's a chance we can recover this by doing a reset so put the above call in a try...catch.
-                    try
+                    for (unsigned i=mCellSolveTaskOffsets[task_index]; i<mCellSolveTaskOffsets[task_index+1]; i++)
                     {
-                        mCellsDistributed[index.Local]->ComputeExceptVoltage(time, nextTime);
+                        unsigned local_index = mCellSolveTaskCells[i];
+                        SolveCellSystemAtNode(voltage, lo + local_index, local_index, time, nextTime, updateVoltage);
                     }
-                    catch (Exception &e)
+                }
+                catch (...)
+                {
+#ifdef CHASTE_OPENMP
+#pragma omp critical(AbstractCardiacTissueException)
+#endif
                     {
-                        // Try an 'emergency' reset if this is a CVODE cell.
-                        // See #2594 for why we think this may be necessary.
-                        if (dynamic_cast<AbstractCvodeCell*>(mCellsDistributed[index.Local]))
-                        {
-                            // Reset the CVODE cell, this leads to a call to CVodeReInit.
-                            static_cast<AbstractCvodeCell*>(mCellsDistributed[index.Local])->ResetSolver();
-                            mCellsDistributed[index.Local]->ComputeExceptVoltage(time, nextTime);
-                            WARNING("Global node " << index.Global << " had an ODE solving problem in t = [" << time <<
-                                    ", " << nextTime << "] ms. This was fixed by a reset of CVODE, but may suggest PDE time"
-                                    " step should be reduced, or CVODE tolerances relaxed.");
-                        }
-                        else
+                        if (task_index < exception_task_index)
                         {
-                            throw e;
+                            exception_task_index = task_index;
+                            p_exception = std::current_exception();
                         }
                     }
-#endif // CHASTE_CVODE
-                }
-                else
-                {
-                    // solve, including updating the voltage (for the operator-splitting implementation of the monodomain solver)
-                    mCellsDistributed[index.Local]->SolveAndUpdateState(time, nextTime);
-                    voltage[index] = mCellsDistributed[index.Local]->GetVoltage();
                 }
             }
-            catch (Exception &e)
-            {
-                std::cout << std::setprecision(16);
-                std::cout << "Global node " << index.Global << " had problems with ODE solve between "
-                        "t = " << time << " and " << nextTime << "ms.\n";
 
-                std::cout << "Voltage at this node before solve was " << voltage_before_update << "mV\n"
-                        "(this SHOULD NOT necessarily be the same as the one in the state variables,\n"
-                        "which can be ignored and stay at the initial condition - the voltage is dictated by PDE instead of state variable.)\n";
-
-                std::cout << "Stimulus current (NB converted to micro-Amps per cm^3) applied here is equal to:\n\t"
-                    << mCellsDistributed[index.Local]->GetIntracellularStimulus(time) << " at t = " << time     << "ms,\n\t"
-                    << mCellsDistributed[index.Local]->GetIntracellularStimulus(nextTime) << " at t = " << nextTime << "ms.\n";
-
-                std::cout << "Cell model: " << dynamic_cast<AbstractUntemplatedParameterisedSystem*>(mCellsDistributed[index.Local])->GetSystemName() << "\n";
-
-                std::cout << "All state variables are now:\n";
-                std::vector<double> state_vars = mCellsDistributed[index.Local]->GetStdVecStateVariables();
-                std::vector<std::string> state_var_names = mCellsDistributed[index.Local]->rGetStateVariableNames();
-                for (unsigned i=0; i<state_vars.size(); i++)
+            if (p_exception)
+            {
+                std::rethrow_exception(p_exception);
+            }
+        }
+        else
+        {
+            for (DistributedVector::Iterator index = dist_solution.Begin();
+                 index != dist_solution.End();
+                 ++index)
+            {
+                if (mIsCellBatched.empty() || !mIsCellBatched[index.Local])
                 {
-                    std::cout << "\t" << state_var_names[i] << "\t:\t" << state_vars[i] << "\n";
+                    SolveCellSystemAtNode(voltage, index.Global, index.Local, time, nextTime, updateVoltage);
                 }
-                std::cout << std::flush;
-
-                throw e;
             }
-            // update the Iionic and stimulus caches
-            UpdateCaches(index.Global, index.Local, nextTime);
         }
 
         if (updateVoltage)
@@ -726,6 +758,345 @@ ReplicatableVector& AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::rGetPurkinjeIn
     return mPurkinjeIntracellularStimulusCacheReplicated;
 }
 
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SolveCellSystemAtNode(DistributedVector::Stripe& rVoltage,
+                                                                          unsigned globalIndex,
+                                                                          unsigned localIndex,
+                                                                          double time,
+                                                                          double nextTime,
+                                                                          bool updateVoltage)
+{
+    AbstractCardiacCellInterface* p_cell = mCellsDistributed[localIndex];
+    double voltage_before_update = rVoltage[globalIndex];
+    p_cell->SetVoltage( voltage_before_update );
+
+    // Added a try-catch here to provide more output to screen when an error occurs.
+    /// \todo This may want to go to std::cerr ??
+    try
+    {
+        if (!updateVoltage)
+        {
+            // solve ODE system at this node.
+            // Note: Voltage is not being updated. The voltage is updated in the PDE solve.
+#ifndef CHASTE_CVODE
+            p_cell->ComputeExceptVoltage(time, nextTime);
+#else
+            // If CVODE is enabled, and this is a CVODE cell
+            // there's a chance we can recover this by doing a reset so put the above call in a try...catch.
+            try
+            {
+                p_cell->ComputeExceptVoltage(time, nextTime);
+            }
+            catch (Exception &e)
+            {
+                // Try an 'emergency' reset if this is a CVODE cell.
+                // See #2594 for why we think this may be necessary.
+                if (dynamic_cast<AbstractCvodeCell*>(p_cell))
+                {
+                    // Reset the CVODE cell, this leads to a call to CVodeReInit.
+                    static_cast<AbstractCvodeCell*>(p_cell)->ResetSolver();
+                    p_cell->ComputeExceptVoltage(time, nextTime);
+#ifdef CHASTE_OPENMP
+#pragma omp critical(AbstractCardiacTissueOutput)
+#endif
+                    {
+                        WARNING("Global node " << globalIndex << " had an ODE solving problem in t = [" << time <<
+                                ", " << nextTime << "] ms. This was fixed by a reset of CVODE, but may suggest PDE time"
+                                " step should be reduced, or CVODE tolerances relaxed.");
+                    }
+                }
+                else
+                {
+                    throw e;
+                }
+            }
+#endif // CHASTE_CVODE
+        }
+        else
+        {
+            // solve, including updating the voltage (for the operator-splitting implementation of the monodomain solver)
+            p_cell->SolveAndUpdateState(time, nextTime);
+            rVoltage[globalIndex] = p_cell->GetVoltage();
+        }
+    }
+    catch (Exception &e)
+    {
+#ifdef CHASTE_OPENMP
+#pragma omp critical(AbstractCardiacTissueOutput)
+#endif
+        {
+            std::cout << std::setprecision(16);
+            std::cout << "Global node " << globalIndex << " had problems with ODE solve between "
+                    "t = " << time << " and " << nextTime << "ms.\n";
+
+            std::cout << "Voltage at this node before solve was " << voltage_before_update << "mV\n"
+                    "(this SHOULD NOT necessarily be the same as the one in the state variables,\n"
+                    "which can be ignored and stay at the initial condition - the voltage is dictated by PDE instead of state variable.)\n";
+
+            std::cout << "Stimulus current (NB converted to micro-Amps per cm^3) applied here is equal to:\n\t"
+                << p_cell->GetIntracellularStimulus(time) << " at t = " << time     << "ms,\n\t"
+                << p_cell->GetIntracellularStimulus(nextTime) << " at t = " << nextTime << "ms.\n";
+
+            std::cout << "Cell model: " << dynamic_cast<AbstractUntemplatedParameterisedSystem*>(p_cell)->GetSystemName() << "\n";
+
+            std::cout << "All state variables are now:\n";
+            std::vector<double> state_vars = p_cell->GetStdVecStateVariables();
+            std::vector<std::string> state_var_names = p_cell->rGetStateVariableNames();
+            for (unsigned i=0; i<state_vars.size(); i++)
+            {
+                std::cout << "\t" << state_var_names[i] << "\t:\t" << state_vars[i] << "\n";
+            }
+            std::cout << std::flush;
+        }
+
+        throw e;
+    }
+    // update the Iionic and stimulus caches
+    UpdateCaches(globalIndex, localIndex, nextTime);
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SetUpCellSolveTasks()
+{
+    mCellSolveTaskCells.clear();
+    mCellSolveTaskOffsets.clear();
+
+    // Group the cells that share an ODE solver
+    std::map<AbstractIvpOdeSolver*, std::vector<unsigned> > cells_by_solver;
+    std::vector<unsigned> independent_cells;
+    std::set<std::string> evaluated_models;
+    for (unsigned local_index=0; local_index<mCellsDistributed.size(); local_index++)
+    {
+        if (!mIsCellBatched.empty() && mIsCellBatched[local_index])
+        {
+            continue;
+        }
+        AbstractCardiacCellInterface* p_cell = mCellsDistributed[local_index];
+        AbstractIvpOdeSolver* p_solver = p_cell->GetSolver().get();
+        if (p_solver == nullptr)
+        {
+            independent_cells.push_back(local_index);
+        }
+        else
+        {
+            cells_by_solver[p_solver].push_back(local_index);
+        }
+
+        // Create any lazily created shared data for this cell model, which is not thread safe
+        if (evaluated_models.insert(typeid(*p_cell).name()).second)
+        {
+            p_cell->GetIIonic();
+        }
+    }
+
+    // Start the largest groups first, so that they are not left until the end of the loop
+    std::vector<std::pair<unsigned, AbstractIvpOdeSolver*> > group_sizes;
+    for (std::map<AbstractIvpOdeSolver*, std::vector<unsigned> >::iterator iter = cells_by_solver.begin();
+         iter != cells_by_solver.end();
+         ++iter)
+    {
+        group_sizes.push_back(std::make_pair(iter->second.size(), iter->first));
+    }
+    std::sort(group_sizes.rbegin(), group_sizes.rend());
+
+    const unsigned num_threads = ThreadingTools::GetNumThreads();
+    mCellSolveTaskNumThreads = num_threads;
+    mCellSolveTaskCells.reserve(mCellsDistributed.size());
+    mCellSolveTaskOffsets.reserve(group_sizes.size()*num_threads + independent_cells.size() + 1);
+    for (unsigned i=0; i<group_sizes.size(); i++)
+    {
+        const std::vector<unsigned>& r_group = cells_by_solver[group_sizes[i].second];
+
+        /*
+         * If the solver keeps nothing between steps except working memory, split the group into
+         * one chunk per thread and give each chunk after the first its own copy of the solver.
+         * Other solvers cannot be copied, so their cells stay in a single task.
+         */
+        unsigned num_chunks = 1;
+        if (CanCopyCellSolver(group_sizes[i].second))
+        {
+            num_chunks = std::min(num_threads, (unsigned)r_group.size());
+        }
+
+        for (unsigned chunk=0; chunk<num_chunks; chunk++)
+        {
+            unsigned begin = (chunk*r_group.size())/num_chunks;
+            unsigned end = ((chunk+1)*r_group.size())/num_chunks;
+
+            if (chunk > 0)
+            {
+                boost::shared_ptr<AbstractIvpOdeSolver> p_solver = CopyCellSolver(group_sizes[i].second);
+                for (unsigned j=begin; j<end; j++)
+                {
+                    mCellsDistributed[r_group[j]]->SetSolver(p_solver);
+                }
+            }
+
+            mCellSolveTaskOffsets.push_back(mCellSolveTaskCells.size());
+            mCellSolveTaskCells.insert(mCellSolveTaskCells.end(), r_group.begin() + begin, r_group.begin() + end);
+        }
+    }
+    for (unsigned i=0; i<independent_cells.size(); i++)
+    {
+        mCellSolveTaskOffsets.push_back(mCellSolveTaskCells.size());
+        mCellSolveTaskCells.push_back(independent_cells[i]);
+    }
+    mCellSolveTaskOffsets.push_back(mCellSolveTaskCells.size());
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+bool AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::CanCopyCellSolver(AbstractIvpOdeSolver* pSolver)
+{
+    // Only exact types are copied, since a subclass may keep other state
+    const std::type_info& r_type = typeid(*pSolver);
+    return (r_type == typeid(EulerIvpOdeSolver)
+            || r_type == typeid(RungeKutta2IvpOdeSolver)
+            || r_type == typeid(RungeKutta4IvpOdeSolver));
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+boost::shared_ptr<AbstractIvpOdeSolver> AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::CopyCellSolver(AbstractIvpOdeSolver* pSolver)
+{
+    assert(CanCopyCellSolver(pSolver));
+    boost::shared_ptr<AbstractIvpOdeSolver> p_copy;
+
+    const std::type_info& r_type = typeid(*pSolver);
+    if (r_type == typeid(EulerIvpOdeSolver))
+    {
+        p_copy.reset(new EulerIvpOdeSolver);
+    }
+    else if (r_type == typeid(RungeKutta2IvpOdeSolver))
+    {
+        p_copy.reset(new RungeKutta2IvpOdeSolver);
+    }
+    else
+    {
+        p_copy.reset(new RungeKutta4IvpOdeSolver);
+    }
+
+    return p_copy;
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SetUpCellBatches()
+{
+    mCellBatches.clear();
+    mIsCellBatched.assign(mCellsDistributed.size(), false);
+
+    // Limit the size of each batch, so that there is at least one batch of each model per thread
+    mCellBatchNumThreads = ThreadingTools::GetNumThreads();
+    const unsigned max_batch_size = (mCellsDistributed.size() + mCellBatchNumThreads - 1)/mCellBatchNumThreads;
+
+    for (unsigned local_index=0; local_index<mCellsDistributed.size(); local_index++)
+    {
+        AbstractCardiacCell* p_cell = dynamic_cast<AbstractCardiacCell*>(mCellsDistributed[local_index]);
+        if (p_cell == NULL)
+        {
+            continue;
+        }
+
+        // Look for a batch that can take this cell...
+        for (unsigned b=0; b<mCellBatches.size() && !mIsCellBatched[local_index]; b++)
+        {
+            if (mCellBatches[b]->GetNumCells() < max_batch_size && mCellBatches[b]->CanAddCell(p_cell))
+            {
+                mCellBatches[b]->AddCell(p_cell);
+                mIsCellBatched[local_index] = true;
+            }
+        }
+
+        // ...otherwise start a new one, if this model has a batched version
+        if (!mIsCellBatched[local_index])
+        {
+            boost::shared_ptr<AbstractCardiacCellBatch> p_batch(p_cell->CreateCellBatch());
+            if (p_batch && p_batch->CanAddCell(p_cell))
+            {
+                p_batch->SetUseRushLarsen(mUseRushLarsenInCellBatches);
+                p_batch->AddCell(p_cell);
+                mCellBatches.push_back(p_batch);
+                mIsCellBatched[local_index] = true;
+            }
+        }
+    }
+
+    // The cells to solve individually have changed
+    mCellSolveTaskCells.clear();
+    mCellSolveTaskOffsets.clear();
+}
+
+template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
+void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::SolveCellBatches(DistributedVector& rDistributedSolution,
+                                                                     DistributedVector::Stripe& rVoltage,
+                                                                     double time,
+                                                                     double nextTime,
+                                                                     bool updateVoltage)
+{
+    for (DistributedVector::Iterator index = rDistributedSolution.Begin();
+         index != rDistributedSolution.End();
+         ++index)
+    {
+        if (mIsCellBatched[index.Local])
+        {
+            mCellsDistributed[index.Local]->SetVoltage(rVoltage[index]);
+        }
+    }
+
+    // Each batch owns its cells and working memory, so batches may be solved concurrently
+    std::exception_ptr p_exception = nullptr;
+    unsigned exception_batch_index = UINT_MAX;
+    const unsigned num_batches = mCellBatches.size();
+#ifdef CHASTE_OPENMP
+#pragma omp parallel for schedule(dynamic) num_threads(ThreadingTools::GetNumThreads())
+#endif
+    for (unsigned b=0; b<num_batches; b++)
+    {
+        try
+        {
+            if (!updateVoltage)
+            {
+                // Note: Voltage is not being updated. The voltage is updated in the PDE solve.
+                mCellBatches[b]->ComputeExceptVoltage(time, nextTime);
+            }
+            else
+            {
+                mCellBatches[b]->SolveAndUpdateState(time, nextTime);
+            }
+        }
+        catch (...)
+        {
+#ifdef CHASTE_OPENMP
+#pragma omp critical(AbstractCardiacTissueException)
+#endif
+            {
+                if (b < exception_batch_index)
+                {
+                    exception_batch_index = b;
+                    p_exception = std::current_exception();
+                }
+            }
+        }
+    }
+
+    if (p_exception)
+    {
+        std::rethrow_exception(p_exception);
+    }
+
+    for (DistributedVector::Iterator index = rDistributedSolution.Begin();
+         index != rDistributedSolution.End();
+         ++index)
+    {
+        if (mIsCellBatched[index.Local])
+        {
+            if (updateVoltage)
+            {
+                rVoltage[index] = mCellsDistributed[index.Local]->GetVoltage();
+            }
+            UpdateCaches(index.Global, index.Local, nextTime);
+        }
+    }
+}
+
 template <unsigned ELEMENT_DIM,unsigned SPACE_DIM>
 void AbstractCardiacTissue<ELEMENT_DIM,SPACE_DIM>::UpdateCaches(unsigned globalIndex, unsigned localIndex, double nextTime)
 {
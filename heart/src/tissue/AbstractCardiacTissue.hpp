@@ -61,6 +61,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "AbstractDynamicallyLoadableEntity.hpp"
 #include "DynamicModelLoaderRegistry.hpp"
 #include "AbstractConductivityModifier.hpp"
+#include "DistributedVector.hpp"
+#include "AbstractCardiacCellBatch.hpp"
 
 /**
  * Class containing "tissue-like" functionality used in monodomain and bidomain
@@ -302,6 +304,18 @@ protected:
      */
     bool mDoCacheReplication;
 
+    /**
+     * Whether to solve cells whose model provides a batched version together, in
+     * batches (see AbstractCardiacCellBatch). Not archived. Defaults to false.
+     */
+    bool mUseBatchedCellModels;
+
+    /**
+     * Whether batched cell models update their gating variables with the Rush-Larsen
+     * method (see AbstractCardiacCellBatch::SetUseRushLarsen()). Not archived. Defaults to false.
+     */
+    bool mUseRushLarsenInCellBatches;
+
     /**
      * Whether the mesh was unarchived or got from elsewhere.
      */
@@ -350,6 +364,99 @@ protected:
      */
     void SetUpHaloCells(AbstractCardiacCellFactory<ELEMENT_DIM,SPACE_DIM>* pCellFactory);
 
+    /**
+     * The local indices of the cells in #mCellsDistributed, grouped into the tasks that
+     * SolveCellSystems() shares between threads. Task i comprises entries
+     * mCellSolveTaskOffsets[i] to mCellSolveTaskOffsets[i+1]-1. Empty until first needed.
+     */
+    std::vector<unsigned> mCellSolveTaskCells;
+
+    /** The offset of the first cell of each task in #mCellSolveTaskCells, followed by its size. */
+    std::vector<unsigned> mCellSolveTaskOffsets;
+
+    /** The number of threads that the tasks in #mCellSolveTaskOffsets were set up for. */
+    unsigned mCellSolveTaskNumThreads;
+
+    /**
+     * Group the cells in #mCellsDistributed into tasks that may be solved concurrently.
+     *
+     * Cells that share an ODE solver object (for example an AbstractCardiacCell given the
+     * cell factory's solver) must be solved one after another, since the solver holds working
+     * memory. If the solver can be copied (see CanCopyCellSolver()), such a group is split into one
+     * task per thread, and the cells of each task after the first are given their own copy of
+     * the solver; otherwise the group forms one task. Every other cell forms a task on its own.
+     * Also evaluates the ionic current of one cell of each model, so that data shared between
+     * cells of a model and created on first use, such as lookup tables, exist before the threads
+     * start.
+     */
+    void SetUpCellSolveTasks();
+
+    /**
+     * Whether the given ODE solver is of a type known to keep no state between solves other than
+     * working memory (EulerIvpOdeSolver, RungeKutta2IvpOdeSolver and RungeKutta4IvpOdeSolver),
+     * so that CopyCellSolver() can copy it.
+     *
+     * @param pSolver  the solver
+     * @return whether the solver can be copied
+     */
+    static bool CanCopyCellSolver(AbstractIvpOdeSolver* pSolver);
+
+    /**
+     * Create a new ODE solver of the same type as the given one.
+     *
+     * @param pSolver  the solver to copy, for which CanCopyCellSolver() must be true
+     * @return the copy
+     */
+    static boost::shared_ptr<AbstractIvpOdeSolver> CopyCellSolver(AbstractIvpOdeSolver* pSolver);
+
+    /**
+     * Integrate the cell ODEs at one node and update the caches, as required by SolveCellSystems().
+     * If CVODE is enabled and a CVODE cell fails, it is reset and solved again.
+     *
+     * @param rVoltage  the voltage stripe of the current solution vector
+     * @param globalIndex  the global index of the node
+     * @param localIndex  the local index of the node
+     * @param time  the current simulation time
+     * @param nextTime  when to simulate the cell until
+     * @param updateVoltage  whether to also solve for the voltage
+     */
+    void SolveCellSystemAtNode(DistributedVector::Stripe& rVoltage, unsigned globalIndex, unsigned localIndex,
+                               double time, double nextTime, bool updateVoltage);
+
+    /** The batches of cells in #mCellsDistributed that are solved together. Empty until first needed. */
+    std::vector<boost::shared_ptr<AbstractCardiacCellBatch> > mCellBatches;
+
+    /** Whether each cell in #mCellsDistributed belongs to one of #mCellBatches. Empty until first needed. */
+    std::vector<bool> mIsCellBatched;
+
+    /** The number of threads that #mCellBatches were set up for. */
+    unsigned mCellBatchNumThreads;
+
+    /**
+     * Put each cell in #mCellsDistributed whose model provides a batched version (see
+     * AbstractCardiacCell::CreateCellBatch()) into the first batch that can take it,
+     * creating new batches as required, and fill in #mIsCellBatched.
+     *
+     * If ThreadingTools::GetNumThreads() is greater than one, no batch is given more than
+     * its share of the cells owned by this process, so that the cells of one model are
+     * spread over at least that many batches, which SolveCellBatches() solves concurrently.
+     */
+    void SetUpCellBatches();
+
+    /**
+     * Integrate the cell ODEs of the cells in #mCellBatches and update the caches,
+     * as required by SolveCellSystems(). The batches are shared dynamically between
+     * ThreadingTools::GetNumThreads() threads.
+     *
+     * @param rDistributedSolution  the current solution vector
+     * @param rVoltage  the voltage stripe of the current solution vector
+     * @param time  the current simulation time
+     * @param nextTime  when to simulate the cells until
+     * @param updateVoltage  whether to also solve for the voltage
+     */
+    void SolveCellBatches(DistributedVector& rDistributedSolution, DistributedVector::Stripe& rVoltage,
+                          double time, double nextTime, bool updateVoltage);
+
 public:
     /**
      * This constructor is called from the Initialise() method of the CardiacProblem class.
@@ -391,6 +498,36 @@ public:
      */
     bool GetDoCacheReplication();
 
+    /**
+     * Set whether to solve cells whose model provides a batched version (see
+     * AbstractCardiacCellBatch) together, which lets the compiler vectorise the
+     * evaluation of their ODEs. Only cells solved by an EulerIvpOdeSolver are batched,
+     * so results are unchanged unless SetUseRushLarsenInCellBatches() is also called.
+     *
+     * @param useBatchedCellModels  whether to use batched cell models
+     */
+    void SetUseBatchedCellModels(bool useBatchedCellModels);
+
+    /**
+     * @return whether cells whose model provides a batched version are solved together.
+     */
+    bool GetUseBatchedCellModels();
+
+    /**
+     * Set whether batched cell models update the gating variables of their model with the
+     * Rush-Larsen method, rather than forward Euler (see AbstractCardiacCellBatch::SetUseRushLarsen()).
+     * This changes the results compared with solving the cells individually, but allows
+     * larger ODE time steps. Only has an effect if SetUseBatchedCellModels() has been called.
+     *
+     * @param useRushLarsen  whether to use the Rush-Larsen method in batched cell models
+     */
+    void SetUseRushLarsenInCellBatches(bool useRushLarsen);
+
+    /**
+     * @return whether batched cell models update their gating variables with the Rush-Larsen method.
+     */
+    bool GetUseRushLarsenInCellBatches();
+
     /** @return the intracellular conductivity tensor for the given element
      * @param elementIndex  index of the element of interest
      */
@@ -439,6 +576,13 @@ public:
      * Integrate the cell ODEs and update ionic current etc for each of the
      * cells, between the two times provided.
      *
+     * If ThreadingTools::GetNumThreads() is greater than one, the cells owned by this
+     * process are shared dynamically between that many threads (see SetUpCellSolveTasks()).
+     * Purkinje cells are always solved on a single thread.
+     *
+     * If SetUseBatchedCellModels() has been called, cells that belong to a batch
+     * are solved first, a batch at a time, before the remaining cells.
+     *
      * @param existingSolution  the current voltage solution vector
      * @param time  the current simulation time
      * @param nextTime  when to simulate the cells until
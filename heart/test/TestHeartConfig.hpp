@@ -1252,6 +1252,23 @@ public:
         HeartConfig::Instance()->SetUseFixedNumberIterationsLinearSolver(true, 20);
         TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseFixedNumberIterationsLinearSolver(), true);
         TS_ASSERT_EQUALS(HeartConfig::Instance()->GetEvaluateNumItsEveryNSolves(), 20u);
+
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetHdf5DataWriterDeflateLevel(), 0u);
+        HeartConfig::Instance()->SetHdf5DataWriterDeflateLevel(4u);
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetHdf5DataWriterDeflateLevel(), 4u);
+        TS_ASSERT_THROWS_THIS(HeartConfig::Instance()->SetHdf5DataWriterDeflateLevel(10u), "Deflate level must be between 0 and 9.");
+
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseHdf5DataWriterShuffleFilter(), false);
+        HeartConfig::Instance()->SetUseHdf5DataWriterShuffleFilter();
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseHdf5DataWriterShuffleFilter(), true);
+        HeartConfig::Instance()->SetUseHdf5DataWriterShuffleFilter(false);
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseHdf5DataWriterShuffleFilter(), false);
+
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseHdf5DataWriterAsynchronousWrites(), false);
+        HeartConfig::Instance()->SetUseHdf5DataWriterAsynchronousWrites();
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseHdf5DataWriterAsynchronousWrites(), true);
+        HeartConfig::Instance()->SetUseHdf5DataWriterAsynchronousWrites(false);
+        TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseHdf5DataWriterAsynchronousWrites(), false);
     }
 
     void TestPostProcessingFunctions()
@@ -1408,6 +1425,8 @@ public:
         cp::ionic_models_available_type user_ionic = HeartConfig::Instance()->GetDefaultIonicModel().Hardcoded().get();
         TS_ASSERT( user_ionic == cp::ionic_models_available_type::FaberRudy2000 );
         TS_ASSERT_EQUALS(HeartConfig::Instance()->GetSimulationDuration(), 10.0);
+        HeartConfig::Instance()->SetHdf5DataWriterDeflateLevel(3u);
+        HeartConfig::Instance()->SetUseHdf5DataWriterShuffleFilter();
 
         std::ofstream ofs(archive_filename.c_str());
         boost::archive::text_oarchive output_arch(ofs);
@@ -1442,6 +1461,8 @@ public:
             TS_ASSERT_EQUALS(HeartConfig::Instance()->GetSimulationDuration(), 20.0);
             TS_ASSERT(p_heart_config->GetDefaultIonicModel().Hardcoded().present());
             TS_ASSERT_EQUALS( user_ionic, p_heart_config->GetDefaultIonicModel().Hardcoded().get());
+            TS_ASSERT_EQUALS(HeartConfig::Instance()->GetHdf5DataWriterDeflateLevel(), 3u);
+            TS_ASSERT_EQUALS(HeartConfig::Instance()->GetUseHdf5DataWriterShuffleFilter(), true);
 
             // Check that the resume parameters have overridden everything they should have
             TS_ASSERT_DELTA(HeartConfig::Instance()->GetOdeTimeStep(), 0.01, 1e-12);
@@ -56,6 +56,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "CellProperties.hpp"
 #include "CorriasBuistSMCModified.hpp"
 #include "CorriasBuistICCModified.hpp"
+#include "AbstractCardiacCellBatch.hpp"
 
 #include "PetscSetupAndFinalize.hpp"
 
@@ -183,6 +184,150 @@ public:
 
      }
 
+    void TestCellBatches(void)
+    {
+        boost::shared_ptr<ZeroStimulus> p_zero_stimulus(new ZeroStimulus);
+        boost::shared_ptr<SimpleStimulus> p_stimulus(new SimpleStimulus(-0.01, 5.0, 120.0));
+        boost::shared_ptr<EulerIvpOdeSolver> p_solver(new EulerIvpOdeSolver);
+        const double time_step = 0.1;
+        const unsigned num_cells = 5;
+
+        // ICC cells solved one at a time, and copies of them solved as a batch
+        std::vector<boost::shared_ptr<CorriasBuistICCModified> > icc_cells;
+        std::vector<boost::shared_ptr<CorriasBuistICCModified> > batched_icc_cells;
+        for (unsigned c=0; c<num_cells; c++)
+        {
+            boost::shared_ptr<AbstractStimulusFunction> p_cell_stimulus = (c%2 == 0) ? p_stimulus : p_zero_stimulus;
+            icc_cells.push_back(boost::shared_ptr<CorriasBuistICCModified>(new CorriasBuistICCModified(p_solver, p_cell_stimulus)));
+            batched_icc_cells.push_back(boost::shared_ptr<CorriasBuistICCModified>(new CorriasBuistICCModified(p_solver, p_cell_stimulus)));
+            for (unsigned copy=0; copy<2; copy++)
+            {
+                CorriasBuistICCModified* p_cell = (copy == 0) ? icc_cells.back().get() : batched_icc_cells.back().get();
+                p_cell->SetTimestep(time_step);
+                p_cell->SetIP3Concentration(0.000635);
+                p_cell->SetFractionOfVDDRInPU(0.04);
+                p_cell->SetVoltage(p_cell->GetVoltage() + c);
+            }
+        }
+
+        boost::shared_ptr<AbstractCardiacCellBatch> p_icc_batch(batched_icc_cells[0]->CreateCellBatch());
+        TS_ASSERT(p_icc_batch);
+        for (unsigned c=0; c<num_cells; c++)
+        {
+            TS_ASSERT(p_icc_batch->CanAddCell(batched_icc_cells[c].get()));
+            p_icc_batch->AddCell(batched_icc_cells[c].get());
+        }
+
+        // ICC cells with different settings can't be added to the batch
+        CorriasBuistICCModified other_icc_cell(p_solver, p_zero_stimulus);
+        other_icc_cell.SetTimestep(time_step);
+        other_icc_cell.SetFractionOfVDDRInPU(0.04);
+        TS_ASSERT(!p_icc_batch->CanAddCell(&other_icc_cell));
+        other_icc_cell.SetIP3Concentration(0.000635);
+        TS_ASSERT(p_icc_batch->CanAddCell(&other_icc_cell));
+        other_icc_cell.SetSercaPumpScaleFactor(0.5);
+        TS_ASSERT(!p_icc_batch->CanAddCell(&other_icc_cell));
+
+        // SMC cells, with the fake ICC stimulus, likewise
+        std::vector<boost::shared_ptr<CorriasBuistSMCModified> > smc_cells;
+        std::vector<boost::shared_ptr<CorriasBuistSMCModified> > batched_smc_cells;
+        for (unsigned c=0; c<num_cells; c++)
+        {
+            smc_cells.push_back(boost::shared_ptr<CorriasBuistSMCModified>(new CorriasBuistSMCModified(p_solver, p_zero_stimulus)));
+            batched_smc_cells.push_back(boost::shared_ptr<CorriasBuistSMCModified>(new CorriasBuistSMCModified(p_solver, p_zero_stimulus)));
+            for (unsigned copy=0; copy<2; copy++)
+            {
+                CorriasBuistSMCModified* p_cell = (copy == 0) ? smc_cells.back().get() : batched_smc_cells.back().get();
+                p_cell->SetTimestep(time_step);
+                p_cell->SetVoltage(p_cell->GetVoltage() + c);
+            }
+        }
+
+        boost::shared_ptr<AbstractCardiacCellBatch> p_smc_batch(batched_smc_cells[0]->CreateCellBatch());
+        TS_ASSERT(p_smc_batch);
+        for (unsigned c=0; c<num_cells; c++)
+        {
+            TS_ASSERT(p_smc_batch->CanAddCell(batched_smc_cells[c].get()));
+            p_smc_batch->AddCell(batched_smc_cells[c].get());
+        }
+        TS_ASSERT(!p_smc_batch->CanAddCell(&other_icc_cell));
+
+        CorriasBuistSMCModified other_smc_cell(p_solver, p_zero_stimulus);
+        other_smc_cell.SetTimestep(time_step);
+        other_smc_cell.SetFakeIccStimulusPresent(false);
+        TS_ASSERT(!p_smc_batch->CanAddCell(&other_smc_cell));
+        other_smc_cell.SetFakeIccStimulusPresent(true);
+        other_smc_cell.SetCarbonMonoxideScaleFactor(2.0);
+        TS_ASSERT(!p_smc_batch->CanAddCell(&other_smc_cell));
+
+        // Solve without and then with updating the voltage
+        for (unsigned step=0; step<100; step++)
+        {
+            double time = 10.0*step;
+            for (unsigned c=0; c<num_cells; c++)
+            {
+                if (step < 10)
+                {
+                    icc_cells[c]->ComputeExceptVoltage(time, time+10.0);
+                    smc_cells[c]->ComputeExceptVoltage(time, time+10.0);
+                }
+                else
+                {
+                    icc_cells[c]->SolveAndUpdateState(time, time+10.0);
+                    smc_cells[c]->SolveAndUpdateState(time, time+10.0);
+                }
+            }
+            if (step < 10)
+            {
+                p_icc_batch->ComputeExceptVoltage(time, time+10.0);
+                p_smc_batch->ComputeExceptVoltage(time, time+10.0);
+            }
+            else
+            {
+                p_icc_batch->SolveAndUpdateState(time, time+10.0);
+                p_smc_batch->SolveAndUpdateState(time, time+10.0);
+            }
+        }
+
+        // The batches step exactly as the cells' own solver does
+        for (unsigned c=0; c<num_cells; c++)
+        {
+            for (unsigned i=0; i<icc_cells[c]->GetNumberOfStateVariables(); i++)
+            {
+                TS_ASSERT_DELTA(batched_icc_cells[c]->GetStateVariable(i), icc_cells[c]->GetStateVariable(i), 1e-12);
+            }
+            for (unsigned i=0; i<smc_cells[c]->GetNumberOfStateVariables(); i++)
+            {
+                TS_ASSERT_DELTA(batched_smc_cells[c]->GetStateVariable(i), smc_cells[c]->GetStateVariable(i), 1e-12);
+            }
+        }
+
+        // With the Rush-Larsen method, the gating variables are updated differently, but the
+        // solution stays close to the forward Euler one
+        TS_ASSERT_EQUALS(p_smc_batch->GetUseRushLarsen(), false);
+        p_smc_batch->SetUseRushLarsen(true);
+        TS_ASSERT_EQUALS(p_smc_batch->GetUseRushLarsen(), true);
+        for (unsigned step=100; step<200; step++)
+        {
+            double time = 10.0*step;
+            for (unsigned c=0; c<num_cells; c++)
+            {
+                smc_cells[c]->SolveAndUpdateState(time, time+10.0);
+            }
+            p_smc_batch->SolveAndUpdateState(time, time+10.0);
+        }
+        for (unsigned c=0; c<num_cells; c++)
+        {
+            TS_ASSERT_DIFFERS(batched_smc_cells[c]->GetStateVariable("d_CaL"), smc_cells[c]->GetStateVariable("d_CaL"));
+            TS_ASSERT_DELTA(batched_smc_cells[c]->GetVoltage(), smc_cells[c]->GetVoltage(), 2.0);
+            for (unsigned i=1; i<=12; i++)
+            {
+                TS_ASSERT_LESS_THAN_EQUALS(0.0, batched_smc_cells[c]->GetStateVariable(i));
+                TS_ASSERT_LESS_THAN_EQUALS(batched_smc_cells[c]->GetStateVariable(i), 1.0);
+            }
+        }
+    }
+
     void TestArchiving(void)
     {
         //Archive
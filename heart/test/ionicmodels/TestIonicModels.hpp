@@ -65,6 +65,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "HodgkinHuxley1952.hpp"
 #include "HodgkinHuxley1952BackwardEulerOpt.hpp"
 #include "FitzHughNagumo1961OdeSystem.hpp"
+#include "AbstractCardiacCellBatch.hpp"
 #include "LuoRudy1991.hpp"
 #include "LuoRudy1991BackwardEulerOpt.hpp"
 
@@ -402,6 +403,84 @@ public:
 
     }
 
+    void TestFHN61CellBatch(void)
+    {
+        boost::shared_ptr<SimpleStimulus> p_stimulus(new SimpleStimulus(0.2, 0.5, 0.1));
+        boost::shared_ptr<ZeroStimulus> p_zero_stimulus(new ZeroStimulus);
+        boost::shared_ptr<EulerIvpOdeSolver> p_solver(new EulerIvpOdeSolver);
+
+        // Cells solved one at a time, and copies of them solved as a batch
+        const unsigned num_cells = 7;
+        std::vector<boost::shared_ptr<FitzHughNagumo1961OdeSystem> > cells;
+        std::vector<boost::shared_ptr<FitzHughNagumo1961OdeSystem> > batched_cells;
+        for (unsigned c=0; c<num_cells; c++)
+        {
+            boost::shared_ptr<AbstractStimulusFunction> p_cell_stimulus = p_zero_stimulus;
+            if (c%2 == 0)
+            {
+                p_cell_stimulus = p_stimulus;
+            }
+            cells.push_back(boost::shared_ptr<FitzHughNagumo1961OdeSystem>(new FitzHughNagumo1961OdeSystem(p_solver, p_cell_stimulus)));
+            batched_cells.push_back(boost::shared_ptr<FitzHughNagumo1961OdeSystem>(new FitzHughNagumo1961OdeSystem(p_solver, p_cell_stimulus)));
+            cells.back()->SetTimestep(0.01);
+            batched_cells.back()->SetTimestep(0.01);
+            cells.back()->SetStateVariable(1u, 0.01*c);
+            batched_cells.back()->SetStateVariable(1u, 0.01*c);
+        }
+
+        boost::shared_ptr<AbstractCardiacCellBatch> p_batch(batched_cells[0]->CreateCellBatch());
+        TS_ASSERT(p_batch);
+        for (unsigned c=0; c<num_cells; c++)
+        {
+            TS_ASSERT(p_batch->CanAddCell(batched_cells[c].get()));
+            p_batch->AddCell(batched_cells[c].get());
+        }
+        TS_ASSERT_EQUALS(p_batch->GetNumCells(), num_cells);
+
+        // Cells that differ from those in the batch can't be added to it
+        FitzHughNagumo1961OdeSystem other_timestep_cell(p_solver, p_zero_stimulus);
+        other_timestep_cell.SetTimestep(0.02);
+        TS_ASSERT(!p_batch->CanAddCell(&other_timestep_cell));
+        boost::shared_ptr<RungeKutta4IvpOdeSolver> p_rk4_solver(new RungeKutta4IvpOdeSolver);
+        FitzHughNagumo1961OdeSystem other_solver_cell(p_rk4_solver, p_zero_stimulus);
+        other_solver_cell.SetTimestep(0.01);
+        TS_ASSERT(!p_batch->CanAddCell(&other_solver_cell));
+        CellLuoRudy1991FromCellML other_model_cell(p_solver, p_zero_stimulus);
+        other_model_cell.SetTimestep(0.01);
+        TS_ASSERT(!p_batch->CanAddCell(&other_model_cell));
+        TS_ASSERT(!other_model_cell.CreateCellBatch());
+
+        // Solve without and then with updating the voltage
+        for (unsigned step=0; step<10; step++)
+        {
+            double time = 0.1*step;
+            if (step < 5)
+            {
+                for (unsigned c=0; c<num_cells; c++)
+                {
+                    cells[c]->ComputeExceptVoltage(time, time+0.1);
+                }
+                p_batch->ComputeExceptVoltage(time, time+0.1);
+            }
+            else
+            {
+                for (unsigned c=0; c<num_cells; c++)
+                {
+                    cells[c]->SolveAndUpdateState(time, time+0.1);
+                }
+                p_batch->SolveAndUpdateState(time, time+0.1);
+            }
+        }
+
+        for (unsigned c=0; c<num_cells; c++)
+        {
+            TS_ASSERT_DELTA(batched_cells[c]->GetVoltage(), cells[c]->GetVoltage(), 1e-12);
+            TS_ASSERT_DELTA(batched_cells[c]->GetStateVariable(1u), cells[c]->GetStateVariable(1u), 1e-12);
+        }
+        // The stimulated cell has depolarised
+        TS_ASSERT_LESS_THAN(0.0, cells[0]->GetVoltage());
+    }
+
 
     void TestSolverForLR91WithDelayedSimpleStimulus(void)
     {
@@ -39,6 +39,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #include <cxxtest/TestSuite.h>
+#include <fstream>
+#include <sstream>
 #include <vector>
 
 #include "TetrahedralMesh.hpp"
@@ -50,6 +52,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "PlaneStimulusCellFactory.hpp"
 #include "LuoRudy1991.hpp"
 #include "ActivationOutputModifier.hpp"
+#include "PostProcessingOutputModifier.hpp"
 #include "NumericFileComparison.hpp"
 
 class TestMonodomainConductionVelocity : public CxxTest::TestSuite
@@ -90,6 +93,10 @@ public:
         boost::shared_ptr<ActivationOutputModifier> activation_map_minus70(new ActivationOutputModifier("activation_map_-70.0.txt", -70.0));
         monodomain_problem.AddOutputModifier(activation_map_0);
         monodomain_problem.AddOutputModifier(activation_map_minus70);
+        boost::shared_ptr<PostProcessingOutputModifier> maps(new PostProcessingOutputModifier("maps"));
+        maps->AddUpstrokeTimeMap(-30.0);
+        maps->AddMaxUpstrokeVelocityMap(-30.0);
+        monodomain_problem.AddOutputModifier(maps);
 
         monodomain_problem.Solve();
 
@@ -124,6 +131,36 @@ public:
         // The value should be approximately 50cm/sec
         // i.e. 0.05 cm/msec (which is the units of the simulation)
         TS_ASSERT_DELTA(velocity, 0.05, 0.003);
+
+        // The on-the-fly maps sample every PDE time step, which here is also the printing time step,
+        // so they match post-processing of the output nodes
+        std::ifstream upstroke_times_file((handler.GetOutputDirectoryFullPath() + "maps_UpstrokeTimeMap_-30.dat").c_str());
+        std::ifstream upstroke_velocities_file((handler.GetOutputDirectoryFullPath() + "maps_MaxUpstrokeVelocityMap_-30.dat").c_str());
+        TS_ASSERT(upstroke_times_file.is_open());
+        TS_ASSERT(upstroke_velocities_file.is_open());
+        for (unsigned node_index=0; node_index<=95; node_index++)
+        {
+            std::string upstroke_times_line;
+            std::string upstroke_velocities_line;
+            std::getline(upstroke_times_file, upstroke_times_line);
+            std::getline(upstroke_velocities_file, upstroke_velocities_line);
+            if (node_index == 5u || node_index == 95u)
+            {
+                std::vector<double> upstroke_times = ppc.CalculateUpstrokeTimes(node_index, -30.0);
+                std::vector<double> upstroke_velocities = ppc.CalculateAllMaximumUpstrokeVelocities(node_index, -30.0);
+                TS_ASSERT_EQUALS(upstroke_times.size(), 1u);
+                TS_ASSERT_EQUALS(upstroke_velocities.size(), 1u);
+
+                std::stringstream upstroke_times_stream(upstroke_times_line);
+                std::stringstream upstroke_velocities_stream(upstroke_velocities_line);
+                double upstroke_time;
+                double upstroke_velocity;
+                upstroke_times_stream >> upstroke_time;
+                upstroke_velocities_stream >> upstroke_velocity;
+                TS_ASSERT_DELTA(upstroke_time, upstroke_times[0], 1e-4);
+                TS_ASSERT_DELTA(upstroke_velocity, upstroke_velocities[0], 1e-4*upstroke_velocities[0]);
+            }
+        }
     }
 
     // Solve on a 1D string of cells, 1cm long with a space step of 0.5mm.
@@ -1695,6 +1695,41 @@ public:
                                                 1e-4));
     }
 
+    void TestMonodomainProblemWithCompressedAsynchronousOutput()
+    {
+        HeartConfig::Instance()->SetOdePdeAndPrintingTimeSteps(0.01, 0.01, 0.01);
+        HeartConfig::Instance()->SetSimulationDuration(1.0);
+        HeartConfig::Instance()->SetMeshFileName("mesh/test/data/1D_0_to_1mm_10_elements");
+        HeartConfig::Instance()->SetOutputDirectory("MonodomainWithCompressedAsynchronousOutput");
+        HeartConfig::Instance()->SetOutputFilenamePrefix("MonodomainLR91_1d_compressed");
+        HeartConfig::Instance()->SetHdf5DataWriterDeflateLevel(4u);
+        HeartConfig::Instance()->SetUseHdf5DataWriterShuffleFilter();
+        HeartConfig::Instance()->SetUseHdf5DataWriterAsynchronousWrites();
+
+        PlaneStimulusCellFactory<CellLuoRudy1991FromCellML, 1> cell_factory;
+        MonodomainProblem<1> monodomain_problem(&cell_factory);
+
+        monodomain_problem.Initialise();
+        monodomain_problem.Solve();
+
+        // There is a warning if the writes could not be made asynchronously, but the results are the same
+        Warnings::QuietDestroy();
+        TS_ASSERT(CompareFilesViaHdf5DataReader("MonodomainWithCompressedAsynchronousOutput", "MonodomainLR91_1d_compressed", true,
+                                                "heart/test/data/MonodomainWithWriterCache", "MonodomainLR91_1d_with_cache", false,
+                                                2e-4));
+
+        // Check the filters were applied to the dataset
+        OutputFileHandler file_handler("MonodomainWithCompressedAsynchronousOutput", false);
+        FileFinder file = file_handler.FindFile("MonodomainLR91_1d_compressed.h5");
+        hid_t h5_file = H5Fopen(file.GetAbsolutePath().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        hid_t dset = H5Dopen(h5_file, "Data", H5P_DEFAULT);
+        hid_t dcpl = H5Dget_create_plist(dset);
+        TS_ASSERT_EQUALS(H5Pget_nfilters(dcpl), 2);
+        H5Pclose(dcpl);
+        H5Dclose(dset);
+        H5Fclose(h5_file);
+    }
+
     void TestMonodomainProblemWithTargetChunkSizeAndAlignment()
     {
         {
@@ -47,6 +47,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "SimpleStimulus.hpp"
 #include "EulerIvpOdeSolver.hpp"
 #include "LuoRudy1991.hpp"
+#include "FitzHughNagumo1961OdeSystem.hpp"
 #include "MonodomainTissue.hpp"
 #include "OdeSolution.hpp"
 #include "AbstractCardiacCellFactory.hpp"
@@ -59,6 +60,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ArchiveOpener.hpp"
 #include "DiFrancescoNoble1985.hpp"
 #include "MonodomainProblem.hpp"
+#include "ThreadingTools.hpp"
 
 #include "PetscSetupAndFinalize.hpp"
 
@@ -94,6 +96,74 @@ public:
     }
 };
 
+class MixedSolverCellFactory : public AbstractCardiacCellFactory<1>
+{
+private:
+    boost::shared_ptr<SimpleStimulus> mpStimulus;
+
+public:
+
+    MixedSolverCellFactory()
+        : AbstractCardiacCellFactory<1>(),
+          mpStimulus(new SimpleStimulus(-600.0, 0.5))
+    {
+    }
+
+    AbstractCardiacCell* CreateCardiacCellForTissueNode(Node<1>* pNode)
+    {
+        unsigned node_index = pNode->GetIndex();
+
+        // Cells at odd nodes share the factory's solver; cells at even nodes have their own
+        boost::shared_ptr<AbstractIvpOdeSolver> p_solver = mpSolver;
+        if (node_index%2 == 0)
+        {
+            p_solver.reset(new EulerIvpOdeSolver);
+        }
+
+        if (node_index==0)
+        {
+            return new CellLuoRudy1991FromCellML(p_solver, mpStimulus);
+        }
+        else
+        {
+            return new CellLuoRudy1991FromCellML(p_solver, mpZeroStimulus);
+        }
+    }
+};
+
+class BatchableCellFactory : public AbstractCardiacCellFactory<1>
+{
+private:
+    boost::shared_ptr<SimpleStimulus> mpStimulus;
+
+public:
+
+    BatchableCellFactory()
+        : AbstractCardiacCellFactory<1>(),
+          mpStimulus(new SimpleStimulus(700.0, 0.5))
+    {
+    }
+
+    AbstractCardiacCell* CreateCardiacCellForTissueNode(Node<1>* pNode)
+    {
+        unsigned node_index = pNode->GetIndex();
+
+        // Every fifth node has a cell model without a batched version
+        if (node_index%5 == 2)
+        {
+            return new CellLuoRudy1991FromCellML(mpSolver, mpZeroStimulus);
+        }
+        else if (node_index==0)
+        {
+            return new FitzHughNagumo1961OdeSystem(mpSolver, mpStimulus);
+        }
+        else
+        {
+            return new FitzHughNagumo1961OdeSystem(mpSolver, mpZeroStimulus);
+        }
+    }
+};
+
 class PurkinjeCellFactory : public AbstractPurkinjeCellFactory<2>
 {
 private:
@@ -322,6 +392,198 @@ public:
         PetscTools::Destroy(voltage2);
     }
 
+    void TestSolveCellSystemsWithThreads()
+    {
+        HeartConfig::Instance()->Reset();
+        DistributedTetrahedralMesh<1,1> mesh;
+        mesh.ConstructRegularSlabMesh(0.01, 0.2); // 21 nodes
+
+        MixedSolverCellFactory serial_cell_factory;
+        serial_cell_factory.SetMesh(&mesh);
+        MonodomainTissue<1> serial_tissue(&serial_cell_factory);
+
+        MixedSolverCellFactory threaded_cell_factory;
+        threaded_cell_factory.SetMesh(&mesh);
+        MonodomainTissue<1> threaded_tissue(&threaded_cell_factory);
+
+        Vec serial_voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), -83.853);
+        Vec threaded_voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), -83.853);
+
+        // Solve without and then with updating the voltage, on one thread and then on as many as are available
+        for (unsigned step=0; step<4; step++)
+        {
+            double time = 0.1*step;
+            bool update_voltage = (step >= 2);
+
+            ThreadingTools::SetNumThreads(1);
+            serial_tissue.SolveCellSystems(serial_voltage, time, time+0.1, update_voltage);
+
+            ThreadingTools::SetNumThreads(ThreadingTools::GetMaxNumThreads());
+            threaded_tissue.SolveCellSystems(threaded_voltage, time, time+0.1, update_voltage);
+        }
+        ThreadingTools::Reset();
+
+        // The results should be bit-identical
+        ReplicatableVector serial_voltage_repl(serial_voltage);
+        ReplicatableVector threaded_voltage_repl(threaded_voltage);
+        DistributedVectorFactory* p_factory = mesh.GetDistributedVectorFactory();
+        for (unsigned index=p_factory->GetLow(); index<p_factory->GetHigh(); index++)
+        {
+            TS_ASSERT_EQUALS(threaded_voltage_repl[index], serial_voltage_repl[index]);
+            TS_ASSERT_EQUALS(threaded_tissue.rGetIionicCacheReplicated()[index], serial_tissue.rGetIionicCacheReplicated()[index]);
+            TS_ASSERT(threaded_tissue.GetCardiacCell(index)->GetStdVecStateVariables()
+                      == serial_tissue.GetCardiacCell(index)->GetStdVecStateVariables());
+        }
+
+        PetscTools::Destroy(serial_voltage);
+        PetscTools::Destroy(threaded_voltage);
+    }
+
+    void TestCellSolveTasksWithDefaultCellFactory()
+    {
+        HeartConfig::Instance()->Reset();
+        DistributedTetrahedralMesh<1,1> mesh;
+        mesh.ConstructRegularSlabMesh(0.01, 0.2); // 21 nodes
+
+        // All the cells created by this factory share its forward Euler solver
+        PlaneStimulusCellFactory<CellLuoRudy1991FromCellML, 1> cell_factory;
+        cell_factory.SetMesh(&mesh);
+        MonodomainTissue<1> tissue(&cell_factory);
+        unsigned num_local_cells = mesh.GetDistributedVectorFactory()->GetLocalOwnership();
+
+        // On one thread they form a single task...
+        tissue.SetUpCellSolveTasks();
+        TS_ASSERT_EQUALS(tissue.mCellSolveTaskOffsets.size(), std::min(num_local_cells, 1u) + 1);
+        TS_ASSERT_EQUALS(tissue.mCellSolveTaskNumThreads, 1u);
+        if (num_local_cells > 0)
+        {
+            TS_ASSERT(AbstractCardiacTissue<1>::CanCopyCellSolver(tissue.mCellsDistributed[0]->GetSolver().get()));
+        }
+
+        // ...but the solver can be copied, so on more threads they are shared between one task per thread
+        if (ThreadingTools::IsThreadingAvailable())
+        {
+            // The tasks were set up for one thread, so solving on two sets them up again
+            Vec voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), -83.853);
+            ThreadingTools::SetNumThreads(2);
+            tissue.SolveCellSystems(voltage, 0.0, 0.1, false);
+            ThreadingTools::Reset();
+            PetscTools::Destroy(voltage);
+            TS_ASSERT_EQUALS(tissue.mCellSolveTaskNumThreads, 2u);
+
+            unsigned num_tasks = tissue.mCellSolveTaskOffsets.size() - 1;
+            TS_ASSERT_EQUALS(num_tasks, std::min(num_local_cells, 2u));
+            TS_ASSERT_EQUALS(tissue.mCellSolveTaskCells.size(), num_local_cells);
+
+            // The cells of each task share a solver, which no other task uses
+            std::set<AbstractIvpOdeSolver*> task_solvers;
+            for (unsigned task_index=0; task_index<num_tasks; task_index++)
+            {
+                unsigned first_cell = tissue.mCellSolveTaskCells[tissue.mCellSolveTaskOffsets[task_index]];
+                AbstractIvpOdeSolver* p_solver = tissue.mCellsDistributed[first_cell]->GetSolver().get();
+                TS_ASSERT(dynamic_cast<EulerIvpOdeSolver*>(p_solver) != nullptr);
+                TS_ASSERT(task_solvers.insert(p_solver).second);
+
+                for (unsigned i=tissue.mCellSolveTaskOffsets[task_index]; i<tissue.mCellSolveTaskOffsets[task_index+1]; i++)
+                {
+                    TS_ASSERT_EQUALS(tissue.mCellsDistributed[tissue.mCellSolveTaskCells[i]]->GetSolver().get(), p_solver);
+                }
+            }
+        }
+    }
+
+    void TestSolveCellSystemsWithBatchedCellModels()
+    {
+        HeartConfig::Instance()->Reset();
+        DistributedTetrahedralMesh<1,1> mesh;
+        mesh.ConstructRegularSlabMesh(0.01, 0.2); // 21 nodes
+
+        BatchableCellFactory cell_factory;
+        cell_factory.SetMesh(&mesh);
+        MonodomainTissue<1> tissue(&cell_factory);
+        TS_ASSERT_EQUALS(tissue.GetUseBatchedCellModels(), false);
+
+        BatchableCellFactory batched_cell_factory;
+        batched_cell_factory.SetMesh(&mesh);
+        MonodomainTissue<1> batched_tissue(&batched_cell_factory);
+        batched_tissue.SetUseBatchedCellModels(true);
+        TS_ASSERT_EQUALS(batched_tissue.GetUseBatchedCellModels(), true);
+
+        Vec voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), 0.0);
+        Vec batched_voltage = PetscTools::CreateAndSetVec(mesh.GetNumNodes(), 0.0);
+
+        // Solve without and then with updating the voltage
+        for (unsigned step=0; step<4; step++)
+        {
+            double time = 0.1*step;
+            bool update_voltage = (step >= 2);
+            tissue.SolveCellSystems(voltage, time, time+0.1, update_voltage);
+            batched_tissue.SolveCellSystems(batched_voltage, time, time+0.1, update_voltage);
+        }
+
+        // Batching only changes the order of the arithmetic within each cell if the compiler contracts it differently
+        ReplicatableVector voltage_repl(voltage);
+        ReplicatableVector batched_voltage_repl(batched_voltage);
+        DistributedVectorFactory* p_factory = mesh.GetDistributedVectorFactory();
+        for (unsigned index=p_factory->GetLow(); index<p_factory->GetHigh(); index++)
+        {
+            TS_ASSERT_DELTA(batched_voltage_repl[index], voltage_repl[index], 1e-12);
+            TS_ASSERT_DELTA(batched_tissue.rGetIionicCacheReplicated()[index], tissue.rGetIionicCacheReplicated()[index], 1e-12);
+            std::vector<double> state = tissue.GetCardiacCell(index)->GetStdVecStateVariables();
+            std::vector<double> batched_state = batched_tissue.GetCardiacCell(index)->GetStdVecStateVariables();
+            TS_ASSERT_EQUALS(batched_state.size(), state.size());
+            for (unsigned i=0; i<state.size(); i++)
+            {
+                TS_ASSERT_DELTA(batched_state[i], state[i], 1e-12);
+            }
+        }
+
+        // The stimulated cell has depolarised
+        if (p_factory->GetLow() == 0)
+        {
+            TS_ASSERT_LESS_THAN(0.0, batched_voltage_repl[0]);
+        }
+
+        // On more threads the cells are spread over one batch per thread, which are solved concurrently
+        if (ThreadingTools::IsThreadingAvailable())
+        {
+            ThreadingTools::SetNumThreads(2);
+            tissue.SolveCellSystems(voltage, 0.4, 0.5, true);
+            batched_tissue.SolveCellSystems(batched_voltage, 0.4, 0.5, true);
+            ThreadingTools::Reset();
+
+            TS_ASSERT_EQUALS(batched_tissue.mCellBatchNumThreads, 2u);
+            unsigned max_batch_size = (p_factory->GetLocalOwnership() + 1)/2;
+            for (unsigned b=0; b<batched_tissue.mCellBatches.size(); b++)
+            {
+                TS_ASSERT_LESS_THAN_EQUALS(batched_tissue.mCellBatches[b]->GetNumCells(), max_batch_size);
+            }
+            if (PetscTools::IsSequential())
+            {
+                TS_ASSERT_EQUALS(batched_tissue.mCellBatches.size(), 2u);
+            }
+
+            ReplicatableVector threaded_voltage_repl(voltage);
+            ReplicatableVector threaded_batched_voltage_repl(batched_voltage);
+            for (unsigned index=p_factory->GetLow(); index<p_factory->GetHigh(); index++)
+            {
+                TS_ASSERT_DELTA(threaded_batched_voltage_repl[index], threaded_voltage_repl[index], 1e-12);
+            }
+        }
+
+        // The Rush-Larsen setting is passed on to existing batches
+        TS_ASSERT_EQUALS(batched_tissue.GetUseRushLarsenInCellBatches(), false);
+        batched_tissue.SetUseRushLarsenInCellBatches(true);
+        TS_ASSERT_EQUALS(batched_tissue.GetUseRushLarsenInCellBatches(), true);
+        for (unsigned b=0; b<batched_tissue.mCellBatches.size(); b++)
+        {
+            TS_ASSERT_EQUALS(batched_tissue.mCellBatches[b]->GetUseRushLarsen(), true);
+        }
+
+        PetscTools::Destroy(voltage);
+        PetscTools::Destroy(batched_voltage);
+    }
+
     void TestNodeExchange()
     {
         HeartConfig::Instance()->Reset();
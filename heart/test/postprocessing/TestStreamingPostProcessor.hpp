@@ -0,0 +1,240 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _TESTSTREAMINGPOSTPROCESSOR_HPP_
+#define _TESTSTREAMINGPOSTPROCESSOR_HPP_
+
+#include <cxxtest/TestSuite.h>
+#include <fstream>
+#include <vector>
+
+#include "CellProperties.hpp"
+#include "DistributedVectorFactory.hpp"
+#include "Exception.hpp"
+#include "FileFinder.hpp"
+#include "Hdf5DataReader.hpp"
+#include "PropagationPropertiesCalculator.hpp"
+#include "StreamingCellProperties.hpp"
+#include "StreamingPostProcessor.hpp"
+
+#include "PetscSetupAndFinalize.hpp"
+
+class TestStreamingPostProcessor : public CxxTest::TestSuite
+{
+private:
+    void LoadMeshalyzerOutputTraces(const std::string& rFileName, const unsigned length, std::vector<double>& rTime, std::vector<double>& rVoltage)
+    {
+        FileFinder file_finder(rFileName, RelativeTo::ChasteSourceRoot);
+        std::ifstream apd_file((file_finder.GetAbsolutePath()).c_str());
+        TS_ASSERT(apd_file.is_open());
+
+        rVoltage.resize(length);
+        rTime.resize(length);
+        for (unsigned i = 0; i < length; ++i)
+        {
+            apd_file >> rTime[i];
+            apd_file >> rVoltage[i];
+        }
+        apd_file.close();
+    }
+
+    /* Check that feeding a trace in one sample at a time gives exactly what CellProperties does */
+    void CompareWithCellProperties(const std::vector<double>& rTime, const std::vector<double>& rVoltage, double threshold)
+    {
+        std::vector<double> percentages;
+        percentages.push_back(30.0);
+        percentages.push_back(50.0);
+        percentages.push_back(90.0);
+
+        StreamingCellProperties streaming_properties(threshold, percentages);
+        for (unsigned i=0; i<rTime.size(); i++)
+        {
+            streaming_properties.AddSample(rTime[i], rVoltage[i]);
+        }
+        streaming_properties.Finish();
+        CellProperties cell_properties(rVoltage, rTime, threshold);
+
+        TS_ASSERT_EQUALS(streaming_properties.GetMaxUpstrokeVelocities(), cell_properties.GetMaxUpstrokeVelocities());
+        TS_ASSERT_EQUALS(streaming_properties.GetTimesAtMaxUpstrokeVelocity(), cell_properties.GetTimesAtMaxUpstrokeVelocity());
+        TS_ASSERT_EQUALS(streaming_properties.GetNumberOfAboveThresholdDepolarisationsForAllAps(),
+                         cell_properties.GetNumberOfAboveThresholdDepolarisationsForAllAps());
+        for (unsigned i=0; i<percentages.size(); i++)
+        {
+            TS_ASSERT_EQUALS(streaming_properties.GetAllActionPotentialDurations(percentages[i]),
+                             cell_properties.GetAllActionPotentialDurations(percentages[i]));
+        }
+    }
+
+public:
+    void TestStreamingCellProperties()
+    {
+        std::vector<double> times;
+        std::vector<double> voltages;
+
+        LoadMeshalyzerOutputTraces("heart/test/data/sample_APs/phenomenological_delayed_stim.dat", 5001, times, voltages);
+        CompareWithCellProperties(times, voltages, 0.4);
+        CompareWithCellProperties(times, voltages, 0.1);
+
+        // A small spike followed by a full action potential, giving APDs that start below threshold
+        LoadMeshalyzerOutputTraces("heart/test/data/sample_APs/Tricky_alternans.dat", 22674, times, voltages);
+        CompareWithCellProperties(times, voltages, -30.0);
+        CompareWithCellProperties(times, voltages, -50.0);
+        CompareWithCellProperties(times, voltages, -70.0);
+
+        {
+            // Ten APs, with EADs
+            std::ifstream apd_file("heart/test/data/sample_APs/TrickyAPD.dat");
+            TS_ASSERT(apd_file.is_open());
+            voltages.resize(15001);
+            times.resize(15001);
+            for (unsigned i=0; i<15001; i++)
+            {
+                apd_file >> voltages[i];
+                times[i] = i;
+            }
+            CompareWithCellProperties(times, voltages, -30.0);
+            CompareWithCellProperties(times, voltages, 0.0);
+        }
+
+        // Exceptions match those of CellProperties
+        std::vector<double> percentages(1u, 90.0);
+        StreamingCellProperties no_samples(-30.0, percentages);
+        TS_ASSERT_THROWS_THIS(no_samples.Finish(), "Insufficient time steps to calculate physiological properties.");
+
+        StreamingCellProperties flat(-30.0, percentages);
+        for (unsigned i=0; i<10; i++)
+        {
+            flat.AddSample(i, -84.0);
+        }
+        flat.Finish();
+        TS_ASSERT_THROWS_THIS(flat.GetMaxUpstrokeVelocities(), "AP did not occur, never descended past threshold voltage.");
+        TS_ASSERT_THROWS_THIS(flat.GetAllActionPotentialDurations(90.0), "AP did not occur, never exceeded threshold voltage.");
+        TS_ASSERT_THROWS_THIS(flat.GetAllActionPotentialDurations(50.0), "APD50 was not requested when these properties were constructed.");
+        TS_ASSERT_EQUALS(flat.GetNumberOfAboveThresholdDepolarisationsForAllAps().size(), 0u);
+
+        StreamingCellProperties unfinished(-30.0, percentages);
+        unfinished.AddSample(0.0, -84.0);
+        unfinished.AddSample(1.0, 20.0);
+        unfinished.Finish();
+        TS_ASSERT_EQUALS(unfinished.GetMaxUpstrokeVelocities().size(), 1u);
+        TS_ASSERT_THROWS_THIS(unfinished.GetAllActionPotentialDurations(90.0), "No full action potential was recorded");
+    }
+
+    void TestStreamingPostProcessorMatchesPropagationPropertiesCalculator()
+    {
+        Hdf5DataReader reader("heart/test/data/PostProcessingWriter", "Ead", false);
+        unsigned num_nodes = reader.GetNumberOfRows();
+        DistributedVectorFactory factory(num_nodes);
+        unsigned lo = factory.GetLow();
+        unsigned hi = factory.GetHigh();
+
+        StreamingPostProcessor processor(lo, hi);
+        processor.AddApdMap(90.0, -30.0);
+        processor.AddApdMap(50.0, -60.0);
+        processor.AddUpstrokeTimeMap(-60.0);
+        processor.AddMaxUpstrokeVelocityMap(0.0);
+        processor.AddConductionVelocityMaps();
+        processor.ProcessHdf5Data(reader, "V");
+        TS_ASSERT_THROWS_THIS(processor.AddUpstrokeTimeMap(-50.0), "Maps must be requested before any time steps are processed.");
+        processor.Finish();
+
+        TS_ASSERT_THROWS_THIS(processor.GetUpstrokeTimeMap(-50.0), "No map was requested with a threshold of -50.");
+        TS_ASSERT_THROWS_THIS(processor.GetApdMap(90.0, -60.0), "No APD90 map was requested with a threshold of -60.");
+
+        PropagationPropertiesCalculator calculator(&reader);
+
+        std::vector<std::vector<double> > apd_map = processor.GetApdMap(90.0, -30.0);
+        TS_ASSERT_EQUALS(apd_map, calculator.CalculateAllActionPotentialDurationsForNodeRange(90.0, lo, hi, -30.0));
+        apd_map = processor.GetApdMap(50.0, -60.0);
+        TS_ASSERT_EQUALS(apd_map, calculator.CalculateAllActionPotentialDurationsForNodeRange(50.0, lo, hi, -60.0));
+
+        std::vector<double> distances(num_nodes);
+        for (unsigned node_index=0; node_index<num_nodes; node_index++)
+        {
+            distances[node_index] = 0.01*node_index;
+        }
+
+        std::vector<std::vector<double> > upstroke_time_map = processor.GetUpstrokeTimeMap(-60.0);
+        std::vector<std::vector<double> > upstroke_velocity_map = processor.GetMaxUpstrokeVelocityMap(0.0);
+        std::vector<std::vector<double> > conduction_velocity_map = processor.GetConductionVelocityMap(0u, distances);
+        TS_ASSERT_EQUALS(upstroke_time_map.size(), hi - lo);
+        TS_ASSERT_EQUALS(upstroke_velocity_map.size(), hi - lo);
+        TS_ASSERT_EQUALS(conduction_velocity_map.size(), hi - lo);
+        for (unsigned node_index=lo; node_index<hi; node_index++)
+        {
+            TS_ASSERT_EQUALS(upstroke_time_map[node_index-lo], calculator.CalculateUpstrokeTimes(node_index, -60.0));
+            TS_ASSERT_EQUALS(upstroke_velocity_map[node_index-lo], calculator.CalculateAllMaximumUpstrokeVelocities(node_index, 0.0));
+            TS_ASSERT_EQUALS(conduction_velocity_map[node_index-lo], calculator.CalculateAllConductionVelocities(0u, node_index, distances[node_index]));
+        }
+    }
+
+    void TestStreamingPostProcessorWithSolutionVector()
+    {
+        // Voltages passed in directly, as from a solution vector with two variables per node
+        StreamingPostProcessor processor(0u, 3u);
+        processor.AddApdMap(90.0, -30.0);
+        processor.AddUpstrokeTimeMap(-30.0);
+        processor.AddConductionVelocityMaps();
+        for (unsigned i=0; i<10; i++)
+        {
+            double solution[6] = {-84.0, 1.0, -84.0, 2.0, -84.0, 3.0};
+            if (i == 5)
+            {
+                solution[4] = 10.0;
+            }
+            processor.ProcessTimeStep(0.1*i, solution, 2u);
+        }
+        processor.Finish();
+
+        std::vector<std::vector<double> > apd_map = processor.GetApdMap(90.0, -30.0);
+        std::vector<std::vector<double> > upstroke_time_map = processor.GetUpstrokeTimeMap(-30.0);
+        std::vector<double> distances(3u, 1.0);
+        std::vector<std::vector<double> > conduction_velocity_map = processor.GetConductionVelocityMap(0u, distances);
+        // There is no upstroke at the origin node 0, so no conduction velocities
+        for (unsigned node_index=0; node_index<3; node_index++)
+        {
+            TS_ASSERT_EQUALS(conduction_velocity_map[node_index], std::vector<double>(1u, 0.0));
+        }
+        // Only node 2 has an AP, a spike at 0.5ms
+        TS_ASSERT_EQUALS(apd_map[0], std::vector<double>(1u, 0.0));
+        TS_ASSERT_EQUALS(apd_map[1], std::vector<double>(1u, 0.0));
+        TS_ASSERT_EQUALS(apd_map[2].size(), 1u);
+        TS_ASSERT_DELTA(apd_map[2][0], 0.18, 1e-9);
+        TS_ASSERT_EQUALS(upstroke_time_map[0], std::vector<double>(1u, 0.0));
+        TS_ASSERT_EQUALS(upstroke_time_map[2], std::vector<double>(1u, 0.5));
+    }
+};
+
+#endif //_TESTSTREAMINGPOSTPROCESSOR_HPP_
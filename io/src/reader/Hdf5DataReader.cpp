@@ -340,6 +340,67 @@ std::vector<std::vector<double> > Hdf5DataReader::GetVariableOverTimeOverMultipl
     return ret;
 }
 
+std::vector<double> Hdf5DataReader::GetVariableOverMultipleNodesOverTimeRange(const std::string& rVariableName,
+                                                                              unsigned lowerIndex,
+                                                                              unsigned upperIndex,
+                                                                              unsigned firstTimestep,
+                                                                              unsigned numTimesteps)
+{
+    if (!mIsUnlimitedDimensionSet)
+    {
+        EXCEPTION("The dataset '" << mDatasetName << "' does not contain time dependent data");
+    }
+
+    if (!mIsDataComplete)
+    {
+        EXCEPTION("GetVariableOverMultipleNodesOverTimeRange() cannot be called using incomplete data sets (those for which data was only written for certain nodes)");
+    }
+
+    if (upperIndex > mDatasetDims[1])
+    {
+       EXCEPTION("The dataset '" << mDatasetName << "' doesn't contain info for node " << upperIndex-1);
+    }
+
+    if (firstTimestep + numTimesteps > mNumberTimesteps)
+    {
+        EXCEPTION("The dataset '" << mDatasetName << "' does not contain data for timestep number " << firstTimestep + numTimesteps - 1);
+    }
+
+    std::map<std::string, unsigned>::iterator col_iter = mVariableToColumnIndex.find(rVariableName);
+    if (col_iter == mVariableToColumnIndex.end())
+    {
+        EXCEPTION("The dataset '" << mDatasetName << "' doesn't contain data for variable " << rVariableName);
+    }
+    unsigned column_index = (*col_iter).second;
+
+    unsigned num_nodes_read = upperIndex-lowerIndex;
+    std::vector<double> ret(numTimesteps*num_nodes_read);
+    if (ret.empty())
+    {
+        return ret;
+    }
+
+    // Define hyperslab in the dataset.
+    hsize_t offset[3] = {firstTimestep, lowerIndex, column_index};
+    hsize_t count[3]  = {numTimesteps, num_nodes_read, 1};
+    hid_t variables_dataspace = H5Dget_space(mVariablesDatasetId);
+    H5Sselect_hyperslab(variables_dataspace, H5S_SELECT_SET, offset, nullptr, count, nullptr);
+
+    // Define a simple memory dataspace
+    hsize_t data_dimensions[2];
+    data_dimensions[0] = numTimesteps;
+    data_dimensions[1] = num_nodes_read;
+    hid_t memspace = H5Screate_simple(2, data_dimensions, nullptr);
+
+    // Read data from hyperslab in the file straight into the returned buffer
+    H5Dread(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, variables_dataspace, H5P_DEFAULT, &ret[0]);
+
+    H5Sclose(variables_dataspace);
+    H5Sclose(memspace);
+
+    return ret;
+}
+
 void Hdf5DataReader::GetVariableOverNodes(Vec data,
                                           const std::string& rVariableName,
                                           unsigned timestep)
@@ -113,6 +113,24 @@ public:
                                                                            unsigned lowerIndex,
                                                                            unsigned upperIndex);
 
+    /**
+     * @return the values of a given variable over multiple nodes at a range of consecutive time steps,
+     * time-major: entry (t - firstTimestep)*(upperIndex - lowerIndex) + (node - lowerIndex) holds the
+     * value at node at time step t. This matches the layout of the file, so reading successive blocks
+     * of time steps streams through the dataset once.
+     *
+     * @param rVariableName  name of a variable in the data file
+     * @param lowerIndex the index of the lower node for which the data is obtained
+     * @param upperIndex one past the index of the upper node for which the data is obtained
+     * @param firstTimestep the first time step for which the data is obtained
+     * @param numTimesteps the number of time steps for which the data is obtained
+     */
+    std::vector<double> GetVariableOverMultipleNodesOverTimeRange(const std::string& rVariableName,
+                                                                  unsigned lowerIndex,
+                                                                  unsigned upperIndex,
+                                                                  unsigned firstTimestep,
+                                                                  unsigned numTimesteps);
+
     /**
      * @return the values of a given variable at each node at a given time step.
      *
@@ -37,17 +37,19 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  * Implementation file for Hdf5DataWriter class.
  *
  */
-#include <boost/scoped_array.hpp>
 #include <cstring> //For strcmp etc. Needed in gcc-4.4
+#include <exception>
 #include <set>
 
 #include "Hdf5DataWriter.hpp"
 
+#include "BackgroundIoThread.hpp"
 #include "Exception.hpp"
 #include "MathsCustomFunctions.hpp"
 #include "OutputFileHandler.hpp"
 #include "PetscTools.hpp"
 #include "Version.hpp"
+#include "Warnings.hpp"
 
 Hdf5DataWriter::Hdf5DataWriter(DistributedVectorFactory& rVectorFactory,
                                const std::string& rDirectory,
@@ -77,8 +79,11 @@ Hdf5DataWriter::Hdf5DataWriter(DistributedVectorFactory& rVectorFactory,
           mNumberOfChunks(0),
           mChunkTargetSize(0x20000), // 128 K
           mAlignment(0), // No alignment
+          mDeflateLevel(0u), // No compression
+          mUseShuffleFilter(false),
           mUseCache(useCache),
-          mCacheFirstTimeStep(0u)
+          mCacheFirstTimeStep(0u),
+          mUseAsynchronousWrites(false)
 {
     mChunkSize[0] = 0;
     mChunkSize[1] = 0;
@@ -270,7 +275,19 @@ Hdf5DataWriter::Hdf5DataWriter(DistributedVectorFactory& rVectorFactory,
 
 Hdf5DataWriter::~Hdf5DataWriter()
 {
-    Close();
+    try
+    {
+        Close();
+    }
+    catch (const Exception& e)
+    {
+        // An asynchronous write failed; the file has still been closed. Call Close() first to handle the error.
+        WARNING("Hdf5DataWriter was destroyed without being closed, and finishing its writes failed: " << e.GetShortMessage());
+    }
+    catch (...)
+    {
+        WARNING("Hdf5DataWriter was destroyed without being closed, and finishing its writes failed.");
+    }
 
     if (mSinglePermutation)
     {
@@ -298,7 +315,15 @@ void Hdf5DataWriter::OpenFile()
 
     // Set up a property list saying how we'll open the file
     hid_t fapl = H5Pcreate(H5P_FILE_ACCESS);
-    H5Pset_fapl_mpio(fapl, PETSC_COMM_WORLD, MPI_INFO_NULL);
+    if (mUseAsynchronousWrites && PetscTools::IsSequential())
+    {
+        // The MPI-IO driver would make MPI calls on the I/O thread, which needs MPI_THREAD_MULTIPLE
+        H5Pset_fapl_sec2(fapl);
+    }
+    else
+    {
+        H5Pset_fapl_mpio(fapl, PETSC_COMM_WORLD, MPI_INFO_NULL);
+    }
 
     // Set size of each dimension in main dataset.
     mDatasetDims[0] = mEstimatedUnlimitedLength; // While developing we got a non-documented "only the first dimension can be extendible" error.
@@ -536,6 +561,39 @@ void Hdf5DataWriter::EndDefineMode()
         EXCEPTION("Cannot end define mode. One fixed dimension should be defined.");
     }
 
+#if !H5_VERSION_GE(1, 10, 2)
+    if ((mDeflateLevel > 0 || mUseShuffleFilter) && !PetscTools::IsSequential())
+    {
+        EXCEPTION("Writing compressed datasets in parallel needs HDF5 1.10.2 or later.");
+    }
+#endif
+
+    if (mUseAsynchronousWrites)
+    {
+        // Nothing stops other code making HDF5 calls on the main thread while the I/O thread is writing
+        hbool_t is_thread_safe = 0;
+#if H5_VERSION_GE(1, 8, 16)
+        H5is_library_threadsafe(&is_thread_safe);
+#endif
+        if (!is_thread_safe)
+        {
+            WARNING("The HDF5 library is not thread-safe, so HDF5 data will be written synchronously.");
+            mUseAsynchronousWrites = false;
+        }
+    }
+
+    if (mUseAsynchronousWrites && !PetscTools::IsSequential())
+    {
+        // Collective writes will be made on the I/O thread while the main thread carries on with MPI calls
+        int thread_support;
+        MPI_Query_thread(&thread_support);
+        if (thread_support < MPI_THREAD_MULTIPLE)
+        {
+            WARNING("MPI was not initialised with MPI_THREAD_MULTIPLE support (use the -mpi_thread_multiple option), so HDF5 data will be written synchronously.");
+            mUseAsynchronousWrites = false;
+        }
+    }
+
     OpenFile();
 
     mIsInDefineMode = false;
@@ -569,6 +627,16 @@ void Hdf5DataWriter::EndDefineMode()
     // Create chunked dataset and clean up
     hid_t cparms = H5Pcreate(H5P_DATASET_CREATE);
     H5Pset_chunk(cparms, DATASET_DIMS, mChunkSize);
+
+    // Filters run in the order they are added: shuffling first makes the data easier to compress
+    if (mUseShuffleFilter)
+    {
+        H5Pset_shuffle(cparms);
+    }
+    if (mDeflateLevel > 0)
+    {
+        H5Pset_deflate(cparms, mDeflateLevel);
+    }
     hid_t filespace = H5Screate_simple(DATASET_DIMS, mDatasetDims, dataset_max_dims);
     mVariablesDatasetId = H5Dcreate(mFileId, mDatasetName.c_str(), H5T_NATIVE_DOUBLE, filespace,
                                     H5P_DEFAULT, cparms, H5P_DEFAULT);
@@ -717,6 +785,12 @@ void Hdf5DataWriter::EndDefineMode()
     free(provenance_data);
     H5Sclose(provenance_space);
     H5Aclose(prov_attr);
+
+    // From now on the main thread makes no HDF5 calls while the I/O thread may be busy
+    if (mUseAsynchronousWrites)
+    {
+        mpIoThread.reset(new BackgroundIoThread);
+    }
 }
 
 void Hdf5DataWriter::PutVector(int variableID, Vec petscVector)
@@ -769,29 +843,6 @@ void Hdf5DataWriter::PutVector(int variableID, Vec petscVector)
         MatMult(mSinglePermutation, petscVector, output_petsc_vector);
     }
 
-    // Define memspace and hyperslab
-    hid_t memspace, hyperslab_space;
-    if (mNumberOwned != 0)
-    {
-        hsize_t v_size[1] = { mNumberOwned };
-        memspace = H5Screate_simple(1, v_size, nullptr);
-
-        hsize_t count[DATASET_DIMS] = { 1, mNumberOwned, 1 };
-        hsize_t offset_dims[DATASET_DIMS] = { mCurrentTimeStep, mOffset, (unsigned)(variableID) };
-
-        hyperslab_space = H5Dget_space(mVariablesDatasetId);
-        H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, offset_dims, nullptr, count, nullptr);
-    }
-    else
-    {
-        memspace = H5Screate(H5S_NULL);
-        hyperslab_space = H5Screate(H5S_NULL);
-    }
-
-    // Create property list for collective dataset
-    hid_t property_list_id = H5Pcreate(H5P_DATASET_XFER);
-    H5Pset_dxpl_mpio(property_list_id, H5FD_MPIO_COLLECTIVE);
-
     double* p_petsc_vector;
     VecGetArray(output_petsc_vector, &p_petsc_vector);
 
@@ -804,13 +855,13 @@ void Hdf5DataWriter::PutVector(int variableID, Vec petscVector)
         }
         else
         {
-            H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, p_petsc_vector);
+            PutDataBlock(mCurrentTimeStep, 1, variableID, 1, p_petsc_vector);
         }
     }
     else
     {
         // Make a local copy of the data you own
-        boost::scoped_array<double> local_data(new double[mNumberOwned]);
+        std::vector<double> local_data(mNumberOwned);
         for (unsigned i = 0; i < mNumberOwned; i++)
         {
             local_data[i] = p_petsc_vector[mIncompletePermIndices[mOffset + i] - mLo];
@@ -818,20 +869,16 @@ void Hdf5DataWriter::PutVector(int variableID, Vec petscVector)
         if (mUseCache)
         {
             //Covered by TestHdf5DataWriterFullFormatIncompleteCached
-            mDataCache.insert(mDataCache.end(), local_data.get(), local_data.get() + mNumberOwned);
+            mDataCache.insert(mDataCache.end(), local_data.begin(), local_data.end());
         }
         else
         {
-            H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, local_data.get());
+            PutDataBlock(mCurrentTimeStep, 1, variableID, 1, local_data.data());
         }
     }
 
     VecRestoreArray(output_petsc_vector, &p_petsc_vector);
 
-    H5Sclose(memspace);
-    H5Sclose(hyperslab_space);
-    H5Pclose(property_list_id);
-
     if (petscVector != output_petsc_vector)
     {
         // Free local vector
@@ -906,31 +953,8 @@ void Hdf5DataWriter::PutStripedVector(std::vector<int> variableIDs, Vec petscVec
         // Apply the permutation matrix
         MatMult(mDoublePermutation, petscVector, output_petsc_vector);
     }
-    // Define memspace and hyperslab
-    hid_t memspace, hyperslab_space;
-    if (mNumberOwned != 0)
-    {
-        hsize_t v_size[1] = { mNumberOwned * NUM_STRIPES };
-        memspace = H5Screate_simple(1, v_size, nullptr);
-
-        hsize_t start[DATASET_DIMS] = { mCurrentTimeStep, mOffset, (unsigned)(firstVariableID) };
-        hsize_t stride[DATASET_DIMS] = { 1, 1, 1 }; //we are imposing contiguous variables, hence the stride is 1 (3rd component)
-        hsize_t block_size[DATASET_DIMS] = { 1, mNumberOwned, 1 };
-        hsize_t number_blocks[DATASET_DIMS] = { 1, 1, NUM_STRIPES };
-
-        hyperslab_space = H5Dget_space(mVariablesDatasetId);
-        H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, start, stride, number_blocks, block_size);
-    }
-    else
-    {
-        memspace = H5Screate(H5S_NULL);
-        hyperslab_space = H5Screate(H5S_NULL);
-    }
-
-    // Create property list for collective dataset write, and write! Finally.
-    hid_t property_list_id = H5Pcreate(H5P_DATASET_XFER);
-    H5Pset_dxpl_mpio(property_list_id, H5FD_MPIO_COLLECTIVE);
 
+    // The variables are consecutive columns, so the (u_0 v_0 u_1 v_1 ...) data fill a single block of the dataset
     double* p_petsc_vector;
     VecGetArray(output_petsc_vector, &p_petsc_vector);
 
@@ -943,7 +967,7 @@ void Hdf5DataWriter::PutStripedVector(std::vector<int> variableIDs, Vec petscVec
         }
         else
         {
-            H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, p_petsc_vector);
+            PutDataBlock(mCurrentTimeStep, 1, firstVariableID, NUM_STRIPES, p_petsc_vector);
         }
     }
     else
@@ -951,7 +975,7 @@ void Hdf5DataWriter::PutStripedVector(std::vector<int> variableIDs, Vec petscVec
         if (variableIDs.size() < 3) // incomplete data and striped vector is supported only for NUM_STRIPES=2...for the moment
         {
             // Make a local copy of the data you own
-            boost::scoped_array<double> local_data(new double[mNumberOwned * NUM_STRIPES]);
+            std::vector<double> local_data(mNumberOwned * NUM_STRIPES);
             for (unsigned i = 0; i < mNumberOwned; i++)
             {
                 unsigned local_node_number = mIncompletePermIndices[mOffset + i] - mLo;
@@ -962,11 +986,11 @@ void Hdf5DataWriter::PutStripedVector(std::vector<int> variableIDs, Vec petscVec
             if (mUseCache)
             {
                 //Covered by TestHdf5DataWriterFullFormatStripedIncompleteCached
-                mDataCache.insert(mDataCache.end(), local_data.get(), local_data.get() + 2 * mNumberOwned);
+                mDataCache.insert(mDataCache.end(), local_data.begin(), local_data.end());
             }
             else
             {
-                H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, local_data.get());
+                PutDataBlock(mCurrentTimeStep, 1, firstVariableID, NUM_STRIPES, local_data.data());
             }
         }
         else
@@ -977,10 +1001,6 @@ void Hdf5DataWriter::PutStripedVector(std::vector<int> variableIDs, Vec petscVec
 
     VecRestoreArray(output_petsc_vector, &p_petsc_vector);
 
-    H5Sclose(memspace);
-    H5Sclose(hyperslab_space);
-    H5Pclose(property_list_id);
-
     if (petscVector != output_petsc_vector)
     {
         // Free local vector
@@ -1008,37 +1028,9 @@ void Hdf5DataWriter::WriteCache()
     //    PRINT_3_VARIABLES(mCurrentTimeStep-mCacheFirstTimeStep, mNumberOwned, mDatasetDims[2])
     //    PRINT_VARIABLE(mDataCache.size())
 
-    // Define memspace and hyperslab
-    hid_t memspace, hyperslab_space;
-    if (mNumberOwned != 0)
-    {
-        hsize_t v_size[1] = { mDataCache.size() };
-        memspace = H5Screate_simple(1, v_size, nullptr);
-
-        hsize_t start[DATASET_DIMS] = { mCacheFirstTimeStep, mOffset, 0 };
-        hsize_t count[DATASET_DIMS] = { mCurrentTimeStep - mCacheFirstTimeStep, mNumberOwned, mDatasetDims[2] };
-        assert((mCurrentTimeStep - mCacheFirstTimeStep) * mNumberOwned * mDatasetDims[2] == mDataCache.size()); // Got size right?
-
-        hyperslab_space = H5Dget_space(mVariablesDatasetId);
-        H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, start, nullptr, count, nullptr);
-    }
-    else
-    {
-        memspace = H5Screate(H5S_NULL);
-        hyperslab_space = H5Screate(H5S_NULL);
-    }
-
-    // Create property list for collective dataset write
-    hid_t property_list_id = H5Pcreate(H5P_DATASET_XFER);
-    H5Pset_dxpl_mpio(property_list_id, H5FD_MPIO_COLLECTIVE);
-
     // Write!
-    H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, &mDataCache[0]);
-
-    // Tidy up
-    H5Sclose(memspace);
-    H5Sclose(hyperslab_space);
-    H5Pclose(property_list_id);
+    assert(mNumberOwned == 0 || (mCurrentTimeStep - mCacheFirstTimeStep) * mNumberOwned * mDatasetDims[2] == mDataCache.size()); // Got size right?
+    PutDataBlock(mCacheFirstTimeStep, mCurrentTimeStep - mCacheFirstTimeStep, 0, mDatasetDims[2], mDataCache.data());
 
     mCacheFirstTimeStep = mCurrentTimeStep; // Update where we got to
     mDataCache.clear(); // Clear out cache
@@ -1065,19 +1057,23 @@ void Hdf5DataWriter::PutUnlimitedVariable(double value)
         return;
     }
 
-    hsize_t size[1] = { 1 };
-    hid_t memspace = H5Screate_simple(1, size, nullptr);
+    hsize_t time_step = mCurrentTimeStep;
+    RunOrDefer([this, time_step, value]()
+    {
+        hsize_t size[1] = { 1 };
+        hid_t memspace = H5Screate_simple(1, size, nullptr);
 
-    // Select hyperslab in the file.
-    hsize_t count[1] = { 1 };
-    hsize_t offset[1] = { mCurrentTimeStep };
-    hid_t hyperslab_space = H5Dget_space(mUnlimitedDatasetId);
-    H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, offset, nullptr, count, nullptr);
+        // Select hyperslab in the file.
+        hsize_t count[1] = { 1 };
+        hsize_t offset[1] = { time_step };
+        hid_t hyperslab_space = H5Dget_space(mUnlimitedDatasetId);
+        H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, offset, nullptr, count, nullptr);
 
-    H5Dwrite(mUnlimitedDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, H5P_DEFAULT, &value);
+        H5Dwrite(mUnlimitedDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, H5P_DEFAULT, &value);
 
-    H5Sclose(hyperslab_space);
-    H5Sclose(memspace);
+        H5Sclose(hyperslab_space);
+        H5Sclose(memspace);
+    });
 }
 
 void Hdf5DataWriter::Close()
@@ -1092,6 +1088,23 @@ void Hdf5DataWriter::Close()
         WriteCache();
     }
 
+    // Finish any asynchronous writes, but close the file even if one of them failed
+    std::exception_ptr p_write_exception;
+    if (mpIoThread)
+    {
+        try
+        {
+            StartPendingOperations();
+            mpIoThread->Flush();
+        }
+        catch (...)
+        {
+            p_write_exception = std::current_exception();
+        }
+        mPendingOperations.clear();
+        mpIoThread.reset();
+    }
+
     H5Dclose(mVariablesDatasetId);
     if (mIsUnlimitedDimensionSet)
     {
@@ -1101,6 +1114,11 @@ void Hdf5DataWriter::Close()
 
     // Cope with being called twice (e.g. if a user calls Close then the destructor)
     mIsInDefineMode = true;
+
+    if (p_write_exception)
+    {
+        std::rethrow_exception(p_write_exception);
+    }
 }
 
 void Hdf5DataWriter::DefineUnlimitedDimension(const std::string& rVariableName,
@@ -1151,18 +1169,108 @@ void Hdf5DataWriter::AdvanceAlongUnlimitedDimension()
         mDatasetDims[0]++;
         mNeedExtend = true;
     }
+
+    // The previous time step is complete
+    StartPendingOperations();
 }
 
 void Hdf5DataWriter::PossiblyExtend()
 {
     if (mNeedExtend)
     {
-        H5Dset_extent(mVariablesDatasetId, mDatasetDims);
-        H5Dset_extent(mUnlimitedDatasetId, mDatasetDims);
+        hsize_t dataset_dims[DATASET_DIMS] = { mDatasetDims[0], mDatasetDims[1], mDatasetDims[2] };
+        RunOrDefer([this, dataset_dims]()
+        {
+            H5Dset_extent(mVariablesDatasetId, dataset_dims);
+            H5Dset_extent(mUnlimitedDatasetId, dataset_dims);
+        });
     }
     mNeedExtend = false;
 }
 
+void Hdf5DataWriter::WriteDataBlock(hsize_t firstTimeStep, hsize_t numTimeSteps, hsize_t firstVariable, hsize_t numVariables, const double* pData)
+{
+    // Define memspace and hyperslab
+    hid_t memspace, hyperslab_space;
+    if (mNumberOwned != 0)
+    {
+        hsize_t v_size[1] = { numTimeSteps * mNumberOwned * numVariables };
+        memspace = H5Screate_simple(1, v_size, nullptr);
+
+        hsize_t start[DATASET_DIMS] = { firstTimeStep, mOffset, firstVariable };
+        hsize_t count[DATASET_DIMS] = { numTimeSteps, mNumberOwned, numVariables };
+
+        hyperslab_space = H5Dget_space(mVariablesDatasetId);
+        H5Sselect_hyperslab(hyperslab_space, H5S_SELECT_SET, start, nullptr, count, nullptr);
+    }
+    else
+    {
+        memspace = H5Screate(H5S_NULL);
+        hyperslab_space = H5Screate(H5S_NULL);
+    }
+
+    // Create property list for collective dataset write, and write! Finally.
+    hid_t property_list_id = H5Pcreate(H5P_DATASET_XFER);
+    H5Pset_dxpl_mpio(property_list_id, H5FD_MPIO_COLLECTIVE);
+
+    H5Dwrite(mVariablesDatasetId, H5T_NATIVE_DOUBLE, memspace, hyperslab_space, property_list_id, pData);
+
+    // Tidy up
+    H5Sclose(memspace);
+    H5Sclose(hyperslab_space);
+    H5Pclose(property_list_id);
+}
+
+void Hdf5DataWriter::PutDataBlock(hsize_t firstTimeStep, hsize_t numTimeSteps, hsize_t firstVariable, hsize_t numVariables, const double* pData)
+{
+    if (mpIoThread)
+    {
+        // Take a snapshot, so that the caller can overwrite its data as soon as we return
+        std::vector<double> snapshot(pData, pData + numTimeSteps * mNumberOwned * numVariables);
+        RunOrDefer([this, firstTimeStep, numTimeSteps, firstVariable, numVariables, snapshot = std::move(snapshot)]()
+        {
+            WriteDataBlock(firstTimeStep, numTimeSteps, firstVariable, numVariables, snapshot.data());
+        });
+    }
+    else
+    {
+        WriteDataBlock(firstTimeStep, numTimeSteps, firstVariable, numVariables, pData);
+    }
+}
+
+void Hdf5DataWriter::RunOrDefer(std::function<void()> operation)
+{
+    if (mpIoThread)
+    {
+        mPendingOperations.push_back(std::move(operation));
+    }
+    else
+    {
+        operation();
+    }
+}
+
+void Hdf5DataWriter::StartPendingOperations()
+{
+    if (!mpIoThread || mPendingOperations.empty())
+    {
+        return;
+    }
+
+    // Wait for the previous time step to be written (this rethrows any error writing it)
+    mpIoThread->Flush();
+
+    std::vector<std::function<void()> > operations;
+    operations.swap(mPendingOperations);
+    mpIoThread->Enqueue([operations = std::move(operations)]()
+    {
+        for (unsigned i = 0; i < operations.size(); i++)
+        {
+            operations[i]();
+        }
+    });
+}
+
 void Hdf5DataWriter::EmptyDataset()
 {
     // Set internal counter to 0
@@ -1414,3 +1522,55 @@ void Hdf5DataWriter::SetAlignment(hsize_t alignment)
 
     mAlignment = alignment;
 }
+
+void Hdf5DataWriter::SetDeflateLevel(unsigned deflateLevel)
+{
+    if (!mIsInDefineMode)
+    {
+        EXCEPTION("Cannot set compression when not in define mode.");
+    }
+    if (deflateLevel > 9)
+    {
+        EXCEPTION("Deflate level must be between 0 and 9.");
+    }
+    // LCOV_EXCL_START
+    if (deflateLevel > 0 && H5Zfilter_avail(H5Z_FILTER_DEFLATE) <= 0)
+    {
+        EXCEPTION("This HDF5 library was built without the deflate filter, so data cannot be compressed.");
+    }
+    // LCOV_EXCL_STOP
+    mDeflateLevel = deflateLevel;
+}
+
+unsigned Hdf5DataWriter::GetDeflateLevel() const
+{
+    return mDeflateLevel;
+}
+
+void Hdf5DataWriter::SetUseShuffleFilter(bool useShuffleFilter)
+{
+    if (!mIsInDefineMode)
+    {
+        EXCEPTION("Cannot set compression when not in define mode.");
+    }
+    mUseShuffleFilter = useShuffleFilter;
+}
+
+bool Hdf5DataWriter::GetUseShuffleFilter() const
+{
+    return mUseShuffleFilter;
+}
+
+void Hdf5DataWriter::SetUseAsynchronousWrites(bool useAsynchronousWrites)
+{
+    if (!mIsInDefineMode)
+    {
+        EXCEPTION("Cannot change asynchronous writing when not in define mode.");
+    }
+    mUseAsynchronousWrites = useAsynchronousWrites;
+}
+
+bool Hdf5DataWriter::GetUseAsynchronousWrites() const
+{
+    return mUseAsynchronousWrites;
+}
@@ -36,12 +36,16 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef HDF5DATAWRITER_HPP_
 #define HDF5DATAWRITER_HPP_
 
+#include <functional>
 #include <vector>
+#include <boost/shared_ptr.hpp>
 
 #include "AbstractHdf5Access.hpp"
 #include "DataWriterVariable.hpp"
 #include "DistributedVectorFactory.hpp"
 
+class BackgroundIoThread;
+
 /**
  * A concrete HDF5 data writer class.
  */
@@ -83,10 +87,17 @@ private:
 
     hsize_t mAlignment;                             /**< User-provided alignment parameter */
 
+    unsigned mDeflateLevel;                         /**< User-provided deflate (gzip) compression level, 0 for no compression */
+    bool mUseShuffleFilter;                         /**< Whether to apply the shuffle filter to the data before any compression */
+
     bool mUseCache;                                 /**< Whether to use a cache */
     long unsigned mCacheFirstTimeStep;              /**< Coordinate to keep track of cache writes */
     std::vector<double> mDataCache;                 /**< Cache results here before writing */
 
+    bool mUseAsynchronousWrites;                    /**< Whether to write data to disk on a background I/O thread */
+    boost::shared_ptr<BackgroundIoThread> mpIoThread; /**< The thread running HDF5 calls when writing asynchronously */
+    std::vector<std::function<void()> > mPendingOperations; /**< HDF5 calls for the current time step, not yet handed to #mpIoThread */
+
     /**
      * Check name of variable is allowed, i.e. contains only alphanumeric & _, and isn't blank.
      *
@@ -139,6 +150,44 @@ private:
      */
     void SetChunkSize();
 
+    /**
+     * Write a block of data, covering consecutive time steps and variables, for the rows owned by
+     * this process. The data are ordered by time step, then row, then variable. This is a collective call.
+     *
+     * @param firstTimeStep  the first time step in the block
+     * @param numTimeSteps  the number of time steps in the block
+     * @param firstVariable  the first variable (column) in the block
+     * @param numVariables  the number of variables in the block
+     * @param pData  the data
+     */
+    void WriteDataBlock(hsize_t firstTimeStep, hsize_t numTimeSteps, hsize_t firstVariable, hsize_t numVariables, const double* pData);
+
+    /**
+     * Write a block of data (see #WriteDataBlock) now or, when writing asynchronously, take a
+     * copy of the data and write it on the I/O thread once the current time step is complete.
+     *
+     * @param firstTimeStep  the first time step in the block
+     * @param numTimeSteps  the number of time steps in the block
+     * @param firstVariable  the first variable (column) in the block
+     * @param numVariables  the number of variables in the block
+     * @param pData  the data
+     */
+    void PutDataBlock(hsize_t firstTimeStep, hsize_t numTimeSteps, hsize_t firstVariable, hsize_t numVariables, const double* pData);
+
+    /**
+     * Run an operation that makes HDF5 calls on the open file now or, when writing asynchronously,
+     * once the current time step is complete. Any data the operation uses must be copied into it.
+     *
+     * @param operation  the operation
+     */
+    void RunOrDefer(std::function<void()> operation);
+
+    /**
+     * When writing asynchronously, wait for the I/O thread to finish the previous time step and then
+     * hand it the operations for the current one. At most two time steps of data are thus held in memory.
+     */
+    void StartPendingOperations();
+
 public:
 
     /**
@@ -165,7 +214,8 @@ public:
                    bool useCache=false);
 
     /**
-     * Destructor.
+     * Destructor. Closes the file if Close() has not been called, but since a destructor cannot
+     * throw, any error finishing asynchronous writes is then only reported as a warning.
      */
     virtual ~Hdf5DataWriter();
 
@@ -275,7 +325,8 @@ public:
     void PutUnlimitedVariable(double value);
 
     /**
-     * Close any open files.
+     * Close any open files. When writing asynchronously this first waits for all the writes
+     * to finish, and throws if any of them failed (the file is closed regardless).
      */
     void Close();
 
@@ -398,6 +449,70 @@ public:
      * @param alignment Alignment (bytes)
      */
     void SetAlignment(hsize_t alignment);
+
+    /**
+     * Compress the dataset with the (lossless) deflate filter, as used by gzip. Higher levels
+     * give smaller files at the cost of more time spent writing and reading. Compression works
+     * on whole chunks, so the target chunk size (see SetTargetChunkSize) also affects how well
+     * the data compress. Default is 0, i.e. no compression.
+     *
+     * Writing compressed data in parallel needs HDF5 1.10.2 or later.
+     *
+     * This method only has an effect when creating a NEW DATASET. Must be
+     * called in define mode.
+     *
+     * @param deflateLevel  Compression level, from 0 (none) to 9 (most)
+     */
+    void SetDeflateLevel(unsigned deflateLevel);
+
+    /**
+     * @return the deflate compression level (0 if the data are not compressed).
+     */
+    unsigned GetDeflateLevel() const;
+
+    /**
+     * Apply the shuffle filter, which groups together the corresponding bytes of every value in a
+     * chunk, before any compression. This usually lets floating point data compress much better.
+     * Default is false.
+     *
+     * This method only has an effect when creating a NEW DATASET. Must be
+     * called in define mode.
+     *
+     * @param useShuffleFilter  whether to apply the shuffle filter
+     */
+    void SetUseShuffleFilter(bool useShuffleFilter);
+
+    /**
+     * @return whether the shuffle filter is applied to the dataset.
+     */
+    bool GetUseShuffleFilter() const;
+
+    /**
+     * Write data to disk on a background I/O thread, so that PutVector(), PutStripedVector() and
+     * PutUnlimitedVariable() just take a copy of the data and return. The writes for each time step
+     * are handed to the thread by AdvanceAlongUnlimitedDimension(), which first waits for the writes
+     * for the previous time step to finish. Close() waits for all the writes to finish, and throws
+     * if any of them failed. Default is false.
+     *
+     * In sequential runs the file is then written with the HDF5 POSIX driver rather than MPI-IO.
+     * In parallel runs the collective writes are made from the I/O thread, so MPI must have been
+     * initialised with MPI_THREAD_MULTIPLE support (pass "-mpi_thread_multiple" on the command
+     * line, see PetscSetupUtils::InitialisePetsc()). Other code may make HDF5 calls on the main
+     * thread while the I/O thread is writing, so the HDF5 library must also have been built to be
+     * thread-safe. If either is not the case, a warning is given and data are written synchronously
+     * instead.
+     *
+     * Must be called in define mode when creating a new dataset (asynchronous writes are not
+     * available when extending an existing dataset).
+     *
+     * @param useAsynchronousWrites  whether to write data asynchronously
+     */
+    void SetUseAsynchronousWrites(bool useAsynchronousWrites);
+
+    /**
+     * @return whether data are written asynchronously.
+     */
+    bool GetUseAsynchronousWrites() const;
 };
 
 #endif /*HDF5DATAWRITER_HPP_*/
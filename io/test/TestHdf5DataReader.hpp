@@ -383,6 +383,25 @@ public:
             TS_ASSERT_EQUALS(i_k_values[index], i_k_values_over_multiple[index]);
         }
 
+        // The same data, read a block of time steps at a time
+        std::vector<double> i_k_block = reader.GetVariableOverMultipleNodesOverTimeRange("I_K", 10, 19, 3, 4);
+        TS_ASSERT_EQUALS(i_k_block.size(), 36u);
+        for (unsigned time_step=3; time_step<7; time_step++)
+        {
+            for (unsigned node_index=10; node_index<19; node_index++)
+            {
+                TS_ASSERT_DELTA(i_k_block[(time_step-3)*9 + node_index-10], time_step*1000 + 100 + node_index, 1e-9);
+            }
+        }
+        TS_ASSERT_EQUALS(reader.GetVariableOverMultipleNodesOverTimeRange("I_K", 15, 16, 0, 10), i_k_values);
+
+        TS_ASSERT_THROWS_THIS(reader.GetVariableOverMultipleNodesOverTimeRange("I_K", 0, NUMBER_NODES+5, 0, 1),
+                              "The dataset 'Data' doesn't contain info for node 104");
+        TS_ASSERT_THROWS_THIS(reader.GetVariableOverMultipleNodesOverTimeRange("I_K", 0, 10, 8, 3),
+                              "The dataset 'Data' does not contain data for timestep number 10");
+        TS_ASSERT_THROWS_THIS(reader.GetVariableOverMultipleNodesOverTimeRange("WrongName", 0, 10, 0, 1),
+                              "The dataset 'Data' doesn't contain data for variable WrongName");
+
         unsigned NUMBER_NODES=100;
         DistributedVectorFactory factory(NUMBER_NODES);
 
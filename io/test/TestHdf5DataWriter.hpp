@@ -1967,6 +1967,132 @@ public:
         H5Dclose(dset);
         H5Fclose(h5_file);
     }
+
+    void TestHdf5DataWriterAsynchronousCompressed()
+    {
+        std::string folder("TestHdf5DataWriter");
+        std::string filename("hdf5_test_asynchronous_compressed");
+
+        int number_nodes = 100;
+        DistributedVectorFactory vec_factory(number_nodes);
+
+        {
+            // The same data as TestHdf5DataWriterFullFormatStriped
+            Hdf5DataWriter writer(vec_factory, folder, filename, false);
+            writer.DefineFixedDimension(number_nodes);
+
+            int node_id = writer.DefineVariable("Node", "dimensionless");
+            int vm_id = writer.DefineVariable("V_m", "millivolts");
+            int phi_e_id = writer.DefineVariable("Phi_e", "millivolts");
+            int ina_id = writer.DefineVariable("I_Na", "milliamperes");
+
+            std::vector<int> striped_variable_IDs;
+            striped_variable_IDs.push_back(vm_id);
+            striped_variable_IDs.push_back(phi_e_id);
+
+            writer.DefineUnlimitedDimension("Time", "msec");
+
+            // Test set/get methods
+            TS_ASSERT_EQUALS(writer.GetDeflateLevel(), 0u);
+            TS_ASSERT_EQUALS(writer.GetUseShuffleFilter(), false);
+            TS_ASSERT_EQUALS(writer.GetUseAsynchronousWrites(), false);
+            TS_ASSERT_THROWS_THIS(writer.SetDeflateLevel(10), "Deflate level must be between 0 and 9.");
+            writer.SetDeflateLevel(4);
+            writer.SetUseShuffleFilter(true);
+            writer.SetUseAsynchronousWrites(true);
+            TS_ASSERT_EQUALS(writer.GetDeflateLevel(), 4u);
+            TS_ASSERT_EQUALS(writer.GetUseShuffleFilter(), true);
+
+            writer.EndDefineMode();
+
+            TS_ASSERT_THROWS_THIS(writer.SetDeflateLevel(1), "Cannot set compression when not in define mode.");
+            TS_ASSERT_THROWS_THIS(writer.SetUseShuffleFilter(false), "Cannot set compression when not in define mode.");
+            TS_ASSERT_THROWS_THIS(writer.SetUseAsynchronousWrites(false),
+                                  "Cannot change asynchronous writing when not in define mode.");
+
+            // Data are only written asynchronously if HDF5 is thread-safe and MPI can cope with collective writes from the I/O thread
+            int thread_support;
+            MPI_Query_thread(&thread_support);
+            hbool_t is_thread_safe = 0;
+#if H5_VERSION_GE(1, 8, 16)
+            H5is_library_threadsafe(&is_thread_safe);
+#endif
+            TS_ASSERT_EQUALS(writer.GetUseAsynchronousWrites(),
+                             is_thread_safe && (PetscTools::IsSequential() || thread_support == MPI_THREAD_MULTIPLE));
+            if (!writer.GetUseAsynchronousWrites())
+            {
+                TS_ASSERT_EQUALS(Warnings::Instance()->GetNumWarnings(), 1u);
+                Warnings::QuietDestroy();
+            }
+
+            Vec node_number = vec_factory.CreateVec();
+            Vec petsc_data_short = vec_factory.CreateVec();
+            Vec petsc_data_long = vec_factory.CreateVec(2);
+            DistributedVector distributed_node_number = vec_factory.CreateDistributedVector(node_number);
+            DistributedVector distributed_vector_short = vec_factory.CreateDistributedVector(petsc_data_short);
+            for (DistributedVector::Iterator index = distributed_vector_short.Begin();
+                 index != distributed_vector_short.End();
+                 ++index)
+            {
+                distributed_node_number[index] = index.Global;
+                distributed_vector_short[index] = -0.5;
+            }
+            distributed_node_number.Restore();
+            distributed_vector_short.Restore();
+
+            DistributedVector distributed_vector_long = vec_factory.CreateDistributedVector(petsc_data_long);
+            DistributedVector::Stripe vm_stripe(distributed_vector_long, 0);
+            DistributedVector::Stripe phi_e_stripe(distributed_vector_long, 1);
+
+            for (unsigned time_step = 0; time_step < 10; time_step++)
+            {
+                for (DistributedVector::Iterator index = distributed_vector_long.Begin();
+                     index != distributed_vector_long.End();
+                     ++index)
+                {
+                    vm_stripe[index] = time_step * 1000 + index.Global * 2;
+                    phi_e_stripe[index] = time_step * 1000 + index.Global * 2 + 1;
+                }
+                distributed_vector_long.Restore();
+
+                writer.PutVector(node_id, node_number);
+                writer.PutVector(ina_id, petsc_data_short);
+                writer.PutStripedVector(striped_variable_IDs, petsc_data_long);
+                writer.PutUnlimitedVariable(time_step);
+                writer.AdvanceAlongUnlimitedDimension();
+
+                // The data have been copied, so can be overwritten straight away
+                VecZeroEntries(petsc_data_long);
+            }
+
+            writer.Close();
+
+            PetscTools::Destroy(node_number);
+            PetscTools::Destroy(petsc_data_long);
+            PetscTools::Destroy(petsc_data_short);
+        }
+
+        TS_ASSERT(CompareFilesViaHdf5DataReader(folder, filename, true,
+                                                "io/test/data", "hdf5_test_full_format_striped", false));
+
+        // Check the filters were applied to the dataset
+        OutputFileHandler file_handler(folder, false);
+        FileFinder file = file_handler.FindFile(filename + ".h5");
+        hid_t h5_file = H5Fopen(file.GetAbsolutePath().c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        hid_t dset = H5Dopen(h5_file, "Data", H5P_DEFAULT);
+        hid_t dcpl = H5Dget_create_plist(dset);
+        TS_ASSERT_EQUALS(H5Pget_nfilters(dcpl), 2);
+        unsigned flags;
+        size_t num_values = 1;
+        unsigned deflate_level;
+        TS_ASSERT_EQUALS(H5Pget_filter2(dcpl, 0, &flags, &num_values, &deflate_level, 0, nullptr, nullptr), H5Z_FILTER_SHUFFLE);
+        num_values = 1;
+        TS_ASSERT_EQUALS(H5Pget_filter2(dcpl, 1, &flags, &num_values, &deflate_level, 0, nullptr, nullptr), H5Z_FILTER_DEFLATE);
+        TS_ASSERT_EQUALS(deflate_level, 4u);
+        H5Pclose(dcpl);
+        H5Dclose(dset);
+        H5Fclose(h5_file);
+    }
 };
 
 #endif /*TESTHDF5DATAWRITER_HPP_*/
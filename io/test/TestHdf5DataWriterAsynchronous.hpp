@@ -0,0 +1,146 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTHDF5DATAWRITERASYNCHRONOUS_HPP_
+#define TESTHDF5DATAWRITERASYNCHRONOUS_HPP_
+
+#include <cxxtest/TestSuite.h>
+
+#include "DistributedVectorFactory.hpp"
+#include "Hdf5DataReader.hpp"
+#include "Hdf5DataWriter.hpp"
+#include "PetscTools.hpp"
+#include "Warnings.hpp"
+#include "PetscSetupAndFinalizeWithMpiThreadMultiple.hpp"
+
+/**
+ * Asynchronous HDF5 output needs MPI to have been initialised with MPI_THREAD_MULTIPLE
+ * support in parallel, so this lives in its own suite with a fixture that asks for it.
+ */
+class TestHdf5DataWriterAsynchronous : public CxxTest::TestSuite
+{
+public:
+    void TestMpiThreadMultipleIsProvided()
+    {
+        int thread_support;
+        MPI_Query_thread(&thread_support);
+        TS_ASSERT_EQUALS(thread_support, MPI_THREAD_MULTIPLE);
+    }
+
+    void TestAsynchronousWrites()
+    {
+        std::string folder("TestHdf5DataWriterAsynchronous");
+        std::string filename("hdf5_test_asynchronous");
+
+        const unsigned number_nodes = 100;
+        const unsigned number_time_steps = 10;
+        DistributedVectorFactory vec_factory(number_nodes);
+
+        {
+            Hdf5DataWriter writer(vec_factory, folder, filename);
+            writer.DefineFixedDimension(number_nodes);
+            int node_id = writer.DefineVariable("Node", "dimensionless");
+            int vm_id = writer.DefineVariable("V_m", "millivolts");
+            writer.DefineUnlimitedDimension("Time", "msec");
+            writer.SetUseAsynchronousWrites(true);
+            writer.EndDefineMode();
+
+#ifdef H5_HAVE_THREADSAFE
+            // The background I/O thread really is used, in sequential and in parallel
+            TS_ASSERT_EQUALS(writer.GetUseAsynchronousWrites(), true);
+            TS_ASSERT_EQUALS(Warnings::Instance()->GetNumWarnings(), 0u);
+#else
+            TS_ASSERT_EQUALS(writer.GetUseAsynchronousWrites(), false);
+            TS_ASSERT_EQUALS(Warnings::Instance()->GetNumWarnings(), 1u);
+            Warnings::QuietDestroy();
+#endif // H5_HAVE_THREADSAFE
+
+            Vec node_number = vec_factory.CreateVec();
+            Vec voltage = vec_factory.CreateVec();
+            DistributedVector distributed_node_number = vec_factory.CreateDistributedVector(node_number);
+            for (DistributedVector::Iterator index = distributed_node_number.Begin();
+                 index != distributed_node_number.End();
+                 ++index)
+            {
+                distributed_node_number[index] = index.Global;
+            }
+            distributed_node_number.Restore();
+
+            DistributedVector distributed_voltage = vec_factory.CreateDistributedVector(voltage);
+            for (unsigned time_step = 0; time_step < number_time_steps; time_step++)
+            {
+                for (DistributedVector::Iterator index = distributed_voltage.Begin();
+                     index != distributed_voltage.End();
+                     ++index)
+                {
+                    distributed_voltage[index] = time_step * 1000 + index.Global;
+                }
+                distributed_voltage.Restore();
+
+                writer.PutVector(node_id, node_number);
+                writer.PutVector(vm_id, voltage);
+                writer.PutUnlimitedVariable(time_step);
+                writer.AdvanceAlongUnlimitedDimension();
+
+                // The data have been copied, so can be overwritten straight away
+                VecZeroEntries(voltage);
+            }
+
+            writer.Close();
+
+            PetscTools::Destroy(node_number);
+            PetscTools::Destroy(voltage);
+        }
+
+        // Every time step should have reached the file
+        Hdf5DataReader reader(folder, filename);
+        std::vector<double> times = reader.GetUnlimitedDimensionValues();
+        TS_ASSERT_EQUALS(times.size(), number_time_steps);
+        for (unsigned node_index = 0; node_index < number_nodes; node_index += 33)
+        {
+            std::vector<double> node_values = reader.GetVariableOverTime("Node", node_index);
+            std::vector<double> voltage_values = reader.GetVariableOverTime("V_m", node_index);
+            TS_ASSERT_EQUALS(voltage_values.size(), number_time_steps);
+            for (unsigned time_step = 0; time_step < number_time_steps; time_step++)
+            {
+                TS_ASSERT_DELTA(times[time_step], time_step, 1e-12);
+                TS_ASSERT_DELTA(node_values[time_step], node_index, 1e-12);
+                TS_ASSERT_DELTA(voltage_values[time_step], time_step * 1000 + node_index, 1e-12);
+            }
+        }
+    }
+};
+
+#endif /*TESTHDF5DATAWRITERASYNCHRONOUS_HPP_*/
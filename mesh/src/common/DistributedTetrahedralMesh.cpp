@@ -235,6 +235,7 @@ void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ConstructFromMeshReader
     std::set<unsigned> nodes_owned;
     std::set<unsigned> halo_nodes_owned;
     std::set<unsigned> elements_owned;
+    std::set<unsigned> faces_owned;
     std::vector<unsigned> proc_offsets;//(PetscTools::GetNumProcs());
 
     this->mMeshFileBaseName = rMeshReader.GetMeshFileBaseName();
@@ -242,10 +243,25 @@ void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ConstructFromMeshReader
     mTotalNumBoundaryElements = rMeshReader.GetNumFaces();
     mTotalNumNodes = rMeshReader.GetNumNodes();
 
+    // A partition stored with the mesh (for this number of processes) is used instead of computing one, so that
+    // each process only reads its own part of the mesh.  A geometric partition is always computed, since it is
+    // determined by the user's choice of process regions.
+    bool use_stored_partition = (mPartitioning != DistributedTetrahedralMeshPartitionType::DUMB
+                                 && mPartitioning != DistributedTetrahedralMeshPartitionType::GEOMETRIC
+                                 && PetscTools::IsParallel()
+                                 && rMeshReader.GetNumPartitions() == PetscTools::GetNumProcs());
 
     PetscTools::Barrier();
     Timer::Reset();
-    ComputeMeshPartitioning(rMeshReader, nodes_owned, halo_nodes_owned, elements_owned, proc_offsets);
+    if (use_stored_partition)
+    {
+        rMeshReader.GetPartition(PetscTools::GetMyRank(), this->mNodePermutation, proc_offsets,
+                                 nodes_owned, halo_nodes_owned, elements_owned, faces_owned);
+    }
+    else
+    {
+        ComputeMeshPartitioning(rMeshReader, nodes_owned, halo_nodes_owned, elements_owned, proc_offsets);
+    }
     PetscTools::Barrier();
     //Timer::Print("partitioning");
 
@@ -269,12 +285,12 @@ void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ConstructFromMeshReader
             RegisterNode(global_node_index);
             Node<SPACE_DIM>* p_node = new Node<SPACE_DIM>(global_node_index, coords, false);
 
-// Node attributes in binary format are not yet supported, see #1730
-//            for (unsigned i = 0; i < rMeshReader.GetNodeAttributes().size(); i++)
-//            {
-//                double attribute = rMeshReader.GetNodeAttributes()[i];
-//                p_node->AddNodeAttribute(attribute);
-//            }
+            // Node attributes are not written to binary Triangles files (see #1730), but may be stored in other binary formats
+            std::vector<double> node_attributes = rMeshReader.GetNodeAttributes();
+            for (unsigned i = 0; i < node_attributes.size(); i++)
+            {
+                p_node->AddNodeAttribute(node_attributes[i]);
+            }
 
             this->mNodes.push_back(p_node);
         }
@@ -353,9 +369,24 @@ void DistributedTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ConstructFromMeshReader
     // Boundary nodes and elements
     try
     {
+        std::set<unsigned>::const_iterator stored_face_it = faces_owned.begin();
         for (unsigned face_index=0; face_index<mTotalNumBoundaryElements; face_index++)
         {
-            ElementData face_data = rMeshReader.GetNextFaceData();
+            ElementData face_data;
+            if (use_stored_partition)
+            {
+                // Only the faces in the stored partition are read
+                if (stored_face_it == faces_owned.end() || *stored_face_it != face_index)
+                {
+                    continue;
+                }
+                ++stored_face_it;
+                face_data = rMeshReader.GetFaceData(face_index);
+            }
+            else
+            {
+                face_data = rMeshReader.GetNextFaceData();
+            }
             std::vector<unsigned> node_indices = face_data.NodeIndices;
 
             bool own = false;
@@ -35,6 +35,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <map>
 #include <cstring>
+#include <algorithm>
+#include <iterator>
 
 #include "MutableMesh.hpp"
 #include "OutputFileHandler.hpp"
@@ -47,16 +49,65 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #undef REAL
 #undef VOID
 
+/**
+ * @return twice the signed area of the triangle with the given vertices, which is
+ * positive if they are listed anticlockwise. Only the first two coordinates are used.
+ *
+ * @param rA the first vertex
+ * @param rB the second vertex
+ * @param rC the third vertex
+ */
+template<std::size_t DIM>
+static double SignedDoubleArea(const c_vector<double, DIM>& rA,
+                               const c_vector<double, DIM>& rB,
+                               const c_vector<double, DIM>& rC)
+{
+    return (rB[0] - rA[0])*(rC[1] - rA[1]) - (rB[1] - rA[1])*(rC[0] - rA[0]);
+}
+
+/**
+ * @return a value that is positive if and only if rD lies strictly inside the
+ * circumcircle of the anticlockwise triangle (rA, rB, rC). Only the first two
+ * coordinates are used.
+ *
+ * @param rA the first vertex of the triangle
+ * @param rB the second vertex of the triangle
+ * @param rC the third vertex of the triangle
+ * @param rD the point to test
+ */
+template<std::size_t DIM>
+static double InCircleDeterminant(const c_vector<double, DIM>& rA,
+                                  const c_vector<double, DIM>& rB,
+                                  const c_vector<double, DIM>& rC,
+                                  const c_vector<double, DIM>& rD)
+{
+    double adx = rA[0] - rD[0];
+    double ady = rA[1] - rD[1];
+    double bdx = rB[0] - rD[0];
+    double bdy = rB[1] - rD[1];
+    double cdx = rC[0] - rD[0];
+    double cdy = rC[1] - rD[1];
+    double ad = adx*adx + ady*ady;
+    double bd = bdx*bdx + bdy*bdy;
+    double cd = cdx*cdx + cdy*cdy;
+
+    return adx*(bdy*cd - bd*cdy) - ady*(bdx*cd - bd*cdx) + ad*(bdx*cdy - bdy*cdx);
+}
+
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 MutableMesh<ELEMENT_DIM, SPACE_DIM>::MutableMesh()
-    : mAddedNodes(false)
+    : mAddedNodes(false),
+      mUseIncrementalReMesh(false),
+      mLastReMeshWasIncremental(false)
 {
     this->mMeshChangesDuringSimulation = true;
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 MutableMesh<ELEMENT_DIM, SPACE_DIM>::MutableMesh(std::vector<Node<SPACE_DIM> *> nodes)
+    : mUseIncrementalReMesh(false),
+      mLastReMeshWasIncremental(false)
 {
     this->mMeshChangesDuringSimulation = true;
     Clear();
@@ -79,7 +130,8 @@ MutableMesh<ELEMENT_DIM, SPACE_DIM>::~MutableMesh()
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 unsigned MutableMesh<ELEMENT_DIM, SPACE_DIM>::AddNode(Node<SPACE_DIM>* pNewNode)
 {
-    if (mDeletedNodeIndices.empty())
+    // When repairing the triangulation incrementally, deleted nodes must survive until the next ReMesh()
+    if (mDeletedNodeIndices.empty() || mUseIncrementalReMesh)
     {
         pNewNode->SetIndex(this->mNodes.size());
         this->mNodes.push_back(pNewNode);
@@ -686,6 +738,7 @@ void MutableMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh(NodeMap& map)
 
     // Make sure the map is big enough
     map.Resize(this->GetNumAllNodes());
+    mLastReMeshWasIncremental = false;
     if (mAddedNodes || !mDeletedNodeIndices.empty())
     {
         // Size of mesh is about to change
@@ -775,6 +828,12 @@ void MutableMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh(NodeMap& map)
     }
     else if (SPACE_DIM==2)  // In 2D, remesh using triangle via library calls
     {
+        if (mUseIncrementalReMesh && IncrementalReMesh(map))
+        {
+            mLastReMeshWasIncremental = true;
+            return;
+        }
+
         struct triangulateio mesher_input, mesher_output;
         this->InitialiseTriangulateIo(mesher_input);
         this->InitialiseTriangulateIo(mesher_output);
@@ -811,6 +870,415 @@ void MutableMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh()
     ReMesh(map);
 }
 
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MutableMesh<ELEMENT_DIM, SPACE_DIM>::SetUseIncrementalReMesh(bool useIncrementalReMesh)
+{
+    mUseIncrementalReMesh = useIncrementalReMesh;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::GetUseIncrementalReMesh() const
+{
+    return mUseIncrementalReMesh;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::GetLastReMeshWasIncremental() const
+{
+    return mLastReMeshWasIncremental;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::CanReMeshIncrementally() const
+{
+    return (ELEMENT_DIM == 2 && SPACE_DIM == 2);
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableMesh<ELEMENT_DIM, SPACE_DIM>::IncrementalReMesh(NodeMap& rMap)
+{
+    typedef Element<ELEMENT_DIM, SPACE_DIM> element_t;
+
+    if (!CanReMeshIncrementally() || GetNumElements() == 0)
+    {
+        return false;
+    }
+
+    // Returns the indices of the (one or two) elements sharing the edge between two nodes
+    auto get_shared_elements = [](Node<SPACE_DIM>* pNodeA, Node<SPACE_DIM>* pNodeB)
+    {
+        std::vector<unsigned> shared_elements;
+        std::set_intersection(pNodeA->rGetContainingElementIndices().begin(), pNodeA->rGetContainingElementIndices().end(),
+                              pNodeB->rGetContainingElementIndices().begin(), pNodeB->rGetContainingElementIndices().end(),
+                              std::back_inserter(shared_elements));
+        return shared_elements;
+    };
+
+    // Returns the node of a triangle that is not on the given edge
+    auto get_opposite_node = [](element_t* pElement, Node<SPACE_DIM>* pNodeA, Node<SPACE_DIM>* pNodeB)
+    {
+        for (unsigned i=0; i<3; i++)
+        {
+            if (pElement->GetNode(i) != pNodeA && pElement->GetNode(i) != pNodeB)
+            {
+                return pElement->GetNode(i);
+            }
+        }
+        NEVER_REACHED;
+    };
+
+    auto contains_deleted_node = [](element_t* pElement)
+    {
+        return pElement->GetNode(0)->IsDeleted() || pElement->GetNode(1)->IsDeleted() || pElement->GetNode(2)->IsDeleted();
+    };
+
+    /*
+     * Deleted nodes may not be interrogated for their location, so elements containing them are
+     * left out of the checks below. The cavity left by each deleted node is filled using the
+     * locations of its neighbours, so adjacent deleted nodes are left to the full remesh.
+     */
+    for (unsigned i=0; i<mDeletedNodeIndices.size(); i++)
+    {
+        Node<SPACE_DIM>* p_node = this->mNodes[mDeletedNodeIndices[i]];
+        if (p_node->GetNumContainingElements() > 0 && p_node->IsBoundaryNode())
+        {
+            return false;
+        }
+
+        std::set<unsigned>& r_containing_elements = p_node->rGetContainingElementIndices();
+        for (std::set<unsigned>::iterator it = r_containing_elements.begin(); it != r_containing_elements.end(); ++it)
+        {
+            element_t* p_element = this->mElements[*it];
+            for (unsigned j=0; j<3; j++)
+            {
+                if (p_element->GetNode(j) != p_node && p_element->GetNode(j)->IsDeleted())
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    // Tolerances are relative to the longest edge, so that the repair is independent of the length scale
+    double max_edge_length_squared = 0.0;
+    for (typename AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ElementIterator elem_iter = this->GetElementIteratorBegin();
+         elem_iter != this->GetElementIteratorEnd();
+         ++elem_iter)
+    {
+        for (unsigned i=0; i<3; i++)
+        {
+            if (elem_iter->GetNode(i)->IsDeleted() || elem_iter->GetNode((i+1)%3)->IsDeleted())
+            {
+                continue;
+            }
+            c_vector<double, SPACE_DIM> edge = elem_iter->GetNode((i+1)%3)->rGetLocation() - elem_iter->GetNode(i)->rGetLocation();
+            max_edge_length_squared = std::max(max_edge_length_squared, inner_prod(edge, edge));
+        }
+    }
+    const double area_tolerance = 1e-12*max_edge_length_squared;
+    const double in_circle_tolerance = 1e-10*max_edge_length_squared*max_edge_length_squared;
+
+    /*
+     * The existing triangulation can only be repaired if node movement has not inverted
+     * any element, and if the boundary is still convex (Triangle meshes the convex hull).
+     */
+    std::map<Node<SPACE_DIM>*, Node<SPACE_DIM>*> next_boundary_node;
+    for (typename AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ElementIterator elem_iter = this->GetElementIteratorBegin();
+         elem_iter != this->GetElementIteratorEnd();
+         ++elem_iter)
+    {
+        if (!contains_deleted_node(&(*elem_iter))
+            && SignedDoubleArea(elem_iter->GetNode(0)->rGetLocation(),
+                                elem_iter->GetNode(1)->rGetLocation(),
+                                elem_iter->GetNode(2)->rGetLocation()) <= area_tolerance)
+        {
+            return false;
+        }
+
+        // Elements are anticlockwise, so boundary edges are traversed anticlockwise around the mesh
+        for (unsigned i=0; i<3; i++)
+        {
+            Node<SPACE_DIM>* p_node_a = elem_iter->GetNode(i);
+            Node<SPACE_DIM>* p_node_b = elem_iter->GetNode((i+1)%3);
+            if (get_shared_elements(p_node_a, p_node_b).size() == 1)
+            {
+                if (next_boundary_node.find(p_node_a) != next_boundary_node.end())
+                {
+                    return false;
+                }
+                next_boundary_node[p_node_a] = p_node_b;
+            }
+        }
+    }
+    if (next_boundary_node.size() != GetNumBoundaryElements())
+    {
+        return false;
+    }
+    for (typename std::map<Node<SPACE_DIM>*, Node<SPACE_DIM>*>::iterator it = next_boundary_node.begin();
+         it != next_boundary_node.end();
+         ++it)
+    {
+        typename std::map<Node<SPACE_DIM>*, Node<SPACE_DIM>*>::iterator next_it = next_boundary_node.find(it->second);
+        if (next_it == next_boundary_node.end()
+            || SignedDoubleArea(it->first->rGetLocation(), it->second->rGetLocation(), next_it->second->rGetLocation()) < -area_tolerance)
+        {
+            return false;
+        }
+    }
+
+    // Adds a triangle to the mesh; the Element constructor orders its nodes anticlockwise
+    auto add_triangle = [this](Node<SPACE_DIM>* pNodeA, Node<SPACE_DIM>* pNodeB, Node<SPACE_DIM>* pNodeC)
+    {
+        std::vector<Node<SPACE_DIM>*> nodes;
+        nodes.push_back(pNodeA);
+        nodes.push_back(pNodeB);
+        nodes.push_back(pNodeC);
+        AddElement(new element_t(UINT_MAX, nodes));
+    };
+
+    // Remove each deleted node by retriangulating the polygon formed by its neighbours
+    for (unsigned i=0; i<mDeletedNodeIndices.size(); i++)
+    {
+        Node<SPACE_DIM>* p_node = this->mNodes[mDeletedNodeIndices[i]];
+        if (p_node->GetNumContainingElements() == 0)
+        {
+            continue;
+        }
+
+        // Order the neighbouring nodes anticlockwise around the deleted node
+        std::set<unsigned> containing_elements = p_node->rGetContainingElementIndices();
+        std::map<Node<SPACE_DIM>*, Node<SPACE_DIM>*> next_neighbour;
+        for (std::set<unsigned>::iterator it = containing_elements.begin(); it != containing_elements.end(); ++it)
+        {
+            element_t* p_element = this->mElements[*it];
+            unsigned local_index = 0;
+            while (p_element->GetNode(local_index) != p_node)
+            {
+                local_index++;
+            }
+            next_neighbour[p_element->GetNode((local_index+1)%3)] = p_element->GetNode((local_index+2)%3);
+        }
+
+        std::vector<Node<SPACE_DIM>*> polygon;
+        polygon.push_back(next_neighbour.begin()->first);
+        while (polygon.size() <= containing_elements.size())
+        {
+            typename std::map<Node<SPACE_DIM>*, Node<SPACE_DIM>*>::iterator next_it = next_neighbour.find(polygon.back());
+            if (next_it == next_neighbour.end() || next_it->second == polygon[0])
+            {
+                break;
+            }
+            polygon.push_back(next_it->second);
+        }
+        if (polygon.size() != containing_elements.size() || next_neighbour[polygon.back()] != polygon[0])
+        {
+            return false;
+        }
+
+        for (std::set<unsigned>::iterator it = containing_elements.begin(); it != containing_elements.end(); ++it)
+        {
+            this->mElements[*it]->MarkAsDeleted();
+            mDeletedElementIndices.push_back(*it);
+        }
+
+        // Fill the polygon by ear clipping; the edge flips below then make the result Delaunay
+        while (polygon.size() > 3)
+        {
+            bool found_ear = false;
+            for (unsigned j=0; j<polygon.size() && !found_ear; j++)
+            {
+                Node<SPACE_DIM>* p_previous = polygon[(j + polygon.size() - 1)%polygon.size()];
+                Node<SPACE_DIM>* p_current = polygon[j];
+                Node<SPACE_DIM>* p_next = polygon[(j+1)%polygon.size()];
+                const c_vector<double, SPACE_DIM>& r_a = p_previous->rGetLocation();
+                const c_vector<double, SPACE_DIM>& r_b = p_current->rGetLocation();
+                const c_vector<double, SPACE_DIM>& r_c = p_next->rGetLocation();
+                if (SignedDoubleArea(r_a, r_b, r_c) <= area_tolerance)
+                {
+                    continue;
+                }
+
+                found_ear = true;
+                for (unsigned k=0; k<polygon.size() && found_ear; k++)
+                {
+                    if (polygon[k] != p_previous && polygon[k] != p_current && polygon[k] != p_next)
+                    {
+                        const c_vector<double, SPACE_DIM>& r_p = polygon[k]->rGetLocation();
+                        found_ear = !(SignedDoubleArea(r_a, r_b, r_p) >= 0.0
+                                      && SignedDoubleArea(r_b, r_c, r_p) >= 0.0
+                                      && SignedDoubleArea(r_c, r_a, r_p) >= 0.0);
+                    }
+                }
+                if (found_ear)
+                {
+                    add_triangle(p_previous, p_current, p_next);
+                    polygon.erase(polygon.begin() + j);
+                }
+            }
+            if (!found_ear)
+            {
+                return false;
+            }
+        }
+        if (SignedDoubleArea(polygon[0]->rGetLocation(), polygon[1]->rGetLocation(), polygon[2]->rGetLocation()) <= area_tolerance)
+        {
+            return false;
+        }
+        add_triangle(polygon[0], polygon[1], polygon[2]);
+    }
+
+    /*
+     * Insert each new node by splitting the element containing it into three. The element is
+     * found by walking across the mesh, at each step crossing an edge that separates the current
+     * element from the node, starting from the element that contained the previous new node
+     * (new nodes are usually added close together, for example by cell division).
+     */
+    element_t* p_container = &(*(this->GetElementIteratorBegin()));
+    for (unsigned node_index=0; node_index<this->mNodes.size(); node_index++)
+    {
+        Node<SPACE_DIM>* p_node = this->mNodes[node_index];
+        if (p_node->IsDeleted() || p_node->GetNumContainingElements() > 0)
+        {
+            continue;
+        }
+
+        unsigned num_steps = 0;
+        while (true)
+        {
+            unsigned exit_edge = UINT_MAX;
+            bool is_inside = true;
+            for (unsigned i=0; i<3 && exit_edge == UINT_MAX; i++)
+            {
+                double double_area = SignedDoubleArea(p_container->GetNode(i)->rGetLocation(),
+                                                      p_container->GetNode((i+1)%3)->rGetLocation(),
+                                                      p_node->rGetLocation());
+                if (double_area < -area_tolerance)
+                {
+                    exit_edge = i;
+                }
+                is_inside = is_inside && (double_area > area_tolerance);
+            }
+
+            // Points on an edge of the containing element need a four-way split, so are left to the full remesh
+            if (exit_edge == UINT_MAX)
+            {
+                if (!is_inside)
+                {
+                    return false;
+                }
+                break;
+            }
+
+            // Points outside the mesh change its convex hull; the step count guards against cycling caused by rounding
+            std::vector<unsigned> shared_elements = get_shared_elements(p_container->GetNode(exit_edge),
+                                                                        p_container->GetNode((exit_edge+1)%3));
+            if (shared_elements.size() != 2 || ++num_steps > GetNumElements())
+            {
+                return false;
+            }
+            unsigned next_index = (shared_elements[0] == p_container->GetIndex()) ? shared_elements[1] : shared_elements[0];
+            p_container = this->mElements[next_index];
+        }
+
+        Node<SPACE_DIM>* p_node_0 = p_container->GetNode(0);
+        Node<SPACE_DIM>* p_node_1 = p_container->GetNode(1);
+        Node<SPACE_DIM>* p_node_2 = p_container->GetNode(2);
+        add_triangle(p_node, p_node_1, p_node_2);
+        add_triangle(p_node_0, p_node, p_node_2);
+        p_container->ReplaceNode(p_node_2, p_node);
+    }
+
+    /*
+     * Make the triangulation Delaunay using Lawson's algorithm: flip any interior edge whose
+     * opposite node lies inside the circumcircle of the element on the other side, and recheck
+     * the edges of the quadrilateral around each flipped edge. This terminates in 2D, but we
+     * guard against cycling caused by rounding.
+     */
+    std::set<std::pair<unsigned, unsigned> > edges_to_check;
+    for (typename AbstractTetrahedralMesh<ELEMENT_DIM, SPACE_DIM>::ElementIterator elem_iter = this->GetElementIteratorBegin();
+         elem_iter != this->GetElementIteratorEnd();
+         ++elem_iter)
+    {
+        for (unsigned i=0; i<3; i++)
+        {
+            unsigned index_a = elem_iter->GetNodeGlobalIndex(i);
+            unsigned index_b = elem_iter->GetNodeGlobalIndex((i+1)%3);
+            edges_to_check.insert(std::make_pair(std::min(index_a, index_b), std::max(index_a, index_b)));
+        }
+    }
+
+    unsigned num_flips = 0;
+    const unsigned max_num_flips = 100*GetNumElements();
+    while (!edges_to_check.empty())
+    {
+        Node<SPACE_DIM>* p_node_a = this->mNodes[edges_to_check.begin()->first];
+        Node<SPACE_DIM>* p_node_b = this->mNodes[edges_to_check.begin()->second];
+        edges_to_check.erase(edges_to_check.begin());
+
+        std::vector<unsigned> shared_elements = get_shared_elements(p_node_a, p_node_b);
+        if (shared_elements.size() != 2)
+        {
+            continue;
+        }
+        element_t* p_element_1 = this->mElements[shared_elements[0]];
+        element_t* p_element_2 = this->mElements[shared_elements[1]];
+        Node<SPACE_DIM>* p_node_c = get_opposite_node(p_element_1, p_node_a, p_node_b);
+        Node<SPACE_DIM>* p_node_d = get_opposite_node(p_element_2, p_node_a, p_node_b);
+
+        // Order the edge so that (a, b, c) is anticlockwise and d lies to the right of a->b
+        if (SignedDoubleArea(p_node_a->rGetLocation(), p_node_b->rGetLocation(), p_node_c->rGetLocation()) < 0.0)
+        {
+            std::swap(p_node_a, p_node_b);
+        }
+        const c_vector<double, SPACE_DIM>& r_a = p_node_a->rGetLocation();
+        const c_vector<double, SPACE_DIM>& r_b = p_node_b->rGetLocation();
+        const c_vector<double, SPACE_DIM>& r_c = p_node_c->rGetLocation();
+        const c_vector<double, SPACE_DIM>& r_d = p_node_d->rGetLocation();
+
+        if (InCircleDeterminant(r_a, r_b, r_c, r_d) > in_circle_tolerance
+            && SignedDoubleArea(r_c, r_a, r_d) > area_tolerance
+            && SignedDoubleArea(r_d, r_b, r_c) > area_tolerance)
+        {
+            if (++num_flips > max_num_flips)
+            {
+                return false; // LCOV_EXCL_LINE
+            }
+
+            // (a, b, c) becomes (a, d, c) and (b, a, d) becomes (b, c, d), preserving orientation
+            p_element_1->ReplaceNode(p_node_b, p_node_d);
+            p_element_2->ReplaceNode(p_node_a, p_node_c);
+
+            unsigned index_a = p_node_a->GetIndex();
+            unsigned index_b = p_node_b->GetIndex();
+            unsigned index_c = p_node_c->GetIndex();
+            unsigned index_d = p_node_d->GetIndex();
+            edges_to_check.insert(std::make_pair(std::min(index_a, index_c), std::max(index_a, index_c)));
+            edges_to_check.insert(std::make_pair(std::min(index_a, index_d), std::max(index_a, index_d)));
+            edges_to_check.insert(std::make_pair(std::min(index_b, index_c), std::max(index_b, index_c)));
+            edges_to_check.insert(std::make_pair(std::min(index_b, index_d), std::max(index_b, index_d)));
+        }
+    }
+
+    /*
+     * A full remesh creates new nodes, so the applied force is cleared as it would have
+     * been there. Other node attributes (such as radii) are kept.
+     */
+    for (unsigned node_index=0; node_index<this->mNodes.size(); node_index++)
+    {
+        if (!this->mNodes[node_index]->IsDeleted() && this->mNodes[node_index]->HasNodeAttributes())
+        {
+            this->mNodes[node_index]->ClearAppliedForce();
+        }
+    }
+
+    // Update the cached Jacobians before ReIndex() shuffles them, then remove deleted nodes and elements
+    this->RefreshJacobianCachedData();
+    mAddedNodes = false;
+    ReIndex(rMap);
+
+    return true;
+}
+
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 std::vector<c_vector<unsigned, 5> > MutableMesh<ELEMENT_DIM, SPACE_DIM>::SplitLongEdges(double cutoffLength)
 {
@@ -150,8 +150,48 @@ protected:
     /** Whether any nodes have been added to the mesh. */
     bool mAddedNodes;
 
+    /**
+     * @return whether ReMesh() may repair the existing triangulation rather than build
+     * a new one. This is only implemented for ELEMENT_DIM = SPACE_DIM = 2, and periodic
+     * subclasses, which remesh a copy of the mesh extended by image nodes, override this
+     * method to return false.
+     */
+    virtual bool CanReMeshIncrementally() const;
+
 private:
 
+    /**
+     * Whether ReMesh() should first try to repair the existing triangulation
+     * with local edge flips, point insertions and point deletions, falling back
+     * to a full retriangulation only if this fails. Only used in 2D. Defaults
+     * to false.
+     */
+    bool mUseIncrementalReMesh;
+
+    /** Whether the most recent call to ReMesh() repaired the existing triangulation. */
+    bool mLastReMeshWasIncremental;
+
+    /**
+     * Try to restore a Delaunay triangulation of the current nodes by repairing the
+     * existing one rather than retriangulating from scratch. Nodes marked as deleted
+     * are removed from the triangulation, nodes not yet in any element are inserted,
+     * and the result is made Delaunay by Lawson edge flips. The mesh is then
+     * re-indexed so that the NodeMap is filled in exactly as by a full remesh.
+     *
+     * The repair is abandoned (and false returned) if any element has been inverted,
+     * the boundary is no longer convex, a boundary node has been deleted or a new node
+     * lies outside the mesh or on an existing edge. The mesh is then left in a state
+     * from which a full remesh can proceed, since that only reads the node locations.
+     *
+     * Returns false straight away unless CanReMeshIncrementally() is true. A new node is
+     * located by walking across the mesh from the element that contained the previous
+     * new node, rather than by testing every element.
+     *
+     * @param rMap the NodeMap to fill in
+     * @return whether the triangulation was successfully repaired
+     */
+    bool IncrementalReMesh(NodeMap& rMap);
+
     /**
      * @return true if the mesh is Voronoi local to the given element.
      * Check whether any neighbouring node is inside the circumsphere of this element.
@@ -322,6 +362,27 @@ public:
      */
     void ReMesh();
 
+    /**
+     * Set mUseIncrementalReMesh.
+     *
+     * While this is set, AddNode() appends new nodes rather than reusing the
+     * indices of deleted nodes, so that the existing triangulation remains
+     * intact until the next call to ReMesh().
+     *
+     * @param useIncrementalReMesh whether to repair the existing triangulation in ReMesh() where possible
+     */
+    void SetUseIncrementalReMesh(bool useIncrementalReMesh);
+
+    /**
+     * @return mUseIncrementalReMesh
+     */
+    bool GetUseIncrementalReMesh() const;
+
+    /**
+     * @return whether the most recent call to ReMesh() repaired the existing
+     * triangulation rather than retriangulating from scratch
+     */
+    bool GetLastReMeshWasIncremental() const;
 
     /**
      * Find edges in the mesh longer than the given cutoff length and split them creating new elements as required.
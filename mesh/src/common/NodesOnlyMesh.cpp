@@ -45,7 +45,9 @@ NodesOnlyMesh<SPACE_DIM>::NodesOnlyMesh()
           mMinimumNodeDomainBoundarySeparation(1.0),
           mMaxAddedNodeIndex(0u),
           mpBoxCollection(nullptr),
-          mCalculateNodeNeighbours(true)
+          mCalculateNodeNeighbours(true),
+          mUseFlatCellList(false),
+          mNeighbourListSkin(0.0)
 {
 }
 
@@ -205,6 +207,27 @@ double NodesOnlyMesh<SPACE_DIM>::GetMaximumInteractionDistance()
     return mMaximumInteractionDistance;
 }
 
+template<unsigned SPACE_DIM>
+void NodesOnlyMesh<SPACE_DIM>::SetNeighbourListSkin(double neighbourListSkin)
+{
+    assert(neighbourListSkin >= 0.0);
+    mNeighbourListSkin = neighbourListSkin;
+
+    // Set up the box collection again, over the same domain, with the new box width
+    if (mpBoxCollection)
+    {
+        c_vector<double, 2*SPACE_DIM> domain_size = mpBoxCollection->rGetDomainSize();
+        c_vector<bool, SPACE_DIM> is_periodic = mpBoxCollection->GetIsPeriodicAllDims();
+        SetUpBoxCollection(mMaximumInteractionDistance + mNeighbourListSkin, domain_size, PETSC_DECIDE, is_periodic);
+    }
+}
+
+template<unsigned SPACE_DIM>
+double NodesOnlyMesh<SPACE_DIM>::GetNeighbourListSkin() const
+{
+    return mNeighbourListSkin;
+}
+
 template<unsigned SPACE_DIM>
 double NodesOnlyMesh<SPACE_DIM>::GetWidth(const unsigned& rDimension) const
 {
@@ -222,6 +245,25 @@ void NodesOnlyMesh<SPACE_DIM>::SetCalculateNodeNeighbours(bool calculateNodeNeig
     mCalculateNodeNeighbours = calculateNodeNeighbours;
 }
 
+template<unsigned SPACE_DIM>
+void NodesOnlyMesh<SPACE_DIM>::SetUseFlatCellList(bool useFlatCellList)
+{
+    mUseFlatCellList = useFlatCellList;
+
+    // Move any nodes that are already in the box collection to the new storage
+    if (mpBoxCollection)
+    {
+        mpBoxCollection->SetUseFlatCellList(mUseFlatCellList);
+        UpdateBoxCollection();
+    }
+}
+
+template<unsigned SPACE_DIM>
+bool NodesOnlyMesh<SPACE_DIM>::GetUseFlatCellList() const
+{
+    return mUseFlatCellList;
+}
+
 template<unsigned SPACE_DIM>
 void NodesOnlyMesh<SPACE_DIM>::CalculateInteriorNodePairs(std::vector<std::pair<Node<SPACE_DIM>*, Node<SPACE_DIM>*> >& rNodePairs)
 {
@@ -514,17 +556,18 @@ void NodesOnlyMesh<SPACE_DIM>::EnlargeBoxCollection()
     c_vector<double, 2*SPACE_DIM> new_domain_size = current_domain_size;
 
     double fudge = 1e-14;
+    double box_width = mMaximumInteractionDistance + mNeighbourListSkin;
     c_vector<bool, SPACE_DIM> is_periodic = mpBoxCollection->GetIsPeriodicAllDims();
     for (unsigned d=0; d < SPACE_DIM; d++)
     {
         // We don't enlarge in periodic directions
         if ( !is_periodic(d) )
     {
-        new_domain_size[2*d] = current_domain_size[2*d] - (mMaximumInteractionDistance - fudge);
-        new_domain_size[2*d+1] = current_domain_size[2*d+1] + (mMaximumInteractionDistance - fudge);
+        new_domain_size[2*d] = current_domain_size[2*d] - (box_width - fudge);
+        new_domain_size[2*d+1] = current_domain_size[2*d+1] + (box_width - fudge);
     }
     }
-    SetUpBoxCollection(mMaximumInteractionDistance, new_domain_size, new_local_rows);
+    SetUpBoxCollection(box_width, new_domain_size, new_local_rows);
 }
 
 template<unsigned SPACE_DIM>
@@ -602,7 +645,7 @@ void NodesOnlyMesh<SPACE_DIM>::SetUpBoxCollection(const std::vector<Node<SPACE_D
         domain_size[2*i] = bounding_box.rGetLowerCorner()[i] - swell_factor;
         domain_size[2*i+1] = bounding_box.rGetUpperCorner()[i] + swell_factor;
     }
-    SetUpBoxCollection(mMaximumInteractionDistance, domain_size);
+    SetUpBoxCollection(mMaximumInteractionDistance + mNeighbourListSkin, domain_size);
 }
 
 template<unsigned SPACE_DIM>
@@ -632,6 +675,7 @@ void NodesOnlyMesh<SPACE_DIM>::SetUpBoxCollection(double cutOffLength, c_vector<
     mpBoxCollection = new DistributedBoxCollection<SPACE_DIM>(cutOffLength, domainSize, isPeriodicInX, isPeriodicInY, isPeriodicInZ, numLocalRows);
     mpBoxCollection->SetupLocalBoxesHalfOnly();
     mpBoxCollection->SetCalculateNodeNeighbours(mCalculateNodeNeighbours);
+    mpBoxCollection->SetUseFlatCellList(mUseFlatCellList);
 }
 
 template<unsigned SPACE_DIM>
@@ -643,7 +687,7 @@ void NodesOnlyMesh<SPACE_DIM>::AddNodesToBoxes()
                ++node_iter)
      {
           unsigned box_index = mpBoxCollection->CalculateContainingBox(&(*node_iter));
-          mpBoxCollection->rGetBox(box_index).AddNode(&(*node_iter));
+          mpBoxCollection->AddNodeToBox(box_index, &(*node_iter));
      }
 }
 
@@ -656,7 +700,7 @@ void NodesOnlyMesh<SPACE_DIM>::AddHaloNodesToBoxes()
             ++halo_node_iter)
     {
         unsigned box_index = mpBoxCollection->CalculateContainingBox((*halo_node_iter).get());
-        mpBoxCollection->rGetHaloBox(box_index).AddNode((*halo_node_iter).get());
+        mpBoxCollection->AddNodeToBox(box_index, (*halo_node_iter).get());
     }
 }
 
@@ -709,7 +753,7 @@ void NodesOnlyMesh<SPACE_DIM>::LoadBalanceMesh()
         current_domain_size[2*d] = current_domain_size[2*d] + fudge;
         current_domain_size[2*d+1] = current_domain_size[2*d+1] - fudge;
     }
-    SetUpBoxCollection(mMaximumInteractionDistance, current_domain_size, new_rows);
+    SetUpBoxCollection(mMaximumInteractionDistance + mNeighbourListSkin, current_domain_size, new_rows);
 }
 
 template<unsigned SPACE_DIM>
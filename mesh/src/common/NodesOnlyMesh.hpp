@@ -40,6 +40,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <boost/serialization/base_object.hpp>
 #include <boost/serialization/map.hpp>
 
+#include "ChasteSerializationVersion.hpp"
 #include "SmartPointers.hpp"
 #include "PetscTools.hpp"
 #include "DistributedBoxCollection.hpp"
@@ -74,6 +75,11 @@ private:
     {
         archive & mMaximumInteractionDistance;
         archive & mMinimumNodeDomainBoundarySeparation;
+        if (version > 0)
+        {
+            archive & mUseFlatCellList;
+            archive & mNeighbourListSkin;
+        }
         std::vector<unsigned> indices = GetAllNodeIndices();
         archive & indices;
         archive & boost::serialization::base_object<MutableMesh<SPACE_DIM, SPACE_DIM> >(*this);
@@ -95,6 +101,11 @@ private:
     {
         archive & mMaximumInteractionDistance;
         archive & mMinimumNodeDomainBoundarySeparation;
+        if (version > 0)
+        {
+            archive & mUseFlatCellList;
+            archive & mNeighbourListSkin;
+        }
         std::vector<unsigned> indices;
         archive & indices;
         archive & boost::serialization::base_object<MutableMesh<SPACE_DIM, SPACE_DIM> >(*this);
@@ -152,6 +163,16 @@ private:
     /** Whether to calculate node neighbours in the box collection. Switch off for efficiency */
     bool mCalculateNodeNeighbours;
 
+    /** Whether the box collection stores nodes in a flat cell list. Defaults to false. */
+    bool mUseFlatCellList;
+
+    /**
+     * An extra distance added to mMaximumInteractionDistance to give the width of the boxes,
+     * so that node pairs found by the box collection remain valid for several time steps
+     * (see NodeBasedCellPopulation::SetUseVerletList()). Defaults to zero.
+     */
+    double mNeighbourListSkin;
+
     /**
      * Calculate the next unique global index available on this
      * process. Uses a hashing function to ensure that a unique
@@ -323,6 +344,20 @@ public:
      */
     double GetMaximumInteractionDistance();
 
+    /**
+     * Set the extra distance added to the maximum interaction distance to give the width of
+     * the boxes in the box collection. If the box collection has already been set up then it
+     * is set up again with the new box width.
+     *
+     * @param neighbourListSkin the new skin distance (must be non-negative).
+     */
+    void SetNeighbourListSkin(double neighbourListSkin);
+
+    /**
+     * @return mNeighbourListSkin.
+     */
+    double GetNeighbourListSkin() const;
+
     /**
      * Overridden GetWidth method to work in parallel.
      *
@@ -338,6 +373,20 @@ public:
      */
     void SetCalculateNodeNeighbours(bool calculateNodeNeighbours);
 
+    /**
+     * Set whether the box collection should store nodes in a flat, contiguous cell list rather
+     * than in std::sets, for faster calculation of node pairs on large meshes.
+     * See DistributedBoxCollection::SetUseFlatCellList().
+     *
+     * @param useFlatCellList whether to use the flat cell list.
+     */
+    void SetUseFlatCellList(bool useFlatCellList);
+
+    /**
+     * @return #mUseFlatCellList
+     */
+    bool GetUseFlatCellList() const;
+
     /**
      * Calculate pairs of nodes from interior boxes using the BoxCollection.
      *
@@ -499,4 +548,23 @@ public:
 #include "SerializationExportWrapper.hpp"
 EXPORT_TEMPLATE_CLASS_SAME_DIMS(NodesOnlyMesh)
 
+namespace boost
+{
+namespace serialization
+{
+/**
+ * Specify a version number for archive backwards compatibility.
+ *
+ * This is how to do BOOST_CLASS_VERSION(NodesOnlyMesh, 1)
+ * with a templated class.
+ */
+template <unsigned SPACE_DIM>
+struct version<NodesOnlyMesh<SPACE_DIM> >
+{
+    ///Macro to set the version number of templated archive in known versions of Boost
+    CHASTE_VERSION_CONTENT(1);
+};
+} // namespace serialization
+} // namespace boost
+
 #endif /*NODESONLYMESH_HPP_*/
@@ -185,6 +185,11 @@ void Cylindrical2dMesh::CreateHaloNodes()
     }
 }
 
+bool Cylindrical2dMesh::CanReMeshIncrementally() const
+{
+    return false;
+}
+
 void Cylindrical2dMesh::ReMesh(NodeMap& rMap)
 {
     unsigned old_num_all_nodes = GetNumAllNodes();
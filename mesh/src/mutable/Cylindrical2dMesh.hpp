@@ -198,6 +198,13 @@ private:
      */
     void UseTheseElementsToDecideMeshing(std::set<unsigned>& rMainSideElements);
 
+    /**
+     * Overridden CanReMeshIncrementally() method.
+     *
+     * @return false, as the image nodes used by ReMesh() are recreated each time
+     */
+    bool CanReMeshIncrementally() const;
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -196,6 +196,11 @@ void Toroidal2dMesh::CreateMirrorNodes()
 
 }
 
+bool Toroidal2dMesh::CanReMeshIncrementally() const
+{
+    return false;
+}
+
 void Toroidal2dMesh::ReMesh(NodeMap& rMap)
 {
     unsigned old_num_all_nodes = GetNumAllNodes();
@@ -219,6 +219,13 @@ private:
      */
     unsigned GetCorrespondingToroidalNodeIndex(unsigned nodeIndex);
 
+    /**
+     * Overridden CanReMeshIncrementally() method.
+     *
+     * @return false, as the image nodes used by ReMesh() are recreated each time
+     */
+    bool CanReMeshIncrementally() const;
+
     /** Needed for serialization. */
     friend class boost::serialization::access;
     /**
@@ -155,6 +155,24 @@ const std::vector<unsigned>& AbstractMeshReader<ELEMENT_DIM, SPACE_DIM>::rGetNod
     EXCEPTION("Node permutations aren't supported by this reader");
 }
 
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned AbstractMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNumPartitions()
+{
+    return 0u;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void AbstractMeshReader<ELEMENT_DIM, SPACE_DIM>::GetPartition(unsigned partition,
+                                                              std::vector<unsigned>& rNodePermutation,
+                                                              std::vector<unsigned>& rProcessorsOffset,
+                                                              std::set<unsigned>& rNodesOwned,
+                                                              std::set<unsigned>& rHaloNodesOwned,
+                                                              std::set<unsigned>& rElementsOwned,
+                                                              std::set<unsigned>& rFacesOwned)
+{
+    EXCEPTION("Stored partitions aren't supported by this reader");
+}
+
 // Cable elements aren't supported in most formats
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
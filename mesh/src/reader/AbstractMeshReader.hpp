@@ -227,6 +227,35 @@ public:
      */
     virtual const std::vector<unsigned>& rGetNodePermutation();
 
+    /**
+     * @return the number of processes in a partition of the mesh stored with it, or 0 if there is none.
+     *
+     * Note, this will always return 0 unless over-ridden by a derived class that is able to store partitions.
+     */
+    virtual unsigned GetNumPartitions();
+
+    /**
+     * Get the part of a partition stored with the mesh which belongs to one process, in the form
+     * expected by DistributedTetrahedralMesh.
+     *
+     * Note, this will always throw an exception unless over-ridden by a derived class that is able to store partitions.
+     *
+     * @param partition  the process whose part of the partition is wanted
+     * @param rNodePermutation  filled in with the permuted index of each node
+     * @param rProcessorsOffset  filled in with the first permuted node index owned by each process
+     * @param rNodesOwned  filled in with the (unpermuted) indices of the nodes owned by this process
+     * @param rHaloNodesOwned  filled in with the indices of the halo nodes of this process
+     * @param rElementsOwned  filled in with the indices of the elements owned by this process
+     * @param rFacesOwned  filled in with the indices of the faces owned by this process
+     */
+    virtual void GetPartition(unsigned partition,
+                              std::vector<unsigned>& rNodePermutation,
+                              std::vector<unsigned>& rProcessorsOffset,
+                              std::set<unsigned>& rNodesOwned,
+                              std::set<unsigned>& rHaloNodesOwned,
+                              std::set<unsigned>& rElementsOwned,
+                              std::set<unsigned>& rFacesOwned);
+
 
     // Iterator classes
 
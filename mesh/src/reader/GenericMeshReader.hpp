@@ -40,15 +40,19 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string>
 
 #include "AbstractMeshReader.hpp"
+#include "FileFinder.hpp"
 
 // Possible mesh reader classes to create
 #include "TrianglesMeshReader.hpp"
 #include "MemfemMeshReader.hpp"
 #include "VtkMeshReader.hpp"
+#include "MappedMeshReader.hpp"
 
 /**
  * This function creates a mesh reader of a suitable type to read the mesh file given.
  * It can use any of the following readers:
+ *  - MappedMeshReader (used in preference to the others for linear meshes, if there is a .mmesh file
+ *    newer than any of the other mesh files with the same base name)
  *  - TrianglesMeshReader
  *  - MemfemMeshReader
  *  - VtkMeshReader
@@ -71,6 +75,33 @@ std::shared_ptr<AbstractMeshReader<ELEMENT_DIM, SPACE_DIM> > GenericMeshReader(c
                                                                              bool readContainingElementsForBoundaryElements=false)
 {
     std::shared_ptr<AbstractMeshReader<ELEMENT_DIM, SPACE_DIM> > p_reader;
+
+    /*
+     * A mapped mesh file is memory-mapped rather than read in full, so it is preferred to the
+     * source files it was written from, unless one of them has been changed since then. A mapped
+     * mesh file of other dimensions (or byte order) is ignored if there are source files to read.
+     */
+    FileFinder mapped_mesh_file(rPathBaseName + ".mmesh", RelativeTo::AbsoluteOrCwd);
+    bool use_mapped_mesh_file = (orderOfElements==1 && orderOfBoundaryElements==1 && !readContainingElementsForBoundaryElements
+                                 && mapped_mesh_file.IsFile());
+    bool source_file_exists = false;
+    const char* source_extensions[] = {".node", ".ele", ".face", ".edge", ".pts", ".tetras", ".tri", ".vtu"};
+    for (unsigned i=0; i<sizeof(source_extensions)/sizeof(source_extensions[0]) && use_mapped_mesh_file; i++)
+    {
+        FileFinder source_file(rPathBaseName + source_extensions[i], RelativeTo::AbsoluteOrCwd);
+        source_file_exists = source_file_exists || source_file.IsFile();
+        use_mapped_mesh_file = !source_file.IsFile() || mapped_mesh_file.IsNewerThan(source_file);
+    }
+    if (use_mapped_mesh_file && source_file_exists)
+    {
+        use_mapped_mesh_file = MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::HasMatchingHeader(rPathBaseName);
+    }
+    if (use_mapped_mesh_file)
+    {
+        p_reader.reset(new MappedMeshReader<ELEMENT_DIM, SPACE_DIM>(rPathBaseName));
+        return p_reader;
+    }
+
     try
     {
         p_reader.reset(new TrianglesMeshReader<ELEMENT_DIM, SPACE_DIM>(rPathBaseName,
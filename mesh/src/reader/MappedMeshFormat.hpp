@@ -0,0 +1,112 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef MAPPEDMESHFORMAT_HPP_
+#define MAPPEDMESHFORMAT_HPP_
+
+#include <cstdint>
+
+/**
+ * Layout of the binary mesh files (extension ".mmesh") written by MappedMeshWriter and
+ * read, via a memory map, by MappedMeshReader.
+ *
+ * The file starts with a MappedMeshFormat::Header, followed by the data blocks listed in
+ * MappedMeshFormat::Block. Each block starts at a multiple of MappedMeshFormat::ALIGNMENT
+ * bytes from the start of the file, at the offset given in the header, and holds an array
+ * of native doubles, unsigneds (node, element or face indices) or uint64_ts (offsets into
+ * another block). Files are therefore only portable between machines of the same byte order,
+ * which is recorded in the header so that other files can be recognised.
+ *
+ * A partition of the nodes between a number of processes may be stored with the mesh. The nodes
+ * owned by each process are listed in turn in the PARTITION_NODES block, in increasing order,
+ * so that entry k of this block is the node given index k when the mesh is permuted to give each
+ * process a contiguous range of node indices. Each process is also given the halo nodes, elements
+ * and faces it needs, i.e. the elements and faces containing at least one node it owns, and the
+ * other nodes of those elements. The NODE_PERMUTATION block is the inverse of the PARTITION_NODES
+ * block, which MappedMeshWriter ensures when the file is written.
+ */
+struct MappedMeshFormat
+{
+    /** The data blocks, in the order they are written. */
+    typedef enum
+    {
+        NODES=0,                    /**< SPACE_DIM coordinates per node (double) */
+        NODE_ATTRIBUTES,            /**< NumNodeAttributes attributes per node (double) */
+        ELEMENTS,                   /**< ELEMENT_DIM+1 node indices per element (unsigned) */
+        ELEMENT_ATTRIBUTES,         /**< NumElementAttributes attributes per element (double) */
+        FACES,                      /**< ELEMENT_DIM node indices per face (unsigned) */
+        FACE_ATTRIBUTES,            /**< NumFaceAttributes attributes per face (double) */
+        NODE_PERMUTATION,           /**< The permuted index of each node (unsigned) */
+        PARTITION_NODE_OFFSETS,     /**< Start of each process's nodes in PARTITION_NODES, and the end (uint64_t) */
+        PARTITION_NODES,            /**< The nodes owned by each process (unsigned) */
+        PARTITION_HALO_NODE_OFFSETS,/**< Start of each process's halo nodes in PARTITION_HALO_NODES, and the end (uint64_t) */
+        PARTITION_HALO_NODES,       /**< The halo nodes of each process (unsigned) */
+        PARTITION_ELEMENT_OFFSETS,  /**< Start of each process's elements in PARTITION_ELEMENTS, and the end (uint64_t) */
+        PARTITION_ELEMENTS,         /**< The elements owned by each process (unsigned) */
+        PARTITION_FACE_OFFSETS,     /**< Start of each process's faces in PARTITION_FACES, and the end (uint64_t) */
+        PARTITION_FACES,            /**< The faces owned by each process (unsigned) */
+        NUM_BLOCKS
+    } Block;
+
+    /** Alignment of each block, in bytes. */
+    static constexpr uint64_t ALIGNMENT = 64u;
+
+    /** Version of the format written by MappedMeshWriter. */
+    static constexpr uint32_t VERSION = 2u;
+
+    /** Written to the header in native byte order, so that files of the other byte order can be recognised. */
+    static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304u;
+
+    /** The header at the start of each file. */
+    struct Header
+    {
+        char Magic[8];                      /**< "CHSTMESH", to identify the file type */
+        uint32_t Version;                   /**< Version of the format */
+        uint32_t ByteOrder;                 /**< BYTE_ORDER_MARK, in the byte order of the machine that wrote the file */
+        uint32_t ElementDim;                /**< Dimension of the elements */
+        uint32_t SpaceDim;                  /**< Dimension of the space */
+        uint32_t NumNodes;                  /**< Number of nodes */
+        uint32_t NumElements;               /**< Number of elements */
+        uint32_t NumFaces;                  /**< Number of faces (boundary elements) */
+        uint32_t NumNodeAttributes;         /**< Number of attributes of each node */
+        uint32_t NumElementAttributes;      /**< Number of attributes of each element (0 or 1) */
+        uint32_t NumFaceAttributes;         /**< Number of attributes of each face (0 or 1) */
+        uint32_t NumPartitions;             /**< Number of processes in the stored partition, or 0 if there is none */
+        uint64_t BlockOffsets[NUM_BLOCKS];  /**< Offset of each block from the start of the file, in bytes */
+        uint64_t BlockSizes[NUM_BLOCKS];    /**< Size of each block, in bytes */
+    };
+};
+
+#endif /*MAPPEDMESHFORMAT_HPP_*/
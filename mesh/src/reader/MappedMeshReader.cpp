@@ -0,0 +1,460 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include <cstring>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MappedMeshReader.hpp"
+#include "Exception.hpp"
+
+static const char* MAPPED_MESH_FILE_EXTENSION = ".mmesh";
+
+///////////////////////////////////////////////////////////////////////////////////
+// Implementation
+///////////////////////////////////////////////////////////////////////////////////
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::MappedMeshReader(std::string pathBaseName)
+    : mFilesBaseName(pathBaseName),
+      mpData(nullptr),
+      mFileSize(0),
+      mpHeader(nullptr),
+      mNodesRead(0),
+      mElementsRead(0),
+      mFacesRead(0)
+{
+    std::string file_name = mFilesBaseName + MAPPED_MESH_FILE_EXTENSION;
+
+    int fd = open(file_name.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        EXCEPTION("Could not open data file: " + file_name);
+    }
+
+    struct stat file_status;
+    if (fstat(fd, &file_status) != 0 || file_status.st_size < (off_t)sizeof(MappedMeshFormat::Header))
+    {
+        close(fd);
+        EXCEPTION("File contains incomplete data: " + file_name + " is too small to be a mesh file.");
+    }
+    mFileSize = file_status.st_size;
+
+    void* p_map = mmap(nullptr, mFileSize, PROT_READ, MAP_SHARED, fd, 0);
+    // The mapping remains valid once the file is closed
+    close(fd);
+    if (p_map == MAP_FAILED)
+    {
+        // LCOV_EXCL_START
+        EXCEPTION("Could not memory-map data file: " + file_name);
+        // LCOV_EXCL_STOP
+    }
+    mpData = static_cast<const char*>(p_map);
+    mpHeader = reinterpret_cast<const MappedMeshFormat::Header*>(mpData);
+
+    try
+    {
+        CheckHeader();
+    }
+    catch (Exception&)
+    {
+        munmap(const_cast<char*>(mpData), mFileSize);
+        throw;
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::~MappedMeshReader()
+{
+    munmap(const_cast<char*>(mpData), mFileSize);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::HasMatchingHeader(const std::string& rPathBaseName)
+{
+    std::ifstream file((rPathBaseName + MAPPED_MESH_FILE_EXTENSION).c_str(), std::ios::binary);
+    MappedMeshFormat::Header header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    return (file.gcount() == (std::streamsize)sizeof(header)
+            && strncmp(header.Magic, "CHSTMESH", 8) == 0
+            && header.Version == MappedMeshFormat::VERSION
+            && header.ByteOrder == MappedMeshFormat::BYTE_ORDER_MARK
+            && header.ElementDim == ELEMENT_DIM
+            && header.SpaceDim == SPACE_DIM);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::CheckHeader()
+{
+    if (strncmp(mpHeader->Magic, "CHSTMESH", 8) != 0)
+    {
+        EXCEPTION(mFilesBaseName << MAPPED_MESH_FILE_EXTENSION << " is not a mapped mesh file.");
+    }
+    // BYTE_ORDER_MARK (0x01020304) reads as 0x04030201 if the file was written with the opposite byte order
+    if (mpHeader->ByteOrder == 0x04030201u)
+    {
+        EXCEPTION(mFilesBaseName << MAPPED_MESH_FILE_EXTENSION << " was written on a machine with the opposite byte order.");
+    }
+    if (mpHeader->Version != MappedMeshFormat::VERSION)
+    {
+        EXCEPTION("Mapped mesh file version " << mpHeader->Version << " is not supported (expected version "
+                  << MappedMeshFormat::VERSION << ").");
+    }
+    if (mpHeader->ByteOrder != MappedMeshFormat::BYTE_ORDER_MARK)
+    {
+        EXCEPTION(mFilesBaseName << MAPPED_MESH_FILE_EXTENSION << " is not a mapped mesh file.");
+    }
+    if (mpHeader->SpaceDim != SPACE_DIM || mpHeader->ElementDim != ELEMENT_DIM)
+    {
+        EXCEPTION("Mapped mesh file has ELEMENT_DIM=" << mpHeader->ElementDim << " and SPACE_DIM=" << mpHeader->SpaceDim
+                  << ", but reader has ELEMENT_DIM=" << ELEMENT_DIM << " and SPACE_DIM=" << SPACE_DIM << ".");
+    }
+    if (mpHeader->NumElementAttributes > 1 || mpHeader->NumFaceAttributes > 1)
+    {
+        EXCEPTION("Only one attribute per element or face is supported.");
+    }
+
+    const uint64_t num_nodes = mpHeader->NumNodes;
+    const uint64_t num_elements = mpHeader->NumElements;
+    const uint64_t num_faces = mpHeader->NumFaces;
+    CheckBlock(MappedMeshFormat::NODES, num_nodes*SPACE_DIM*sizeof(double));
+    CheckBlock(MappedMeshFormat::NODE_ATTRIBUTES, num_nodes*mpHeader->NumNodeAttributes*sizeof(double));
+    CheckBlock(MappedMeshFormat::ELEMENTS, num_elements*(ELEMENT_DIM+1)*sizeof(unsigned));
+    CheckBlock(MappedMeshFormat::ELEMENT_ATTRIBUTES, num_elements*mpHeader->NumElementAttributes*sizeof(double));
+    CheckBlock(MappedMeshFormat::FACES, num_faces*ELEMENT_DIM*sizeof(unsigned));
+    CheckBlock(MappedMeshFormat::FACE_ATTRIBUTES, num_faces*mpHeader->NumFaceAttributes*sizeof(double));
+
+    const uint64_t num_partitions = mpHeader->NumPartitions;
+    const uint64_t num_offsets = (num_partitions > 0) ? num_partitions+1 : 0;
+    CheckBlock(MappedMeshFormat::NODE_PERMUTATION, (num_partitions > 0) ? num_nodes*sizeof(unsigned) : 0);
+    CheckBlock(MappedMeshFormat::PARTITION_NODE_OFFSETS, num_offsets*sizeof(uint64_t));
+    CheckBlock(MappedMeshFormat::PARTITION_NODES, (num_partitions > 0) ? num_nodes*sizeof(unsigned) : 0);
+
+    // The size of each of the other partition blocks is given by the last entry of the corresponding offsets block
+    const MappedMeshFormat::Block offsets_blocks[4] = {MappedMeshFormat::PARTITION_NODE_OFFSETS,
+                                                       MappedMeshFormat::PARTITION_HALO_NODE_OFFSETS,
+                                                       MappedMeshFormat::PARTITION_ELEMENT_OFFSETS,
+                                                       MappedMeshFormat::PARTITION_FACE_OFFSETS};
+    for (unsigned i=1; i<4; i++)
+    {
+        MappedMeshFormat::Block offsets_block = offsets_blocks[i];
+        MappedMeshFormat::Block data_block = (MappedMeshFormat::Block)(offsets_block+1);
+        CheckBlock(offsets_block, num_offsets*sizeof(uint64_t));
+        uint64_t num_entries = (num_partitions > 0) ? GetBlock<uint64_t>(offsets_block)[num_partitions] : 0;
+        CheckBlock(data_block, num_entries*sizeof(unsigned));
+    }
+    for (unsigned i=0; i<4; i++)
+    {
+        const uint64_t* p_offsets = GetBlock<uint64_t>(offsets_blocks[i]);
+        for (unsigned partition=0; partition<num_partitions; partition++)
+        {
+            if (p_offsets[partition] > p_offsets[partition+1])
+            {
+                EXCEPTION("Partition stored in " << mFilesBaseName << MAPPED_MESH_FILE_EXTENSION << " is corrupt.");
+            }
+        }
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::CheckBlock(MappedMeshFormat::Block block, uint64_t expectedSize)
+{
+    uint64_t offset = mpHeader->BlockOffsets[block];
+    uint64_t size = mpHeader->BlockSizes[block];
+    if (size != expectedSize
+        || offset % MappedMeshFormat::ALIGNMENT != 0
+        || offset < sizeof(MappedMeshFormat::Header)
+        || offset > mFileSize
+        || size > mFileSize - offset)
+    {
+        EXCEPTION("File contains incomplete data: block " << block << " of " << mFilesBaseName << MAPPED_MESH_FILE_EXTENSION
+                  << " is missing or the wrong size.");
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNumElements() const
+{
+    return mpHeader->NumElements;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNumNodes() const
+{
+    return mpHeader->NumNodes;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNumFaces() const
+{
+    return mpHeader->NumFaces;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNumElementAttributes() const
+{
+    return mpHeader->NumElementAttributes;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNumFaceAttributes() const
+{
+    return mpHeader->NumFaceAttributes;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::Reset()
+{
+    mNodesRead = 0;
+    mElementsRead = 0;
+    mFacesRead = 0;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::vector<double> MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNextNode()
+{
+    if (mNodesRead >= mpHeader->NumNodes)
+    {
+        EXCEPTION("Node does not exist - not enough nodes.");
+    }
+
+    const double* p_coords = GetBlock<double>(MappedMeshFormat::NODES) + (size_t)mNodesRead*SPACE_DIM;
+    std::vector<double> ret_coords(p_coords, p_coords + SPACE_DIM);
+
+    const unsigned num_attributes = mpHeader->NumNodeAttributes;
+    const double* p_attributes = GetBlock<double>(MappedMeshFormat::NODE_ATTRIBUTES) + (size_t)mNodesRead*num_attributes;
+    mNodeAttributes.assign(p_attributes, p_attributes + num_attributes);
+
+    mNodesRead++;
+    return ret_coords;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+ElementData MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNextElementData()
+{
+    if (mElementsRead >= mpHeader->NumElements)
+    {
+        EXCEPTION("Element does not exist - not enough elements.");
+    }
+
+    ElementData element_data;
+    const unsigned* p_indices = GetBlock<unsigned>(MappedMeshFormat::ELEMENTS) + (size_t)mElementsRead*(ELEMENT_DIM+1);
+    element_data.NodeIndices.assign(p_indices, p_indices + ELEMENT_DIM+1);
+    for (unsigned j=0; j<ELEMENT_DIM+1; j++)
+    {
+        if (p_indices[j] >= mpHeader->NumNodes)
+        {
+            EXCEPTION("Element " << mElementsRead << " contains node " << p_indices[j] << ", but the mesh only has " << mpHeader->NumNodes << " nodes.");
+        }
+    }
+    element_data.AttributeValue = 0.0; // If there is no attribute this stays as zero, as in the other readers
+
+    if (mpHeader->NumElementAttributes > 0)
+    {
+        element_data.AttributeValue = GetBlock<double>(MappedMeshFormat::ELEMENT_ATTRIBUTES)[mElementsRead];
+    }
+
+    mElementsRead++;
+    return element_data;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+ElementData MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNextFaceData()
+{
+    if (mFacesRead >= mpHeader->NumFaces)
+    {
+        EXCEPTION("Face does not exist - not enough faces.");
+    }
+
+    ElementData face_data;
+    const unsigned* p_indices = GetBlock<unsigned>(MappedMeshFormat::FACES) + (size_t)mFacesRead*ELEMENT_DIM;
+    face_data.NodeIndices.assign(p_indices, p_indices + ELEMENT_DIM);
+    for (unsigned j=0; j<ELEMENT_DIM; j++)
+    {
+        if (p_indices[j] >= mpHeader->NumNodes)
+        {
+            EXCEPTION("Face " << mFacesRead << " contains node " << p_indices[j] << ", but the mesh only has " << mpHeader->NumNodes << " nodes.");
+        }
+    }
+    face_data.AttributeValue = 1.0; // If there is no attribute this stays as one, as in the other readers
+
+    if (mpHeader->NumFaceAttributes > 0)
+    {
+        face_data.AttributeValue = GetBlock<double>(MappedMeshFormat::FACE_ATTRIBUTES)[mFacesRead];
+    }
+
+    mFacesRead++;
+    return face_data;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::vector<double> MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNodeAttributes()
+{
+    return mNodeAttributes;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::vector<double> MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNode(unsigned index)
+{
+    if (index >= mpHeader->NumNodes)
+    {
+        EXCEPTION("Node does not exist - not enough nodes.");
+    }
+    mNodesRead = index; // Allow GetNextNode() to note the position of the item after this one
+    return GetNextNode();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+ElementData MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetElementData(unsigned index)
+{
+    if (index >= mpHeader->NumElements)
+    {
+        EXCEPTION("Element " << index << " does not exist - not enough elements (only " << mpHeader->NumElements << ").");
+    }
+    mElementsRead = index;
+    return GetNextElementData();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+ElementData MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetFaceData(unsigned index)
+{
+    if (index >= mpHeader->NumFaces)
+    {
+        EXCEPTION("Face does not exist - not enough faces.");
+    }
+    mFacesRead = index;
+    return GetNextFaceData();
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::IsFileFormatBinary()
+{
+    return true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::string MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetMeshFileBaseName()
+{
+    return mFilesBaseName;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetNumPartitions()
+{
+    return mpHeader->NumPartitions;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetPartitionSet(MappedMeshFormat::Block offsetsBlock,
+                                                               MappedMeshFormat::Block dataBlock,
+                                                               unsigned partition,
+                                                               unsigned numItems,
+                                                               std::set<unsigned>& rSet)
+{
+    const uint64_t* p_offsets = GetBlock<uint64_t>(offsetsBlock);
+    const unsigned* p_data = GetBlock<unsigned>(dataBlock);
+
+    // The entries are stored in increasing order, so each may be inserted at the end of the set
+    rSet.clear();
+    for (uint64_t i=p_offsets[partition]; i<p_offsets[partition+1]; i++)
+    {
+        if (p_data[i] >= numItems)
+        {
+            EXCEPTION("Partition stored in " << mFilesBaseName << MAPPED_MESH_FILE_EXTENSION << " is corrupt.");
+        }
+        rSet.insert(rSet.end(), p_data[i]);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MappedMeshReader<ELEMENT_DIM, SPACE_DIM>::GetPartition(unsigned partition,
+                                                            std::vector<unsigned>& rNodePermutation,
+                                                            std::vector<unsigned>& rProcessorsOffset,
+                                                            std::set<unsigned>& rNodesOwned,
+                                                            std::set<unsigned>& rHaloNodesOwned,
+                                                            std::set<unsigned>& rElementsOwned,
+                                                            std::set<unsigned>& rFacesOwned)
+{
+    const unsigned num_partitions = mpHeader->NumPartitions;
+    if (partition >= num_partitions)
+    {
+        EXCEPTION("Partition " << partition << " does not exist - the mesh was partitioned for " << num_partitions << " processes.");
+    }
+
+    const uint64_t* p_node_offsets = GetBlock<uint64_t>(MappedMeshFormat::PARTITION_NODE_OFFSETS);
+    rProcessorsOffset.assign(p_node_offsets, p_node_offsets + num_partitions);
+
+    GetPartitionSet(MappedMeshFormat::PARTITION_NODE_OFFSETS, MappedMeshFormat::PARTITION_NODES, partition, mpHeader->NumNodes, rNodesOwned);
+    GetPartitionSet(MappedMeshFormat::PARTITION_HALO_NODE_OFFSETS, MappedMeshFormat::PARTITION_HALO_NODES, partition, mpHeader->NumNodes, rHaloNodesOwned);
+    GetPartitionSet(MappedMeshFormat::PARTITION_ELEMENT_OFFSETS, MappedMeshFormat::PARTITION_ELEMENTS, partition, mpHeader->NumElements, rElementsOwned);
+    GetPartitionSet(MappedMeshFormat::PARTITION_FACE_OFFSETS, MappedMeshFormat::PARTITION_FACES, partition, mpHeader->NumFaces, rFacesOwned);
+
+    /*
+     * The mesh keeps the whole permutation, but it was checked when the file was written, so only
+     * the entries of the nodes this process loads are checked here: its own nodes must be given
+     * its range of new indices, in order, and its halo nodes new indices in other ranges.
+     */
+    const unsigned* p_permutation = GetBlock<unsigned>(MappedMeshFormat::NODE_PERMUTATION);
+    rNodePermutation.assign(p_permutation, p_permutation + mpHeader->NumNodes);
+
+    uint64_t new_index = p_node_offsets[partition];
+    for (std::set<unsigned>::iterator it = rNodesOwned.begin(); it != rNodesOwned.end(); ++it)
+    {
+        if (p_permutation[*it] != new_index++)
+        {
+            EXCEPTION("Partition stored in " << mFilesBaseName << MAPPED_MESH_FILE_EXTENSION << " is corrupt.");
+        }
+    }
+    for (std::set<unsigned>::iterator it = rHaloNodesOwned.begin(); it != rHaloNodesOwned.end(); ++it)
+    {
+        if (p_permutation[*it] >= mpHeader->NumNodes
+            || (p_permutation[*it] >= p_node_offsets[partition] && p_permutation[*it] < p_node_offsets[partition+1]))
+        {
+            EXCEPTION("Partition stored in " << mFilesBaseName << MAPPED_MESH_FILE_EXTENSION << " is corrupt.");
+        }
+    }
+}
+
+// Explicit instantiation
+template class MappedMeshReader<1,1>;
+template class MappedMeshReader<1,2>;
+template class MappedMeshReader<1,3>;
+template class MappedMeshReader<2,2>;
+template class MappedMeshReader<2,3>;
+template class MappedMeshReader<3,3>;
@@ -0,0 +1,219 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _MAPPEDMESHREADER_HPP_
+#define _MAPPEDMESHREADER_HPP_
+
+#include <string>
+#include <vector>
+#include <set>
+#include "AbstractMeshReader.hpp"
+#include "MappedMeshFormat.hpp"
+
+/**
+ * Reader for the binary mesh files (extension ".mmesh") written by MappedMeshWriter.
+ *
+ * The file is memory-mapped rather than read, so that the operating system only pages in
+ * the parts of the file which are actually used.  All data may be accessed at random, and if
+ * the file stores a partition of the mesh then a DistributedTetrahedralMesh constructed from
+ * this reader (on the same number of processes) takes that partition and only touches the
+ * nodes, elements and faces belonging to each process.
+ *
+ * Only linear meshes are supported.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class MappedMeshReader : public AbstractMeshReader<ELEMENT_DIM,SPACE_DIM>
+{
+private:
+
+    std::string mFilesBaseName;     /**< The base name for mesh files. */
+
+    const char* mpData;             /**< Start of the memory map of the mesh file. */
+    size_t mFileSize;               /**< Size of the mesh file (and so of the memory map), in bytes. */
+    const MappedMeshFormat::Header* mpHeader; /**< The header at the start of the file. */
+
+    unsigned mNodesRead;            /**< Number of nodes read in (or the index of the last one read in + 1). */
+    unsigned mElementsRead;         /**< Number of elements read in (or the index of the last one read in + 1). */
+    unsigned mFacesRead;            /**< Number of faces read in (or the index of the last one read in + 1). */
+
+    std::vector<double> mNodeAttributes; /**< The attributes of the node last read. */
+
+    /**
+     * @return a pointer to the start of one of the data blocks in the file.
+     *
+     * @param block  the block wanted
+     */
+    template<typename T>
+    const T* GetBlock(MappedMeshFormat::Block block) const
+    {
+        return reinterpret_cast<const T*>(mpData + mpHeader->BlockOffsets[block]);
+    }
+
+    /**
+     * Check that the file was written with this machine's byte order, that the header describes a
+     * mesh of the right dimensions, and that all the blocks lie inside the file and are the size
+     * expected.  Throws if not.
+     */
+    void CheckHeader();
+
+    /**
+     * Helper method for CheckHeader.  Throws if a block is not where it should be or is not the expected size.
+     *
+     * @param block  the block to check
+     * @param expectedSize  the number of bytes it should take up
+     */
+    void CheckBlock(MappedMeshFormat::Block block, uint64_t expectedSize);
+
+    /**
+     * Helper method for GetPartition.  Copy part of one of the partition blocks into a set.
+     *
+     * @param offsetsBlock  the block giving the start of each process's entries
+     * @param dataBlock  the block holding the entries
+     * @param partition  the process whose entries are wanted
+     * @param numItems  the number of nodes, elements or faces, which every entry must be less than
+     * @param rSet  filled in with the entries
+     */
+    void GetPartitionSet(MappedMeshFormat::Block offsetsBlock,
+                         MappedMeshFormat::Block dataBlock,
+                         unsigned partition,
+                         unsigned numItems,
+                         std::set<unsigned>& rSet);
+
+public:
+
+    /**
+     * Constructor.  Memory-maps the file.
+     *
+     * @param pathBaseName  the base name of the mesh file from which to read the mesh data
+     *    (either absolute, or relative to the current directory).  The ".mmesh" extension is added.
+     */
+    MappedMeshReader(std::string pathBaseName);
+
+    /**
+     * Destructor.  Unmaps the file.
+     */
+    ~MappedMeshReader();
+
+    /**
+     * Read just the header of a mapped mesh file, to see whether this reader could read it.
+     * Used by GenericMeshReader to fall back to the source files when a mapped mesh file of
+     * other dimensions has the same base name.
+     *
+     * @param rPathBaseName  the base name of the mesh file (the ".mmesh" extension is added)
+     * @return whether the file has a header for a mesh of this reader's dimensions, with this
+     *     machine's byte order
+     */
+    static bool HasMatchingHeader(const std::string& rPathBaseName);
+
+    /** @return the number of elements in the mesh */
+    unsigned GetNumElements() const;
+
+    /** @return the number of nodes in the mesh */
+    unsigned GetNumNodes() const;
+
+    /** @return the number of faces in the mesh */
+    unsigned GetNumFaces() const;
+
+    /** @return the number of attributes of each element */
+    unsigned GetNumElementAttributes() const;
+
+    /** @return the number of attributes of each face */
+    unsigned GetNumFaceAttributes() const;
+
+    /** Resets pointers to beginning*/
+    void Reset();
+
+    /** @return a vector of the coordinates of each node in turn */
+    std::vector<double> GetNextNode();
+
+    /** @return a vector of the nodes of each element (and any attribute information, if there is any) in turn */
+    ElementData GetNextElementData();
+
+    /** @return a vector of the nodes of each face (and any attribute information, if there is any) in turn */
+    ElementData GetNextFaceData();
+
+    /**
+     * @return the attributes of the node last read
+     */
+    std::vector<double> GetNodeAttributes();
+
+    /**
+     * @param index  The global node index
+     * @return a vector of the coordinates of the node
+     */
+    std::vector<double> GetNode(unsigned index);
+
+    /**
+     * @param index  The global element index
+     * @return a vector of the node indices of the element (and any attribute information, if there is any)
+     */
+    ElementData GetElementData(unsigned index);
+
+    /**
+     * @param index  The global face index
+     * @return a vector of the node indices of the face (and any attribute information, if there is any)
+     */
+    ElementData GetFaceData(unsigned index);
+
+    /** @return true, since all data may be accessed at random */
+    bool IsFileFormatBinary();
+
+    /** @return #mFilesBaseName. */
+    std::string GetMeshFileBaseName();
+
+    /** @return the number of processes in the partition stored with the mesh, or 0 if there is none */
+    unsigned GetNumPartitions();
+
+    /**
+     * Get the part of the partition stored with the mesh which belongs to one process.
+     *
+     * @param partition  the process whose part of the partition is wanted
+     * @param rNodePermutation  filled in with the permuted index of each node
+     * @param rProcessorsOffset  filled in with the first permuted node index owned by each process
+     * @param rNodesOwned  filled in with the (unpermuted) indices of the nodes owned by this process
+     * @param rHaloNodesOwned  filled in with the indices of the halo nodes of this process
+     * @param rElementsOwned  filled in with the indices of the elements owned by this process
+     * @param rFacesOwned  filled in with the indices of the faces owned by this process
+     */
+    void GetPartition(unsigned partition,
+                      std::vector<unsigned>& rNodePermutation,
+                      std::vector<unsigned>& rProcessorsOffset,
+                      std::set<unsigned>& rNodesOwned,
+                      std::set<unsigned>& rHaloNodesOwned,
+                      std::set<unsigned>& rElementsOwned,
+                      std::set<unsigned>& rFacesOwned);
+};
+
+#endif //_MAPPEDMESHREADER_HPP_
@@ -48,7 +48,9 @@ DistributedBoxCollection<DIM>::DistributedBoxCollection(double boxWidth, c_vecto
       mIsPeriodicInY(isPeriodicInY),
       mIsPeriodicInZ(isPeriodicInZ),
       mAreLocalBoxesSet(false),
-      mCalculateNodeNeighbours(true)
+      mCalculateNodeNeighbours(true),
+      mUseFlatCellList(false),
+      mIsFlatCellListUpToDate(false)
 {
     // If the domain size is not 'divisible' (i.e. fmod(width, box_size) > 0.0) we swell the domain to enforce this.
     for (unsigned i=0; i<DIM; i++)
@@ -125,6 +127,9 @@ void DistributedBoxCollection<DIM>::EmptyBoxes()
     {
         mHaloBoxes[i].ClearNodes();
     }
+    mFlatCellListAddedNodes.clear();
+    mFlatCellListAddedSlots.clear();
+    mIsFlatCellListUpToDate = false;
 }
 
 template<unsigned DIM>
@@ -203,6 +208,32 @@ void DistributedBoxCollection<DIM>::SetupHaloBoxes()
 template<unsigned DIM>
 void DistributedBoxCollection<DIM>::UpdateHaloBoxes()
 {
+    if (mUseFlatCellList)
+    {
+        UpdateFlatCellList();
+
+        mHaloNodesLeft.clear();
+        for (unsigned i=0; i<mHalosLeft.size(); i++)
+        {
+            unsigned slot = GetFlatCellListSlot(mHalosLeft[i]);
+            for (unsigned j=mFlatCellListStarts[slot]; j<mFlatCellListStarts[slot+1]; j++)
+            {
+                mHaloNodesLeft.push_back(mFlatCellListNodeIndices[j]);
+            }
+        }
+
+        mHaloNodesRight.clear();
+        for (unsigned i=0; i<mHalosRight.size(); i++)
+        {
+            unsigned slot = GetFlatCellListSlot(mHalosRight[i]);
+            for (unsigned j=mFlatCellListStarts[slot]; j<mFlatCellListStarts[slot+1]; j++)
+            {
+                mHaloNodesRight.push_back(mFlatCellListNodeIndices[j]);
+            }
+        }
+        return;
+    }
+
     mHaloNodesLeft.clear();
     for (unsigned i=0; i<mHalosLeft.size(); i++)
     {
@@ -827,6 +858,7 @@ void DistributedBoxCollection<DIM>::SetupLocalBoxesHalfOnly()
                 NEVER_REACHED;
         }
         mAreLocalBoxesSet=true;
+        mFlatStencilStarts.clear();
     }
 }
 
@@ -834,6 +866,7 @@ template<unsigned DIM>
 void DistributedBoxCollection<DIM>::SetupAllLocalBoxes()
 {
     mAreLocalBoxesSet = true;
+    mFlatStencilStarts.clear();
     switch (DIM)
     {
         case 1:
@@ -1656,43 +1689,47 @@ void DistributedBoxCollection<DIM>::SetCalculateNodeNeighbours(bool calculateNod
     mCalculateNodeNeighbours = calculateNodeNeighbours;
 }
 
+template<unsigned DIM>
+void DistributedBoxCollection<DIM>::SetUseFlatCellList(bool useFlatCellList)
+{
+    mUseFlatCellList = useFlatCellList;
+}
+
+template<unsigned DIM>
+bool DistributedBoxCollection<DIM>::GetUseFlatCellList() const
+{
+    return mUseFlatCellList;
+}
+
+template<unsigned DIM>
+void DistributedBoxCollection<DIM>::AddNodeToBox(unsigned boxIndex, Node<DIM>* pNode)
+{
+    if (mUseFlatCellList)
+    {
+        mFlatCellListAddedNodes.push_back(pNode);
+        mFlatCellListAddedSlots.push_back(GetFlatCellListSlot(boxIndex));
+        mIsFlatCellListUpToDate = false;
+    }
+    else
+    {
+        rGetBox(boxIndex).AddNode(pNode);
+    }
+}
+
 template<unsigned DIM>
 void DistributedBoxCollection<DIM>::CalculateNodePairs(std::vector<Node<DIM>*>& rNodes, std::vector<std::pair<Node<DIM>*, Node<DIM>*> >& rNodePairs)
 {
     rNodePairs.clear();
 
     // Create an empty neighbours set for each node
-    for (unsigned i=0; i<rNodes.size(); i++)
-    {
-        // Get the box containing this node as only nodes on this process have NodeAttributes
-        // and therefore Neighbours setup.
-        unsigned box_index = CalculateContainingBox(rNodes[i]);
-
-        if (IsBoxOwned(box_index))
-        {
-            rNodes[i]->ClearNeighbours();
-        }
-    }
+    ClearOwnedNodeNeighbours(rNodes, false);
 
     for (unsigned box_index=mMinBoxIndex; box_index<=mMaxBoxIndex; box_index++)
     {
         AddPairsFromBox(box_index, rNodePairs);
     }
 
-    if (mCalculateNodeNeighbours)
-    {
-        for (unsigned i = 0; i < rNodes.size(); i++)
-        {
-            // Get the box containing this node as only nodes on this process have NodeAttributes
-            // and therefore Neighbours setup.
-            unsigned box_index = CalculateContainingBox(rNodes[i]);
-
-            if (IsBoxOwned(box_index))
-            {
-                rNodes[i]->RemoveDuplicateNeighbours();
-            }
-        }
-    }
+    FinaliseOwnedNodeNeighbours(rNodes, false);
 }
 
 template<unsigned DIM>
@@ -1701,66 +1738,101 @@ void DistributedBoxCollection<DIM>::CalculateInteriorNodePairs(std::vector<Node<
     rNodePairs.clear();
 
     // Create an empty neighbours set for each node
-    for (unsigned i=0; i<rNodes.size(); i++)
-    {
-        // Get the box containing this node as only nodes on this process have NodeAttributes
-        // and therefore Neighbours setup.
-        unsigned box_index = CalculateContainingBox(rNodes[i]);
+    ClearOwnedNodeNeighbours(rNodes, true);
 
-        if (IsBoxOwned(box_index))
+    for (unsigned box_index=mMinBoxIndex; box_index<=mMaxBoxIndex; box_index++)
+    {
+        if (IsInteriorBox(box_index))
         {
-            rNodes[i]->ClearNeighbours();
-            rNodes[i]->SetNeighboursSetUp(false);
+            AddPairsFromBox(box_index, rNodePairs);
         }
     }
 
+    FinaliseOwnedNodeNeighbours(rNodes, true);
+}
+
+template<unsigned DIM>
+void DistributedBoxCollection<DIM>::CalculateBoundaryNodePairs(std::vector<Node<DIM>*>& rNodes, std::vector<std::pair<Node<DIM>*, Node<DIM>*> >& rNodePairs)
+{
     for (unsigned box_index=mMinBoxIndex; box_index<=mMaxBoxIndex; box_index++)
     {
-        if (IsInteriorBox(box_index))
+        if (!IsInteriorBox(box_index))
         {
             AddPairsFromBox(box_index, rNodePairs);
         }
     }
 
-    if (mCalculateNodeNeighbours)
+    FinaliseOwnedNodeNeighbours(rNodes, true);
+}
+
+template<unsigned DIM>
+void DistributedBoxCollection<DIM>::ClearOwnedNodeNeighbours(std::vector<Node<DIM>*>& rNodes, bool resetNeighboursSetUp)
+{
+    if (mUseFlatCellList)
     {
-        for (unsigned i = 0; i < rNodes.size(); i++)
+        UpdateFlatCellList();
+
+        // The owned slots come first, so the owned nodes are at the start of the flat cell list
+        for (unsigned i=0; i<mFlatCellListStarts[mBoxes.size()]; i++)
         {
-            // Get the box containing this node as only nodes on this process have NodeAttributes
-            // and therefore Neighbours setup.
-            unsigned box_index = CalculateContainingBox(rNodes[i]);
+            mFlatCellListNodes[i]->ClearNeighbours();
+            if (resetNeighboursSetUp)
+            {
+                mFlatCellListNodes[i]->SetNeighboursSetUp(false);
+            }
+        }
+        return;
+    }
+
+    for (unsigned i=0; i<rNodes.size(); i++)
+    {
+        // Get the box containing this node as only nodes on this process have NodeAttributes
+        // and therefore Neighbours setup.
+        unsigned box_index = CalculateContainingBox(rNodes[i]);
 
-            if (IsBoxOwned(box_index))
+        if (IsBoxOwned(box_index))
+        {
+            rNodes[i]->ClearNeighbours();
+            if (resetNeighboursSetUp)
             {
-                rNodes[i]->RemoveDuplicateNeighbours();
-                rNodes[i]->SetNeighboursSetUp(true);
+                rNodes[i]->SetNeighboursSetUp(false);
             }
         }
     }
 }
 
 template<unsigned DIM>
-void DistributedBoxCollection<DIM>::CalculateBoundaryNodePairs(std::vector<Node<DIM>*>& rNodes, std::vector<std::pair<Node<DIM>*, Node<DIM>*> >& rNodePairs)
+void DistributedBoxCollection<DIM>::FinaliseOwnedNodeNeighbours(std::vector<Node<DIM>*>& rNodes, bool setNeighboursSetUp)
 {
-    for (unsigned box_index=mMinBoxIndex; box_index<=mMaxBoxIndex; box_index++)
+    if (!mCalculateNodeNeighbours)
     {
-        if (!IsInteriorBox(box_index))
+        return;
+    }
+
+    if (mUseFlatCellList)
+    {
+        for (unsigned i=0; i<mFlatCellListStarts[mBoxes.size()]; i++)
         {
-            AddPairsFromBox(box_index, rNodePairs);
+            mFlatCellListNodes[i]->RemoveDuplicateNeighbours();
+            if (setNeighboursSetUp)
+            {
+                mFlatCellListNodes[i]->SetNeighboursSetUp(true);
+            }
         }
+        return;
     }
 
-    if (mCalculateNodeNeighbours)
+    for (unsigned i = 0; i < rNodes.size(); i++)
     {
-        for (unsigned i = 0; i < rNodes.size(); i++)
-        {
-            // Get the box containing this node as only nodes on this process have NodeAttributes
-            // and therefore Neighbours setup.
-            unsigned box_index = CalculateContainingBox(rNodes[i]);
+        // Get the box containing this node as only nodes on this process have NodeAttributes
+        // and therefore Neighbours setup.
+        unsigned box_index = CalculateContainingBox(rNodes[i]);
 
-            if (IsBoxOwned(box_index))
+        if (IsBoxOwned(box_index))
+        {
+            rNodes[i]->RemoveDuplicateNeighbours();
+            if (setNeighboursSetUp)
             {
-                rNodes[i]->RemoveDuplicateNeighbours();
                 rNodes[i]->SetNeighboursSetUp(true);
             }
         }
@@ -1771,6 +1843,12 @@ template<unsigned DIM>
 void DistributedBoxCollection<DIM>::AddPairsFromBox(unsigned boxIndex,
                                                     std::vector<std::pair<Node<DIM>*, Node<DIM>*> >& rNodePairs)
 {
+    if (mUseFlatCellList)
+    {
+        AddPairsFromFlatCellList(boxIndex, rNodePairs);
+        return;
+    }
+
     // Get the box
     Box<DIM>& r_box = rGetBox(boxIndex);
 
@@ -1832,6 +1910,126 @@ void DistributedBoxCollection<DIM>::AddPairsFromBox(unsigned boxIndex,
     }
 }
 
+template<unsigned DIM>
+void DistributedBoxCollection<DIM>::AddPairsFromFlatCellList(unsigned boxIndex,
+                                                             std::vector<std::pair<Node<DIM>*, Node<DIM>*> >& rNodePairs)
+{
+    UpdateFlatCellList();
+    assert(mFlatStencilStarts.size() == mBoxes.size() + 1);
+
+    // Owned boxes occupy the first slots of the flat cell list
+    unsigned local_index = boxIndex - mMinBoxIndex;
+    unsigned box_begin = mFlatCellListStarts[local_index];
+    unsigned box_end = mFlatCellListStarts[local_index+1];
+
+    if (box_begin == box_end)
+    {
+        return;
+    }
+
+    // Loop over the precomputed stencil of local boxes
+    for (unsigned stencil_index = mFlatStencilStarts[local_index];
+         stencil_index < mFlatStencilStarts[local_index+1];
+         stencil_index++)
+    {
+        unsigned neighbour_slot = mFlatStencilSlots[stencil_index];
+        bool is_same_box = (neighbour_slot == local_index);
+
+        // Loop over the nodes contained in this box
+        for (unsigned j = mFlatCellListStarts[neighbour_slot]; j < mFlatCellListStarts[neighbour_slot+1]; j++)
+        {
+            unsigned other_node_index = mFlatCellListNodeIndices[j];
+            Node<DIM>* p_other_node = mFlatCellListNodes[j];
+
+            // Loop over nodes in this box
+            for (unsigned i = box_begin; i < box_end; i++)
+            {
+                unsigned node_index = mFlatCellListNodeIndices[i];
+
+                // If we're in the same box, then take care not to store the node pair twice
+                if (!is_same_box || other_node_index > node_index)
+                {
+                    rNodePairs.push_back(std::pair<Node<DIM>*, Node<DIM>*>(mFlatCellListNodes[i], p_other_node));
+                    if (mCalculateNodeNeighbours)
+                    {
+                        mFlatCellListNodes[i]->AddNeighbour(other_node_index);
+                        p_other_node->AddNeighbour(node_index);
+                    }
+                }
+            }
+        }
+    }
+}
+
+template<unsigned DIM>
+unsigned DistributedBoxCollection<DIM>::GetFlatCellListSlot(unsigned globalIndex)
+{
+    if (IsBoxOwned(globalIndex))
+    {
+        return globalIndex - mMinBoxIndex;
+    }
+
+    // If normal execution reaches this point then the box does not belong to the process so it must be a halo box
+    assert(IsHaloBox(globalIndex));
+    return mBoxes.size() + mHaloBoxesMapping.find(globalIndex)->second;
+}
+
+template<unsigned DIM>
+void DistributedBoxCollection<DIM>::UpdateFlatCellList()
+{
+    unsigned num_local_boxes = mBoxes.size();
+
+    // Flatten the local boxes into a stencil of slots, once they are available
+    if (mFlatStencilStarts.size() != num_local_boxes + 1 && mAreLocalBoxesSet)
+    {
+        mFlatStencilStarts.assign(1, 0);
+        mFlatStencilSlots.clear();
+        for (unsigned i=0; i<mLocalBoxes.size(); i++)
+        {
+            for (std::set<unsigned>::iterator box_iter = mLocalBoxes[i].begin();
+                 box_iter != mLocalBoxes[i].end();
+                 ++box_iter)
+            {
+                mFlatStencilSlots.push_back(GetFlatCellListSlot(*box_iter));
+            }
+            mFlatStencilStarts.push_back(mFlatStencilSlots.size());
+        }
+    }
+
+    if (mIsFlatCellListUpToDate)
+    {
+        return;
+    }
+
+    // Counting sort of the added nodes by slot: first count the nodes in each slot...
+    unsigned num_slots = num_local_boxes + mHaloBoxes.size();
+    mFlatCellListStarts.assign(num_slots + 1, 0);
+    for (unsigned i=0; i<mFlatCellListAddedSlots.size(); i++)
+    {
+        mFlatCellListStarts[mFlatCellListAddedSlots[i] + 1]++;
+    }
+
+    // ...then accumulate these counts into offsets...
+    for (unsigned slot=0; slot<num_slots; slot++)
+    {
+        mFlatCellListStarts[slot + 1] += mFlatCellListStarts[slot];
+    }
+
+    // ...then scatter the nodes into place, preserving the order in which they were added
+    unsigned num_nodes = mFlatCellListAddedNodes.size();
+    mFlatCellListNodes.resize(num_nodes);
+    mFlatCellListNodeIndices.resize(num_nodes);
+    std::vector<unsigned> next_position(mFlatCellListStarts.begin(), mFlatCellListStarts.end() - 1);
+    for (unsigned i=0; i<num_nodes; i++)
+    {
+        unsigned position = next_position[mFlatCellListAddedSlots[i]]++;
+        mFlatCellListNodes[position] = mFlatCellListAddedNodes[i];
+        mFlatCellListNodeIndices[position] = mFlatCellListAddedNodes[i]->GetIndex();
+    }
+
+    mIsFlatCellListUpToDate = true;
+}
+
 template<unsigned DIM>
 std::vector<int> DistributedBoxCollection<DIM>::CalculateNumberOfNodesInEachStrip()
 {
@@ -1842,7 +2040,15 @@ std::vector<int> DistributedBoxCollection<DIM>::CalculateNumberOfNodesInEachStri
         c_vector<unsigned, DIM> coords = CalculateGridIndices(global_index);
         unsigned location_in_vector = coords[DIM-1] - mpDistributedBoxStackFactory->GetLow();
         unsigned local_index = global_index - mMinBoxIndex;
-        cell_numbers[location_in_vector] += mBoxes[local_index].rGetNodesContained().size();
+        if (mUseFlatCellList)
+        {
+            UpdateFlatCellList();
+            cell_numbers[location_in_vector] += mFlatCellListStarts[local_index+1] - mFlatCellListStarts[local_index];
+        }
+        else
+        {
+            cell_numbers[location_in_vector] += mBoxes[local_index].rGetNodesContained().size();
+        }
     }
 
     return cell_numbers;
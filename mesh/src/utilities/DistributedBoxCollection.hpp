@@ -125,6 +125,42 @@ private:
     /** A flag that can be set to not save rNodeNeighbours in CalculateNodePairs - for efficiency */
     bool mCalculateNodeNeighbours;
 
+    /**
+     * Whether nodes are stored in a flat (CSR-style) cell list rather than in the
+     * std::set of each Box. Defaults to false.
+     */
+    bool mUseFlatCellList;
+
+    /** Whether the flat cell list is consistent with the nodes added since the last call to EmptyBoxes(). */
+    bool mIsFlatCellListUpToDate;
+
+    /** The nodes added to the flat cell list, in the order in which they were added. */
+    std::vector<Node<DIM>*> mFlatCellListAddedNodes;
+
+    /** The cell list slot of each node in mFlatCellListAddedNodes (see GetFlatCellListSlot()). */
+    std::vector<unsigned> mFlatCellListAddedSlots;
+
+    /**
+     * Offsets into mFlatCellListNodes: the nodes in slot s are stored in the range
+     * [mFlatCellListStarts[s], mFlatCellListStarts[s+1]).
+     */
+    std::vector<unsigned> mFlatCellListStarts;
+
+    /** The nodes of the flat cell list, sorted by slot. */
+    std::vector<Node<DIM>*> mFlatCellListNodes;
+
+    /** The indices of the nodes in mFlatCellListNodes, stored contiguously for the pair search. */
+    std::vector<unsigned> mFlatCellListNodeIndices;
+
+    /**
+     * Offsets into mFlatStencilSlots: the slots local to owned box b are stored in the range
+     * [mFlatStencilStarts[b], mFlatStencilStarts[b+1]), where b is the local index of the box.
+     */
+    std::vector<unsigned> mFlatStencilStarts;
+
+    /** The flattened local box stencils, stored as cell list slots (see mFlatStencilStarts). */
+    std::vector<unsigned> mFlatStencilSlots;
+
     /**
      * Setup the halo box structure on this process.
      * (Private method since this is called as a helper method by the constructor.)
@@ -133,6 +169,47 @@ private:
      */
     void SetupHaloBoxes();
 
+    /**
+     * Map a global box index to its slot in the flat cell list. Owned boxes occupy
+     * slots 0 to GetNumLocalBoxes()-1 and halo boxes follow in the order of mHaloBoxes.
+     *
+     * @param globalIndex the global index of an owned or halo box
+     * @return the slot of the box in the flat cell list.
+     */
+    unsigned GetFlatCellListSlot(unsigned globalIndex);
+
+    /**
+     * Bring the flat cell list up to date with the nodes that have been added, by
+     * counting-sorting them by slot. Also flattens the local boxes into
+     * mFlatStencilStarts/mFlatStencilSlots the first time it is called.
+     */
+    void UpdateFlatCellList();
+
+    /**
+     * A method pulled out of AddPairsFromBox() for use with the flat cell list.
+     *
+     * @param boxIndex the box to add neighbours to.
+     * @param rNodePairs the return value, a set of pairs of nodes
+     */
+    void AddPairsFromFlatCellList(unsigned boxIndex, std::vector<std::pair<Node<DIM>*, Node<DIM>*> >& rNodePairs);
+
+    /**
+     * Helper method for the CalculateNodePairs methods. Clears the neighbours of each node owned by this process.
+     *
+     * @param rNodes all the nodes to be considered
+     * @param resetNeighboursSetUp whether to also mark the neighbours of each node as not set up
+     */
+    void ClearOwnedNodeNeighbours(std::vector<Node<DIM>*>& rNodes, bool resetNeighboursSetUp);
+
+    /**
+     * Helper method for the CalculateNodePairs methods. Removes duplicate neighbours from each node
+     * owned by this process, if neighbours are being calculated.
+     *
+     * @param rNodes all the nodes to be considered
+     * @param setNeighboursSetUp whether to also mark the neighbours of each node as set up
+     */
+    void FinaliseOwnedNodeNeighbours(std::vector<Node<DIM>*>& rNodes, bool setNeighboursSetUp);
+
     /** Needed for serialization **/
     friend class boost::serialization::access;
 
@@ -373,6 +450,34 @@ public:
      */
     void SetCalculateNodeNeighbours(bool calculateNodeNeighbours);
 
+    /**
+     * Set whether to store nodes in a flat, contiguous cell list instead of in the std::set of
+     * each Box. The flat cell list is rebuilt with a counting sort whenever nodes have been added,
+     * and the local boxes are flattened into a precomputed stencil, so that the CalculateNodePairs
+     * methods access memory linearly. The pairs found are the same as with the Box storage,
+     * although they may be returned in a different order.
+     *
+     * When this is switched on, nodes must be added with AddNodeToBox() and the Box objects
+     * returned by rGetBox() remain empty. It should therefore be set before any nodes are added.
+     *
+     * @param useFlatCellList whether to use the flat cell list.
+     */
+    void SetUseFlatCellList(bool useFlatCellList);
+
+    /**
+     * @return #mUseFlatCellList
+     */
+    bool GetUseFlatCellList() const;
+
+    /**
+     * Add a node to the (owned or halo) box with global index boxIndex, or to the
+     * flat cell list if SetUseFlatCellList() has been called.
+     *
+     * @param boxIndex the global index of the box containing the node
+     * @param pNode the node to add
+     */
+    void AddNodeToBox(unsigned boxIndex, Node<DIM>* pNode);
+
     /**
      *  Compute all the pairs of (potentially) connected nodes for cell_based simulations, ie nodes which are in a
      *  local box to the box containing the first node. **Note: the user still has to check that the node
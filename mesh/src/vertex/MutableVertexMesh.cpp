@@ -397,6 +397,9 @@ unsigned MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::AddElement(VertexElement<ELE
     pNewElement->RegisterWithNodes();
     pNewElement->SetEdgeHelper(&(this->mEdgeHelper));
     pNewElement->BuildEdges();
+
+    // The new element may reuse the index of a deleted element
+    this->InvalidateElementGeometry();
     return pNewElement->GetIndex();
 }
 
@@ -404,6 +407,7 @@ template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::SetNode(unsigned nodeIndex, ChastePoint<SPACE_DIM> point)
 {
     this->mNodes[nodeIndex]->SetPoint(point);
+    this->InvalidateElementGeometryAtNode(nodeIndex);
 }
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -807,6 +811,7 @@ unsigned MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::DivideElement(
         // Re-build edges when division is performed
         this->mElements[new_element_index]->RebuildEdges();
         pElement->RebuildEdges();
+        this->InvalidateElementGeometry();
         return new_element_index;
     }
     else
@@ -925,6 +930,7 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::DivideEdge(Node<SPACE_DIM>* pNod
         // Add new node to this element
         this->GetElement(*iter)->AddNode(p_new_node, index);
     }
+    this->InvalidateElementGeometry();
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -1007,26 +1013,68 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh([[maybe_unused]] VertexEl
         // Make sure the map is big enough
         rElementMap.Resize(this->GetNumAllElements());
 
+        // Element geometry changes with every swap, so bypass any cached geometry until remeshing is complete
+        bool use_element_geometry_cache = this->GetUseElementGeometryCache();
+        this->SetUseElementGeometryCache(false);
+
         /*
          * To begin the remeshing process, we do not need to call Clear() and remove all current data,
          * since cell birth, rearrangement and death result only in local remeshing of a vertex-based
          * mesh. Instead, we just remove any deleted elements and nodes.
          */
         RemoveDeletedNodesAndElements(rElementMap);
-        bool recheck_mesh = true;
-        while (recheck_mesh == true)
+
+        /*
+         * After each swap, only the elements and nodes near that swap need to be checked again, so
+         * rather than rescanning the whole mesh we keep worklists of candidates, which initially
+         * contain every element and node respectively.
+         */
+        mUseSwapWorklists = true;
+        try
         {
-            // We check for any short edges and perform swaps if necessary and possible.
-            recheck_mesh = CheckForSwapsFromShortEdges();
-        }
+            mShortEdgeWorklist.clear();
+            for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
+                 elem_iter != this->GetElementIteratorEnd();
+                 ++elem_iter)
+            {
+                mShortEdgeWorklist.insert(mShortEdgeWorklist.end(), elem_iter->GetIndex());
+            }
+
+            bool recheck_mesh = true;
+            while (recheck_mesh == true)
+            {
+                // We check for any short edges and perform swaps if necessary and possible.
+                recheck_mesh = CheckForSwapsFromShortEdges();
+            }
 
-        // Check for element intersections
-        recheck_mesh = true;
-        while (recheck_mesh == true)
+            mIntersectionWorklist.clear();
+            mBoundaryElementGridIsCurrent = false;
+            for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->GetNodeIteratorBegin();
+                 node_iter != this->GetNodeIteratorEnd();
+                 ++node_iter)
+            {
+                mIntersectionWorklist.insert(mIntersectionWorklist.end(), node_iter->GetIndex());
+            }
+
+            // Check for element intersections
+            recheck_mesh = true;
+            while (recheck_mesh == true)
+            {
+                // Check mesh for intersections, and perform T3 swaps where required
+                recheck_mesh = CheckForIntersections();
+            }
+        }
+        catch (Exception&)
         {
-            // Check mesh for intersections, and perform T3 swaps where required
-            recheck_mesh = CheckForIntersections();
+            mUseSwapWorklists = false;
+            mShortEdgeWorklist.clear();
+            mIntersectionWorklist.clear();
+            mBoundaryElementGridIsCurrent = false;
+            this->SetUseElementGeometryCache(use_element_geometry_cache);
+            throw;
         }
+        mUseSwapWorklists = false;
+        mBoundaryElementGridIsCurrent = false;
 
         RemoveDeletedNodes();
 
@@ -1035,6 +1083,8 @@ void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::ReMesh([[maybe_unused]] VertexEl
          * (see #2664).
          */
         this->CheckForRosettes();
+
+        this->SetUseElementGeometryCache(use_element_geometry_cache);
     }
     else if constexpr (ELEMENT_DIM == 3 && SPACE_DIM == 3)
     {
@@ -1059,6 +1109,49 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForSwapsFromShortEdges()
 {
     if constexpr (ELEMENT_DIM == 2 && SPACE_DIM == 2)
     {
+        Node<SPACE_DIM>* p_node_a = nullptr;
+        Node<SPACE_DIM>* p_node_b = nullptr;
+
+        if (mUseSwapWorklists)
+        {
+            // Examine the candidate elements in order of index, as the loop below would
+            while (!mShortEdgeWorklist.empty())
+            {
+                VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = this->mElements[*(mShortEdgeWorklist.begin())];
+
+                if (!p_element->IsDeleted() && FindShortEdgeRequiringSwap(*p_element, p_node_a, p_node_b))
+                {
+                    // Note the nodes of the elements affected by the swap before performing it...
+                    std::set<unsigned> swap_node_indices;
+                    swap_node_indices.insert(p_node_a->GetIndex());
+                    swap_node_indices.insert(p_node_b->GetIndex());
+                    std::set<unsigned> affected_node_indices = GetNodesWithinElementRings(swap_node_indices, 1);
+
+                    IdentifySwapType(p_node_a, p_node_b);
+
+                    /*
+                     * ...then recheck every element containing a node of an element that contains one
+                     * of these nodes, as the swap can only change the edge lengths and neighbouring
+                     * triangular elements of such elements
+                     */
+                    std::set<unsigned> recheck_node_indices = GetNodesWithinElementRings(affected_node_indices, 1);
+                    for (std::set<unsigned>::iterator it = recheck_node_indices.begin();
+                         it != recheck_node_indices.end();
+                         ++it)
+                    {
+                        const std::set<unsigned>& r_containing_elements = this->mNodes[*it]->rGetContainingElementIndices();
+                        mShortEdgeWorklist.insert(r_containing_elements.begin(), r_containing_elements.end());
+                    }
+                    return true;
+                }
+
+                // This element is now known not to require a swap
+                mShortEdgeWorklist.erase(mShortEdgeWorklist.begin());
+            }
+
+            return false;
+        }
+
         // Loop over elements to check for T1 swaps
         for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
              elem_iter != this->GetElementIteratorEnd();
@@ -1066,60 +1159,112 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForSwapsFromShortEdges()
         {
             ///\todo Could we search more efficiently by just iterating over edges? (see #2401)
 
-            unsigned num_nodes = elem_iter->GetNumNodes();
-            assert(num_nodes > 0);
-
-            // Loop over the nodes contained in this element
-            for (unsigned local_index = 0; local_index < num_nodes; local_index++)
+            // If any short edge is found, then perform the required type of swap and halt the search, returning true
+            if (FindShortEdgeRequiringSwap(*elem_iter, p_node_a, p_node_b))
             {
-                // Find locations of the current node and anticlockwise node
-                Node<SPACE_DIM>* p_current_node = elem_iter->GetNode(local_index);
-                unsigned local_index_plus_one = (local_index + 1) % num_nodes; ///\todo Use iterators to tidy this up (see #2401)
-                Node<SPACE_DIM>* p_anticlockwise_node = elem_iter->GetNode(local_index_plus_one);
+                IdentifySwapType(p_node_a, p_node_b);
+                return true;
+            }
+        }
 
-                // Find distance between nodes
-                double distance_between_nodes = this->GetDistanceBetweenNodes(p_current_node->GetIndex(), p_anticlockwise_node->GetIndex());
+        return false;
+    }
+    else
+    {
+        NEVER_REACHED;
+    }
+}
 
-                // If the nodes are too close together...
-                if (distance_between_nodes < mCellRearrangementThreshold)
-                {
-                    // ...then check if any triangular elements are shared by these nodes...
-                    std::set<unsigned> elements_of_node_a = p_current_node->rGetContainingElementIndices();
-                    std::set<unsigned> elements_of_node_b = p_anticlockwise_node->rGetContainingElementIndices();
-
-                    std::set<unsigned> shared_elements;
-                    std::set_intersection(elements_of_node_a.begin(), elements_of_node_a.end(),
-                                          elements_of_node_b.begin(), elements_of_node_b.end(),
-                                          std::inserter(shared_elements, shared_elements.begin()));
-
-                    bool both_nodes_share_triangular_element = false;
-                    for (std::set<unsigned>::const_iterator it = shared_elements.begin();
-                         it != shared_elements.end();
-                         ++it)
-                    {
-                        if (this->GetElement(*it)->GetNumNodes() <= 3)
-                        {
-                            both_nodes_share_triangular_element = true;
-                            break;
-                        }
-                    }
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::FindShortEdgeRequiringSwap(VertexElement<ELEMENT_DIM, SPACE_DIM>& rElement,
+                                                                           Node<SPACE_DIM>*& rpNodeA,
+                                                                           Node<SPACE_DIM>*& rpNodeB)
+{
+    unsigned num_nodes = rElement.GetNumNodes();
+    assert(num_nodes > 0);
 
-                    // ...and if none are, then perform the required type of swap and halt the search, returning true
-                    if (!both_nodes_share_triangular_element)
-                    {
-                        IdentifySwapType(p_current_node, p_anticlockwise_node);
-                        return true;
-                    }
+    // Loop over the nodes contained in this element
+    for (unsigned local_index = 0; local_index < num_nodes; local_index++)
+    {
+        // Find locations of the current node and anticlockwise node
+        Node<SPACE_DIM>* p_current_node = rElement.GetNode(local_index);
+        unsigned local_index_plus_one = (local_index + 1) % num_nodes; ///\todo Use iterators to tidy this up (see #2401)
+        Node<SPACE_DIM>* p_anticlockwise_node = rElement.GetNode(local_index_plus_one);
+
+        // Find distance between nodes
+        double distance_between_nodes = this->GetDistanceBetweenNodes(p_current_node->GetIndex(), p_anticlockwise_node->GetIndex());
+
+        // If the nodes are too close together...
+        if (distance_between_nodes < mCellRearrangementThreshold)
+        {
+            // ...then check if any triangular elements are shared by these nodes...
+            const std::set<unsigned>& elements_of_node_a = p_current_node->rGetContainingElementIndices();
+            const std::set<unsigned>& elements_of_node_b = p_anticlockwise_node->rGetContainingElementIndices();
+
+            std::set<unsigned> shared_elements;
+            std::set_intersection(elements_of_node_a.begin(), elements_of_node_a.end(),
+                                  elements_of_node_b.begin(), elements_of_node_b.end(),
+                                  std::inserter(shared_elements, shared_elements.begin()));
+
+            bool both_nodes_share_triangular_element = false;
+            for (std::set<unsigned>::const_iterator it = shared_elements.begin();
+                 it != shared_elements.end();
+                 ++it)
+            {
+                if (this->GetElement(*it)->GetNumNodes() <= 3)
+                {
+                    both_nodes_share_triangular_element = true;
+                    break;
                 }
             }
+
+            // ...and if none are, then this pair of nodes requires a swap
+            if (!both_nodes_share_triangular_element)
+            {
+                rpNodeA = p_current_node;
+                rpNodeB = p_anticlockwise_node;
+                return true;
+            }
         }
+    }
 
-        return false;
+    return false;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::set<unsigned> MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::GetNodesWithinElementRings(const std::set<unsigned>& rNodeIndices, unsigned numRings)
+{
+    std::set<unsigned> node_indices;
+    for (std::set<unsigned>::const_iterator it = rNodeIndices.begin(); it != rNodeIndices.end(); ++it)
+    {
+        if (!this->mNodes[*it]->IsDeleted())
+        {
+            node_indices.insert(*it);
+        }
     }
-    else
+
+    for (unsigned ring = 0; ring < numRings; ring++)
     {
-        NEVER_REACHED;
+        // Find the elements containing the current set of nodes...
+        std::set<unsigned> element_indices;
+        for (std::set<unsigned>::iterator it = node_indices.begin(); it != node_indices.end(); ++it)
+        {
+            const std::set<unsigned>& r_containing_elements = this->mNodes[*it]->rGetContainingElementIndices();
+            element_indices.insert(r_containing_elements.begin(), r_containing_elements.end());
+        }
+
+        // ...and add their nodes
+        for (std::set<unsigned>::iterator it = element_indices.begin(); it != element_indices.end(); ++it)
+        {
+            VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = this->mElements[*it];
+            for (unsigned local_index = 0; local_index < p_element->GetNumNodes(); local_index++)
+            {
+                node_indices.insert(p_element->GetNodeGlobalIndex(local_index));
+            }
+        }
     }
+
+    return node_indices;
 }
 
 template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -1138,6 +1283,7 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForT2Swaps(VertexElementMap
             {
                 // ...then perform a T2 swap and break out of the loop
                 PerformT2Swap(*elem_iter);
+                this->InvalidateElementGeometry();
                 ///\todo: cover this line in a test
                 rElementMap.SetDeleted(elem_iter->GetIndex());
                 return true;
@@ -1155,66 +1301,42 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
         // If checking for internal intersections, then check that no nodes have overlapped any elements...
         if (mCheckForInternalIntersections)
         {
-            // First neighbours are elements that contain the node.  Second
-            // neighbours are elements that share a cell-cell boundary with first
-            // neighbours, but do not contain the node.  Nodes can only intersect
-            // second neighbours.
-            for (auto node_iter = this->GetNodeIteratorBegin();
-                 node_iter != this->GetNodeIteratorEnd();
-                 ++node_iter)
-            {
-                assert(!(node_iter->IsDeleted()));
-
-                // Get all nodes of first neighbours
-                std::set<unsigned> first_neighbour_node_indices;
-
-                auto first_neighbour_indices = node_iter->rGetContainingElementIndices();
+            unsigned elem_index = UINT_MAX;
 
-                for (auto elem_iter = first_neighbour_indices.begin();
-                     elem_iter != first_neighbour_indices.end();
-                     ++elem_iter)
+            if (mUseSwapWorklists)
+            {
+                // Examine the candidate nodes in order of index, as the loop below would
+                while (!mIntersectionWorklist.empty())
                 {
-                    auto p_element = this->GetElement(*elem_iter);
+                    Node<SPACE_DIM>* p_node = this->mNodes[*(mIntersectionWorklist.begin())];
 
-                    for (auto local_node_index = 0u;
-                         local_node_index < p_element->GetNumNodes();
-                         ++local_node_index)
+                    if (!p_node->IsDeleted() && FindElementIntersectedByNode(*p_node, elem_index))
                     {
-                        first_neighbour_node_indices.insert(p_element->GetNodeGlobalIndex(local_node_index));
-                    }
-                }
+                        // Note the nodes of the elements affected by the swap before performing it...
+                        std::set<unsigned> affected_node_indices = GetNodesNearNodeAndElement(p_node, elem_index);
 
-                // Get all first and second neighbours
-                std::set<unsigned> all_neighbours;
+                        PerformIntersectionSwap(p_node, elem_index);
 
-                for (auto second_node_iter = first_neighbour_node_indices.begin();
-                     second_node_iter != first_neighbour_node_indices.end();
-                     ++second_node_iter)
-                {
-                    auto containing_element_indices = this->GetNode(*second_node_iter)->rGetContainingElementIndices();
-                    all_neighbours.insert(containing_element_indices.begin(),
-                                          containing_element_indices.end());
-                }
+                        // ...then recheck every node that may have one of these elements as a first or second neighbour
+                        std::set<unsigned> recheck_node_indices = GetNodesWithinElementRings(affected_node_indices, 2);
+                        mIntersectionWorklist.insert(recheck_node_indices.begin(), recheck_node_indices.end());
+                        UpdateBoundaryElementGridNearNodes(affected_node_indices);
+                        return true;
+                    }
 
-                // Second neighbours are the difference between all neighbours and
-                // first neighbours
-                std::set<unsigned> second_neighbour_indices;
-                std::set_difference(
-                    all_neighbours.begin(), all_neighbours.end(),
-                    first_neighbour_indices.begin(), first_neighbour_indices.end(),
-                    std::inserter(second_neighbour_indices, second_neighbour_indices.begin()));
-
-                // Loop over second neighbours only
-                for (auto elem_iter = second_neighbour_indices.begin();
-                     elem_iter != second_neighbour_indices.end();
-                     ++elem_iter)
+                    // This node is now known not to overlap any element
+                    mIntersectionWorklist.erase(mIntersectionWorklist.begin());
+                }
+            }
+            else
+            {
+                for (auto node_iter = this->GetNodeIteratorBegin();
+                     node_iter != this->GetNodeIteratorEnd();
+                     ++node_iter)
                 {
-                    unsigned elem_index = *elem_iter;
-
-                    // Node should not be part of this element
-                    assert(node_iter->rGetContainingElementIndices().count(elem_index) == 0);
+                    assert(!(node_iter->IsDeleted()));
 
-                    if (this->ElementIncludesPoint(node_iter->rGetLocation(), elem_index))
+                    if (FindElementIntersectedByNode(*node_iter, elem_index))
                     {
                         PerformIntersectionSwap(&(*node_iter), elem_index);
                         return true;
@@ -1225,25 +1347,17 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
 
         if (mCheckForT3Swaps)
         {
-            // If checking for T3 swaps, check that no boundary nodes have overlapped any boundary elements
-            // First: find all boundary element and calculate their centroid only once
-            std::vector<unsigned> boundary_element_indices;
-            std::vector<c_vector<double, SPACE_DIM> > boundary_element_centroids;
-            for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
-                 elem_iter != this->GetElementIteratorEnd();
-                 ++elem_iter)
+            /*
+             * If checking for T3 swaps, check that no boundary nodes have overlapped any boundary elements.
+             * Only elements whose centroids lie within mDistanceForT3SwapChecking of a node are checked;
+             * these are found from a grid of the boundary element centroids, which during ReMesh() is
+             * built once and then updated after each swap, and is otherwise rebuilt here.
+             */
+            if (!mUseSwapWorklists || !mBoundaryElementGridIsCurrent)
             {
-                if (elem_iter->IsElementOnBoundary())
-                {
-                    unsigned element_index = elem_iter->GetIndex();
-                    boundary_element_indices.push_back(element_index);
-                    // should be a map but I am too lazy to look up the syntax
-                    boundary_element_centroids.push_back(this->GetCentroidOfElement(element_index));
-                }
+                BuildBoundaryElementGrid();
             }
 
-            // Second: Check intersections only for those nodes and elements within
-            // mDistanceForT3SwapChecking within each other (node<-->element centroid)
             for (typename AbstractMesh<ELEMENT_DIM, SPACE_DIM>::NodeIterator node_iter = this->GetNodeIteratorBegin();
                  node_iter != this->GetNodeIteratorEnd();
                  ++node_iter)
@@ -1252,30 +1366,40 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
                 {
                     assert(!(node_iter->IsDeleted()));
 
-                    // index in boundary_element_centroids and boundary_element_indices
-                    unsigned boundary_element_index = 0;
-                    for (std::vector<unsigned>::iterator elem_iter = boundary_element_indices.begin();
-                         elem_iter != boundary_element_indices.end();
+                    // Examine the nearby boundary elements in order of index
+                    c_vector<double, SPACE_DIM> node_location = node_iter->rGetLocation();
+                    std::set<unsigned> nearby_element_indices = GetBoundaryElementsNearLocation(node_location);
+                    for (std::set<unsigned>::iterator elem_iter = nearby_element_indices.begin();
+                         elem_iter != nearby_element_indices.end();
                          ++elem_iter)
                     {
                         // Check that the node is not part of this element
                         if (node_iter->rGetContainingElementIndices().count(*elem_iter) == 0)
                         {
-                            c_vector<double, SPACE_DIM> node_location = node_iter->rGetLocation();
-                            c_vector<double, SPACE_DIM> element_centroid = boundary_element_centroids[boundary_element_index];
+                            c_vector<double, SPACE_DIM> element_centroid = mBoundaryElementCentroids[*elem_iter];
                             double node_element_distance = norm_2(this->GetVectorFromAtoB(node_location, element_centroid));
 
                             if (node_element_distance < mDistanceForT3SwapChecking)
                             {
                                 if (this->ElementIncludesPoint(node_iter->rGetLocation(), *elem_iter))
                                 {
-                                    this->PerformT3Swap(&(*node_iter), *elem_iter);
+                                    if (mUseSwapWorklists)
+                                    {
+                                        // As for intersection swaps, recheck the nodes near the swap for internal intersections
+                                        std::set<unsigned> affected_node_indices = GetNodesNearNodeAndElement(&(*node_iter), *elem_iter);
+                                        this->PerformT3Swap(&(*node_iter), *elem_iter);
+                                        std::set<unsigned> recheck_node_indices = GetNodesWithinElementRings(affected_node_indices, 2);
+                                        mIntersectionWorklist.insert(recheck_node_indices.begin(), recheck_node_indices.end());
+                                        UpdateBoundaryElementGridNearNodes(affected_node_indices);
+                                    }
+                                    else
+                                    {
+                                        this->PerformT3Swap(&(*node_iter), *elem_iter);
+                                    }
                                     return true;
                                 }
                             }
                         }
-                        // increment the boundary element index
-                        boundary_element_index += 1u;
                     }
                 }
             }
@@ -1288,6 +1412,215 @@ bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::CheckForIntersections()
     }
 }
 
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::FindElementIntersectedByNode(Node<SPACE_DIM>& rNode, unsigned& rElementIndex)
+{
+    // First neighbours are elements that contain the node.  Second
+    // neighbours are elements that share a cell-cell boundary with first
+    // neighbours, but do not contain the node.  Nodes can only intersect
+    // second neighbours.
+
+    // Get all nodes of first neighbours
+    std::set<unsigned> first_neighbour_node_indices;
+
+    const std::set<unsigned>& first_neighbour_indices = rNode.rGetContainingElementIndices();
+
+    for (auto elem_iter = first_neighbour_indices.begin();
+         elem_iter != first_neighbour_indices.end();
+         ++elem_iter)
+    {
+        auto p_element = this->GetElement(*elem_iter);
+
+        for (auto local_node_index = 0u;
+             local_node_index < p_element->GetNumNodes();
+             ++local_node_index)
+        {
+            first_neighbour_node_indices.insert(p_element->GetNodeGlobalIndex(local_node_index));
+        }
+    }
+
+    // Get all first and second neighbours
+    std::set<unsigned> all_neighbours;
+
+    for (auto second_node_iter = first_neighbour_node_indices.begin();
+         second_node_iter != first_neighbour_node_indices.end();
+         ++second_node_iter)
+    {
+        const std::set<unsigned>& containing_element_indices = this->GetNode(*second_node_iter)->rGetContainingElementIndices();
+        all_neighbours.insert(containing_element_indices.begin(),
+                              containing_element_indices.end());
+    }
+
+    // Second neighbours are the difference between all neighbours and
+    // first neighbours
+    std::set<unsigned> second_neighbour_indices;
+    std::set_difference(
+        all_neighbours.begin(), all_neighbours.end(),
+        first_neighbour_indices.begin(), first_neighbour_indices.end(),
+        std::inserter(second_neighbour_indices, second_neighbour_indices.begin()));
+
+    // Loop over second neighbours only
+    for (auto elem_iter = second_neighbour_indices.begin();
+         elem_iter != second_neighbour_indices.end();
+         ++elem_iter)
+    {
+        unsigned elem_index = *elem_iter;
+
+        // Node should not be part of this element
+        assert(rNode.rGetContainingElementIndices().count(elem_index) == 0);
+
+        if (this->ElementIncludesPoint(rNode.rGetLocation(), elem_index))
+        {
+            rElementIndex = elem_index;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::set<unsigned> MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::GetNodesNearNodeAndElement(Node<SPACE_DIM>* pNode, unsigned elementIndex)
+{
+    std::set<unsigned> node_indices;
+    node_indices.insert(pNode->GetIndex());
+
+    VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = this->GetElement(elementIndex);
+    for (unsigned local_index = 0; local_index < p_element->GetNumNodes(); local_index++)
+    {
+        node_indices.insert(p_element->GetNodeGlobalIndex(local_index));
+    }
+
+    return GetNodesWithinElementRings(node_indices, 1);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::BuildBoundaryElementGrid()
+{
+    mBoundaryElementGrid.clear();
+    mBoundaryElementCentroids.clear();
+
+    /*
+     * Use bins at least mDistanceForT3SwapChecking wide that exactly tile the width of the
+     * mesh, so that wrapping bin indices around is correct for periodic meshes (whose
+     * GetWidth() returns the period) and harmless otherwise. The number of bins is capped
+     * to keep bin indices within range.
+     */
+    for (unsigned dim = 0; dim < SPACE_DIM; dim++)
+    {
+        double width = this->GetWidth(dim);
+        double num_bins = std::min(std::floor(width/mDistanceForT3SwapChecking), 1000.0);
+        mBoundaryElementGridSize[dim] = (num_bins < 1.0) ? 1u : unsigned(num_bins);
+        mBoundaryElementGridSpacing[dim] = (width > 0.0) ? width/mBoundaryElementGridSize[dim] : mDistanceForT3SwapChecking;
+    }
+
+    for (typename VertexMesh<ELEMENT_DIM, SPACE_DIM>::VertexElementIterator elem_iter = this->GetElementIteratorBegin();
+         elem_iter != this->GetElementIteratorEnd();
+         ++elem_iter)
+    {
+        if (elem_iter->IsElementOnBoundary())
+        {
+            UpdateBoundaryElementGrid(elem_iter->GetIndex());
+        }
+    }
+    mBoundaryElementGridIsCurrent = true;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::UpdateBoundaryElementGrid(unsigned elementIndex)
+{
+    c_vector<int, SPACE_DIM> no_offset = zero_vector<int>(SPACE_DIM);
+
+    typename std::map<unsigned, c_vector<double, SPACE_DIM> >::iterator centroid_iter = mBoundaryElementCentroids.find(elementIndex);
+    if (centroid_iter != mBoundaryElementCentroids.end())
+    {
+        unsigned bin = GetBoundaryElementGridBin(centroid_iter->second, no_offset);
+        mBoundaryElementGrid[bin].erase(elementIndex);
+        if (mBoundaryElementGrid[bin].empty())
+        {
+            mBoundaryElementGrid.erase(bin);
+        }
+        mBoundaryElementCentroids.erase(centroid_iter);
+    }
+
+    VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = this->mElements[elementIndex];
+    if (!p_element->IsDeleted() && p_element->IsElementOnBoundary())
+    {
+        c_vector<double, SPACE_DIM> centroid = this->GetCentroidOfElement(elementIndex);
+        mBoundaryElementCentroids[elementIndex] = centroid;
+        mBoundaryElementGrid[GetBoundaryElementGridBin(centroid, no_offset)].insert(elementIndex);
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::UpdateBoundaryElementGridNearNodes(const std::set<unsigned>& rNodeIndices)
+{
+    if (mBoundaryElementGridIsCurrent)
+    {
+        // Nodes may have been added by the swap, but only to elements that contain one of these nodes
+        std::set<unsigned> element_indices;
+        for (std::set<unsigned>::const_iterator it = rNodeIndices.begin(); it != rNodeIndices.end(); ++it)
+        {
+            if (!this->mNodes[*it]->IsDeleted())
+            {
+                const std::set<unsigned>& r_containing_elements = this->mNodes[*it]->rGetContainingElementIndices();
+                element_indices.insert(r_containing_elements.begin(), r_containing_elements.end());
+            }
+        }
+
+        for (std::set<unsigned>::iterator it = element_indices.begin(); it != element_indices.end(); ++it)
+        {
+            UpdateBoundaryElementGrid(*it);
+        }
+    }
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::GetBoundaryElementGridBin(const c_vector<double, SPACE_DIM>& rLocation,
+                                                                              const c_vector<int, SPACE_DIM>& rOffset)
+{
+    unsigned bin = 0;
+    for (unsigned dim = 0; dim < SPACE_DIM; dim++)
+    {
+        long num_bins = mBoundaryElementGridSize[dim];
+        long bin_in_dim = long(std::floor(rLocation[dim]/mBoundaryElementGridSpacing[dim])) + rOffset[dim];
+        bin_in_dim = ((bin_in_dim % num_bins) + num_bins) % num_bins;
+        bin = bin*mBoundaryElementGridSize[dim] + unsigned(bin_in_dim);
+    }
+    return bin;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+std::set<unsigned> MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::GetBoundaryElementsNearLocation(const c_vector<double, SPACE_DIM>& rLocation)
+{
+    std::set<unsigned> element_indices;
+
+    // Loop over the 3^SPACE_DIM bins with offset -1, 0 or 1 in each dimension
+    unsigned num_neighbouring_bins = 1;
+    for (unsigned dim = 0; dim < SPACE_DIM; dim++)
+    {
+        num_neighbouring_bins *= 3;
+    }
+    for (unsigned neighbour = 0; neighbour < num_neighbouring_bins; neighbour++)
+    {
+        c_vector<int, SPACE_DIM> offset;
+        unsigned remainder = neighbour;
+        for (unsigned dim = 0; dim < SPACE_DIM; dim++)
+        {
+            offset[dim] = int(remainder%3) - 1;
+            remainder /= 3;
+        }
+
+        std::map<unsigned, std::set<unsigned> >::iterator bin_iter = mBoundaryElementGrid.find(GetBoundaryElementGridBin(rLocation, offset));
+        if (bin_iter != mBoundaryElementGrid.end())
+        {
+            element_indices.insert(bin_iter->second.begin(), bin_iter->second.end());
+        }
+    }
+
+    return element_indices;
+}
+
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 void MutableVertexMesh<ELEMENT_DIM, SPACE_DIM>::IdentifySwapType(
     [[maybe_unused]] Node<SPACE_DIM>* pNodeA, [[maybe_unused]] Node<SPACE_DIM>* pNodeB)
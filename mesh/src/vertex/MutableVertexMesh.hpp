@@ -131,6 +131,52 @@ protected:
      */
     std::vector< c_vector<double, SPACE_DIM> > mLocationsOfIntersectionSwaps;
 
+    /**
+     * Whether CheckForSwapsFromShortEdges() and CheckForIntersections() only examine the
+     * elements and nodes in mShortEdgeWorklist and mIntersectionWorklist, rather than the
+     * whole mesh. This is only true during ReMesh().
+     */
+    bool mUseSwapWorklists = false;
+
+    /**
+     * The indices of the elements that may contain a short edge requiring a swap. Any element
+     * not in this set is known not to. Used by CheckForSwapsFromShortEdges() during ReMesh().
+     */
+    std::set<unsigned> mShortEdgeWorklist;
+
+    /**
+     * The indices of the nodes that may overlap an element not containing them. Any node not
+     * in this set is known not to. Used by CheckForIntersections() during ReMesh().
+     */
+    std::set<unsigned> mIntersectionWorklist;
+
+    /**
+     * Whether mBoundaryElementGrid is up to date with the boundary elements of the mesh. It is
+     * only kept up to date between passes of CheckForIntersections() during ReMesh(), and is
+     * otherwise rebuilt on each call.
+     */
+    bool mBoundaryElementGridIsCurrent = false;
+
+    /**
+     * The number of bins in each dimension of mBoundaryElementGrid. The bins are at least
+     * mDistanceForT3SwapChecking wide, and exactly tile GetWidth() in each dimension, so
+     * the grid wraps around correctly for periodic meshes.
+     */
+    c_vector<unsigned, SPACE_DIM> mBoundaryElementGridSize;
+
+    /** The width of the bins in each dimension of mBoundaryElementGrid. */
+    c_vector<double, SPACE_DIM> mBoundaryElementGridSpacing;
+
+    /**
+     * A uniform grid of the boundary elements, binned by centroid, used to find the boundary
+     * elements near a boundary node when checking for T3 swaps. Maps the index of each
+     * non-empty bin to the global indices of the elements in it.
+     */
+    std::map<unsigned, std::set<unsigned> > mBoundaryElementGrid;
+
+    /** The centroid of each boundary element in mBoundaryElementGrid, keyed by global index. */
+    std::map<unsigned, c_vector<double, SPACE_DIM> > mBoundaryElementCentroids;
+
     /**
      * Divide an element along the axis passing through two of its nodes.
      *
@@ -161,6 +207,116 @@ protected:
      */
     virtual bool CheckForSwapsFromShortEdges();
 
+    /**
+     * Helper method for CheckForSwapsFromShortEdges().
+     *
+     * Find the first pair of neighbouring nodes in an element that are closer than the
+     * mCellRearrangementThreshold and are not both contained in any triangular element.
+     *
+     * @param rElement the element
+     * @param rpNodeA set to the first node of the pair, if found
+     * @param rpNodeB set to the other (anticlockwise) node of the pair, if found
+     *
+     * @return whether such a pair of nodes was found.
+     */
+    bool FindShortEdgeRequiringSwap(VertexElement<ELEMENT_DIM, SPACE_DIM>& rElement,
+                                    Node<SPACE_DIM>*& rpNodeA,
+                                    Node<SPACE_DIM>*& rpNodeB);
+
+    /**
+     * Helper method for CheckForIntersections().
+     *
+     * Find the first element (in order of index) that does not contain a given node, but
+     * shares a cell-cell boundary with an element that does, and includes the node's location.
+     *
+     * @param rNode the node
+     * @param rElementIndex set to the global index of the element, if found
+     *
+     * @return whether such an element was found.
+     */
+    bool FindElementIntersectedByNode(Node<SPACE_DIM>& rNode, unsigned& rElementIndex);
+
+    /**
+     * Helper method for the swap worklists used in ReMesh().
+     *
+     * Grow a set of nodes by repeatedly adding all nodes of the elements that contain
+     * any of them. Deleted nodes are ignored.
+     *
+     * @param rNodeIndices the global indices of the nodes to start from
+     * @param numRings the number of times to grow the set
+     *
+     * @return the global indices of the nodes in the grown set.
+     */
+    std::set<unsigned> GetNodesWithinElementRings(const std::set<unsigned>& rNodeIndices, unsigned numRings);
+
+    /**
+     * Helper method for the swap worklists used in ReMesh().
+     *
+     * Find the nodes of every element that contains a given node or one of the nodes
+     * of a given element, i.e. the nodes whose elements may be changed by an intersection
+     * swap or T3 swap involving this node and element.
+     *
+     * @param pNode pointer to the node
+     * @param elementIndex global index of the element in the mesh
+     *
+     * @return the global indices of these nodes.
+     */
+    std::set<unsigned> GetNodesNearNodeAndElement(Node<SPACE_DIM>* pNode, unsigned elementIndex);
+
+    /**
+     * Helper method for CheckForIntersections().
+     *
+     * Bin the centroid of every boundary element into mBoundaryElementGrid.
+     */
+    void BuildBoundaryElementGrid();
+
+    /**
+     * Helper method for CheckForIntersections().
+     *
+     * Bring the entry for a given element in mBoundaryElementGrid up to date, after its nodes
+     * have moved or changed: the element is removed from the grid, then re-binned if it is
+     * still a boundary element.
+     *
+     * @param elementIndex global index of the element in the mesh
+     */
+    void UpdateBoundaryElementGrid(unsigned elementIndex);
+
+    /**
+     * Helper method for the swap worklists used in ReMesh().
+     *
+     * If mBoundaryElementGrid is current, update the entries of every element containing
+     * any of a given set of nodes, after a swap involving these nodes.
+     *
+     * @param rNodeIndices the global indices of the nodes
+     */
+    void UpdateBoundaryElementGridNearNodes(const std::set<unsigned>& rNodeIndices);
+
+    /**
+     * Helper method for CheckForIntersections().
+     *
+     * Compute the bin of mBoundaryElementGrid containing a given location, or a neighbour of that bin.
+     *
+     * @param rLocation the location
+     * @param rOffset the offset (in each dimension, -1, 0 or 1) of the neighbouring bin
+     *
+     * @return the index of the bin.
+     */
+    unsigned GetBoundaryElementGridBin(const c_vector<double, SPACE_DIM>& rLocation,
+                                       const c_vector<int, SPACE_DIM>& rOffset);
+
+    /**
+     * Helper method for CheckForIntersections().
+     *
+     * Find the boundary elements in mBoundaryElementGrid whose centroids lie in the same or a
+     * neighbouring bin to a given location. This includes every boundary element whose centroid
+     * is within mDistanceForT3SwapChecking of the location.
+     *
+     * @param rLocation the location
+     *
+     * @return the global indices of these elements, in increasing order.
+     */
+    std::set<unsigned> GetBoundaryElementsNearLocation(const c_vector<double, SPACE_DIM>& rLocation);
+
     /**
      * Helper method for ReMesh().
      *
@@ -686,6 +842,12 @@ public:
      * This method calls several other methods, in particular CheckForT2Swaps(), CheckForSwapsFromShortEdges()
      * and CheckForIntersections().
      *
+     * CheckForSwapsFromShortEdges() and CheckForIntersections() perform at most one swap per call and are
+     * called until they return false. To avoid rescanning the whole mesh after every swap, during
+     * ReMesh() they only re-examine the elements and nodes near the previous swap, through
+     * mShortEdgeWorklist and mIntersectionWorklist; the swaps performed, and their order, are the
+     * same as if the whole mesh were rescanned each time.
+     *
      * @param rElementMap a VertexElementMap which associates the indices of VertexElements in the old mesh
      *                   with indices of VertexElements in the new mesh.  This should be created
      *                   with the correct size, GetNumElements()
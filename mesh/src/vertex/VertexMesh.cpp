@@ -334,6 +334,11 @@ VertexMesh<2, 2>::VertexMesh(TetrahedralMesh<2, 2>& rMesh, bool isPeriodic, bool
         mElements[elem_index] = p_new_element;
     }
 
+    if (!isBounded)
+    {
+        RecordDelaunayElementNodeIndices();
+    }
+
     this->mMeshChangesDuringSimulation = false;
 }
 /**
@@ -488,6 +493,8 @@ VertexMesh<3, 3>::VertexMesh(TetrahedralMesh<3, 3>& rMesh)
         elem_count++;
     }
 
+    RecordDelaunayElementNodeIndices();
+
     this->mMeshChangesDuringSimulation = false;
 }
 /**
@@ -550,6 +557,128 @@ void VertexMesh<ELEMENT_DIM, SPACE_DIM>::GenerateVerticesFromElementCircumcentre
     }
 }
 
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexMesh<ELEMENT_DIM, SPACE_DIM>::RecordDelaunayElementNodeIndices()
+{
+    mDelaunayElementNodeIndices.clear();
+    mDelaunayElementNodeIndices.reserve((ELEMENT_DIM + 1) * mpDelaunayMesh->GetNumAllElements());
+    for (unsigned i = 0; i < mpDelaunayMesh->GetNumAllElements(); i++)
+    {
+        for (unsigned local_index = 0; local_index < ELEMENT_DIM + 1; local_index++)
+        {
+            mDelaunayElementNodeIndices.push_back(mpDelaunayMesh->GetElement(i)->GetNodeGlobalIndex(local_index));
+        }
+    }
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool VertexMesh<ELEMENT_DIM, SPACE_DIM>::UpdateVoronoiTessellation()
+{
+    // Only unbounded, non-periodic tessellations record the topology of their Delaunay mesh
+    if (mDelaunayElementNodeIndices.empty())
+    {
+        return false;
+    }
+
+    // The Delaunay mesh must have the same number of nodes and elements, with none deleted
+    unsigned num_delaunay_elements = mpDelaunayMesh->GetNumAllElements();
+    if (num_delaunay_elements != this->mNodes.size()
+        || mpDelaunayMesh->GetNumElements() != num_delaunay_elements
+        || mpDelaunayMesh->GetNumAllNodes() != mpDelaunayMesh->GetNumNodes()
+        || (ELEMENT_DIM + 1) * num_delaunay_elements != mDelaunayElementNodeIndices.size())
+    {
+        return false;
+    }
+    if (ELEMENT_DIM == 2 && mpDelaunayMesh->GetNumAllNodes() != mElements.size())
+    {
+        return false;
+    }
+
+    // Find the Delaunay nodes whose surrounding elements have changed
+    std::set<unsigned> changed_delaunay_nodes;
+    for (unsigned i = 0; i < num_delaunay_elements; i++)
+    {
+        Element<ELEMENT_DIM, SPACE_DIM>* p_element = mpDelaunayMesh->GetElement(i);
+        for (unsigned local_index = 0; local_index < ELEMENT_DIM + 1; local_index++)
+        {
+            unsigned old_node_index = mDelaunayElementNodeIndices[(ELEMENT_DIM + 1) * i + local_index];
+            unsigned new_node_index = p_element->GetNodeGlobalIndex(local_index);
+            if (old_node_index != new_node_index)
+            {
+                changed_delaunay_nodes.insert(old_node_index);
+                changed_delaunay_nodes.insert(new_node_index);
+            }
+        }
+    }
+
+    // In 3D the faces of the tessellation depend on the Delaunay edges, so any change requires a rebuild
+    if (ELEMENT_DIM != 2 && !changed_delaunay_nodes.empty())
+    {
+        return false;
+    }
+
+    // Move each vertex to the current circumcentre of its Delaunay element
+    c_matrix<double, SPACE_DIM, ELEMENT_DIM> jacobian;
+    c_matrix<double, ELEMENT_DIM, SPACE_DIM> inverse_jacobian;
+    double jacobian_det;
+    for (unsigned i = 0; i < num_delaunay_elements; i++)
+    {
+        mpDelaunayMesh->GetInverseJacobianForElement(i, jacobian, jacobian_det, inverse_jacobian);
+        c_vector<double, SPACE_DIM + 1> circumsphere = mpDelaunayMesh->GetElement(i)->CalculateCircumsphere(jacobian, inverse_jacobian);
+
+        c_vector<double, SPACE_DIM>& r_location = this->mNodes[i]->rGetModifiableLocation();
+        for (unsigned j = 0; j < SPACE_DIM; j++)
+        {
+            r_location(j) = circumsphere(j);
+        }
+    }
+
+    if constexpr (ELEMENT_DIM == 2 && SPACE_DIM == 2)
+    {
+        // Rebuild the Voronoi element of each Delaunay node whose surrounding elements have changed
+        for (std::set<unsigned>::iterator node_iter = changed_delaunay_nodes.begin();
+             node_iter != changed_delaunay_nodes.end();
+             ++node_iter)
+        {
+            unsigned elem_index = *node_iter;
+            VertexElement<2, 2>* p_old_element = mElements[elem_index];
+            for (unsigned local_index = 0; local_index < p_old_element->GetNumNodes(); local_index++)
+            {
+                p_old_element->GetNode(local_index)->RemoveElement(elem_index);
+            }
+
+            // Order the circumcentres of the surrounding Delaunay elements anticlockwise, as in the constructor
+            c_vector<double, 2> centre = mpDelaunayMesh->GetNode(elem_index)->rGetLocation();
+            const std::set<unsigned>& r_delaunay_elements = mpDelaunayMesh->GetNode(elem_index)->rGetContainingElementIndices();
+            std::vector<std::pair<double, unsigned> > index_angle_list;
+            for (std::set<unsigned>::const_iterator iter = r_delaunay_elements.begin();
+                 iter != r_delaunay_elements.end();
+                 ++iter)
+            {
+                c_vector<double, 2> centre_to_vertex = mpDelaunayMesh->GetVectorFromAtoB(centre, this->mNodes[*iter]->rGetLocation());
+                double angle = atan2(centre_to_vertex(1), centre_to_vertex(0));
+                index_angle_list.push_back(std::pair<double, unsigned>(angle, *iter));
+            }
+            sort(index_angle_list.begin(), index_angle_list.end());
+
+            VertexElement<2, 2>* p_new_element = new VertexElement<2, 2>(elem_index);
+            for (unsigned count = 0; count < index_angle_list.size(); count++)
+            {
+                unsigned local_index = count > 1 ? count - 1 : 0;
+                p_new_element->AddNode(this->mNodes[index_angle_list[count].second], local_index);
+            }
+
+            delete p_old_element;
+            mElements[elem_index] = p_new_element;
+        }
+    }
+
+    RecordDelaunayElementNodeIndices();
+    InvalidateElementGeometry();
+
+    return true;
+}
+
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 double VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetEdgeLength(unsigned elementIndex1, unsigned elementIndex2)
 {
@@ -738,6 +867,11 @@ void VertexMesh<ELEMENT_DIM, SPACE_DIM>::Clear()
         delete this->mNodes[i];
     }
     this->mNodes.clear();
+
+    // Discard any cached element geometry
+    mElementGeometryIsCurrent.clear();
+
+    mDelaunayElementNodeIndices.clear();
 }
 
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
@@ -758,6 +892,121 @@ unsigned VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetNumAllElements() const
     return mElements.size();
 }
 
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexMesh<ELEMENT_DIM, SPACE_DIM>::SetUseElementGeometryCache(bool useElementGeometryCache)
+{
+    mUseElementGeometryCache = useElementGeometryCache;
+    InvalidateElementGeometry();
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+bool VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetUseElementGeometryCache() const
+{
+    return mUseElementGeometryCache;
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexMesh<ELEMENT_DIM, SPACE_DIM>::InvalidateElementGeometry()
+{
+    mElementGeometryIsCurrent.assign(mElementGeometryIsCurrent.size(), false);
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexMesh<ELEMENT_DIM, SPACE_DIM>::RefreshMesh()
+{
+    InvalidateElementGeometry();
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexMesh<ELEMENT_DIM, SPACE_DIM>::InvalidateElementGeometryAtNode(unsigned nodeIndex)
+{
+    const std::set<unsigned>& r_containing_elements = this->mNodes[nodeIndex]->rGetContainingElementIndices();
+    for (std::set<unsigned>::const_iterator iter = r_containing_elements.begin();
+         iter != r_containing_elements.end();
+         ++iter)
+    {
+        if (*iter < mElementGeometryIsCurrent.size())
+        {
+            mElementGeometryIsCurrent[*iter] = false;
+        }
+    }
+}
+
+template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void VertexMesh<ELEMENT_DIM, SPACE_DIM>::UpdateElementGeometry(unsigned index)
+{
+    assert(SPACE_DIM == 2); // LCOV_EXCL_LINE - code will be removed at compile time
+
+    if (index >= mElementGeometryIsCurrent.size())
+    {
+        unsigned num_elements = std::max(index + 1, (unsigned)mElements.size());
+        mElementGeometryIsCurrent.resize(num_elements, false);
+        mCachedElementSignedAreas.resize(num_elements);
+        mCachedElementPerimeters.resize(num_elements);
+        mCachedElementCentroids.resize(num_elements);
+        mCachedElementEdgeVectors.resize(num_elements);
+        mCachedElementEdgeLengths.resize(num_elements);
+    }
+
+    if (!mElementGeometryIsCurrent[index])
+    {
+        VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = GetElement(index);
+        unsigned num_nodes = p_element->GetNumNodes();
+
+        std::vector<c_vector<double, SPACE_DIM> >& r_edge_vectors = mCachedElementEdgeVectors[index];
+        std::vector<double>& r_edge_lengths = mCachedElementEdgeLengths[index];
+        r_edge_vectors.resize(num_nodes);
+        r_edge_lengths.resize(num_nodes);
+
+        double centroid_x = 0.0;
+        double centroid_y = 0.0;
+        double signed_area = 0.0;
+        double perimeter = 0.0;
+
+        // As in GetVolumeOfElement(), map the first vertex to the origin and employ GetVectorFromAtoB() to allow for periodicity
+        c_vector<double, SPACE_DIM> first_node_location = p_element->GetNodeLocation(0);
+        c_vector<double, SPACE_DIM> this_node_location = first_node_location;
+        c_vector<double, SPACE_DIM> pos_1 = zero_vector<double>(SPACE_DIM);
+
+        for (unsigned local_index = 0; local_index < num_nodes; local_index++)
+        {
+            c_vector<double, SPACE_DIM> next_node_location = p_element->GetNodeLocation((local_index + 1) % num_nodes);
+            c_vector<double, SPACE_DIM> pos_2 = GetVectorFromAtoB(first_node_location, next_node_location);
+
+            double this_x = pos_1[0];
+            double this_y = pos_1[1];
+            double next_x = pos_2[0];
+            double next_y = pos_2[1];
+
+            double signed_area_term = this_x * next_y - this_y * next_x;
+
+            centroid_x += (this_x + next_x) * signed_area_term;
+            centroid_y += (this_y + next_y) * signed_area_term;
+            signed_area += 0.5 * signed_area_term;
+
+            r_edge_vectors[local_index] = GetVectorFromAtoB(this_node_location, next_node_location);
+            r_edge_lengths[local_index] = norm_2(r_edge_vectors[local_index]);
+            perimeter += r_edge_lengths[local_index];
+
+            pos_1 = pos_2;
+            this_node_location = next_node_location;
+        }
+
+        mCachedElementSignedAreas[index] = signed_area;
+        mCachedElementPerimeters[index] = perimeter;
+
+        // GetCentroidOfElement() checks that the area is non-zero before returning this
+        mCachedElementCentroids[index] = first_node_location;
+        if (signed_area != 0.0)
+        {
+            mCachedElementCentroids[index](0) += centroid_x / (6.0 * signed_area);
+            mCachedElementCentroids[index](1) += centroid_y / (6.0 * signed_area);
+        }
+
+        mElementGeometryIsCurrent[index] = true;
+    }
+}
+
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 unsigned VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetNumFaces() const
 {
@@ -781,6 +1030,13 @@ VertexElement<ELEMENT_DIM - 1, SPACE_DIM>* VertexMesh<ELEMENT_DIM, SPACE_DIM>::G
 template <unsigned ELEMENT_DIM, unsigned SPACE_DIM>
 c_vector<double, SPACE_DIM> VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetCentroidOfElement(unsigned index)
 {
+    if (SPACE_DIM == 2 && mUseElementGeometryCache)
+    {
+        UpdateElementGeometry(index);
+        assert(mCachedElementSignedAreas[index] != 0.0);
+        return mCachedElementCentroids[index];
+    }
+
     VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = GetElement(index);
     unsigned num_nodes = p_element->GetNumNodes();
 
@@ -1187,6 +1443,12 @@ double VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetVolumeOfElement(unsigned index)
 {
     assert(SPACE_DIM == 2 || SPACE_DIM == 3); // LCOV_EXCL_LINE - code will be removed at compile time
 
+    if (SPACE_DIM == 2 && mUseElementGeometryCache)
+    {
+        UpdateElementGeometry(index);
+        return fabs(mCachedElementSignedAreas[index]);
+    }
+
     // Get pointer to this element
     VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = GetElement(index);
 
@@ -1244,6 +1506,12 @@ double VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetSurfaceAreaOfElement(unsigned inde
 {
     assert(SPACE_DIM == 2 || SPACE_DIM == 3); // LCOV_EXCL_LINE - code will be removed at compile time
 
+    if (SPACE_DIM == 2 && mUseElementGeometryCache)
+    {
+        UpdateElementGeometry(index);
+        return mCachedElementPerimeters[index];
+    }
+
     // Get pointer to this element
     VertexElement<ELEMENT_DIM, SPACE_DIM>* p_element = GetElement(index);
 
@@ -1622,6 +1890,15 @@ c_vector<double, SPACE_DIM> VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetPreviousEdgeG
         // We add an extra num_nodes_in_element-1 in the line below as otherwise this term can be negative, which breaks the % operator
         const unsigned previous_local_index = (num_nodes_in_element + localIndex - 1) % num_nodes_in_element;
 
+        if (mUseElementGeometryCache)
+        {
+            unsigned element_index = pElement->GetIndex();
+            assert(mElements[element_index] == pElement);
+            UpdateElementGeometry(element_index);
+            assert(mCachedElementEdgeLengths[element_index][previous_local_index] > DBL_EPSILON);
+            return mCachedElementEdgeVectors[element_index][previous_local_index] / mCachedElementEdgeLengths[element_index][previous_local_index];
+        }
+
         const unsigned this_global_index = pElement->GetNodeGlobalIndex(localIndex);
         const unsigned previous_global_index = pElement->GetNodeGlobalIndex(previous_local_index);
 
@@ -1646,6 +1923,15 @@ c_vector<double, SPACE_DIM> VertexMesh<ELEMENT_DIM, SPACE_DIM>::GetNextEdgeGradi
     {
         const unsigned next_local_index = (localIndex + 1) % (pElement->GetNumNodes());
 
+        if (mUseElementGeometryCache)
+        {
+            unsigned element_index = pElement->GetIndex();
+            assert(mElements[element_index] == pElement);
+            UpdateElementGeometry(element_index);
+            assert(mCachedElementEdgeLengths[element_index][localIndex] > DBL_EPSILON);
+            return -mCachedElementEdgeVectors[element_index][localIndex] / mCachedElementEdgeLengths[element_index][localIndex];
+        }
+
         const unsigned this_global_index = pElement->GetNodeGlobalIndex(localIndex);
         const unsigned next_global_index = pElement->GetNodeGlobalIndex(next_local_index);
 
@@ -107,6 +107,41 @@ protected:
      */
     TetrahedralMesh<ELEMENT_DIM, SPACE_DIM>* mpDelaunayMesh;
 
+    /**
+     * The global indices of the nodes of each element of mpDelaunayMesh, recorded when
+     * this mesh was last constructed or updated as an unbounded, non-periodic Voronoi
+     * tessellation of it, and empty otherwise. Used by UpdateVoronoiTessellation() to
+     * find the Voronoi elements whose topology has changed.
+     */
+    std::vector<unsigned> mDelaunayElementNodeIndices;
+
+    /**
+     * Whether the geometry of each element is cached (see SetUseElementGeometryCache()).
+     * Only used in 2D.
+     */
+    bool mUseElementGeometryCache = false;
+
+    /** Whether the cached geometry of each element, indexed by global index, is up to date. */
+    std::vector<bool> mElementGeometryIsCurrent;
+
+    /** The cached signed area of each element. */
+    std::vector<double> mCachedElementSignedAreas;
+
+    /** The cached perimeter of each element. */
+    std::vector<double> mCachedElementPerimeters;
+
+    /** The cached centroid of each element. */
+    std::vector<c_vector<double, SPACE_DIM> > mCachedElementCentroids;
+
+    /**
+     * The cached edges of each element: for each local node index, the vector from that
+     * node to the next one in the element, as given by GetVectorFromAtoB().
+     */
+    std::vector<std::vector<c_vector<double, SPACE_DIM> > > mCachedElementEdgeVectors;
+
+    /** The cached lengths of the edges in mCachedElementEdgeVectors. */
+    std::vector<std::vector<double> > mCachedElementEdgeLengths;
+
     /**
      * Solve node mapping method. This overridden method is required
      * as it is pure virtual in the base class.
@@ -134,6 +169,16 @@ protected:
      */
     unsigned SolveBoundaryElementMapping(unsigned index) const;
 
+    /**
+     * If the cached geometry of an element is out of date, compute its signed area, perimeter,
+     * centroid and edges in a single loop over its nodes, and store them. The results are
+     * identical to those computed by GetVolumeOfElement(), GetSurfaceAreaOfElement(),
+     * GetCentroidOfElement() and GetNextEdgeGradientOfElementAtNode() without the cache.
+     *
+     * @param index the global index of the element
+     */
+    void UpdateElementGeometry(unsigned index);
+
     /**
      * Build edges from elements. Populates edges in EdgeHelper class
      * @param rElements from which edges are built
@@ -149,6 +194,13 @@ protected:
      */
     void GenerateVerticesFromElementCircumcentres(TetrahedralMesh<ELEMENT_DIM, SPACE_DIM>& rMesh);
 
+    /**
+     * Record the global indices of the nodes of each element of mpDelaunayMesh in
+     * mDelaunayElementNodeIndices. Used by 'Voronoi' constructors and by
+     * UpdateVoronoiTessellation().
+     */
+    void RecordDelaunayElementNodeIndices();
+
     /**
      * Test whether a given point lies inside a given element.
      *
@@ -329,6 +381,43 @@ public:
      */
     unsigned GetNumAllElements() const;
 
+    /**
+     * Set whether to cache the area, perimeter, centroid and edges of each element, so that they
+     * are computed at most once however many times they are requested between changes to the
+     * mesh. Only used in 2D. Enabling or disabling the cache discards any cached geometry.
+     *
+     * Cached geometry is discarded for the elements containing a node moved by SetNode(), and for
+     * all elements when the topology of the mesh changes or the mesh is scaled, translated or
+     * rotated. Code that moves nodes in any other way, for example through
+     * Node::rGetModifiableLocation(), must call InvalidateElementGeometry().
+     *
+     * @param useElementGeometryCache whether to cache element geometry
+     */
+    void SetUseElementGeometryCache(bool useElementGeometryCache);
+
+    /**
+     * @return mUseElementGeometryCache
+     */
+    bool GetUseElementGeometryCache() const;
+
+    /**
+     * Discard the cached geometry of every element.
+     */
+    void InvalidateElementGeometry();
+
+    /**
+     * Overridden RefreshMesh() method. This method calls InvalidateElementGeometry(), so that
+     * Scale(), Translate() and Rotate() discard any cached element geometry.
+     */
+    void RefreshMesh();
+
+    /**
+     * Discard the cached geometry of every element containing a given node.
+     *
+     * @param nodeIndex the global index of the node
+     */
+    void InvalidateElementGeometryAtNode(unsigned nodeIndex);
+
     /**
      * @return the number of Faces in the mesh.
      */
@@ -384,6 +473,23 @@ public:
      */
     unsigned GetDelaunayNodeIndexCorrespondingToVoronoiElementIndex(unsigned elementIndex);
 
+    /**
+     * Bring this Voronoi tessellation up to date with its Delaunay mesh after the nodes
+     * of the Delaunay mesh have moved or it has been remeshed, reusing as much of the
+     * existing tessellation as possible.
+     *
+     * Every vertex is moved to the current circumcentre of its Delaunay element. In 2D,
+     * only the Voronoi elements of Delaunay nodes whose surrounding triangles have changed
+     * are rebuilt; in 3D, the tessellation is only updated if no Delaunay element has changed.
+     *
+     * The result is the same as constructing the tessellation from the Delaunay mesh afresh.
+     * Bounded and periodic tessellations are not supported.
+     *
+     * @return whether the tessellation was updated; if false, it is unchanged and must be
+     *     constructed afresh
+     */
+    bool UpdateVoronoiTessellation();
+
     /**
      * @return the global index of the corresponding element in the Voronoi
      * mesh given the global index of a node in the Delaunay mesh,  or
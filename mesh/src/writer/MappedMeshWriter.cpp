@@ -0,0 +1,411 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#include "MappedMeshWriter.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+#include <cstring>
+#include <numeric>
+
+#include "AbstractTetrahedralMesh.hpp"
+#include "Exception.hpp"
+
+///////////////////////////////////////////////////////////////////////////////////
+// Implementation
+///////////////////////////////////////////////////////////////////////////////////
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+MappedMeshWriter<ELEMENT_DIM, SPACE_DIM>::MappedMeshWriter(
+    const std::string& rDirectory,
+    const std::string& rBaseName,
+    const bool clearOutputDir)
+        : AbstractTetrahedralMeshWriter<ELEMENT_DIM, SPACE_DIM>(rDirectory, rBaseName, clearOutputDir),
+          mNumPartitions(0u)
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+MappedMeshWriter<ELEMENT_DIM, SPACE_DIM>::~MappedMeshWriter()
+{
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MappedMeshWriter<ELEMENT_DIM, SPACE_DIM>::SetNumPartitions(unsigned numPartitions)
+{
+    mNumPartitions = numPartitions;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+unsigned MappedMeshWriter<ELEMENT_DIM, SPACE_DIM>::GetNumPartitions() const
+{
+    return mNumPartitions;
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MappedMeshWriter<ELEMENT_DIM, SPACE_DIM>::BisectNodes(const std::vector<double>& rCoordinates,
+                                                           std::vector<unsigned>::iterator begin,
+                                                           std::vector<unsigned>::iterator end,
+                                                           unsigned firstPartition,
+                                                           unsigned numPartitions,
+                                                           std::vector<unsigned>& rNodePartitions)
+{
+    if (numPartitions == 1)
+    {
+        for (std::vector<unsigned>::iterator it = begin; it != end; ++it)
+        {
+            rNodePartitions[*it] = firstPartition;
+        }
+        return;
+    }
+
+    // Find the longest side of the bounding box of the nodes
+    double min_coords[SPACE_DIM];
+    double max_coords[SPACE_DIM];
+    for (unsigned i=0; i<SPACE_DIM; i++)
+    {
+        min_coords[i] = DBL_MAX;
+        max_coords[i] = -DBL_MAX;
+    }
+    for (std::vector<unsigned>::iterator it = begin; it != end; ++it)
+    {
+        for (unsigned i=0; i<SPACE_DIM; i++)
+        {
+            min_coords[i] = std::min(min_coords[i], rCoordinates[(*it)*SPACE_DIM + i]);
+            max_coords[i] = std::max(max_coords[i], rCoordinates[(*it)*SPACE_DIM + i]);
+        }
+    }
+    unsigned axis = 0;
+    for (unsigned i=1; i<SPACE_DIM; i++)
+    {
+        if (max_coords[i] - min_coords[i] > max_coords[axis] - min_coords[axis])
+        {
+            axis = i;
+        }
+    }
+
+    // Split the nodes across that side in proportion to the number of partitions on each side
+    // (ties are broken by node index, so that the partition does not depend on the library implementation)
+    unsigned num_lower_partitions = numPartitions/2;
+    std::vector<unsigned>::iterator middle = begin + ((end - begin)*(uint64_t)num_lower_partitions)/numPartitions;
+    std::nth_element(begin, middle, end, [&rCoordinates, axis](unsigned a, unsigned b)
+    {
+        double coord_a = rCoordinates[a*SPACE_DIM + axis];
+        double coord_b = rCoordinates[b*SPACE_DIM + axis];
+        return coord_a < coord_b || (coord_a == coord_b && a < b);
+    });
+
+    BisectNodes(rCoordinates, begin, middle, firstPartition, num_lower_partitions, rNodePartitions);
+    BisectNodes(rCoordinates, middle, end, firstPartition + num_lower_partitions, numPartitions - num_lower_partitions, rNodePartitions);
+}
+
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+void MappedMeshWriter<ELEMENT_DIM, SPACE_DIM>::WriteFiles()
+{
+    const unsigned num_nodes = this->GetNumNodes();
+    const unsigned num_elements = this->GetNumElements();
+    const unsigned num_faces = this->GetNumBoundaryFaces();
+
+    if (this->GetNumCableElements() > 0)
+    {
+        EXCEPTION("Cable elements cannot be written in mapped mesh format.");
+    }
+    if (mNumPartitions > num_nodes)
+    {
+        EXCEPTION("Cannot partition a mesh with " << num_nodes << " nodes between " << mNumPartitions << " processes.");
+    }
+
+    // Node attributes are only available from a reader, or from a mesh which is held on this process and has no deleted nodes
+    bool node_attributes_from_mesh = (this->mpMesh != nullptr && this->mpDistributedMesh == nullptr
+                                      && num_nodes > 0 && this->mpMesh->GetNumAllNodes() == num_nodes);
+    unsigned num_node_attributes = node_attributes_from_mesh ? this->mpMesh->GetNumNodeAttributes() : 0u;
+
+    std::vector<double> node_coordinates;
+    std::vector<double> node_attributes;
+    node_coordinates.reserve((size_t)num_nodes*SPACE_DIM);
+    for (unsigned item_num=0; item_num<num_nodes; item_num++)
+    {
+        std::vector<double> coords = this->GetNextNode();
+        node_coordinates.insert(node_coordinates.end(), coords.begin(), coords.end());
+
+        std::vector<double> attributes;
+        if (this->mpMeshReader)
+        {
+            attributes = this->mpMeshReader->GetNodeAttributes();
+            if (item_num == 0)
+            {
+                num_node_attributes = attributes.size();
+            }
+        }
+        else if (num_node_attributes > 0)
+        {
+            attributes = this->mpMesh->GetNode(item_num)->rGetNodeAttributes();
+        }
+        if (attributes.size() != num_node_attributes)
+        {
+            EXCEPTION("All nodes must have the same number of attributes to be written in mapped mesh format.");
+        }
+        node_attributes.insert(node_attributes.end(), attributes.begin(), attributes.end());
+    }
+
+    // As in the Triangles format, every element and face has a single attribute
+    std::vector<unsigned> element_nodes;
+    std::vector<double> element_attributes;
+    element_nodes.reserve((size_t)num_elements*(ELEMENT_DIM+1));
+    element_attributes.reserve(num_elements);
+    for (unsigned item_num=0; item_num<num_elements; item_num++)
+    {
+        ElementData element_data = this->GetNextElement();
+        if (element_data.NodeIndices.size() != ELEMENT_DIM+1)
+        {
+            EXCEPTION("Only linear meshes can be written in mapped mesh format.");
+        }
+        for (unsigned j=0; j<ELEMENT_DIM+1; j++)
+        {
+            if (element_data.NodeIndices[j] >= num_nodes)
+            {
+                EXCEPTION("Element " << item_num << " contains node " << element_data.NodeIndices[j] << ", but the mesh only has " << num_nodes << " nodes.");
+            }
+        }
+        element_nodes.insert(element_nodes.end(), element_data.NodeIndices.begin(), element_data.NodeIndices.end());
+        element_attributes.push_back(element_data.AttributeValue);
+    }
+
+    std::vector<unsigned> face_nodes;
+    std::vector<double> face_attributes;
+    face_nodes.reserve((size_t)num_faces*ELEMENT_DIM);
+    face_attributes.reserve(num_faces);
+    for (unsigned item_num=0; item_num<num_faces; item_num++)
+    {
+        ElementData face_data = this->GetNextBoundaryElement();
+        if (face_data.NodeIndices.size() != ELEMENT_DIM)
+        {
+            EXCEPTION("Only linear meshes can be written in mapped mesh format.");
+        }
+        for (unsigned j=0; j<ELEMENT_DIM; j++)
+        {
+            if (face_data.NodeIndices[j] >= num_nodes)
+            {
+                EXCEPTION("Face " << item_num << " contains node " << face_data.NodeIndices[j] << ", but the mesh only has " << num_nodes << " nodes.");
+            }
+        }
+        face_nodes.insert(face_nodes.end(), face_data.NodeIndices.begin(), face_data.NodeIndices.end());
+        face_attributes.push_back(face_data.AttributeValue);
+    }
+
+    std::vector<unsigned> node_permutation;
+    std::vector<uint64_t> partition_node_offsets;
+    std::vector<unsigned> partition_nodes;
+    std::vector<uint64_t> partition_halo_node_offsets;
+    std::vector<unsigned> partition_halo_nodes;
+    std::vector<uint64_t> partition_element_offsets;
+    std::vector<unsigned> partition_elements;
+    std::vector<uint64_t> partition_face_offsets;
+    std::vector<unsigned> partition_faces;
+
+    if (mNumPartitions > 0)
+    {
+        std::vector<unsigned> node_partitions(num_nodes);
+        std::vector<unsigned> node_indices(num_nodes);
+        std::iota(node_indices.begin(), node_indices.end(), 0u);
+        BisectNodes(node_coordinates, node_indices.begin(), node_indices.end(), 0u, mNumPartitions, node_partitions);
+
+        // Give each partition a contiguous range of permuted node indices, keeping the original order within each range
+        partition_node_offsets.assign(mNumPartitions+1, 0u);
+        for (unsigned node_index=0; node_index<num_nodes; node_index++)
+        {
+            partition_node_offsets[node_partitions[node_index]+1]++;
+        }
+        std::partial_sum(partition_node_offsets.begin(), partition_node_offsets.end(), partition_node_offsets.begin());
+
+        /*
+         * The permutation is the inverse of the list of nodes owned by each partition. This is the
+         * only place it is checked in full; readers check just the entries of the nodes they load.
+         */
+        std::vector<uint64_t> next_position(partition_node_offsets.begin(), partition_node_offsets.end()-1);
+        partition_nodes.resize(num_nodes);
+        node_permutation.resize(num_nodes);
+        for (unsigned node_index=0; node_index<num_nodes; node_index++)
+        {
+            uint64_t position = next_position[node_partitions[node_index]]++;
+            partition_nodes[position] = node_index;
+            node_permutation[node_index] = position;
+        }
+        for (unsigned position=0; position<num_nodes; position++)
+        {
+            assert(node_permutation[partition_nodes[position]] == position);
+        }
+
+        // A partition owns every element and face with a node it owns, and the other nodes of its elements are its halo nodes
+        std::vector<std::vector<unsigned> > elements_owned(mNumPartitions);
+        std::vector<std::vector<unsigned> > halo_nodes_owned(mNumPartitions);
+        std::vector<std::vector<unsigned> > faces_owned(mNumPartitions);
+        std::vector<unsigned> partitions;
+        for (unsigned element_index=0; element_index<num_elements; element_index++)
+        {
+            const unsigned* p_nodes = &element_nodes[(size_t)element_index*(ELEMENT_DIM+1)];
+            partitions.clear();
+            for (unsigned j=0; j<ELEMENT_DIM+1; j++)
+            {
+                partitions.push_back(node_partitions[p_nodes[j]]);
+            }
+            std::sort(partitions.begin(), partitions.end());
+            partitions.erase(std::unique(partitions.begin(), partitions.end()), partitions.end());
+
+            for (unsigned i=0; i<partitions.size(); i++)
+            {
+                elements_owned[partitions[i]].push_back(element_index);
+                for (unsigned j=0; j<ELEMENT_DIM+1; j++)
+                {
+                    if (node_partitions[p_nodes[j]] != partitions[i])
+                    {
+                        halo_nodes_owned[partitions[i]].push_back(p_nodes[j]);
+                    }
+                }
+            }
+        }
+        for (unsigned face_index=0; face_index<num_faces; face_index++)
+        {
+            const unsigned* p_nodes = &face_nodes[(size_t)face_index*ELEMENT_DIM];
+            partitions.clear();
+            for (unsigned j=0; j<ELEMENT_DIM; j++)
+            {
+                partitions.push_back(node_partitions[p_nodes[j]]);
+            }
+            std::sort(partitions.begin(), partitions.end());
+            partitions.erase(std::unique(partitions.begin(), partitions.end()), partitions.end());
+
+            for (unsigned i=0; i<partitions.size(); i++)
+            {
+                faces_owned[partitions[i]].push_back(face_index);
+            }
+        }
+
+        partition_halo_node_offsets.push_back(0u);
+        partition_element_offsets.push_back(0u);
+        partition_face_offsets.push_back(0u);
+        for (unsigned partition=0; partition<mNumPartitions; partition++)
+        {
+            std::vector<unsigned>& r_halo_nodes = halo_nodes_owned[partition];
+            std::sort(r_halo_nodes.begin(), r_halo_nodes.end());
+            r_halo_nodes.erase(std::unique(r_halo_nodes.begin(), r_halo_nodes.end()), r_halo_nodes.end());
+
+            partition_halo_nodes.insert(partition_halo_nodes.end(), r_halo_nodes.begin(), r_halo_nodes.end());
+            partition_elements.insert(partition_elements.end(), elements_owned[partition].begin(), elements_owned[partition].end());
+            partition_faces.insert(partition_faces.end(), faces_owned[partition].begin(), faces_owned[partition].end());
+            partition_halo_node_offsets.push_back(partition_halo_nodes.size());
+            partition_element_offsets.push_back(partition_elements.size());
+            partition_face_offsets.push_back(partition_faces.size());
+        }
+    }
+
+    // Lay out the blocks, in order, each at the next aligned offset after the header or the previous block
+    const char* block_data[MappedMeshFormat::NUM_BLOCKS] = {
+        reinterpret_cast<const char*>(node_coordinates.data()),
+        reinterpret_cast<const char*>(node_attributes.data()),
+        reinterpret_cast<const char*>(element_nodes.data()),
+        reinterpret_cast<const char*>(element_attributes.data()),
+        reinterpret_cast<const char*>(face_nodes.data()),
+        reinterpret_cast<const char*>(face_attributes.data()),
+        reinterpret_cast<const char*>(node_permutation.data()),
+        reinterpret_cast<const char*>(partition_node_offsets.data()),
+        reinterpret_cast<const char*>(partition_nodes.data()),
+        reinterpret_cast<const char*>(partition_halo_node_offsets.data()),
+        reinterpret_cast<const char*>(partition_halo_nodes.data()),
+        reinterpret_cast<const char*>(partition_element_offsets.data()),
+        reinterpret_cast<const char*>(partition_elements.data()),
+        reinterpret_cast<const char*>(partition_face_offsets.data()),
+        reinterpret_cast<const char*>(partition_faces.data())};
+
+    MappedMeshFormat::Header header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.Magic, "CHSTMESH", 8);
+    header.Version = MappedMeshFormat::VERSION;
+    header.ByteOrder = MappedMeshFormat::BYTE_ORDER_MARK;
+    header.ElementDim = ELEMENT_DIM;
+    header.SpaceDim = SPACE_DIM;
+    header.NumNodes = num_nodes;
+    header.NumElements = num_elements;
+    header.NumFaces = num_faces;
+    header.NumNodeAttributes = num_node_attributes;
+    header.NumElementAttributes = 1u;
+    header.NumFaceAttributes = 1u;
+    header.NumPartitions = mNumPartitions;
+    header.BlockSizes[MappedMeshFormat::NODES] = node_coordinates.size()*sizeof(double);
+    header.BlockSizes[MappedMeshFormat::NODE_ATTRIBUTES] = node_attributes.size()*sizeof(double);
+    header.BlockSizes[MappedMeshFormat::ELEMENTS] = element_nodes.size()*sizeof(unsigned);
+    header.BlockSizes[MappedMeshFormat::ELEMENT_ATTRIBUTES] = element_attributes.size()*sizeof(double);
+    header.BlockSizes[MappedMeshFormat::FACES] = face_nodes.size()*sizeof(unsigned);
+    header.BlockSizes[MappedMeshFormat::FACE_ATTRIBUTES] = face_attributes.size()*sizeof(double);
+    header.BlockSizes[MappedMeshFormat::NODE_PERMUTATION] = node_permutation.size()*sizeof(unsigned);
+    header.BlockSizes[MappedMeshFormat::PARTITION_NODE_OFFSETS] = partition_node_offsets.size()*sizeof(uint64_t);
+    header.BlockSizes[MappedMeshFormat::PARTITION_NODES] = partition_nodes.size()*sizeof(unsigned);
+    header.BlockSizes[MappedMeshFormat::PARTITION_HALO_NODE_OFFSETS] = partition_halo_node_offsets.size()*sizeof(uint64_t);
+    header.BlockSizes[MappedMeshFormat::PARTITION_HALO_NODES] = partition_halo_nodes.size()*sizeof(unsigned);
+    header.BlockSizes[MappedMeshFormat::PARTITION_ELEMENT_OFFSETS] = partition_element_offsets.size()*sizeof(uint64_t);
+    header.BlockSizes[MappedMeshFormat::PARTITION_ELEMENTS] = partition_elements.size()*sizeof(unsigned);
+    header.BlockSizes[MappedMeshFormat::PARTITION_FACE_OFFSETS] = partition_face_offsets.size()*sizeof(uint64_t);
+    header.BlockSizes[MappedMeshFormat::PARTITION_FACES] = partition_faces.size()*sizeof(unsigned);
+
+    const uint64_t alignment = MappedMeshFormat::ALIGNMENT;
+    uint64_t offset = sizeof(header);
+    for (unsigned block=0; block<MappedMeshFormat::NUM_BLOCKS; block++)
+    {
+        offset = ((offset + alignment - 1)/alignment)*alignment;
+        header.BlockOffsets[block] = offset;
+        offset += header.BlockSizes[block];
+    }
+
+    out_stream p_file = this->mpOutputFileHandler->OpenOutputFile(this->mBaseName + ".mmesh", std::ios::binary | std::ios::trunc);
+    p_file->write(reinterpret_cast<const char*>(&header), sizeof(header));
+    const char padding[MappedMeshFormat::ALIGNMENT] = {0};
+    uint64_t position = sizeof(header);
+    for (unsigned block=0; block<MappedMeshFormat::NUM_BLOCKS; block++)
+    {
+        p_file->write(padding, header.BlockOffsets[block] - position);
+        p_file->write(block_data[block], header.BlockSizes[block]);
+        position = header.BlockOffsets[block] + header.BlockSizes[block];
+    }
+    p_file->close();
+}
+
+// Explicit instantiation
+template class MappedMeshWriter<1,1>;
+template class MappedMeshWriter<1,2>;
+template class MappedMeshWriter<1,3>;
+template class MappedMeshWriter<2,2>;
+template class MappedMeshWriter<2,3>;
+template class MappedMeshWriter<3,3>;
@@ -0,0 +1,117 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef _MAPPEDMESHWRITER_HPP_
+#define _MAPPEDMESHWRITER_HPP_
+
+#include <vector>
+#include "AbstractTetrahedralMeshWriter.hpp"
+#include "MappedMeshFormat.hpp"
+
+/**
+ * A concrete mesh writer class that writes the single binary file (extension ".mmesh") read by
+ * MappedMeshReader.  See MappedMeshFormat for the layout of the file.
+ *
+ * Optionally, the nodes may be partitioned between a number of processes by recursive coordinate
+ * bisection when the file is written.  The partition, and the halo nodes, elements and faces
+ * of each process, are then stored in the file so that a DistributedTetrahedralMesh loaded from it
+ * on that many processes need not partition the mesh itself.
+ *
+ * Only linear meshes without cable elements can be written.
+ */
+template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+class MappedMeshWriter : public AbstractTetrahedralMeshWriter<ELEMENT_DIM, SPACE_DIM>
+{
+private:
+
+    /** Number of processes to partition the mesh between, or 0 not to store a partition. */
+    unsigned mNumPartitions;
+
+    /**
+     * Partition some of the nodes by recursive coordinate bisection: the nodes are split
+     * across the longest side of their bounding box, in proportion to the number of partitions
+     * on each side, until each part is a single partition.
+     *
+     * @param rCoordinates  the coordinates of all the nodes (SPACE_DIM values per node)
+     * @param begin  the start of the node indices to partition
+     * @param end  the end of the node indices to partition
+     * @param firstPartition  the first partition to give the nodes to
+     * @param numPartitions  the number of partitions to give the nodes to
+     * @param rNodePartitions  filled in with the partition of each node
+     */
+    void BisectNodes(const std::vector<double>& rCoordinates,
+                     std::vector<unsigned>::iterator begin,
+                     std::vector<unsigned>::iterator end,
+                     unsigned firstPartition,
+                     unsigned numPartitions,
+                     std::vector<unsigned>& rNodePartitions);
+
+public:
+
+    /**
+     * Constructor.
+     *
+     * @param rDirectory  the directory in which to write the mesh to file
+     * @param rBaseName  the base name of the file in which to write the mesh data (the ".mmesh" extension is added)
+     * @param clearOutputDir  whether to clean the directory (defaults to true)
+     */
+    MappedMeshWriter(const std::string& rDirectory,
+                     const std::string& rBaseName,
+                     const bool clearOutputDir=true);
+
+    /**
+     * Set the number of processes to partition the mesh between when it is written.
+     *
+     * @param numPartitions  the number of processes, or 0 (the default) not to store a partition
+     */
+    void SetNumPartitions(unsigned numPartitions);
+
+    /**
+     * @return the number of processes the mesh will be partitioned between.
+     */
+    unsigned GetNumPartitions() const;
+
+    /**
+     * Write mesh data to file.
+     */
+    void WriteFiles();
+
+    /**
+     * Destructor.
+     */
+    virtual ~MappedMeshWriter();
+};
+
+#endif //_MAPPEDMESHWRITER_HPP_
@@ -46,6 +46,8 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "TetrahedralMesh.hpp"
 #include "TrianglesMeshReader.hpp"
 #include "TrianglesMeshWriter.hpp"
+#include "MappedMeshReader.hpp"
+#include "MappedMeshWriter.hpp"
 #include "PetscTools.hpp"
 #include "ArchiveOpener.hpp"
 #include "FileFinder.hpp"
@@ -829,6 +831,59 @@ public:
         }
     }
 
+    void TestEverythingIsAssignedStoredPartition()
+    {
+        // Convert the mesh to mapped format, storing a partition for the number of processes in this run
+        TrianglesMeshReader<3,3> triangles_reader("mesh/test/data/cube_136_elements");
+        MappedMeshWriter<3,3> mesh_writer("TestDistributedTetrahedralMeshStoredPartition", "cube_136_elements");
+        mesh_writer.SetNumPartitions(PetscTools::GetNumProcs());
+        mesh_writer.WriteFilesUsingMeshReader(triangles_reader);
+        PetscTools::Barrier("TestEverythingIsAssignedStoredPartition");
+
+        MappedMeshReader<3,3> mesh_reader(mesh_writer.GetOutputDirectory() + "cube_136_elements");
+        DistributedTetrahedralMesh<3,3> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        TS_ASSERT_EQUALS(mesh.GetNumNodes(), mesh_reader.GetNumNodes());
+        TS_ASSERT_EQUALS(mesh.GetNumElements(), mesh_reader.GetNumElements());
+        TS_ASSERT_EQUALS(mesh.GetNumBoundaryElements(), mesh_reader.GetNumFaces());
+
+        CheckEverythingIsAssigned<3,3>(mesh);
+
+        if (PetscTools::IsParallel())
+        {
+            // The mesh has taken the stored partition rather than computing one
+            std::vector<unsigned> permutation;
+            std::vector<unsigned> offsets;
+            std::set<unsigned> nodes, halo_nodes, elements, faces;
+            mesh_reader.GetPartition(PetscTools::GetMyRank(), permutation, offsets, nodes, halo_nodes, elements, faces);
+            TS_ASSERT_EQUALS(mesh.rGetNodePermutation(), permutation);
+            TS_ASSERT_EQUALS(mesh.GetNumLocalNodes(), nodes.size());
+            TS_ASSERT_EQUALS(mesh.GetNumHaloNodes(), halo_nodes.size());
+            TS_ASSERT_EQUALS(mesh.GetNumLocalElements(), elements.size());
+            TS_ASSERT_EQUALS(mesh.GetNumLocalBoundaryElements(), faces.size());
+            TS_ASSERT_EQUALS(mesh.GetDistributedVectorFactory()->GetLow(), offsets[PetscTools::GetMyRank()]);
+        }
+
+        // The elements are the same as those of a sequential mesh, although the nodes may have been renumbered
+        triangles_reader.Reset();
+        TetrahedralMesh<3,3> seq_mesh;
+        seq_mesh.ConstructFromMeshReader(triangles_reader);
+        for (AbstractTetrahedralMesh<3,3>::ElementIterator iter = mesh.GetElementIteratorBegin();
+             iter != mesh.GetElementIteratorEnd();
+             ++iter)
+        {
+            Element<3,3>* p_sequ_element = seq_mesh.GetElement(iter->GetIndex());
+            for (unsigned node_local_index=0; node_local_index < iter->GetNumNodes(); node_local_index++)
+            {
+                for (unsigned dim=0; dim<3; dim++)
+                {
+                    TS_ASSERT_EQUALS(iter->GetNode(node_local_index)->GetPoint()[dim],
+                                     p_sequ_element->GetNode(node_local_index)->GetPoint()[dim]);
+                }
+            }
+        }
+    }
 
     void TestConstruct3DWithRegions()
     {
@@ -506,6 +506,145 @@ public:
         TS_ASSERT_THROWS_THIS(mesh.ReMesh(map),"The number of nodes must exceed the spatial dimension.");
     }
 
+    void TestIncrementalReMesh2d()
+    {
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/square_128_elements");
+        MutableMesh<2,2> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+        mesh.ReMesh();
+
+        TS_ASSERT_EQUALS(mesh.GetUseIncrementalReMesh(), false);
+        mesh.SetUseIncrementalReMesh(true);
+        TS_ASSERT_EQUALS(mesh.GetUseIncrementalReMesh(), true);
+
+        // Perturb the interior nodes of the (cocircular) square grid, so that some edges must be flipped
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            if (!mesh.GetNode(i)->IsBoundaryNode())
+            {
+                c_vector<double, 2>& r_location = mesh.GetNode(i)->rGetModifiableLocation();
+                r_location[0] += 0.03*sin(1.7*i);
+                r_location[1] += 0.03*cos(2.3*i);
+            }
+        }
+        double area = mesh.GetVolume();
+        TS_ASSERT_EQUALS(mesh.CheckIsVoronoi(), false);
+
+        NodeMap map(mesh.GetNumNodes());
+        mesh.ReMesh(map);
+
+        TS_ASSERT_EQUALS(mesh.GetLastReMeshWasIncremental(), true);
+        TS_ASSERT(map.IsIdentityMap());
+        TS_ASSERT_EQUALS(mesh.GetNumNodes(), 81u);
+        TS_ASSERT_EQUALS(mesh.GetNumAllElements(), 128u);
+        TS_ASSERT_EQUALS(mesh.GetNumBoundaryElements(), 32u);
+        TS_ASSERT_EQUALS(mesh.GetNumBoundaryNodes(), 32u);
+        TS_ASSERT_DELTA(mesh.GetVolume(), area, 1e-12);
+        TS_ASSERT_EQUALS(mesh.CheckIsVoronoi(), true);
+
+        // Delete an interior node and add a new one, as happens on cell death and division
+        mesh.DeleteNodePriorToReMesh(40);
+        unsigned new_index = mesh.AddNode(new Node<2>(0, false, 0.31, 0.27));
+        TS_ASSERT_EQUALS(new_index, 81u); // deleted indices are not reused
+
+        NodeMap map2(mesh.GetNumAllNodes());
+        mesh.ReMesh(map2);
+
+        TS_ASSERT_EQUALS(mesh.GetLastReMeshWasIncremental(), true);
+        TS_ASSERT_EQUALS(map2.IsDeleted(40), true);
+        TS_ASSERT_EQUALS(map2.GetNewIndex(39), 39u);
+        TS_ASSERT_EQUALS(map2.GetNewIndex(41), 40u);
+        TS_ASSERT_EQUALS(map2.GetNewIndex(81), 80u);
+        TS_ASSERT_DELTA(mesh.GetNode(80)->rGetLocation()[0], 0.31, 1e-12);
+        TS_ASSERT_EQUALS(mesh.GetNumNodes(), 81u);
+        TS_ASSERT_EQUALS(mesh.GetNumAllNodes(), 81u);
+        TS_ASSERT_EQUALS(mesh.GetNumAllElements(), 128u);
+        TS_ASSERT_DELTA(mesh.GetVolume(), area, 1e-12);
+        TS_ASSERT_EQUALS(mesh.CheckIsVoronoi(), true);
+
+        // The triangulation should match one built from scratch by Triangle
+        std::vector<Node<2>*> nodes;
+        for (unsigned i=0; i<mesh.GetNumNodes(); i++)
+        {
+            nodes.push_back(new Node<2>(i, mesh.GetNode(i)->rGetLocation()));
+        }
+        MutableMesh<2,2> reference_mesh(nodes);
+        TS_ASSERT_EQUALS(reference_mesh.GetNumElements(), mesh.GetNumElements());
+        std::set<std::set<unsigned> > elements;
+        std::set<std::set<unsigned> > reference_elements;
+        for (unsigned i=0; i<mesh.GetNumElements(); i++)
+        {
+            std::set<unsigned> element;
+            std::set<unsigned> reference_element;
+            for (unsigned j=0; j<3; j++)
+            {
+                element.insert(mesh.GetElement(i)->GetNodeGlobalIndex(j));
+                reference_element.insert(reference_mesh.GetElement(i)->GetNodeGlobalIndex(j));
+            }
+            elements.insert(element);
+            reference_elements.insert(reference_element);
+        }
+        TS_ASSERT(elements == reference_elements);
+
+        // Deleting two neighbouring interior nodes leaves a joint cavity, so Triangle is used instead
+        unsigned neighbour_index = UINT_MAX;
+        Element<2,2>* p_element = mesh.GetElement(*(mesh.GetNode(20)->ContainingElementsBegin()));
+        for (unsigned j=0; j<3; j++)
+        {
+            if (p_element->GetNodeGlobalIndex(j) != 20u && !p_element->GetNode(j)->IsBoundaryNode())
+            {
+                neighbour_index = p_element->GetNodeGlobalIndex(j);
+            }
+        }
+        TS_ASSERT_DIFFERS(neighbour_index, UINT_MAX);
+        mesh.DeleteNodePriorToReMesh(20);
+        mesh.DeleteNodePriorToReMesh(neighbour_index);
+
+        NodeMap map3(mesh.GetNumAllNodes());
+        mesh.ReMesh(map3);
+
+        TS_ASSERT_EQUALS(mesh.GetLastReMeshWasIncremental(), false);
+        TS_ASSERT_EQUALS(map3.IsDeleted(20), true);
+        TS_ASSERT_EQUALS(map3.IsDeleted(neighbour_index), true);
+        TS_ASSERT_EQUALS(mesh.GetNumNodes(), 79u);
+        TS_ASSERT_EQUALS(mesh.GetNumBoundaryNodes(), 32u);
+        TS_ASSERT_DELTA(mesh.GetVolume(), area, 1e-12);
+        TS_ASSERT_EQUALS(mesh.CheckIsVoronoi(), true);
+
+        // Moving a boundary node inwards makes the boundary non-convex, so Triangle is used instead
+        mesh.GetNode(5)->rGetModifiableLocation()[0] += 0.05;
+        TS_ASSERT_EQUALS(mesh.GetNode(5)->IsBoundaryNode(), true);
+        mesh.ReMesh();
+        TS_ASSERT_EQUALS(mesh.GetLastReMeshWasIncremental(), false);
+        TS_ASSERT_EQUALS(mesh.GetNumNodes(), 79u);
+        TS_ASSERT_EQUALS(mesh.CheckIsVoronoi(), true);
+
+        // New nodes far apart are found by walking across the mesh from the previous one
+        area = mesh.GetVolume();
+        mesh.AddNode(new Node<2>(0, false, 0.12, 0.88));
+        mesh.AddNode(new Node<2>(0, false, 0.93, 0.07));
+        mesh.AddNode(new Node<2>(0, false, 0.55, 0.52));
+        mesh.AddNode(new Node<2>(0, false, 0.09, 0.21));
+        mesh.AddNode(new Node<2>(0, false, 0.81, 0.94));
+
+        NodeMap map4(mesh.GetNumAllNodes());
+        mesh.ReMesh(map4);
+
+        TS_ASSERT_EQUALS(mesh.GetLastReMeshWasIncremental(), true);
+        TS_ASSERT(map4.IsIdentityMap());
+        TS_ASSERT_EQUALS(mesh.GetNumNodes(), 84u);
+        TS_ASSERT_EQUALS(mesh.GetNumElements() + 2, 2*mesh.GetNumNodes() - mesh.GetNumBoundaryNodes());
+        TS_ASSERT_DELTA(mesh.GetVolume(), area, 1e-12);
+        TS_ASSERT_EQUALS(mesh.CheckIsVoronoi(), true);
+
+        // A new node outside the mesh changes its convex hull, so Triangle is used instead
+        mesh.AddNode(new Node<2>(0, false, 1.2, 0.5));
+        mesh.ReMesh();
+        TS_ASSERT_EQUALS(mesh.GetLastReMeshWasIncremental(), false);
+        TS_ASSERT_EQUALS(mesh.GetNumNodes(), 85u);
+        TS_ASSERT_EQUALS(mesh.CheckIsVoronoi(), true);
+    }
+
     void TestRawTriangleLibraryCall()
     {
         struct triangulateio in, out;
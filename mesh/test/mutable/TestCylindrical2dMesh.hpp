@@ -539,7 +539,10 @@ public:
         unsigned new_index = p_mesh->AddNode(p_node);
         NodeMap map(p_mesh->GetNumNodes());
 
+        // The mesh is always rebuilt, as the image nodes used to remesh it are recreated each time
+        p_mesh->SetUseIncrementalReMesh(true);
         p_mesh->ReMesh(map);
+        TS_ASSERT_EQUALS(p_mesh->GetLastReMeshWasIncremental(), false);
 
         TS_ASSERT_EQUALS(map.IsIdentityMap(), true);
 
@@ -263,8 +263,11 @@ public:
         ToroidalHoneycombMeshGenerator generator(cells_across, cells_up, 1 , 1);
         boost::shared_ptr<Toroidal2dMesh> p_mesh = generator.GetToroidalMesh();
 
+        // The mesh is always rebuilt, as the image nodes used to remesh it are recreated each time
+        p_mesh->SetUseIncrementalReMesh(true);
         NodeMap map(p_mesh->GetNumNodes());
         p_mesh->ReMesh(map);
+        TS_ASSERT_EQUALS(p_mesh->GetLastReMeshWasIncremental(), false);
 
         TS_ASSERT_EQUALS(map.IsIdentityMap(), true);
 
@@ -0,0 +1,459 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTMAPPEDMESHREADER_HPP_
+#define TESTMAPPEDMESHREADER_HPP_
+
+#include <cxxtest/TestSuite.h>
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <numeric>
+
+#include "MappedMeshReader.hpp"
+#include "MappedMeshWriter.hpp"
+#include "TrianglesMeshReader.hpp"
+#include "TrianglesMeshWriter.hpp"
+#include "GenericMeshReader.hpp"
+#include "TetrahedralMesh.hpp"
+#include "OutputFileHandler.hpp"
+#include "PetscTools.hpp"
+
+#include "PetscSetupAndFinalize.hpp"
+
+typedef MappedMeshReader<3,3> READER_3D;
+typedef MappedMeshReader<2,3> READER_2D_3D;
+typedef TrianglesMeshReader<3,3> TRIANGLES_READER_3D;
+
+class TestMappedMeshReader : public CxxTest::TestSuite
+{
+private:
+
+    /**
+     * Check that a mapped mesh reader gives the same data as another reader for the same mesh.
+     * (Face attributes are not compared when the mapped file was written from a mesh, since a mesh
+     * only keeps the face attributes which were in its file.)
+     */
+    template<unsigned ELEMENT_DIM, unsigned SPACE_DIM>
+    void CompareReaders(AbstractMeshReader<ELEMENT_DIM,SPACE_DIM>& rReader,
+                        MappedMeshReader<ELEMENT_DIM,SPACE_DIM>& rMappedReader,
+                        bool compareFaceAttributes=true)
+    {
+        TS_ASSERT_EQUALS(rMappedReader.GetNumNodes(), rReader.GetNumNodes());
+        TS_ASSERT_EQUALS(rMappedReader.GetNumElements(), rReader.GetNumElements());
+        TS_ASSERT_EQUALS(rMappedReader.GetNumFaces(), rReader.GetNumFaces());
+
+        for (unsigned i=0; i<rReader.GetNumNodes(); i++)
+        {
+            TS_ASSERT_EQUALS(rMappedReader.GetNextNode(), rReader.GetNextNode());
+            TS_ASSERT_EQUALS(rMappedReader.GetNodeAttributes(), rReader.GetNodeAttributes());
+        }
+        for (unsigned i=0; i<rReader.GetNumElements(); i++)
+        {
+            ElementData data = rReader.GetNextElementData();
+            ElementData mapped_data = rMappedReader.GetNextElementData();
+            TS_ASSERT_EQUALS(mapped_data.NodeIndices, data.NodeIndices);
+            TS_ASSERT_EQUALS(mapped_data.AttributeValue, data.AttributeValue);
+        }
+        for (unsigned i=0; i<rReader.GetNumFaces(); i++)
+        {
+            ElementData data = rReader.GetNextFaceData();
+            ElementData mapped_data = rMappedReader.GetNextFaceData();
+            TS_ASSERT_EQUALS(mapped_data.NodeIndices, data.NodeIndices);
+            if (compareFaceAttributes)
+            {
+                TS_ASSERT_EQUALS(mapped_data.AttributeValue, data.AttributeValue);
+            }
+        }
+    }
+
+public:
+
+    void TestWriteAndReadBack()
+    {
+        std::string output_dir;
+        {
+            TrianglesMeshReader<3,3> mesh_reader("mesh/test/data/cube_136_elements");
+            MappedMeshWriter<3,3> mesh_writer("TestMappedMeshReader", "cube_136_elements");
+            TS_ASSERT_EQUALS(mesh_writer.GetNumPartitions(), 0u);
+            mesh_writer.WriteFilesUsingMeshReader(mesh_reader);
+            output_dir = mesh_writer.GetOutputDirectory();
+        }
+        PetscTools::Barrier("TestWriteAndReadBack");
+
+        TrianglesMeshReader<3,3> mesh_reader("mesh/test/data/cube_136_elements");
+        MappedMeshReader<3,3> mapped_reader(output_dir + "cube_136_elements");
+        TS_ASSERT(mapped_reader.IsFileFormatBinary());
+        TS_ASSERT_EQUALS(mapped_reader.GetMeshFileBaseName(), output_dir + "cube_136_elements");
+        TS_ASSERT_EQUALS(mapped_reader.GetNumElementAttributes(), 1u);
+        TS_ASSERT_EQUALS(mapped_reader.GetNumFaceAttributes(), 1u);
+        TS_ASSERT_EQUALS(mapped_reader.GetNumPartitions(), 0u);
+        TS_ASSERT_EQUALS(mapped_reader.GetOrderOfElements(), 1u);
+        CompareReaders(mesh_reader, mapped_reader);
+
+        // Reading past the end
+        TS_ASSERT_THROWS_THIS(mapped_reader.GetNextNode(), "Node does not exist - not enough nodes.");
+        TS_ASSERT_THROWS_THIS(mapped_reader.GetNextElementData(), "Element does not exist - not enough elements.");
+        TS_ASSERT_THROWS_THIS(mapped_reader.GetNextFaceData(), "Face does not exist - not enough faces.");
+
+        // Reset and read again
+        mesh_reader.Reset();
+        mapped_reader.Reset();
+        CompareReaders(mesh_reader, mapped_reader);
+
+        // Random access
+        TrianglesMeshReader<3,3> binary_reader("mesh/test/data/cube_136_elements_binary");
+        TS_ASSERT_EQUALS(mapped_reader.GetNode(17), binary_reader.GetNode(17));
+        TS_ASSERT_EQUALS(mapped_reader.GetNode(3), binary_reader.GetNode(3));
+        TS_ASSERT_EQUALS(mapped_reader.GetNextNode(), binary_reader.GetNode(4));
+        TS_ASSERT_EQUALS(mapped_reader.GetElementData(100).NodeIndices, binary_reader.GetElementData(100).NodeIndices);
+        TS_ASSERT_EQUALS(mapped_reader.GetFaceData(50).NodeIndices, binary_reader.GetFaceData(50).NodeIndices);
+        TS_ASSERT_EQUALS(mapped_reader.GetNextFaceData().NodeIndices, binary_reader.GetFaceData(51).NodeIndices);
+
+        TS_ASSERT_THROWS_THIS(mapped_reader.GetNode(51), "Node does not exist - not enough nodes.");
+        TS_ASSERT_THROWS_THIS(mapped_reader.GetElementData(136), "Element 136 does not exist - not enough elements (only 136).");
+        TS_ASSERT_THROWS_THIS(mapped_reader.GetFaceData(96), "Face does not exist - not enough faces.");
+
+        // The node and element iterators use random access
+        std::set<unsigned> node_indices;
+        node_indices.insert(2);
+        node_indices.insert(40);
+        unsigned num_nodes_read = 0;
+        for (AbstractMeshReader<3,3>::NodeIterator it = mapped_reader.GetNodeIteratorBegin(node_indices);
+             it != mapped_reader.GetNodeIteratorEnd();
+             ++it)
+        {
+            TS_ASSERT_EQUALS(*it, binary_reader.GetNode(it.GetIndex()));
+            num_nodes_read++;
+        }
+        TS_ASSERT_EQUALS(num_nodes_read, 2u);
+
+        // There is no stored partition
+        std::vector<unsigned> permutation;
+        std::vector<unsigned> offsets;
+        std::set<unsigned> nodes, halo_nodes, elements, faces;
+        TS_ASSERT_THROWS_THIS(mapped_reader.GetPartition(0, permutation, offsets, nodes, halo_nodes, elements, faces),
+                              "Partition 0 does not exist - the mesh was partitioned for 0 processes.");
+        TS_ASSERT_EQUALS(binary_reader.GetNumPartitions(), 0u);
+        TS_ASSERT_THROWS_THIS(binary_reader.GetPartition(0, permutation, offsets, nodes, halo_nodes, elements, faces),
+                              "Stored partitions aren't supported by this reader");
+
+        // A generic reader prefers the mapped file
+        std::shared_ptr<AbstractMeshReader<3,3> > p_reader = GenericMeshReader<3,3>(output_dir + "cube_136_elements");
+        TS_ASSERT(std::dynamic_pointer_cast<READER_3D>(p_reader));
+
+        // ...unless the source files have been changed since it was written
+        {
+            TrianglesMeshReader<3,3> source_reader("mesh/test/data/cube_136_elements");
+            TrianglesMeshWriter<3,3> triangles_writer("TestMappedMeshReader", "cube_136_elements", false);
+            triangles_writer.WriteFilesUsingMeshReader(source_reader);
+        }
+        PetscTools::Barrier("TestWriteAndReadBack2");
+        p_reader = GenericMeshReader<3,3>(output_dir + "cube_136_elements");
+        TS_ASSERT(std::dynamic_pointer_cast<TRIANGLES_READER_3D>(p_reader));
+
+        // ...or the mapped file is of other dimensions
+        {
+            TrianglesMeshReader<2,2> other_reader("mesh/test/data/square_128_elements");
+            MappedMeshWriter<2,2> other_writer("TestMappedMeshReader", "cube_136_elements", false);
+            other_writer.WriteFilesUsingMeshReader(other_reader);
+        }
+        PetscTools::Barrier("TestWriteAndReadBack3");
+        p_reader = GenericMeshReader<3,3>(output_dir + "cube_136_elements");
+        TS_ASSERT(std::dynamic_pointer_cast<TRIANGLES_READER_3D>(p_reader));
+        TS_ASSERT_EQUALS(p_reader->GetNumNodes(), 51u);
+    }
+
+    void TestWriteFromMeshWithNodeAttributes()
+    {
+        TrianglesMeshReader<3,3> mesh_reader("mesh/test/data/cube_2mm_12_elements_with_node_attributes");
+        TetrahedralMesh<3,3> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        MappedMeshWriter<3,3> mesh_writer("TestMappedMeshReader", "cube_2mm_12_elements_with_node_attributes", false);
+        mesh_writer.WriteFilesUsingMesh(mesh);
+        PetscTools::Barrier("TestWriteFromMeshWithNodeAttributes");
+
+        mesh_reader.Reset();
+        MappedMeshReader<3,3> mapped_reader(mesh_writer.GetOutputDirectory() + "cube_2mm_12_elements_with_node_attributes");
+        CompareReaders(mesh_reader, mapped_reader, false);
+
+        std::vector<double> location = mapped_reader.GetNode(8);
+        TS_ASSERT_EQUALS(location.size(), 3u);
+        std::vector<double> attributes = mapped_reader.GetNodeAttributes();
+        TS_ASSERT_EQUALS(attributes.size(), 2u);
+        TS_ASSERT_DELTA(attributes[0], 3.0, 1e-6);
+        TS_ASSERT_DELTA(attributes[1], 24.5, 1e-6);
+    }
+
+    void TestStoredPartition()
+    {
+        const unsigned num_partitions = 3;
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/2D_0_to_1mm_200_elements");
+        TetrahedralMesh<2,2> mesh;
+        mesh.ConstructFromMeshReader(mesh_reader);
+
+        MappedMeshWriter<2,2> mesh_writer("TestMappedMeshReader", "2D_0_to_1mm_200_elements", false);
+        mesh_writer.SetNumPartitions(num_partitions);
+        TS_ASSERT_EQUALS(mesh_writer.GetNumPartitions(), num_partitions);
+        mesh_writer.WriteFilesUsingMesh(mesh);
+        PetscTools::Barrier("TestStoredPartition");
+
+        MappedMeshReader<2,2> mapped_reader(mesh_writer.GetOutputDirectory() + "2D_0_to_1mm_200_elements");
+        TS_ASSERT_EQUALS(mapped_reader.GetNumPartitions(), num_partitions);
+        const unsigned num_nodes = mapped_reader.GetNumNodes();
+
+        std::vector<unsigned> num_times_owned(num_nodes, 0u);
+        std::vector<unsigned> new_index_used(num_nodes, 0u);
+        for (unsigned partition=0; partition<num_partitions; partition++)
+        {
+            std::vector<unsigned> permutation;
+            std::vector<unsigned> offsets;
+            std::set<unsigned> nodes, halo_nodes, elements, faces;
+            mapped_reader.GetPartition(partition, permutation, offsets, nodes, halo_nodes, elements, faces);
+            TS_ASSERT_EQUALS(permutation.size(), num_nodes);
+            TS_ASSERT_EQUALS(offsets.size(), num_partitions);
+            TS_ASSERT_EQUALS(offsets[0], 0u);
+
+            // The bisection gives each partition a third of the nodes
+            TS_ASSERT_LESS_THAN_EQUALS(nodes.size(), num_nodes/num_partitions + 1);
+            TS_ASSERT_LESS_THAN_EQUALS(num_nodes/num_partitions, nodes.size());
+
+            // Owned nodes are given the contiguous range of new indices starting at this partition's offset
+            for (std::set<unsigned>::iterator it = nodes.begin(); it != nodes.end(); ++it)
+            {
+                num_times_owned[*it]++;
+                unsigned new_index = permutation[*it];
+                TS_ASSERT_LESS_THAN_EQUALS(offsets[partition], new_index);
+                TS_ASSERT_LESS_THAN(new_index, offsets[partition] + nodes.size());
+                new_index_used[new_index]++;
+                TS_ASSERT(halo_nodes.find(*it) == halo_nodes.end());
+            }
+
+            // Elements are owned if they have an owned node, and their other nodes are halo nodes
+            std::set<unsigned> expected_halo_nodes;
+            for (unsigned element_index=0; element_index<mapped_reader.GetNumElements(); element_index++)
+            {
+                std::vector<unsigned> element_nodes = mapped_reader.GetElementData(element_index).NodeIndices;
+                bool owned = false;
+                for (unsigned j=0; j<element_nodes.size(); j++)
+                {
+                    owned = owned || (nodes.find(element_nodes[j]) != nodes.end());
+                }
+                TS_ASSERT_EQUALS(elements.find(element_index) != elements.end(), owned);
+                for (unsigned j=0; owned && j<element_nodes.size(); j++)
+                {
+                    if (nodes.find(element_nodes[j]) == nodes.end())
+                    {
+                        expected_halo_nodes.insert(element_nodes[j]);
+                    }
+                }
+            }
+            TS_ASSERT(halo_nodes == expected_halo_nodes);
+
+            for (unsigned face_index=0; face_index<mapped_reader.GetNumFaces(); face_index++)
+            {
+                std::vector<unsigned> face_nodes = mapped_reader.GetFaceData(face_index).NodeIndices;
+                bool owned = false;
+                for (unsigned j=0; j<face_nodes.size(); j++)
+                {
+                    owned = owned || (nodes.find(face_nodes[j]) != nodes.end());
+                }
+                TS_ASSERT_EQUALS(faces.find(face_index) != faces.end(), owned);
+            }
+        }
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            TS_ASSERT_EQUALS(num_times_owned[i], 1u);
+            TS_ASSERT_EQUALS(new_index_used[i], 1u);
+        }
+
+        std::vector<unsigned> permutation;
+        std::vector<unsigned> offsets;
+        std::set<unsigned> nodes, halo_nodes, elements, faces;
+        TS_ASSERT_THROWS_THIS(mapped_reader.GetPartition(3, permutation, offsets, nodes, halo_nodes, elements, faces),
+                              "Partition 3 does not exist - the mesh was partitioned for 3 processes.");
+    }
+
+    void TestExceptions()
+    {
+        TS_ASSERT_THROWS_THIS(READER_3D reader("mesh/test/data/no_such_mesh"),
+                              "Could not open data file: mesh/test/data/no_such_mesh.mmesh");
+
+        // Quadratic meshes can't be written, and there can't be more partitions than nodes
+        TrianglesMeshReader<2,2> quadratic_reader("mesh/test/data/square_128_elements_quadratic", 2, 1);
+        MappedMeshWriter<2,2> quadratic_writer("TestMappedMeshReader", "square_128_elements_quadratic", false);
+        TrianglesMeshReader<2,2> linear_reader("mesh/test/data/2D_0_to_1mm_200_elements");
+        MappedMeshWriter<2,2> linear_writer("TestMappedMeshReader", "2D_0_to_1mm_200_elements", false);
+        linear_writer.SetNumPartitions(122);
+        if (PetscTools::AmMaster()) // Files are only written by the master process
+        {
+            TS_ASSERT_THROWS_THIS(quadratic_writer.WriteFilesUsingMeshReader(quadratic_reader),
+                                  "Only linear meshes can be written in mapped mesh format.");
+            TS_ASSERT_THROWS_THIS(linear_writer.WriteFilesUsingMeshReader(linear_reader),
+                                  "Cannot partition a mesh with 121 nodes between 122 processes.");
+        }
+
+        std::string output_dir;
+        {
+            TrianglesMeshReader<3,3> mesh_reader("mesh/test/data/cube_136_elements");
+            MappedMeshWriter<3,3> mesh_writer("TestMappedMeshReaderExceptions", "cube_136_elements");
+            mesh_writer.SetNumPartitions(2);
+            mesh_writer.WriteFilesUsingMeshReader(mesh_reader);
+            output_dir = mesh_writer.GetOutputDirectory();
+        }
+        PetscTools::Barrier("TestExceptions");
+
+        // Wrong dimensions
+        TS_ASSERT_THROWS_THIS(READER_2D_3D reader(output_dir + "cube_136_elements"),
+                              "Mapped mesh file has ELEMENT_DIM=3 and SPACE_DIM=3, but reader has ELEMENT_DIM=2 and SPACE_DIM=3.");
+
+        if (PetscTools::AmMaster())
+        {
+            // A file which is too short, and a file which is not a mesh file
+            std::ifstream good_file((output_dir + "cube_136_elements.mmesh").c_str(), std::ios::binary);
+            std::vector<char> contents((std::istreambuf_iterator<char>(good_file)), std::istreambuf_iterator<char>());
+
+            std::ofstream truncated_file((output_dir + "truncated.mmesh").c_str(), std::ios::binary);
+            truncated_file.write(&contents[0], contents.size()/2);
+            truncated_file.close();
+
+            std::ofstream tiny_file((output_dir + "tiny.mmesh").c_str(), std::ios::binary);
+            tiny_file.write(&contents[0], 8);
+            tiny_file.close();
+
+            // Node, element and face indices must be in range
+            MappedMeshFormat::Header header;
+            std::copy(contents.begin(), contents.begin() + sizeof(header), (char*)&header);
+            std::vector<char> bad_element_contents(contents);
+            unsigned bad_index = header.NumNodes;
+            std::copy((char*)&bad_index, (char*)&bad_index + sizeof(unsigned),
+                      bad_element_contents.begin() + header.BlockOffsets[MappedMeshFormat::ELEMENTS] + 2*sizeof(unsigned));
+            std::ofstream bad_element_file((output_dir + "bad_element.mmesh").c_str(), std::ios::binary);
+            bad_element_file.write(&bad_element_contents[0], bad_element_contents.size());
+            bad_element_file.close();
+
+            std::vector<char> bad_partition_contents(contents);
+            bad_index = header.NumElements;
+            std::copy((char*)&bad_index, (char*)&bad_index + sizeof(unsigned),
+                      bad_partition_contents.begin() + header.BlockOffsets[MappedMeshFormat::PARTITION_ELEMENTS]);
+            std::ofstream bad_partition_file((output_dir + "bad_partition.mmesh").c_str(), std::ios::binary);
+            bad_partition_file.write(&bad_partition_contents[0], bad_partition_contents.size());
+            bad_partition_file.close();
+
+            // The new index of an owned node must lie in its partition's range
+            std::vector<char> bad_permutation_contents(contents);
+            unsigned first_owned_node;
+            std::copy(contents.begin() + header.BlockOffsets[MappedMeshFormat::PARTITION_NODES],
+                      contents.begin() + header.BlockOffsets[MappedMeshFormat::PARTITION_NODES] + sizeof(unsigned),
+                      (char*)&first_owned_node);
+            bad_index = header.NumNodes - 1;
+            std::copy((char*)&bad_index, (char*)&bad_index + sizeof(unsigned),
+                      bad_permutation_contents.begin() + header.BlockOffsets[MappedMeshFormat::NODE_PERMUTATION] + first_owned_node*sizeof(unsigned));
+            std::ofstream bad_permutation_file((output_dir + "bad_permutation.mmesh").c_str(), std::ios::binary);
+            bad_permutation_file.write(&bad_permutation_contents[0], bad_permutation_contents.size());
+            bad_permutation_file.close();
+
+            // A file written on a machine with the opposite byte order
+            std::vector<char> swapped_contents(contents);
+            std::reverse(swapped_contents.begin() + offsetof(MappedMeshFormat::Header, ByteOrder),
+                         swapped_contents.begin() + offsetof(MappedMeshFormat::Header, ByteOrder) + sizeof(uint32_t));
+            std::ofstream swapped_file((output_dir + "swapped.mmesh").c_str(), std::ios::binary);
+            swapped_file.write(&swapped_contents[0], swapped_contents.size());
+            swapped_file.close();
+
+            contents[0] = 'X';
+            std::ofstream bad_magic_file((output_dir + "bad_magic.mmesh").c_str(), std::ios::binary);
+            bad_magic_file.write(&contents[0], contents.size());
+            bad_magic_file.close();
+        }
+        PetscTools::Barrier("TestExceptions2");
+
+        TS_ASSERT_THROWS_CONTAINS(READER_3D reader(output_dir + "truncated"),
+                                  "File contains incomplete data: block");
+        TS_ASSERT_THROWS_CONTAINS(READER_3D reader(output_dir + "tiny"),
+                                  "is too small to be a mesh file.");
+        TS_ASSERT_THROWS_CONTAINS(READER_3D reader(output_dir + "bad_magic"),
+                                  "bad_magic.mmesh is not a mapped mesh file.");
+        TS_ASSERT_THROWS_CONTAINS(READER_3D reader(output_dir + "swapped"),
+                                  "swapped.mmesh was written on a machine with the opposite byte order.");
+        TS_ASSERT_EQUALS(READER_3D::HasMatchingHeader(output_dir + "swapped"), false);
+        TS_ASSERT_EQUALS(READER_3D::HasMatchingHeader(output_dir + "tiny"), false);
+        TS_ASSERT_EQUALS(READER_3D::HasMatchingHeader(output_dir + "cube_136_elements"), true);
+        TS_ASSERT_EQUALS(READER_2D_3D::HasMatchingHeader(output_dir + "cube_136_elements"), false);
+
+        // With no source files to fall back to, a generic reader reports the wrong dimensions
+        TS_ASSERT_THROWS_THIS((GenericMeshReader<2,3>(output_dir + "cube_136_elements")),
+                              "Mapped mesh file has ELEMENT_DIM=3 and SPACE_DIM=3, but reader has ELEMENT_DIM=2 and SPACE_DIM=3.");
+
+        READER_3D bad_element_reader(output_dir + "bad_element");
+        TS_ASSERT_THROWS_THIS(bad_element_reader.GetNextElementData(),
+                              "Element 0 contains node 51, but the mesh only has 51 nodes.");
+        TS_ASSERT_THROWS_CONTAINS(bad_element_reader.GetElementData(0), "Element 0 contains node 51");
+
+        READER_3D bad_partition_reader(output_dir + "bad_partition");
+        std::vector<unsigned> permutation;
+        std::vector<unsigned> offsets;
+        std::set<unsigned> nodes, halo_nodes, elements, faces;
+        TS_ASSERT_THROWS_CONTAINS(bad_partition_reader.GetPartition(0, permutation, offsets, nodes, halo_nodes, elements, faces),
+                                  "bad_partition.mmesh is corrupt.");
+
+        // Each process checks the new indices of the nodes it owns
+        READER_3D bad_permutation_reader(output_dir + "bad_permutation");
+        TS_ASSERT_THROWS_CONTAINS(bad_permutation_reader.GetPartition(0, permutation, offsets, nodes, halo_nodes, elements, faces),
+                                  "bad_permutation.mmesh is corrupt.");
+
+        // A mesh which refers to a node that does not exist can't be written
+        OutputFileHandler handler("TestMappedMeshReaderExceptions", false);
+        if (PetscTools::AmMaster())
+        {
+            FileFinder node_file("mesh/test/data/square_2_elements.node", RelativeTo::ChasteSourceRoot);
+            handler.CopyFileTo(node_file);
+            out_stream p_ele_file = handler.OpenOutputFile("square_2_elements.ele");
+            *p_ele_file << "2 3 0\n0 3 0 1\n1 1 2 4\n";
+            p_ele_file->close();
+            out_stream p_edge_file = handler.OpenOutputFile("square_2_elements.edge");
+            *p_edge_file << "1 1\n0 0 1 1\n";
+            p_edge_file->close();
+
+            TrianglesMeshReader<2,2> bad_reader(output_dir + "square_2_elements");
+            MappedMeshWriter<2,2> bad_writer("TestMappedMeshReaderExceptions", "square_2_elements", false);
+            TS_ASSERT_THROWS_THIS(bad_writer.WriteFilesUsingMeshReader(bad_reader),
+                                  "Element 1 contains node 4, but the mesh only has 4 nodes.");
+        }
+    }
+};
+
+#endif /*TESTMAPPEDMESHREADER_HPP_*/
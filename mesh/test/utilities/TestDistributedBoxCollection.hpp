@@ -36,6 +36,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define TESTDISTRIBUTEDBOXCOLLECTION_HPP_
 
 #include <cxxtest/TestSuite.h>
+#include <algorithm>
 
 #include "CheckpointArchiveTypes.hpp"
 
@@ -44,6 +45,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "TrianglesMeshReader.hpp"
 #include "ArchiveOpener.hpp"
 #include "Warnings.hpp"
+#include "RandomNumberGenerator.hpp"
 
 #include "PetscSetupAndFinalize.hpp"
 
@@ -235,6 +237,129 @@ private:
         PetscTools::Destroy(petsc_vec);
     }
 
+    template<unsigned DIM>
+    std::vector<std::pair<unsigned, unsigned> > GetSortedPairIndices(std::vector<std::pair<Node<DIM>*, Node<DIM>*> >& rNodePairs)
+    {
+        std::vector<std::pair<unsigned, unsigned> > pair_indices;
+        for (unsigned i=0; i<rNodePairs.size(); i++)
+        {
+            pair_indices.push_back(std::pair<unsigned, unsigned>(rNodePairs[i].first->GetIndex(), rNodePairs[i].second->GetIndex()));
+        }
+        std::sort(pair_indices.begin(), pair_indices.end());
+        return pair_indices;
+    }
+
+    template<unsigned DIM>
+    void DoFlatCellListMatchesBoxes(bool isPeriodic)
+    {
+        // Construct two identical 6(x6(x6)) box collections, one of which uses the flat cell list
+        c_vector<double, 2*DIM> domain_size;
+        for (unsigned i=0; i<DIM; i++)
+        {
+            domain_size[2*i] = 0.0;
+            domain_size[2*i+1] = 6.0;
+        }
+
+        DistributedBoxCollection<DIM> box_collection(1.0, domain_size, isPeriodic, isPeriodic, isPeriodic);
+        box_collection.SetupLocalBoxesHalfOnly();
+
+        DistributedBoxCollection<DIM> flat_box_collection(1.0, domain_size, isPeriodic, isPeriodic, isPeriodic);
+        flat_box_collection.SetupLocalBoxesHalfOnly();
+        TS_ASSERT_EQUALS(flat_box_collection.GetUseFlatCellList(), false);
+        flat_box_collection.SetUseFlatCellList(true);
+        TS_ASSERT_EQUALS(flat_box_collection.GetUseFlatCellList(), true);
+
+        // Scatter three nodes per box (on average) at random through the domain
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+        p_gen->Reseed(0);
+
+        unsigned num_nodes = 3*box_collection.GetNumBoxes();
+        std::vector<Node<DIM>*> nodes;
+        std::vector<Node<DIM>*> local_nodes;
+        for (unsigned i=0; i<num_nodes; i++)
+        {
+            c_vector<double, DIM> location;
+            for (unsigned d=0; d<DIM; d++)
+            {
+                location[d] = 6.0*p_gen->ranf();
+            }
+            nodes.push_back(new Node<DIM>(i, location, false));
+
+            if (box_collection.IsOwned(nodes[i]))
+            {
+                unsigned box_index = box_collection.CalculateContainingBox(nodes[i]);
+                box_collection.AddNodeToBox(box_index, nodes[i]);
+                flat_box_collection.AddNodeToBox(box_index, nodes[i]);
+                local_nodes.push_back(nodes[i]);
+
+                // The boxes themselves are not used by the flat cell list
+                TS_ASSERT_EQUALS(flat_box_collection.rGetBox(box_index).rGetNodesContained().size(), 0u);
+            }
+        }
+
+        // Compute the pairs and neighbours using the boxes
+        std::vector<std::pair<Node<DIM>*, Node<DIM>*> > pairs;
+        box_collection.CalculateNodePairs(local_nodes, pairs);
+        std::vector<std::pair<unsigned, unsigned> > pair_indices = GetSortedPairIndices<DIM>(pairs);
+
+        std::vector<std::vector<unsigned> > neighbours(local_nodes.size());
+        for (unsigned i=0; i<local_nodes.size(); i++)
+        {
+            neighbours[i] = local_nodes[i]->rGetNeighbours();
+            std::sort(neighbours[i].begin(), neighbours[i].end());
+        }
+
+        // The flat cell list should find exactly the same pairs and neighbours
+        std::vector<std::pair<Node<DIM>*, Node<DIM>*> > flat_pairs;
+        flat_box_collection.CalculateNodePairs(local_nodes, flat_pairs);
+        TS_ASSERT_EQUALS(flat_pairs.size(), pairs.size());
+        TS_ASSERT(GetSortedPairIndices<DIM>(flat_pairs) == pair_indices);
+
+        for (unsigned i=0; i<local_nodes.size(); i++)
+        {
+            std::vector<unsigned> flat_neighbours = local_nodes[i]->rGetNeighbours();
+            std::sort(flat_neighbours.begin(), flat_neighbours.end());
+            TS_ASSERT(flat_neighbours == neighbours[i]);
+        }
+
+        // The same holds when the calculation is split into interior and boundary boxes
+        flat_pairs.clear();
+        flat_box_collection.CalculateInteriorNodePairs(local_nodes, flat_pairs);
+        flat_box_collection.CalculateBoundaryNodePairs(local_nodes, flat_pairs);
+        TS_ASSERT(GetSortedPairIndices<DIM>(flat_pairs) == pair_indices);
+
+        // Check the node distribution and halo nodes
+        std::vector<int> distribution = box_collection.CalculateNumberOfNodesInEachStrip();
+        std::vector<int> flat_distribution = flat_box_collection.CalculateNumberOfNodesInEachStrip();
+        TS_ASSERT(flat_distribution == distribution);
+
+        box_collection.UpdateHaloBoxes();
+        flat_box_collection.UpdateHaloBoxes();
+
+        std::vector<unsigned> halo_nodes_left = box_collection.rGetHaloNodesLeft();
+        std::vector<unsigned> flat_halo_nodes_left = flat_box_collection.rGetHaloNodesLeft();
+        std::sort(halo_nodes_left.begin(), halo_nodes_left.end());
+        std::sort(flat_halo_nodes_left.begin(), flat_halo_nodes_left.end());
+        TS_ASSERT(flat_halo_nodes_left == halo_nodes_left);
+
+        std::vector<unsigned> halo_nodes_right = box_collection.rGetHaloNodesRight();
+        std::vector<unsigned> flat_halo_nodes_right = flat_box_collection.rGetHaloNodesRight();
+        std::sort(halo_nodes_right.begin(), halo_nodes_right.end());
+        std::sort(flat_halo_nodes_right.begin(), flat_halo_nodes_right.end());
+        TS_ASSERT(flat_halo_nodes_right == halo_nodes_right);
+
+        // Once emptied, the flat cell list should return no pairs
+        flat_box_collection.EmptyBoxes();
+        flat_box_collection.CalculateNodePairs(local_nodes, flat_pairs);
+        TS_ASSERT_EQUALS(flat_pairs.size(), 0u);
+
+        // Tidy up
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
+
 public:
 
     void TestBox()
@@ -2868,6 +2993,17 @@ public:
             delete nodes[i];
         }
     }
+
+    void TestFlatCellListMatchesBoxes()
+    {
+        DoFlatCellListMatchesBoxes<1>(false);
+        DoFlatCellListMatchesBoxes<2>(false);
+        DoFlatCellListMatchesBoxes<3>(false);
+
+        DoFlatCellListMatchesBoxes<1>(true);
+        DoFlatCellListMatchesBoxes<2>(true);
+        DoFlatCellListMatchesBoxes<3>(true);
+    }
 };
 
 #endif /*TESTDISTRIBUTEDBOXCOLLECTION_HPP_*/
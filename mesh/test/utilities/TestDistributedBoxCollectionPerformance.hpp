@@ -0,0 +1,187 @@
+/*
+
+Copyright (c) 2005-2023, University of Oxford.
+All rights reserved.
+
+University of Oxford means the Chancellor, Masters and Scholars of the
+University of Oxford, having an administrative office at Wellington
+Square, Oxford OX1 2JD, UK.
+
+This file is part of Chaste.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+ * Redistributions of source code must retain the above copyright notice,
+   this list of conditions and the following disclaimer.
+ * Redistributions in binary form must reproduce the above copyright notice,
+   this list of conditions and the following disclaimer in the documentation
+   and/or other materials provided with the distribution.
+ * Neither the name of the University of Oxford nor the names of its
+   contributors may be used to endorse or promote products derived from this
+   software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT
+OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef TESTDISTRIBUTEDBOXCOLLECTIONPERFORMANCE_HPP_
+#define TESTDISTRIBUTEDBOXCOLLECTIONPERFORMANCE_HPP_
+
+#include <cxxtest/TestSuite.h>
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+#include "DistributedBoxCollection.hpp"
+#include "RandomNumberGenerator.hpp"
+#include "Timer.hpp"
+
+#include "PetscSetupAndFinalize.hpp"
+
+/**
+ * This test compares the time taken to calculate node pairs, and an estimate of the
+ * memory used to store nodes, when a DistributedBoxCollection stores its nodes in the
+ * std::set of each Box and when it uses the flat cell list. Nodes are scattered at
+ * random with unit density, and the box width (cut-off length) is 1.
+ *
+ * Each timing includes adding the nodes to the box collection, as happens every time
+ * step in a NodeBasedCellPopulation.
+ */
+class TestDistributedBoxCollectionPerformance : public CxxTest::TestSuite
+{
+private:
+
+    template<unsigned DIM>
+    void ProfileNodePairs(unsigned numNodes)
+    {
+        // Scatter the nodes at random through a cube of unit node density
+        double width = pow(double(numNodes), 1.0/double(DIM));
+
+        c_vector<double, 2*DIM> domain_size;
+        for (unsigned i=0; i<DIM; i++)
+        {
+            domain_size[2*i] = 0.0;
+            domain_size[2*i+1] = width;
+        }
+
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+        p_gen->Reseed(0);
+
+        std::vector<Node<DIM>*> nodes;
+        for (unsigned i=0; i<numNodes; i++)
+        {
+            c_vector<double, DIM> location;
+            for (unsigned d=0; d<DIM; d++)
+            {
+                location[d] = width*p_gen->ranf();
+            }
+            nodes.push_back(new Node<DIM>(i, location, false));
+        }
+
+        unsigned num_repeats = std::max(1000000u/numNodes, 1u);
+        unsigned num_pairs[2] = {0u, 0u};
+        double time_per_step[2];
+        double memory[2];
+
+        for (unsigned use_flat_cell_list=0; use_flat_cell_list<2; use_flat_cell_list++)
+        {
+            DistributedBoxCollection<DIM> box_collection(1.0, domain_size);
+            box_collection.SetupLocalBoxesHalfOnly();
+            box_collection.SetCalculateNodeNeighbours(false);
+            box_collection.SetUseFlatCellList(use_flat_cell_list == 1);
+
+            std::vector<Node<DIM>*> local_nodes;
+            std::vector<unsigned> box_indices;
+            for (unsigned i=0; i<nodes.size(); i++)
+            {
+                if (box_collection.IsOwned(nodes[i]))
+                {
+                    local_nodes.push_back(nodes[i]);
+                    box_indices.push_back(box_collection.CalculateContainingBox(nodes[i]));
+                }
+            }
+
+            std::vector<std::pair<Node<DIM>*, Node<DIM>*> > pairs;
+
+            double start_time = Timer::GetWallTime();
+            for (unsigned repeat=0; repeat<num_repeats; repeat++)
+            {
+                box_collection.EmptyBoxes();
+                for (unsigned i=0; i<local_nodes.size(); i++)
+                {
+                    box_collection.AddNodeToBox(box_indices[i], local_nodes[i]);
+                }
+                box_collection.CalculateNodePairs(local_nodes, pairs);
+            }
+            time_per_step[use_flat_cell_list] = (Timer::GetWallTime() - start_time)/num_repeats;
+            num_pairs[use_flat_cell_list] = pairs.size();
+
+            /*
+             * Estimate the memory used to store the nodes. Each element of a std::set is a tree
+             * node holding three pointers and a colour as well as the element itself, whereas the
+             * flat cell list holds each node pointer and index twice (as added and as sorted)
+             * together with the offsets of each box and the flattened local box stencils.
+             */
+            unsigned num_stencil_entries = 0;
+            for (unsigned box_index=0; box_index<box_collection.GetNumBoxes(); box_index++)
+            {
+                if (box_collection.IsBoxOwned(box_index))
+                {
+                    num_stencil_entries += box_collection.rGetLocalBoxes(box_index).size();
+                }
+            }
+
+            if (use_flat_cell_list == 1)
+            {
+                memory[1] = local_nodes.size()*2.0*(sizeof(Node<DIM>*) + sizeof(unsigned))
+                            + 2.0*(box_collection.GetNumLocalBoxes() + 1)*sizeof(unsigned)
+                            + num_stencil_entries*sizeof(unsigned);
+            }
+            else
+            {
+                memory[0] = local_nodes.size()*(4.0*sizeof(void*) + sizeof(Node<DIM>*));
+            }
+        }
+
+        // Both methods should find the same number of pairs
+        TS_ASSERT_EQUALS(num_pairs[1], num_pairs[0]);
+
+        std::cout << DIM << "D\t" << std::setw(8) << numNodes << " nodes\t"
+                  << std::setw(9) << num_pairs[0] << " pairs\t"
+                  << "std::set: " << std::setw(10) << time_per_step[0] << "s " << std::setw(8) << memory[0]/1048576.0 << "Mb\t"
+                  << "flat: " << std::setw(10) << time_per_step[1] << "s " << std::setw(8) << memory[1]/1048576.0 << "Mb\t"
+                  << "speedup: " << time_per_step[0]/time_per_step[1] << "\n";
+
+        for (unsigned i=0; i<nodes.size(); i++)
+        {
+            delete nodes[i];
+        }
+    }
+
+public:
+
+    void TestNodePairsPerformance2d()
+    {
+        ProfileNodePairs<2>(10000);
+        ProfileNodePairs<2>(100000);
+        ProfileNodePairs<2>(1000000);
+    }
+
+    void TestNodePairsPerformance3d()
+    {
+        ProfileNodePairs<3>(10000);
+        ProfileNodePairs<3>(100000);
+        ProfileNodePairs<3>(1000000);
+    }
+};
+
+#endif /*TESTDISTRIBUTEDBOXCOLLECTIONPERFORMANCE_HPP_*/
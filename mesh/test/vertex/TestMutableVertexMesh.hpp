@@ -1875,6 +1875,99 @@ public:
     {
         //\todo need to re-implement this
     }
+
+    void TestElementGeometryCache()
+    {
+        HoneycombVertexMeshGenerator generator(4, 4);
+        boost::shared_ptr<MutableVertexMesh<2, 2> > p_mesh = generator.GetMesh();
+
+        // Distort the mesh so that no two elements have the same geometry
+        for (unsigned node_index = 0; node_index < p_mesh->GetNumNodes(); node_index++)
+        {
+            c_vector<double, 2>& r_location = p_mesh->GetNode(node_index)->rGetModifiableLocation();
+            r_location[0] += 0.01 * r_location[1] * r_location[1];
+        }
+
+        std::vector<double> areas;
+        std::vector<double> perimeters;
+        std::vector<c_vector<double, 2> > centroids;
+        std::vector<c_vector<double, 2> > edge_gradients;
+        for (unsigned elem_index = 0; elem_index < p_mesh->GetNumElements(); elem_index++)
+        {
+            VertexElement<2, 2>* p_element = p_mesh->GetElement(elem_index);
+            areas.push_back(p_mesh->GetVolumeOfElement(elem_index));
+            perimeters.push_back(p_mesh->GetSurfaceAreaOfElement(elem_index));
+            centroids.push_back(p_mesh->GetCentroidOfElement(elem_index));
+            edge_gradients.push_back(p_mesh->GetPerimeterGradientOfElementAtNode(p_element, 2));
+        }
+
+        // Test set and get methods
+        TS_ASSERT_EQUALS(p_mesh->GetUseElementGeometryCache(), false);
+        p_mesh->SetUseElementGeometryCache(true);
+        TS_ASSERT_EQUALS(p_mesh->GetUseElementGeometryCache(), true);
+
+        // The cached geometry should be identical to that computed without the cache
+        for (unsigned elem_index = 0; elem_index < p_mesh->GetNumElements(); elem_index++)
+        {
+            VertexElement<2, 2>* p_element = p_mesh->GetElement(elem_index);
+            TS_ASSERT_EQUALS(p_mesh->GetVolumeOfElement(elem_index), areas[elem_index]);
+            TS_ASSERT_EQUALS(p_mesh->GetSurfaceAreaOfElement(elem_index), perimeters[elem_index]);
+            TS_ASSERT_EQUALS(p_mesh->GetCentroidOfElement(elem_index)[0], centroids[elem_index][0]);
+            TS_ASSERT_EQUALS(p_mesh->GetCentroidOfElement(elem_index)[1], centroids[elem_index][1]);
+            TS_ASSERT_EQUALS(p_mesh->GetPerimeterGradientOfElementAtNode(p_element, 2)[0], edge_gradients[elem_index][0]);
+            TS_ASSERT_EQUALS(p_mesh->GetPerimeterGradientOfElementAtNode(p_element, 2)[1], edge_gradients[elem_index][1]);
+        }
+        TS_ASSERT_EQUALS(p_mesh->mElementGeometryIsCurrent.size(), p_mesh->GetNumElements());
+
+        // Moving a node with SetNode() should only invalidate the elements containing it
+        Node<2>* p_node = p_mesh->GetElement(5)->GetNode(0);
+        std::set<unsigned> containing_elements = p_node->rGetContainingElementIndices();
+        c_vector<double, 2> old_location = p_node->rGetLocation();
+        c_vector<double, 2> new_location = old_location;
+        new_location[0] += 0.1;
+        new_location[1] += 0.1; // a purely horizontal move would shear the hexagon without changing its area
+        p_mesh->SetNode(p_node->GetIndex(), ChastePoint<2>(new_location));
+
+        for (unsigned elem_index = 0; elem_index < p_mesh->GetNumElements(); elem_index++)
+        {
+            TS_ASSERT_EQUALS(p_mesh->mElementGeometryIsCurrent[elem_index], containing_elements.count(elem_index) == 0);
+        }
+        TS_ASSERT_DIFFERS(p_mesh->GetVolumeOfElement(5), areas[5]);
+        p_mesh->SetUseElementGeometryCache(false);
+        double uncached_area = p_mesh->GetVolumeOfElement(5);
+        p_mesh->SetUseElementGeometryCache(true);
+        TS_ASSERT_EQUALS(p_mesh->GetVolumeOfElement(5), uncached_area);
+
+        // Nodes moved directly require the cache to be invalidated
+        p_node->rGetModifiableLocation() = old_location;
+        TS_ASSERT_EQUALS(p_mesh->GetVolumeOfElement(5), uncached_area);
+        p_mesh->InvalidateElementGeometry();
+        TS_ASSERT_EQUALS(p_mesh->GetVolumeOfElement(5), areas[5]);
+
+        // Scaling, translating or rotating the mesh should invalidate the cache
+        p_mesh->Scale(2.0, 1.0);
+        TS_ASSERT_DELTA(p_mesh->GetVolumeOfElement(5), 2.0*areas[5], 1e-12);
+        p_mesh->Translate(1.0, 0.5);
+        TS_ASSERT_DELTA(p_mesh->GetCentroidOfElement(5)[1], centroids[5][1] + 0.5, 1e-12);
+        p_mesh->Rotate(0.5*M_PI);
+        TS_ASSERT_DELTA(p_mesh->GetCentroidOfElement(5)[0], centroids[5][1] + 0.5, 1e-12);
+        p_mesh->Rotate(-0.5*M_PI);
+        p_mesh->Translate(-1.0, -0.5);
+        p_mesh->Scale(0.5, 1.0);
+        TS_ASSERT_DELTA(p_mesh->GetVolumeOfElement(5), areas[5], 1e-12);
+
+        // Dividing an element should invalidate the cache, and the new element should be cached
+        unsigned num_elements = p_mesh->GetNumElements();
+        unsigned new_element_index = p_mesh->DivideElementAlongShortAxis(p_mesh->GetElement(5));
+        TS_ASSERT_EQUALS(p_mesh->GetNumElements(), num_elements + 1);
+        TS_ASSERT_DELTA(p_mesh->GetVolumeOfElement(5) + p_mesh->GetVolumeOfElement(new_element_index), areas[5], 1e-12);
+        TS_ASSERT_EQUALS(p_mesh->mElementGeometryIsCurrent.size(), num_elements + 1);
+
+        // Remeshing should leave the cache enabled
+        p_mesh->ReMesh();
+        TS_ASSERT_EQUALS(p_mesh->GetUseElementGeometryCache(), true);
+        TS_ASSERT_DELTA(p_mesh->GetVolumeOfElement(5) + p_mesh->GetVolumeOfElement(new_element_index), areas[5], 1e-12);
+    }
 };
 
 #endif /*TESTMUTABLEVERTEXMESH_HPP_*/
@@ -38,8 +38,11 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <cxxtest/TestSuite.h>
 
+#include "CylindricalHoneycombVertexMeshGenerator.hpp"
 #include "FileComparison.hpp"
+#include "HoneycombVertexMeshGenerator.hpp"
 #include "MutableVertexMesh.hpp"
+#include "RandomNumberGenerator.hpp"
 #include "VertexMeshWriter.hpp"
 #include "Warnings.hpp"
 
@@ -58,6 +61,47 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 class TestMutableVertexMeshReMesh : public CxxTest::TestSuite
 {
+private:
+
+    /**
+     * Remesh in the way ReMesh() did before it used worklists, by rescanning
+     * the whole mesh after every swap.
+     */
+    void ReMeshByRescanning(MutableVertexMesh<2, 2>& rMesh)
+    {
+        VertexElementMap map(rMesh.GetNumElements());
+        rMesh.RemoveDeletedNodesAndElements(map);
+
+        TS_ASSERT_EQUALS(rMesh.mUseSwapWorklists, false);
+        while (rMesh.CheckForSwapsFromShortEdges())
+        {
+        }
+        while (rMesh.CheckForIntersections())
+        {
+        }
+
+        rMesh.RemoveDeletedNodes();
+        rMesh.CheckForRosettes();
+    }
+
+    /**
+     * Randomly move the interior nodes of a mesh, so that many edges become short.
+     */
+    void PerturbInteriorNodes(MutableVertexMesh<2, 2>& rMesh, double maxDisplacement)
+    {
+        RandomNumberGenerator* p_gen = RandomNumberGenerator::Instance();
+        p_gen->Reseed(0);
+        for (unsigned node_index = 0; node_index < rMesh.GetNumNodes(); node_index++)
+        {
+            Node<2>* p_node = rMesh.GetNode(node_index);
+            if (!p_node->IsBoundaryNode())
+            {
+                p_node->rGetModifiableLocation()[0] += maxDisplacement * (2.0 * p_gen->ranf() - 1.0);
+                p_node->rGetModifiableLocation()[1] += maxDisplacement * (2.0 * p_gen->ranf() - 1.0);
+            }
+        }
+    }
+
 public:
     void TestPerformNodeMerge()
     {
@@ -4452,6 +4496,117 @@ public:
         TS_ASSERT_DELTA(vertex_mesh.GetSurfaceAreaOfElement(0), 2.4232, 1e-4);
         TS_ASSERT_DELTA(vertex_mesh.GetSurfaceAreaOfElement(1), 2.3062, 1e-4);
     }
+
+    void TestReMeshWithWorklistsMatchesRescanning()
+    {
+        // Create two identical honeycomb meshes and move their interior nodes in the same way
+        HoneycombVertexMeshGenerator generator(12, 12);
+        boost::shared_ptr<MutableVertexMesh<2, 2> > p_mesh = generator.GetMesh();
+        p_mesh->SetCellRearrangementThreshold(0.3);
+        PerturbInteriorNodes(*p_mesh, 0.15);
+
+        HoneycombVertexMeshGenerator reference_generator(12, 12);
+        boost::shared_ptr<MutableVertexMesh<2, 2> > p_reference_mesh = reference_generator.GetMesh();
+        p_reference_mesh->SetCellRearrangementThreshold(0.3);
+        PerturbInteriorNodes(*p_reference_mesh, 0.15);
+
+        // Remesh one using the worklists and the other by rescanning the mesh after each swap
+        p_mesh->ReMesh();
+        TS_ASSERT_EQUALS(p_mesh->mUseSwapWorklists, false);
+        ReMeshByRescanning(*p_reference_mesh);
+
+        // Many T1 swaps should have been performed...
+        TS_ASSERT_LESS_THAN(10u, p_mesh->GetLocationsOfT1Swaps().size());
+        TS_ASSERT_EQUALS(p_mesh->GetLocationsOfT1Swaps().size(), p_reference_mesh->GetLocationsOfT1Swaps().size());
+
+        // ...and the resulting meshes should be identical
+        TS_ASSERT_EQUALS(p_mesh->GetNumNodes(), p_reference_mesh->GetNumNodes());
+        TS_ASSERT_EQUALS(p_mesh->GetNumElements(), p_reference_mesh->GetNumElements());
+
+        for (unsigned node_index = 0; node_index < p_mesh->GetNumNodes(); node_index++)
+        {
+            for (unsigned i = 0; i < 2; i++)
+            {
+                TS_ASSERT_EQUALS(p_mesh->GetNode(node_index)->rGetLocation()[i],
+                                 p_reference_mesh->GetNode(node_index)->rGetLocation()[i]);
+            }
+        }
+
+        for (unsigned elem_index = 0; elem_index < p_mesh->GetNumElements(); elem_index++)
+        {
+            VertexElement<2, 2>* p_element = p_mesh->GetElement(elem_index);
+            VertexElement<2, 2>* p_reference_element = p_reference_mesh->GetElement(elem_index);
+            TS_ASSERT_EQUALS(p_element->GetNumNodes(), p_reference_element->GetNumNodes());
+            for (unsigned local_index = 0; local_index < p_element->GetNumNodes(); local_index++)
+            {
+                TS_ASSERT_EQUALS(p_element->GetNodeGlobalIndex(local_index), p_reference_element->GetNodeGlobalIndex(local_index));
+            }
+        }
+    }
+
+    void TestBoundaryElementGridFindsAllNearbyBoundaryElements()
+    {
+        HoneycombVertexMeshGenerator generator(12, 12);
+        boost::shared_ptr<MutableVertexMesh<2, 2> > p_mesh = generator.GetMesh();
+
+        CylindricalHoneycombVertexMeshGenerator cylindrical_generator(12, 12);
+        boost::shared_ptr<Cylindrical2dVertexMesh> p_cylindrical_mesh = cylindrical_generator.GetCylindricalMesh();
+
+        std::vector<MutableVertexMesh<2, 2>*> meshes;
+        meshes.push_back(p_mesh.get());
+        meshes.push_back(p_cylindrical_mesh.get());
+
+        for (unsigned i = 0; i < meshes.size(); i++)
+        {
+            MutableVertexMesh<2, 2>& r_mesh = *(meshes[i]);
+            r_mesh.SetDistanceForT3SwapChecking(1.5);
+            r_mesh.BuildBoundaryElementGrid();
+
+            // The grid should be split into several bins in each dimension
+            TS_ASSERT_LESS_THAN(3u, r_mesh.mBoundaryElementGridSize[0]);
+            TS_ASSERT_LESS_THAN(3u, r_mesh.mBoundaryElementGridSize[1]);
+            TS_ASSERT_LESS_THAN_EQUALS(1.5, r_mesh.mBoundaryElementGridSpacing[0]);
+            TS_ASSERT_LESS_THAN_EQUALS(1.5, r_mesh.mBoundaryElementGridSpacing[1]);
+
+            // Every boundary element within the T3 swap checking distance of a boundary node should be found
+            unsigned num_pairs_found = 0;
+            for (unsigned node_index = 0; node_index < r_mesh.GetNumNodes(); node_index++)
+            {
+                Node<2>* p_node = r_mesh.GetNode(node_index);
+                if (p_node->IsBoundaryNode())
+                {
+                    std::set<unsigned> nearby_elements = r_mesh.GetBoundaryElementsNearLocation(p_node->rGetLocation());
+                    for (unsigned elem_index = 0; elem_index < r_mesh.GetNumElements(); elem_index++)
+                    {
+                        if (r_mesh.GetElement(elem_index)->IsElementOnBoundary())
+                        {
+                            c_vector<double, 2> centroid = r_mesh.GetCentroidOfElement(elem_index);
+                            if (norm_2(r_mesh.GetVectorFromAtoB(p_node->rGetLocation(), centroid)) < 1.5)
+                            {
+                                TS_ASSERT_EQUALS(nearby_elements.count(elem_index), 1u);
+                                num_pairs_found++;
+                            }
+                        }
+                    }
+                }
+            }
+            TS_ASSERT_LESS_THAN(0u, num_pairs_found);
+
+            // Moving an element's nodes and updating the grid should re-bin it
+            VertexElement<2, 2>* p_element = r_mesh.GetElement(0);
+            TS_ASSERT(p_element->IsElementOnBoundary());
+            std::set<unsigned> element_node_indices;
+            for (unsigned local_index = 0; local_index < p_element->GetNumNodes(); local_index++)
+            {
+                element_node_indices.insert(p_element->GetNodeGlobalIndex(local_index));
+                p_element->GetNode(local_index)->rGetModifiableLocation()[1] += 4.0;
+            }
+            c_vector<double, 2> new_centroid = r_mesh.GetCentroidOfElement(0);
+            r_mesh.UpdateBoundaryElementGridNearNodes(element_node_indices);
+            TS_ASSERT_EQUALS(r_mesh.GetBoundaryElementsNearLocation(new_centroid).count(0), 1u);
+            TS_ASSERT_DELTA(r_mesh.mBoundaryElementCentroids[0][1], new_centroid[1], 1e-12);
+        }
+    }
 };
 
 #endif /*TESTMUTABLEVERTEXMESHREMESH_HPP_*/
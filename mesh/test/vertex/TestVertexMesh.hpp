@@ -46,6 +46,7 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "VertexMesh.hpp"
 #include "ArchiveOpener.hpp"
 #include "MutableMesh.hpp"
+#include "TrianglesMeshReader.hpp"
 //This test is always run sequentially (never in parallel)
 #include "FakePetscSetup.hpp"
 
@@ -2042,6 +2043,119 @@ public:
         TS_ASSERT_DELTA(voronoi_mesh.GetVolumeOfElement(4), 0.5, 1e-6);
     }
 
+    void TestUpdateVoronoiTessellation()
+    {
+        TrianglesMeshReader<2,2> mesh_reader("mesh/test/data/square_128_elements");
+        MutableMesh<2,2> delaunay_mesh;
+        delaunay_mesh.ConstructFromMeshReader(mesh_reader);
+        delaunay_mesh.ReMesh();
+        delaunay_mesh.SetUseIncrementalReMesh(true);
+
+        VertexMesh<2,2> voronoi_mesh(delaunay_mesh);
+
+        // Nothing has changed, so the update just recomputes the same vertices
+        TS_ASSERT_EQUALS(voronoi_mesh.UpdateVoronoiTessellation(), true);
+
+        for (unsigned step=0; step<2; step++)
+        {
+            if (step == 0)
+            {
+                // Move the interior nodes, so that some edges of the Delaunay mesh are flipped
+                for (unsigned i=0; i<delaunay_mesh.GetNumNodes(); i++)
+                {
+                    if (!delaunay_mesh.GetNode(i)->IsBoundaryNode())
+                    {
+                        c_vector<double, 2>& r_location = delaunay_mesh.GetNode(i)->rGetModifiableLocation();
+                        r_location[0] += 0.03*sin(1.7*i);
+                        r_location[1] += 0.03*cos(2.3*i);
+                    }
+                }
+            }
+            else
+            {
+                // Replace an interior node, as happens on cell death and division
+                delaunay_mesh.DeleteNodePriorToReMesh(40);
+                delaunay_mesh.AddNode(new Node<2>(0, false, 0.31, 0.27));
+            }
+            NodeMap map(delaunay_mesh.GetNumAllNodes());
+            delaunay_mesh.ReMesh(map);
+            TS_ASSERT_EQUALS(delaunay_mesh.GetLastReMeshWasIncremental(), true);
+
+            TS_ASSERT_EQUALS(voronoi_mesh.UpdateVoronoiTessellation(), true);
+
+            // The updated tessellation should be identical to one constructed afresh
+            VertexMesh<2,2> new_voronoi_mesh(delaunay_mesh);
+            TS_ASSERT_EQUALS(voronoi_mesh.GetNumNodes(), new_voronoi_mesh.GetNumNodes());
+            TS_ASSERT_EQUALS(voronoi_mesh.GetNumElements(), new_voronoi_mesh.GetNumElements());
+            for (unsigned i=0; i<voronoi_mesh.GetNumNodes(); i++)
+            {
+                TS_ASSERT_DELTA(voronoi_mesh.GetNode(i)->rGetLocation()[0], new_voronoi_mesh.GetNode(i)->rGetLocation()[0], 1e-12);
+                TS_ASSERT_DELTA(voronoi_mesh.GetNode(i)->rGetLocation()[1], new_voronoi_mesh.GetNode(i)->rGetLocation()[1], 1e-12);
+                TS_ASSERT(voronoi_mesh.GetNode(i)->rGetContainingElementIndices() == new_voronoi_mesh.GetNode(i)->rGetContainingElementIndices());
+            }
+            for (unsigned i=0; i<voronoi_mesh.GetNumElements(); i++)
+            {
+                TS_ASSERT_EQUALS(voronoi_mesh.GetElement(i)->GetNumNodes(), new_voronoi_mesh.GetElement(i)->GetNumNodes());
+                for (unsigned j=0; j<voronoi_mesh.GetElement(i)->GetNumNodes(); j++)
+                {
+                    TS_ASSERT_EQUALS(voronoi_mesh.GetElement(i)->GetNodeGlobalIndex(j), new_voronoi_mesh.GetElement(i)->GetNodeGlobalIndex(j));
+                }
+                TS_ASSERT_DELTA(voronoi_mesh.GetVolumeOfElement(i), new_voronoi_mesh.GetVolumeOfElement(i), 1e-12);
+            }
+        }
+
+        // A tessellation cannot be updated once the number of Delaunay elements changes
+        delaunay_mesh.AddNode(new Node<2>(0, false, 0.52, 0.49));
+        delaunay_mesh.ReMesh();
+        TS_ASSERT_EQUALS(voronoi_mesh.UpdateVoronoiTessellation(), false);
+
+        // Bounded tessellations cannot be updated
+        VertexMesh<2,2> bounded_voronoi_mesh(delaunay_mesh, false, true);
+        TS_ASSERT_EQUALS(bounded_voronoi_mesh.UpdateVoronoiTessellation(), false);
+
+        // Nor can tessellations that were not constructed from a Delaunay mesh
+        VertexMesh<2,2> empty_mesh;
+        TS_ASSERT_EQUALS(empty_mesh.UpdateVoronoiTessellation(), false);
+    }
+
+    void TestUpdateVoronoiTessellation3d()
+    {
+        std::vector<Node<3>*> nodes;
+        nodes.push_back(new Node<3>(0, true,  0.0, 0.0, 0.0));
+        nodes.push_back(new Node<3>(1, true,  1.0, 1.0, 0.0));
+        nodes.push_back(new Node<3>(2, true,  1.0, 0.0, 1.0));
+        nodes.push_back(new Node<3>(3, true,  0.0, 1.0, 1.0));
+        nodes.push_back(new Node<3>(4, false, 0.5, 0.5, 0.5));
+        MutableMesh<3,3> delaunay_mesh(nodes);
+
+        VertexMesh<3,3> voronoi_mesh(delaunay_mesh);
+
+        // Move the interior node without changing the topology of the Delaunay mesh
+        c_vector<double, 3>& r_location = delaunay_mesh.GetNode(4)->rGetModifiableLocation();
+        r_location[0] = 0.45;
+        r_location[1] = 0.55;
+        delaunay_mesh.RefreshMesh();
+
+        TS_ASSERT_EQUALS(voronoi_mesh.UpdateVoronoiTessellation(), true);
+
+        VertexMesh<3,3> new_voronoi_mesh(delaunay_mesh);
+        TS_ASSERT_EQUALS(voronoi_mesh.GetNumNodes(), new_voronoi_mesh.GetNumNodes());
+        for (unsigned i=0; i<voronoi_mesh.GetNumNodes(); i++)
+        {
+            for (unsigned j=0; j<3; j++)
+            {
+                TS_ASSERT_DELTA(voronoi_mesh.GetNode(i)->rGetLocation()[j], new_voronoi_mesh.GetNode(i)->rGetLocation()[j], 1e-12);
+            }
+        }
+        TS_ASSERT_DELTA(voronoi_mesh.GetVolumeOfElement(0), new_voronoi_mesh.GetVolumeOfElement(0), 1e-12);
+        TS_ASSERT_DELTA(voronoi_mesh.GetSurfaceAreaOfElement(0), new_voronoi_mesh.GetSurfaceAreaOfElement(0), 1e-12);
+
+        // In 3D a tessellation cannot be updated once the topology of the Delaunay mesh changes
+        delaunay_mesh.AddNode(new Node<3>(0, false, 0.3, 0.4, 0.4));
+        delaunay_mesh.ReMesh();
+        TS_ASSERT_EQUALS(voronoi_mesh.UpdateVoronoiTessellation(), false);
+    }
+
     void TestGetEdgeLengthWithSimpleMesh()
     {
         // Create a simple 2D tetrahedral mesh, the Delaunay triangulation
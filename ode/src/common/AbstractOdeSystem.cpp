@@ -33,8 +33,12 @@ OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 */
 
+#include <climits>
+#include <exception>
+
 #include "AbstractOdeSystem.hpp"
 #include "Exception.hpp"
+#include "ThreadingTools.hpp"
 
 AbstractOdeSystem::AbstractOdeSystem(unsigned numberOfStateVariables)
     : AbstractParameterisedSystem<std::vector<double> >(numberOfStateVariables),
@@ -46,6 +50,67 @@ AbstractOdeSystem::~AbstractOdeSystem()
 {
 }
 
+void AbstractOdeSystem::EvaluateYDerivativesBatch(double time,
+                                                  const std::vector<AbstractOdeSystem*>& rSystems,
+                                                  const std::vector<double>& rY,
+                                                  std::vector<double>& rDY)
+{
+    const unsigned num_systems = rSystems.size();
+    const unsigned num_variables = GetNumberOfStateVariables();
+
+    // Exceptions cannot leave a parallel region, so we keep the one thrown for the lowest system index and rethrow it below
+    std::exception_ptr p_exception = nullptr;
+    unsigned exception_system_index = UINT_MAX;
+
+#ifdef CHASTE_OPENMP
+#pragma omp parallel num_threads(ThreadingTools::GetNumThreads())
+#endif
+    {
+        // Work vectors for the system being evaluated by this thread
+        std::vector<double> row_y(num_variables);
+        std::vector<double> row_dy(num_variables);
+
+#ifdef CHASTE_OPENMP
+#pragma omp for schedule(static)
+#endif
+        for (unsigned s=0; s<num_systems; s++)
+        {
+            try
+            {
+                for (unsigned i=0; i<num_variables; i++)
+                {
+                    row_y[i] = rY[i*num_systems + s];
+                }
+
+                rSystems[s]->EvaluateYDerivatives(time, row_y, row_dy);
+
+                for (unsigned i=0; i<num_variables; i++)
+                {
+                    rDY[i*num_systems + s] = row_dy[i];
+                }
+            }
+            catch (...)
+            {
+#ifdef CHASTE_OPENMP
+#pragma omp critical(AbstractOdeSystemException)
+#endif
+                {
+                    if (s < exception_system_index)
+                    {
+                        exception_system_index = s;
+                        p_exception = std::current_exception();
+                    }
+                }
+            }
+        }
+    }
+
+    if (p_exception)
+    {
+        std::rethrow_exception(p_exception);
+    }
+}
+
 bool AbstractOdeSystem::CalculateStoppingEvent(double time, const std::vector<double>& rY)
 {
     return false;
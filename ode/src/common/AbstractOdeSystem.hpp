@@ -177,6 +177,24 @@ public:
     virtual void EvaluateYDerivatives(double time, const std::vector<double>& rY,
                                       std::vector<double>& rDY)=0;
 
+    /**
+     * Evaluate the derivatives of several ODE systems of the same class as this one at once.
+     *
+     * The state variables and derivatives are stored as struct-of-arrays, so that variable i
+     * of system s is held at entry i*rSystems.size() + s. The default implementation copies
+     * each system's variables into a work vector and calls its EvaluateYDerivatives(), sharing
+     * the systems between ThreadingTools::GetNumThreads() threads. Subclasses may override it
+     * with loops over the systems that work directly on the columns of rY and rDY, which the
+     * compiler can vectorise; these must give the same results as EvaluateYDerivatives().
+     *
+     * @param time  the current time
+     * @param rSystems  the ODE systems, all of the same class as this one
+     * @param rY  the current values of the state variables of the systems
+     * @param rDY  storage for the derivatives of the systems; will be filled in on return
+     */
+    virtual void EvaluateYDerivativesBatch(double time, const std::vector<AbstractOdeSystem*>& rSystems,
+                                           const std::vector<double>& rY, std::vector<double>& rDY);
+
     /**
      * CalculateStoppingEvent() - can be overloaded if the ODE is to be solved
      * only until a particular event (for example, only until the y value becomes